@@ -15,6 +15,7 @@
 //===----------------------------------------------------------------------===//
 
 #include <buddy/Core/Container.h>
+#include <buddy/DIP/DIP.h>
 #include <buddy/DIP/ImageContainer.h>
 #include <chrono>
 #include <cstdlib>
@@ -42,13 +43,7 @@ const cv::Mat imagePreprocessing() {
   // Read the image in grayscale mode.
   cv::Mat inputImage = cv::imread(imgPath, cv::IMREAD_GRAYSCALE);
   assert(!inputImage.empty() && "Could not read the image.");
-  cv::Mat resizedImage;
-  int imageWidth = 28;
-  int imageHeight = 28;
-  // Resize the image to 28x28 pixels.
-  cv::resize(inputImage, resizedImage, cv::Size(imageWidth, imageHeight),
-             cv::INTER_LINEAR);
-  return resizedImage;
+  return inputImage;
 }
 
 /// Print [Log] label in bold blue format.
@@ -120,7 +115,19 @@ int main() {
   intptr_t sizesOutput[2] = {1, 10};
 
   // Create input and output containers for the image and model output.
-  Img<float, 4> input(image, sizesInput, true);
+  Img<float, 4> input(sizesInput);
+  // Resize, normalize to [0, 1] and lay out the image as NCHW in one pass,
+  // reading the decoded pixels in place. Bilinear sampling aligns the pixel
+  // centers like cv::resize with INTER_LINEAR; values can differ from OpenCV
+  // by rounding, since OpenCV interpolates 8-bit images in fixed point.
+  assert(image.isContinuous() && "The decoded image must be contiguous.");
+  intptr_t sizesImage[2] = {image.rows, image.cols};
+  ImgView<uint8_t, 2> decodedImage(image.data, sizesImage);
+  const float mean[1] = {0.f};
+  const float stdDev[1] = {1.f};
+  dip::ImageToTensor(&decodedImage, &input, dip::TENSOR_LAYOUT::NCHW,
+                     dip::INTERPOLATION_TYPE::BILINEAR_INTERPOLATION, mean,
+                     stdDev);
   MemRef<float, 2> output(sizesOutput);
 
   // Load model parameters from the specified file.
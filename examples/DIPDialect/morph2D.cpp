@@ -89,7 +89,7 @@ bool testImplementation(int argc, char *argv[], std::ptrdiff_t x,
   // kernel for morphological transformations.
   Mat kernel1 = cv::getStructuringElement(MORPH_ELLIPSE, Size(3, 3));
 
-  dip::Opening2D(input, &kernel, &output1, x, y, 1,
+  dip::Opening2D(&input, &kernel, &output1, x, y, 1,
                  dip::BOUNDARY_OPTION::CONSTANT_PADDING, 0.0);
   Mat outputImageConstantPaddingopening(sizesOutput[0], sizesOutput[1],
                                         CV_32FC1, output1.getData());
@@ -106,7 +106,7 @@ bool testImplementation(int argc, char *argv[], std::ptrdiff_t x,
     return 0;
   }
 
-  dip::Opening2D(input, &kernel, &output2, x, y, 1,
+  dip::Opening2D(&input, &kernel, &output2, x, y, 1,
                  dip::BOUNDARY_OPTION::REPLICATE_PADDING, 0.0);
   // Define a cv::Mat with the output of Opening2D.
   Mat outputImageReplicatePaddingopening(sizesOutput[0], sizesOutput[1],
@@ -122,7 +122,7 @@ bool testImplementation(int argc, char *argv[], std::ptrdiff_t x,
     return 0;
   }
 
-  dip::Closing2D(input, &kernel, &output3, x, y, 1,
+  dip::Closing2D(&input, &kernel, &output3, x, y, 1,
                  dip::BOUNDARY_OPTION::REPLICATE_PADDING, 0);
   Mat outputImageReplicatePaddingclosing(sizesOutput[0], sizesOutput[1],
                                          CV_32FC1, output3.getData());
@@ -139,7 +139,7 @@ bool testImplementation(int argc, char *argv[], std::ptrdiff_t x,
     return 0;
   }
 
-  dip::Closing2D(input, &kernel, &output4, x, y, 1,
+  dip::Closing2D(&input, &kernel, &output4, x, y, 1,
                  dip::BOUNDARY_OPTION::CONSTANT_PADDING, 0.0);
 
   // Define a cv::Mat with the output of Closing2D.
@@ -157,7 +157,7 @@ bool testImplementation(int argc, char *argv[], std::ptrdiff_t x,
     return 0;
   }
 
-  dip::TopHat2D(input, &kernel, &output5, x, y, 1,
+  dip::TopHat2D(&input, &kernel, &output5, x, y, 1,
                 dip::BOUNDARY_OPTION::REPLICATE_PADDING);
   Mat outputImageReplicatePaddingtophat(sizesOutput[0], sizesOutput[1],
                                         CV_32FC1, output5.getData());
@@ -249,7 +249,7 @@ bool testImplementation(int argc, char *argv[], std::ptrdiff_t x,
     return 0;
   }
 
-  dip::MorphGrad2D(input, &kernel, &output10, x, y, 1,
+  dip::MorphGrad2D(&input, &kernel, &output10, x, y, 1,
                    dip::BOUNDARY_OPTION::REPLICATE_PADDING, 0.0);
 
   // Define a cv::Mat with the output of MorphGrad2D.
@@ -267,7 +267,7 @@ bool testImplementation(int argc, char *argv[], std::ptrdiff_t x,
     return 0;
   }
 
-  dip::BottomHat2D(input, &kernel, &output11, x, y, 1,
+  dip::BottomHat2D(&input, &kernel, &output11, x, y, 1,
                    dip::BOUNDARY_OPTION::REPLICATE_PADDING, 0);
   Mat outputImageReplicatePaddingbottomhat(sizesOutput[0], sizesOutput[1],
                                            CV_32FC1, output11.getData());
@@ -23,7 +23,16 @@
 
 #include "buddy/Core/Container.h"
 #include "buddy/DIP/ImageContainer.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
 #include <math.h>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
 namespace dip {
 // Availale types of boundary extrapolation techniques provided in DIP dialect.
 enum class BOUNDARY_OPTION { CONSTANT_PADDING, REPLICATE_PADDING };
@@ -36,9 +45,14 @@ enum class ANGLE_TYPE { DEGREE, RADIAN };
 // provided by the DIP dialect.
 enum class INTERPOLATION_TYPE {
   NEAREST_NEIGHBOUR_INTERPOLATION,
-  BILINEAR_INTERPOLATION
+  BILINEAR_INTERPOLATION,
+  AREA_INTERPOLATION,
+  BICUBIC_INTERPOLATION
 };
 
+// Available layouts of the image tensors produced for DNN inputs.
+enum class TENSOR_LAYOUT { NCHW, NHWC };
+
 namespace detail {
 // Functions present inside dip::detail are not meant to be called by users
 // directly.
@@ -53,6 +67,75 @@ void _mlir_ciface_corr_2d_replicate_padding(
     Img<float, 2> *input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
     unsigned int centerX, unsigned int centerY, float constantValue);
 
+// Declare the Corr2DSeparable C interface.
+void _mlir_ciface_corr_2d_separable_constant_padding(
+    Img<float, 2> *input, MemRef<float, 1> *kernelX, MemRef<float, 1> *kernelY,
+    MemRef<float, 2> *output, unsigned int centerX, unsigned int centerY,
+    float constantValue);
+
+void _mlir_ciface_corr_2d_separable_replicate_padding(
+    Img<float, 2> *input, MemRef<float, 1> *kernelX, MemRef<float, 1> *kernelY,
+    MemRef<float, 2> *output, unsigned int centerX, unsigned int centerY,
+    float constantValue);
+
+// Declare the IntegralImage, BoxFilter2D and GaussianBlur2D C interfaces.
+void _mlir_ciface_integral_image(Img<float, 2> *input,
+                                 MemRef<double, 2> *output);
+
+void _mlir_ciface_box_filter_constant_padding(
+    Img<float, 2> *input, MemRef<float, 2> *output, unsigned int kernelWidth,
+    unsigned int kernelHeight, unsigned int centerX, unsigned int centerY,
+    float constantValue);
+
+void _mlir_ciface_box_filter_replicate_padding(
+    Img<float, 2> *input, MemRef<float, 2> *output, unsigned int kernelWidth,
+    unsigned int kernelHeight, unsigned int centerX, unsigned int centerY,
+    float constantValue);
+
+void _mlir_ciface_gaussian_blur_constant_padding(Img<float, 2> *input,
+                                                 MemRef<float, 2> *output,
+                                                 float sigmaX, float sigmaY,
+                                                 float constantValue);
+
+void _mlir_ciface_gaussian_blur_replicate_padding(Img<float, 2> *input,
+                                                  MemRef<float, 2> *output,
+                                                  float sigmaX, float sigmaY,
+                                                  float constantValue);
+
+// Declare the Median2D and RankFilter2D C interfaces.
+void _mlir_ciface_median_2d_constant_padding(
+    Img<float, 2> *input, MemRef<float, 2> *output, unsigned int kernelSize,
+    float constantValue);
+
+void _mlir_ciface_median_2d_replicate_padding(
+    Img<float, 2> *input, MemRef<float, 2> *output, unsigned int kernelSize,
+    float constantValue);
+
+void _mlir_ciface_rank_filter_2d_constant_padding(
+    Img<float, 2> *input, MemRef<float, 2> *output, unsigned int kernelSize,
+    unsigned int rank, float constantValue);
+
+void _mlir_ciface_rank_filter_2d_replicate_padding(
+    Img<float, 2> *input, MemRef<float, 2> *output, unsigned int kernelSize,
+    unsigned int rank, float constantValue);
+
+// Declare the PyrDown and PyrUp C interfaces.
+void _mlir_ciface_pyr_down_constant_padding(Img<float, 2> *input,
+                                            MemRef<float, 2> *output,
+                                            float constantValue);
+
+void _mlir_ciface_pyr_down_replicate_padding(Img<float, 2> *input,
+                                             MemRef<float, 2> *output,
+                                             float constantValue);
+
+void _mlir_ciface_pyr_up_constant_padding(Img<float, 2> *input,
+                                          MemRef<float, 2> *output,
+                                          float constantValue);
+
+void _mlir_ciface_pyr_up_replicate_padding(Img<float, 2> *input,
+                                           MemRef<float, 2> *output,
+                                           float constantValue);
+
 void _mlir_ciface_corrfft_2d(MemRef<float, 2> *inputReal,
                              MemRef<float, 2> *inputImag,
                              MemRef<float, 2> *kernelReal,
@@ -60,6 +143,17 @@ void _mlir_ciface_corrfft_2d(MemRef<float, 2> *inputReal,
                              MemRef<float, 2> *intermediateReal,
                              MemRef<float, 2> *intermediateImag);
 
+void _mlir_ciface_fft_2d(MemRef<float, 2> *real, MemRef<float, 2> *imag,
+                         MemRef<float, 2> *intermediateReal,
+                         MemRef<float, 2> *intermediateImag);
+
+void _mlir_ciface_corrfft_2d_spectrum(MemRef<float, 2> *inputReal,
+                                      MemRef<float, 2> *inputImag,
+                                      MemRef<float, 2> *kernelSpectrumReal,
+                                      MemRef<float, 2> *kernelSpectrumImag,
+                                      MemRef<float, 2> *intermediateReal,
+                                      MemRef<float, 2> *intermediateImag);
+
 // Declare the Rotate2D C interface.
 void _mlir_ciface_rotate_2d(Img<float, 2> *input, float angleValue,
                             MemRef<float, 2> *output);
@@ -73,133 +167,718 @@ void _mlir_ciface_resize_2d_bilinear_interpolation(
     Img<float, 2> *input, float horizontalScalingFactor,
     float verticalScalingFactor, MemRef<float, 2> *output);
 
+void _mlir_ciface_resize_2d_area_interpolation(
+    Img<float, 2> *input, float horizontalScalingFactor,
+    float verticalScalingFactor, MemRef<float, 2> *output);
+
+void _mlir_ciface_resize_2d_bicubic_interpolation(
+    Img<float, 2> *input, float horizontalScalingFactor,
+    float verticalScalingFactor, MemRef<float, 2> *output);
+
+// Declare the Warp2D C interface.
+void _mlir_ciface_warp_affine_2d_constant_padding(Img<float, 2> *input,
+                                                  MemRef<float, 2> *matrix,
+                                                  MemRef<float, 2> *output,
+                                                  float constantValue);
+
+void _mlir_ciface_warp_affine_2d_replicate_padding(Img<float, 2> *input,
+                                                   MemRef<float, 2> *matrix,
+                                                   MemRef<float, 2> *output,
+                                                   float constantValue);
+
+void _mlir_ciface_warp_perspective_2d_constant_padding(
+    Img<float, 2> *input, MemRef<float, 2> *matrix, MemRef<float, 2> *output,
+    float constantValue);
+
+void _mlir_ciface_warp_perspective_2d_replicate_padding(
+    Img<float, 2> *input, MemRef<float, 2> *matrix, MemRef<float, 2> *output,
+    float constantValue);
+
+void _mlir_ciface_warp_map_2d(MemRef<float, 2> *matrix,
+                              MemRef<int32_t, 3> *map);
+
+void _mlir_ciface_remap_2d_constant_padding(Img<float, 2> *input,
+                                            MemRef<int32_t, 3> *map,
+                                            MemRef<float, 2> *output,
+                                            float constantValue);
+
+void _mlir_ciface_remap_2d_replicate_padding(Img<float, 2> *input,
+                                             MemRef<int32_t, 3> *map,
+                                             MemRef<float, 2> *output,
+                                             float constantValue);
+
 // Declare the Morphology 2D C interface.
 void _mlir_ciface_erosion_2d_constant_padding(
-    Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
+    Img<float, 2> *input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
     MemRef<float, 2> *copymemref, unsigned int centerX, unsigned int centerY,
     unsigned int iterations, float constantValue);
 
 void _mlir_ciface_erosion_2d_replicate_padding(
-    Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
+    Img<float, 2> *input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
     MemRef<float, 2> *copymemref, unsigned int centerX, unsigned int centerY,
     unsigned int iterations, float constantValue);
 
 void _mlir_ciface_dilation_2d_constant_padding(
-    Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
+    Img<float, 2> *input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
     MemRef<float, 2> *copymemref, unsigned int centerX, unsigned int centerY,
     unsigned int iterations, float constantValue);
 
 void _mlir_ciface_dilation_2d_replicate_padding(
-    Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
+    Img<float, 2> *input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
     MemRef<float, 2> *copymemref, unsigned int centerX, unsigned int centerY,
     unsigned int iterations, float constantValue);
 
 void _mlir_ciface_opening_2d_constant_padding(
-    Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
+    Img<float, 2> *input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
     MemRef<float, 2> *output1, MemRef<float, 2> *copymemref,
     MemRef<float, 2> *copymemref1, unsigned int centerX, unsigned int centerY,
     unsigned int iterations, float constantValue);
 
 void _mlir_ciface_opening_2d_replicate_padding(
-    Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
+    Img<float, 2> *input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
     MemRef<float, 2> *output1, MemRef<float, 2> *copymemref,
     MemRef<float, 2> *copymemref1, unsigned int centerX, unsigned int centerY,
     unsigned int iterations, float constantValue);
 
 void _mlir_ciface_closing_2d_constant_padding(
-    Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
+    Img<float, 2> *input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
     MemRef<float, 2> *output1, MemRef<float, 2> *copymemref,
     MemRef<float, 2> *copymemref1, unsigned int centerX, unsigned int centerY,
     unsigned int iterations, float constantValue);
 
 void _mlir_ciface_closing_2d_replicate_padding(
-    Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
+    Img<float, 2> *input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
     MemRef<float, 2> *output1, MemRef<float, 2> *copymemref,
     MemRef<float, 2> *copymemref1, unsigned int centerX, unsigned int centerY,
     unsigned int iterations, float constantValue);
 
 void _mlir_ciface_tophat_2d_constant_padding(
-    Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
+    Img<float, 2> *input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
     MemRef<float, 2> *output1, MemRef<float, 2> *output2,
     MemRef<float, 2> *input1, MemRef<float, 2> *copymemref,
     MemRef<float, 2> *copymemref1, unsigned int centerX, unsigned int centerY,
     unsigned int iterations, float constantValue);
 
 void _mlir_ciface_tophat_2d_replicate_padding(
-    Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
+    Img<float, 2> *input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
     MemRef<float, 2> *output1, MemRef<float, 2> *output2,
     MemRef<float, 2> *input1, MemRef<float, 2> *copymemref,
     MemRef<float, 2> *copymemref1, unsigned int centerX, unsigned int centerY,
     unsigned int iterations, float constantValue);
 
 void _mlir_ciface_bottomhat_2d_constant_padding(
-    Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
+    Img<float, 2> *input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
     MemRef<float, 2> *output1, MemRef<float, 2> *output2,
     MemRef<float, 2> *input1, MemRef<float, 2> *copymemref,
     MemRef<float, 2> *copymemref1, unsigned int centerX, unsigned int centerY,
     unsigned int iterations, float constantValue);
 
 void _mlir_ciface_bottomhat_2d_replicate_padding(
-    Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
+    Img<float, 2> *input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
     MemRef<float, 2> *output1, MemRef<float, 2> *output2,
     MemRef<float, 2> *input1, MemRef<float, 2> *copymemref,
     MemRef<float, 2> *copymemref1, unsigned int centerX, unsigned int centerY,
     unsigned int iterations, float constantValue);
 
 void _mlir_ciface_morphgrad_2d_constant_padding(
-    Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
+    Img<float, 2> *input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
     MemRef<float, 2> *output1, MemRef<float, 2> *output2,
     MemRef<float, 2> *input1, MemRef<float, 2> *copymemref,
     MemRef<float, 2> *copymemref1, unsigned int centerX, unsigned int centerY,
     unsigned int iterations, float constantValue);
 
 void _mlir_ciface_morphgrad_2d_replicate_padding(
-    Img<float, 2> input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
+    Img<float, 2> *input, MemRef<float, 2> *kernel, MemRef<float, 2> *output,
     MemRef<float, 2> *output1, MemRef<float, 2> *output2,
     MemRef<float, 2> *input1, MemRef<float, 2> *copymemref,
     MemRef<float, 2> *copymemref1, unsigned int centerX, unsigned int centerY,
     unsigned int iterations, float constantValue);
+
+// Declare the ImageToTensor C interface.
+void _mlir_ciface_image_to_tensor_nchw_nearest_neighbour_u8(
+    Img<uint8_t, 2> *input, MemRef<float, 4> *output, intptr_t batch,
+    float scale, MemRef<float, 1> *mean, MemRef<float, 1> *stdDev);
+
+void _mlir_ciface_image_to_tensor_nchw_bilinear_u8(
+    Img<uint8_t, 2> *input, MemRef<float, 4> *output, intptr_t batch,
+    float scale, MemRef<float, 1> *mean, MemRef<float, 1> *stdDev);
+
+void _mlir_ciface_image_to_tensor_nhwc_nearest_neighbour_u8(
+    Img<uint8_t, 2> *input, MemRef<float, 4> *output, intptr_t batch,
+    float scale, MemRef<float, 1> *mean, MemRef<float, 1> *stdDev);
+
+void _mlir_ciface_image_to_tensor_nhwc_bilinear_u8(
+    Img<uint8_t, 2> *input, MemRef<float, 4> *output, intptr_t batch,
+    float scale, MemRef<float, 1> *mean, MemRef<float, 1> *stdDev);
+
+void _mlir_ciface_image_to_tensor_nchw_nearest_neighbour_u8_hwc(
+    Img<uint8_t, 3> *input, MemRef<float, 4> *output, intptr_t batch,
+    float scale, MemRef<float, 1> *mean, MemRef<float, 1> *stdDev);
+
+void _mlir_ciface_image_to_tensor_nchw_nearest_neighbour_u8_hwc_swap_rb(
+    Img<uint8_t, 3> *input, MemRef<float, 4> *output, intptr_t batch,
+    float scale, MemRef<float, 1> *mean, MemRef<float, 1> *stdDev);
+
+void _mlir_ciface_image_to_tensor_nchw_bilinear_u8_hwc(
+    Img<uint8_t, 3> *input, MemRef<float, 4> *output, intptr_t batch,
+    float scale, MemRef<float, 1> *mean, MemRef<float, 1> *stdDev);
+
+void _mlir_ciface_image_to_tensor_nchw_bilinear_u8_hwc_swap_rb(
+    Img<uint8_t, 3> *input, MemRef<float, 4> *output, intptr_t batch,
+    float scale, MemRef<float, 1> *mean, MemRef<float, 1> *stdDev);
+
+void _mlir_ciface_image_to_tensor_nhwc_nearest_neighbour_u8_hwc(
+    Img<uint8_t, 3> *input, MemRef<float, 4> *output, intptr_t batch,
+    float scale, MemRef<float, 1> *mean, MemRef<float, 1> *stdDev);
+
+void _mlir_ciface_image_to_tensor_nhwc_nearest_neighbour_u8_hwc_swap_rb(
+    Img<uint8_t, 3> *input, MemRef<float, 4> *output, intptr_t batch,
+    float scale, MemRef<float, 1> *mean, MemRef<float, 1> *stdDev);
+
+void _mlir_ciface_image_to_tensor_nhwc_bilinear_u8_hwc(
+    Img<uint8_t, 3> *input, MemRef<float, 4> *output, intptr_t batch,
+    float scale, MemRef<float, 1> *mean, MemRef<float, 1> *stdDev);
+
+void _mlir_ciface_image_to_tensor_nhwc_bilinear_u8_hwc_swap_rb(
+    Img<uint8_t, 3> *input, MemRef<float, 4> *output, intptr_t batch,
+    float scale, MemRef<float, 1> *mean, MemRef<float, 1> *stdDev);
+
+// Declare the C interfaces of the 8-bit filters, histograms and lookup
+// tables.
+void _mlir_ciface_integral_image_u8(Img<uint8_t, 2> *input,
+                                    MemRef<int32_t, 2> *output);
+
+void _mlir_ciface_box_filter_constant_padding_u8(
+    Img<uint8_t, 2> *input, MemRef<uint8_t, 2> *output,
+    unsigned int kernelWidth, unsigned int kernelHeight, unsigned int centerX,
+    unsigned int centerY, uint8_t constantValue);
+
+void _mlir_ciface_box_filter_replicate_padding_u8(
+    Img<uint8_t, 2> *input, MemRef<uint8_t, 2> *output,
+    unsigned int kernelWidth, unsigned int kernelHeight, unsigned int centerX,
+    unsigned int centerY, uint8_t constantValue);
+
+void _mlir_ciface_gaussian_blur_constant_padding_u8(Img<uint8_t, 2> *input,
+                                                    MemRef<uint8_t, 2> *output,
+                                                    float sigmaX, float sigmaY,
+                                                    uint8_t constantValue);
+
+void _mlir_ciface_gaussian_blur_replicate_padding_u8(
+    Img<uint8_t, 2> *input, MemRef<uint8_t, 2> *output, float sigmaX,
+    float sigmaY, uint8_t constantValue);
+
+void _mlir_ciface_median_2d_constant_padding_u8(
+    Img<uint8_t, 2> *input, MemRef<uint8_t, 2> *output, unsigned int kernelSize,
+    uint8_t constantValue);
+
+void _mlir_ciface_median_2d_replicate_padding_u8(
+    Img<uint8_t, 2> *input, MemRef<uint8_t, 2> *output, unsigned int kernelSize,
+    uint8_t constantValue);
+
+void _mlir_ciface_rank_filter_2d_constant_padding_u8(
+    Img<uint8_t, 2> *input, MemRef<uint8_t, 2> *output, unsigned int kernelSize,
+    unsigned int rank, uint8_t constantValue);
+
+void _mlir_ciface_rank_filter_2d_replicate_padding_u8(
+    Img<uint8_t, 2> *input, MemRef<uint8_t, 2> *output, unsigned int kernelSize,
+    unsigned int rank, uint8_t constantValue);
+
+void _mlir_ciface_pyr_down_constant_padding_u8(Img<uint8_t, 2> *input,
+                                               MemRef<uint8_t, 2> *output,
+                                               uint8_t constantValue);
+
+void _mlir_ciface_pyr_down_replicate_padding_u8(Img<uint8_t, 2> *input,
+                                                MemRef<uint8_t, 2> *output,
+                                                uint8_t constantValue);
+
+void _mlir_ciface_pyr_up_constant_padding_u8(Img<uint8_t, 2> *input,
+                                             MemRef<uint8_t, 2> *output,
+                                             uint8_t constantValue);
+
+void _mlir_ciface_pyr_up_replicate_padding_u8(Img<uint8_t, 2> *input,
+                                              MemRef<uint8_t, 2> *output,
+                                              uint8_t constantValue);
+
+void _mlir_ciface_histogram_u8(Img<uint8_t, 2> *input,
+                               MemRef<int32_t, 1> *hist);
+
+void _mlir_ciface_equalize_hist_u8(Img<uint8_t, 2> *input,
+                                   MemRef<uint8_t, 2> *output);
+
+void _mlir_ciface_apply_lut_u8(Img<uint8_t, 2> *input, MemRef<uint8_t, 1> *lut,
+                               MemRef<uint8_t, 2> *output);
+
+void _mlir_ciface_apply_lut_u8_hwc(Img<uint8_t, 3> *input,
+                                   MemRef<uint8_t, 1> *lut,
+                                   MemRef<uint8_t, 3> *output);
+
+void _mlir_ciface_apply_lut_u8_f32(Img<uint8_t, 2> *input,
+                                   MemRef<float, 1> *lut,
+                                   MemRef<float, 2> *output);
 }
 
-// Pad kernel as per the requirements for using FFT in convolution.
-inline void padKernel(MemRef<float, 2> *kernel, unsigned int centerX,
-                      unsigned int centerY, intptr_t *paddedSizes,
-                      MemRef<float, 2> *kernelPaddedReal) {
-  // Apply padding so that the center of kernel is at top left of 2D padded
-  // container.
-  for (long i = -static_cast<long>(centerY);
-       i < static_cast<long>(kernel->getSizes()[0]) - centerY; ++i) {
-    uint32_t r = (i < 0) ? (i + paddedSizes[0]) : i;
-    for (long j = -static_cast<long>(centerX);
-         j < static_cast<long>(kernel->getSizes()[1]) - centerX; ++j) {
-      uint32_t c = (j < 0) ? (j + paddedSizes[1]) : j;
-      kernelPaddedReal->getData()[r * paddedSizes[1] + c] =
-          kernel
-              ->getData()[(i + centerY) * kernel->getSizes()[1] + j + centerX];
-    }
+// C interfaces of the 8-bit and 16-bit variants, declared for every pixel type
+// `T` (with kernels of type `K`) and rank `N`: 2 for single channel images and
+// 3 for interleaved HWC images. `IntegerInterfaces<T, N>` names them for the
+// dispatching functions below.
+template <typename T, size_t N> struct IntegerInterfaces;
+
+#define DIP_DECLARE_INTEGER_INTERFACES(SUFFIX, T, K, N)                        \
+  extern "C" {                                                                 \
+  void _mlir_ciface_resize_2d_nearest_neighbour_interpolation_##SUFFIX(        \
+      Img<T, N> *input, float horizontalScalingFactor,                         \
+      float verticalScalingFactor, MemRef<T, N> *output);                      \
+  void _mlir_ciface_resize_2d_bilinear_interpolation_##SUFFIX(                 \
+      Img<T, N> *input, float horizontalScalingFactor,                         \
+      float verticalScalingFactor, MemRef<T, N> *output);                      \
+  void _mlir_ciface_resize_2d_area_interpolation_##SUFFIX(                     \
+      Img<T, N> *input, float horizontalScalingFactor,                         \
+      float verticalScalingFactor, MemRef<T, N> *output);                      \
+  void _mlir_ciface_resize_2d_bicubic_interpolation_##SUFFIX(                  \
+      Img<T, N> *input, float horizontalScalingFactor,                         \
+      float verticalScalingFactor, MemRef<T, N> *output);                      \
+  void _mlir_ciface_corr_2d_separable_constant_padding_##SUFFIX(               \
+      Img<T, N> *input, MemRef<K, 1> *kernelX, MemRef<K, 1> *kernelY,          \
+      MemRef<T, N> *output, unsigned int centerX, unsigned int centerY,        \
+      T constantValue);                                                        \
+  void _mlir_ciface_corr_2d_separable_replicate_padding_##SUFFIX(              \
+      Img<T, N> *input, MemRef<K, 1> *kernelX, MemRef<K, 1> *kernelY,          \
+      MemRef<T, N> *output, unsigned int centerX, unsigned int centerY,        \
+      T constantValue);                                                        \
+  void _mlir_ciface_warp_affine_2d_constant_padding_##SUFFIX(                  \
+      Img<T, N> *input, MemRef<float, 2> *matrix, MemRef<T, N> *output,        \
+      T constantValue);                                                        \
+  void _mlir_ciface_warp_affine_2d_replicate_padding_##SUFFIX(                 \
+      Img<T, N> *input, MemRef<float, 2> *matrix, MemRef<T, N> *output,        \
+      T constantValue);                                                        \
+  void _mlir_ciface_warp_perspective_2d_constant_padding_##SUFFIX(             \
+      Img<T, N> *input, MemRef<float, 2> *matrix, MemRef<T, N> *output,        \
+      T constantValue);                                                        \
+  void _mlir_ciface_warp_perspective_2d_replicate_padding_##SUFFIX(            \
+      Img<T, N> *input, MemRef<float, 2> *matrix, MemRef<T, N> *output,        \
+      T constantValue);                                                        \
+  void _mlir_ciface_remap_2d_constant_padding_##SUFFIX(                        \
+      Img<T, N> *input, MemRef<int32_t, 3> *map, MemRef<T, N> *output,         \
+      T constantValue);                                                        \
+  void _mlir_ciface_remap_2d_replicate_padding_##SUFFIX(                       \
+      Img<T, N> *input, MemRef<int32_t, 3> *map, MemRef<T, N> *output,         \
+      T constantValue);                                                        \
+  }                                                                            \
+  template <> struct IntegerInterfaces<T, N> {                                 \
+    using Kernel = K;                                                          \
+    static constexpr auto resizeNearest =                                      \
+        _mlir_ciface_resize_2d_nearest_neighbour_interpolation_##SUFFIX;       \
+    static constexpr auto resizeBilinear =                                     \
+        _mlir_ciface_resize_2d_bilinear_interpolation_##SUFFIX;                \
+    static constexpr auto resizeArea =                                         \
+        _mlir_ciface_resize_2d_area_interpolation_##SUFFIX;                    \
+    static constexpr auto resizeBicubic =                                      \
+        _mlir_ciface_resize_2d_bicubic_interpolation_##SUFFIX;                 \
+    static constexpr auto corr2DSeparableConstant =                            \
+        _mlir_ciface_corr_2d_separable_constant_padding_##SUFFIX;              \
+    static constexpr auto corr2DSeparableReplicate =                           \
+        _mlir_ciface_corr_2d_separable_replicate_padding_##SUFFIX;             \
+    static constexpr auto warpAffineConstant =                                 \
+        _mlir_ciface_warp_affine_2d_constant_padding_##SUFFIX;                 \
+    static constexpr auto warpAffineReplicate =                                \
+        _mlir_ciface_warp_affine_2d_replicate_padding_##SUFFIX;                \
+    static constexpr auto warpPerspectiveConstant =                            \
+        _mlir_ciface_warp_perspective_2d_constant_padding_##SUFFIX;            \
+    static constexpr auto warpPerspectiveReplicate =                           \
+        _mlir_ciface_warp_perspective_2d_replicate_padding_##SUFFIX;           \
+    static constexpr auto remapConstant =                                      \
+        _mlir_ciface_remap_2d_constant_padding_##SUFFIX;                       \
+    static constexpr auto remapReplicate =                                     \
+        _mlir_ciface_remap_2d_replicate_padding_##SUFFIX;                      \
+  };
+
+DIP_DECLARE_INTEGER_INTERFACES(u8, uint8_t, int8_t, 2)
+DIP_DECLARE_INTEGER_INTERFACES(u16, uint16_t, int16_t, 2)
+DIP_DECLARE_INTEGER_INTERFACES(u8_hwc, uint8_t, int8_t, 3)
+DIP_DECLARE_INTEGER_INTERFACES(u16_hwc, uint16_t, int16_t, 3)
+#undef DIP_DECLARE_INTEGER_INTERFACES
+
+// Size of a padded FFT dimension holding at least `n` elements: the smallest
+// size of the form 2^a * 3^b * 5^c, which the mixed-radix FFT handles directly.
+inline intptr_t fftPaddedSize(intptr_t n) {
+  for (intptr_t size = std::max<intptr_t>(n, 1);; ++size) {
+    intptr_t remaining = size;
+    for (intptr_t radix : {2, 3, 5})
+      while (remaining % radix == 0)
+        remaining /= radix;
+    if (remaining == 1)
+      return size;
+  }
+}
+
+// Inverts the row-major 2x3 (`rows` = 2) or 3x3 (`rows` = 3) transformation
+// `matrix`, so that it maps output coordinates to input coordinates as the
+// warping operations expect.
+inline MemRef<float, 2> inverseWarpMatrix(const float *matrix, intptr_t rows) {
+  double m[9] = {0, 0, 0, 0, 0, 0, 0, 0, 1};
+  std::copy(matrix, matrix + rows * 3, m);
+  double cof[9] = {m[4] * m[8] - m[5] * m[7], m[2] * m[7] - m[1] * m[8],
+                   m[1] * m[5] - m[2] * m[4], m[5] * m[6] - m[3] * m[8],
+                   m[0] * m[8] - m[2] * m[6], m[2] * m[3] - m[0] * m[5],
+                   m[3] * m[7] - m[4] * m[6], m[1] * m[6] - m[0] * m[7],
+                   m[0] * m[4] - m[1] * m[3]};
+  double det = m[0] * cof[0] + m[1] * cof[3] + m[2] * cof[6];
+  if (det == 0)
+    throw std::invalid_argument("The transformation matrix is singular.\n");
+  float inverse[9];
+  for (int i = 0; i < 9; ++i)
+    inverse[i] = static_cast<float>(cof[i] / det);
+  intptr_t sizes[2] = {rows, 3};
+  return MemRef<float, 2>(inverse, sizes);
+}
+
+// Keeps a parameter out of template argument deduction, so that constants of
+// any integer type convert to the pixel type.
+template <typename T> struct NonDeducedImpl {
+  using type = T;
+};
+template <typename T> using NonDeduced = typename NonDeducedImpl<T>::type;
+
+// Dispatches the floating-point 2D Resize on the interpolation type.
+inline void resize2DInterface(Img<float, 2> *input, INTERPOLATION_TYPE type,
+                              float horizontalScalingFactor,
+                              float verticalScalingFactor,
+                              MemRef<float, 2> *output) {
+  switch (type) {
+  case INTERPOLATION_TYPE::NEAREST_NEIGHBOUR_INTERPOLATION:
+    return _mlir_ciface_resize_2d_nearest_neighbour_interpolation(
+        input, horizontalScalingFactor, verticalScalingFactor, output);
+  case INTERPOLATION_TYPE::BILINEAR_INTERPOLATION:
+    return _mlir_ciface_resize_2d_bilinear_interpolation(
+        input, horizontalScalingFactor, verticalScalingFactor, output);
+  case INTERPOLATION_TYPE::AREA_INTERPOLATION:
+    return _mlir_ciface_resize_2d_area_interpolation(
+        input, horizontalScalingFactor, verticalScalingFactor, output);
+  case INTERPOLATION_TYPE::BICUBIC_INTERPOLATION:
+    return _mlir_ciface_resize_2d_bicubic_interpolation(
+        input, horizontalScalingFactor, verticalScalingFactor, output);
+  }
+  throw std::invalid_argument(
+      "Please chose a supported type of interpolation "
+      "(Nearest neighbour, Bilinear, Area or Bicubic interpolation)\n");
+}
+
+// Dispatches the 8-bit and 16-bit variants of the operations on the type of
+// the image and on the runtime option. Options outside of the enumerations
+// throw std::invalid_argument.
+template <typename T, size_t N>
+void resize2DInterface(Img<T, N> *input, INTERPOLATION_TYPE type,
+                       float horizontalScalingFactor,
+                       float verticalScalingFactor, MemRef<T, N> *output) {
+  using Interfaces = IntegerInterfaces<T, N>;
+  switch (type) {
+  case INTERPOLATION_TYPE::NEAREST_NEIGHBOUR_INTERPOLATION:
+    return Interfaces::resizeNearest(input, horizontalScalingFactor,
+                                     verticalScalingFactor, output);
+  case INTERPOLATION_TYPE::BILINEAR_INTERPOLATION:
+    return Interfaces::resizeBilinear(input, horizontalScalingFactor,
+                                      verticalScalingFactor, output);
+  case INTERPOLATION_TYPE::AREA_INTERPOLATION:
+    return Interfaces::resizeArea(input, horizontalScalingFactor,
+                                  verticalScalingFactor, output);
+  case INTERPOLATION_TYPE::BICUBIC_INTERPOLATION:
+    return Interfaces::resizeBicubic(input, horizontalScalingFactor,
+                                     verticalScalingFactor, output);
   }
+  throw std::invalid_argument(
+      "Please chose a supported type of interpolation "
+      "(Nearest neighbour, Bilinear, Area or Bicubic interpolation)\n");
+}
+
+template <typename T, typename K, size_t N>
+void corr2DSeparableInterface(Img<T, N> *input, MemRef<K, 1> *kernelX,
+                              MemRef<K, 1> *kernelY, MemRef<T, N> *output,
+                              unsigned int centerX, unsigned int centerY,
+                              BOUNDARY_OPTION option,
+                              NonDeduced<T> constantValue) {
+  using Interfaces = IntegerInterfaces<T, N>;
+  static_assert(std::is_same_v<K, typename Interfaces::Kernel>,
+                "Kernels are signed integers of the pixel width.");
+  if (option == BOUNDARY_OPTION::CONSTANT_PADDING)
+    return Interfaces::corr2DSeparableConstant(input, kernelX, kernelY, output,
+                                               centerX, centerY, constantValue);
+  if (option == BOUNDARY_OPTION::REPLICATE_PADDING)
+    return Interfaces::corr2DSeparableReplicate(input, kernelX, kernelY, output,
+                                                centerX, centerY, 0);
+  throw std::invalid_argument("Please chose a supported boundary option.\n");
 }
 
-// Helper function for applying 2D resize operation on images.
-inline MemRef<float, 2> Resize2D_Impl(Img<float, 2> *input,
-                                      INTERPOLATION_TYPE type,
-                                      std::vector<float> scalingRatios,
-                                      intptr_t outputSize[2]) {
-  MemRef<float, 2> output(outputSize);
+template <typename T, size_t N>
+void warpAffine2DInterface(Img<T, N> *input, MemRef<float, 2> *matrix,
+                           MemRef<T, N> *output, BOUNDARY_OPTION option,
+                           NonDeduced<T> constantValue) {
+  using Interfaces = IntegerInterfaces<T, N>;
+  if (option == BOUNDARY_OPTION::CONSTANT_PADDING)
+    return Interfaces::warpAffineConstant(input, matrix, output,
+                                          constantValue);
+  if (option == BOUNDARY_OPTION::REPLICATE_PADDING)
+    return Interfaces::warpAffineReplicate(input, matrix, output, 0);
+  throw std::invalid_argument("Please chose a supported boundary option.\n");
+}
+
+template <typename T, size_t N>
+void warpPerspective2DInterface(Img<T, N> *input, MemRef<float, 2> *matrix,
+                                MemRef<T, N> *output, BOUNDARY_OPTION option,
+                                NonDeduced<T> constantValue) {
+  using Interfaces = IntegerInterfaces<T, N>;
+  if (option == BOUNDARY_OPTION::CONSTANT_PADDING)
+    return Interfaces::warpPerspectiveConstant(input, matrix, output,
+                                               constantValue);
+  if (option == BOUNDARY_OPTION::REPLICATE_PADDING)
+    return Interfaces::warpPerspectiveReplicate(input, matrix, output, 0);
+  throw std::invalid_argument("Please chose a supported boundary option.\n");
+}
+
+template <typename T, size_t N>
+void remap2DInterface(Img<T, N> *input, MemRef<int32_t, 3> *map,
+                      MemRef<T, N> *output, BOUNDARY_OPTION option,
+                      NonDeduced<T> constantValue) {
+  using Interfaces = IntegerInterfaces<T, N>;
+  if (option == BOUNDARY_OPTION::CONSTANT_PADDING)
+    return Interfaces::remapConstant(input, map, output, constantValue);
+  if (option == BOUNDARY_OPTION::REPLICATE_PADDING)
+    return Interfaces::remapReplicate(input, map, output, 0);
+  throw std::invalid_argument("Please chose a supported boundary option.\n");
+}
 
-  if (type == INTERPOLATION_TYPE::NEAREST_NEIGHBOUR_INTERPOLATION) {
-    detail::_mlir_ciface_resize_2d_nearest_neighbour_interpolation(
-        input, scalingRatios[0], scalingRatios[1], &output);
-  } else if (type == INTERPOLATION_TYPE::BILINEAR_INTERPOLATION) {
-    detail::_mlir_ciface_resize_2d_bilinear_interpolation(
-        input, scalingRatios[0], scalingRatios[1], &output);
-  } else {
+inline void boxFilterInterface(Img<float, 2> *input, MemRef<float, 2> *output,
+                               unsigned int kernelWidth,
+                               unsigned int kernelHeight, unsigned int centerX,
+                               unsigned int centerY, BOUNDARY_OPTION option,
+                               float constantValue) {
+  if (option == BOUNDARY_OPTION::CONSTANT_PADDING)
+    return _mlir_ciface_box_filter_constant_padding(input, output, kernelWidth,
+                                                    kernelHeight, centerX,
+                                                    centerY, constantValue);
+  if (option == BOUNDARY_OPTION::REPLICATE_PADDING)
+    return _mlir_ciface_box_filter_replicate_padding(
+        input, output, kernelWidth, kernelHeight, centerX, centerY, 0);
+  throw std::invalid_argument("Please chose a supported boundary option.\n");
+}
+
+inline void boxFilterInterface(Img<uint8_t, 2> *input,
+                               MemRef<uint8_t, 2> *output,
+                               unsigned int kernelWidth,
+                               unsigned int kernelHeight, unsigned int centerX,
+                               unsigned int centerY, BOUNDARY_OPTION option,
+                               uint8_t constantValue) {
+  if (option == BOUNDARY_OPTION::CONSTANT_PADDING)
+    return _mlir_ciface_box_filter_constant_padding_u8(
+        input, output, kernelWidth, kernelHeight, centerX, centerY,
+        constantValue);
+  if (option == BOUNDARY_OPTION::REPLICATE_PADDING)
+    return _mlir_ciface_box_filter_replicate_padding_u8(
+        input, output, kernelWidth, kernelHeight, centerX, centerY, 0);
+  throw std::invalid_argument("Please chose a supported boundary option.\n");
+}
+
+inline void gaussianBlurInterface(Img<float, 2> *input,
+                                  MemRef<float, 2> *output, float sigmaX,
+                                  float sigmaY, BOUNDARY_OPTION option,
+                                  float constantValue) {
+  if (option == BOUNDARY_OPTION::CONSTANT_PADDING)
+    return _mlir_ciface_gaussian_blur_constant_padding(input, output, sigmaX,
+                                                       sigmaY, constantValue);
+  if (option == BOUNDARY_OPTION::REPLICATE_PADDING)
+    return _mlir_ciface_gaussian_blur_replicate_padding(input, output, sigmaX,
+                                                        sigmaY, 0);
+  throw std::invalid_argument("Please chose a supported boundary option.\n");
+}
+
+inline void gaussianBlurInterface(Img<uint8_t, 2> *input,
+                                  MemRef<uint8_t, 2> *output, float sigmaX,
+                                  float sigmaY, BOUNDARY_OPTION option,
+                                  uint8_t constantValue) {
+  if (option == BOUNDARY_OPTION::CONSTANT_PADDING)
+    return _mlir_ciface_gaussian_blur_constant_padding_u8(
+        input, output, sigmaX, sigmaY, constantValue);
+  if (option == BOUNDARY_OPTION::REPLICATE_PADDING)
+    return _mlir_ciface_gaussian_blur_replicate_padding_u8(input, output,
+                                                           sigmaX, sigmaY, 0);
+  throw std::invalid_argument("Please chose a supported boundary option.\n");
+}
+
+inline void median2DInterface(Img<float, 2> *input, MemRef<float, 2> *output,
+                              unsigned int kernelSize, BOUNDARY_OPTION option,
+                              float constantValue) {
+  if (option == BOUNDARY_OPTION::CONSTANT_PADDING)
+    return _mlir_ciface_median_2d_constant_padding(input, output, kernelSize,
+                                                   constantValue);
+  if (option == BOUNDARY_OPTION::REPLICATE_PADDING)
+    return _mlir_ciface_median_2d_replicate_padding(input, output, kernelSize,
+                                                    0);
+  throw std::invalid_argument("Please chose a supported boundary option.\n");
+}
+
+inline void rankFilter2DInterface(Img<float, 2> *input,
+                                  MemRef<float, 2> *output,
+                                  unsigned int kernelSize, unsigned int rank,
+                                  BOUNDARY_OPTION option, float constantValue) {
+  if (option == BOUNDARY_OPTION::CONSTANT_PADDING)
+    return _mlir_ciface_rank_filter_2d_constant_padding(
+        input, output, kernelSize, rank, constantValue);
+  if (option == BOUNDARY_OPTION::REPLICATE_PADDING)
+    return _mlir_ciface_rank_filter_2d_replicate_padding(input, output,
+                                                         kernelSize, rank, 0);
+  throw std::invalid_argument("Please chose a supported boundary option.\n");
+}
+
+inline void median2DInterface(Img<uint8_t, 2> *input,
+                              MemRef<uint8_t, 2> *output,
+                              unsigned int kernelSize, BOUNDARY_OPTION option,
+                              uint8_t constantValue) {
+  if (option == BOUNDARY_OPTION::CONSTANT_PADDING)
+    return _mlir_ciface_median_2d_constant_padding_u8(input, output, kernelSize,
+                                                      constantValue);
+  if (option == BOUNDARY_OPTION::REPLICATE_PADDING)
+    return _mlir_ciface_median_2d_replicate_padding_u8(input, output,
+                                                       kernelSize, 0);
+  throw std::invalid_argument("Please chose a supported boundary option.\n");
+}
+
+inline void rankFilter2DInterface(Img<uint8_t, 2> *input,
+                                  MemRef<uint8_t, 2> *output,
+                                  unsigned int kernelSize, unsigned int rank,
+                                  BOUNDARY_OPTION option,
+                                  uint8_t constantValue) {
+  if (option == BOUNDARY_OPTION::CONSTANT_PADDING)
+    return _mlir_ciface_rank_filter_2d_constant_padding_u8(
+        input, output, kernelSize, rank, constantValue);
+  if (option == BOUNDARY_OPTION::REPLICATE_PADDING)
+    return _mlir_ciface_rank_filter_2d_replicate_padding_u8(
+        input, output, kernelSize, rank, 0);
+  throw std::invalid_argument("Please chose a supported boundary option.\n");
+}
+
+inline void pyrDownInterface(Img<float, 2> *input, MemRef<float, 2> *output,
+                             BOUNDARY_OPTION option, float constantValue) {
+  if (option == BOUNDARY_OPTION::CONSTANT_PADDING)
+    return _mlir_ciface_pyr_down_constant_padding(input, output, constantValue);
+  if (option == BOUNDARY_OPTION::REPLICATE_PADDING)
+    return _mlir_ciface_pyr_down_replicate_padding(input, output, 0);
+  throw std::invalid_argument("Please chose a supported boundary option.\n");
+}
+
+inline void pyrUpInterface(Img<float, 2> *input, MemRef<float, 2> *output,
+                           BOUNDARY_OPTION option, float constantValue) {
+  if (option == BOUNDARY_OPTION::CONSTANT_PADDING)
+    return _mlir_ciface_pyr_up_constant_padding(input, output, constantValue);
+  if (option == BOUNDARY_OPTION::REPLICATE_PADDING)
+    return _mlir_ciface_pyr_up_replicate_padding(input, output, 0);
+  throw std::invalid_argument("Please chose a supported boundary option.\n");
+}
+
+inline void pyrDownInterface(Img<uint8_t, 2> *input,
+                             MemRef<uint8_t, 2> *output,
+                             BOUNDARY_OPTION option, uint8_t constantValue) {
+  if (option == BOUNDARY_OPTION::CONSTANT_PADDING)
+    return _mlir_ciface_pyr_down_constant_padding_u8(input, output,
+                                                     constantValue);
+  if (option == BOUNDARY_OPTION::REPLICATE_PADDING)
+    return _mlir_ciface_pyr_down_replicate_padding_u8(input, output, 0);
+  throw std::invalid_argument("Please chose a supported boundary option.\n");
+}
+
+inline void pyrUpInterface(Img<uint8_t, 2> *input, MemRef<uint8_t, 2> *output,
+                           BOUNDARY_OPTION option, uint8_t constantValue) {
+  if (option == BOUNDARY_OPTION::CONSTANT_PADDING)
+    return _mlir_ciface_pyr_up_constant_padding_u8(input, output,
+                                                   constantValue);
+  if (option == BOUNDARY_OPTION::REPLICATE_PADDING)
+    return _mlir_ciface_pyr_up_replicate_padding_u8(input, output, 0);
+  throw std::invalid_argument("Please chose a supported boundary option.\n");
+}
+
+inline void applyLutInterface(Img<uint8_t, 2> *input, MemRef<uint8_t, 1> *lut,
+                              MemRef<uint8_t, 2> *output) {
+  _mlir_ciface_apply_lut_u8(input, lut, output);
+}
+
+inline void applyLutInterface(Img<uint8_t, 3> *input, MemRef<uint8_t, 1> *lut,
+                              MemRef<uint8_t, 3> *output) {
+  _mlir_ciface_apply_lut_u8_hwc(input, lut, output);
+}
+
+inline void applyLutInterface(Img<uint8_t, 2> *input, MemRef<float, 1> *lut,
+                              MemRef<float, 2> *output) {
+  _mlir_ciface_apply_lut_u8_f32(input, lut, output);
+}
+
+inline void imageToTensorInterface(Img<uint8_t, 2> *input,
+                                   MemRef<float, 4> *output,
+                                   TENSOR_LAYOUT layout,
+                                   INTERPOLATION_TYPE type, bool,
+                                   intptr_t batch, float scale,
+                                   MemRef<float, 1> *mean,
+                                   MemRef<float, 1> *stdDev) {
+  bool nearest = type == INTERPOLATION_TYPE::NEAREST_NEIGHBOUR_INTERPOLATION;
+  if (!nearest && type != INTERPOLATION_TYPE::BILINEAR_INTERPOLATION) {
     throw std::invalid_argument(
         "Please chose a supported type of interpolation "
-        "(Nearest neighbour interpolation or Bilinear interpolation)\n");
+        "(Nearest neighbour or Bilinear interpolation)\n");
   }
+  if (layout == TENSOR_LAYOUT::NCHW) {
+    if (nearest)
+      return _mlir_ciface_image_to_tensor_nchw_nearest_neighbour_u8(
+          input, output, batch, scale, mean, stdDev);
+    return _mlir_ciface_image_to_tensor_nchw_bilinear_u8(
+        input, output, batch, scale, mean, stdDev);
+  }
+  if (layout == TENSOR_LAYOUT::NHWC) {
+    if (nearest)
+      return _mlir_ciface_image_to_tensor_nhwc_nearest_neighbour_u8(
+          input, output, batch, scale, mean, stdDev);
+    return _mlir_ciface_image_to_tensor_nhwc_bilinear_u8(
+        input, output, batch, scale, mean, stdDev);
+  }
+  throw std::invalid_argument("Please chose a supported tensor layout.\n");
+}
 
-  return output;
+inline void imageToTensorInterface(Img<uint8_t, 3> *input,
+                                   MemRef<float, 4> *output,
+                                   TENSOR_LAYOUT layout,
+                                   INTERPOLATION_TYPE type, bool swapRB,
+                                   intptr_t batch, float scale,
+                                   MemRef<float, 1> *mean,
+                                   MemRef<float, 1> *stdDev) {
+  bool nearest = type == INTERPOLATION_TYPE::NEAREST_NEIGHBOUR_INTERPOLATION;
+  if (!nearest && type != INTERPOLATION_TYPE::BILINEAR_INTERPOLATION) {
+    throw std::invalid_argument(
+        "Please chose a supported type of interpolation "
+        "(Nearest neighbour or Bilinear interpolation)\n");
+  }
+  if (layout == TENSOR_LAYOUT::NCHW) {
+    if (nearest && swapRB)
+      return _mlir_ciface_image_to_tensor_nchw_nearest_neighbour_u8_hwc_swap_rb(
+          input, output, batch, scale, mean, stdDev);
+    if (nearest)
+      return _mlir_ciface_image_to_tensor_nchw_nearest_neighbour_u8_hwc(
+          input, output, batch, scale, mean, stdDev);
+    if (swapRB)
+      return _mlir_ciface_image_to_tensor_nchw_bilinear_u8_hwc_swap_rb(
+          input, output, batch, scale, mean, stdDev);
+    return _mlir_ciface_image_to_tensor_nchw_bilinear_u8_hwc(
+        input, output, batch, scale, mean, stdDev);
+  }
+  if (layout == TENSOR_LAYOUT::NHWC) {
+    if (nearest && swapRB)
+      return _mlir_ciface_image_to_tensor_nhwc_nearest_neighbour_u8_hwc_swap_rb(
+          input, output, batch, scale, mean, stdDev);
+    if (nearest)
+      return _mlir_ciface_image_to_tensor_nhwc_nearest_neighbour_u8_hwc(
+          input, output, batch, scale, mean, stdDev);
+    if (swapRB)
+      return _mlir_ciface_image_to_tensor_nhwc_bilinear_u8_hwc_swap_rb(
+          input, output, batch, scale, mean, stdDev);
+    return _mlir_ciface_image_to_tensor_nhwc_bilinear_u8_hwc(
+        input, output, batch, scale, mean, stdDev);
+  }
+  throw std::invalid_argument("Please chose a supported tensor layout.\n");
 }
 } // namespace detail
 
@@ -217,84 +896,144 @@ inline void Corr2D(Img<float, 2> *input, MemRef<float, 2> *kernel,
   }
 }
 
-inline void CorrFFT2D(Img<float, 2> *input, MemRef<float, 2> *kernel,
-                      MemRef<float, 2> *output, unsigned int centerX,
-                      unsigned int centerY, BOUNDARY_OPTION option,
-                      float constantValue = 0) {
-  // Calculate padding sizes.
-  intptr_t paddedSizes[2] = {
-      1 << static_cast<intptr_t>(
-          ceil(log2(input->getSizes()[0] + kernel->getSizes()[0] - 1))),
-      1 << static_cast<intptr_t>(
-          ceil(log2(input->getSizes()[1] + kernel->getSizes()[1] - 1)))};
-  intptr_t paddedTSizes[2] = {paddedSizes[1], paddedSizes[0]};
-
-  // Declare padded containers for input image and kernel.
-  // Also declare an intermediate container for calculation convenience.
-  MemRef<float, 2> inputPaddedReal(paddedSizes);
-  MemRef<float, 2> inputPaddedImag(paddedSizes);
-
-  MemRef<float, 2> kernelPaddedReal(paddedSizes);
-  MemRef<float, 2> kernelPaddedImag(paddedSizes);
-
-  MemRef<float, 2> intermediateReal(paddedTSizes);
-  MemRef<float, 2> intermediateImag(paddedTSizes);
-
-  intptr_t flippedKernelSizeRows = kernel->getSizes()[0];
-  intptr_t flippedKernelSizeCols = kernel->getSizes()[1];
-  intptr_t flippedKernelSizes[2] = {flippedKernelSizeRows,
-                                    flippedKernelSizeCols};
-  MemRef<float, 2> flippedKernel(flippedKernelSizes);
-
-  for (uint32_t i = 0; i < kernel->getSizes()[0]; ++i)
-    for (uint32_t j = 0; j < kernel->getSizes()[1]; ++j) {
-      flippedKernel.getData()[i * kernel->getSizes()[1] + j] =
-          kernel->getData()[(kernel->getSizes()[0] - 1 - i) *
-                                kernel->getSizes()[1] +
-                            kernel->getSizes()[1] - 1 - j];
-    }
-
+// 2D correlation with the separable kernel kernelY * kernelX^T, where `kernelX`
+// is the row kernel and `kernelY` the column kernel. `centerX` indexes
+// `kernelX` and `centerY` indexes `kernelY`; the output is overwritten.
+inline void Corr2DSeparable(Img<float, 2> *input, MemRef<float, 1> *kernelX,
+                            MemRef<float, 1> *kernelY, MemRef<float, 2> *output,
+                            unsigned int centerX, unsigned int centerY,
+                            BOUNDARY_OPTION option, float constantValue = 0) {
   if (option == BOUNDARY_OPTION::CONSTANT_PADDING) {
-    for (uint32_t i = 0; i < paddedSizes[0]; ++i) {
-      for (uint32_t j = 0; j < paddedSizes[1]; ++j) {
-        if (i < input->getSizes()[0] && j < input->getSizes()[1])
-          inputPaddedReal.getData()[i * paddedSizes[1] + j] =
-              input->getData()[i * input->getSizes()[1] + j];
-        else
-          inputPaddedReal.getData()[i * paddedSizes[1] + j] = constantValue;
-      }
-    }
+    detail::_mlir_ciface_corr_2d_separable_constant_padding(
+        input, kernelX, kernelY, output, centerX, centerY, constantValue);
   } else if (option == BOUNDARY_OPTION::REPLICATE_PADDING) {
-    for (uint32_t i = 0; i < paddedSizes[0]; ++i) {
-      uint32_t r = (i < input->getSizes()[0])
-                       ? i
-                       : ((i < input->getSizes()[0] + centerY)
-                              ? (input->getSizes()[0] - 1)
-                              : 0);
-      for (uint32_t j = 0; j < paddedSizes[1]; ++j) {
-        uint32_t c = (j < input->getSizes()[1])
-                         ? j
-                         : ((j < input->getSizes()[1] + centerX)
-                                ? (input->getSizes()[1] - 1)
-                                : 0);
-        inputPaddedReal.getData()[i * paddedSizes[1] + j] =
-            input->getData()[r * input->getSizes()[1] + c];
+    detail::_mlir_ciface_corr_2d_separable_replicate_padding(
+        input, kernelX, kernelY, output, centerX, centerY, 0);
+  }
+}
+
+// Reusable plan for 2D correlation using FFT with a fixed kernel and image
+// size. The plan owns the padded workspace and keeps the kernel spectrum, so
+// repeated calls (e.g. on video frames) only transform the image. The upper and
+// lower halves of the real image are packed into the real and imaginary parts
+// of one complex transform, so a real image costs half of a complex one.
+// `centerX` and `centerY` follow the convention of `CorrFFT2D`.
+class CorrFFT2DPlan {
+public:
+  CorrFFT2DPlan(intptr_t imageRows, intptr_t imageCols,
+                MemRef<float, 2> *kernel, unsigned int centerX,
+                unsigned int centerY)
+      : imageRows(imageRows), imageCols(imageCols),
+        tileRows((imageRows + 1) / 2),
+        anchorX(kernel->getSizes()[1] - 1 - centerX),
+        anchorY(kernel->getSizes()[0] - 1 - centerY),
+        paddedRows(detail::fftPaddedSize(tileRows + kernel->getSizes()[0] - 1)),
+        paddedCols(
+            detail::fftPaddedSize(imageCols + kernel->getSizes()[1] - 1)),
+        packedReal(paddedShape()), packedImag(paddedShape()),
+        spectrumReal(paddedShape(), 0.f), spectrumImag(paddedShape(), 0.f),
+        intermediateReal(transposedShape()),
+        intermediateImag(transposedShape()) {
+    // Place the kernel so that its anchor is at the top left of the padded
+    // container (negative offsets wrap around), then transform it once.
+    intptr_t kernelRows = kernel->getSizes()[0];
+    intptr_t kernelCols = kernel->getSizes()[1];
+    for (intptr_t u = 0; u < kernelRows; ++u) {
+      intptr_t r = (anchorY - u + paddedRows) % paddedRows;
+      for (intptr_t v = 0; v < kernelCols; ++v) {
+        intptr_t c = (anchorX - v + paddedCols) % paddedCols;
+        spectrumReal.getData()[r * paddedCols + c] =
+            kernel->getData()[u * kernelCols + v];
       }
     }
+    detail::_mlir_ciface_fft_2d(&spectrumReal, &spectrumImag,
+                                &intermediateReal, &intermediateImag);
+  }
+
+  // Correlate `input` with the kernel of the plan.
+  void execute(Img<float, 2> *input, MemRef<float, 2> *output,
+               BOUNDARY_OPTION option, float constantValue = 0) {
+    if (input->getSizes()[0] != imageRows ||
+        input->getSizes()[1] != imageCols) {
+      throw std::invalid_argument(
+          "Image size does not match the size of the FFT plan.\n");
+    }
+    fillTile(input, &packedReal, 0, option, constantValue);
+    fillTile(input, &packedImag, tileRows, option, constantValue);
+
+    detail::_mlir_ciface_corrfft_2d_spectrum(
+        &packedReal, &packedImag, &spectrumReal, &spectrumImag,
+        &intermediateReal, &intermediateImag);
+
+    for (intptr_t i = 0; i < output->getSizes()[0]; ++i) {
+      float *tile = i < tileRows ? packedReal.getData() : packedImag.getData();
+      intptr_t q = i < tileRows ? i : i - tileRows;
+      std::copy(tile + q * paddedCols, tile + q * paddedCols + imageCols,
+                output->getData() + i * output->getSizes()[1]);
+    }
   }
 
-  // Obtain padded kernel.
-  detail::padKernel(&flippedKernel, centerX, centerY, paddedSizes,
-                    &kernelPaddedReal);
+  intptr_t getPaddedRows() const { return paddedRows; }
+  intptr_t getPaddedCols() const { return paddedCols; }
+
+private:
+  std::vector<size_t> paddedShape() const {
+    return {static_cast<size_t>(paddedRows), static_cast<size_t>(paddedCols)};
+  }
+  std::vector<size_t> transposedShape() const {
+    return {static_cast<size_t>(paddedCols), static_cast<size_t>(paddedRows)};
+  }
 
-  detail::_mlir_ciface_corrfft_2d(&inputPaddedReal, &inputPaddedImag,
-                                  &kernelPaddedReal, &kernelPaddedImag,
-                                  &intermediateReal, &intermediateImag);
+  // Fill a padded container with the image rows starting at `rowOffset`,
+  // extrapolating the boundary as per `option`. Rows and columns before the
+  // image wrap around to the end of the container.
+  void fillTile(Img<float, 2> *input, MemRef<float, 2> *tile,
+                intptr_t rowOffset, BOUNDARY_OPTION option,
+                float constantValue) {
+    bool replicate = option == BOUNDARY_OPTION::REPLICATE_PADDING;
+    for (intptr_t q = 0; q < paddedRows; ++q) {
+      float *dst = tile->getData() + q * paddedCols;
+      intptr_t r = rowOffset + (q < paddedRows - anchorY ? q : q - paddedRows);
+      if (!replicate && (r < 0 || r >= imageRows)) {
+        std::fill(dst, dst + paddedCols, constantValue);
+        continue;
+      }
+      r = std::min(std::max(r, static_cast<intptr_t>(0)), imageRows - 1);
+      const float *src = input->getData() + r * imageCols;
+      std::copy(src, src + imageCols, dst);
+      std::fill(dst + imageCols, dst + paddedCols - anchorX,
+                replicate ? src[imageCols - 1] : constantValue);
+      std::fill(dst + paddedCols - anchorX, dst + paddedCols,
+                replicate ? src[0] : constantValue);
+    }
+  }
+
+  intptr_t imageRows;
+  intptr_t imageCols;
+  // Number of image rows packed into each part of the complex container.
+  intptr_t tileRows;
+  // Anchor of the correlation window.
+  intptr_t anchorX;
+  intptr_t anchorY;
+  intptr_t paddedRows;
+  intptr_t paddedCols;
+  MemRef<float, 2> packedReal;
+  MemRef<float, 2> packedImag;
+  MemRef<float, 2> spectrumReal;
+  MemRef<float, 2> spectrumImag;
+  MemRef<float, 2> intermediateReal;
+  MemRef<float, 2> intermediateImag;
+};
 
-  for (uint32_t i = 0; i < output->getSizes()[0]; ++i)
-    for (uint32_t j = 0; j < output->getSizes()[1]; ++j)
-      output->getData()[i * output->getSizes()[1] + j] =
-          inputPaddedReal.getData()[i * paddedSizes[1] + j];
+// User interface for 2D Correlation using FFT. Use `CorrFFT2DPlan` to reuse
+// the workspace and the kernel spectrum across calls.
+inline void CorrFFT2D(Img<float, 2> *input, MemRef<float, 2> *kernel,
+                      MemRef<float, 2> *output, unsigned int centerX,
+                      unsigned int centerY, BOUNDARY_OPTION option,
+                      float constantValue = 0) {
+  CorrFFT2DPlan plan(input->getSizes()[0], input->getSizes()[1], kernel,
+                     centerX, centerY);
+  plan.execute(input, output, option, constantValue);
 }
 
 // User interface for 2D Rotation.
@@ -332,18 +1071,14 @@ inline MemRef<float, 2> Resize2D(Img<float, 2> *input, INTERPOLATION_TYPE type,
         "Note : scaling ratio = "
         "output_image_dimension / input_image_dimension\n");
   }
-  std::reverse(scalingRatios.begin(), scalingRatios.end());
-
-  intptr_t outputSize[2] = {static_cast<unsigned>(std::round(
-                                input->getSizes()[0] * scalingRatios[0])),
-                            static_cast<unsigned>(std::round(
-                                input->getSizes()[1] * scalingRatios[1]))};
-
-  scalingRatios[0] = 1 / scalingRatios[0];
-  scalingRatios[1] = 1 / scalingRatios[1];
-
-  return detail::Resize2D_Impl(
-      input, type, {scalingRatios[1], scalingRatios[0]}, outputSize);
+  intptr_t sizes[2] = {static_cast<unsigned>(std::round(
+                           input->getSizes()[0] * scalingRatios[1])),
+                       static_cast<unsigned>(std::round(
+                           input->getSizes()[1] * scalingRatios[0]))};
+  MemRef<float, 2> output(sizes);
+  detail::resize2DInterface(input, type, 1 / scalingRatios[0],
+                            1 / scalingRatios[1], &output);
+  return output;
 }
 
 // User interface for 2D Resize.
@@ -353,13 +1088,304 @@ inline MemRef<float, 2> Resize2D(Img<float, 2> *input, INTERPOLATION_TYPE type,
     throw std::invalid_argument(
         "Please enter positive values of output dimensions.\n");
   }
-  std::reverse(outputSize, outputSize + 2);
+  intptr_t sizes[2] = {outputSize[1], outputSize[0]};
+  MemRef<float, 2> output(sizes);
+  detail::resize2DInterface(input, type,
+                            input->getSizes()[1] * 1.0f / outputSize[0],
+                            input->getSizes()[0] * 1.0f / outputSize[1],
+                            &output);
+  return output;
+}
+
+// User interface for 2D affine warping. `matrix` is the row-major 2x3
+// transformation from input to output coordinates; `output` receives the
+// warped image.
+inline void WarpAffine2D(Img<float, 2> *input, const float matrix[6],
+                         MemRef<float, 2> *output, BOUNDARY_OPTION option,
+                         float constantValue = 0) {
+  MemRef<float, 2> inverse = detail::inverseWarpMatrix(matrix, 2);
+  if (option == BOUNDARY_OPTION::CONSTANT_PADDING) {
+    detail::_mlir_ciface_warp_affine_2d_constant_padding(
+        input, &inverse, output, constantValue);
+  } else if (option == BOUNDARY_OPTION::REPLICATE_PADDING) {
+    detail::_mlir_ciface_warp_affine_2d_replicate_padding(input, &inverse,
+                                                          output, 0);
+  }
+}
+
+// User interface for 2D perspective warping. `matrix` is the row-major 3x3
+// homography from input to output coordinates.
+inline void WarpPerspective2D(Img<float, 2> *input, const float matrix[9],
+                              MemRef<float, 2> *output, BOUNDARY_OPTION option,
+                              float constantValue = 0) {
+  MemRef<float, 2> inverse = detail::inverseWarpMatrix(matrix, 3);
+  if (option == BOUNDARY_OPTION::CONSTANT_PADDING) {
+    detail::_mlir_ciface_warp_perspective_2d_constant_padding(
+        input, &inverse, output, constantValue);
+  } else if (option == BOUNDARY_OPTION::REPLICATE_PADDING) {
+    detail::_mlir_ciface_warp_perspective_2d_replicate_padding(
+        input, &inverse, output, 0);
+  }
+}
+
+// Precomputes the remap table of the affine (`rows` = 2) or perspective
+// (`rows` = 3) transformation `matrix` for outputs of size `outputSize`. Use
+// it with Remap2D to apply the same transformation to many images.
+inline MemRef<int32_t, 3> WarpMap2D(const float *matrix, intptr_t rows,
+                                    intptr_t outputSize[2]) {
+  if (rows != 2 && rows != 3) {
+    throw std::invalid_argument(
+        "Please pass a 2x3 affine or a 3x3 perspective matrix.\n");
+  }
+  MemRef<float, 2> inverse = detail::inverseWarpMatrix(matrix, rows);
+  intptr_t mapSize[3] = {2, outputSize[0], outputSize[1]};
+  MemRef<int32_t, 3> map(mapSize);
+  detail::_mlir_ciface_warp_map_2d(&inverse, &map);
+  return map;
+}
+
+// User interface for resampling an image with a remap table built by
+// WarpMap2D. `output` must have the size the map was built for.
+inline void Remap2D(Img<float, 2> *input, MemRef<int32_t, 3> *map,
+                    MemRef<float, 2> *output, BOUNDARY_OPTION option,
+                    float constantValue = 0) {
+  if (option == BOUNDARY_OPTION::CONSTANT_PADDING) {
+    detail::_mlir_ciface_remap_2d_constant_padding(input, map, output,
+                                                   constantValue);
+  } else if (option == BOUNDARY_OPTION::REPLICATE_PADDING) {
+    detail::_mlir_ciface_remap_2d_replicate_padding(input, map, output, 0);
+  }
+}
+
+// User interface for 2D Resize of 8-bit and 16-bit images, single channel
+// (N = 2) or interleaved HWC (N = 3). `outputSize` is {width, height} as in the
+// floating-point variant.
+template <typename T, size_t N>
+MemRef<T, N> Resize2D(Img<T, N> *input, INTERPOLATION_TYPE type,
+                      intptr_t outputSize[2]) {
+  static_assert(N == 2 || N == 3, "Images are HxW or interleaved HxWxC.");
+  if (outputSize[0] <= 0 || outputSize[1] <= 0) {
+    throw std::invalid_argument(
+        "Please enter positive values of output dimensions.\n");
+  }
+  intptr_t sizes[N];
+  sizes[0] = outputSize[1];
+  sizes[1] = outputSize[0];
+  if constexpr (N == 3)
+    sizes[2] = input->getSizes()[2];
+  MemRef<T, N> output(sizes);
+  detail::resize2DInterface(input, type,
+                            input->getSizes()[1] * 1.0f / outputSize[0],
+                            input->getSizes()[0] * 1.0f / outputSize[1],
+                            &output);
+  return output;
+}
+
+// User interface for 2D Correlation with a separable kernel on 8-bit and
+// 16-bit images. The kernels are signed integers of the pixel width and the
+// results saturate to the range of the pixels.
+template <typename T, typename K, size_t N>
+void Corr2DSeparable(Img<T, N> *input, MemRef<K, 1> *kernelX,
+                     MemRef<K, 1> *kernelY, MemRef<T, N> *output,
+                     unsigned int centerX, unsigned int centerY,
+                     BOUNDARY_OPTION option,
+                     detail::NonDeduced<T> constantValue = 0) {
+  detail::corr2DSeparableInterface(input, kernelX, kernelY, output, centerX,
+                                   centerY, option, constantValue);
+}
+
+// User interface for the integral image. The result has one more row and
+// column than the image, and element (i, j) is the sum of the pixels in rows
+// [0, i) and columns [0, j).
+inline MemRef<double, 2> IntegralImage(Img<float, 2> *input) {
+  intptr_t sizes[2] = {input->getSizes()[0] + 1, input->getSizes()[1] + 1};
+  MemRef<double, 2> output(sizes);
+  detail::_mlir_ciface_integral_image(input, &output);
+  return output;
+}
+
+inline MemRef<int32_t, 2> IntegralImage(Img<uint8_t, 2> *input) {
+  intptr_t sizes[2] = {input->getSizes()[0] + 1, input->getSizes()[1] + 1};
+  MemRef<int32_t, 2> output(sizes);
+  detail::_mlir_ciface_integral_image_u8(input, &output);
+  return output;
+}
+
+// User interface for the normalized box filter (mean over the kernelWidth x
+// kernelHeight window centered on each pixel) on f32 and 8-bit images. The
+// cost per pixel does not depend on the window size.
+template <typename T>
+void BoxFilter2D(Img<T, 2> *input, MemRef<T, 2> *output,
+                 unsigned int kernelWidth, unsigned int kernelHeight,
+                 BOUNDARY_OPTION option,
+                 detail::NonDeduced<T> constantValue = 0) {
+  detail::boxFilterInterface(input, output, kernelWidth, kernelHeight,
+                             kernelWidth / 2, kernelHeight / 2, option,
+                             constantValue);
+}
+
+// User interface for the Gaussian blur on f32 and 8-bit images, approximated
+// by three box filters so that the cost per pixel does not depend on sigma.
+template <typename T>
+void GaussianBlur2D(Img<T, 2> *input, MemRef<T, 2> *output, float sigmaX,
+                    float sigmaY, BOUNDARY_OPTION option,
+                    detail::NonDeduced<T> constantValue = 0) {
+  detail::gaussianBlurInterface(input, output, sigmaX, sigmaY, option,
+                                constantValue);
+}
 
-  std::vector<float> scalingRatios(2);
-  scalingRatios[1] = input->getSizes()[0] * 1.0f / outputSize[0];
-  scalingRatios[0] = input->getSizes()[1] * 1.0f / outputSize[1];
+// User interface for the median filter over the kernelSize x kernelSize window
+// centered on each pixel, on f32 and 8-bit images.
+template <typename T>
+void Median2D(Img<T, 2> *input, MemRef<T, 2> *output, unsigned int kernelSize,
+              BOUNDARY_OPTION option, detail::NonDeduced<T> constantValue = 0) {
+  detail::median2DInterface(input, output, kernelSize, option, constantValue);
+}
+
+// User interface for the rank filter, which picks the element of rank `rank`
+// (0 for the minimum) of the kernelSize x kernelSize window centered on each
+// pixel.
+template <typename T>
+void RankFilter2D(Img<T, 2> *input, MemRef<T, 2> *output,
+                  unsigned int kernelSize, unsigned int rank,
+                  BOUNDARY_OPTION option,
+                  detail::NonDeduced<T> constantValue = 0) {
+  detail::rankFilter2DInterface(input, output, kernelSize, rank, option,
+                                constantValue);
+}
+
+// User interface for the percentile filter, i.e. the rank filter with the rank
+// nearest to `percentile` (in [0, 100]) of the window.
+template <typename T>
+void PercentileFilter2D(Img<T, 2> *input, MemRef<T, 2> *output,
+                        unsigned int kernelSize, float percentile,
+                        BOUNDARY_OPTION option,
+                        detail::NonDeduced<T> constantValue = 0) {
+  float lastRank = static_cast<float>(kernelSize * kernelSize - 1);
+  float rank = std::round(std::clamp(percentile, 0.0f, 100.0f) / 100.0f *
+                          lastRank);
+  detail::rankFilter2DInterface(input, output, kernelSize,
+                                static_cast<unsigned int>(rank), option,
+                                constantValue);
+}
 
-  return detail::Resize2D_Impl(input, type, scalingRatios, outputSize);
+// User interface for the 256-bin histogram of an 8-bit image.
+inline MemRef<int32_t, 1> Histogram(Img<uint8_t, 2> *input) {
+  intptr_t sizes[1] = {256};
+  MemRef<int32_t, 1> hist(sizes);
+  detail::_mlir_ciface_histogram_u8(input, &hist);
+  return hist;
+}
+
+// User interface for histogram equalization of an 8-bit image, as OpenCV's
+// equalizeHist.
+inline void EqualizeHist(Img<uint8_t, 2> *input, MemRef<uint8_t, 2> *output) {
+  detail::_mlir_ciface_equalize_hist_u8(input, output);
+}
+
+// User interface for mapping an 8-bit image, gray (N = 2) or interleaved HWC
+// (N = 3), through a 256-entry lookup table of 8-bit levels, or of f32 values
+// for gray images.
+template <typename T, size_t N>
+void ApplyLUT(Img<uint8_t, N> *input, MemRef<T, 1> *lut,
+              MemRef<T, N> *output) {
+  if (lut->getSizes()[0] != 256) {
+    throw std::invalid_argument(
+        "Please enter a lookup table of 256 entries.\n");
+  }
+  detail::applyLutInterface(input, lut, output);
+}
+
+// User interface for the next level of a Gaussian pyramid of an f32 or 8-bit
+// image, i.e. the image blurred with the 5x5 binomial kernel and downsampled by
+// two. The output is ((w + 1) / 2)x((h + 1) / 2) like OpenCV's pyrDown, or
+// (w / 2)x(h / 2).
+template <typename T>
+void PyrDown(Img<T, 2> *input, MemRef<T, 2> *output,
+             BOUNDARY_OPTION option = BOUNDARY_OPTION::REPLICATE_PADDING,
+             detail::NonDeduced<T> constantValue = 0) {
+  for (int dim = 0; dim < 2; ++dim) {
+    intptr_t inSize = input->getSizes()[dim];
+    intptr_t outSize = output->getSizes()[dim];
+    if (outSize != (inSize + 1) / 2 && outSize != inSize / 2) {
+      throw std::invalid_argument(
+          "Please enter an output of half the size of the input.\n");
+    }
+  }
+  detail::pyrDownInterface(input, output, option, constantValue);
+}
+
+// User interface for the previous level of a Gaussian pyramid of an f32 or
+// 8-bit image, i.e. the image upsampled by two and blurred with 4 times the
+// kernel of PyrDown. The output is (2w)x(2h), or one less in each dimension.
+template <typename T>
+void PyrUp(Img<T, 2> *input, MemRef<T, 2> *output,
+           BOUNDARY_OPTION option = BOUNDARY_OPTION::REPLICATE_PADDING,
+           detail::NonDeduced<T> constantValue = 0) {
+  for (int dim = 0; dim < 2; ++dim) {
+    intptr_t inSize = input->getSizes()[dim];
+    intptr_t outSize = output->getSizes()[dim];
+    if (outSize != 2 * inSize && outSize != 2 * inSize - 1) {
+      throw std::invalid_argument(
+          "Please enter an output of twice the size of the input.\n");
+    }
+  }
+  detail::pyrUpInterface(input, output, option, constantValue);
+}
+
+// User interface for 2D affine warping of 8-bit and 16-bit images, single
+// channel (N = 2) or interleaved HWC (N = 3). `matrix` is as in the f32
+// variant.
+template <typename T, size_t N>
+void WarpAffine2D(Img<T, N> *input, const float matrix[6], MemRef<T, N> *output,
+                  BOUNDARY_OPTION option,
+                  detail::NonDeduced<T> constantValue = 0) {
+  MemRef<float, 2> inverse = detail::inverseWarpMatrix(matrix, 2);
+  detail::warpAffine2DInterface(input, &inverse, output, option,
+                                constantValue);
+}
+
+// User interface for 2D perspective warping of 8-bit and 16-bit images.
+template <typename T, size_t N>
+void WarpPerspective2D(Img<T, N> *input, const float matrix[9],
+                       MemRef<T, N> *output, BOUNDARY_OPTION option,
+                       detail::NonDeduced<T> constantValue = 0) {
+  MemRef<float, 2> inverse = detail::inverseWarpMatrix(matrix, 3);
+  detail::warpPerspective2DInterface(input, &inverse, output, option,
+                                     constantValue);
+}
+
+// User interface for resampling 8-bit and 16-bit images with a remap table
+// built by WarpMap2D. Each channel of an interleaved image follows the map.
+template <typename T, size_t N>
+void Remap2D(Img<T, N> *input, MemRef<int32_t, 3> *map, MemRef<T, N> *output,
+             BOUNDARY_OPTION option, detail::NonDeduced<T> constantValue = 0) {
+  detail::remap2DInterface(input, map, output, option, constantValue);
+}
+
+// User interface for converting a decoded 8-bit image, gray (N = 2) or
+// interleaved HWC (N = 3), into entry `batch` of the f32 input tensor of a
+// DNN in one pass. The image is resized to the spatial size of `output`
+// (nearest neighbour or bilinear interpolation, sampled like cv::resize), its
+// channels are swapped from BGR to RGB when `swapRB` is set, and every value of
+// output channel c is normalized to (pixel * scale - mean[c]) / stdDev[c]. Gray
+// images feed every output channel. Wrap decoded frames in an ImgView to pass
+// them without copying.
+template <size_t N>
+void ImageToTensor(Img<uint8_t, N> *input, Img<float, 4> *output,
+                   TENSOR_LAYOUT layout, INTERPOLATION_TYPE type,
+                   const float *mean, const float *stdDev, bool swapRB = false,
+                   float scale = 1.0f / 255, intptr_t batch = 0) {
+  if (batch < 0 || batch >= output->getSizes()[0]) {
+    throw std::invalid_argument("Please enter a batch index of the output.\n");
+  }
+  intptr_t channels =
+      output->getSizes()[layout == TENSOR_LAYOUT::NCHW ? 1 : 3];
+  intptr_t paramSizes[1] = {channels};
+  MemRef<float, 1> meanMemRef(mean, paramSizes);
+  MemRef<float, 1> stdMemRef(stdDev, paramSizes);
+  detail::imageToTensorInterface(input, output, layout, type, swapRB, batch,
+                                 scale, &meanMemRef, &stdMemRef);
 }
 
 inline void Erosion2D(Img<float, 2> input, MemRef<float, 2> *kernel,
@@ -373,11 +1399,11 @@ inline void Erosion2D(Img<float, 2> input, MemRef<float, 2> *kernel,
 
   if (option == BOUNDARY_OPTION::CONSTANT_PADDING) {
     detail::_mlir_ciface_erosion_2d_constant_padding(
-        input, kernel, output, &copymemref, centerX, centerY, iterations,
+        &input, kernel, output, &copymemref, centerX, centerY, iterations,
         constantValue);
   } else if (option == BOUNDARY_OPTION::REPLICATE_PADDING) {
     detail::_mlir_ciface_erosion_2d_replicate_padding(
-        input, kernel, output, &copymemref, centerX, centerY, iterations, 0);
+        &input, kernel, output, &copymemref, centerX, centerY, iterations, 0);
   }
 }
 
@@ -391,25 +1417,40 @@ inline void Dilation2D(Img<float, 2> input, MemRef<float, 2> *kernel,
   MemRef<float, 2> copymemref(sizesOutput, -1.f);
   if (option == BOUNDARY_OPTION::CONSTANT_PADDING) {
     detail::_mlir_ciface_dilation_2d_constant_padding(
-        input, kernel, output, &copymemref, centerX, centerY, iterations,
+        &input, kernel, output, &copymemref, centerX, centerY, iterations,
         constantValue);
   } else if (option == BOUNDARY_OPTION::REPLICATE_PADDING) {
     detail::_mlir_ciface_dilation_2d_replicate_padding(
-        input, kernel, output, &copymemref, centerX, centerY, iterations, 0);
+        &input, kernel, output, &copymemref, centerX, centerY, iterations, 0);
   }
 }
 
-inline void Opening2D(Img<float, 2> input, MemRef<float, 2> *kernel,
+namespace detail {
+// Sizes of the scratch buffers of the compound morphological operations. A
+// single iteration is computed tile by tile and only reads the initial values
+// of both stages, so one element is enough.
+inline void morphScratchSizes(MemRef<float, 2> *output,
+                              unsigned int iterations, intptr_t sizes[2]) {
+  sizes[0] = iterations == 1 ? 1 : output->getSizes()[0];
+  sizes[1] = iterations == 1 ? 1 : output->getSizes()[1];
+}
+} // namespace detail
+
+inline void Opening2D(Img<float, 2> *input, MemRef<float, 2> *kernel,
                       MemRef<float, 2> *output, unsigned int centerX,
                       unsigned int centerY, unsigned int iterations,
                       BOUNDARY_OPTION option, float constantValue = 0) {
-  intptr_t outputRows = output->getSizes()[0];
-  intptr_t outputCols = output->getSizes()[1];
-
-  intptr_t sizesOutput[2] = {outputRows, outputCols};
+  intptr_t sizesOutput[2];
+  detail::morphScratchSizes(output, iterations, sizesOutput);
   MemRef<float, 2> output1(sizesOutput);
   MemRef<float, 2> copymemref(sizesOutput, 256.f);
   MemRef<float, 2> copymemref1(sizesOutput, -1.f);
+  // The iterative lowering overwrites its input, so it works on a copy.
+  Img<float, 2> inputCopy;
+  if (iterations != 1) {
+    inputCopy = *input;
+    input = &inputCopy;
+  }
   if (option == BOUNDARY_OPTION::CONSTANT_PADDING) {
     detail::_mlir_ciface_opening_2d_constant_padding(
         input, kernel, output, &output1, &copymemref, &copymemref1, centerX,
@@ -421,17 +1462,21 @@ inline void Opening2D(Img<float, 2> input, MemRef<float, 2> *kernel,
   }
 }
 
-inline void Closing2D(Img<float, 2> input, MemRef<float, 2> *kernel,
+inline void Closing2D(Img<float, 2> *input, MemRef<float, 2> *kernel,
                       MemRef<float, 2> *output, unsigned int centerX,
                       unsigned int centerY, unsigned int iterations,
                       BOUNDARY_OPTION option, float constantValue = 0) {
-  intptr_t outputRows = output->getSizes()[0];
-  intptr_t outputCols = output->getSizes()[1];
-
-  intptr_t sizesOutput[2] = {outputRows, outputCols};
+  intptr_t sizesOutput[2];
+  detail::morphScratchSizes(output, iterations, sizesOutput);
   MemRef<float, 2> output1(sizesOutput);
   MemRef<float, 2> copymemref(sizesOutput, -1.f);
   MemRef<float, 2> copymemref1(sizesOutput, 256.f);
+  // The iterative lowering overwrites its input, so it works on a copy.
+  Img<float, 2> inputCopy;
+  if (iterations != 1) {
+    inputCopy = *input;
+    input = &inputCopy;
+  }
   if (option == BOUNDARY_OPTION::CONSTANT_PADDING) {
     detail::_mlir_ciface_closing_2d_constant_padding(
         input, kernel, output, &output1, &copymemref, &copymemref1, centerX,
@@ -443,13 +1488,12 @@ inline void Closing2D(Img<float, 2> input, MemRef<float, 2> *kernel,
   }
 }
 
-inline void TopHat2D(Img<float, 2> input, MemRef<float, 2> *kernel,
+inline void TopHat2D(Img<float, 2> *input, MemRef<float, 2> *kernel,
                      MemRef<float, 2> *output, unsigned int centerX,
                      unsigned int centerY, unsigned int iterations,
                      BOUNDARY_OPTION option, float constantValue = 0) {
-  intptr_t outputRows = output->getSizes()[0];
-  intptr_t outputCols = output->getSizes()[1];
-  intptr_t sizesOutput[2] = {outputRows, outputCols};
+  intptr_t sizesOutput[2];
+  detail::morphScratchSizes(output, iterations, sizesOutput);
   MemRef<float, 2> output1(sizesOutput);
   MemRef<float, 2> output2(sizesOutput);
   MemRef<float, 2> input1(sizesOutput);
@@ -466,13 +1510,12 @@ inline void TopHat2D(Img<float, 2> input, MemRef<float, 2> *kernel,
   }
 }
 
-inline void BottomHat2D(Img<float, 2> input, MemRef<float, 2> *kernel,
+inline void BottomHat2D(Img<float, 2> *input, MemRef<float, 2> *kernel,
                         MemRef<float, 2> *output, unsigned int centerX,
                         unsigned int centerY, unsigned int iterations,
                         BOUNDARY_OPTION option, float constantValue = 0) {
-  intptr_t outputRows = output->getSizes()[0];
-  intptr_t outputCols = output->getSizes()[1];
-  intptr_t sizesOutput[2] = {outputRows, outputCols};
+  intptr_t sizesOutput[2];
+  detail::morphScratchSizes(output, iterations, sizesOutput);
   MemRef<float, 2> output1(sizesOutput);
   MemRef<float, 2> output2(sizesOutput);
   MemRef<float, 2> input1(sizesOutput);
@@ -489,13 +1532,12 @@ inline void BottomHat2D(Img<float, 2> input, MemRef<float, 2> *kernel,
   }
 }
 
-inline void MorphGrad2D(Img<float, 2> input, MemRef<float, 2> *kernel,
+inline void MorphGrad2D(Img<float, 2> *input, MemRef<float, 2> *kernel,
                         MemRef<float, 2> *output, unsigned int centerX,
                         unsigned int centerY, unsigned int iterations,
                         BOUNDARY_OPTION option, float constantValue = 0) {
-  intptr_t outputRows = output->getSizes()[0];
-  intptr_t outputCols = output->getSizes()[1];
-  intptr_t sizesOutput[2] = {outputRows, outputCols};
+  intptr_t sizesOutput[2];
+  detail::morphScratchSizes(output, iterations, sizesOutput);
   MemRef<float, 2> output1(sizesOutput);
   MemRef<float, 2> output2(sizesOutput);
   MemRef<float, 2> input1(sizesOutput);
@@ -511,6 +1553,613 @@ inline void MorphGrad2D(Img<float, 2> input, MemRef<float, 2> *kernel,
         &copymemref1, centerX, centerY, iterations, 0);
   }
 }
+
+//===----------------------------------------------------------------------===//
+// Batched interfaces
+//===----------------------------------------------------------------------===//
+//
+// The batched variants process a stack of images, i.e. a MemRef whose last two
+// dimensions are the rows and the columns of every image (e.g. NxHxW or the
+// NCHW planes of a tensor), and distribute the images over a pool of threads.
+// Each thread owns its scratch buffers and reuses them for all of its images,
+// and kernel preprocessing is done once per batch. `numThreads` = 0 uses all
+// hardware threads.
+//
+
+namespace detail {
+// Non-owning view of image `index` of a stack of images, passed to the C
+// interfaces without copying the pixels.
+template <typename T> class ImageSlice : public Img<T, 2> {
+public:
+  template <size_t N> ImageSlice(MemRef<T, N> *stack, intptr_t index) {
+    static_assert(N >= 2, "A stack of images has at least two dimensions.");
+    auto sizes = stack->getSizes();
+    this->sizes[0] = sizes[N - 2];
+    this->sizes[1] = sizes[N - 1];
+    this->setStrides();
+    // The C interfaces of identity layouts ignore the offset, so the view
+    // points at the first pixel of the image.
+    this->aligned = stack->getData() + index * sizes[N - 2] * sizes[N - 1];
+  }
+  // View of the rows x cols image stored contiguously at `data`.
+  ImageSlice(T *data, intptr_t rows, intptr_t cols) {
+    this->sizes[0] = rows;
+    this->sizes[1] = cols;
+    this->setStrides();
+    this->aligned = data;
+  }
+};
+
+// Number of images in a stack.
+template <typename T, size_t N> intptr_t stackSize(MemRef<T, N> *stack) {
+  intptr_t count = 1;
+  for (size_t i = 0; i + 2 < N; ++i)
+    count *= stack->getSizes()[i];
+  return count;
+}
+
+// Number of threads processing `count` images.
+inline unsigned batchThreads(intptr_t count, unsigned numThreads) {
+  if (numThreads == 0)
+    numThreads = std::max(1u, std::thread::hardware_concurrency());
+  return static_cast<unsigned>(
+      std::max<intptr_t>(1, std::min<intptr_t>(count, numThreads)));
+}
+
+// Pool of worker threads shared by the batched interfaces. The workers are
+// started on first use and live until the program exits, so that a batch does
+// not pay for creating and joining threads. One job runs at a time; a job
+// started from inside a running job runs on the calling thread only.
+class ThreadPool {
+public:
+  static ThreadPool &instance() {
+    static ThreadPool pool;
+    return pool;
+  }
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread &worker : workers)
+      worker.join();
+  }
+
+  // Runs `job(thread)` on up to `numThreads` threads, the calling thread being
+  // thread 0, and returns when all of them are done. `job` must not throw.
+  void run(unsigned numThreads, const std::function<void(unsigned)> &job) {
+    numThreads = std::min<unsigned>(numThreads, workers.size() + 1);
+    if (numThreads <= 1 || inJob()) {
+      job(0);
+      return;
+    }
+    std::lock_guard<std::mutex> runLock(runMutex);
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      current = &job;
+      tickets = numThreads - 1;
+      running = numThreads - 1;
+      ++generation;
+    }
+    wake.notify_all();
+    inJob() = true;
+    job(0);
+    inJob() = false;
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [&] { return running == 0; });
+    current = nullptr;
+  }
+
+private:
+  ThreadPool() {
+    unsigned numWorkers = std::max(1u, std::thread::hardware_concurrency()) - 1;
+    for (unsigned t = 0; t < numWorkers; ++t)
+      workers.emplace_back([this] { work(); });
+  }
+
+  // Whether the current thread is running a job.
+  static bool &inJob() {
+    static thread_local bool running = false;
+    return running;
+  }
+
+  // Every worker takes at most one ticket, i.e. one thread index, per job.
+  void work() {
+    inJob() = true;
+    uint64_t seen = 0;
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      wake.wait(lock, [&] {
+        return stopping || (generation != seen && tickets > 0);
+      });
+      if (stopping)
+        return;
+      seen = generation;
+      unsigned thread = tickets--;
+      const std::function<void(unsigned)> *job = current;
+      lock.unlock();
+      (*job)(thread);
+      lock.lock();
+      if (--running == 0)
+        done.notify_one();
+    }
+  }
+
+  std::vector<std::thread> workers;
+  std::mutex runMutex;
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable done;
+  const std::function<void(unsigned)> *current = nullptr;
+  uint64_t generation = 0;
+  unsigned tickets = 0;
+  unsigned running = 0;
+  bool stopping = false;
+};
+
+// Calls `fn(index, thread)` for every index in [0, count) on `numThreads`
+// threads of the pool, which pick the next index when they finish one. The
+// first exception thrown by `fn` is rethrown once all threads are done.
+inline void parallelFor(intptr_t count, unsigned numThreads,
+                        const std::function<void(intptr_t, unsigned)> &fn) {
+  std::atomic<intptr_t> next(0);
+  std::exception_ptr error;
+  std::mutex errorMutex;
+  ThreadPool::instance().run(numThreads, [&](unsigned thread) {
+    try {
+      for (intptr_t i = next++; i < count; i = next++)
+        fn(i, thread);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(errorMutex);
+      if (!error)
+        error = std::current_exception();
+      next = count;
+    }
+  });
+  if (error)
+    std::rethrow_exception(error);
+}
+
+// Applies `fn(input, output, thread)` to the images of two stacks with the
+// same number of images.
+template <size_t N, size_t M>
+void forEachImage(
+    Img<float, N> *input, MemRef<float, M> *output, unsigned numThreads,
+    const std::function<void(Img<float, 2> *, MemRef<float, 2> *, unsigned)>
+        &fn) {
+  intptr_t count = stackSize(input);
+  if (stackSize(output) != count) {
+    throw std::invalid_argument(
+        "Input and output stacks must hold the same number of images.\n");
+  }
+  parallelFor(count, batchThreads(count, numThreads),
+              [&](intptr_t i, unsigned thread) {
+                ImageSlice<float> inputImage(input, i);
+                ImageSlice<float> outputImage(output, i);
+                fn(&inputImage, &outputImage, thread);
+              });
+}
+
+// Scratch buffers of one thread running morphological operations. The initial
+// values are restored before every image, as iterative lowerings overwrite
+// them.
+class MorphScratch {
+public:
+  MorphScratch(intptr_t sizes[2], intptr_t inputSizes[2], bool copyInput)
+      : output1(sizes), output2(sizes), input1(sizes),
+        erosionInit(sizes, 256.f), dilationInit(sizes, -1.f),
+        inputCopy(copyInput ? inputSizes : sizes) {}
+
+  // Prepares the buffers for `input` and returns the image to process.
+  Img<float, 2> *prepare(Img<float, 2> *input, bool copyInput) {
+    std::fill(erosionInit.getData(),
+              erosionInit.getData() + erosionInit.getSize(), 256.f);
+    std::fill(dilationInit.getData(),
+              dilationInit.getData() + dilationInit.getSize(), -1.f);
+    if (!copyInput)
+      return input;
+    std::copy(input->getData(), input->getData() + input->getSize(),
+              inputCopy.getData());
+    return &inputCopy;
+  }
+
+  MemRef<float, 2> output1;
+  MemRef<float, 2> output2;
+  MemRef<float, 2> input1;
+  MemRef<float, 2> erosionInit;
+  MemRef<float, 2> dilationInit;
+  Img<float, 2> inputCopy;
+};
+
+// Applies a morphological operation `fn(input, output, scratch)` to the images
+// of two stacks. `copyInput` protects the input images from lowerings that
+// overwrite them.
+template <size_t N>
+void morphBatch(Img<float, N> *input, MemRef<float, N> *output,
+                unsigned int iterations, bool copyInput, unsigned numThreads,
+                const std::function<void(Img<float, 2> *, MemRef<float, 2> *,
+                                         MorphScratch &)> &fn) {
+  intptr_t count = stackSize(input);
+  numThreads = batchThreads(count, numThreads);
+  ImageSlice<float> first(output, 0);
+  intptr_t sizes[2];
+  morphScratchSizes(&first, iterations, sizes);
+  intptr_t inputSizes[2] = {input->getSizes()[N - 2],
+                            input->getSizes()[N - 1]};
+  std::vector<std::unique_ptr<MorphScratch>> scratch;
+  for (unsigned t = 0; t < numThreads; ++t)
+    scratch.emplace_back(new MorphScratch(sizes, inputSizes, copyInput));
+  forEachImage(input, output, numThreads,
+               [&](Img<float, 2> *inputImage, MemRef<float, 2> *outputImage,
+                   unsigned thread) {
+                 MorphScratch &s = *scratch[thread];
+                 fn(s.prepare(inputImage, copyInput), outputImage, s);
+               });
+}
+} // namespace detail
+
+// Batched 2D Correlation of every image of `input` with `kernel`.
+template <size_t N>
+void Corr2DBatch(Img<float, N> *input, MemRef<float, 2> *kernel,
+                 MemRef<float, N> *output, unsigned int centerX,
+                 unsigned int centerY, BOUNDARY_OPTION option,
+                 float constantValue = 0, unsigned numThreads = 0) {
+  detail::forEachImage(input, output, numThreads,
+                       [&](Img<float, 2> *inputImage,
+                           MemRef<float, 2> *outputImage, unsigned) {
+                         Corr2D(inputImage, kernel, outputImage, centerX,
+                                centerY, option, constantValue);
+                       });
+}
+
+// Batched 2D Correlation with a separable kernel.
+template <size_t N>
+void Corr2DSeparableBatch(Img<float, N> *input, MemRef<float, 1> *kernelX,
+                          MemRef<float, 1> *kernelY, MemRef<float, N> *output,
+                          unsigned int centerX, unsigned int centerY,
+                          BOUNDARY_OPTION option, float constantValue = 0,
+                          unsigned numThreads = 0) {
+  detail::forEachImage(input, output, numThreads,
+                       [&](Img<float, 2> *inputImage,
+                           MemRef<float, 2> *outputImage, unsigned) {
+                         Corr2DSeparable(inputImage, kernelX, kernelY,
+                                         outputImage, centerX, centerY, option,
+                                         constantValue);
+                       });
+}
+
+// Batched 2D Correlation using FFT. The kernel spectrum is computed once and
+// every thread works on its own copy of the plan.
+template <size_t N>
+void CorrFFT2DBatch(Img<float, N> *input, MemRef<float, 2> *kernel,
+                    MemRef<float, N> *output, unsigned int centerX,
+                    unsigned int centerY, BOUNDARY_OPTION option,
+                    float constantValue = 0, unsigned numThreads = 0) {
+  intptr_t count = detail::stackSize(input);
+  numThreads = detail::batchThreads(count, numThreads);
+  std::vector<CorrFFT2DPlan> plans;
+  plans.reserve(numThreads);
+  plans.emplace_back(input->getSizes()[N - 2], input->getSizes()[N - 1],
+                     kernel, centerX, centerY);
+  for (unsigned t = 1; t < numThreads; ++t)
+    plans.push_back(plans[0]);
+  detail::forEachImage(input, output, numThreads,
+                       [&](Img<float, 2> *inputImage,
+                           MemRef<float, 2> *outputImage, unsigned thread) {
+                         plans[thread].execute(inputImage, outputImage, option,
+                                               constantValue);
+                       });
+}
+
+// Batched 2D Rotation. All images have the size of the stack, so they share
+// the size of the rotated images.
+template <size_t N>
+MemRef<float, N> Rotate2DBatch(Img<float, N> *input, float angle,
+                               ANGLE_TYPE angleType, unsigned numThreads = 0) {
+  float angleRad = angleType == ANGLE_TYPE::DEGREE ? M_PI * angle / 180 : angle;
+  float sinAngle = std::sin(angleRad);
+  float cosAngle = std::cos(angleRad);
+  intptr_t rows = input->getSizes()[N - 2];
+  intptr_t cols = input->getSizes()[N - 1];
+  intptr_t sizesOutput[N];
+  std::copy(input->getSizes(), input->getSizes() + N, sizesOutput);
+  sizesOutput[N - 2] =
+      std::round(std::abs(rows * cosAngle) + std::abs(cols * sinAngle));
+  sizesOutput[N - 1] =
+      std::round(std::abs(cols * cosAngle) + std::abs(rows * sinAngle));
+  MemRef<float, N> output(sizesOutput);
+  detail::forEachImage(input, &output, numThreads,
+                       [&](Img<float, 2> *inputImage,
+                           MemRef<float, 2> *outputImage, unsigned) {
+                         detail::_mlir_ciface_rotate_2d(inputImage, angleRad,
+                                                        outputImage);
+                       });
+  return output;
+}
+
+// Batched 2D Resize of a stack of images to `outputSize` ({width, height}).
+template <size_t N>
+MemRef<float, N> Resize2DBatch(Img<float, N> *input, INTERPOLATION_TYPE type,
+                               intptr_t outputSize[2],
+                               unsigned numThreads = 0) {
+  if (outputSize[0] <= 0 || outputSize[1] <= 0) {
+    throw std::invalid_argument(
+        "Please enter positive values of output dimensions.\n");
+  }
+  intptr_t sizesOutput[N];
+  std::copy(input->getSizes(), input->getSizes() + N, sizesOutput);
+  sizesOutput[N - 2] = outputSize[1];
+  sizesOutput[N - 1] = outputSize[0];
+  float horizontalScalingFactor =
+      input->getSizes()[N - 1] * 1.0f / outputSize[0];
+  float verticalScalingFactor = input->getSizes()[N - 2] * 1.0f / outputSize[1];
+  MemRef<float, N> output(sizesOutput);
+  detail::forEachImage(input, &output, numThreads,
+                       [&](Img<float, 2> *inputImage,
+                           MemRef<float, 2> *outputImage, unsigned) {
+                         detail::resize2DInterface(
+                             inputImage, type, horizontalScalingFactor,
+                             verticalScalingFactor, outputImage);
+                       });
+  return output;
+}
+
+// Batched 2D Resize of images of different sizes to `outputSize`
+// ({width, height}), e.g. for thumbnailing.
+inline std::vector<MemRef<float, 2>>
+Resize2DBatch(std::vector<Img<float, 2>> &inputs, INTERPOLATION_TYPE type,
+              intptr_t outputSize[2], unsigned numThreads = 0) {
+  if (outputSize[0] <= 0 || outputSize[1] <= 0) {
+    throw std::invalid_argument(
+        "Please enter positive values of output dimensions.\n");
+  }
+  intptr_t sizesOutput[2] = {outputSize[1], outputSize[0]};
+  std::vector<MemRef<float, 2>> outputs;
+  outputs.reserve(inputs.size());
+  for (size_t i = 0; i < inputs.size(); ++i)
+    outputs.emplace_back(sizesOutput);
+  intptr_t count = inputs.size();
+  detail::parallelFor(
+      count, detail::batchThreads(count, numThreads),
+      [&](intptr_t i, unsigned) {
+        Img<float, 2> &image = inputs[i];
+        detail::resize2DInterface(&image, type,
+                                  image.getSizes()[1] * 1.0f / outputSize[0],
+                                  image.getSizes()[0] * 1.0f / outputSize[1],
+                                  &outputs[i]);
+      });
+  return outputs;
+}
+
+// Batched Erosion.
+template <size_t N>
+void Erosion2DBatch(Img<float, N> *input, MemRef<float, 2> *kernel,
+                    MemRef<float, N> *output, unsigned int centerX,
+                    unsigned int centerY, unsigned int iterations,
+                    BOUNDARY_OPTION option, float constantValue = 0,
+                    unsigned numThreads = 0) {
+  // Erosion and dilation read their initial values from an output-sized
+  // buffer, and more than one iteration overwrites the input.
+  detail::morphBatch(
+      input, output, /*iterations=*/0, iterations > 1, numThreads,
+      [&](Img<float, 2> *inputImage, MemRef<float, 2> *outputImage,
+          detail::MorphScratch &s) {
+        if (option == BOUNDARY_OPTION::CONSTANT_PADDING) {
+          detail::_mlir_ciface_erosion_2d_constant_padding(
+              inputImage, kernel, outputImage, &s.erosionInit, centerX,
+              centerY, iterations, constantValue);
+        } else if (option == BOUNDARY_OPTION::REPLICATE_PADDING) {
+          detail::_mlir_ciface_erosion_2d_replicate_padding(
+              inputImage, kernel, outputImage, &s.erosionInit, centerX,
+              centerY, iterations, 0);
+        }
+      });
+}
+
+// Batched Dilation.
+template <size_t N>
+void Dilation2DBatch(Img<float, N> *input, MemRef<float, 2> *kernel,
+                     MemRef<float, N> *output, unsigned int centerX,
+                     unsigned int centerY, unsigned int iterations,
+                     BOUNDARY_OPTION option, float constantValue = 0,
+                     unsigned numThreads = 0) {
+  detail::morphBatch(
+      input, output, /*iterations=*/0, iterations > 1, numThreads,
+      [&](Img<float, 2> *inputImage, MemRef<float, 2> *outputImage,
+          detail::MorphScratch &s) {
+        if (option == BOUNDARY_OPTION::CONSTANT_PADDING) {
+          detail::_mlir_ciface_dilation_2d_constant_padding(
+              inputImage, kernel, outputImage, &s.dilationInit, centerX,
+              centerY, iterations, constantValue);
+        } else if (option == BOUNDARY_OPTION::REPLICATE_PADDING) {
+          detail::_mlir_ciface_dilation_2d_replicate_padding(
+              inputImage, kernel, outputImage, &s.dilationInit, centerX,
+              centerY, iterations, 0);
+        }
+      });
+}
+
+// Batched Opening.
+template <size_t N>
+void Opening2DBatch(Img<float, N> *input, MemRef<float, 2> *kernel,
+                    MemRef<float, N> *output, unsigned int centerX,
+                    unsigned int centerY, unsigned int iterations,
+                    BOUNDARY_OPTION option, float constantValue = 0,
+                    unsigned numThreads = 0) {
+  detail::morphBatch(
+      input, output, iterations, iterations != 1, numThreads,
+      [&](Img<float, 2> *inputImage, MemRef<float, 2> *outputImage,
+          detail::MorphScratch &s) {
+        if (option == BOUNDARY_OPTION::CONSTANT_PADDING) {
+          detail::_mlir_ciface_opening_2d_constant_padding(
+              inputImage, kernel, outputImage, &s.output1, &s.erosionInit,
+              &s.dilationInit, centerX, centerY, iterations, constantValue);
+        } else if (option == BOUNDARY_OPTION::REPLICATE_PADDING) {
+          detail::_mlir_ciface_opening_2d_replicate_padding(
+              inputImage, kernel, outputImage, &s.output1, &s.erosionInit,
+              &s.dilationInit, centerX, centerY, iterations, 0);
+        }
+      });
+}
+
+// Batched Closing.
+template <size_t N>
+void Closing2DBatch(Img<float, N> *input, MemRef<float, 2> *kernel,
+                    MemRef<float, N> *output, unsigned int centerX,
+                    unsigned int centerY, unsigned int iterations,
+                    BOUNDARY_OPTION option, float constantValue = 0,
+                    unsigned numThreads = 0) {
+  detail::morphBatch(
+      input, output, iterations, iterations != 1, numThreads,
+      [&](Img<float, 2> *inputImage, MemRef<float, 2> *outputImage,
+          detail::MorphScratch &s) {
+        if (option == BOUNDARY_OPTION::CONSTANT_PADDING) {
+          detail::_mlir_ciface_closing_2d_constant_padding(
+              inputImage, kernel, outputImage, &s.output1, &s.dilationInit,
+              &s.erosionInit, centerX, centerY, iterations, constantValue);
+        } else if (option == BOUNDARY_OPTION::REPLICATE_PADDING) {
+          detail::_mlir_ciface_closing_2d_replicate_padding(
+              inputImage, kernel, outputImage, &s.output1, &s.dilationInit,
+              &s.erosionInit, centerX, centerY, iterations, 0);
+        }
+      });
+}
+
+// Batched Top Hat.
+template <size_t N>
+void TopHat2DBatch(Img<float, N> *input, MemRef<float, 2> *kernel,
+                   MemRef<float, N> *output, unsigned int centerX,
+                   unsigned int centerY, unsigned int iterations,
+                   BOUNDARY_OPTION option, float constantValue = 0,
+                   unsigned numThreads = 0) {
+  detail::morphBatch(
+      input, output, iterations, /*copyInput=*/false, numThreads,
+      [&](Img<float, 2> *inputImage, MemRef<float, 2> *outputImage,
+          detail::MorphScratch &s) {
+        if (option == BOUNDARY_OPTION::CONSTANT_PADDING) {
+          detail::_mlir_ciface_tophat_2d_constant_padding(
+              inputImage, kernel, outputImage, &s.output1, &s.output2,
+              &s.input1, &s.erosionInit, &s.dilationInit, centerX, centerY,
+              iterations, constantValue);
+        } else if (option == BOUNDARY_OPTION::REPLICATE_PADDING) {
+          detail::_mlir_ciface_tophat_2d_replicate_padding(
+              inputImage, kernel, outputImage, &s.output1, &s.output2,
+              &s.input1, &s.erosionInit, &s.dilationInit, centerX, centerY,
+              iterations, 0);
+        }
+      });
+}
+
+// Batched Bottom Hat.
+template <size_t N>
+void BottomHat2DBatch(Img<float, N> *input, MemRef<float, 2> *kernel,
+                      MemRef<float, N> *output, unsigned int centerX,
+                      unsigned int centerY, unsigned int iterations,
+                      BOUNDARY_OPTION option, float constantValue = 0,
+                      unsigned numThreads = 0) {
+  detail::morphBatch(
+      input, output, iterations, /*copyInput=*/false, numThreads,
+      [&](Img<float, 2> *inputImage, MemRef<float, 2> *outputImage,
+          detail::MorphScratch &s) {
+        if (option == BOUNDARY_OPTION::CONSTANT_PADDING) {
+          detail::_mlir_ciface_bottomhat_2d_constant_padding(
+              inputImage, kernel, outputImage, &s.output1, &s.output2,
+              &s.input1, &s.dilationInit, &s.erosionInit, centerX, centerY,
+              iterations, constantValue);
+        } else if (option == BOUNDARY_OPTION::REPLICATE_PADDING) {
+          detail::_mlir_ciface_bottomhat_2d_replicate_padding(
+              inputImage, kernel, outputImage, &s.output1, &s.output2,
+              &s.input1, &s.dilationInit, &s.erosionInit, centerX, centerY,
+              iterations, 0);
+        }
+      });
+}
+
+// Batched Morphological Gradient.
+template <size_t N>
+void MorphGrad2DBatch(Img<float, N> *input, MemRef<float, 2> *kernel,
+                      MemRef<float, N> *output, unsigned int centerX,
+                      unsigned int centerY, unsigned int iterations,
+                      BOUNDARY_OPTION option, float constantValue = 0,
+                      unsigned numThreads = 0) {
+  detail::morphBatch(
+      input, output, iterations, /*copyInput=*/false, numThreads,
+      [&](Img<float, 2> *inputImage, MemRef<float, 2> *outputImage,
+          detail::MorphScratch &s) {
+        if (option == BOUNDARY_OPTION::CONSTANT_PADDING) {
+          detail::_mlir_ciface_morphgrad_2d_constant_padding(
+              inputImage, kernel, outputImage, &s.output1, &s.output2,
+              &s.input1, &s.dilationInit, &s.erosionInit, centerX, centerY,
+              iterations, constantValue);
+        } else if (option == BOUNDARY_OPTION::REPLICATE_PADDING) {
+          detail::_mlir_ciface_morphgrad_2d_replicate_padding(
+              inputImage, kernel, outputImage, &s.output1, &s.output2,
+              &s.input1, &s.dilationInit, &s.erosionInit, centerX, centerY,
+              iterations, 0);
+        }
+      });
+}
+
+//===----------------------------------------------------------------------===//
+// Image pyramids
+//===----------------------------------------------------------------------===//
+
+// Gaussian pyramid of an f32 or 8-bit image. Level 0 is the input image, which
+// is not copied, and level i + 1 is PyrDown of level i, of size
+// ((w + 1) / 2)x((h + 1) / 2). All the other levels live in one buffer which is
+// allocated up front, so that building the pyramid allocates nothing per level,
+// and are exposed as non-owning views of that buffer.
+template <typename T> class GaussianPyramid {
+public:
+  // Builds up to `levels` levels; the pyramid stops at the first 1x1 level.
+  GaussianPyramid(Img<T, 2> *image, unsigned int levels,
+                  BOUNDARY_OPTION option = BOUNDARY_OPTION::REPLICATE_PADDING,
+                  detail::NonDeduced<T> constantValue = 0)
+      : base(image), buffer(std::vector<size_t>{bufferSize(image, levels)}) {
+    intptr_t rows = image->getSizes()[0];
+    intptr_t cols = image->getSizes()[1];
+    T *data = buffer.getData();
+    Img<T, 2> *previous = base;
+    for (unsigned int i = 1; i < levels && (rows > 1 || cols > 1); ++i) {
+      rows = (rows + 1) / 2;
+      cols = (cols + 1) / 2;
+      views.push_back(
+          std::make_unique<detail::ImageSlice<T>>(data, rows, cols));
+      detail::pyrDownInterface(previous, views.back().get(), option,
+                               constantValue);
+      previous = views.back().get();
+      data += rows * cols;
+    }
+  }
+
+  // Number of levels, including the input image.
+  size_t size() const { return views.size() + 1; }
+
+  Img<T, 2> *operator[](size_t level) const {
+    return level == 0 ? base : views[level - 1].get();
+  }
+
+private:
+  // Number of pixels of the levels after level 0.
+  static size_t bufferSize(Img<T, 2> *image, unsigned int levels) {
+    intptr_t rows = image->getSizes()[0];
+    intptr_t cols = image->getSizes()[1];
+    size_t total = 0;
+    for (unsigned int i = 1; i < levels && (rows > 1 || cols > 1); ++i) {
+      rows = (rows + 1) / 2;
+      cols = (cols + 1) / 2;
+      total += rows * cols;
+    }
+    // Keep the buffer non-empty for single-level pyramids.
+    return std::max<size_t>(total, 1);
+  }
+
+  Img<T, 2> *base;
+  MemRef<T, 1> buffer;
+  std::vector<std::unique_ptr<detail::ImageSlice<T>>> views;
+};
 } // namespace dip
 
 #endif // FRONTEND_INTERFACES_BUDDY_DIP_DIP
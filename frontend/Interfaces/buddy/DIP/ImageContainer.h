@@ -106,7 +106,7 @@ Img<T, N>::Img(const Img<T, N> &m) : MemRef<T, N>(m) {}
 // Assign the NULL pointer to the original aligned and allocated members to
 // avoid the double free error.
 template <typename T, size_t N>
-Img<T, N>::Img(Img<T, N> &&m) : MemRef<T, N>(m) {}
+Img<T, N>::Img(Img<T, N> &&m) : MemRef<T, N>(std::move(m)) {}
 
 // Move Assignment Operator.
 // Note that the original object no longer owns the members and spaces.
@@ -116,7 +116,8 @@ Img<T, N>::Img(Img<T, N> &&m) : MemRef<T, N>(m) {}
 // Assign the NULL pointer to the original aligned and allocated members to
 // avoid the double free error.
 template <typename T, size_t N> Img<T, N> &Img<T, N>::operator=(Img<T, N> &&m) {
-  MemRef<T, N>::operator=(m);
+  MemRef<T, N>::operator=(std::move(m));
+  return *this;
 }
 
 /**
@@ -147,11 +148,16 @@ Img<T, N>::Img(cv::Mat image, intptr_t sizes[N], bool norm) : MemRef<T, N>() {
     assert((N == 2 || N == 4) &&
            "For gray images, the number of dimensions can be 2 or 4.");
   } else if (image.channels() == 3) {
-    assert((N == 4) && "For RGB images, the number of dimensions must be 4, "
-                       "either in NHWC or NCHW layout.");
+    assert((N == 3 || N == 4) &&
+           "For RGB images, the number of dimensions must be 3 in interleaved "
+           "HWC layout, or 4 in NHWC or NCHW layout.");
+  } else if (image.channels() == 4) {
+    assert((N == 3) && "For RGBA images, the number of dimensions must be 3, "
+                       "in interleaved HWC layout.");
   } else {
-    std::cerr << "Only 2-channel gray images and 3-channel RGB images are "
-                 "supported, but got images' channel equal to "
+    std::cerr << "Only 1-channel gray images, 3-channel RGB images and "
+                 "4-channel RGBA images are supported, but got images' channel "
+                 "equal to "
               << image.channels() << "." << std::endl;
   }
   // Use default layout setting.
@@ -161,6 +167,12 @@ Img<T, N>::Img(cv::Mat image, intptr_t sizes[N], bool norm) : MemRef<T, N>() {
       this->sizes[0] = image.rows;
       this->sizes[1] = image.cols;
     }
+    // Color images keep the interleaved channels of OpenCV in HWC layout.
+    if (N == 3) {
+      this->sizes[0] = image.rows;
+      this->sizes[1] = image.cols;
+      this->sizes[2] = image.channels();
+    }
     this->setStrides();
     this->allocated = new T[this->product(this->sizes)];
     this->aligned = this->allocated;
@@ -178,6 +190,27 @@ Img<T, N>::Img(cv::Mat image, intptr_t sizes[N], bool norm) : MemRef<T, N>() {
         }
       }
     }
+    // Load interleaved color image data from OpenCV Mat. Mats of the element
+    // type of the image are copied as is, and 8-bit Mats are converted.
+    if (N == 3) {
+      bool sameDepth = image.depth() == cv::DataType<T>::depth;
+      assert((sameDepth || image.depth() == CV_8U) &&
+             "Interleaved images are loaded from 8-bit Mats or from Mats of "
+             "the element type of the image.");
+      size_t k = 0;
+      for (int i = 0; i < image.rows; i++) {
+        for (int j = 0; j < image.cols * image.channels(); j++) {
+          if (sameDepth) {
+            this->aligned[k] = image.ptr<T>(i)[j];
+          } else if (norm) {
+            this->aligned[k] = (T)image.ptr<uchar>(i)[j] / 255;
+          } else {
+            this->aligned[k] = (T)image.ptr<uchar>(i)[j];
+          }
+          k++;
+        }
+      }
+    }
   } else {
     // Use custom layout setting.
     // Only support gray scale image and NCHW now.
@@ -214,4 +247,19 @@ template <typename T, size_t N> int Img<T, N>::channels() {
   return this->sizes[2];
 }
 
+// Non-owning image over pixels owned by the caller, e.g. the data of a decoded
+// cv::Mat, so that decoded frames reach the DIP interfaces without a copy. The
+// pixels must be contiguous in row-major order and outlive the view, which
+// never frees them. Copies of a view own a deep copy of the pixels.
+template <typename T, size_t N> class ImgView : public Img<T, N> {
+public:
+  ImgView(T *data, intptr_t sizes[N]) {
+    for (size_t i = 0; i < N; i++) {
+      this->sizes[i] = sizes[i];
+    }
+    this->setStrides();
+    this->aligned = data;
+  }
+};
+
 #endif // FRONTEND_INTERFACES_BUDDY_DIP_IMAGECONTAINER
@@ -52,6 +52,7 @@
 #include "buddy/DIP/ImageContainer.h"
 #include "buddy/DIP/imgcodecs/replenishment.h"
 #include "buddy/DIP/imgcodecs/utils.h"
+#include <stdexcept>
 #include <stdio.h>
 #include <string.h>
 
@@ -62,6 +63,8 @@ public:
   RBaseStream();
   virtual ~RBaseStream();
   virtual bool open(const String &filename);
+  // Reads the `size` bytes at `data`, which must outlive the stream.
+  virtual bool open(const uchar *data, size_t size);
   virtual void close();
   bool isOpened();
   void setPos(int pos);
@@ -203,6 +206,7 @@ template <typename T, size_t N> void RBaseStream<T, N>::readBlock() {
   if (m_file == 0) {
     if (m_block_pos == 0 && m_current < m_end)
       return;
+    throw std::runtime_error("Unexpected end of the image data.");
   }
 
   fseek(m_file, m_block_pos, SEEK_SET);
@@ -227,6 +231,19 @@ bool RBaseStream<T, N>::open(const String &filename) {
   return m_file != 0;
 }
 
+template <typename T, size_t N>
+bool RBaseStream<T, N>::open(const uchar *data, size_t size) {
+  close();
+  release();
+
+  m_start = const_cast<uchar *>(data);
+  m_end = m_start + size;
+  m_current = m_start;
+  m_block_pos = 0;
+  m_is_opened = true;
+  return true;
+}
+
 template <typename T, size_t N> void RBaseStream<T, N>::close() {
   if (m_file) {
     fclose(m_file);
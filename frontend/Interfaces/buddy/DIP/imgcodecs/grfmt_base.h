@@ -68,6 +68,9 @@ public:
   // ExifEntry_t getExifTag(const ExifTagName tag) const;
   virtual bool setSource(const String &filename);
   virtual bool setSource(const Img<T, N> &buf);
+  // Decodes the encoded image held in the `size` bytes at `data`, which must
+  // outlive the decoder.
+  virtual bool setSource(const uchar *data, size_t size);
   virtual int setScale(const int &scale_denom);
   virtual bool readHeader() = 0;
   virtual bool readData(Img<T, N> &img) = 0;
@@ -87,6 +90,8 @@ protected:
   String m_filename;
   String m_signature;
   Img<T, N> m_buf;
+  const uchar *m_data; // encoded image in memory ( set by setSource )
+  size_t m_data_size;
   bool m_buf_supported;
   // ExifReader m_exif;
 };
@@ -118,12 +123,16 @@ template <typename T, size_t N> BaseImageDecoder<T, N>::BaseImageDecoder() {
   m_channels = -1;
   m_buf_supported = false;
   m_scale_denom = 1;
+  m_data = 0;
+  m_data_size = 0;
 }
 
 template <typename T, size_t N>
 bool BaseImageDecoder<T, N>::setSource(const String &filename) {
   m_filename = filename;
   m_buf.release();
+  m_data = 0;
+  m_data_size = 0;
   return true;
 }
 
@@ -136,6 +145,16 @@ bool BaseImageDecoder<T, N>::setSource(const Img<T, N> &buf) {
   return true;
 }
 
+template <typename T, size_t N>
+bool BaseImageDecoder<T, N>::setSource(const uchar *data, size_t size) {
+  if (!m_buf_supported)
+    return false;
+  m_filename = String();
+  m_data = data;
+  m_data_size = size;
+  return true;
+}
+
 template <typename T, size_t N>
 size_t BaseImageDecoder<T, N>::signatureLength() const {
   return m_signature.size();
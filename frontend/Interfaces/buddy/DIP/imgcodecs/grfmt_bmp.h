@@ -142,7 +142,10 @@ void BmpDecoder<T, N>::maskBGRA(uchar *des, uchar *src, int num) {
 template <typename T, size_t N> bool BmpDecoder<T, N>::readHeader() {
   bool result = false;
   bool iscolor = false;
-  m_strm.open(this->m_filename);
+  if (this->m_data)
+    m_strm.open(this->m_data, this->m_data_size);
+  else
+    m_strm.open(this->m_filename);
   try {
     m_strm.skip(10);
     m_offset = m_strm.getDWord();
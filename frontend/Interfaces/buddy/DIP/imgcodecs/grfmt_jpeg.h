@@ -58,6 +58,8 @@
 #include <algorithm>
 #include <setjmp.h>
 #include <stdio.h>
+#include <type_traits>
+#include <vector>
 
 // the following defines are a hack to avoid multiple problems with frame
 // pointer handling and setjmp see
@@ -154,11 +156,21 @@ public:
   bool readHeader();
   void close();
 
+  // Requests an image of at least width x height pixels (0 for any size). The
+  // decoder then downscales by the largest of 1/2, 1/4 and 1/8 that keeps the
+  // image that large, in the DCT domain, so that a following resize reads a
+  // smaller image. Must be called before readHeader.
+  void setTargetSize(int width, int height);
+
   std::unique_ptr<BaseImageDecoder<T, N>> newDecoder() const;
 
 protected:
+  int reducedScaleDenom(int width, int height) const;
+
   FILE *m_f;
   void *m_state;
+  int m_target_width;
+  int m_target_height;
 
 private:
   JpegDecoder(const JpegDecoder &);            // copy disabled
@@ -246,6 +258,7 @@ template <typename T, size_t N> JpegDecoder<T, N>::JpegDecoder() {
   this->m_signature = "\xFF\xD8\xFF";
   m_state = 0;
   m_f = 0;
+  m_target_width = m_target_height = 0;
   this->m_buf_supported = true;
 }
 
@@ -273,6 +286,24 @@ std::unique_ptr<BaseImageDecoder<T, N>> JpegDecoder<T, N>::newDecoder() const {
   return std::make_unique<JpegDecoder<T, N>>();
 }
 
+template <typename T, size_t N>
+void JpegDecoder<T, N>::setTargetSize(int width, int height) {
+  m_target_width = width;
+  m_target_height = height;
+}
+
+// Largest supported scale denominator whose output (rounded up, as libjpeg
+// does) still covers the target size.
+template <typename T, size_t N>
+int JpegDecoder<T, N>::reducedScaleDenom(int width, int height) const {
+  for (int denom = 8; denom > 1; denom /= 2) {
+    if ((width + denom - 1) / denom >= m_target_width &&
+        (height + denom - 1) / denom >= m_target_height)
+      return denom;
+  }
+  return 1;
+}
+
 template <typename T, size_t N> bool JpegDecoder<T, N>::readHeader() {
   volatile bool result = false;
   close();
@@ -285,9 +316,15 @@ template <typename T, size_t N> bool JpegDecoder<T, N>::readHeader() {
   if (setjmp(state->jerr.setjmp_buffer) == 0) {
     jpeg_create_decompress(&state->cinfo);
 
-    m_f = fopen(this->m_filename.c_str(), "rb");
-    if (m_f)
-      jpeg_stdio_src(&state->cinfo, m_f);
+    if (this->m_data) {
+      jpeg_buffer_src(&state->cinfo, &state->source);
+      state->source.pub.next_input_byte = this->m_data;
+      state->source.pub.bytes_in_buffer = this->m_data_size;
+    } else {
+      m_f = fopen(this->m_filename.c_str(), "rb");
+      if (m_f)
+        jpeg_stdio_src(&state->cinfo, m_f);
+    }
 
     if (state->cinfo.src != 0) {
       jpeg_save_markers(&state->cinfo, APP1, 0xffff);
@@ -295,6 +332,9 @@ template <typename T, size_t N> bool JpegDecoder<T, N>::readHeader() {
 
       state->cinfo.scale_num = 1;
       state->cinfo.scale_denom = this->m_scale_denom;
+      if (m_target_width > 0 || m_target_height > 0)
+        state->cinfo.scale_denom = reducedScaleDenom(
+            state->cinfo.image_width, state->cinfo.image_height);
       this->m_scale_denom =
           1; // trick! to know which decoder used scale_denom see imread_
       jpeg_calc_output_dimensions(&state->cinfo);
@@ -424,6 +464,48 @@ static int my_jpeg_load_dht(struct jpeg_decompress_struct *info,
  ***************************************************************************/
 #endif // IMG_MANUAL_JPEG_STD_HUFF_TABLES
 
+// Number of scanlines decoded by one jpeg_read_scanlines batch.
+static const int kJpegScanlineBatch = 16;
+
+#ifdef JCS_EXTENSIONS
+// libjpeg-turbo writes BGR pixels with its SIMD color converters.
+static const bool kJpegDecodesBGR = true;
+#else
+static const bool kJpegDecodesBGR = false;
+#endif
+
+// Converts one decoded scanline of `components` samples per pixel to the
+// `channels` channels of the image. The plain and swapped copies are simple
+// contiguous loops that the compiler vectorizes, including the widening to
+// float.
+template <typename T>
+static void convertJpegScanline(const uchar *src, T *dst, int width,
+                                int components, int channels, bool swapRB) {
+  if (components == 4) {
+    for (int i = 0; i < width; i++, src += 4, dst += channels) {
+      int c = src[0], m = src[1], y = src[2], k = src[3];
+      c = k - ((255 - c) * k >> 8);
+      m = k - ((255 - m) * k >> 8);
+      y = k - ((255 - y) * k >> 8);
+      if (channels > 1) {
+        dst[2] = (T)c;
+        dst[1] = (T)m;
+        dst[0] = (T)y;
+      } else {
+        dst[0] = (T)descale(y * cB + m * cG + c * cR, SCALE);
+      }
+    }
+  } else if (swapRB) {
+    for (int i = 0; i < width; i++) {
+      dst[3 * i] = (T)src[3 * i + 2];
+      dst[3 * i + 1] = (T)src[3 * i + 1];
+      dst[3 * i + 2] = (T)src[3 * i];
+    }
+  } else {
+    convertFromU8(src, dst, (size_t)width * components);
+  }
+}
+
 template <typename T, size_t N>
 bool JpegDecoder<T, N>::readData(Img<T, N> &img) {
   volatile bool result = false;
@@ -433,7 +515,6 @@ bool JpegDecoder<T, N>::readData(Img<T, N> &img) {
   if (m_state && this->m_width && this->m_height) {
     jpeg_decompress_struct *cinfo = &((JpegState *)m_state)->cinfo;
     JpegErrorMgr *jerr = &((JpegState *)m_state)->jerr;
-    JSAMPARRAY buffer = 0;
 
     if (setjmp(jerr->setjmp_buffer) == 0) {
 #ifdef IMG_MANUAL_JPEG_STD_HUFF_TABLES
@@ -451,7 +532,11 @@ bool JpegDecoder<T, N>::readData(Img<T, N> &img) {
 
       if (color) {
         if (cinfo->num_components != 4) {
+#ifdef JCS_EXTENSIONS
+          cinfo->out_color_space = JCS_EXT_BGR;
+#else
           cinfo->out_color_space = JCS_RGB;
+#endif
           cinfo->out_color_components = 3;
         } else {
           cinfo->out_color_space = JCS_CMYK;
@@ -476,72 +561,47 @@ bool JpegDecoder<T, N>::readData(Img<T, N> &img) {
         cmarker = cmarker->next;
       }
       jpeg_start_decompress(cinfo);
-      buffer = (*cinfo->mem->alloc_sarray)((j_common_ptr)cinfo, JPOOL_IMAGE,
-                                           this->m_width * 4, 1);
+
+      // Scanlines are decoded in batches. 8-bit images whose layout matches
+      // the decoder output are decoded straight into their rows, the others
+      // go through a batch buffer and are converted row by row.
+      int components = cinfo->out_color_components;
+      bool swapRB = color && components == 3 && !kJpegDecodesBGR;
+      bool direct = std::is_same<T, uchar>::value &&
+                    components == img.channels() && !swapRB;
+      int batchRows = std::max(kJpegScanlineBatch, cinfo->rec_outbuf_height);
+      JSAMPARRAY buffer = 0;
+      if (!direct)
+        buffer = (*cinfo->mem->alloc_sarray)(
+            (j_common_ptr)cinfo, JPOOL_IMAGE, this->m_width * 4, batchRows);
+      std::vector<JSAMPROW> rows(batchRows);
       T *data = img.getData();
-      for (; this->m_height--; data += step) {
-        jpeg_read_scanlines(cinfo, buffer, 1);
-        if (color) {
-          if (cinfo->out_color_components == 3) {
-            int bgr_step = 0;
-            int rgb_step = 0;
-            _Size size(this->m_width, 1);
-            for (; size.height--;) {
-              for (int i = 0; i < size.width; i++, buffer[0] += 3, data += 3) {
-                uchar t0 = buffer[0][0], t1 = buffer[0][1], t2 = buffer[0][2];
-                data[2] = (T)t0;
-                data[1] = (T)t1;
-                data[0] = (T)t2;
-              }
-              buffer[0] += bgr_step - size.width * 3;
-              data += rgb_step - size.width * 3;
-            }
-          } else {
-            int cmyk_step = 0;
-            int bgr_step = 0;
-            _Size size(this->m_width, 1);
-            for (; size.height--;) {
-              for (int i = 0; i < size.width; i++, data += 3, buffer[0] += 4) {
-                int c = buffer[0][0], m = buffer[0][1], y = buffer[0][2],
-                    k = buffer[0][3];
-                c = k - ((255 - c) * k >> 8);
-                m = k - ((255 - m) * k >> 8);
-                y = k - ((255 - y) * k >> 8);
-                data[2] = (T)c;
-                data[1] = (T)m;
-                data[0] = (T)y;
-              }
-              data += bgr_step - size.width * 3;
-              buffer[0] += cmyk_step - size.width * 4;
-            }
-          }
-        } else {
-          if (cinfo->out_color_components == 1) {
-            for (int i = 0; i < this->m_width; i++) {
-              data[i] = (T)buffer[0][i];
-            }
-          } else {
-            int cmyk_step = 0;
-            int gray_step = 0;
-            _Size size(this->m_width, 1);
-            for (; size.height--;) {
-              for (int i = 0; i < size.width; i++, buffer[0] += 4) {
-                int c = buffer[0][0], m = buffer[0][1], y = buffer[0][2],
-                    k = buffer[0][3];
-                c = k - ((255 - c) * k >> 8);
-                m = k - ((255 - m) * k >> 8);
-                y = k - ((255 - y) * k >> 8);
-                int t = descale(y * cB + m * cG + c * cR, SCALE);
-                data[i] = (T)t;
-              }
-              data += gray_step;
-              buffer[0] += cmyk_step - size.width * 4;
-            }
-          }
+      int y = 0;
+      while (y < this->m_height) {
+        int count = std::min(batchRows, this->m_height - y);
+        for (int i = 0; i < count; i++)
+          rows[i] = direct ? (JSAMPROW)(data + (y + i) * step) : buffer[i];
+        int read = 0;
+        while (read < count) {
+          JDIMENSION lines =
+              jpeg_read_scanlines(cinfo, &rows[read], count - read);
+          if (lines == 0)
+            break;
+          read += lines;
         }
+        if (!direct) {
+          for (int i = 0; i < read; i++)
+            convertJpegScanline(rows[i], data + (y + i) * step, this->m_width,
+                                components, img.channels(), swapRB);
+        }
+        if (read < count)
+          break;
+        y += count;
+      }
+      if (y == this->m_height) {
+        result = true;
+        jpeg_finish_decompress(cinfo);
       }
-      result = true;
-      jpeg_finish_decompress(cinfo);
     }
   }
   close();
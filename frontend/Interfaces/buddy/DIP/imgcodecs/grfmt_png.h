@@ -59,6 +59,8 @@
 #include "buddy/DIP/imgcodecs/bitstrm.h"
 #include "buddy/DIP/imgcodecs/grfmt_base.h"
 #include <png.h>
+#include <type_traits>
+#include <vector>
 #include <zlib.h>
 
 #if defined _MSC_VER && _MSC_VER >= 1200
@@ -79,6 +81,10 @@ public:
   PngDecoder();
   virtual ~PngDecoder();
   bool readData(Img<T, N> &img);
+  // Decodes the image as 8-bit pixels with `channels` channels (1, 3 or 4)
+  // into `buffer`, whose rows are `step` bytes apart. libpng writes the rows
+  // in place, so a caller can decode into memory it reuses across images.
+  bool readData(uchar *buffer, size_t step, int channels);
   bool readHeader();
   void close();
   std::unique_ptr<BaseImageDecoder<T, N>> newDecoder() const;
@@ -91,6 +97,8 @@ protected:
   FILE *m_f;
   int m_color_type;
   size_t m_buf_pos;
+
+  static void readDataFromBuf(void *png_ptr, uchar *dst, size_t size);
 };
 
 template <typename T, size_t N>
@@ -144,6 +152,19 @@ template <typename T, size_t N> void PngDecoder<T, N>::close() {
   }
 }
 
+template <typename T, size_t N>
+void PngDecoder<T, N>::readDataFromBuf(void *_png_ptr, uchar *dst,
+                                       size_t size) {
+  png_structp png_ptr = (png_structp)_png_ptr;
+  PngDecoder<T, N> *decoder = (PngDecoder<T, N> *)(png_get_io_ptr(png_ptr));
+  if (decoder->m_buf_pos + size > decoder->m_data_size) {
+    png_error(png_ptr, "PNG input buffer is incomplete");
+    return;
+  }
+  memcpy(dst, decoder->m_data + decoder->m_buf_pos, size);
+  decoder->m_buf_pos += size;
+}
+
 template <typename T, size_t N> bool PngDecoder<T, N>::readHeader() {
   volatile bool result = false;
   close();
@@ -157,10 +178,14 @@ template <typename T, size_t N> bool PngDecoder<T, N>::readHeader() {
     m_buf_pos = 0;
     if (info_ptr && end_info) {
       if (setjmp(png_jmpbuf(png_ptr)) == 0) {
-        m_f = fopen(this->m_filename.c_str(), "rb");
-        if (m_f)
-          png_init_io(png_ptr, m_f);
-        if (m_f) {
+        if (this->m_data) {
+          png_set_read_fn(png_ptr, this, (png_rw_ptr)readDataFromBuf);
+        } else {
+          m_f = fopen(this->m_filename.c_str(), "rb");
+          if (m_f)
+            png_init_io(png_ptr, m_f);
+        }
+        if (this->m_data || m_f) {
           png_uint_32 wdth, hght;
           int bit_depth, color_type, num_trans = 0;
           png_bytep trans;
@@ -201,27 +226,38 @@ template <typename T, size_t N> bool PngDecoder<T, N>::readHeader() {
   return result;
 }
 
+// 8-bit images are decoded straight into their storage. Other images are
+// decoded into a byte buffer and widened in a separate pass.
 template <typename T, size_t N>
 bool PngDecoder<T, N>::readData(Img<T, N> &img) {
+  size_t step = this->m_width * img.channels();
+  if (std::is_same<T, uchar>::value)
+    return readData((uchar *)img.getData(), step, img.channels());
+
+  std::vector<uchar> pixels(step * this->m_height);
+  bool result = readData(pixels.data(), step, img.channels());
+  if (result)
+    convertFromU8(pixels.data(), img.getData(), pixels.size());
+  return result;
+}
+
+template <typename T, size_t N>
+bool PngDecoder<T, N>::readData(uchar *buffer, size_t step, int channels) {
   volatile bool result = false;
-  uchar **_buffer = new uchar *[this->m_height];
-  uchar **buffer = _buffer;
-  bool color = img.channels() > 1;
-  T *data = img.getData();
+  bool color = channels > 1;
+  std::vector<png_bytep> rows(this->m_height);
   png_structp png_ptr = (png_structp)m_png_ptr;
   png_infop info_ptr = (png_infop)m_info_ptr;
   png_infop end_info = (png_infop)m_end_info;
   if (m_png_ptr && m_info_ptr && m_end_info && this->m_width &&
       this->m_height) {
     if (setjmp(png_jmpbuf(png_ptr)) == 0) {
-      int y;
-
       if (m_bit_depth == 16)
         png_set_strip_16(png_ptr);
       else if (!isBigEndian())
         png_set_swap(png_ptr);
 
-      if (img.channels() < 4) {
+      if (channels < 4) {
         /* observation: png_read_image() writes 400 bytes beyond
          * end of data when reading a 400x118 color png
          * "mpplus_sand.png".  OpenCV crashes even with demo
@@ -258,18 +294,11 @@ bool PngDecoder<T, N>::readData(Img<T, N> &img) {
       png_set_interlace_handling(png_ptr);
       png_read_update_info(png_ptr, info_ptr);
 
-      size_t step = this->m_width * img.channels();
-      uchar *myArry = new uchar[img.getSize()];
       for (int y = 0; y < this->m_height; y++)
-        buffer[y] = myArry + y * step;
+        rows[y] = buffer + y * step;
 
-      png_read_image(png_ptr, buffer);
+      png_read_image(png_ptr, rows.data());
       png_read_end(png_ptr, end_info);
-      for (int i = 0; i < img.getSize(); i++) {
-        data[i] = (T)myArry[i];
-      }
-      delete[] myArry;
-      delete[] _buffer;
 #ifdef PNG_eXIf_SUPPORTED
       png_uint_32 num_exif = 0;
       png_bytep exif = 0;
@@ -54,6 +54,15 @@
 #include "buddy/DIP/imgcodecs/grfmt_jpeg.h"
 #include "buddy/DIP/imgcodecs/grfmt_png.h"
 #include "buddy/DIP/imgcodecs/replenishment.h"
+#include <condition_variable>
+#include <deque>
+#include <errno.h>
+#include <fcntl.h>
+#include <future>
+#include <mutex>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
 
 namespace dip {
 template <typename T, size_t N> struct ImageCodecInitializer {
@@ -92,6 +101,35 @@ static ImageCodecInitializer<T, N> &getCodecs() {
 #endif
 }
 
+/**
+ * Find the decoder for an image signature
+ *
+ * @param[in] signature Leading bytes of the encoded image
+ *
+ * @return Image decoder to parse the image.
+ */
+template <typename T, size_t N>
+static std::unique_ptr<BaseImageDecoder<T, N>>
+findDecoderForSignature(const String &signature) {
+  ImageCodecInitializer<T, N> &codecs = getCodecs<T, N>();
+  /// compare signature against all decoders
+  for (size_t i = 0; i < codecs.decoders.size(); i++) {
+    if (codecs.decoders[i]->checkSignature(signature))
+      return codecs.decoders[i]->newDecoder();
+  }
+  /// If no decoder was found, return base type
+  return nullptr;
+}
+
+/// Length of the longest signature of the registered decoders.
+template <typename T, size_t N> static size_t maxSignatureLength() {
+  size_t maxlen = 0;
+  ImageCodecInitializer<T, N> &codecs = getCodecs<T, N>();
+  for (size_t i = 0; i < codecs.decoders.size(); i++)
+    maxlen = std::max(maxlen, codecs.decoders[i]->signatureLength());
+  return maxlen;
+}
+
 /**
  * Find the decoders
  *
@@ -102,15 +140,7 @@ static ImageCodecInitializer<T, N> &getCodecs() {
 template <typename T, size_t N>
 static std::unique_ptr<BaseImageDecoder<T, N>>
 findDecoder(const String &filename) {
-
-  size_t i, maxlen = 0;
-
-  /// iterate through list of registered codecs
-  ImageCodecInitializer<T, N> &codecs = getCodecs<T, N>();
-  for (i = 0; i < codecs.decoders.size(); i++) {
-    size_t len = codecs.decoders[i]->signatureLength();
-    maxlen = std::max(maxlen, len);
-  }
+  size_t maxlen = maxSignatureLength<T, N>();
 
   /// Open the file
   FILE *f = fopen(filename.c_str(), "rb");
@@ -125,104 +155,432 @@ findDecoder(const String &filename) {
   fclose(f);
   signature = signature.substr(0, maxlen);
 
-  /// compare signature against all decoders
-  for (i = 0; i < codecs.decoders.size(); i++) {
-    if (codecs.decoders[i]->checkSignature(signature))
-      return codecs.decoders[i]->newDecoder();
+  return findDecoderForSignature<T, N>(signature);
+}
+
+/**
+ * Find the decoder of an encoded image held in memory
+ *
+ * @param[in] data Encoded image
+ * @param[in] size Size of the encoded image in bytes
+ *
+ * @return Image decoder to parse the image.
+ */
+template <typename T, size_t N>
+static std::unique_ptr<BaseImageDecoder<T, N>> findDecoder(const uchar *data,
+                                                           size_t size) {
+  size_t maxlen = std::min(maxSignatureLength<T, N>(), size);
+  return findDecoderForSignature<T, N>(String((const char *)data, maxlen));
+}
+
+/**
+ * Read the header of the image a decoder was pointed at
+ *
+ * @param[in] decoder Decoder whose source is set
+ * @param[in] flags IMGRD_* flags
+ * @param[in] targetSize Smallest size the caller needs, see imread.
+ * @param[out] sizes Height, width and channels of the decoded image.
+ */
+template <typename T, size_t N>
+static void readImageHeader(BaseImageDecoder<T, N> &decoder, int flags,
+                            const _Size &targetSize, intptr_t sizes[3]) {
+  // Defines whether the image is scaled or not
+  int scale_denom = 1;
+  decoder.setScale(scale_denom);
+  JpegDecoder<T, N> *JpegDecoderPtr =
+      dynamic_cast<JpegDecoder<T, N> *>(&decoder);
+  if (JpegDecoderPtr)
+    JpegDecoderPtr->setTargetSize(targetSize.width, targetSize.height);
+  if (!decoder.readHeader())
+    throw std::runtime_error("Failed to read the image header.");
+  int channels = decoder.channels();
+  if ((flags & IMGRD_COLOR) != 0 ||
+      ((flags & IMGRD_ANYCOLOR) != 0 && channels > 1)) {
+    channels = 3;
+  } else {
+    channels = 1;
   }
-  /// If no decoder was found, return base type
-  return nullptr;
+  sizes[0] = decoder.height();
+  sizes[1] = decoder.width();
+  sizes[2] = channels;
 }
 
+/**
+ * Read an image
+ *
+ * @param[in] filename File to read
+ * @param[in] flags IMGRD_* flags
+ * @param[in] targetSize Smallest size the caller needs, e.g. the input size of
+ * a model the image is resized to. JPEG images are then downscaled by up to 8
+ * while decoding, as long as they stay at least that large.
+ *
+ * @return Decoded image.
+ */
 template <typename T, size_t N>
-Img<T, N> imread(const String &filename, int flags) {
+Img<T, N> imread(const String &filename, int flags,
+                 _Size targetSize = _Size()) {
   std::unique_ptr<BaseImageDecoder<T, N>> decoder = findDecoder<T, N>(filename);
 
   if (!decoder) {
     throw std::runtime_error("Decoder not found for the given image.");
   }
 
-  if (decoder) {
-    // Converts a pointer to BmpDecoder<T, N>
-    BmpDecoder<T, N> *bmpDecoderPtr =
-        dynamic_cast<BmpDecoder<T, N> *>(decoder.get());
-    if (bmpDecoderPtr) {
-      // After creating the BmpDecoder<T, N> instance, perform related
-      // operations Defines whether the image is scaled or not
-      int scale_denom = 1;
-      bmpDecoderPtr->setScale(scale_denom);
-      // Set image path
-      bmpDecoderPtr->setSource(filename);
-      // Read image head
-      bmpDecoderPtr->readHeader();
-      int channels = bmpDecoderPtr->channels();
-      if ((flags & IMGRD_COLOR) != 0 ||
-          ((flags & IMGRD_ANYCOLOR) != 0 && channels > 1)) {
-        channels = 3;
-      } else {
-        channels = 1;
+  // Set image path
+  decoder->setSource(filename);
+  intptr_t sizes[3];
+  readImageHeader(*decoder, flags, targetSize, sizes);
+  // Create an Img instance
+  Img<T, N> Image(sizes);
+  decoder->readData(Image);
+  return Image;
+}
+
+/**
+ * Decode an image held in memory
+ *
+ * @param[in] data Encoded image, e.g. the contents of a JPEG, PNG or BMP file
+ * @param[in] size Size of the encoded image in bytes
+ * @param[in] flags IMGRD_* flags
+ * @param[in] targetSize Smallest size the caller needs, see imread.
+ *
+ * @return Decoded image.
+ */
+template <typename T, size_t N>
+Img<T, N> imdecode(const uchar *data, size_t size, int flags,
+                   _Size targetSize = _Size()) {
+  std::unique_ptr<BaseImageDecoder<T, N>> decoder =
+      findDecoder<T, N>(data, size);
+
+  if (!decoder) {
+    throw std::runtime_error("Decoder not found for the given image.");
+  }
+
+  decoder->setSource(data, size);
+  intptr_t sizes[3];
+  readImageHeader(*decoder, flags, targetSize, sizes);
+  Img<T, N> Image(sizes);
+  decoder->readData(Image);
+  return Image;
+}
+
+/**
+ * Read a whole file into memory
+ *
+ * @param[in] filename File to read
+ * @param[out] bytes Contents of the file
+ *
+ * @return Whether the file could be read.
+ */
+inline bool readFileBytes(const String &filename, std::vector<uchar> &bytes) {
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+  struct stat st;
+  bool result = fstat(fd, &st) == 0;
+  if (result) {
+    bytes.resize(st.st_size);
+    size_t done = 0;
+    // pread keeps no file position, so a short read simply continues at the
+    // next offset.
+    while (done < bytes.size()) {
+      ssize_t n = pread(fd, bytes.data() + done, bytes.size() - done, done);
+      if (n < 0 && errno == EINTR)
+        continue;
+      if (n <= 0) {
+        result = false;
+        break;
       }
-      // Create an Img instance
-      intptr_t sizes[3] = {bmpDecoderPtr->height(), bmpDecoderPtr->width(),
-                           channels};
-      Img<T, N> Image(sizes);
-      bmpDecoderPtr->readData(Image);
-      return Image;
+      done += n;
     }
-    // Converts a pointer to JpegDecoder<T, N>
-    JpegDecoder<T, N> *JpegDecoderPtr =
-        dynamic_cast<JpegDecoder<T, N> *>(decoder.get());
-    if (JpegDecoderPtr) {
-      // After creating the JpegDecoder<T, N> instance, perform related
-      // operations Defines whether the image is scaled or not
-      int scale_denom = 1;
-      JpegDecoderPtr->setScale(scale_denom);
-      // Set image path
-      JpegDecoderPtr->setSource(filename);
-      // Read image head
-      JpegDecoderPtr->readHeader();
-      int channels = JpegDecoderPtr->channels();
-      if ((flags & IMGRD_COLOR) != 0 ||
-          ((flags & IMGRD_ANYCOLOR) != 0 && channels > 1)) {
-        channels = 3;
-      } else {
-        channels = 1;
-      }
-      // Create an Img instance
-      intptr_t sizes[3] = {JpegDecoderPtr->height(), JpegDecoderPtr->width(),
-                           channels};
-      Img<T, N> Image(sizes);
-      JpegDecoderPtr->readData(Image);
-      return Image;
+  }
+  ::close(fd);
+  return result;
+}
+
+// Non-owning view of one image of a batch tensor, which decoders write into
+// directly.
+template <typename T, size_t N> class BatchEntry : public Img<T, N> {
+public:
+  BatchEntry(MemRef<T, N + 1> &batch, intptr_t index) {
+    const intptr_t *sizes = batch.getSizes();
+    intptr_t count = 1;
+    for (size_t i = 0; i < N; i++) {
+      this->sizes[i] = sizes[i + 1];
+      count *= sizes[i + 1];
     }
+    this->setStrides();
+    this->aligned = batch.getData() + index * count;
+  }
+};
 
-    // Converts a pointer to BmpDecoder<T, N>
-    PngDecoder<T, N> *PngDecoderPtr =
-        dynamic_cast<PngDecoder<T, N> *>(decoder.get());
-    if (PngDecoderPtr) {
-      // After creating the BmpDecoder<T, N> instance, perform related
-      // operations Defines whether the image is scaled or not
-      int scale_denom = 1;
-      PngDecoderPtr->setScale(scale_denom);
-      // Set image path
-      PngDecoderPtr->setSource(filename);
-      // Read image head
-      PngDecoderPtr->readHeader();
-      int channels = PngDecoderPtr->channels();
-      if ((flags & IMGRD_COLOR) != 0 ||
-          ((flags & IMGRD_ANYCOLOR) != 0 && channels > 1)) {
-        channels = 3;
-      } else {
-        channels = 1;
-      }
-      // Create an Img instance
-      intptr_t sizes[3] = {PngDecoderPtr->height(), PngDecoderPtr->width(),
-                           channels};
-      Img<T, N> Image(sizes);
-      PngDecoderPtr->readData(Image);
-      return Image;
+/**
+ * Asynchronous image decoder
+ *
+ * Decodes images on a pool of worker threads and hands them out in the order
+ * they were pushed. A reader thread loads the files ahead of the workers, so
+ * that decoding never waits for I/O, and the signature is taken from the loaded
+ * bytes instead of reopening the file. The public member functions may be
+ * called from several threads at once.
+ *
+ * Usage:
+ *   ImageDecodeQueue<uchar, 3> queue(IMGRD_COLOR);
+ *   for (const String &path : paths)
+ *     queue.push(path);
+ *   for (size_t i = 0; i < paths.size(); i++)
+ *     Img<uchar, 3> image = queue.pop();
+ */
+template <typename T, size_t N> class ImageDecodeQueue {
+public:
+  /**
+   * @param[in] flags IMGRD_* flags
+   * @param[in] numThreads Number of decoding threads, 0 for one per core.
+   * @param[in] targetSize Smallest size the caller needs, see imread.
+   * @param[in] prefetchLimit Number of loaded files waiting to be decoded at
+   * which the reader thread pauses, which bounds the memory of the prefetch.
+   */
+  ImageDecodeQueue(int flags, unsigned numThreads = 0,
+                   const _Size &targetSize = _Size(),
+                   size_t prefetchLimit = 32);
+  ~ImageDecodeQueue();
+
+  /// Queues the image stored in a file.
+  void push(const String &filename);
+  /// Queues an encoded image held in memory.
+  void push(std::vector<uchar> encoded);
+
+  /**
+   * Returns the oldest image that was not popped yet, waiting until it is
+   * decoded. Rethrows the error that made its decoding fail.
+   */
+  Img<T, N> pop();
+
+  /// Number of pushed images that were not popped yet.
+  size_t size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return pending.size();
+  }
+
+  /**
+   * Decodes the images stored in `filenames` into consecutive entries of a
+   * preallocated batch, e.g. a {batch, height, width, channels} tensor. Every
+   * image must decode to the size of a batch entry. Waits for all images and
+   * rethrows the first error.
+   */
+  void decodeBatch(const std::vector<String> &filenames,
+                   MemRef<T, N + 1> &batch);
+
+private:
+  struct Task {
+    String filename;
+    std::vector<uchar> encoded;
+    // Batch entry to decode into, or null to allocate a new image.
+    std::unique_ptr<BatchEntry<T, N>> entry;
+    std::unique_ptr<Img<T, N>> image;
+    std::promise<void> done;
+  };
+
+  void enqueue(std::shared_ptr<Task> task);
+  void readLoop();
+  void decodeLoop();
+  void decode(Task &task);
+
+  int flags;
+  _Size targetSize;
+  size_t prefetchLimit;
+  // Guards the task queues and `pending`, so that any thread may push and pop.
+  mutable std::mutex mutex;
+  std::condition_variable readReady;   // reads queued or stopping
+  std::condition_variable decodeReady; // decodes queued or stopping
+  std::condition_variable decodeSpace; // prefetch below the limit
+  std::deque<std::shared_ptr<Task>> reads;
+  std::deque<std::shared_ptr<Task>> decodes;
+  bool stopping = false;
+  // Tasks to pop, in the order they were pushed.
+  std::deque<std::pair<std::shared_ptr<Task>, std::future<void>>> pending;
+  std::thread reader;
+  std::vector<std::thread> workers;
+};
+
+template <typename T, size_t N>
+ImageDecodeQueue<T, N>::ImageDecodeQueue(int flags, unsigned numThreads,
+                                         const _Size &targetSize,
+                                         size_t prefetchLimit)
+    : flags(flags), prefetchLimit(std::max<size_t>(1, prefetchLimit)) {
+  this->targetSize = targetSize;
+  if (numThreads == 0)
+    numThreads = std::max(1u, std::thread::hardware_concurrency());
+  reader = std::thread(&ImageDecodeQueue::readLoop, this);
+  for (unsigned i = 0; i < numThreads; i++)
+    workers.emplace_back(&ImageDecodeQueue::decodeLoop, this);
+}
+
+// Images that are still queued are dropped.
+template <typename T, size_t N> ImageDecodeQueue<T, N>::~ImageDecodeQueue() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  readReady.notify_all();
+  decodeReady.notify_all();
+  decodeSpace.notify_all();
+  reader.join();
+  for (std::thread &worker : workers)
+    worker.join();
+}
+
+template <typename T, size_t N>
+void ImageDecodeQueue<T, N>::push(const String &filename) {
+  std::shared_ptr<Task> task = std::make_shared<Task>();
+  task->filename = filename;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    pending.emplace_back(task, task->done.get_future());
+  }
+  enqueue(std::move(task));
+}
+
+template <typename T, size_t N>
+void ImageDecodeQueue<T, N>::push(std::vector<uchar> encoded) {
+  std::shared_ptr<Task> task = std::make_shared<Task>();
+  task->encoded = std::move(encoded);
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    pending.emplace_back(task, task->done.get_future());
+  }
+  enqueue(std::move(task));
+}
+
+template <typename T, size_t N> Img<T, N> ImageDecodeQueue<T, N>::pop() {
+  std::shared_ptr<Task> task;
+  std::future<void> done;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (pending.empty())
+      throw std::runtime_error("No image was pushed to the decode queue.");
+    task = std::move(pending.front().first);
+    done = std::move(pending.front().second);
+    pending.pop_front();
+  }
+  // Wait without the lock, the workers need it to take the next tasks.
+  done.get();
+  return std::move(*task->image);
+}
+
+template <typename T, size_t N>
+void ImageDecodeQueue<T, N>::decodeBatch(const std::vector<String> &filenames,
+                                         MemRef<T, N + 1> &batch) {
+  if ((intptr_t)filenames.size() > batch.getSizes()[0])
+    throw std::invalid_argument("More images than batch entries.");
+  std::vector<std::future<void>> done;
+  for (size_t i = 0; i < filenames.size(); i++) {
+    std::shared_ptr<Task> task = std::make_shared<Task>();
+    task->filename = filenames[i];
+    task->entry = std::make_unique<BatchEntry<T, N>>(batch, i);
+    done.push_back(task->done.get_future());
+    enqueue(std::move(task));
+  }
+  std::exception_ptr error;
+  for (std::future<void> &result : done) {
+    try {
+      result.get();
+    } catch (...) {
+      if (!error)
+        error = std::current_exception();
+    }
+  }
+  if (error)
+    std::rethrow_exception(error);
+}
+
+template <typename T, size_t N>
+void ImageDecodeQueue<T, N>::enqueue(std::shared_ptr<Task> task) {
+  bool inMemory = task->filename.empty();
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (inMemory)
+      decodes.push_back(std::move(task));
+    else
+      reads.push_back(std::move(task));
+  }
+  if (inMemory)
+    decodeReady.notify_one();
+  else
+    readReady.notify_one();
+}
+
+template <typename T, size_t N> void ImageDecodeQueue<T, N>::readLoop() {
+  for (;;) {
+    std::shared_ptr<Task> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      readReady.wait(lock, [this] { return stopping || !reads.empty(); });
+      if (stopping)
+        return;
+      task = std::move(reads.front());
+      reads.pop_front();
+    }
+    if (!readFileBytes(task->filename, task->encoded)) {
+      task->done.set_exception(std::make_exception_ptr(
+          std::runtime_error("Failed to read " + task->filename + ".")));
+      continue;
+    }
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      decodeSpace.wait(
+          lock, [this] { return stopping || decodes.size() < prefetchLimit; });
+      if (stopping)
+        return;
+      decodes.push_back(std::move(task));
+    }
+    decodeReady.notify_one();
+  }
+}
+
+template <typename T, size_t N> void ImageDecodeQueue<T, N>::decodeLoop() {
+  for (;;) {
+    std::shared_ptr<Task> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      decodeReady.wait(lock, [this] { return stopping || !decodes.empty(); });
+      if (stopping)
+        return;
+      task = std::move(decodes.front());
+      decodes.pop_front();
     }
+    decodeSpace.notify_one();
+    try {
+      decode(*task);
+      task->done.set_value();
+    } catch (...) {
+      task->done.set_exception(std::current_exception());
+    }
+  }
+}
+
+template <typename T, size_t N>
+void ImageDecodeQueue<T, N>::decode(Task &task) {
+  const uchar *data = task.encoded.data();
+  size_t size = task.encoded.size();
+  std::unique_ptr<BaseImageDecoder<T, N>> decoder =
+      findDecoder<T, N>(data, size);
+  if (!decoder)
+    throw std::runtime_error("Decoder not found for the given image.");
+  decoder->setSource(data, size);
+  intptr_t sizes[3];
+  readImageHeader(*decoder, flags, targetSize, sizes);
+  if (task.entry) {
+    const intptr_t *entrySizes = task.entry->getSizes();
+    for (size_t i = 0; i < std::min<size_t>(N, 3); i++)
+      if (entrySizes[i] != sizes[i])
+        throw std::runtime_error(
+            "The image size does not match the batch entry.");
+    decoder->readData(*task.entry);
+  } else {
+    task.image = std::make_unique<Img<T, N>>(sizes);
+    decoder->readData(*task.image);
   }
+  // Release the encoded bytes as soon as they are no longer needed.
+  std::vector<uchar>().swap(task.encoded);
 }
 
 template <typename T, size_t N>
@@ -103,6 +103,14 @@ inline uchar *FillColorRow1(uchar *data, uchar *indices, int len,
 inline uchar *FillGrayRow1(uchar *data, uchar *indices, int len,
                            uchar *palette);
 
+// Converts `count` 8-bit samples to T. The loop is kept trivial so that the
+// compiler vectorizes the widening.
+template <typename T>
+inline void convertFromU8(const uchar *src, T *dst, size_t count) {
+  for (size_t i = 0; i < count; i++)
+    dst[i] = (T)src[i];
+}
+
 #define SCALE 14
 #define cR (int)(0.299 * (1 << SCALE) + 0.5)
 #define cG (int)(0.587 * (1 << SCALE) + 0.5)
@@ -30,12 +30,114 @@ func.func @corr_2d_replicate_padding(%inputImage : memref<?x?xf32>, %kernel : me
   return
 }
 
+func.func @corr_2d_separable_constant_padding(%inputImage : memref<?x?xf32>, %kernelX : memref<?xf32>, %kernelY : memref<?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.corr_2d_separable <CONSTANT_PADDING> %inputImage, %kernelX, %kernelY, %outputImage, %centerX, %centerY, %constantValue : memref<?x?xf32>, memref<?xf32>, memref<?xf32>, memref<?x?xf32>, index, index, f32
+  return
+}
+
+func.func @corr_2d_separable_replicate_padding(%inputImage : memref<?x?xf32>, %kernelX : memref<?xf32>, %kernelY : memref<?xf32>, %outputImage : memref<?x?xf32>, %centerX : index, %centerY : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.corr_2d_separable <REPLICATE_PADDING> %inputImage, %kernelX, %kernelY, %outputImage, %centerX, %centerY, %constantValue : memref<?x?xf32>, memref<?xf32>, memref<?xf32>, memref<?x?xf32>, index, index, f32
+  return
+}
+
+func.func @integral_image(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf64>) attributes{llvm.emit_c_interface}
+{
+  dip.integral_image %inputImage, %outputImage : memref<?x?xf32>, memref<?x?xf64>
+  return
+}
+
+func.func @box_filter_constant_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %kernelWidth : index, %kernelHeight : index, %centerX : index, %centerY : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.box_filter <CONSTANT_PADDING> %inputImage, %outputImage, %kernelWidth, %kernelHeight, %centerX, %centerY, %constantValue : memref<?x?xf32>, memref<?x?xf32>, index, index, index, index, f32
+  return
+}
+
+func.func @box_filter_replicate_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %kernelWidth : index, %kernelHeight : index, %centerX : index, %centerY : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.box_filter <REPLICATE_PADDING> %inputImage, %outputImage, %kernelWidth, %kernelHeight, %centerX, %centerY, %constantValue : memref<?x?xf32>, memref<?x?xf32>, index, index, index, index, f32
+  return
+}
+
+func.func @gaussian_blur_constant_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %sigmaX : f32, %sigmaY : f32, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gaussian_blur <CONSTANT_PADDING> %inputImage, %outputImage, %sigmaX, %sigmaY, %constantValue : memref<?x?xf32>, memref<?x?xf32>, f32, f32, f32
+  return
+}
+
+func.func @gaussian_blur_replicate_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %sigmaX : f32, %sigmaY : f32, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.gaussian_blur <REPLICATE_PADDING> %inputImage, %outputImage, %sigmaX, %sigmaY, %constantValue : memref<?x?xf32>, memref<?x?xf32>, f32, f32, f32
+  return
+}
+
+func.func @median_2d_constant_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %kernelSize : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.median_2d <CONSTANT_PADDING> %inputImage, %outputImage, %kernelSize, %constantValue : memref<?x?xf32>, memref<?x?xf32>, index, f32
+  return
+}
+
+func.func @median_2d_replicate_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %kernelSize : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.median_2d <REPLICATE_PADDING> %inputImage, %outputImage, %kernelSize, %constantValue : memref<?x?xf32>, memref<?x?xf32>, index, f32
+  return
+}
+
+func.func @rank_filter_2d_constant_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %kernelSize : index, %rank : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.rank_filter_2d <CONSTANT_PADDING> %inputImage, %outputImage, %kernelSize, %rank, %constantValue : memref<?x?xf32>, memref<?x?xf32>, index, index, f32
+  return
+}
+
+func.func @rank_filter_2d_replicate_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %kernelSize : index, %rank : index, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.rank_filter_2d <REPLICATE_PADDING> %inputImage, %outputImage, %kernelSize, %rank, %constantValue : memref<?x?xf32>, memref<?x?xf32>, index, index, f32
+  return
+}
+
+func.func @pyr_down_constant_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.pyr_down <CONSTANT_PADDING> %inputImage, %outputImage, %constantValue : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @pyr_down_replicate_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.pyr_down <REPLICATE_PADDING> %inputImage, %outputImage, %constantValue : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @pyr_up_constant_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.pyr_up <CONSTANT_PADDING> %inputImage, %outputImage, %constantValue : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @pyr_up_replicate_padding(%inputImage : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.pyr_up <REPLICATE_PADDING> %inputImage, %outputImage, %constantValue : memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
 func.func @corrfft_2d(%inputImageReal : memref<?x?xf32>, %inputImageImag : memref<?x?xf32>, %kernelReal : memref<?x?xf32>, %kernelImag : memref<?x?xf32>, %intermediateReal : memref<?x?xf32>, %intermediateImag : memref<?x?xf32>) attributes{llvm.emit_c_interface}
 {
   dip.corrfft_2d %inputImageReal, %inputImageImag, %kernelReal, %kernelImag, %intermediateReal, %intermediateImag : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>
   return
 }
 
+func.func @fft_2d(%real : memref<?x?xf32>, %imag : memref<?x?xf32>, %intermediateReal : memref<?x?xf32>, %intermediateImag : memref<?x?xf32>) attributes{llvm.emit_c_interface}
+{
+  dip.fft_2d %real, %imag, %intermediateReal, %intermediateImag : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>
+  return
+}
+
+func.func @corrfft_2d_spectrum(%inputImageReal : memref<?x?xf32>, %inputImageImag : memref<?x?xf32>, %kernelSpectrumReal : memref<?x?xf32>, %kernelSpectrumImag : memref<?x?xf32>, %intermediateReal : memref<?x?xf32>, %intermediateImag : memref<?x?xf32>) attributes{llvm.emit_c_interface}
+{
+  dip.corrfft_2d_spectrum %inputImageReal, %inputImageImag, %kernelSpectrumReal, %kernelSpectrumImag, %intermediateReal, %intermediateImag : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>
+  return
+}
+
 func.func @rotate_2d(%inputImage : memref<?x?xf32>, %angle : f32, %outputImage : memref<?x?xf32>) attributes{llvm.emit_c_interface}
 {
   dip.rotate_2d %inputImage, %angle, %outputImage : memref<?x?xf32>, f32, memref<?x?xf32>
@@ -54,6 +156,60 @@ func.func @resize_2d_bilinear_interpolation(%inputImage : memref<?x?xf32>, %hori
   return
 }
 
+func.func @resize_2d_area_interpolation(%inputImage : memref<?x?xf32>, %horizontal_scaling_factor : f32, %vertical_scaling_factor : f32, %outputImage : memref<?x?xf32>) attributes{llvm.emit_c_interface}
+{
+  dip.resize_2d AREA_INTERPOLATION %inputImage, %horizontal_scaling_factor, %vertical_scaling_factor, %outputImage : memref<?x?xf32>, f32, f32, memref<?x?xf32>
+  return
+}
+
+func.func @resize_2d_bicubic_interpolation(%inputImage : memref<?x?xf32>, %horizontal_scaling_factor : f32, %vertical_scaling_factor : f32, %outputImage : memref<?x?xf32>) attributes{llvm.emit_c_interface}
+{
+  dip.resize_2d BICUBIC_INTERPOLATION %inputImage, %horizontal_scaling_factor, %vertical_scaling_factor, %outputImage : memref<?x?xf32>, f32, f32, memref<?x?xf32>
+  return
+}
+
+func.func @warp_affine_2d_constant_padding(%inputImage : memref<?x?xf32>, %matrix : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.warp_affine_2d <CONSTANT_PADDING> %inputImage, %matrix, %outputImage, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @warp_affine_2d_replicate_padding(%inputImage : memref<?x?xf32>, %matrix : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.warp_affine_2d <REPLICATE_PADDING> %inputImage, %matrix, %outputImage, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @warp_perspective_2d_constant_padding(%inputImage : memref<?x?xf32>, %matrix : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.warp_perspective_2d <CONSTANT_PADDING> %inputImage, %matrix, %outputImage, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @warp_perspective_2d_replicate_padding(%inputImage : memref<?x?xf32>, %matrix : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.warp_perspective_2d <REPLICATE_PADDING> %inputImage, %matrix, %outputImage, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @warp_map_2d(%matrix : memref<?x?xf32>, %map : memref<?x?x?xi32>) attributes{llvm.emit_c_interface}
+{
+  dip.warp_map_2d %matrix, %map : memref<?x?xf32>, memref<?x?x?xi32>
+  return
+}
+
+func.func @remap_2d_constant_padding(%inputImage : memref<?x?xf32>, %map : memref<?x?x?xi32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.remap_2d <CONSTANT_PADDING> %inputImage, %map, %outputImage, %constantValue : memref<?x?xf32>, memref<?x?x?xi32>, memref<?x?xf32>, f32
+  return
+}
+
+func.func @remap_2d_replicate_padding(%inputImage : memref<?x?xf32>, %map : memref<?x?x?xi32>, %outputImage : memref<?x?xf32>, %constantValue : f32) attributes{llvm.emit_c_interface}
+{
+  dip.remap_2d <REPLICATE_PADDING> %inputImage, %map, %outputImage, %constantValue : memref<?x?xf32>, memref<?x?x?xi32>, memref<?x?xf32>, f32
+  return
+}
+
 func.func @erosion_2d_constant_padding(%inputImage : memref<?x?xf32>, %kernel : memref<?x?xf32>, %outputImage : memref<?x?xf32>, %copymemref : memref<?x?xf32>, %centerX : index, %centerY : index, %iterations : index, %constantValue: f32) attributes{llvm.emit_c_interface}
 {
   dip.erosion_2d <CONSTANT_PADDING> %inputImage, %kernel, %outputImage, %copymemref, %centerX, %centerY, %iterations, %constantValue: memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
@@ -137,3 +293,476 @@ func.func @morphgrad_2d_replicate_padding(%inputImage : memref<?x?xf32>, %kernel
   dip.morphgrad_2d <REPLICATE_PADDING> %inputImage, %kernel, %outputImage, %outputImage1,%outputImage2, %inputImage1, %copymemref, %copymemref1, %centerX, %centerY, %iterations, %constantValue : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, index, index, index, f32
   return
 }
+
+// Variants of the operations for 8-bit and 16-bit images, single channel or
+// interleaved HxWxC. Pixels are unsigned and kernels are signed.
+
+func.func @resize_2d_nearest_neighbour_interpolation_u8(%inputImage : memref<?x?xi8>, %horizontal_scaling_factor : f32, %vertical_scaling_factor : f32, %outputImage : memref<?x?xi8>) attributes{llvm.emit_c_interface}
+{
+  dip.resize_2d NEAREST_NEIGHBOUR_INTERPOLATION %inputImage, %horizontal_scaling_factor, %vertical_scaling_factor, %outputImage : memref<?x?xi8>, f32, f32, memref<?x?xi8>
+  return
+}
+
+func.func @resize_2d_bilinear_interpolation_u8(%inputImage : memref<?x?xi8>, %horizontal_scaling_factor : f32, %vertical_scaling_factor : f32, %outputImage : memref<?x?xi8>) attributes{llvm.emit_c_interface}
+{
+  dip.resize_2d BILINEAR_INTERPOLATION %inputImage, %horizontal_scaling_factor, %vertical_scaling_factor, %outputImage : memref<?x?xi8>, f32, f32, memref<?x?xi8>
+  return
+}
+
+func.func @resize_2d_area_interpolation_u8(%inputImage : memref<?x?xi8>, %horizontal_scaling_factor : f32, %vertical_scaling_factor : f32, %outputImage : memref<?x?xi8>) attributes{llvm.emit_c_interface}
+{
+  dip.resize_2d AREA_INTERPOLATION %inputImage, %horizontal_scaling_factor, %vertical_scaling_factor, %outputImage : memref<?x?xi8>, f32, f32, memref<?x?xi8>
+  return
+}
+
+func.func @resize_2d_bicubic_interpolation_u8(%inputImage : memref<?x?xi8>, %horizontal_scaling_factor : f32, %vertical_scaling_factor : f32, %outputImage : memref<?x?xi8>) attributes{llvm.emit_c_interface}
+{
+  dip.resize_2d BICUBIC_INTERPOLATION %inputImage, %horizontal_scaling_factor, %vertical_scaling_factor, %outputImage : memref<?x?xi8>, f32, f32, memref<?x?xi8>
+  return
+}
+
+func.func @corr_2d_separable_constant_padding_u8(%inputImage : memref<?x?xi8>, %kernelX : memref<?xi8>, %kernelY : memref<?xi8>, %outputImage : memref<?x?xi8>, %centerX : index, %centerY : index, %constantValue : i8) attributes{llvm.emit_c_interface}
+{
+  dip.corr_2d_separable <CONSTANT_PADDING> %inputImage, %kernelX, %kernelY, %outputImage, %centerX, %centerY, %constantValue : memref<?x?xi8>, memref<?xi8>, memref<?xi8>, memref<?x?xi8>, index, index, i8
+  return
+}
+
+func.func @corr_2d_separable_replicate_padding_u8(%inputImage : memref<?x?xi8>, %kernelX : memref<?xi8>, %kernelY : memref<?xi8>, %outputImage : memref<?x?xi8>, %centerX : index, %centerY : index, %constantValue : i8) attributes{llvm.emit_c_interface}
+{
+  dip.corr_2d_separable <REPLICATE_PADDING> %inputImage, %kernelX, %kernelY, %outputImage, %centerX, %centerY, %constantValue : memref<?x?xi8>, memref<?xi8>, memref<?xi8>, memref<?x?xi8>, index, index, i8
+  return
+}
+
+func.func @remap_2d_constant_padding_u8(%inputImage : memref<?x?xi8>, %map : memref<?x?x?xi32>, %outputImage : memref<?x?xi8>, %constantValue : i8) attributes{llvm.emit_c_interface}
+{
+  dip.remap_2d <CONSTANT_PADDING> %inputImage, %map, %outputImage, %constantValue : memref<?x?xi8>, memref<?x?x?xi32>, memref<?x?xi8>, i8
+  return
+}
+
+func.func @remap_2d_replicate_padding_u8(%inputImage : memref<?x?xi8>, %map : memref<?x?x?xi32>, %outputImage : memref<?x?xi8>, %constantValue : i8) attributes{llvm.emit_c_interface}
+{
+  dip.remap_2d <REPLICATE_PADDING> %inputImage, %map, %outputImage, %constantValue : memref<?x?xi8>, memref<?x?x?xi32>, memref<?x?xi8>, i8
+  return
+}
+
+func.func @warp_affine_2d_constant_padding_u8(%inputImage : memref<?x?xi8>, %matrix : memref<?x?xf32>, %outputImage : memref<?x?xi8>, %constantValue : i8) attributes{llvm.emit_c_interface}
+{
+  dip.warp_affine_2d <CONSTANT_PADDING> %inputImage, %matrix, %outputImage, %constantValue : memref<?x?xi8>, memref<?x?xf32>, memref<?x?xi8>, i8
+  return
+}
+
+func.func @warp_affine_2d_replicate_padding_u8(%inputImage : memref<?x?xi8>, %matrix : memref<?x?xf32>, %outputImage : memref<?x?xi8>, %constantValue : i8) attributes{llvm.emit_c_interface}
+{
+  dip.warp_affine_2d <REPLICATE_PADDING> %inputImage, %matrix, %outputImage, %constantValue : memref<?x?xi8>, memref<?x?xf32>, memref<?x?xi8>, i8
+  return
+}
+
+func.func @warp_perspective_2d_constant_padding_u8(%inputImage : memref<?x?xi8>, %matrix : memref<?x?xf32>, %outputImage : memref<?x?xi8>, %constantValue : i8) attributes{llvm.emit_c_interface}
+{
+  dip.warp_perspective_2d <CONSTANT_PADDING> %inputImage, %matrix, %outputImage, %constantValue : memref<?x?xi8>, memref<?x?xf32>, memref<?x?xi8>, i8
+  return
+}
+
+func.func @warp_perspective_2d_replicate_padding_u8(%inputImage : memref<?x?xi8>, %matrix : memref<?x?xf32>, %outputImage : memref<?x?xi8>, %constantValue : i8) attributes{llvm.emit_c_interface}
+{
+  dip.warp_perspective_2d <REPLICATE_PADDING> %inputImage, %matrix, %outputImage, %constantValue : memref<?x?xi8>, memref<?x?xf32>, memref<?x?xi8>, i8
+  return
+}
+
+func.func @integral_image_u8(%inputImage : memref<?x?xi8>, %outputImage : memref<?x?xi32>) attributes{llvm.emit_c_interface}
+{
+  dip.integral_image %inputImage, %outputImage : memref<?x?xi8>, memref<?x?xi32>
+  return
+}
+
+func.func @box_filter_constant_padding_u8(%inputImage : memref<?x?xi8>, %outputImage : memref<?x?xi8>, %kernelWidth : index, %kernelHeight : index, %centerX : index, %centerY : index, %constantValue : i8) attributes{llvm.emit_c_interface}
+{
+  dip.box_filter <CONSTANT_PADDING> %inputImage, %outputImage, %kernelWidth, %kernelHeight, %centerX, %centerY, %constantValue : memref<?x?xi8>, memref<?x?xi8>, index, index, index, index, i8
+  return
+}
+
+func.func @box_filter_replicate_padding_u8(%inputImage : memref<?x?xi8>, %outputImage : memref<?x?xi8>, %kernelWidth : index, %kernelHeight : index, %centerX : index, %centerY : index, %constantValue : i8) attributes{llvm.emit_c_interface}
+{
+  dip.box_filter <REPLICATE_PADDING> %inputImage, %outputImage, %kernelWidth, %kernelHeight, %centerX, %centerY, %constantValue : memref<?x?xi8>, memref<?x?xi8>, index, index, index, index, i8
+  return
+}
+
+func.func @gaussian_blur_constant_padding_u8(%inputImage : memref<?x?xi8>, %outputImage : memref<?x?xi8>, %sigmaX : f32, %sigmaY : f32, %constantValue : i8) attributes{llvm.emit_c_interface}
+{
+  dip.gaussian_blur <CONSTANT_PADDING> %inputImage, %outputImage, %sigmaX, %sigmaY, %constantValue : memref<?x?xi8>, memref<?x?xi8>, f32, f32, i8
+  return
+}
+
+func.func @gaussian_blur_replicate_padding_u8(%inputImage : memref<?x?xi8>, %outputImage : memref<?x?xi8>, %sigmaX : f32, %sigmaY : f32, %constantValue : i8) attributes{llvm.emit_c_interface}
+{
+  dip.gaussian_blur <REPLICATE_PADDING> %inputImage, %outputImage, %sigmaX, %sigmaY, %constantValue : memref<?x?xi8>, memref<?x?xi8>, f32, f32, i8
+  return
+}
+
+func.func @median_2d_constant_padding_u8(%inputImage : memref<?x?xi8>, %outputImage : memref<?x?xi8>, %kernelSize : index, %constantValue : i8) attributes{llvm.emit_c_interface}
+{
+  dip.median_2d <CONSTANT_PADDING> %inputImage, %outputImage, %kernelSize, %constantValue : memref<?x?xi8>, memref<?x?xi8>, index, i8
+  return
+}
+
+func.func @median_2d_replicate_padding_u8(%inputImage : memref<?x?xi8>, %outputImage : memref<?x?xi8>, %kernelSize : index, %constantValue : i8) attributes{llvm.emit_c_interface}
+{
+  dip.median_2d <REPLICATE_PADDING> %inputImage, %outputImage, %kernelSize, %constantValue : memref<?x?xi8>, memref<?x?xi8>, index, i8
+  return
+}
+
+func.func @rank_filter_2d_constant_padding_u8(%inputImage : memref<?x?xi8>, %outputImage : memref<?x?xi8>, %kernelSize : index, %rank : index, %constantValue : i8) attributes{llvm.emit_c_interface}
+{
+  dip.rank_filter_2d <CONSTANT_PADDING> %inputImage, %outputImage, %kernelSize, %rank, %constantValue : memref<?x?xi8>, memref<?x?xi8>, index, index, i8
+  return
+}
+
+func.func @rank_filter_2d_replicate_padding_u8(%inputImage : memref<?x?xi8>, %outputImage : memref<?x?xi8>, %kernelSize : index, %rank : index, %constantValue : i8) attributes{llvm.emit_c_interface}
+{
+  dip.rank_filter_2d <REPLICATE_PADDING> %inputImage, %outputImage, %kernelSize, %rank, %constantValue : memref<?x?xi8>, memref<?x?xi8>, index, index, i8
+  return
+}
+
+func.func @pyr_down_constant_padding_u8(%inputImage : memref<?x?xi8>, %outputImage : memref<?x?xi8>, %constantValue : i8) attributes{llvm.emit_c_interface}
+{
+  dip.pyr_down <CONSTANT_PADDING> %inputImage, %outputImage, %constantValue : memref<?x?xi8>, memref<?x?xi8>, i8
+  return
+}
+
+func.func @pyr_down_replicate_padding_u8(%inputImage : memref<?x?xi8>, %outputImage : memref<?x?xi8>, %constantValue : i8) attributes{llvm.emit_c_interface}
+{
+  dip.pyr_down <REPLICATE_PADDING> %inputImage, %outputImage, %constantValue : memref<?x?xi8>, memref<?x?xi8>, i8
+  return
+}
+
+func.func @pyr_up_constant_padding_u8(%inputImage : memref<?x?xi8>, %outputImage : memref<?x?xi8>, %constantValue : i8) attributes{llvm.emit_c_interface}
+{
+  dip.pyr_up <CONSTANT_PADDING> %inputImage, %outputImage, %constantValue : memref<?x?xi8>, memref<?x?xi8>, i8
+  return
+}
+
+func.func @pyr_up_replicate_padding_u8(%inputImage : memref<?x?xi8>, %outputImage : memref<?x?xi8>, %constantValue : i8) attributes{llvm.emit_c_interface}
+{
+  dip.pyr_up <REPLICATE_PADDING> %inputImage, %outputImage, %constantValue : memref<?x?xi8>, memref<?x?xi8>, i8
+  return
+}
+
+func.func @histogram_u8(%inputImage : memref<?x?xi8>, %hist : memref<?xi32>) attributes{llvm.emit_c_interface}
+{
+  dip.histogram %inputImage, %hist : memref<?x?xi8>, memref<?xi32>
+  return
+}
+
+func.func @equalize_hist_u8(%inputImage : memref<?x?xi8>, %outputImage : memref<?x?xi8>) attributes{llvm.emit_c_interface}
+{
+  dip.equalize_hist %inputImage, %outputImage : memref<?x?xi8>, memref<?x?xi8>
+  return
+}
+
+func.func @apply_lut_u8(%inputImage : memref<?x?xi8>, %lut : memref<?xi8>, %outputImage : memref<?x?xi8>) attributes{llvm.emit_c_interface}
+{
+  dip.apply_lut %inputImage, %lut, %outputImage : memref<?x?xi8>, memref<?xi8>, memref<?x?xi8>
+  return
+}
+
+func.func @apply_lut_u8_hwc(%inputImage : memref<?x?x?xi8>, %lut : memref<?xi8>, %outputImage : memref<?x?x?xi8>) attributes{llvm.emit_c_interface}
+{
+  dip.apply_lut %inputImage, %lut, %outputImage : memref<?x?x?xi8>, memref<?xi8>, memref<?x?x?xi8>
+  return
+}
+
+func.func @apply_lut_u8_f32(%inputImage : memref<?x?xi8>, %lut : memref<?xf32>, %outputImage : memref<?x?xf32>) attributes{llvm.emit_c_interface}
+{
+  dip.apply_lut %inputImage, %lut, %outputImage : memref<?x?xi8>, memref<?xf32>, memref<?x?xf32>
+  return
+}
+
+func.func @resize_2d_nearest_neighbour_interpolation_u16(%inputImage : memref<?x?xi16>, %horizontal_scaling_factor : f32, %vertical_scaling_factor : f32, %outputImage : memref<?x?xi16>) attributes{llvm.emit_c_interface}
+{
+  dip.resize_2d NEAREST_NEIGHBOUR_INTERPOLATION %inputImage, %horizontal_scaling_factor, %vertical_scaling_factor, %outputImage : memref<?x?xi16>, f32, f32, memref<?x?xi16>
+  return
+}
+
+func.func @resize_2d_bilinear_interpolation_u16(%inputImage : memref<?x?xi16>, %horizontal_scaling_factor : f32, %vertical_scaling_factor : f32, %outputImage : memref<?x?xi16>) attributes{llvm.emit_c_interface}
+{
+  dip.resize_2d BILINEAR_INTERPOLATION %inputImage, %horizontal_scaling_factor, %vertical_scaling_factor, %outputImage : memref<?x?xi16>, f32, f32, memref<?x?xi16>
+  return
+}
+
+func.func @resize_2d_area_interpolation_u16(%inputImage : memref<?x?xi16>, %horizontal_scaling_factor : f32, %vertical_scaling_factor : f32, %outputImage : memref<?x?xi16>) attributes{llvm.emit_c_interface}
+{
+  dip.resize_2d AREA_INTERPOLATION %inputImage, %horizontal_scaling_factor, %vertical_scaling_factor, %outputImage : memref<?x?xi16>, f32, f32, memref<?x?xi16>
+  return
+}
+
+func.func @resize_2d_bicubic_interpolation_u16(%inputImage : memref<?x?xi16>, %horizontal_scaling_factor : f32, %vertical_scaling_factor : f32, %outputImage : memref<?x?xi16>) attributes{llvm.emit_c_interface}
+{
+  dip.resize_2d BICUBIC_INTERPOLATION %inputImage, %horizontal_scaling_factor, %vertical_scaling_factor, %outputImage : memref<?x?xi16>, f32, f32, memref<?x?xi16>
+  return
+}
+
+func.func @corr_2d_separable_constant_padding_u16(%inputImage : memref<?x?xi16>, %kernelX : memref<?xi16>, %kernelY : memref<?xi16>, %outputImage : memref<?x?xi16>, %centerX : index, %centerY : index, %constantValue : i16) attributes{llvm.emit_c_interface}
+{
+  dip.corr_2d_separable <CONSTANT_PADDING> %inputImage, %kernelX, %kernelY, %outputImage, %centerX, %centerY, %constantValue : memref<?x?xi16>, memref<?xi16>, memref<?xi16>, memref<?x?xi16>, index, index, i16
+  return
+}
+
+func.func @corr_2d_separable_replicate_padding_u16(%inputImage : memref<?x?xi16>, %kernelX : memref<?xi16>, %kernelY : memref<?xi16>, %outputImage : memref<?x?xi16>, %centerX : index, %centerY : index, %constantValue : i16) attributes{llvm.emit_c_interface}
+{
+  dip.corr_2d_separable <REPLICATE_PADDING> %inputImage, %kernelX, %kernelY, %outputImage, %centerX, %centerY, %constantValue : memref<?x?xi16>, memref<?xi16>, memref<?xi16>, memref<?x?xi16>, index, index, i16
+  return
+}
+
+func.func @remap_2d_constant_padding_u16(%inputImage : memref<?x?xi16>, %map : memref<?x?x?xi32>, %outputImage : memref<?x?xi16>, %constantValue : i16) attributes{llvm.emit_c_interface}
+{
+  dip.remap_2d <CONSTANT_PADDING> %inputImage, %map, %outputImage, %constantValue : memref<?x?xi16>, memref<?x?x?xi32>, memref<?x?xi16>, i16
+  return
+}
+
+func.func @remap_2d_replicate_padding_u16(%inputImage : memref<?x?xi16>, %map : memref<?x?x?xi32>, %outputImage : memref<?x?xi16>, %constantValue : i16) attributes{llvm.emit_c_interface}
+{
+  dip.remap_2d <REPLICATE_PADDING> %inputImage, %map, %outputImage, %constantValue : memref<?x?xi16>, memref<?x?x?xi32>, memref<?x?xi16>, i16
+  return
+}
+
+func.func @warp_affine_2d_constant_padding_u16(%inputImage : memref<?x?xi16>, %matrix : memref<?x?xf32>, %outputImage : memref<?x?xi16>, %constantValue : i16) attributes{llvm.emit_c_interface}
+{
+  dip.warp_affine_2d <CONSTANT_PADDING> %inputImage, %matrix, %outputImage, %constantValue : memref<?x?xi16>, memref<?x?xf32>, memref<?x?xi16>, i16
+  return
+}
+
+func.func @warp_affine_2d_replicate_padding_u16(%inputImage : memref<?x?xi16>, %matrix : memref<?x?xf32>, %outputImage : memref<?x?xi16>, %constantValue : i16) attributes{llvm.emit_c_interface}
+{
+  dip.warp_affine_2d <REPLICATE_PADDING> %inputImage, %matrix, %outputImage, %constantValue : memref<?x?xi16>, memref<?x?xf32>, memref<?x?xi16>, i16
+  return
+}
+
+func.func @warp_perspective_2d_constant_padding_u16(%inputImage : memref<?x?xi16>, %matrix : memref<?x?xf32>, %outputImage : memref<?x?xi16>, %constantValue : i16) attributes{llvm.emit_c_interface}
+{
+  dip.warp_perspective_2d <CONSTANT_PADDING> %inputImage, %matrix, %outputImage, %constantValue : memref<?x?xi16>, memref<?x?xf32>, memref<?x?xi16>, i16
+  return
+}
+
+func.func @warp_perspective_2d_replicate_padding_u16(%inputImage : memref<?x?xi16>, %matrix : memref<?x?xf32>, %outputImage : memref<?x?xi16>, %constantValue : i16) attributes{llvm.emit_c_interface}
+{
+  dip.warp_perspective_2d <REPLICATE_PADDING> %inputImage, %matrix, %outputImage, %constantValue : memref<?x?xi16>, memref<?x?xf32>, memref<?x?xi16>, i16
+  return
+}
+
+func.func @resize_2d_nearest_neighbour_interpolation_u8_hwc(%inputImage : memref<?x?x?xi8>, %horizontal_scaling_factor : f32, %vertical_scaling_factor : f32, %outputImage : memref<?x?x?xi8>) attributes{llvm.emit_c_interface}
+{
+  dip.resize_2d NEAREST_NEIGHBOUR_INTERPOLATION %inputImage, %horizontal_scaling_factor, %vertical_scaling_factor, %outputImage : memref<?x?x?xi8>, f32, f32, memref<?x?x?xi8>
+  return
+}
+
+func.func @resize_2d_bilinear_interpolation_u8_hwc(%inputImage : memref<?x?x?xi8>, %horizontal_scaling_factor : f32, %vertical_scaling_factor : f32, %outputImage : memref<?x?x?xi8>) attributes{llvm.emit_c_interface}
+{
+  dip.resize_2d BILINEAR_INTERPOLATION %inputImage, %horizontal_scaling_factor, %vertical_scaling_factor, %outputImage : memref<?x?x?xi8>, f32, f32, memref<?x?x?xi8>
+  return
+}
+
+func.func @resize_2d_area_interpolation_u8_hwc(%inputImage : memref<?x?x?xi8>, %horizontal_scaling_factor : f32, %vertical_scaling_factor : f32, %outputImage : memref<?x?x?xi8>) attributes{llvm.emit_c_interface}
+{
+  dip.resize_2d AREA_INTERPOLATION %inputImage, %horizontal_scaling_factor, %vertical_scaling_factor, %outputImage : memref<?x?x?xi8>, f32, f32, memref<?x?x?xi8>
+  return
+}
+
+func.func @resize_2d_bicubic_interpolation_u8_hwc(%inputImage : memref<?x?x?xi8>, %horizontal_scaling_factor : f32, %vertical_scaling_factor : f32, %outputImage : memref<?x?x?xi8>) attributes{llvm.emit_c_interface}
+{
+  dip.resize_2d BICUBIC_INTERPOLATION %inputImage, %horizontal_scaling_factor, %vertical_scaling_factor, %outputImage : memref<?x?x?xi8>, f32, f32, memref<?x?x?xi8>
+  return
+}
+
+func.func @corr_2d_separable_constant_padding_u8_hwc(%inputImage : memref<?x?x?xi8>, %kernelX : memref<?xi8>, %kernelY : memref<?xi8>, %outputImage : memref<?x?x?xi8>, %centerX : index, %centerY : index, %constantValue : i8) attributes{llvm.emit_c_interface}
+{
+  dip.corr_2d_separable <CONSTANT_PADDING> %inputImage, %kernelX, %kernelY, %outputImage, %centerX, %centerY, %constantValue : memref<?x?x?xi8>, memref<?xi8>, memref<?xi8>, memref<?x?x?xi8>, index, index, i8
+  return
+}
+
+func.func @corr_2d_separable_replicate_padding_u8_hwc(%inputImage : memref<?x?x?xi8>, %kernelX : memref<?xi8>, %kernelY : memref<?xi8>, %outputImage : memref<?x?x?xi8>, %centerX : index, %centerY : index, %constantValue : i8) attributes{llvm.emit_c_interface}
+{
+  dip.corr_2d_separable <REPLICATE_PADDING> %inputImage, %kernelX, %kernelY, %outputImage, %centerX, %centerY, %constantValue : memref<?x?x?xi8>, memref<?xi8>, memref<?xi8>, memref<?x?x?xi8>, index, index, i8
+  return
+}
+
+func.func @remap_2d_constant_padding_u8_hwc(%inputImage : memref<?x?x?xi8>, %map : memref<?x?x?xi32>, %outputImage : memref<?x?x?xi8>, %constantValue : i8) attributes{llvm.emit_c_interface}
+{
+  dip.remap_2d <CONSTANT_PADDING> %inputImage, %map, %outputImage, %constantValue : memref<?x?x?xi8>, memref<?x?x?xi32>, memref<?x?x?xi8>, i8
+  return
+}
+
+func.func @remap_2d_replicate_padding_u8_hwc(%inputImage : memref<?x?x?xi8>, %map : memref<?x?x?xi32>, %outputImage : memref<?x?x?xi8>, %constantValue : i8) attributes{llvm.emit_c_interface}
+{
+  dip.remap_2d <REPLICATE_PADDING> %inputImage, %map, %outputImage, %constantValue : memref<?x?x?xi8>, memref<?x?x?xi32>, memref<?x?x?xi8>, i8
+  return
+}
+
+func.func @warp_affine_2d_constant_padding_u8_hwc(%inputImage : memref<?x?x?xi8>, %matrix : memref<?x?xf32>, %outputImage : memref<?x?x?xi8>, %constantValue : i8) attributes{llvm.emit_c_interface}
+{
+  dip.warp_affine_2d <CONSTANT_PADDING> %inputImage, %matrix, %outputImage, %constantValue : memref<?x?x?xi8>, memref<?x?xf32>, memref<?x?x?xi8>, i8
+  return
+}
+
+func.func @warp_affine_2d_replicate_padding_u8_hwc(%inputImage : memref<?x?x?xi8>, %matrix : memref<?x?xf32>, %outputImage : memref<?x?x?xi8>, %constantValue : i8) attributes{llvm.emit_c_interface}
+{
+  dip.warp_affine_2d <REPLICATE_PADDING> %inputImage, %matrix, %outputImage, %constantValue : memref<?x?x?xi8>, memref<?x?xf32>, memref<?x?x?xi8>, i8
+  return
+}
+
+func.func @warp_perspective_2d_constant_padding_u8_hwc(%inputImage : memref<?x?x?xi8>, %matrix : memref<?x?xf32>, %outputImage : memref<?x?x?xi8>, %constantValue : i8) attributes{llvm.emit_c_interface}
+{
+  dip.warp_perspective_2d <CONSTANT_PADDING> %inputImage, %matrix, %outputImage, %constantValue : memref<?x?x?xi8>, memref<?x?xf32>, memref<?x?x?xi8>, i8
+  return
+}
+
+func.func @warp_perspective_2d_replicate_padding_u8_hwc(%inputImage : memref<?x?x?xi8>, %matrix : memref<?x?xf32>, %outputImage : memref<?x?x?xi8>, %constantValue : i8) attributes{llvm.emit_c_interface}
+{
+  dip.warp_perspective_2d <REPLICATE_PADDING> %inputImage, %matrix, %outputImage, %constantValue : memref<?x?x?xi8>, memref<?x?xf32>, memref<?x?x?xi8>, i8
+  return
+}
+
+func.func @resize_2d_nearest_neighbour_interpolation_u16_hwc(%inputImage : memref<?x?x?xi16>, %horizontal_scaling_factor : f32, %vertical_scaling_factor : f32, %outputImage : memref<?x?x?xi16>) attributes{llvm.emit_c_interface}
+{
+  dip.resize_2d NEAREST_NEIGHBOUR_INTERPOLATION %inputImage, %horizontal_scaling_factor, %vertical_scaling_factor, %outputImage : memref<?x?x?xi16>, f32, f32, memref<?x?x?xi16>
+  return
+}
+
+func.func @resize_2d_bilinear_interpolation_u16_hwc(%inputImage : memref<?x?x?xi16>, %horizontal_scaling_factor : f32, %vertical_scaling_factor : f32, %outputImage : memref<?x?x?xi16>) attributes{llvm.emit_c_interface}
+{
+  dip.resize_2d BILINEAR_INTERPOLATION %inputImage, %horizontal_scaling_factor, %vertical_scaling_factor, %outputImage : memref<?x?x?xi16>, f32, f32, memref<?x?x?xi16>
+  return
+}
+
+func.func @resize_2d_area_interpolation_u16_hwc(%inputImage : memref<?x?x?xi16>, %horizontal_scaling_factor : f32, %vertical_scaling_factor : f32, %outputImage : memref<?x?x?xi16>) attributes{llvm.emit_c_interface}
+{
+  dip.resize_2d AREA_INTERPOLATION %inputImage, %horizontal_scaling_factor, %vertical_scaling_factor, %outputImage : memref<?x?x?xi16>, f32, f32, memref<?x?x?xi16>
+  return
+}
+
+func.func @resize_2d_bicubic_interpolation_u16_hwc(%inputImage : memref<?x?x?xi16>, %horizontal_scaling_factor : f32, %vertical_scaling_factor : f32, %outputImage : memref<?x?x?xi16>) attributes{llvm.emit_c_interface}
+{
+  dip.resize_2d BICUBIC_INTERPOLATION %inputImage, %horizontal_scaling_factor, %vertical_scaling_factor, %outputImage : memref<?x?x?xi16>, f32, f32, memref<?x?x?xi16>
+  return
+}
+
+func.func @corr_2d_separable_constant_padding_u16_hwc(%inputImage : memref<?x?x?xi16>, %kernelX : memref<?xi16>, %kernelY : memref<?xi16>, %outputImage : memref<?x?x?xi16>, %centerX : index, %centerY : index, %constantValue : i16) attributes{llvm.emit_c_interface}
+{
+  dip.corr_2d_separable <CONSTANT_PADDING> %inputImage, %kernelX, %kernelY, %outputImage, %centerX, %centerY, %constantValue : memref<?x?x?xi16>, memref<?xi16>, memref<?xi16>, memref<?x?x?xi16>, index, index, i16
+  return
+}
+
+func.func @corr_2d_separable_replicate_padding_u16_hwc(%inputImage : memref<?x?x?xi16>, %kernelX : memref<?xi16>, %kernelY : memref<?xi16>, %outputImage : memref<?x?x?xi16>, %centerX : index, %centerY : index, %constantValue : i16) attributes{llvm.emit_c_interface}
+{
+  dip.corr_2d_separable <REPLICATE_PADDING> %inputImage, %kernelX, %kernelY, %outputImage, %centerX, %centerY, %constantValue : memref<?x?x?xi16>, memref<?xi16>, memref<?xi16>, memref<?x?x?xi16>, index, index, i16
+  return
+}
+
+func.func @remap_2d_constant_padding_u16_hwc(%inputImage : memref<?x?x?xi16>, %map : memref<?x?x?xi32>, %outputImage : memref<?x?x?xi16>, %constantValue : i16) attributes{llvm.emit_c_interface}
+{
+  dip.remap_2d <CONSTANT_PADDING> %inputImage, %map, %outputImage, %constantValue : memref<?x?x?xi16>, memref<?x?x?xi32>, memref<?x?x?xi16>, i16
+  return
+}
+
+func.func @remap_2d_replicate_padding_u16_hwc(%inputImage : memref<?x?x?xi16>, %map : memref<?x?x?xi32>, %outputImage : memref<?x?x?xi16>, %constantValue : i16) attributes{llvm.emit_c_interface}
+{
+  dip.remap_2d <REPLICATE_PADDING> %inputImage, %map, %outputImage, %constantValue : memref<?x?x?xi16>, memref<?x?x?xi32>, memref<?x?x?xi16>, i16
+  return
+}
+
+func.func @warp_affine_2d_constant_padding_u16_hwc(%inputImage : memref<?x?x?xi16>, %matrix : memref<?x?xf32>, %outputImage : memref<?x?x?xi16>, %constantValue : i16) attributes{llvm.emit_c_interface}
+{
+  dip.warp_affine_2d <CONSTANT_PADDING> %inputImage, %matrix, %outputImage, %constantValue : memref<?x?x?xi16>, memref<?x?xf32>, memref<?x?x?xi16>, i16
+  return
+}
+
+func.func @warp_affine_2d_replicate_padding_u16_hwc(%inputImage : memref<?x?x?xi16>, %matrix : memref<?x?xf32>, %outputImage : memref<?x?x?xi16>, %constantValue : i16) attributes{llvm.emit_c_interface}
+{
+  dip.warp_affine_2d <REPLICATE_PADDING> %inputImage, %matrix, %outputImage, %constantValue : memref<?x?x?xi16>, memref<?x?xf32>, memref<?x?x?xi16>, i16
+  return
+}
+
+func.func @warp_perspective_2d_constant_padding_u16_hwc(%inputImage : memref<?x?x?xi16>, %matrix : memref<?x?xf32>, %outputImage : memref<?x?x?xi16>, %constantValue : i16) attributes{llvm.emit_c_interface}
+{
+  dip.warp_perspective_2d <CONSTANT_PADDING> %inputImage, %matrix, %outputImage, %constantValue : memref<?x?x?xi16>, memref<?x?xf32>, memref<?x?x?xi16>, i16
+  return
+}
+
+func.func @warp_perspective_2d_replicate_padding_u16_hwc(%inputImage : memref<?x?x?xi16>, %matrix : memref<?x?xf32>, %outputImage : memref<?x?x?xi16>, %constantValue : i16) attributes{llvm.emit_c_interface}
+{
+  dip.warp_perspective_2d <REPLICATE_PADDING> %inputImage, %matrix, %outputImage, %constantValue : memref<?x?x?xi16>, memref<?x?xf32>, memref<?x?x?xi16>, i16
+  return
+}
+
+// Conversion of decoded 8-bit images into the f32 input tensors of DNNs.
+
+func.func @image_to_tensor_nchw_nearest_neighbour_u8(%inputImage : memref<?x?xi8>, %outputTensor : memref<?x?x?x?xf32>, %batch : index, %scale : f32, %mean : memref<?xf32>, %std : memref<?xf32>) attributes{llvm.emit_c_interface}
+{
+  dip.image_to_tensor <NCHW> NEAREST_NEIGHBOUR_INTERPOLATION %inputImage, %outputTensor, %batch, %scale, %mean, %std : memref<?x?xi8>, memref<?x?x?x?xf32>, index, f32, memref<?xf32>, memref<?xf32>
+  return
+}
+
+func.func @image_to_tensor_nchw_bilinear_u8(%inputImage : memref<?x?xi8>, %outputTensor : memref<?x?x?x?xf32>, %batch : index, %scale : f32, %mean : memref<?xf32>, %std : memref<?xf32>) attributes{llvm.emit_c_interface}
+{
+  dip.image_to_tensor <NCHW> BILINEAR_INTERPOLATION %inputImage, %outputTensor, %batch, %scale, %mean, %std : memref<?x?xi8>, memref<?x?x?x?xf32>, index, f32, memref<?xf32>, memref<?xf32>
+  return
+}
+
+func.func @image_to_tensor_nhwc_nearest_neighbour_u8(%inputImage : memref<?x?xi8>, %outputTensor : memref<?x?x?x?xf32>, %batch : index, %scale : f32, %mean : memref<?xf32>, %std : memref<?xf32>) attributes{llvm.emit_c_interface}
+{
+  dip.image_to_tensor <NHWC> NEAREST_NEIGHBOUR_INTERPOLATION %inputImage, %outputTensor, %batch, %scale, %mean, %std : memref<?x?xi8>, memref<?x?x?x?xf32>, index, f32, memref<?xf32>, memref<?xf32>
+  return
+}
+
+func.func @image_to_tensor_nhwc_bilinear_u8(%inputImage : memref<?x?xi8>, %outputTensor : memref<?x?x?x?xf32>, %batch : index, %scale : f32, %mean : memref<?xf32>, %std : memref<?xf32>) attributes{llvm.emit_c_interface}
+{
+  dip.image_to_tensor <NHWC> BILINEAR_INTERPOLATION %inputImage, %outputTensor, %batch, %scale, %mean, %std : memref<?x?xi8>, memref<?x?x?x?xf32>, index, f32, memref<?xf32>, memref<?xf32>
+  return
+}
+
+func.func @image_to_tensor_nchw_nearest_neighbour_u8_hwc(%inputImage : memref<?x?x?xi8>, %outputTensor : memref<?x?x?x?xf32>, %batch : index, %scale : f32, %mean : memref<?xf32>, %std : memref<?xf32>) attributes{llvm.emit_c_interface}
+{
+  dip.image_to_tensor <NCHW> NEAREST_NEIGHBOUR_INTERPOLATION %inputImage, %outputTensor, %batch, %scale, %mean, %std : memref<?x?x?xi8>, memref<?x?x?x?xf32>, index, f32, memref<?xf32>, memref<?xf32>
+  return
+}
+
+func.func @image_to_tensor_nchw_nearest_neighbour_u8_hwc_swap_rb(%inputImage : memref<?x?x?xi8>, %outputTensor : memref<?x?x?x?xf32>, %batch : index, %scale : f32, %mean : memref<?xf32>, %std : memref<?xf32>) attributes{llvm.emit_c_interface}
+{
+  dip.image_to_tensor <NCHW> NEAREST_NEIGHBOUR_INTERPOLATION %inputImage, %outputTensor, %batch, %scale, %mean, %std {swap_rb} : memref<?x?x?xi8>, memref<?x?x?x?xf32>, index, f32, memref<?xf32>, memref<?xf32>
+  return
+}
+
+func.func @image_to_tensor_nchw_bilinear_u8_hwc(%inputImage : memref<?x?x?xi8>, %outputTensor : memref<?x?x?x?xf32>, %batch : index, %scale : f32, %mean : memref<?xf32>, %std : memref<?xf32>) attributes{llvm.emit_c_interface}
+{
+  dip.image_to_tensor <NCHW> BILINEAR_INTERPOLATION %inputImage, %outputTensor, %batch, %scale, %mean, %std : memref<?x?x?xi8>, memref<?x?x?x?xf32>, index, f32, memref<?xf32>, memref<?xf32>
+  return
+}
+
+func.func @image_to_tensor_nchw_bilinear_u8_hwc_swap_rb(%inputImage : memref<?x?x?xi8>, %outputTensor : memref<?x?x?x?xf32>, %batch : index, %scale : f32, %mean : memref<?xf32>, %std : memref<?xf32>) attributes{llvm.emit_c_interface}
+{
+  dip.image_to_tensor <NCHW> BILINEAR_INTERPOLATION %inputImage, %outputTensor, %batch, %scale, %mean, %std {swap_rb} : memref<?x?x?xi8>, memref<?x?x?x?xf32>, index, f32, memref<?xf32>, memref<?xf32>
+  return
+}
+
+func.func @image_to_tensor_nhwc_nearest_neighbour_u8_hwc(%inputImage : memref<?x?x?xi8>, %outputTensor : memref<?x?x?x?xf32>, %batch : index, %scale : f32, %mean : memref<?xf32>, %std : memref<?xf32>) attributes{llvm.emit_c_interface}
+{
+  dip.image_to_tensor <NHWC> NEAREST_NEIGHBOUR_INTERPOLATION %inputImage, %outputTensor, %batch, %scale, %mean, %std : memref<?x?x?xi8>, memref<?x?x?x?xf32>, index, f32, memref<?xf32>, memref<?xf32>
+  return
+}
+
+func.func @image_to_tensor_nhwc_nearest_neighbour_u8_hwc_swap_rb(%inputImage : memref<?x?x?xi8>, %outputTensor : memref<?x?x?x?xf32>, %batch : index, %scale : f32, %mean : memref<?xf32>, %std : memref<?xf32>) attributes{llvm.emit_c_interface}
+{
+  dip.image_to_tensor <NHWC> NEAREST_NEIGHBOUR_INTERPOLATION %inputImage, %outputTensor, %batch, %scale, %mean, %std {swap_rb} : memref<?x?x?xi8>, memref<?x?x?x?xf32>, index, f32, memref<?xf32>, memref<?xf32>
+  return
+}
+
+func.func @image_to_tensor_nhwc_bilinear_u8_hwc(%inputImage : memref<?x?x?xi8>, %outputTensor : memref<?x?x?x?xf32>, %batch : index, %scale : f32, %mean : memref<?xf32>, %std : memref<?xf32>) attributes{llvm.emit_c_interface}
+{
+  dip.image_to_tensor <NHWC> BILINEAR_INTERPOLATION %inputImage, %outputTensor, %batch, %scale, %mean, %std : memref<?x?x?xi8>, memref<?x?x?x?xf32>, index, f32, memref<?xf32>, memref<?xf32>
+  return
+}
+
+func.func @image_to_tensor_nhwc_bilinear_u8_hwc_swap_rb(%inputImage : memref<?x?x?xi8>, %outputTensor : memref<?x?x?x?xf32>, %batch : index, %scale : f32, %mean : memref<?xf32>, %std : memref<?xf32>) attributes{llvm.emit_c_interface}
+{
+  dip.image_to_tensor <NHWC> BILINEAR_INTERPOLATION %inputImage, %outputTensor, %batch, %scale, %mean, %std {swap_rb} : memref<?x?x?xi8>, memref<?x?x?x?xf32>, index, f32, memref<?xf32>, memref<?xf32>
+  return
+}
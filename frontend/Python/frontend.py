@@ -44,7 +44,7 @@ from .ops.math import ops_registry as math_ops_registry
 from .ops.func import ops_registry as func_ops_registry
 from .graph import Graph, TensorDType, TensorMeta
 from .graph.operation import *
-from .graph.transform import maxpool2d_simplify
+from .graph.transform import maxpool2d_simplify, conv_bn_fold
 
 
 class DynamoCompiler:
@@ -347,10 +347,15 @@ class DynamoCompiler:
                     )
 
                 graph.add_node(buddy_node)
-            transform_list = [maxpool2d_simplify]
+            # The folded parameters must not alias the model parameters.
+            graph_params = list(params_flat)
+            transform_list = [
+                maxpool2d_simplify,
+                lambda graph: conv_bn_fold(graph, graph_params),
+            ]
             graph.perform(transform_list)
             self._imported_graphs.append(graph)
-            self._imported_params[graph] = params_flat
+            self._imported_params[graph] = graph_params
             return _gm.forward
 
         return aot_module_simplified(
@@ -409,6 +409,8 @@ class Conv2dOp(Op):
         super().__init__()
         self._op_type = OpType.ReduceType
         self._layout = "NCHW_FCHW"
+        # The (min, max) clamp fused into the convolution output, if any.
+        self._epilogue = None
 
 class ReluOp(Op):
     def __init__(self) -> None:
@@ -18,5 +18,6 @@
 #
 # ===---------------------------------------------------------------------------
 
+from .conv_bn_fold import conv_bn_fold
 from .fuse_ops import simply_fuse
 from .useless_op_eliminate import maxpool2d_simplify
@@ -0,0 +1,335 @@
+# ===- conv_bn_fold.py ---------------------------------------------------------
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# ===---------------------------------------------------------------------------
+#
+# Fold the inference-mode batch normalization into the convolution parameters.
+#
+# ===---------------------------------------------------------------------------
+
+from typing import List, Optional
+
+import torch
+
+from .. import Graph
+from ..operation import *
+
+
+def _is_node(graph: Graph, arg) -> bool:
+    return isinstance(arg, str) and arg in graph.node_table
+
+
+def _param_index(graph: Graph, params: List[torch.Tensor]) -> dict:
+    """
+    Map the names of the placeholders that hold model parameters to their
+    positions in the flat parameter list. The parameters are the leading
+    placeholders of the graph.
+    """
+    index = {}
+    for node in graph.body:
+        if isinstance(node, PlaceholderOp) and len(index) < len(params):
+            index[node.name] = len(index)
+    return index
+
+
+def _eval_const(graph: Graph, arg, params, param_index, cache):
+    """
+    Evaluate a node that only depends on model parameters and scalars.
+
+    Returns:
+        torch.Tensor or None if the value depends on the model inputs.
+    """
+    if isinstance(arg, (int, float)) and not isinstance(arg, bool):
+        return torch.tensor(arg, dtype=torch.float32)
+    if not _is_node(graph, arg):
+        return None
+    if arg in cache:
+        return cache[arg]
+    node = graph.node_table[arg]
+    value = None
+    if isinstance(node, PlaceholderOp):
+        if arg in param_index:
+            value = params[param_index[arg]].detach()
+    elif isinstance(node, (AddOp, SubOp, MulOp, DivOp)):
+        lhs = _eval_const(graph, node.args[0], params, param_index, cache)
+        rhs = _eval_const(graph, node.args[1], params, param_index, cache)
+        if lhs is not None and rhs is not None:
+            if isinstance(node, AddOp):
+                value = lhs + rhs * node.kwargs.get("alpha", 1)
+            elif isinstance(node, SubOp):
+                value = lhs - rhs * node.kwargs.get("alpha", 1)
+            elif isinstance(node, MulOp):
+                value = lhs * rhs
+            else:
+                value = lhs / rhs
+    elif isinstance(node, (RsqrtOp, SqrtOp, ReciprocalOp)):
+        operand = _eval_const(graph, node.args[0], params, param_index, cache)
+        if operand is not None:
+            if isinstance(node, RsqrtOp):
+                value = torch.rsqrt(operand)
+            elif isinstance(node, SqrtOp):
+                value = torch.sqrt(operand)
+            else:
+                value = torch.reciprocal(operand)
+    elif isinstance(node, UnsqueezeOp):
+        operand = _eval_const(graph, node.args[0], params, param_index, cache)
+        if operand is not None:
+            value = torch.unsqueeze(operand, node.args[1])
+    elif isinstance(node, (ViewOp, ReshapeOp)):
+        operand = _eval_const(graph, node.args[0], params, param_index, cache)
+        if operand is not None:
+            value = torch.reshape(operand, node.args[1])
+    cache[arg] = value
+    return value
+
+
+def _per_channel(value: torch.Tensor, channels: int) -> Optional[torch.Tensor]:
+    """
+    Return the per-output-channel vector of a constant that broadcasts against
+    an NCHW activation, or None if it varies along other dimensions.
+    """
+    target = (1, channels, 1, 1)
+    try:
+        if torch.broadcast_shapes(value.shape, target) != target:
+            return None
+    except RuntimeError:
+        return None
+    return torch.broadcast_to(value, target).reshape(channels)
+
+
+def _remove_node(graph: Graph, node: Op):
+    """
+    Remove a node from the graph and detach it from its parents. Parents that
+    become dead are removed as well, except for the function arguments.
+    """
+    del graph.node_table[node.name]
+    graph.body.remove(node)
+    for parent_name in node._parents:
+        parent = graph.node_table.get(parent_name)
+        if parent is None:
+            continue
+        parent._children = [c for c in parent._children if c != node.name]
+        if len(parent._children) == 0 and not isinstance(
+            parent, PlaceholderOp
+        ):
+            _remove_node(graph, parent)
+
+
+def _replace_uses(graph: Graph, old: Op, new: Op):
+    """
+    Redirect the users of `old` to `new`.
+    """
+
+    def replace(arg):
+        if isinstance(arg, (list, tuple)):
+            return type(arg)(replace(a) for a in arg)
+        if not isinstance(arg, (int, float, bool)) and str(arg) == old.name:
+            return new.name
+        return arg
+
+    for child_name in old._children:
+        child = graph.node_table[child_name]
+        child._arguments = [replace(arg) for arg in child.args]
+        child._parents = [
+            new.name if p == old.name else p for p in child._parents
+        ]
+        new.add_children(child_name)
+    old._children = []
+
+
+def _ancestors(graph: Graph, nodes: List[Op], stop: Op) -> set:
+    """
+    Collect the names of the nodes that the given nodes depend on, without
+    walking through `stop`.
+    """
+    visited = set()
+    pending = [p for node in nodes for p in node._parents]
+    while pending:
+        name = pending.pop()
+        if name == stop.name or name in visited:
+            continue
+        if name not in graph.node_table:
+            continue
+        visited.add(name)
+        pending.extend(graph.node_table[name]._parents)
+    return visited
+
+
+def _only_feeds(graph: Graph, name: str, inputs: set, chain: set) -> bool:
+    """
+    Check that every use of `name` ends in the folded chain.
+    """
+    pending = list(graph.node_table[name]._children)
+    while pending:
+        child = pending.pop()
+        if child in chain:
+            continue
+        if child not in inputs:
+            return False
+        pending.extend(graph.node_table[child]._children)
+    return True
+
+
+def _fold_affine_chain(
+    graph: Graph, conv: Conv2dOp, params, param_index, cache
+) -> bool:
+    """
+    Fold the per-channel affine chain `y = x * scale + shift` that follows the
+    convolution into its weight and bias.
+    """
+    weight_name, bias_name = conv.args[1], conv.args[2]
+    if conv.args[6] or weight_name not in param_index:
+        return False
+    if graph.node_table[weight_name]._children != [conv.name]:
+        return False
+    if bias_name is not None and (
+        bias_name not in param_index
+        or graph.node_table[bias_name]._children != [conv.name]
+    ):
+        return False
+    out_shape = list(conv.tensor_meta["shape"])
+    channels = out_shape[1]
+    scale = torch.ones(channels)
+    shift = torch.zeros(channels)
+    chain = []
+    current = conv
+    while len(current._children) == 1:
+        child = graph.node_table[current._children[0]]
+        if not isinstance(child, (AddOp, SubOp, MulOp, DivOp)):
+            break
+        if list(child.tensor_meta["shape"]) != out_shape:
+            break
+        if len(child.args) != 2 or child.kwargs.get("alpha", 1) != 1:
+            break
+        if child.args[0] == current.name:
+            other, current_is_lhs = child.args[1], True
+        elif child.args[1] == current.name:
+            other, current_is_lhs = child.args[0], False
+        else:
+            break
+        value = _eval_const(graph, other, params, param_index, cache)
+        if value is None:
+            break
+        value = _per_channel(value.to(torch.float32), channels)
+        if value is None:
+            break
+        if isinstance(child, AddOp):
+            shift = shift + value
+        elif isinstance(child, SubOp):
+            if current_is_lhs:
+                shift = shift - value
+            else:
+                scale, shift = -scale, value - shift
+        elif isinstance(child, MulOp):
+            scale, shift = scale * value, shift * value
+        elif current_is_lhs:
+            scale, shift = scale / value, shift / value
+        else:
+            break
+        chain.append(child)
+        current = child
+    if len(chain) == 0:
+        return False
+    chain_names = set(node.name for node in chain)
+    # Without a convolution bias, reuse a per-channel parameter that only
+    # feeds the folded chain (e.g. the batch normalization shift).
+    if bias_name is None:
+        chain_inputs = _ancestors(graph, chain, conv) - chain_names
+        for candidate in param_index:
+            candidate_node = graph.node_table[candidate]
+            if (
+                candidate != weight_name
+                and candidate in chain_inputs
+                and list(candidate_node.tensor_meta["shape"]) == [channels]
+                and _only_feeds(graph, candidate, chain_inputs, chain_names)
+            ):
+                bias_name = candidate
+                break
+        if bias_name is None:
+            return False
+        bias = torch.zeros(channels)
+    else:
+        bias = params[param_index[bias_name]].detach().to(torch.float32)
+    # Rewrite the parameters.
+    with torch.no_grad():
+        weight = params[param_index[weight_name]].detach()
+        params[param_index[weight_name]] = (
+            weight * scale.reshape(-1, 1, 1, 1).to(weight.dtype)
+        ).contiguous()
+        params[param_index[bias_name]] = (bias * scale + shift).to(weight.dtype)
+    cache.clear()
+    # Rewire the graph around the folded chain.
+    conv._children = []
+    _replace_uses(graph, chain[-1], conv)
+    for node in chain:
+        node._parents = [
+            p for p in node._parents if p != conv.name and p not in chain_names
+        ]
+    for node in chain:
+        _remove_node(graph, node)
+    if conv.args[2] is None:
+        conv._arguments[2] = bias_name
+        conv.add_parent(bias_name)
+        graph.node_table[bias_name].add_children(conv.name)
+    return True
+
+
+def _fuse_epilogue(graph: Graph, conv: Conv2dOp):
+    """
+    Mark the trailing ReLU or clamp of the convolution as its epilogue.
+    """
+    while len(conv._children) == 1:
+        child = graph.node_table[conv._children[0]]
+        low, high = conv._epilogue or (-float("inf"), float("inf"))
+        if isinstance(child, ReluOp):
+            low = max(low, 0.0)
+        elif isinstance(child, ClampMinOp) and isinstance(
+            child.args[1], (int, float)
+        ):
+            low = max(low, float(child.args[1]))
+        elif isinstance(child, ClampMaxOp) and isinstance(
+            child.args[1], (int, float)
+        ):
+            high = min(high, float(child.args[1]))
+        else:
+            break
+        conv._epilogue = (low, high)
+        conv._children = []
+        _replace_uses(graph, child, conv)
+        child._parents = []
+        _remove_node(graph, child)
+
+
+def conv_bn_fold(graph: Graph, params: List[torch.Tensor]):
+    """
+    Fold the inference-mode batch normalization that follows a convolution
+    (decomposed into a per-channel affine chain) into the convolution weight
+    and bias, and mark a trailing ReLU or clamp as the convolution epilogue.
+
+    The folded tensors replace their entries in `params`, so the packed
+    parameter layout is unchanged. When the convolution has no bias, a
+    per-channel parameter that only feeds the folded chain holds the new bias.
+
+    Args:
+        graph (Graph): The Graph to be simplified.
+        params (List[torch.Tensor]): The flat parameters of the graph.
+    """
+    param_index = _param_index(graph, params)
+    cache = {}
+    convs = [node for node in graph.body if isinstance(node, Conv2dOp)]
+    for conv in convs:
+        if len(conv.tensor_meta["shape"]) != 4:
+            continue
+        _fold_affine_chain(graph, conv, params, param_index, cache)
+        _fuse_epilogue(graph, conv)
@@ -1148,6 +1148,22 @@ def convolution2d_op(node: Conv2dOp, symbol_table):
                     stride_attr,
                     dilation_attr,
                 )
+        # Fused ReLU/clamp epilogue, applied before the output transpose.
+        if node._epilogue is not None:
+            min_value, max_value = node._epilogue
+            min_int = ir.IntegerAttr.get(
+                ir.IntegerType.get_signless(64),
+                round(max(min_value, -sys.maxsize)),
+            )
+            max_int = ir.IntegerAttr.get(
+                ir.IntegerType.get_signless(64),
+                round(min(max_value, sys.maxsize)),
+            )
+            min_fp = ir.FloatAttr.get(ir.F32Type.get(), min_value)
+            max_fp = ir.FloatAttr.get(ir.F32Type.get(), max_value)
+            op = tosa.ClampOp(
+                output_type, op.result, min_int, max_int, min_fp, max_fp
+            )
         # Output transpose
         if node._layout.find("NCHW") != -1:
             perm_list = [0, 3, 1, 2]
@@ -25,12 +25,13 @@ using namespace mlir;
 
 namespace buddy {
 // Given x*m0+m2(and x*m3+m5) and m1(and m4), compute new x and y, then remap
-// origin pixels to new pixels
+// origin pixels to new pixels. With a positive `tileRows`, tiles of `tileRows`
+// output rows are processed in parallel, each with its own remap buffers.
 void affineTransformCore(OpBuilder &builder, Location loc, Value input,
                          Value output, Value yStart, Value yEnd, Value xStart,
                          Value xEnd, Value m1, Value m4, Value xAddr1,
                          Value xAddr2, int64_t stride, const int &RSV_BITS,
-                         int interp_type);
+                         int interp_type, int64_t tileRows = 0);
 
 // remap using nearest neighbor interpolation
 void remapNearest(OpBuilder &builder, Location loc, Value input, Value output,
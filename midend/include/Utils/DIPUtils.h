@@ -32,7 +32,16 @@ namespace dip {
 
 // Specify operation names which will be used for performing operation specific
 // tasks inside generic utility functions.
-enum class DIP_OP { CORRELATION_2D, EROSION_2D, DILATION_2D };
+enum class DIP_OP {
+  CORRELATION_2D,
+  EROSION_2D,
+  DILATION_2D,
+  OPENING_2D,
+  CLOSING_2D,
+  TOPHAT_2D,
+  BOTTOMHAT_2D,
+  MORPHGRAD_2D
+};
 
 // Specify error codes specific to DIP dialect which might be used for exiting
 // from lowering passes with appropriate messages.
@@ -115,7 +124,7 @@ SmallVector<Value, 6> getRotationMatrix(OpBuilder &builder, Location loc,
 void affineTransformController(OpBuilder &builder, Location loc,
                                MLIRContext *ctx, Value input, Value output,
                                SmallVector<Value, 6> affineMatrix,
-                               int64_t stride);
+                               int64_t stride, int64_t tileRows = 0);
 
 // Controls shear transform application.
 void shearTransformController(
@@ -141,35 +150,63 @@ void standardRotateController(
     Value inputRowLastElemF32, Value inputColLastElemF32, Value c0, Value c0F32,
     Value c1F32Vec, VectorType vectorTy32, int64_t stride, FloatType f32);
 
-// Fills pixels in bilinear interpolation fashion.
-void fillPixelsBilinearInterpolate(
-    OpBuilder &builder, Location loc, Value resXVec, Value resYVec,
-    Value xVec_L, Value yVec_L, Value xVec_H, Value yVec_H, Value input,
-    Value output, Value c0, Value strideVal, Value xVecWeight, Value yVecWeight,
-    Value outputRowLastElemF32, Value outputColLastElemF32,
-    Value inputRowLastElemF32, Value inputColLastElemF32, Value c0F32,
-    Value c1F32);
+// Views an interleaved HxWxC image as a HxWC image with the channels of each
+// pixel in consecutive columns. Returns C for interleaved images and a null
+// value for single channel images, which are left unchanged.
+Value collapseChannels(OpBuilder &builder, Location loc, Value &image);
 
-// Helper function for resizing an image using nearest neighbour interpolation
-// mechanism.
-void NearestNeighbourInterpolationResizing(
-    OpBuilder &builder, Location loc, MLIRContext *ctx,
-    SmallVector<Value, 8> lowerBounds, SmallVector<Value, 8> upperBounds,
-    SmallVector<int64_t, 8> steps, Value strideVal, Value input, Value output,
-    Value horizontalScalingFactorVec, Value verticalScalingFactorVec,
-    Value outputRowLastElemF32, Value outputColLastElemF32,
-    Value inputRowLastElemF32, Value inputColLastElemF32, VectorType vectorTy32,
-    int64_t stride, Value c0, Value c0F32);
+// Helper function for resizing an image with separable passes. The source
+// positions and weights of every output column and row are computed once into
+// coefficient tables; each output row is then interpolated vertically from
+// contiguous input rows into a row buffer and horizontally from the row
+// buffer. Supports all interpolation types and element types; integer images
+// use fixed-point coefficients and saturate to the range of the image, which is
+// unsigned for 8-bit and 16-bit pixels and signed for wider pixels. Images
+// collapsed by `collapseChannels` pass their channel count in `channels`.
+void separableResizing(OpBuilder &builder, Location loc, MLIRContext *ctx,
+                       Value input, Value output,
+                       Value horizontalScalingFactor,
+                       Value verticalScalingFactor, Type elemTy,
+                       buddy::dip::InterpolationType type, int64_t stride,
+                       int64_t tileRows = 0, Value channels = nullptr);
 
-// Helper function for resizing an image using bilinear interpolation mechanism.
-void BilinearInterpolationResizing(
-    OpBuilder &builder, Location loc, MLIRContext *ctx,
-    SmallVector<Value, 8> lowerBounds, SmallVector<Value, 8> upperBounds,
-    SmallVector<int64_t, 8> steps, Value strideVal, Value input, Value output,
-    Value horizontalScalingFactorVec, Value verticalScalingFactorVec,
-    Value outputRowLastElemF32, Value outputColLastElemF32,
-    Value inputRowLastElemF32, Value inputColLastElemF32, VectorType vectorTy32,
-    int64_t stride, Value c0, Value c0F32, Value c1F32);
+// Helper function for warping an image with an affine (2x3) or perspective
+// (3x3) `matrix` mapping output coordinates to input coordinates. Source
+// positions are quantized to fixed point and sampled bilinearly; samples
+// outside the input image are extrapolated according to `boundaryOptionAttr`.
+// The perspective division is only emitted when `perspective` is set. Images
+// collapsed by `collapseChannels` pass their channel count in `channels`.
+void warpImage(OpBuilder &builder, Location loc, MLIRContext *ctx, Value input,
+               Value matrix, Value output, Value constantValue, Type elemTy,
+               buddy::dip::BoundaryOption boundaryOptionAttr, bool perspective,
+               int64_t stride, int64_t tileRows = 0, Value channels = nullptr);
+
+// Helper function for storing the fixed-point source positions `warpImage`
+// samples for every output pixel into the 2xHxW i32 `map`.
+void buildWarpMap(OpBuilder &builder, Location loc, MLIRContext *ctx,
+                  Value matrix, Value map, int64_t stride,
+                  int64_t tileRows = 0);
+
+// Helper function for resampling an image at the source positions of a map
+// built by `buildWarpMap`.
+void remapImage(OpBuilder &builder, Location loc, MLIRContext *ctx, Value input,
+                Value map, Value output, Value constantValue, Type elemTy,
+                buddy::dip::BoundaryOption boundaryOptionAttr, int64_t stride,
+                int64_t tileRows = 0, Value channels = nullptr);
+
+// Helper function for converting an unsigned integer (or f32) HxW or
+// interleaved HxWxC image into entry `batch` of a NCHW or NHWC f32 tensor in
+// one pass. Each output pixel is resampled from the input with nearest
+// neighbour or bilinear interpolation, reads the input channel selected for
+// its output channel (swapping the first and the third channel of color
+// images when `swapRB` is set) and is normalized to
+// (pixel * scale - mean[c]) / stdDev[c].
+void imageToTensor(OpBuilder &builder, Location loc, MLIRContext *ctx,
+                   Value input, Value output, Value batch, Value scale,
+                   Value mean, Value stdDev, Type elemTy,
+                   buddy::dip::InterpolationType type,
+                   buddy::dip::TensorLayout layout, bool swapRB, int64_t stride,
+                   int64_t tileRows = 0);
 
 // Util function for morphological transformations ; compares two vectors and
 // returns a mask
@@ -194,11 +231,163 @@ void calcAndStorewTailProcessingMorph(
 // Utility function for traversing an image with support for boundary extrapolation,
 // variable anchor point positioning, and tail processing. It is used to compose more
 // complicated operations on top of it, like 2D Correlation and morphological operations.
+// With a positive `tileRows`, the output rows are processed in parallel tiles;
+// every tile reads its halo rows directly from the input.
 void traverseImagewBoundaryExtrapolation(
     OpBuilder &rewriter, Location loc, MLIRContext *ctx, Value input,
     Value kernel, Value output, Value centerX, Value centerY,
     Value constantValue, Value strideVal, Type elemTy,
-    buddy::dip::BoundaryOption boundaryOptionAttr, int64_t stride, DIP_OP op);
+    buddy::dip::BoundaryOption boundaryOptionAttr, int64_t stride, DIP_OP op,
+    int64_t tileRows = 0);
+
+// Utility function for 2D correlation with a separable kernel kernelY *
+// kernelX^T. Each extrapolated input row is correlated with kernelX once,
+// through a padded row buffer, into a ring buffer of the last kernelY rows;
+// each output row is then the kernelY-weighted sum of the ring buffer rows.
+// Images of up to 16-bit integers are treated as unsigned and accumulated in
+// a wider type with signed kernels, saturating to the range of the image.
+// Images collapsed by `collapseChannels` pass their channel count in
+// `channels`.
+void separableCorrelation(OpBuilder &rewriter, Location loc, MLIRContext *ctx,
+                          Value input, Value kernelX, Value kernelY,
+                          Value output, Value centerX, Value centerY,
+                          Value constantValue, Type elemTy,
+                          buddy::dip::BoundaryOption boundaryOptionAttr,
+                          int64_t stride, Value channels = nullptr);
+
+// Helper function for computing the integral image of `input` into `output`,
+// which has one more row and column than the input: output[i][j] is the sum
+// of the input pixels above and left of (i, j). Each row is summed with
+// in-register prefix sums and added to the output row above it. Integer
+// pixels are unsigned.
+void integralImage(OpBuilder &builder, Location loc, MLIRContext *ctx,
+                   Value input, Value output, Type inElemTy, Type outElemTy,
+                   int64_t stride);
+
+// Helper function for the normalized box filter (mean over a kernelWidth x
+// kernelHeight window anchored at (centerX, centerY)). Every row tile keeps
+// the sums of the window rows for each column, which slide down by adding the
+// new row and subtracting the old one, and gets the window sums of each output
+// row from the prefix sums of the column sums, so the cost per pixel does not
+// depend on the window size. Integer images of up to 16 bits are unsigned and
+// summed exactly in i32; integer results are rounded to nearest. The output
+// may have a different element type than the input, e.g. f32 for the
+// intermediate results of `gaussianBlur`.
+void boxFilter(OpBuilder &builder, Location loc, MLIRContext *ctx, Value input,
+               Value output, Value kernelWidth, Value kernelHeight,
+               Value centerX, Value centerY, Value constantValue,
+               Type inElemTy, Type outElemTy,
+               buddy::dip::BoundaryOption boundaryOptionAttr, int64_t stride,
+               int64_t tileRows = 0);
+
+// Helper function for approximating a Gaussian blur with standard deviations
+// `sigmaX` and `sigmaY` by three successive `boxFilter` passes with odd widths
+// whose variances add up to sigma^2. Intermediate results of integer images
+// are kept in f32.
+void gaussianBlur(OpBuilder &builder, Location loc, MLIRContext *ctx,
+                  Value input, Value output, Value sigmaX, Value sigmaY,
+                  Value constantValue, Type elemTy,
+                  buddy::dip::BoundaryOption boundaryOptionAttr,
+                  int64_t stride, int64_t tileRows = 0);
+
+// Helper function for the rank filters, which replace every pixel with the
+// element of rank `rank` (clamped to the window) of its kernelSize x kernelSize
+// window anchored at kernelSize / 2; a null `rank` selects the median. Every
+// row tile is first copied with its extrapolated borders. 3x3 and 5x5 windows
+// are sorted with vectorized odd-even merge sorting networks, pruned to the
+// median when the rank is known. Larger 8-bit windows use the constant-time
+// histogram algorithm of Perreault and Hebert, and other windows select the
+// rank with Hoare's quickselect. Integer pixels are unsigned.
+void rankFilter(OpBuilder &builder, Location loc, MLIRContext *ctx,
+                Value input, Value output, Value kernelSize, Value rank,
+                Value constantValue, Type elemTy,
+                buddy::dip::BoundaryOption boundaryOptionAttr, int64_t stride,
+                int64_t tileRows = 0);
+
+// Helper function for the next level of a Gaussian pyramid: every second row
+// and column of the image blurred with the 5x5 binomial kernel. Only the kept
+// rows are blurred vertically, into a padded row buffer, and the kept columns
+// are blurred horizontally from the even lanes of double-width vectors.
+// Integer pixels are unsigned, summed in i32 and rounded to nearest.
+void pyrDown(OpBuilder &builder, Location loc, MLIRContext *ctx, Value input,
+             Value output, Value constantValue, Type elemTy,
+             buddy::dip::BoundaryOption boundaryOptionAttr, int64_t stride,
+             int64_t tileRows = 0);
+
+// Helper function for the previous level of a Gaussian pyramid: the image
+// upsampled by two and blurred with 4 times the kernel of `pyrDown`. The taps
+// of the zero rows and columns are skipped by selecting the weights from the
+// parity of the output row, and the even and odd output columns are computed
+// in separate vectors which are interleaved with a shuffle.
+void pyrUp(OpBuilder &builder, Location loc, MLIRContext *ctx, Value input,
+           Value output, Value constantValue, Type elemTy,
+           buddy::dip::BoundaryOption boundaryOptionAttr, int64_t stride,
+           int64_t tileRows = 0);
+
+// Helper function for the 256-bin histogram of an unsigned 8-bit image. With a
+// positive `tileRows`, every row tile counts its pixels into a private
+// sub-histogram in parallel, and the sub-histograms are then merged with
+// vector additions.
+void histogram(OpBuilder &builder, Location loc, MLIRContext *ctx,
+               Value input, Value hist, int64_t stride, int64_t tileRows = 0);
+
+// Helper function for mapping every pixel of an unsigned 8-bit image through
+// the 256-entry table `lut` with vector gathers. Interleaved images are
+// collapsed by `collapseChannels` beforehand.
+void applyLut(OpBuilder &builder, Location loc, MLIRContext *ctx, Value input,
+              Value lut, Value output, Type outElemTy, int64_t stride,
+              int64_t tileRows = 0);
+
+// Helper function for histogram equalization of an unsigned 8-bit image: the
+// cdf of the `histogram` is turned into a LUT in vectors, which is applied
+// with `applyLut`.
+void equalizeHist(OpBuilder &builder, Location loc, MLIRContext *ctx,
+                  Value input, Value output, int64_t stride,
+                  int64_t tileRows = 0);
+
+// Utility function for erosion and dilation with a flat rectangular (or line)
+// structuring element, using the van Herk/Gil-Werman algorithm: the running
+// min/max is computed with forward and backward scans over segments of the
+// kernel size, separately along columns and rows, so the cost per pixel does
+// not depend on the kernel size. The column scans run on vectors of image rows;
+// the row scans run on vectors of one element of several rows, which are
+// obtained by transposing square blocks. The result is combined with the values
+// already present in `output`. With a positive `tileRows`, the scan segments
+// and the row tiles are processed in parallel.
+void vanHerkMorphology(OpBuilder &rewriter, Location loc, MLIRContext *ctx,
+                       Value input, Value kernel, Value output, Value centerX,
+                       Value centerY, Value constantValue, Type elemTy,
+                       buddy::dip::BoundaryOption boundaryOptionAttr,
+                       int64_t stride, DIP_OP op, int64_t tileRows = 0);
+
+// Utility function for erosion and dilation which uses `vanHerkMorphology`
+// when all of the elements of the kernel are non-zero, and
+// `traverseImagewBoundaryExtrapolation` otherwise. The kernel is checked at
+// compile time when it is a constant global and at runtime otherwise.
+void traverseImageMorphology(OpBuilder &rewriter, Location loc,
+                             MLIRContext *ctx, Value input, Value kernel,
+                             Value output, Value centerX, Value centerY,
+                             Value constantValue, Value strideVal, Type elemTy,
+                             buddy::dip::BoundaryOption boundaryOptionAttr,
+                             int64_t stride, DIP_OP op, int64_t tileRows = 0);
+
+// Utility function for a single iteration of a compound morphological
+// operation (opening, closing, top hat, bottom hat or morphological gradient).
+// The image is processed in row tiles: each tile extrapolates the input rows it
+// needs, including the halo of both stages, into a small buffer, computes the
+// first stage into a second tile buffer and writes the final result, so no
+// full size intermediate image is created. With a rectangular kernel, every
+// stage runs the vertical and horizontal van Herk/Gil-Werman scans of
+// `vanHerkMorphology` over the tile buffers; the kernel is checked like in
+// `traverseImageMorphology`. `firstInit` and `secondInit` are
+// the initial values of the first and the second stage. Tiles have `tileRows`
+// rows and are processed in parallel when it is positive.
+void fusedMorphology(OpBuilder &rewriter, Location loc, MLIRContext *ctx,
+                     Value input, Value kernel, Value output, Value centerX,
+                     Value centerY, Value constantValue, Value firstInit,
+                     Value secondInit, Type elemTy,
+                     buddy::dip::BoundaryOption boundaryOptionAttr,
+                     int64_t stride, DIP_OP op, int64_t tileRows = 0);
 
 // Function for applying type check mechanisms for all DIP dialect operations.
 template <typename DIPOP>
@@ -66,6 +66,24 @@ Value iotaVec0F32(OpBuilder &builder, Location loc, int64_t length);
 Value castAndExpand(OpBuilder &builder, Location loc, Value val,
                     VectorType vecType);
 
+// Builds an affine loop nest like `affine::buildAffineLoopNest`. When
+// `tileRows` is positive, the outermost (row) loop is split into tiles of
+// `tileRows` iterations which are distributed by an `affine.parallel` loop;
+// otherwise the nest is sequential.
+void buildRowTiledLoopNest(
+    OpBuilder &builder, Location loc, ValueRange lbs, ValueRange ubs,
+    ArrayRef<int64_t> steps, int64_t tileRows,
+    function_ref<void(OpBuilder &, Location, ValueRange)> bodyBuilderFn);
+
+// Splits the rows [lowerBound, upperBound) into tiles of `tileRows` rows and
+// calls `bodyBuilderFn` with the bounds of each tile inside an `scf.parallel`
+// loop. When `tileRows` is not positive, the body is built once for the whole
+// range.
+void buildRowTileLoop(
+    OpBuilder &builder, Location loc, Value lowerBound, Value upperBound,
+    int64_t tileRows,
+    function_ref<void(OpBuilder &, Location, Value, Value)> bodyBuilderFn);
+
 // print values(for debug use)
 void printValues(OpBuilder &builder, Location loc,
                  std::initializer_list<Value> values);
@@ -102,37 +120,55 @@ void vector2DMemRefMultiply(OpBuilder &builder, Location loc, Value memRef1Real,
                             Value memRef3Imag, Value memRefNumRows,
                             Value memRefNumCols, Value c0, VectorType vecType);
 
-// Function for implementing Cooley Tukey Butterfly algortihm for calculating
-// inverse of discrete Fourier transform of invidiual 1D components of 2D input
-// MemRef. Separate MemRefs for real and imaginary parts are expected.
-void idft1DCooleyTukeyButterfly(OpBuilder &builder, Location loc,
-                                Value memRefReal2D, Value memRefImag2D,
-                                Value memRefLength, Value strideVal,
-                                VectorType vecType, Value rowIndex, Value c0,
-                                Value c1, int64_t step);
-
-// Function for implementing Gentleman Sande Butterfly algortihm for calculating
-// discrete Fourier transform of invidiual 1D components of 2D input MemRef.
-// Separate MemRefs for real and imaginary parts are expected.
-void dft1DGentlemanSandeButterfly(OpBuilder &builder, Location loc,
-                                  Value memRefReal2D, Value memRefImag2D,
-                                  Value memRefLength, Value strideVal,
-                                  VectorType vecType, Value rowIndex, Value c0,
-                                  Value c1, int64_t step);
+// Function for factorizing `memRefLength` into the radices of the mixed-radix
+// FFT. The radices are stored in the 1D index MemRef `radices`; the number of
+// stages and the remaining factor are returned. The remaining factor is 1 iff
+// the length is of the form 2^a * 3^b * 5^c.
+std::pair<Value, Value> fftFactorize(OpBuilder &builder, Location loc,
+                                     Value memRefLength, Value radices,
+                                     Value c0, Value c1);
+
+// Function for implementing the mixed-radix (2, 3, 4, 5) FFT of a row of 2D
+// MemRefs, using the radices computed by `fftFactorize`. The forward
+// transform leaves the spectrum in digit-reversed order, which is the order
+// consumed by the inverse transform; the inverse transform also scales the
+// result by 1 / length. Separate MemRefs for real and imaginary parts are
+// expected.
+void fft1DMixedRadix(OpBuilder &builder, Location loc, Value memRefReal2D,
+                     Value memRefImag2D, Value memRefLength, Value radices,
+                     Value numStages, VectorType vecType, Value rowIndex,
+                     Value c0, Value c1, bool inverse);
+
+// Function for implementing Bluestein's algorithm for the DFT of every row of
+// 2D MemRefs whose length has prime factors other than 2, 3 and 5. The
+// spectrum is in natural order. Separate MemRefs for real and imaginary parts
+// are expected.
+void fft1DBluestein(OpBuilder &builder, Location loc, Value memRefReal2D,
+                    Value memRefImag2D, Value memRefNumRows,
+                    Value memRefLength, VectorType vecType, Value c0, Value c1,
+                    bool inverse);
+
+// Function for calculating the DFT (or its inverse) of every row of 2D
+// MemRefs. Rows whose length is 2^a * 3^b * 5^c use the mixed-radix FFT, other
+// lengths fall back to Bluestein's algorithm. Separate MemRefs for real and
+// imaginary parts are expected.
+void fft1DRows(OpBuilder &builder, Location loc, Value memRefReal2D,
+               Value memRefImag2D, Value memRefNumRows, Value memRefLength,
+               VectorType vecType, Value c0, Value c1, bool inverse);
 
 // Function for applying inverse of discrete fourier transform on a 2D MemRef.
 // Separate MemRefs for real and imaginary parts are expected.
 void idft2D(OpBuilder &builder, Location loc, Value container2DReal,
             Value container2DImag, Value container2DRows, Value container2DCols,
             Value intermediateReal, Value intermediateImag, Value c0, Value c1,
-            Value strideVal, VectorType vecType);
+            VectorType vecType);
 
 // Function for applying discrete fourier transform on a 2D MemRef. Separate
 // MemRefs for real and imaginary parts are expected.
 void dft2D(OpBuilder &builder, Location loc, Value container2DReal,
            Value container2DImag, Value container2DRows, Value container2DCols,
            Value intermediateReal, Value intermediateImag, Value c0, Value c1,
-           Value strideVal, VectorType vecType);
+           VectorType vecType);
 
 } // namespace buddy
 
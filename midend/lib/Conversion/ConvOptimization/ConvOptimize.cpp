@@ -21,6 +21,7 @@
 #include <mlir/Dialect/Affine/IR/AffineOps.h>
 #include <mlir/Dialect/Func/IR/FuncOps.h>
 #include <mlir/Dialect/Linalg/Transforms/Transforms.h>
+#include <mlir/Dialect/SCF/IR/SCF.h>
 #include <mlir/IR/IntegerSet.h>
 #include <mlir/Pass/Pass.h>
 
@@ -157,6 +158,235 @@ private:
   int64_t kernelM;
   int64_t kernelN;
 };
+
+/// Direct convolution for `linalg.conv_2d_nhwc_hwcf` on memrefs.
+///
+/// The filter is first packed into a `FB x KH x KW x C x blockF` buffer, where
+/// `blockF = vecSize * channelBlock` and the last output-channel block is zero
+/// padded, so that every block of output channels reads its weights
+/// contiguously. The computation then runs an `scf.parallel` over batch,
+/// output rows and output-channel blocks. Each parallel iteration keeps a
+/// `widthBlock x channelBlock` tile of output vectors in registers while it
+/// accumulates over the filter window and the input channels, and a scalar
+/// column loop handles the width tail. Strides and dilations are taken from
+/// the op attributes.
+class ConvNhwcHwcfOptimizePattern : public ConversionPattern {
+public:
+  explicit ConvNhwcHwcfOptimizePattern(MLIRContext *context,
+                                       int64_t vecSizeParam,
+                                       int64_t channelBlockParam,
+                                       int64_t widthBlockParam)
+      : ConversionPattern(linalg::Conv2DNhwcHwcfOp::getOperationName(), 1,
+                          context) {
+    vecSize = vecSizeParam;
+    channelBlock = channelBlockParam;
+    widthBlock = widthBlockParam;
+  }
+
+  LogicalResult
+  matchAndRewrite(Operation *op, ArrayRef<Value> /*operands*/,
+                  ConversionPatternRewriter &rewriter) const override {
+    auto convOp = cast<linalg::Conv2DNhwcHwcfOp>(op);
+    auto loc = op->getLoc();
+
+    Value input = op->getOperand(0);
+    Value filter = op->getOperand(1);
+    Value output = op->getOperand(2);
+
+    auto inputTy = input.getType().dyn_cast<MemRefType>();
+    auto filterTy = filter.getType().dyn_cast<MemRefType>();
+    auto outputTy = output.getType().dyn_cast<MemRefType>();
+    if (!inputTy || !filterTy || !outputTy)
+      return failure();
+    Type elemTy = inputTy.getElementType();
+    if (!elemTy.isa<FloatType>() || filterTy.getElementType() != elemTy ||
+        outputTy.getElementType() != elemTy)
+      return failure();
+
+    SmallVector<int64_t, 2> strides =
+        llvm::to_vector<2>(convOp.getStrides().getValues<int64_t>());
+    SmallVector<int64_t, 2> dilations =
+        llvm::to_vector<2>(convOp.getDilations().getValues<int64_t>());
+
+    const int64_t blockF = vecSize * channelBlock;
+    VectorType vecTy = VectorType::get(vecSize, elemTy);
+
+    const AffineExpr d0 = rewriter.getAffineDimExpr(0);
+    const AffineExpr d1 = rewriter.getAffineDimExpr(1);
+
+    const Value c0 =
+        rewriter.create<arith::ConstantOp>(loc, rewriter.getIndexAttr(0));
+    const Value c1 =
+        rewriter.create<arith::ConstantOp>(loc, rewriter.getIndexAttr(1));
+    const Value zeroElem = rewriter.create<arith::ConstantOp>(
+        loc, rewriter.getZeroAttr(elemTy));
+
+    // Dims
+    Value batch = rewriter.create<memref::DimOp>(loc, output, 0);
+    Value outRows = rewriter.create<memref::DimOp>(loc, output, 1);
+    Value outCols = rewriter.create<memref::DimOp>(loc, output, 2);
+    Value outChannels = rewriter.create<memref::DimOp>(loc, output, 3);
+    Value kernelRows = rewriter.create<memref::DimOp>(loc, filter, 0);
+    Value kernelCols = rewriter.create<memref::DimOp>(loc, filter, 1);
+    Value inChannels = rewriter.create<memref::DimOp>(loc, filter, 2);
+
+    Value channelBlocks = rewriter.create<affine::AffineApplyOp>(
+        loc, AffineMap::get(1, 0, d0.ceilDiv(blockF)), ValueRange{outChannels});
+    Value outColsMain = rewriter.create<affine::AffineApplyOp>(
+        loc, AffineMap::get(1, 0, d0.floorDiv(widthBlock) * widthBlock),
+        ValueRange{outCols});
+
+    // Step 1: Pack the filter into output-channel blocks.
+    MemRefType packedTy = MemRefType::get(
+        {ShapedType::kDynamic, ShapedType::kDynamic, ShapedType::kDynamic,
+         ShapedType::kDynamic, blockF},
+        elemTy);
+    Value packed = rewriter.create<memref::AllocOp>(
+        loc, packedTy,
+        ValueRange{channelBlocks, kernelRows, kernelCols, inChannels});
+
+    rewriter.create<scf::ParallelOp>(
+        loc, ValueRange{c0, c0}, ValueRange{channelBlocks, kernelRows},
+        ValueRange{c1, c1},
+        [&](OpBuilder &builder, Location loc, ValueRange ivs) {
+          Value ivFB = ivs[0];
+          Value ivKH = ivs[1];
+          affine::buildAffineLoopNest(
+              builder, loc, {c0, c0}, {kernelCols, inChannels}, {1, 1},
+              [&](OpBuilder &builder, Location loc, ValueRange ivRange) {
+                Value ivKW = ivRange[0];
+                Value ivC = ivRange[1];
+                for (int64_t m = 0; m < channelBlock; ++m) {
+                  Value channel = builder.create<affine::AffineApplyOp>(
+                      loc, AffineMap::get(1, 0, d0 * blockF + m * vecSize),
+                      ValueRange{ivFB});
+                  // Out-of-bounds channels of the last block read as zero.
+                  Value w = builder.create<vector::TransferReadOp>(
+                      loc, vecTy, filter,
+                      ValueRange{ivKH, ivKW, ivC, channel}, zeroElem);
+                  Value offset = builder.create<arith::ConstantOp>(
+                      loc, builder.getIndexAttr(m * vecSize));
+                  builder.create<vector::StoreOp>(
+                      loc, w, packed,
+                      ValueRange{ivFB, ivKH, ivKW, ivC, offset});
+                }
+              });
+        });
+
+    // Emit the register-blocked micro-kernel for `width` output columns
+    // starting at `ivOW`.
+    auto emitTile = [&](OpBuilder &builder, Location loc, Value ivN, Value ivOH,
+                        Value ivFB, Value ivOW, int64_t width) {
+      SmallVector<Value> channels;
+      SmallVector<Value> offsets;
+      for (int64_t m = 0; m < channelBlock; ++m) {
+        channels.push_back(builder.create<affine::AffineApplyOp>(
+            loc, AffineMap::get(1, 0, d0 * blockF + m * vecSize),
+            ValueRange{ivFB}));
+        offsets.push_back(builder.create<arith::ConstantOp>(
+            loc, builder.getIndexAttr(m * vecSize)));
+      }
+      SmallVector<Value> columns;
+      for (int64_t j = 0; j < width; ++j)
+        columns.push_back(builder.create<affine::AffineApplyOp>(
+            loc, AffineMap::get(1, 0, d0 + j), ValueRange{ivOW}));
+
+      // Load the current output tile, the linalg op accumulates into it.
+      SmallVector<Value> accs;
+      for (int64_t j = 0; j < width; ++j)
+        for (int64_t m = 0; m < channelBlock; ++m)
+          accs.push_back(builder.create<vector::TransferReadOp>(
+              loc, vecTy, output, ValueRange{ivN, ivOH, columns[j], channels[m]},
+              zeroElem));
+
+      auto khLoop = builder.create<scf::ForOp>(
+          loc, c0, kernelRows, c1, accs,
+          [&](OpBuilder &builder, Location loc, Value ivKH, ValueRange accs) {
+            Value inRow = builder.create<affine::AffineApplyOp>(
+                loc,
+                AffineMap::get(2, 0, d0 * strides[0] + d1 * dilations[0]),
+                ValueRange{ivOH, ivKH});
+            auto kwLoop = builder.create<scf::ForOp>(
+                loc, c0, kernelCols, c1, accs,
+                [&](OpBuilder &builder, Location loc, Value ivKW,
+                    ValueRange accs) {
+                  SmallVector<Value> inCols;
+                  for (int64_t j = 0; j < width; ++j)
+                    inCols.push_back(builder.create<affine::AffineApplyOp>(
+                        loc,
+                        AffineMap::get(2, 0,
+                                       d0 * strides[1] + d1 * dilations[1]),
+                        ValueRange{columns[j], ivKW}));
+                  auto cLoop = builder.create<scf::ForOp>(
+                      loc, c0, inChannels, c1, accs,
+                      [&](OpBuilder &builder, Location loc, Value ivC,
+                          ValueRange accs) {
+                        SmallVector<Value> weights;
+                        for (int64_t m = 0; m < channelBlock; ++m)
+                          weights.push_back(builder.create<vector::LoadOp>(
+                              loc, vecTy, packed,
+                              ValueRange{ivFB, ivKH, ivKW, ivC, offsets[m]}));
+                        SmallVector<Value> results;
+                        for (int64_t j = 0; j < width; ++j) {
+                          Value x = builder.create<memref::LoadOp>(
+                              loc, input, ValueRange{ivN, inRow, inCols[j], ivC});
+                          Value xVec =
+                              builder.create<vector::BroadcastOp>(loc, vecTy, x);
+                          for (int64_t m = 0; m < channelBlock; ++m)
+                            results.push_back(builder.create<vector::FMAOp>(
+                                loc, xVec, weights[m],
+                                accs[j * channelBlock + m]));
+                        }
+                        builder.create<scf::YieldOp>(loc, results);
+                      });
+                  builder.create<scf::YieldOp>(loc, cLoop.getResults());
+                });
+            builder.create<scf::YieldOp>(loc, kwLoop.getResults());
+          });
+
+      // Out-of-bounds lanes of the last channel block are masked off.
+      for (int64_t j = 0; j < width; ++j)
+        for (int64_t m = 0; m < channelBlock; ++m)
+          builder.create<vector::TransferWriteOp>(
+              loc, khLoop.getResult(j * channelBlock + m), output,
+              ValueRange{ivN, ivOH, columns[j], channels[m]});
+    };
+
+    // Step 2: Parallel over batch, output rows and output-channel blocks.
+    rewriter.create<scf::ParallelOp>(
+        loc, ValueRange{c0, c0, c0}, ValueRange{batch, outRows, channelBlocks},
+        ValueRange{c1, c1, c1},
+        [&](OpBuilder &builder, Location loc, ValueRange ivs) {
+          Value ivN = ivs[0];
+          Value ivOH = ivs[1];
+          Value ivFB = ivs[2];
+          Value widthStep = builder.create<arith::ConstantOp>(
+              loc, builder.getIndexAttr(widthBlock));
+          builder.create<scf::ForOp>(
+              loc, c0, outColsMain, widthStep, std::nullopt,
+              [&](OpBuilder &builder, Location loc, Value ivOW, ValueRange) {
+                emitTile(builder, loc, ivN, ivOH, ivFB, ivOW, widthBlock);
+                builder.create<scf::YieldOp>(loc);
+              });
+          builder.create<scf::ForOp>(
+              loc, outColsMain, outCols, c1, std::nullopt,
+              [&](OpBuilder &builder, Location loc, Value ivOW, ValueRange) {
+                emitTile(builder, loc, ivN, ivOH, ivFB, ivOW, 1);
+                builder.create<scf::YieldOp>(loc);
+              });
+        });
+
+    rewriter.create<memref::DeallocOp>(loc, packed);
+
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  int64_t vecSize;
+  int64_t channelBlock;
+  int64_t widthBlock;
+};
 } // end anonymous namespace
 
 //===----------------------------------------------------------------------===//
@@ -180,7 +410,7 @@ public:
   void runOnOperation() override;
 
   void getDependentDialects(DialectRegistry &registry) const override {
-    registry.insert<linalg::LinalgDialect, scf::SCFDialect, affine::AffineDialect, VectorDialect>();
+    registry.insert<linalg::LinalgDialect, scf::SCFDialect, affine::AffineDialect, memref::MemRefDialect, VectorDialect>();
   }
 
   Option<int64_t> vecSize{*this, "vec-size", llvm::cl::desc("Vector size using in kernel."), llvm::cl::init(16)};
@@ -188,6 +418,10 @@ public:
   Option<int64_t> kernelM{*this, "kernel-m", llvm::cl::desc("Specify how many rows kernel will contain."), llvm::cl::init(4)};
 
   Option<int64_t> kernelN{*this, "kernel-n", llvm::cl::desc("Specify how many columns kernel will cantain."), llvm::cl::init(2)};
+
+  Option<int64_t> channelBlock{*this, "channel-block", llvm::cl::desc("Output-channel vectors kept in registers by the NHWC kernel."), llvm::cl::init(2)};
+
+  Option<int64_t> widthBlock{*this, "width-block", llvm::cl::desc("Output columns kept in registers by the NHWC kernel."), llvm::cl::init(4)};
 };
 } // end anonymous namespace.
 
@@ -195,6 +429,11 @@ void ConvOptimizePass::runOnOperation() {
   MLIRContext *context = &getContext();
   ModuleOp module = getOperation();
 
+  if (channelBlock <= 0 || widthBlock <= 0) {
+    module.emitError("conv-optimize requires positive channel-block and width-block");
+    return signalPassFailure();
+  }
+
   ConversionTarget target(*context);
   target.addLegalDialect<arith::ArithDialect, affine::AffineDialect, scf::SCFDialect, memref::MemRefDialect, VectorDialect>();
   target.addLegalOp<ModuleOp, func::FuncOp, func::ReturnOp>();
@@ -202,6 +441,7 @@ void ConvOptimizePass::runOnOperation() {
 
   RewritePatternSet patterns(context);
   patterns.add<ConvOptimizePattern>(context, vecSize, kernelM, kernelN);
+  patterns.add<ConvNhwcHwcfOptimizePattern>(context, vecSize, channelBlock, widthBlock);
 
   if (failed(applyPartialConversion(module, target, std::move(patterns))))
     signalPassFailure();
@@ -0,0 +1,557 @@
+//====- ConvWinograd.cpp --------------------------------------------------===//
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements the Winograd convolution F(m x m, 3 x 3) for 3x3
+// stride-1 `linalg.conv_2d_nchw_fchw` and `linalg.conv_2d_nhwc_hwcf`.
+//
+// With alpha = m + 2, the convolution of every m x m output tile is computed
+// as Y = A^T [(G g G^T) . (B^T d B)] A. The rewrite emits:
+//   1. the filter transform U = G g G^T, folded into a new constant global
+//      when the filter is a constant `memref.get_global`;
+//   2. the input transform V = B^T d B, vectorized over the rows of the
+//      alpha x alpha input patch;
+//   3. one `linalg.batch_matmul` over the alpha^2 transform positions,
+//      M[e] = U[e] x V[e], so that `-batchmatmul-optimize` supplies the
+//      micro-kernel;
+//   4. the output transform Y = A^T M A, accumulated into the output.
+//
+//===----------------------------------------------------------------------===//
+
+#include <mlir/Dialect/Affine/IR/AffineOps.h>
+#include <mlir/Dialect/Func/IR/FuncOps.h>
+#include <mlir/Dialect/Linalg/Transforms/Transforms.h>
+#include <mlir/Dialect/SCF/IR/SCF.h>
+#include <mlir/IR/SymbolTable.h>
+#include <mlir/Pass/Pass.h>
+
+using namespace mlir;
+using namespace vector;
+
+//===----------------------------------------------------------------------===//
+// Helper Functions
+//===----------------------------------------------------------------------===//
+
+namespace {
+
+using Matrix = SmallVector<SmallVector<double, 6>, 6>;
+
+/// Transform matrices of the Winograd algorithm F(m x m, 3 x 3).
+struct WinogradMatrices {
+  int64_t m;
+  int64_t alpha;
+  // alpha x 3
+  Matrix G;
+  // alpha x alpha
+  Matrix BT;
+  // m x alpha
+  Matrix AT;
+};
+
+WinogradMatrices getWinogradMatrices(int64_t m) {
+  WinogradMatrices w;
+  w.m = m;
+  w.alpha = m + 2;
+  if (m == 2) {
+    w.G = {{1, 0, 0}, {0.5, 0.5, 0.5}, {0.5, -0.5, 0.5}, {0, 0, 1}};
+    w.BT = {{1, 0, -1, 0}, {0, 1, 1, 0}, {0, -1, 1, 0}, {0, 1, 0, -1}};
+    w.AT = {{1, 1, 1, 0}, {0, 1, -1, -1}};
+    return w;
+  }
+  w.G = {{1.0 / 4, 0, 0},
+         {-1.0 / 6, -1.0 / 6, -1.0 / 6},
+         {-1.0 / 6, 1.0 / 6, -1.0 / 6},
+         {1.0 / 24, 1.0 / 12, 1.0 / 6},
+         {1.0 / 24, -1.0 / 12, 1.0 / 6},
+         {0, 0, 1}};
+  w.BT = {{4, 0, -5, 0, 1, 0},  {0, -4, -4, 1, 1, 0}, {0, 4, -4, -1, 1, 0},
+          {0, -2, -1, 2, 1, 0}, {0, 2, -1, -2, 1, 0}, {0, 4, 0, -5, 0, 1}};
+  w.AT = {{1, 1, 1, 1, 1, 0},
+          {0, 1, -1, 2, -2, 0},
+          {0, 1, 1, 4, 4, 0},
+          {0, 1, -1, 8, -8, 1}};
+  return w;
+}
+
+/// Computes U = G g G^T for a 3x3 filter `g` on the host.
+SmallVector<double, 36> transformFilter(const WinogradMatrices &w,
+                                        ArrayRef<double> g) {
+  SmallVector<double, 18> gg(w.alpha * 3, 0);
+  for (int64_t i = 0; i < w.alpha; ++i)
+    for (int64_t j = 0; j < 3; ++j)
+      for (int64_t k = 0; k < 3; ++k)
+        gg[i * 3 + j] += w.G[i][k] * g[k * 3 + j];
+  SmallVector<double, 36> u(w.alpha * w.alpha, 0);
+  for (int64_t i = 0; i < w.alpha; ++i)
+    for (int64_t j = 0; j < w.alpha; ++j)
+      for (int64_t k = 0; k < 3; ++k)
+        u[i * w.alpha + j] += gg[i * 3 + k] * w.G[j][k];
+  return u;
+}
+
+/// Creates a floating point constant of `type`, which is a float or a vector
+/// of floats.
+Value createFloatConstant(OpBuilder &builder, Location loc, Type type,
+                          double value) {
+  if (auto vecTy = type.dyn_cast<VectorType>())
+    return builder.create<arith::ConstantOp>(
+        loc, vecTy,
+        DenseElementsAttr::get(
+            vecTy, builder.getFloatAttr(vecTy.getElementType(), value)));
+  return builder.create<arith::ConstantOp>(loc,
+                                           builder.getFloatAttr(type, value));
+}
+
+/// Returns sum_j coeffs[j] * values[j]. Zero coefficients are skipped and unit
+/// coefficients become plain additions and subtractions.
+Value combine(OpBuilder &builder, Location loc, ArrayRef<Value> values,
+              ArrayRef<double> coeffs) {
+  Type type = values.front().getType();
+  Value acc;
+  for (size_t j = 0; j < values.size(); ++j) {
+    double c = coeffs[j];
+    if (c == 0)
+      continue;
+    if (c == 1 || c == -1) {
+      if (!acc)
+        acc = c == 1 ? values[j]
+                     : Value(builder.create<arith::NegFOp>(loc, values[j]));
+      else if (c == 1)
+        acc = builder.create<arith::AddFOp>(loc, acc, values[j]);
+      else
+        acc = builder.create<arith::SubFOp>(loc, acc, values[j]);
+      continue;
+    }
+    Value term = builder.create<arith::MulFOp>(
+        loc, createFloatConstant(builder, loc, type, c), values[j]);
+    acc = acc ? Value(builder.create<arith::AddFOp>(loc, acc, term)) : term;
+  }
+  return acc ? acc : createFloatConstant(builder, loc, type, 0);
+}
+
+/// Left-multiplies the matrix given by its row vectors with `mat`.
+SmallVector<Value> transformRows(OpBuilder &builder, Location loc,
+                                 ArrayRef<Value> rows, const Matrix &mat) {
+  SmallVector<Value> result;
+  for (const SmallVector<double, 6> &coeffs : mat)
+    result.push_back(combine(builder, loc, rows, coeffs));
+  return result;
+}
+
+/// Transposes the matrix given by its row vectors.
+SmallVector<Value> transposeRows(OpBuilder &builder, Location loc,
+                                 ArrayRef<Value> rows) {
+  auto rowTy = rows.front().getType().cast<VectorType>();
+  int64_t numRows = rows.size();
+  int64_t numCols = rowTy.getDimSize(0);
+  Type elemTy = rowTy.getElementType();
+  Value mat = createFloatConstant(
+      builder, loc, VectorType::get({numRows, numCols}, elemTy), 0);
+  for (int64_t i = 0; i < numRows; ++i)
+    mat = builder.create<vector::InsertOp>(loc, rows[i], mat,
+                                           ArrayRef<int64_t>{i});
+  Value transposed = builder.create<vector::TransposeOp>(
+      loc, mat, ArrayRef<int64_t>{1, 0});
+  SmallVector<Value> result;
+  for (int64_t j = 0; j < numCols; ++j)
+    result.push_back(builder.create<vector::ExtractOp>(loc, transposed,
+                                                       ArrayRef<int64_t>{j}));
+  return result;
+}
+
+//===----------------------------------------------------------------------===//
+// Rewrite Pattern
+//===----------------------------------------------------------------------===//
+
+template <typename ConvOpTy>
+class ConvWinogradPattern : public ConversionPattern {
+public:
+  explicit ConvWinogradPattern(MLIRContext *context, int64_t tileSizeParam)
+      : ConversionPattern(ConvOpTy::getOperationName(), 1, context) {
+    tileSize = tileSizeParam;
+  }
+
+  LogicalResult
+  matchAndRewrite(Operation *op, ArrayRef<Value> /*operands*/,
+                  ConversionPatternRewriter &rewriter) const override {
+    auto convOp = cast<ConvOpTy>(op);
+    auto loc = op->getLoc();
+    constexpr bool isNchw = std::is_same_v<ConvOpTy, linalg::Conv2DNchwFchwOp>;
+
+    Value input = op->getOperand(0);
+    Value filter = op->getOperand(1);
+    Value output = op->getOperand(2);
+
+    auto inputTy = input.getType().dyn_cast<MemRefType>();
+    auto filterTy = filter.getType().dyn_cast<MemRefType>();
+    auto outputTy = output.getType().dyn_cast<MemRefType>();
+    if (!inputTy || !filterTy || !outputTy)
+      return failure();
+    Type elemTy = inputTy.getElementType();
+    if (!elemTy.isF32() || filterTy.getElementType() != elemTy ||
+        outputTy.getElementType() != elemTy)
+      return failure();
+
+    // Only 3x3, stride 1, dilation 1 convolutions are eligible.
+    for (int64_t s : convOp.getStrides().template getValues<int64_t>())
+      if (s != 1)
+        return failure();
+    for (int64_t d : convOp.getDilations().template getValues<int64_t>())
+      if (d != 1)
+        return failure();
+    int64_t khDim = isNchw ? 2 : 0;
+    if (filterTy.getDimSize(khDim) != 3 || filterTy.getDimSize(khDim + 1) != 3)
+      return failure();
+
+    const WinogradMatrices w = getWinogradMatrices(tileSize);
+    const int64_t m = w.m;
+    const int64_t alpha = w.alpha;
+    VectorType inRowTy = VectorType::get(alpha, elemTy);
+    VectorType outRowTy = VectorType::get(m, elemTy);
+
+    const AffineExpr d0 = rewriter.getAffineDimExpr(0);
+    const AffineExpr s0 = rewriter.getAffineSymbolExpr(0);
+
+    const Value c0 =
+        rewriter.create<arith::ConstantOp>(loc, rewriter.getIndexAttr(0));
+    const Value c1 =
+        rewriter.create<arith::ConstantOp>(loc, rewriter.getIndexAttr(1));
+    const Value zeroElem =
+        rewriter.create<arith::ConstantOp>(loc, rewriter.getF32FloatAttr(0.));
+    const Value zeroRow = createFloatConstant(rewriter, loc, inRowTy, 0);
+
+    // Dims
+    int64_t hDim = isNchw ? 2 : 1;
+    int64_t wDim = isNchw ? 3 : 2;
+    int64_t cDim = isNchw ? 1 : 3;
+    Value batch = rewriter.create<memref::DimOp>(loc, output, 0);
+    Value inRows = rewriter.create<memref::DimOp>(loc, input, hDim);
+    Value outRows = rewriter.create<memref::DimOp>(loc, output, hDim);
+    Value outCols = rewriter.create<memref::DimOp>(loc, output, wDim);
+    Value inChannels = rewriter.create<memref::DimOp>(loc, input, cDim);
+    Value outChannels = rewriter.create<memref::DimOp>(loc, output, cDim);
+    Value lastInRow = rewriter.create<affine::AffineApplyOp>(
+        loc, AffineMap::get(1, 0, d0 - 1), ValueRange{inRows});
+    Value tileRows = rewriter.create<affine::AffineApplyOp>(
+        loc, AffineMap::get(1, 0, d0.ceilDiv(m)), ValueRange{outRows});
+    Value tileCols = rewriter.create<affine::AffineApplyOp>(
+        loc, AffineMap::get(1, 0, d0.ceilDiv(m)), ValueRange{outCols});
+    Value tilesPerImage =
+        rewriter.create<arith::MulIOp>(loc, tileRows, tileCols);
+    Value numTiles = rewriter.create<arith::MulIOp>(loc, batch, tilesPerImage);
+
+    // Row vectors run along the width dimension.
+    AffineMap rowMap = AffineMap::get(4, 0, {rewriter.getAffineDimExpr(wDim)},
+                                      rewriter.getContext());
+    auto indices = [&](Value n, Value c, Value h, Value wIdx) {
+      return isNchw ? SmallVector<Value, 4>{n, c, h, wIdx}
+                    : SmallVector<Value, 4>{n, h, wIdx, c};
+    };
+    auto tileIndex = [&](OpBuilder &builder, Location loc, Value n, Value th,
+                         Value tw) -> Value {
+      Value t = builder.create<arith::MulIOp>(loc, n, tileRows);
+      t = builder.create<arith::AddIOp>(loc, t, th);
+      t = builder.create<arith::MulIOp>(loc, t, tileCols);
+      return builder.create<arith::AddIOp>(loc, t, tw);
+    };
+
+    // Step 1: Filter transform U[alpha * alpha][K][C].
+    MemRefType transformedFilterTy = MemRefType::get(
+        {alpha * alpha, ShapedType::kDynamic, ShapedType::kDynamic}, elemTy);
+    Value transformedFilter = foldConstantFilter(rewriter, op, filter, w);
+    bool filterIsAllocated = !transformedFilter;
+    if (!transformedFilter) {
+      transformedFilter = rewriter.create<memref::AllocOp>(
+          loc, transformedFilterTy, ValueRange{outChannels, inChannels});
+      rewriter.create<scf::ParallelOp>(
+          loc, ValueRange{c0, c0}, ValueRange{outChannels, inChannels},
+          ValueRange{c1, c1},
+          [&](OpBuilder &builder, Location loc, ValueRange ivs) {
+            Value ivK = ivs[0];
+            Value ivC = ivs[1];
+            // The filter rows are transformed as scalars, once per call.
+            SmallVector<Value> g;
+            for (int64_t i = 0; i < 3; ++i)
+              for (int64_t j = 0; j < 3; ++j) {
+                Value ci = builder.create<arith::ConstantOp>(
+                    loc, builder.getIndexAttr(i));
+                Value cj = builder.create<arith::ConstantOp>(
+                    loc, builder.getIndexAttr(j));
+                SmallVector<Value, 4> filterIndices =
+                    isNchw ? SmallVector<Value, 4>{ivK, ivC, ci, cj}
+                           : SmallVector<Value, 4>{ci, cj, ivC, ivK};
+                g.push_back(
+                    builder.create<memref::LoadOp>(loc, filter, filterIndices));
+              }
+            for (int64_t i = 0; i < alpha; ++i) {
+              SmallVector<Value, 3> gg;
+              for (int64_t j = 0; j < 3; ++j)
+                gg.push_back(combine(builder, loc, {g[j], g[3 + j], g[6 + j]},
+                                     w.G[i]));
+              for (int64_t j = 0; j < alpha; ++j) {
+                Value u = combine(builder, loc, gg, w.G[j]);
+                Value e = builder.create<arith::ConstantOp>(
+                    loc, builder.getIndexAttr(i * alpha + j));
+                builder.create<memref::StoreOp>(loc, u, transformedFilter,
+                                                ValueRange{e, ivK, ivC});
+              }
+            }
+          });
+    }
+
+    // Step 2: Input transform V[alpha * alpha][C][P].
+    MemRefType transformedInputTy = MemRefType::get(
+        {alpha * alpha, ShapedType::kDynamic, ShapedType::kDynamic}, elemTy);
+    Value transformedInput = rewriter.create<memref::AllocOp>(
+        loc, transformedInputTy, ValueRange{inChannels, numTiles});
+    rewriter.create<scf::ParallelOp>(
+        loc, ValueRange{c0, c0, c0}, ValueRange{batch, tileRows, tileCols},
+        ValueRange{c1, c1, c1},
+        [&](OpBuilder &builder, Location loc, ValueRange ivs) {
+          Value ivN = ivs[0];
+          Value ivTH = ivs[1];
+          Value ivTW = ivs[2];
+          Value tile = tileIndex(builder, loc, ivN, ivTH, ivTW);
+          Value col = builder.create<affine::AffineApplyOp>(
+              loc, AffineMap::get(1, 0, d0 * m), ValueRange{ivTW});
+          builder.create<scf::ForOp>(
+              loc, c0, inChannels, c1, std::nullopt,
+              [&](OpBuilder &builder, Location loc, Value ivC, ValueRange) {
+                SmallVector<Value> patch;
+                for (int64_t r = 0; r < alpha; ++r) {
+                  // Rows below the image read as zero, columns past the
+                  // image are padded by the transfer read.
+                  Value row = builder.create<affine::AffineApplyOp>(
+                      loc, AffineMap::get(1, 0, d0 * m + r), ValueRange{ivTH});
+                  Value clamped = builder.create<affine::AffineMinOp>(
+                      loc, AffineMap::get(1, 1, {d0, s0}, builder.getContext()),
+                      ValueRange{row, lastInRow});
+                  Value vec = builder.create<vector::TransferReadOp>(
+                      loc, inRowTy, input, indices(ivN, ivC, clamped, col),
+                      rowMap);
+                  Value inside = builder.create<arith::CmpIOp>(
+                      loc, arith::CmpIPredicate::ult, row, inRows);
+                  patch.push_back(
+                      builder.create<arith::SelectOp>(loc, inside, vec, zeroRow));
+                }
+                // W = B^T (B^T d)^T = (B^T d B)^T
+                SmallVector<Value> t = transformRows(builder, loc, patch, w.BT);
+                SmallVector<Value> v =
+                    transformRows(builder, loc, transposeRows(builder, loc, t),
+                                  w.BT);
+                for (int64_t nu = 0; nu < alpha; ++nu)
+                  for (int64_t xi = 0; xi < alpha; ++xi) {
+                    Value elem = builder.create<vector::ExtractOp>(
+                        loc, v[nu], ArrayRef<int64_t>{xi});
+                    Value e = builder.create<arith::ConstantOp>(
+                        loc, builder.getIndexAttr(xi * alpha + nu));
+                    builder.create<memref::StoreOp>(loc, elem, transformedInput,
+                                                    ValueRange{e, ivC, tile});
+                  }
+                builder.create<scf::YieldOp>(loc);
+              });
+        });
+
+    // Step 3: Batched GEMM M[e] = U[e] x V[e] for every transform position.
+    Value gemmOutput = rewriter.create<memref::AllocOp>(
+        loc, transformedInputTy, ValueRange{outChannels, numTiles});
+    rewriter.create<linalg::FillOp>(loc, ValueRange{zeroElem},
+                                    ValueRange{gemmOutput});
+    rewriter.create<linalg::BatchMatmulOp>(
+        loc, ValueRange{transformedFilter, transformedInput},
+        ValueRange{gemmOutput});
+
+    // Step 4: Output transform Y = A^T M A, accumulated into the output.
+    rewriter.create<scf::ParallelOp>(
+        loc, ValueRange{c0, c0, c0}, ValueRange{batch, tileRows, tileCols},
+        ValueRange{c1, c1, c1},
+        [&](OpBuilder &builder, Location loc, ValueRange ivs) {
+          Value ivN = ivs[0];
+          Value ivTH = ivs[1];
+          Value ivTW = ivs[2];
+          Value tile = tileIndex(builder, loc, ivN, ivTH, ivTW);
+          Value col = builder.create<affine::AffineApplyOp>(
+              loc, AffineMap::get(1, 0, d0 * m), ValueRange{ivTW});
+          builder.create<scf::ForOp>(
+              loc, c0, outChannels, c1, std::nullopt,
+              [&](OpBuilder &builder, Location loc, Value ivK, ValueRange) {
+                SmallVector<Value> rows;
+                for (int64_t xi = 0; xi < alpha; ++xi) {
+                  Value row = zeroRow;
+                  for (int64_t nu = 0; nu < alpha; ++nu) {
+                    Value e = builder.create<arith::ConstantOp>(
+                        loc, builder.getIndexAttr(xi * alpha + nu));
+                    Value elem = builder.create<memref::LoadOp>(
+                        loc, gemmOutput, ValueRange{e, ivK, tile});
+                    row = builder.create<vector::InsertOp>(
+                        loc, elem, row, ArrayRef<int64_t>{nu});
+                  }
+                  rows.push_back(row);
+                }
+                // Y^T = A^T (A^T M)^T, transposed back into output rows.
+                SmallVector<Value> t = transformRows(builder, loc, rows, w.AT);
+                SmallVector<Value> yt = transformRows(
+                    builder, loc, transposeRows(builder, loc, t), w.AT);
+                SmallVector<Value> y = transposeRows(builder, loc, yt);
+                for (int64_t i = 0; i < m; ++i) {
+                  Value row = builder.create<affine::AffineApplyOp>(
+                      loc, AffineMap::get(1, 0, d0 * m + i), ValueRange{ivTH});
+                  Value inside = builder.create<arith::CmpIOp>(
+                      loc, arith::CmpIPredicate::ult, row, outRows);
+                  auto ifOp = builder.create<scf::IfOp>(loc, inside,
+                                                        /*withElseRegion=*/false);
+                  OpBuilder thenBuilder = ifOp.getThenBodyBuilder();
+                  SmallVector<Value, 4> outIndices =
+                      indices(ivN, ivK, row, col);
+                  // Columns past the image are masked by the transfers.
+                  Value bias = thenBuilder.create<vector::TransferReadOp>(
+                      loc, outRowTy, output, outIndices, rowMap);
+                  Value sum = thenBuilder.create<arith::AddFOp>(loc, bias, y[i]);
+                  thenBuilder.create<vector::TransferWriteOp>(
+                      loc, sum, output, outIndices, rowMap);
+                }
+                builder.create<scf::YieldOp>(loc);
+              });
+        });
+
+    rewriter.create<memref::DeallocOp>(loc, gemmOutput);
+    rewriter.create<memref::DeallocOp>(loc, transformedInput);
+    if (filterIsAllocated)
+      rewriter.create<memref::DeallocOp>(loc, transformedFilter);
+
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  /// If `filter` is a constant global, transforms it at compile time into a
+  /// new constant global and returns a `memref.get_global` of it.
+  Value foldConstantFilter(ConversionPatternRewriter &rewriter, Operation *op,
+                           Value filter, const WinogradMatrices &w) const {
+    constexpr bool isNchw = std::is_same_v<ConvOpTy, linalg::Conv2DNchwFchwOp>;
+    auto getGlobalOp = filter.getDefiningOp<memref::GetGlobalOp>();
+    if (!getGlobalOp)
+      return nullptr;
+    auto globalOp = SymbolTable::lookupNearestSymbolFrom<memref::GlobalOp>(
+        op, getGlobalOp.getNameAttr());
+    if (!globalOp || !globalOp.getConstant() || !globalOp.getInitialValue())
+      return nullptr;
+    auto dense = globalOp.getInitialValue()->dyn_cast<DenseElementsAttr>();
+    auto filterTy = filter.getType().cast<MemRefType>();
+    if (!dense || !filterTy.hasStaticShape())
+      return nullptr;
+
+    int64_t numK = filterTy.getDimSize(isNchw ? 0 : 3);
+    int64_t numC = filterTy.getDimSize(isNchw ? 1 : 2);
+    int64_t alphaSq = w.alpha * w.alpha;
+    SmallVector<float> values = llvm::to_vector(dense.getValues<float>());
+    SmallVector<float> transformed(alphaSq * numK * numC);
+    for (int64_t k = 0; k < numK; ++k)
+      for (int64_t c = 0; c < numC; ++c) {
+        SmallVector<double, 9> g;
+        for (int64_t i = 0; i < 3; ++i)
+          for (int64_t j = 0; j < 3; ++j)
+            g.push_back(isNchw ? values[((k * numC + c) * 3 + i) * 3 + j]
+                               : values[((i * 3 + j) * numC + c) * numK + k]);
+        SmallVector<double, 36> u = transformFilter(w, g);
+        for (int64_t e = 0; e < alphaSq; ++e)
+          transformed[(e * numK + k) * numC + c] = u[e];
+      }
+
+    MemRefType type =
+        MemRefType::get({alphaSq, numK, numC}, filterTy.getElementType());
+    std::string name = (getGlobalOp.getName() + "_winograd_f" +
+                        std::to_string(w.m))
+                           .str();
+    ModuleOp module = op->getParentOfType<ModuleOp>();
+    if (!SymbolTable::lookupSymbolIn(module, name)) {
+      OpBuilder::InsertionGuard guard(rewriter);
+      rewriter.setInsertionPointToStart(module.getBody());
+      rewriter.create<memref::GlobalOp>(
+          op->getLoc(), name, rewriter.getStringAttr("private"), type,
+          DenseElementsAttr::get(RankedTensorType::get(type.getShape(),
+                                                       type.getElementType()),
+                                 ArrayRef<float>(transformed)),
+          /*constant=*/true, /*alignment=*/IntegerAttr());
+    }
+    return rewriter.create<memref::GetGlobalOp>(op->getLoc(), type, name);
+  }
+
+  int64_t tileSize;
+};
+} // end anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// ConvWinogradPass
+//===----------------------------------------------------------------------===//
+
+namespace {
+class ConvWinogradPass
+    : public PassWrapper<ConvWinogradPass, OperationPass<ModuleOp>> {
+public:
+  MLIR_DEFINE_EXPLICIT_INTERNAL_INLINE_TYPE_ID(ConvWinogradPass)
+  StringRef getArgument() const final { return "conv-winograd"; }
+  StringRef getDescription() const final {
+    return "Winograd F(mxm, 3x3) for 3x3 stride-1 NCHW/NHWC convolutions.";
+  }
+  ConvWinogradPass() = default;
+  ConvWinogradPass(const ConvWinogradPass &) {}
+  explicit ConvWinogradPass(int64_t tileSizeParam) { tileSize = tileSizeParam; }
+
+  void runOnOperation() override;
+
+  void getDependentDialects(DialectRegistry &registry) const override {
+    registry.insert<linalg::LinalgDialect, scf::SCFDialect,
+                    affine::AffineDialect, memref::MemRefDialect,
+                    VectorDialect>();
+  }
+
+  Option<int64_t> tileSize{
+      *this, "tile-size",
+      llvm::cl::desc("Output tile size m of F(mxm, 3x3), either 2 or 4."),
+      llvm::cl::init(4)};
+};
+} // end anonymous namespace.
+
+void ConvWinogradPass::runOnOperation() {
+  MLIRContext *context = &getContext();
+  ModuleOp module = getOperation();
+
+  if (tileSize != 2 && tileSize != 4) {
+    module.emitError("conv-winograd only supports tile-size 2 or 4");
+    return signalPassFailure();
+  }
+
+  ConversionTarget target(*context);
+  target.addLegalDialect<arith::ArithDialect, affine::AffineDialect,
+                         scf::SCFDialect, memref::MemRefDialect,
+                         VectorDialect>();
+  target.addLegalOp<ModuleOp, func::FuncOp, func::ReturnOp>();
+  target.addLegalOp<linalg::FillOp, linalg::BatchMatmulOp>();
+
+  RewritePatternSet patterns(context);
+  patterns.add<ConvWinogradPattern<linalg::Conv2DNchwFchwOp>,
+               ConvWinogradPattern<linalg::Conv2DNhwcHwcfOp>>(context,
+                                                              tileSize);
+
+  if (failed(applyPartialConversion(module, target, std::move(patterns))))
+    signalPassFailure();
+}
+
+namespace mlir {
+namespace buddy {
+void registerConvWinogradPass() { PassRegistration<ConvWinogradPass>(); }
+} // namespace buddy
+} // namespace mlir
@@ -25,6 +25,7 @@
 #include "mlir/Dialect/Linalg/Transforms/Transforms.h"
 #include "mlir/Dialect/Math/IR/Math.h"
 #include "mlir/Dialect/MemRef/IR/MemRef.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
 #include "mlir/Dialect/Vector/IR/VectorOps.h"
 #include "mlir/Pass/Pass.h"
 
@@ -231,6 +232,310 @@ void populateCBTilingPattern(Operation *op, ArrayRef<int64_t> tileSizes,
   rewriter.eraseOp(op);
 }
 
+// Returns the number of register accumulators to use for a dimension of size
+// `dimSize`: the largest divisor of the (static) dimension not exceeding
+// `limit`, so that no accumulator block needs a tail.
+static int64_t getRegisterBlock(int64_t dimSize, int64_t limit) {
+  if (ShapedType::isDynamic(dimSize))
+    return 1;
+  for (int64_t block = std::min(dimSize, limit); block > 1; --block)
+    if (dimSize % block == 0)
+      return block;
+  return 1;
+}
+
+// Multichannel CB for `linalg.conv_2d_nchw_fchw`.
+// The output row is strip-mined with `stride` lanes, each input vector is
+// multiplied by `fBlock` broadcast filter coefficients and the `fBlock` output
+// channels are accumulated in registers across the input channels and the
+// kernel window.
+void populateCBNchwFchwPattern(Operation *op, int64_t stride,
+                               int64_t registerBlock,
+                               ConversionPatternRewriter &rewriter) {
+  auto loc = op->getLoc();
+  auto ctx = op->getContext();
+  // Get input, kernel and output.
+  Value input = op->getOperand(0);
+  Value kernel = op->getOperand(1);
+  Value output = op->getOperand(2);
+  MemRefType outputTy = output.getType().cast<MemRefType>();
+  FloatType elemTy = outputTy.getElementType().cast<FloatType>();
+  // Strides and dilations.
+  auto strides = op->getAttrOfType<DenseIntElementsAttr>("strides")
+                     .getValues<int64_t>();
+  auto dilations = op->getAttrOfType<DenseIntElementsAttr>("dilations")
+                       .getValues<int64_t>();
+  int64_t strHeight = strides[0];
+  int64_t strWidth = strides[1];
+  int64_t dilHeight = dilations[0];
+  int64_t dilWidth = dilations[1];
+  // Number of output channels accumulated in registers.
+  int64_t fBlock = getRegisterBlock(outputTy.getDimSize(1), registerBlock);
+  // Define `*Type`.
+  VectorType vectorTy = VectorType::get({stride}, elemTy);
+  VectorType vectorMaskTy = VectorType::get({stride}, rewriter.getI1Type());
+  VectorType offsetTy = VectorType::get({stride}, rewriter.getI32Type());
+  // Create constant index.
+  Value c0 = rewriter.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = rewriter.create<arith::ConstantIndexOp>(loc, 1);
+  Value cStride = rewriter.create<arith::ConstantIndexOp>(loc, stride);
+  Value cFBlock = rewriter.create<arith::ConstantIndexOp>(loc, fBlock);
+  Value f0 = rewriter.create<arith::ConstantFloatOp>(
+      loc, APFloat::getZero(elemTy.getFloatSemantics()), elemTy);
+  // Create pass through vector.
+  Value passThroughVec = rewriter.create<SplatOp>(loc, vectorTy, f0);
+  // Lane offsets of a strided input row.
+  SmallVector<int32_t> laneOffsets;
+  for (int64_t i = 0; i < stride; ++i)
+    laneOffsets.push_back(i * strWidth);
+  Value laneOffsetVec = rewriter.create<arith::ConstantOp>(
+      loc, DenseElementsAttr::get(offsetTy, ArrayRef<int32_t>(laneOffsets)));
+  // Create DimOp.
+  Value batch = rewriter.create<memref::DimOp>(loc, output, 0);
+  Value outChannels = rewriter.create<memref::DimOp>(loc, output, 1);
+  Value outputRow = rewriter.create<memref::DimOp>(loc, output, 2);
+  Value outputCol = rewriter.create<memref::DimOp>(loc, output, 3);
+  Value inChannels = rewriter.create<memref::DimOp>(loc, kernel, 1);
+  Value kernelRow = rewriter.create<memref::DimOp>(loc, kernel, 2);
+  Value kernelCol = rewriter.create<memref::DimOp>(loc, kernel, 3);
+  AffineExpr d0, d1;
+  bindDims(ctx, d0, d1);
+  AffineMap inputRowMap = AffineMap::get(2, 0, d0 * strHeight + d1 * dilHeight);
+  AffineMap inputColMap = AffineMap::get(2, 0, d0 * strWidth + d1 * dilWidth);
+  AffineMap addMap = AffineMap::get(2, 0, d0 + d1);
+
+  rewriter.create<scf::ParallelOp>(
+      loc, ValueRange{c0, c0, c0}, ValueRange{batch, outChannels, outputRow},
+      ValueRange{c1, cFBlock, c1},
+      [&](OpBuilder &builder, Location loc, ValueRange ivs) {
+        Value n = ivs[0];
+        Value f = ivs[1];
+        Value oh = ivs[2];
+        SmallVector<Value> fIdx;
+        for (int64_t i = 0; i < fBlock; ++i)
+          fIdx.push_back(builder.create<affine::AffineApplyOp>(
+              loc, addMap,
+              ValueRange{f, builder.create<arith::ConstantIndexOp>(loc, i)}));
+        // Strip mining loop over the output row.
+        builder.create<scf::ForOp>(
+            loc, c0, outputCol, cStride, std::nullopt,
+            [&](OpBuilder &builder, Location loc, Value ow, ValueRange) {
+              // Create mask according to the tail.
+              Value tail = builder.create<arith::SubIOp>(loc, outputCol, ow);
+              Value tailMask =
+                  builder.create<CreateMaskOp>(loc, vectorMaskTy, tail);
+              SmallVector<Value> accs;
+              for (int64_t i = 0; i < fBlock; ++i)
+                accs.push_back(builder.create<MaskedLoadOp>(
+                    loc, vectorTy, output, ValueRange{n, fIdx[i], oh, ow},
+                    tailMask, passThroughVec));
+              // Accumulate the input channels and the kernel window.
+              auto cLoop = builder.create<scf::ForOp>(
+                  loc, c0, inChannels, c1, accs,
+                  [&](OpBuilder &builder, Location loc, Value c,
+                      ValueRange cArgs) {
+                    auto khLoop = builder.create<scf::ForOp>(
+                        loc, c0, kernelRow, c1, cArgs,
+                        [&](OpBuilder &builder, Location loc, Value kh,
+                            ValueRange khArgs) {
+                          Value ih = builder.create<affine::AffineApplyOp>(
+                              loc, inputRowMap, ValueRange{oh, kh});
+                          auto kwLoop = builder.create<scf::ForOp>(
+                              loc, c0, kernelCol, c1, khArgs,
+                              [&](OpBuilder &builder, Location loc, Value kw,
+                                  ValueRange kwArgs) {
+                                Value iw =
+                                    builder.create<affine::AffineApplyOp>(
+                                        loc, inputColMap, ValueRange{ow, kw});
+                                Value inputVec;
+                                if (strWidth == 1)
+                                  inputVec = builder.create<MaskedLoadOp>(
+                                      loc, vectorTy, input,
+                                      ValueRange{n, c, ih, iw}, tailMask,
+                                      passThroughVec);
+                                else
+                                  inputVec = builder.create<GatherOp>(
+                                      loc, vectorTy, input,
+                                      ValueRange{n, c, ih, iw}, laneOffsetVec,
+                                      tailMask, passThroughVec);
+                                // Broadcast the coefficients of the kernel.
+                                SmallVector<Value> results;
+                                for (int64_t i = 0; i < fBlock; ++i) {
+                                  Value kernelValue =
+                                      builder.create<memref::LoadOp>(
+                                          loc, kernel,
+                                          ValueRange{fIdx[i], c, kh, kw});
+                                  Value kernelVec =
+                                      builder.create<vector::BroadcastOp>(
+                                          loc, vectorTy, kernelValue);
+                                  results.push_back(builder.create<FMAOp>(
+                                      loc, inputVec, kernelVec, kwArgs[i]));
+                                }
+                                builder.create<scf::YieldOp>(loc, results);
+                              });
+                          builder.create<scf::YieldOp>(loc,
+                                                       kwLoop.getResults());
+                        });
+                    builder.create<scf::YieldOp>(loc, khLoop.getResults());
+                  });
+              // Masked store the results to output.
+              for (int64_t i = 0; i < fBlock; ++i)
+                builder.create<MaskedStoreOp>(
+                    loc, output, ValueRange{n, fIdx[i], oh, ow}, tailMask,
+                    cLoop.getResult(i));
+              builder.create<scf::YieldOp>(loc);
+            });
+      });
+  // Remove the origin convolution operation.
+  rewriter.eraseOp(op);
+}
+
+// Multichannel CB for `linalg.conv_2d_nhwc_hwcf`.
+// The output channels are strip-mined with `stride` lanes, each input element
+// is broadcast against a filter vector and `wBlock` output columns are
+// accumulated in registers across the input channels and the kernel window.
+void populateCBNhwcHwcfPattern(Operation *op, int64_t stride,
+                               int64_t registerBlock,
+                               ConversionPatternRewriter &rewriter) {
+  auto loc = op->getLoc();
+  auto ctx = op->getContext();
+  // Get input, kernel and output.
+  Value input = op->getOperand(0);
+  Value kernel = op->getOperand(1);
+  Value output = op->getOperand(2);
+  MemRefType outputTy = output.getType().cast<MemRefType>();
+  FloatType elemTy = outputTy.getElementType().cast<FloatType>();
+  // Strides and dilations.
+  auto strides = op->getAttrOfType<DenseIntElementsAttr>("strides")
+                     .getValues<int64_t>();
+  auto dilations = op->getAttrOfType<DenseIntElementsAttr>("dilations")
+                       .getValues<int64_t>();
+  int64_t strHeight = strides[0];
+  int64_t strWidth = strides[1];
+  int64_t dilHeight = dilations[0];
+  int64_t dilWidth = dilations[1];
+  // Number of output columns accumulated in registers.
+  int64_t wBlock = getRegisterBlock(outputTy.getDimSize(2), registerBlock);
+  // Define `*Type`.
+  VectorType vectorTy = VectorType::get({stride}, elemTy);
+  VectorType vectorMaskTy = VectorType::get({stride}, rewriter.getI1Type());
+  // Create constant index.
+  Value c0 = rewriter.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = rewriter.create<arith::ConstantIndexOp>(loc, 1);
+  Value cStride = rewriter.create<arith::ConstantIndexOp>(loc, stride);
+  Value cWBlock = rewriter.create<arith::ConstantIndexOp>(loc, wBlock);
+  Value f0 = rewriter.create<arith::ConstantFloatOp>(
+      loc, APFloat::getZero(elemTy.getFloatSemantics()), elemTy);
+  // Create pass through vector.
+  Value passThroughVec = rewriter.create<SplatOp>(loc, vectorTy, f0);
+  // Create DimOp.
+  Value batch = rewriter.create<memref::DimOp>(loc, output, 0);
+  Value outputRow = rewriter.create<memref::DimOp>(loc, output, 1);
+  Value outputCol = rewriter.create<memref::DimOp>(loc, output, 2);
+  Value outChannels = rewriter.create<memref::DimOp>(loc, output, 3);
+  Value kernelRow = rewriter.create<memref::DimOp>(loc, kernel, 0);
+  Value kernelCol = rewriter.create<memref::DimOp>(loc, kernel, 1);
+  Value inChannels = rewriter.create<memref::DimOp>(loc, kernel, 2);
+  AffineExpr d0, d1, d2;
+  bindDims(ctx, d0, d1, d2);
+  AffineMap inputRowMap = AffineMap::get(2, 0, d0 * strHeight + d1 * dilHeight);
+  AffineMap addMap = AffineMap::get(2, 0, d0 + d1);
+
+  rewriter.create<scf::ParallelOp>(
+      loc, ValueRange{c0, c0}, ValueRange{batch, outputRow}, ValueRange{c1, c1},
+      [&](OpBuilder &builder, Location loc, ValueRange ivs) {
+        Value n = ivs[0];
+        Value oh = ivs[1];
+        builder.create<scf::ForOp>(
+            loc, c0, outputCol, cWBlock, std::nullopt,
+            [&](OpBuilder &builder, Location loc, Value ow, ValueRange) {
+              SmallVector<Value> owIdx;
+              for (int64_t j = 0; j < wBlock; ++j)
+                owIdx.push_back(builder.create<affine::AffineApplyOp>(
+                    loc, addMap,
+                    ValueRange{ow,
+                               builder.create<arith::ConstantIndexOp>(loc, j)}));
+              // Strip mining loop over the output channels.
+              builder.create<scf::ForOp>(
+                  loc, c0, outChannels, cStride, std::nullopt,
+                  [&](OpBuilder &builder, Location loc, Value f, ValueRange) {
+                    // Create mask according to the tail.
+                    Value tail =
+                        builder.create<arith::SubIOp>(loc, outChannels, f);
+                    Value tailMask =
+                        builder.create<CreateMaskOp>(loc, vectorMaskTy, tail);
+                    SmallVector<Value> accs;
+                    for (int64_t j = 0; j < wBlock; ++j)
+                      accs.push_back(builder.create<MaskedLoadOp>(
+                          loc, vectorTy, output,
+                          ValueRange{n, oh, owIdx[j], f}, tailMask,
+                          passThroughVec));
+                    // Accumulate the kernel window and the input channels.
+                    auto khLoop = builder.create<scf::ForOp>(
+                        loc, c0, kernelRow, c1, accs,
+                        [&](OpBuilder &builder, Location loc, Value kh,
+                            ValueRange khArgs) {
+                          Value ih = builder.create<affine::AffineApplyOp>(
+                              loc, inputRowMap, ValueRange{oh, kh});
+                          auto kwLoop = builder.create<scf::ForOp>(
+                              loc, c0, kernelCol, c1, khArgs,
+                              [&](OpBuilder &builder, Location loc, Value kw,
+                                  ValueRange kwArgs) {
+                                SmallVector<Value> iwIdx;
+                                for (int64_t j = 0; j < wBlock; ++j)
+                                  iwIdx.push_back(
+                                      builder.create<affine::AffineApplyOp>(
+                                          loc,
+                                          AffineMap::get(2, 0,
+                                                         (d0 + j) * strWidth +
+                                                             d1 * dilWidth),
+                                          ValueRange{ow, kw}));
+                                auto cLoop = builder.create<scf::ForOp>(
+                                    loc, c0, inChannels, c1, kwArgs,
+                                    [&](OpBuilder &builder, Location loc,
+                                        Value c, ValueRange cArgs) {
+                                      Value kernelVec =
+                                          builder.create<MaskedLoadOp>(
+                                              loc, vectorTy, kernel,
+                                              ValueRange{kh, kw, c, f},
+                                              tailMask, passThroughVec);
+                                      // Broadcast the input elements.
+                                      SmallVector<Value> results;
+                                      for (int64_t j = 0; j < wBlock; ++j) {
+                                        Value inputValue =
+                                            builder.create<memref::LoadOp>(
+                                                loc, input,
+                                                ValueRange{n, ih, iwIdx[j], c});
+                                        Value inputVec =
+                                            builder.create<vector::BroadcastOp>(
+                                                loc, vectorTy, inputValue);
+                                        results.push_back(builder.create<FMAOp>(
+                                            loc, inputVec, kernelVec,
+                                            cArgs[j]));
+                                      }
+                                      builder.create<scf::YieldOp>(loc,
+                                                                   results);
+                                    });
+                                builder.create<scf::YieldOp>(
+                                    loc, cLoop.getResults());
+                              });
+                          builder.create<scf::YieldOp>(loc,
+                                                       kwLoop.getResults());
+                        });
+                    // Masked store the results to output.
+                    for (int64_t j = 0; j < wBlock; ++j)
+                      builder.create<MaskedStoreOp>(
+                          loc, output, ValueRange{n, oh, owIdx[j], f}, tailMask,
+                          khLoop.getResult(j));
+                    builder.create<scf::YieldOp>(loc);
+                  });
+              builder.create<scf::YieldOp>(loc);
+            });
+      });
+  // Remove the origin convolution operation.
+  rewriter.eraseOp(op);
+}
+
 //===----------------------------------------------------------------------===//
 // Rewrite Pattern
 //===----------------------------------------------------------------------===//
@@ -259,6 +564,38 @@ private:
   int64_t stride;
   ArrayRef<int64_t> tileSizes;
 };
+
+// Multichannel CB pattern for `linalg.conv_2d_nchw_fchw` and
+// `linalg.conv_2d_nhwc_hwcf`.
+template <typename ConvOpTy>
+class CBConvMultiChannelVectorizationPattern : public ConversionPattern {
+public:
+  explicit CBConvMultiChannelVectorizationPattern(MLIRContext *context,
+                                                  int64_t strideParam,
+                                                  int64_t registerBlockParam)
+      : ConversionPattern(ConvOpTy::getOperationName(), 1, context) {
+    stride = strideParam;
+    registerBlock = registerBlockParam;
+  }
+
+  LogicalResult
+  matchAndRewrite(Operation *op, ArrayRef<Value> operands,
+                  ConversionPatternRewriter &rewriter) const override {
+    // Only memref convolutions with a float element type are vectorized.
+    auto outputTy = op->getOperand(2).getType().dyn_cast<MemRefType>();
+    if (!outputTy || !outputTy.getElementType().isa<FloatType>())
+      return failure();
+    if (std::is_same_v<ConvOpTy, linalg::Conv2DNchwFchwOp>)
+      populateCBNchwFchwPattern(op, stride, registerBlock, rewriter);
+    else
+      populateCBNhwcHwcfPattern(op, stride, registerBlock, rewriter);
+    return success();
+  }
+
+private:
+  int64_t stride;
+  int64_t registerBlock;
+};
 } // end anonymous namespace
 
 //===----------------------------------------------------------------------===//
@@ -296,6 +633,12 @@ public:
                          llvm::cl::init(32)};
   ListOption<int64_t> tile{*this, "tile-sizes", llvm::cl::desc("Tile sizes."),
                            llvm::cl::ZeroOrMore};
+  Option<int64_t> registerBlock{
+      *this, "register-block",
+      llvm::cl::desc("Number of accumulators kept in registers by the "
+                     "multichannel convolutions (output channels for NCHW, "
+                     "output columns for NHWC)."),
+      llvm::cl::init(4)};
 };
 } // end anonymous namespace.
 
@@ -313,6 +656,10 @@ void ConvVectorizationPass::runOnOperation() {
 
   RewritePatternSet patterns(context);
   patterns.add<CBConvVectorizationPattern>(context, stride, tile);
+  patterns.add<
+      CBConvMultiChannelVectorizationPattern<linalg::Conv2DNchwFchwOp>,
+      CBConvMultiChannelVectorizationPattern<linalg::Conv2DNhwcHwcfOp>>(
+      context, stride, registerBlock);
 
   if (failed(applyPartialConversion(module, target, std::move(patterns))))
     signalPassFailure();
@@ -0,0 +1,455 @@
+//====- DepthwiseConvVectorization.cpp ------------------------------------===//
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements the depthwise convolution vectorization.
+//
+// - NHWC (`linalg.depthwise_conv_2d_nhwc_hwc` and the channel multiplier
+//   form `linalg.depthwise_conv_2d_nhwc_hwcm` emitted by tosa-to-linalg) is
+//   vectorized across channels. Every filter vector is reused for a block of
+//   `width-block` output pixels kept in registers. The multiplier dimension of
+//   the HWCM filter and output is collapsed into the channel dimension, so
+//   output channel `q` reads input channel `q / multiplier` with a gather.
+// - NCHW (`linalg.depthwise_conv_2d_nchw_chw`) is vectorized across output
+//   columns, with gathers for strided layers.
+//
+// Channel and column tails are handled by the out-of-bounds masking of the
+// vector transfers. The outer loops are `scf.parallel` over batch and output
+// rows (and channels for NCHW). As in linalg, the input is expected to be
+// already padded, so any padding is handled by the producer of the input.
+//
+//===----------------------------------------------------------------------===//
+
+#include <mlir/Dialect/Affine/IR/AffineOps.h>
+#include <mlir/Dialect/Arith/IR/Arith.h>
+#include <mlir/Dialect/Func/IR/FuncOps.h>
+#include <mlir/Dialect/Linalg/IR/Linalg.h>
+#include <mlir/Dialect/Linalg/Transforms/Transforms.h>
+#include <mlir/Dialect/MemRef/IR/MemRef.h>
+#include <mlir/Dialect/SCF/IR/SCF.h>
+#include <mlir/Dialect/Vector/IR/VectorOps.h>
+#include <mlir/IR/BuiltinAttributes.h>
+#include <mlir/IR/BuiltinTypes.h>
+#include <mlir/Pass/Pass.h>
+
+using namespace mlir;
+using namespace vector;
+
+//===----------------------------------------------------------------------===//
+// Rewrite Pattern
+//===----------------------------------------------------------------------===//
+
+namespace {
+
+// DepthwiseConv2DNhwcHwc(m) vectorization pattern
+template <typename DepthwiseOpTy>
+class DepthwiseConvNhwcVectorizationPattern : public ConversionPattern {
+public:
+  explicit DepthwiseConvNhwcVectorizationPattern(MLIRContext *context,
+                                                 int64_t vecSizeParam,
+                                                 int64_t widthBlockParam)
+      : ConversionPattern(DepthwiseOpTy::getOperationName(), 1, context) {
+    vecSize = vecSizeParam;
+    widthBlock = widthBlockParam;
+  }
+
+  LogicalResult
+  matchAndRewrite(Operation *op, ArrayRef<Value> /*operands*/,
+                  ConversionPatternRewriter &rewriter) const override {
+    constexpr bool hasMultiplier =
+        std::is_same_v<DepthwiseOpTy, linalg::DepthwiseConv2DNhwcHwcmOp>;
+    auto loc = op->getLoc();
+    // Get input, kernel and output.
+    Value input = op->getOperand(0);
+    Value kernel = op->getOperand(1);
+    Value output = op->getOperand(2);
+    MemRefType inputTy = dyn_cast<MemRefType>(input.getType());
+    MemRefType kernelTy = dyn_cast<MemRefType>(kernel.getType());
+    MemRefType outputTy = dyn_cast<MemRefType>(output.getType());
+    if (!inputTy || !kernelTy || !outputTy)
+      return failure();
+    // Element type.
+    FloatType fTy = dyn_cast<FloatType>(inputTy.getElementType());
+    if (!fTy || kernelTy.getElementType() != fTy ||
+        outputTy.getElementType() != fTy)
+      return failure();
+    // Strides and dilations.
+    auto strides = op->getAttrOfType<mlir::DenseIntElementsAttr>("strides")
+                       .getValues<int64_t>();
+    auto dilations = op->getAttrOfType<mlir::DenseIntElementsAttr>("dilations")
+                         .getValues<int64_t>();
+    int64_t strH = strides[0], strW = strides[1];
+    int64_t dilH = dilations[0], dilW = dilations[1];
+    // Vector types.
+    VectorType vecTy = VectorType::get({vecSize}, fTy);
+    VectorType maskTy = VectorType::get({vecSize}, rewriter.getI1Type());
+    VectorType idxVecTy = VectorType::get({vecSize}, rewriter.getI32Type());
+    // Constants.
+    Value c0 = rewriter.create<arith::ConstantIndexOp>(loc, 0);
+    Value c1 = rewriter.create<arith::ConstantIndexOp>(loc, 1);
+    Value cVec = rewriter.create<arith::ConstantIndexOp>(loc, vecSize);
+    Value cWidthBlock = rewriter.create<arith::ConstantIndexOp>(loc, widthBlock);
+    Value f0 = rewriter.create<arith::ConstantOp>(
+        loc, rewriter.getFloatAttr(fTy, 0.0));
+    AffineExpr d0, d1;
+    bindDims(rewriter.getContext(), d0, d1);
+    // Collapse the HWCM multiplier into the channel dimension, so that the
+    // filter and output are read as HWC and NHWC with contiguous vectors.
+    Value multiplier;
+    bool unitMultiplier = true;
+    if (hasMultiplier) {
+      SmallVector<ReassociationIndices> kernelDims = {{0}, {1}, {2, 3}};
+      SmallVector<ReassociationIndices> outputDims = {{0}, {1}, {2}, {3, 4}};
+      if (!memref::CollapseShapeOp::isGuaranteedCollapsible(kernelTy,
+                                                            kernelDims) ||
+          !memref::CollapseShapeOp::isGuaranteedCollapsible(outputTy,
+                                                            outputDims))
+        return failure();
+      unitMultiplier = kernelTy.getDimSize(3) == 1;
+      multiplier = rewriter.create<memref::DimOp>(loc, kernel, 3);
+      kernel =
+          rewriter.create<memref::CollapseShapeOp>(loc, kernel, kernelDims);
+      output =
+          rewriter.create<memref::CollapseShapeOp>(loc, output, outputDims);
+    }
+    // Dimensions.
+    Value batch = rewriter.create<memref::DimOp>(loc, output, 0);
+    Value outRows = rewriter.create<memref::DimOp>(loc, output, 1);
+    Value outCols = rewriter.create<memref::DimOp>(loc, output, 2);
+    Value channels = rewriter.create<memref::DimOp>(loc, output, 3);
+    Value kRows = rewriter.create<memref::DimOp>(loc, kernel, 0);
+    Value kCols = rewriter.create<memref::DimOp>(loc, kernel, 1);
+    Value outColsMain = rewriter.create<affine::AffineApplyOp>(
+        loc, AffineMap::get(1, 0, d0.floorDiv(widthBlock) * widthBlock),
+        ValueRange{outCols});
+    // Lane offsets of a channel vector for the input gathers.
+    Value laneOffsetVec, passThroughVec;
+    if (!unitMultiplier) {
+      SmallVector<int32_t> laneOffsets;
+      for (int64_t i = 0; i < vecSize; ++i)
+        laneOffsets.push_back(i);
+      laneOffsetVec = rewriter.create<arith::ConstantOp>(
+          loc,
+          DenseElementsAttr::get(idxVecTy, ArrayRef<int32_t>(laneOffsets)));
+      passThroughVec = rewriter.create<SplatOp>(loc, vecTy, f0);
+    }
+
+    // Computes `width` output pixels from column `ow` for the channel vector
+    // starting at `ch`. With a multiplier, `inputIdx` holds the input channel
+    // of every lane and `mask` the lanes inside the channels.
+    auto emitTile = [&](OpBuilder &builder, Location loc, Value n, Value oh,
+                        Value ch, Value inputIdx, Value mask, Value ow,
+                        int64_t width) {
+      SmallVector<Value> cols;
+      for (int64_t j = 0; j < width; ++j)
+        cols.push_back(builder.create<affine::AffineApplyOp>(
+            loc, AffineMap::get(1, 0, d0 + j), ValueRange{ow}));
+      SmallVector<Value> accs;
+      for (int64_t j = 0; j < width; ++j)
+        accs.push_back(builder.create<TransferReadOp>(
+            loc, vecTy, output, ValueRange{n, oh, cols[j], ch}, f0));
+      auto khLoop = builder.create<scf::ForOp>(
+          loc, c0, kRows, c1, accs,
+          [&](OpBuilder &builder, Location loc, Value kh, ValueRange accs) {
+            Value ih = builder.create<affine::AffineApplyOp>(
+                loc, AffineMap::get(2, 0, d0 * strH + d1 * dilH),
+                ValueRange{oh, kh});
+            auto kwLoop = builder.create<scf::ForOp>(
+                loc, c0, kCols, c1, accs,
+                [&](OpBuilder &builder, Location loc, Value kw,
+                    ValueRange accs) {
+                  // Load the filter vector once for the whole block.
+                  Value kernelVec = builder.create<TransferReadOp>(
+                      loc, vecTy, kernel, ValueRange{kh, kw, ch}, f0);
+                  SmallVector<Value> results;
+                  for (int64_t j = 0; j < width; ++j) {
+                    Value iw = builder.create<affine::AffineApplyOp>(
+                        loc, AffineMap::get(2, 0, d0 * strW + d1 * dilW),
+                        ValueRange{cols[j], kw});
+                    Value inputVec;
+                    if (unitMultiplier)
+                      inputVec = builder.create<TransferReadOp>(
+                          loc, vecTy, input, ValueRange{n, ih, iw, ch}, f0);
+                    else
+                      inputVec = builder.create<GatherOp>(
+                          loc, vecTy, input, ValueRange{n, ih, iw, c0},
+                          inputIdx, mask, passThroughVec);
+                    results.push_back(
+                        builder.create<FMAOp>(loc, inputVec, kernelVec, accs[j]));
+                  }
+                  builder.create<scf::YieldOp>(loc, results);
+                });
+            builder.create<scf::YieldOp>(loc, kwLoop.getResults());
+          });
+      for (int64_t j = 0; j < width; ++j)
+        builder.create<TransferWriteOp>(loc, khLoop.getResult(j), output,
+                                        ValueRange{n, oh, cols[j], ch});
+    };
+
+    rewriter.create<scf::ParallelOp>(
+        loc, ValueRange{c0, c0}, ValueRange{batch, outRows},
+        ValueRange{c1, c1},
+        [&](OpBuilder &builder, Location loc, ValueRange ivs) {
+          Value n = ivs[0];
+          Value oh = ivs[1];
+          builder.create<scf::ForOp>(
+              loc, c0, channels, cVec, std::nullopt,
+              [&](OpBuilder &builder, Location loc, Value ch, ValueRange) {
+                // Input channel `(ch + lane) / multiplier` of every lane.
+                Value inputIdx, mask;
+                if (!unitMultiplier) {
+                  Value tail = builder.create<arith::SubIOp>(loc, channels, ch);
+                  mask = builder.create<CreateMaskOp>(loc, maskTy, tail);
+                  Value chVec = builder.create<BroadcastOp>(
+                      loc, idxVecTy,
+                      builder.create<arith::IndexCastOp>(
+                          loc, builder.getI32Type(), ch));
+                  Value multiplierVec = builder.create<BroadcastOp>(
+                      loc, idxVecTy,
+                      builder.create<arith::IndexCastOp>(
+                          loc, builder.getI32Type(), multiplier));
+                  inputIdx = builder.create<arith::DivUIOp>(
+                      loc,
+                      builder.create<arith::AddIOp>(loc, chVec, laneOffsetVec),
+                      multiplierVec);
+                }
+                // Register-blocked output pixels.
+                builder.create<scf::ForOp>(
+                    loc, c0, outColsMain, cWidthBlock, std::nullopt,
+                    [&](OpBuilder &builder, Location loc, Value ow,
+                        ValueRange) {
+                      emitTile(builder, loc, n, oh, ch, inputIdx, mask, ow,
+                               widthBlock);
+                      builder.create<scf::YieldOp>(loc);
+                    });
+                // Remaining output pixels.
+                builder.create<scf::ForOp>(
+                    loc, outColsMain, outCols, c1, std::nullopt,
+                    [&](OpBuilder &builder, Location loc, Value ow,
+                        ValueRange) {
+                      emitTile(builder, loc, n, oh, ch, inputIdx, mask, ow, 1);
+                      builder.create<scf::YieldOp>(loc);
+                    });
+                builder.create<scf::YieldOp>(loc);
+              });
+        });
+    // Remove the origin convolution operation.
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  int64_t vecSize;
+  int64_t widthBlock;
+};
+
+// DepthwiseConv2DNchwChw vectorization pattern
+class DepthwiseConvNchwVectorizationPattern : public ConversionPattern {
+public:
+  explicit DepthwiseConvNchwVectorizationPattern(MLIRContext *context,
+                                                 int64_t vecSizeParam)
+      : ConversionPattern(linalg::DepthwiseConv2DNchwChwOp::getOperationName(),
+                          1, context) {
+    vecSize = vecSizeParam;
+  }
+
+  LogicalResult
+  matchAndRewrite(Operation *op, ArrayRef<Value> /*operands*/,
+                  ConversionPatternRewriter &rewriter) const override {
+    auto loc = op->getLoc();
+    // Get input, kernel and output.
+    Value input = op->getOperand(0);
+    Value kernel = op->getOperand(1);
+    Value output = op->getOperand(2);
+    MemRefType inputTy = dyn_cast<MemRefType>(input.getType());
+    MemRefType kernelTy = dyn_cast<MemRefType>(kernel.getType());
+    MemRefType outputTy = dyn_cast<MemRefType>(output.getType());
+    if (!inputTy || !kernelTy || !outputTy)
+      return failure();
+    // Element type.
+    FloatType fTy = dyn_cast<FloatType>(inputTy.getElementType());
+    if (!fTy || kernelTy.getElementType() != fTy ||
+        outputTy.getElementType() != fTy)
+      return failure();
+    // Strides and dilations.
+    auto strides = op->getAttrOfType<mlir::DenseIntElementsAttr>("strides")
+                       .getValues<int64_t>();
+    auto dilations = op->getAttrOfType<mlir::DenseIntElementsAttr>("dilations")
+                         .getValues<int64_t>();
+    int64_t strH = strides[0], strW = strides[1];
+    int64_t dilH = dilations[0], dilW = dilations[1];
+    // Vector types.
+    VectorType vecTy = VectorType::get({vecSize}, fTy);
+    VectorType maskTy = VectorType::get({vecSize}, rewriter.getI1Type());
+    VectorType idxVecTy = VectorType::get({vecSize}, rewriter.getI32Type());
+    // Constants.
+    Value c0 = rewriter.create<arith::ConstantIndexOp>(loc, 0);
+    Value c1 = rewriter.create<arith::ConstantIndexOp>(loc, 1);
+    Value cVec = rewriter.create<arith::ConstantIndexOp>(loc, vecSize);
+    Value f0 = rewriter.create<arith::ConstantOp>(
+        loc, rewriter.getFloatAttr(fTy, 0.0));
+    Value passThroughVec = rewriter.create<SplatOp>(loc, vecTy, f0);
+    // Lane offsets of a strided input row.
+    SmallVector<int32_t> laneOffsets;
+    for (int64_t i = 0; i < vecSize; ++i)
+      laneOffsets.push_back(i * strW);
+    Value laneOffsetVec = rewriter.create<arith::ConstantOp>(
+        loc, DenseElementsAttr::get(idxVecTy, ArrayRef<int32_t>(laneOffsets)));
+    AffineExpr d0, d1;
+    bindDims(rewriter.getContext(), d0, d1);
+    // Dimensions.
+    Value batch = rewriter.create<memref::DimOp>(loc, output, 0);
+    Value channels = rewriter.create<memref::DimOp>(loc, output, 1);
+    Value outRows = rewriter.create<memref::DimOp>(loc, output, 2);
+    Value outCols = rewriter.create<memref::DimOp>(loc, output, 3);
+    Value kRows = rewriter.create<memref::DimOp>(loc, kernel, 1);
+    Value kCols = rewriter.create<memref::DimOp>(loc, kernel, 2);
+
+    rewriter.create<scf::ParallelOp>(
+        loc, ValueRange{c0, c0, c0}, ValueRange{batch, channels, outRows},
+        ValueRange{c1, c1, c1},
+        [&](OpBuilder &builder, Location loc, ValueRange ivs) {
+          Value n = ivs[0];
+          Value c = ivs[1];
+          Value oh = ivs[2];
+          builder.create<scf::ForOp>(
+              loc, c0, outCols, cVec, std::nullopt,
+              [&](OpBuilder &builder, Location loc, Value ow, ValueRange) {
+                Value tail = builder.create<arith::SubIOp>(loc, outCols, ow);
+                Value tailMask =
+                    builder.create<CreateMaskOp>(loc, maskTy, tail);
+                Value acc = builder.create<TransferReadOp>(
+                    loc, vecTy, output, ValueRange{n, c, oh, ow}, f0);
+                auto khLoop = builder.create<scf::ForOp>(
+                    loc, c0, kRows, c1, ValueRange{acc},
+                    [&](OpBuilder &builder, Location loc, Value kh,
+                        ValueRange khArgs) {
+                      Value ih = builder.create<affine::AffineApplyOp>(
+                          loc, AffineMap::get(2, 0, d0 * strH + d1 * dilH),
+                          ValueRange{oh, kh});
+                      auto kwLoop = builder.create<scf::ForOp>(
+                          loc, c0, kCols, c1, khArgs,
+                          [&](OpBuilder &builder, Location loc, Value kw,
+                              ValueRange kwArgs) {
+                            // Broadcast element of the kernel.
+                            Value kernelValue = builder.create<memref::LoadOp>(
+                                loc, kernel, ValueRange{c, kh, kw});
+                            Value kernelVec = builder.create<BroadcastOp>(
+                                loc, vecTy, kernelValue);
+                            Value iw = builder.create<affine::AffineApplyOp>(
+                                loc, AffineMap::get(2, 0, d0 * strW + d1 * dilW),
+                                ValueRange{ow, kw});
+                            Value inputVec;
+                            if (strW == 1)
+                              inputVec = builder.create<TransferReadOp>(
+                                  loc, vecTy, input, ValueRange{n, c, ih, iw},
+                                  f0);
+                            else
+                              inputVec = builder.create<GatherOp>(
+                                  loc, vecTy, input, ValueRange{n, c, ih, iw},
+                                  laneOffsetVec, tailMask, passThroughVec);
+                            Value result = builder.create<FMAOp>(
+                                loc, inputVec, kernelVec, kwArgs[0]);
+                            builder.create<scf::YieldOp>(loc, result);
+                          });
+                      builder.create<scf::YieldOp>(loc, kwLoop.getResults());
+                    });
+                builder.create<TransferWriteOp>(loc, khLoop.getResult(0),
+                                                output,
+                                                ValueRange{n, c, oh, ow});
+                builder.create<scf::YieldOp>(loc);
+              });
+        });
+    // Remove the origin convolution operation.
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  int64_t vecSize;
+};
+} // end anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// DepthwiseConvVectorizationPass
+//===----------------------------------------------------------------------===//
+
+/// This is a partial lowering linalg depthwise convolution operations to
+/// mixture of SCF + Vector operations.
+namespace {
+class DepthwiseConvVectorizationPass
+    : public PassWrapper<DepthwiseConvVectorizationPass,
+                         OperationPass<ModuleOp>> {
+public:
+  MLIR_DEFINE_EXPLICIT_INTERNAL_INLINE_TYPE_ID(DepthwiseConvVectorizationPass)
+  StringRef getArgument() const final {
+    return "depthwise-conv-vectorization";
+  }
+  StringRef getDescription() const final {
+    return "Depthwise convolution vectorization.";
+  }
+  DepthwiseConvVectorizationPass() = default;
+  DepthwiseConvVectorizationPass(const DepthwiseConvVectorizationPass &) {}
+  explicit DepthwiseConvVectorizationPass(int64_t vecSizeParam,
+                                          int64_t widthBlockParam) {
+    vecSize = vecSizeParam;
+    widthBlock = widthBlockParam;
+  }
+
+  void runOnOperation() override;
+
+  void getDependentDialects(DialectRegistry &registry) const override {
+    registry.insert<linalg::LinalgDialect, scf::SCFDialect,
+                    affine::AffineDialect, VectorDialect>();
+  }
+
+  Option<int64_t> vecSize{*this, "vector-size",
+                          llvm::cl::desc("Vector size."), llvm::cl::init(16)};
+  Option<int64_t> widthBlock{
+      *this, "width-block",
+      llvm::cl::desc("Output pixels kept in registers (NHWC)."),
+      llvm::cl::init(4)};
+};
+} // end anonymous namespace.
+
+void DepthwiseConvVectorizationPass::runOnOperation() {
+  MLIRContext *context = &getContext();
+  ModuleOp module = getOperation();
+
+  ConversionTarget target(*context);
+  target
+      .addLegalDialect<arith::ArithDialect, affine::AffineDialect,
+                       scf::SCFDialect, memref::MemRefDialect, VectorDialect>();
+  target.addLegalOp<ModuleOp, func::FuncOp, func::ReturnOp>();
+  target.addLegalOp<linalg::FillOp>();
+
+  RewritePatternSet patterns(context);
+  patterns.add<
+      DepthwiseConvNhwcVectorizationPattern<linalg::DepthwiseConv2DNhwcHwcOp>,
+      DepthwiseConvNhwcVectorizationPattern<linalg::DepthwiseConv2DNhwcHwcmOp>>(
+      context, vecSize, widthBlock);
+  patterns.add<DepthwiseConvNchwVectorizationPattern>(context, vecSize);
+
+  if (failed(applyPartialConversion(module, target, std::move(patterns))))
+    signalPassFailure();
+}
+
+namespace mlir {
+namespace buddy {
+void registerDepthwiseConvVectorizationPass() {
+  PassRegistration<DepthwiseConvVectorizationPass>();
+}
+} // namespace buddy
+} // namespace mlir
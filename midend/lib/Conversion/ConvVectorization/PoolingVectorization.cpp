@@ -242,6 +242,223 @@ public:
     return success();
   }
 
+private:
+  int64_t strip;
+};
+
+// Max and sum pooling vectorization pattern for NHWC and NCHW.
+//
+// NHWC pooling is vectorized across channels and NCHW pooling across output
+// columns (with gathers for strided windows). The vector length is the
+// strip-mining size and the tails are handled with masks.
+template <typename PoolingOpTy>
+class PoolingVectorizationPattern : public ConversionPattern {
+  static constexpr bool isMax =
+      std::is_same_v<PoolingOpTy, linalg::PoolingNhwcMaxOp> ||
+      std::is_same_v<PoolingOpTy, linalg::PoolingNchwMaxOp>;
+  static constexpr bool isNchw =
+      std::is_same_v<PoolingOpTy, linalg::PoolingNchwMaxOp> ||
+      std::is_same_v<PoolingOpTy, linalg::PoolingNchwSumOp>;
+
+public:
+  explicit PoolingVectorizationPattern(MLIRContext *context, int64_t stripParam)
+      : ConversionPattern(PoolingOpTy::getOperationName(), 1, context) {
+    strip = stripParam;
+  }
+
+  LogicalResult
+  matchAndRewrite(Operation *op, ArrayRef<Value> /*operands*/,
+                  ConversionPatternRewriter &rewriter) const override {
+    auto loc = op->getLoc();
+    // Get input, kernel and output.
+    Value input = op->getOperand(0);
+    Value kernel = op->getOperand(1);
+    Value output = op->getOperand(2);
+    MemRefType inputMemRefTy = dyn_cast<MemRefType>(input.getType());
+    MemRefType kernelTy = dyn_cast<MemRefType>(kernel.getType());
+    if (!inputMemRefTy || !kernelTy ||
+        !isa<MemRefType>(output.getType()))
+      return failure();
+    // Element type.
+    Type elemTy = inputMemRefTy.getElementType();
+    bool isFloat = isa<FloatType>(elemTy);
+    if (!isFloat && !isa<IntegerType>(elemTy))
+      return failure();
+    // Strides.
+    auto strides = op->getAttrOfType<mlir::DenseIntElementsAttr>("strides")
+                       .getValues<int64_t>();
+    int64_t strHeight = strides[0];
+    int64_t strWidth = strides[1];
+    // Dilations.
+    auto dilations = op->getAttrOfType<mlir::DenseIntElementsAttr>("dilations")
+                         .getValues<int64_t>();
+    int64_t dilHeight = dilations[0];
+    int64_t dilWidth = dilations[1];
+    // Vector types.
+    VectorType vecTy = VectorType::get({strip}, elemTy);
+    VectorType maskTy = VectorType::get({strip}, rewriter.getI1Type());
+    // Constants.
+    Value c0 = rewriter.create<arith::ConstantIndexOp>(loc, 0);
+    Value c1 = rewriter.create<arith::ConstantIndexOp>(loc, 1);
+    Value cStrip = rewriter.create<arith::ConstantIndexOp>(loc, strip);
+    // The neutral element of the reduction is the pass through value of the
+    // masked loads.
+    TypedAttr neutralAttr;
+    if (!isMax)
+      neutralAttr = rewriter.getZeroAttr(elemTy);
+    else if (isFloat)
+      neutralAttr = rewriter.getFloatAttr(
+          elemTy, APFloat::getInf(cast<FloatType>(elemTy).getFloatSemantics(),
+                                  /*Negative=*/true));
+    else
+      neutralAttr = rewriter.getIntegerAttr(
+          elemTy, APInt::getSignedMinValue(elemTy.getIntOrFloatBitWidth()));
+    Value neutral = rewriter.create<arith::ConstantOp>(loc, neutralAttr);
+    Value passThroughVec = rewriter.create<SplatOp>(loc, vecTy, neutral);
+    AffineExpr d0, d1;
+    bindDims(rewriter.getContext(), d0, d1);
+    // Dimensions of the output and the pooling window.
+    Value batch = rewriter.create<memref::DimOp>(loc, output, 0);
+    Value channels = rewriter.create<memref::DimOp>(loc, output, isNchw ? 1 : 3);
+    Value outHeight =
+        rewriter.create<memref::DimOp>(loc, output, isNchw ? 2 : 1);
+    Value outWidth = rewriter.create<memref::DimOp>(loc, output, isNchw ? 3 : 2);
+    Value kHeight = rewriter.create<memref::DimOp>(loc, kernel, 0);
+    Value kWidth = rewriter.create<memref::DimOp>(loc, kernel, 1);
+
+    auto combine = [&](OpBuilder &builder, Location loc, Value acc,
+                       Value vec) -> Value {
+      if (isMax)
+        return isFloat
+                   ? Value(builder.create<arith::MaximumFOp>(loc, acc, vec))
+                   : Value(builder.create<arith::MaxSIOp>(loc, acc, vec));
+      return isFloat ? Value(builder.create<arith::AddFOp>(loc, acc, vec))
+                     : Value(builder.create<arith::AddIOp>(loc, acc, vec));
+    };
+
+    // Reduces the pooling window into `acc`. `loadWindowVec` loads the input
+    // vector for a window position.
+    auto reduceWindow =
+        [&](OpBuilder &builder, Location loc, Value acc,
+            function_ref<Value(OpBuilder &, Location, Value, Value)>
+                loadWindowVec) -> Value {
+      auto khLoop = builder.create<scf::ForOp>(
+          loc, c0, kHeight, c1, ValueRange{acc},
+          [&](OpBuilder &builder, Location loc, Value kh, ValueRange khArgs) {
+            auto kwLoop = builder.create<scf::ForOp>(
+                loc, c0, kWidth, c1, khArgs,
+                [&](OpBuilder &builder, Location loc, Value kw,
+                    ValueRange kwArgs) {
+                  Value vec = loadWindowVec(builder, loc, kh, kw);
+                  builder.create<scf::YieldOp>(
+                      loc, combine(builder, loc, kwArgs[0], vec));
+                });
+            builder.create<scf::YieldOp>(loc, kwLoop.getResults());
+          });
+      return khLoop.getResult(0);
+    };
+
+    if (!isNchw) {
+      rewriter.create<scf::ParallelOp>(
+          loc, ValueRange{c0, c0}, ValueRange{batch, outHeight},
+          ValueRange{c1, c1},
+          [&](OpBuilder &builder, Location loc, ValueRange ivs) {
+            Value n = ivs[0];
+            Value oh = ivs[1];
+            mlir::scf::buildLoopNest(
+                builder, loc, ValueRange{c0, c0}, ValueRange{outWidth, channels},
+                ValueRange{c1, cStrip}, {},
+                [&](OpBuilder &builder, Location loc, ValueRange ivs,
+                    ValueRange) -> scf::ValueVector {
+                  Value ow = ivs[0];
+                  Value c = ivs[1];
+                  // Create mask according to the channel tail.
+                  Value tail = builder.create<arith::SubIOp>(loc, channels, c);
+                  Value tailMask =
+                      builder.create<CreateMaskOp>(loc, maskTy, tail);
+                  Value acc = builder.create<MaskedLoadOp>(
+                      loc, vecTy, output, ValueRange{n, oh, ow, c}, tailMask,
+                      passThroughVec);
+                  Value result = reduceWindow(
+                      builder, loc, acc,
+                      [&](OpBuilder &builder, Location loc, Value kh,
+                          Value kw) -> Value {
+                        Value ih = builder.create<affine::AffineApplyOp>(
+                            loc,
+                            AffineMap::get(2, 0,
+                                           d0 * strHeight + d1 * dilHeight),
+                            ValueRange{oh, kh});
+                        Value iw = builder.create<affine::AffineApplyOp>(
+                            loc,
+                            AffineMap::get(2, 0, d0 * strWidth + d1 * dilWidth),
+                            ValueRange{ow, kw});
+                        return builder.create<MaskedLoadOp>(
+                            loc, vecTy, input, ValueRange{n, ih, iw, c},
+                            tailMask, passThroughVec);
+                      });
+                  builder.create<MaskedStoreOp>(
+                      loc, output, ValueRange{n, oh, ow, c}, tailMask, result);
+                  return {};
+                });
+          });
+    } else {
+      // Lane offsets of a strided input row.
+      VectorType idxVecTy = VectorType::get({strip}, rewriter.getI32Type());
+      SmallVector<int32_t> laneOffsets;
+      for (int64_t i = 0; i < strip; ++i)
+        laneOffsets.push_back(i * strWidth);
+      Value laneOffsetVec = rewriter.create<arith::ConstantOp>(
+          loc,
+          DenseElementsAttr::get(idxVecTy, ArrayRef<int32_t>(laneOffsets)));
+      rewriter.create<scf::ParallelOp>(
+          loc, ValueRange{c0, c0, c0}, ValueRange{batch, channels, outHeight},
+          ValueRange{c1, c1, c1},
+          [&](OpBuilder &builder, Location loc, ValueRange ivs) {
+            Value n = ivs[0];
+            Value c = ivs[1];
+            Value oh = ivs[2];
+            builder.create<scf::ForOp>(
+                loc, c0, outWidth, cStrip, std::nullopt,
+                [&](OpBuilder &builder, Location loc, Value ow, ValueRange) {
+                  // Create mask according to the column tail.
+                  Value tail = builder.create<arith::SubIOp>(loc, outWidth, ow);
+                  Value tailMask =
+                      builder.create<CreateMaskOp>(loc, maskTy, tail);
+                  Value acc = builder.create<MaskedLoadOp>(
+                      loc, vecTy, output, ValueRange{n, c, oh, ow}, tailMask,
+                      passThroughVec);
+                  Value result = reduceWindow(
+                      builder, loc, acc,
+                      [&](OpBuilder &builder, Location loc, Value kh,
+                          Value kw) -> Value {
+                        Value ih = builder.create<affine::AffineApplyOp>(
+                            loc,
+                            AffineMap::get(2, 0,
+                                           d0 * strHeight + d1 * dilHeight),
+                            ValueRange{oh, kh});
+                        Value iw = builder.create<affine::AffineApplyOp>(
+                            loc,
+                            AffineMap::get(2, 0, d0 * strWidth + d1 * dilWidth),
+                            ValueRange{ow, kw});
+                        if (strWidth == 1)
+                          return builder.create<MaskedLoadOp>(
+                              loc, vecTy, input, ValueRange{n, c, ih, iw},
+                              tailMask, passThroughVec);
+                        return builder.create<GatherOp>(
+                            loc, vecTy, input, ValueRange{n, c, ih, iw},
+                            laneOffsetVec, tailMask, passThroughVec);
+                      });
+                  builder.create<MaskedStoreOp>(
+                      loc, output, ValueRange{n, c, oh, ow}, tailMask, result);
+                  builder.create<scf::YieldOp>(loc);
+                });
+          });
+    }
+    // Remove the origin pooling operation.
+    rewriter.eraseOp(op);
+    return success();
+  }
+
 private:
   int64_t strip;
 };
@@ -290,6 +507,10 @@ void PoolingVectorizationPass::runOnOperation() {
 
   RewritePatternSet patterns(context);
   patterns.add<CBPoolingNhwcSumVectorizationPattern>(context, strip);
+  patterns.add<PoolingVectorizationPattern<linalg::PoolingNhwcMaxOp>,
+               PoolingVectorizationPattern<linalg::PoolingNchwMaxOp>,
+               PoolingVectorizationPattern<linalg::PoolingNchwSumOp>>(context,
+                                                                      strip);
 
   if (failed(applyPartialConversion(module, target, std::move(patterns))))
     signalPassFailure();
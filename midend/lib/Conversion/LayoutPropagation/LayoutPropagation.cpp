@@ -0,0 +1,501 @@
+//====- LayoutPropagation.cpp - Transpose elimination and folding ---------===//
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements the layout propagation pass. The frontend emits a
+// `linalg.transpose` for every `TOp`, `TransposeOp` and `PermuteOp`, and most
+// of them only exist to feed a matmul in a different layout. Instead of
+// optimizing these copy kernels, the pass removes them:
+//
+//   - adjacent transposes are composed, and cancelled when they are inverse;
+//   - transposes are sunk below `tensor.expand_shape` and (when the
+//     reassociation allows it) `tensor.collapse_shape`, so that they meet
+//     their consumers;
+//   - transposes feeding `linalg.matmul`/`linalg.batch_matmul` become the
+//     transposed-operand named variants;
+//   - any remaining transpose feeding or fed by a `linalg.generic` is folded
+//     into the indexing maps of that generic op.
+//
+// The pass works on tensors, i.e. it must run before bufferization.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/Linalg/Transforms/Transforms.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/IR/AffineMap.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/Pass/Pass.h"
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+#include "llvm/ADT/SmallVector.h"
+
+using namespace mlir;
+
+//===----------------------------------------------------------------------===//
+// Helper Functions
+//===----------------------------------------------------------------------===//
+
+namespace {
+
+/// Returns the transpose defining `value`, if it works on ranked tensors.
+linalg::TransposeOp getTensorTransposeProducer(Value value) {
+  auto transposeOp = value.getDefiningOp<linalg::TransposeOp>();
+  if (!transposeOp || !isa<RankedTensorType>(transposeOp.getInput().getType()))
+    return nullptr;
+  return transposeOp;
+}
+
+/// Returns the inverse of the permutation `perm`.
+SmallVector<int64_t> invertPermutation(ArrayRef<int64_t> perm) {
+  SmallVector<int64_t> inverse(perm.size());
+  for (size_t i = 0; i < perm.size(); ++i)
+    inverse[perm[i]] = i;
+  return inverse;
+}
+
+/// Returns true if `perm` is the identity permutation.
+bool isIdentityPermutation(ArrayRef<int64_t> perm) {
+  for (size_t i = 0; i < perm.size(); ++i)
+    if (perm[i] != static_cast<int64_t>(i))
+      return false;
+  return true;
+}
+
+/// Returns true if `perm` only swaps the two innermost dimensions.
+bool isInnermostSwap(ArrayRef<int64_t> perm) {
+  int64_t rank = perm.size();
+  if (rank < 2)
+    return false;
+  for (int64_t i = 0; i < rank - 2; ++i)
+    if (perm[i] != i)
+      return false;
+  return perm[rank - 2] == rank - 1 && perm[rank - 1] == rank - 2;
+}
+
+//===----------------------------------------------------------------------===//
+// Rewrite Patterns
+//===----------------------------------------------------------------------===//
+
+/// transpose(transpose(x, p1), p2) -> transpose(x, p1 o p2), or x itself when
+/// the two permutations are inverse to each other.
+class ComposeTransposePattern : public OpRewritePattern<linalg::TransposeOp> {
+public:
+  using OpRewritePattern<linalg::TransposeOp>::OpRewritePattern;
+
+  LogicalResult matchAndRewrite(linalg::TransposeOp op,
+                                PatternRewriter &rewriter) const override {
+    linalg::TransposeOp producer = getTensorTransposeProducer(op.getInput());
+    if (!producer || op->getNumResults() != 1)
+      return failure();
+
+    ArrayRef<int64_t> inner = producer.getPermutation();
+    ArrayRef<int64_t> outer = op.getPermutation();
+    SmallVector<int64_t> composed;
+    for (int64_t p : outer)
+      composed.push_back(inner[p]);
+
+    if (isIdentityPermutation(composed)) {
+      rewriter.replaceOp(op, producer.getInput());
+      return success();
+    }
+    rewriter.replaceOpWithNewOp<linalg::TransposeOp>(op, producer.getInput(),
+                                                     op.getInit(), composed);
+    return success();
+  }
+};
+
+/// A transpose of rank one or with the identity permutation is a copy.
+class EraseIdentityTransposePattern
+    : public OpRewritePattern<linalg::TransposeOp> {
+public:
+  using OpRewritePattern<linalg::TransposeOp>::OpRewritePattern;
+
+  LogicalResult matchAndRewrite(linalg::TransposeOp op,
+                                PatternRewriter &rewriter) const override {
+    if (op->getNumResults() != 1 ||
+        !isIdentityPermutation(op.getPermutation()) ||
+        op.getInput().getType() != op->getResult(0).getType())
+      return failure();
+    rewriter.replaceOp(op, op.getInput());
+    return success();
+  }
+};
+
+/// expand_shape(transpose(x, p)) -> transpose(expand_shape(x), p'), so that the
+/// transpose reaches its consumers. Each transposed dimension k is source
+/// dimension p[k], so the source can always be split in the same way.
+class SinkTransposeThroughExpandShapePattern
+    : public OpRewritePattern<tensor::ExpandShapeOp> {
+public:
+  using OpRewritePattern<tensor::ExpandShapeOp>::OpRewritePattern;
+
+  LogicalResult matchAndRewrite(tensor::ExpandShapeOp op,
+                                PatternRewriter &rewriter) const override {
+    linalg::TransposeOp transposeOp = getTensorTransposeProducer(op.getSrc());
+    if (!transposeOp || !transposeOp->hasOneUse())
+      return failure();
+    RankedTensorType resultTy = op.getResultType();
+    if (!resultTy.hasStaticShape())
+      return failure();
+
+    ArrayRef<int64_t> perm = transposeOp.getPermutation();
+    SmallVector<int64_t> inversePerm = invertPermutation(perm);
+    SmallVector<ReassociationIndices> groups = op.getReassociationIndices();
+
+    // Build the expanded source: source dim j is split like group pinv[j].
+    SmallVector<ReassociationIndices> newGroups;
+    SmallVector<int64_t> newShape;
+    SmallVector<int64_t> groupStart(perm.size());
+    for (size_t j = 0; j < perm.size(); ++j) {
+      ReassociationIndices newGroup;
+      groupStart[j] = newShape.size();
+      for (int64_t dim : groups[inversePerm[j]]) {
+        newGroup.push_back(newShape.size());
+        newShape.push_back(resultTy.getDimSize(dim));
+      }
+      newGroups.push_back(newGroup);
+    }
+
+    // Expanded dims of group k come from the expanded dims of source p[k].
+    SmallVector<int64_t> newPerm;
+    for (size_t k = 0; k < groups.size(); ++k)
+      for (size_t i = 0; i < groups[k].size(); ++i)
+        newPerm.push_back(groupStart[perm[k]] + i);
+
+    Location loc = op.getLoc();
+    auto newExpandTy =
+        RankedTensorType::get(newShape, resultTy.getElementType());
+    Value newExpand = rewriter.create<tensor::ExpandShapeOp>(
+        loc, newExpandTy, transposeOp.getInput(), newGroups);
+    Value init = rewriter.create<tensor::EmptyOp>(loc, resultTy.getShape(),
+                                                  resultTy.getElementType());
+    rewriter.replaceOpWithNewOp<linalg::TransposeOp>(op, newExpand, init,
+                                                     newPerm);
+    return success();
+  }
+};
+
+/// collapse_shape(transpose(x, p)) -> transpose(collapse_shape(x), p') when
+/// every collapsed group maps to a run of consecutive source dimensions.
+class SinkTransposeThroughCollapseShapePattern
+    : public OpRewritePattern<tensor::CollapseShapeOp> {
+public:
+  using OpRewritePattern<tensor::CollapseShapeOp>::OpRewritePattern;
+
+  LogicalResult matchAndRewrite(tensor::CollapseShapeOp op,
+                                PatternRewriter &rewriter) const override {
+    linalg::TransposeOp transposeOp = getTensorTransposeProducer(op.getSrc());
+    if (!transposeOp || !transposeOp->hasOneUse())
+      return failure();
+    RankedTensorType resultTy = op.getResultType();
+    if (!resultTy.hasStaticShape())
+      return failure();
+
+    ArrayRef<int64_t> perm = transposeOp.getPermutation();
+    SmallVector<ReassociationIndices> groups = op.getReassociationIndices();
+
+    // Every group must read consecutive, increasing source dimensions.
+    for (const ReassociationIndices &group : groups)
+      for (size_t i = 1; i < group.size(); ++i)
+        if (perm[group[i]] != perm[group[i - 1]] + 1)
+          return failure();
+
+    // Order the groups by their first source dimension.
+    SmallVector<int64_t> order(groups.size());
+    for (size_t k = 0; k < groups.size(); ++k)
+      order[k] = k;
+    llvm::sort(order, [&](int64_t a, int64_t b) {
+      return perm[groups[a].front()] < perm[groups[b].front()];
+    });
+
+    SmallVector<ReassociationIndices> newGroups;
+    SmallVector<int64_t> newShape;
+    SmallVector<int64_t> positionOf(groups.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+      const ReassociationIndices &group = groups[order[i]];
+      ReassociationIndices newGroup;
+      for (size_t j = 0; j < group.size(); ++j)
+        newGroup.push_back(perm[group.front()] + j);
+      newGroups.push_back(newGroup);
+      newShape.push_back(resultTy.getDimSize(order[i]));
+      positionOf[order[i]] = i;
+    }
+
+    SmallVector<int64_t> newPerm;
+    for (size_t k = 0; k < groups.size(); ++k)
+      newPerm.push_back(positionOf[k]);
+
+    Location loc = op.getLoc();
+    auto newCollapseTy =
+        RankedTensorType::get(newShape, resultTy.getElementType());
+    Value newCollapse = rewriter.create<tensor::CollapseShapeOp>(
+        loc, newCollapseTy, transposeOp.getInput(), newGroups);
+    if (isIdentityPermutation(newPerm)) {
+      rewriter.replaceOp(op, newCollapse);
+      return success();
+    }
+    Value init = rewriter.create<tensor::EmptyOp>(loc, resultTy.getShape(),
+                                                  resultTy.getElementType());
+    rewriter.replaceOpWithNewOp<linalg::TransposeOp>(op, newCollapse, init,
+                                                     newPerm);
+    return success();
+  }
+};
+
+/// matmul(transpose(A), B) -> matmul_transpose_a(A, B)
+/// matmul(A, transpose(B)) -> matmul_transpose_b(A, B)
+class FoldTransposeIntoMatmulPattern
+    : public OpRewritePattern<linalg::MatmulOp> {
+public:
+  using OpRewritePattern<linalg::MatmulOp>::OpRewritePattern;
+
+  LogicalResult matchAndRewrite(linalg::MatmulOp op,
+                                PatternRewriter &rewriter) const override {
+    if (!op.hasTensorSemantics())
+      return failure();
+    Value lhs = op.getInputs()[0];
+    Value rhs = op.getInputs()[1];
+    linalg::TransposeOp lhsT = getTensorTransposeProducer(lhs);
+    linalg::TransposeOp rhsT = getTensorTransposeProducer(rhs);
+    bool foldLhs = lhsT && isInnermostSwap(lhsT.getPermutation());
+    bool foldRhs = rhsT && isInnermostSwap(rhsT.getPermutation());
+
+    // (A^T B^T) has no named form; leave it to the generic folding.
+    if (foldLhs == foldRhs)
+      return failure();
+
+    if (foldLhs)
+      rewriter.replaceOpWithNewOp<linalg::MatmulTransposeAOp>(
+          op, op.getResultTypes(), ValueRange{lhsT.getInput(), rhs},
+          op.getOutputs());
+    else
+      rewriter.replaceOpWithNewOp<linalg::MatmulTransposeBOp>(
+          op, op.getResultTypes(), ValueRange{lhs, rhsT.getInput()},
+          op.getOutputs());
+    return success();
+  }
+};
+
+/// batch_matmul with an operand transposed in its two innermost dimensions ->
+/// batch_matmul_transpose_a/b.
+class FoldTransposeIntoBatchMatmulPattern
+    : public OpRewritePattern<linalg::BatchMatmulOp> {
+public:
+  using OpRewritePattern<linalg::BatchMatmulOp>::OpRewritePattern;
+
+  LogicalResult matchAndRewrite(linalg::BatchMatmulOp op,
+                                PatternRewriter &rewriter) const override {
+    if (!op.hasTensorSemantics())
+      return failure();
+    Value lhs = op.getInputs()[0];
+    Value rhs = op.getInputs()[1];
+    linalg::TransposeOp lhsT = getTensorTransposeProducer(lhs);
+    linalg::TransposeOp rhsT = getTensorTransposeProducer(rhs);
+    bool foldLhs = lhsT && isInnermostSwap(lhsT.getPermutation());
+    bool foldRhs = rhsT && isInnermostSwap(rhsT.getPermutation());
+
+    if (foldLhs == foldRhs)
+      return failure();
+
+    if (foldLhs)
+      rewriter.replaceOpWithNewOp<linalg::BatchMatmulTransposeAOp>(
+          op, op.getResultTypes(), ValueRange{lhsT.getInput(), rhs},
+          op.getOutputs());
+    else
+      rewriter.replaceOpWithNewOp<linalg::BatchMatmulTransposeBOp>(
+          op, op.getResultTypes(), ValueRange{lhs, rhsT.getInput()},
+          op.getOutputs());
+    return success();
+  }
+};
+
+/// Any other permutation reaching a (batch) matmul is handled by generalizing
+/// the matmul, so that the transpose can be folded into its indexing maps.
+template <typename MatmulOpTy>
+class GeneralizeTransposedMatmulPattern : public OpRewritePattern<MatmulOpTy> {
+public:
+  using OpRewritePattern<MatmulOpTy>::OpRewritePattern;
+
+  LogicalResult matchAndRewrite(MatmulOpTy op,
+                                PatternRewriter &rewriter) const override {
+    if (!op.hasTensorSemantics())
+      return failure();
+    bool hasTransposedInput = false;
+    for (Value input : op.getInputs())
+      if (getTensorTransposeProducer(input))
+        hasTransposedInput = true;
+    if (!hasTransposedInput)
+      return failure();
+    // Let the named-variant patterns take the simple cases.
+    linalg::TransposeOp lhsT = getTensorTransposeProducer(op.getInputs()[0]);
+    linalg::TransposeOp rhsT = getTensorTransposeProducer(op.getInputs()[1]);
+    bool lhsSwap = lhsT && isInnermostSwap(lhsT.getPermutation());
+    bool rhsSwap = rhsT && isInnermostSwap(rhsT.getPermutation());
+    if ((lhsSwap && !rhsT) || (rhsSwap && !lhsT))
+      return failure();
+    return linalg::generalizeNamedOp(rewriter, op);
+  }
+};
+
+/// generic(transpose(x, p), ...) -> generic(x, ...) with the permuted indexing
+/// map. Element i of transpose(x) is x[j] with j[p[k]] = i[k], so the map of x
+/// is the map of the transposed operand with its results permuted by p^-1.
+class FoldTransposeIntoGenericInputPattern
+    : public OpRewritePattern<linalg::GenericOp> {
+public:
+  using OpRewritePattern<linalg::GenericOp>::OpRewritePattern;
+
+  LogicalResult matchAndRewrite(linalg::GenericOp op,
+                                PatternRewriter &rewriter) const override {
+    if (!op.hasTensorSemantics())
+      return failure();
+
+    SmallVector<Value> newInputs;
+    SmallVector<AffineMap> newMaps = op.getIndexingMapsArray();
+    bool changed = false;
+    for (auto [idx, input] : llvm::enumerate(op.getInputs())) {
+      AffineMap map = newMaps[idx];
+      linalg::TransposeOp transposeOp = getTensorTransposeProducer(input);
+      if (!transposeOp) {
+        newInputs.push_back(input);
+        continue;
+      }
+      SmallVector<int64_t> inversePerm =
+          invertPermutation(transposeOp.getPermutation());
+      SmallVector<AffineExpr> exprs;
+      for (int64_t p : inversePerm)
+        exprs.push_back(map.getResult(p));
+      newInputs.push_back(transposeOp.getInput());
+      newMaps[idx] = AffineMap::get(map.getNumDims(), map.getNumSymbols(),
+                                    exprs, op.getContext());
+      changed = true;
+    }
+    if (!changed)
+      return failure();
+
+    rewriter.updateRootInPlace(op, [&]() {
+      op.getInputsMutable().assign(newInputs);
+      op.setIndexingMapsAttr(rewriter.getAffineMapArrayAttr(newMaps));
+    });
+    return success();
+  }
+};
+
+/// transpose(generic(...)) -> generic(...) writing the transposed layout
+/// directly. Only applies when the generic does not read its init value.
+class FoldTransposeIntoGenericOutputPattern
+    : public OpRewritePattern<linalg::TransposeOp> {
+public:
+  using OpRewritePattern<linalg::TransposeOp>::OpRewritePattern;
+
+  LogicalResult matchAndRewrite(linalg::TransposeOp op,
+                                PatternRewriter &rewriter) const override {
+    auto genericOp = op.getInput().getDefiningOp<linalg::GenericOp>();
+    if (!genericOp || !genericOp.hasTensorSemantics() ||
+        genericOp->getNumResults() != 1 || !genericOp->hasOneUse() ||
+        op->getNumResults() != 1)
+      return failure();
+
+    OpOperand *init = genericOp.getDpsInitOperand(0);
+    if (genericOp.payloadUsesValueFromOperand(init))
+      return failure();
+
+    // Element k of the transposed result is element p[k] of the generic's
+    // result, so permute the output map results by p.
+    AffineMap outMap = genericOp.getMatchingIndexingMap(init);
+    SmallVector<AffineExpr> exprs;
+    for (int64_t p : op.getPermutation())
+      exprs.push_back(outMap.getResult(p));
+    AffineMap newOutMap = AffineMap::get(
+        outMap.getNumDims(), outMap.getNumSymbols(), exprs, op.getContext());
+
+    SmallVector<AffineMap> newMaps = genericOp.getIndexingMapsArray();
+    newMaps.back() = newOutMap;
+
+    Value newInit = op.getInit();
+    auto newGeneric = rewriter.create<linalg::GenericOp>(
+        genericOp.getLoc(), TypeRange{newInit.getType()},
+        genericOp.getInputs(), ValueRange{newInit}, newMaps,
+        genericOp.getIteratorTypesArray());
+    rewriter.inlineRegionBefore(genericOp.getRegion(), newGeneric.getRegion(),
+                                newGeneric.getRegion().begin());
+    rewriter.replaceOp(op, newGeneric->getResults());
+    rewriter.eraseOp(genericOp);
+    return success();
+  }
+};
+
+} // end anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// LayoutPropagationPass
+//===----------------------------------------------------------------------===//
+
+namespace {
+class LayoutPropagationPass
+    : public PassWrapper<LayoutPropagationPass, OperationPass<ModuleOp>> {
+public:
+  MLIR_DEFINE_EXPLICIT_INTERNAL_INLINE_TYPE_ID(LayoutPropagationPass)
+  StringRef getArgument() const final { return "layout-propagation"; }
+  StringRef getDescription() const final {
+    return "Cancel, sink and fold linalg.transpose into consumers.";
+  }
+  LayoutPropagationPass() = default;
+  LayoutPropagationPass(const LayoutPropagationPass &) {}
+
+  void runOnOperation() override;
+
+  void getDependentDialects(DialectRegistry &registry) const override {
+    registry.insert<linalg::LinalgDialect, tensor::TensorDialect>();
+  }
+
+  Option<bool> generalizeMatmul{
+      *this, "generalize-matmul",
+      llvm::cl::desc("Generalize (batch) matmuls whose transposed operands "
+                     "have no named variant, and fold the permutation into "
+                     "their indexing maps."),
+      llvm::cl::init(true)};
+};
+} // end anonymous namespace.
+
+void LayoutPropagationPass::runOnOperation() {
+  MLIRContext *context = &getContext();
+  ModuleOp module = getOperation();
+
+  RewritePatternSet patterns(context);
+  patterns.add<ComposeTransposePattern, EraseIdentityTransposePattern,
+               SinkTransposeThroughExpandShapePattern,
+               SinkTransposeThroughCollapseShapePattern,
+               FoldTransposeIntoMatmulPattern,
+               FoldTransposeIntoBatchMatmulPattern,
+               FoldTransposeIntoGenericInputPattern,
+               FoldTransposeIntoGenericOutputPattern>(context);
+  if (generalizeMatmul)
+    patterns.add<GeneralizeTransposedMatmulPattern<linalg::MatmulOp>,
+                 GeneralizeTransposedMatmulPattern<linalg::BatchMatmulOp>>(
+        context);
+
+  if (failed(applyPatternsAndFoldGreedily(module, std::move(patterns))))
+    signalPassFailure();
+}
+
+namespace mlir {
+namespace buddy {
+void registerLayoutPropagationPass() {
+  PassRegistration<LayoutPropagationPass>();
+}
+} // namespace buddy
+} // namespace mlir
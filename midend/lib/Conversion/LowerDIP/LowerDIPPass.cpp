@@ -50,9 +50,11 @@ class DIPCorr2DOpLowering : public OpRewritePattern<dip::Corr2DOp> {
 public:
   using OpRewritePattern<dip::Corr2DOp>::OpRewritePattern;
 
-  explicit DIPCorr2DOpLowering(MLIRContext *context, int64_t strideParam)
+  explicit DIPCorr2DOpLowering(MLIRContext *context, int64_t strideParam,
+                               int64_t tileRowsParam)
       : OpRewritePattern(context) {
     stride = strideParam;
+    tileRows = tileRowsParam;
   }
 
   LogicalResult matchAndRewrite(dip::Corr2DOp op,
@@ -85,7 +87,8 @@ public:
     traverseImagewBoundaryExtrapolation(rewriter, loc, ctx, input, kernel,
                                         output, centerX, centerY, constantValue,
                                         strideVal, inElemTy, boundaryOptionAttr,
-                                        stride, dip::DIP_OP::CORRELATION_2D);
+                                        stride, dip::DIP_OP::CORRELATION_2D,
+                                        tileRows);
     // Remove the origin convolution operation.
     rewriter.eraseOp(op);
     return success();
@@ -93,6 +96,537 @@ public:
 
 private:
   int64_t stride;
+  int64_t tileRows;
+};
+
+class DIPCorr2DSeparableOpLowering
+    : public OpRewritePattern<dip::Corr2DSeparableOp> {
+public:
+  using OpRewritePattern<dip::Corr2DSeparableOp>::OpRewritePattern;
+
+  explicit DIPCorr2DSeparableOpLowering(MLIRContext *context,
+                                        int64_t strideParam)
+      : OpRewritePattern(context) {
+    stride = strideParam;
+  }
+
+  LogicalResult matchAndRewrite(dip::Corr2DSeparableOp op,
+                                PatternRewriter &rewriter) const override {
+    auto loc = op->getLoc();
+    auto *ctx = op->getContext();
+
+    // Register operand values.
+    Value input = op->getOperand(0);
+    Value kernelX = op->getOperand(1);
+    Value kernelY = op->getOperand(2);
+    Value output = op->getOperand(3);
+    Value centerX = op->getOperand(4);
+    Value centerY = op->getOperand(5);
+    Value constantValue = op->getOperand(6);
+    dip::BoundaryOption boundaryOptionAttr = op.getBoundaryOption();
+
+    auto inElemTy = input.getType().cast<MemRefType>().getElementType();
+    dip::DIP_ERROR error = dip::checkDIPCommonTypes<dip::Corr2DSeparableOp>(
+        op, {input, kernelX, kernelY, output, constantValue});
+
+    if (error == dip::DIP_ERROR::INCONSISTENT_TYPES) {
+      return op->emitOpError() << "input, kernels, output and constant must "
+                                  "have the same element type";
+    } else if (error == dip::DIP_ERROR::UNSUPPORTED_TYPE) {
+      return op->emitOpError() << "supports only f32, f64 and integer types. "
+                               << inElemTy << "is passed";
+    }
+
+    // Interleaved images are correlated with the channels of each pixel in
+    // consecutive columns.
+    Value channels = dip::collapseChannels(rewriter, loc, input);
+    dip::collapseChannels(rewriter, loc, output);
+    separableCorrelation(rewriter, loc, ctx, input, kernelX, kernelY, output,
+                         centerX, centerY, constantValue, inElemTy,
+                         boundaryOptionAttr, stride, channels);
+    // Remove the origin correlation operation.
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  int64_t stride;
+};
+
+class DIPIntegralImageOpLowering
+    : public OpRewritePattern<dip::IntegralImageOp> {
+public:
+  using OpRewritePattern<dip::IntegralImageOp>::OpRewritePattern;
+
+  explicit DIPIntegralImageOpLowering(MLIRContext *context,
+                                      int64_t strideParam)
+      : OpRewritePattern(context) {
+    stride = strideParam;
+  }
+
+  LogicalResult matchAndRewrite(dip::IntegralImageOp op,
+                                PatternRewriter &rewriter) const override {
+    auto loc = op->getLoc();
+    auto *ctx = op->getContext();
+
+    // Register operand values.
+    Value input = op->getOperand(0);
+    Value output = op->getOperand(1);
+
+    auto inputTy = input.getType().cast<MemRefType>();
+    auto outputTy = output.getType().cast<MemRefType>();
+    Type inElemTy = inputTy.getElementType();
+    Type outElemTy = outputTy.getElementType();
+    if (inputTy.getRank() != 2 || outputTy.getRank() != 2) {
+      return op->emitOpError() << "input and output must be HxW images";
+    }
+    if (!inElemTy.isF32() && !inElemTy.isF64() && !inElemTy.isInteger(8) &&
+        !inElemTy.isInteger(16)) {
+      return op->emitOpError() << "supports only f32, f64, 8-bit and 16-bit "
+                                  "images. "
+                               << inElemTy << " is passed";
+    }
+    if (!outElemTy.isF32() && !outElemTy.isF64() && !outElemTy.isInteger(32) &&
+        !outElemTy.isInteger(64)) {
+      return op->emitOpError() << "output must have i32, i64, f32 or f64 "
+                                  "element type";
+    }
+    unsigned inWidth = inElemTy.getIntOrFloatBitWidth();
+    if (inElemTy.isa<FloatType>() &&
+        (!outElemTy.isa<FloatType>() ||
+         outElemTy.getIntOrFloatBitWidth() < inWidth)) {
+      return op->emitOpError() << "floating-point images need a "
+                                  "floating-point output at least as wide";
+    }
+
+    dip::integralImage(rewriter, loc, ctx, input, output, inElemTy, outElemTy,
+                       stride);
+    // Remove the origin integral image operation.
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  int64_t stride;
+};
+
+// Checks the operands of the box, Gaussian and rank filters and of the pyramid
+// operations, which support single channel f32, f64 and unsigned 8-bit and
+// 16-bit images.
+template <typename FilterOp>
+static LogicalResult checkFilterOp(FilterOp op, Value input, Value output,
+                                   Value constantValue) {
+  auto inputTy = input.getType().cast<MemRefType>();
+  Type inElemTy = inputTy.getElementType();
+  dip::DIP_ERROR error =
+      dip::checkDIPCommonTypes<FilterOp>(op, {input, output, constantValue});
+
+  if (error == dip::DIP_ERROR::INCONSISTENT_TYPES) {
+    return op->emitOpError()
+           << "input, output and constant must have the same element type";
+  }
+  if (!inElemTy.isF32() && !inElemTy.isF64() && !inElemTy.isInteger(8) &&
+      !inElemTy.isInteger(16)) {
+    return op->emitOpError() << "supports only f32, f64, 8-bit and 16-bit "
+                                "images. "
+                             << inElemTy << " is passed";
+  }
+  if (inputTy.getRank() != 2 ||
+      output.getType().cast<MemRefType>().getRank() != 2) {
+    return op->emitOpError() << "input and output must be HxW images";
+  }
+  return success();
+}
+
+class DIPBoxFilterOpLowering : public OpRewritePattern<dip::BoxFilterOp> {
+public:
+  using OpRewritePattern<dip::BoxFilterOp>::OpRewritePattern;
+
+  explicit DIPBoxFilterOpLowering(MLIRContext *context, int64_t strideParam,
+                                  int64_t tileRowsParam)
+      : OpRewritePattern(context) {
+    stride = strideParam;
+    tileRows = tileRowsParam;
+  }
+
+  LogicalResult matchAndRewrite(dip::BoxFilterOp op,
+                                PatternRewriter &rewriter) const override {
+    auto loc = op->getLoc();
+    auto *ctx = op->getContext();
+
+    // Register operand values.
+    Value input = op->getOperand(0);
+    Value output = op->getOperand(1);
+    Value kernelWidth = op->getOperand(2);
+    Value kernelHeight = op->getOperand(3);
+    Value centerX = op->getOperand(4);
+    Value centerY = op->getOperand(5);
+    Value constantValue = op->getOperand(6);
+    dip::BoundaryOption boundaryOptionAttr = op.getBoundaryOption();
+
+    if (failed(checkFilterOp(op, input, output, constantValue)))
+      return failure();
+
+    auto elemTy = input.getType().cast<MemRefType>().getElementType();
+    dip::boxFilter(rewriter, loc, ctx, input, output, kernelWidth,
+                   kernelHeight, centerX, centerY, constantValue, elemTy,
+                   elemTy, boundaryOptionAttr, stride, tileRows);
+    // Remove the origin filter operation.
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  int64_t stride;
+  int64_t tileRows;
+};
+
+class DIPGaussianBlurOpLowering
+    : public OpRewritePattern<dip::GaussianBlurOp> {
+public:
+  using OpRewritePattern<dip::GaussianBlurOp>::OpRewritePattern;
+
+  explicit DIPGaussianBlurOpLowering(MLIRContext *context,
+                                     int64_t strideParam,
+                                     int64_t tileRowsParam)
+      : OpRewritePattern(context) {
+    stride = strideParam;
+    tileRows = tileRowsParam;
+  }
+
+  LogicalResult matchAndRewrite(dip::GaussianBlurOp op,
+                                PatternRewriter &rewriter) const override {
+    auto loc = op->getLoc();
+    auto *ctx = op->getContext();
+
+    // Register operand values.
+    Value input = op->getOperand(0);
+    Value output = op->getOperand(1);
+    Value sigmaX = op->getOperand(2);
+    Value sigmaY = op->getOperand(3);
+    Value constantValue = op->getOperand(4);
+    dip::BoundaryOption boundaryOptionAttr = op.getBoundaryOption();
+
+    if (failed(checkFilterOp(op, input, output, constantValue)))
+      return failure();
+
+    auto elemTy = input.getType().cast<MemRefType>().getElementType();
+    dip::gaussianBlur(rewriter, loc, ctx, input, output, sigmaX, sigmaY,
+                      constantValue, elemTy, boundaryOptionAttr, stride,
+                      tileRows);
+    // Remove the origin filter operation.
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  int64_t stride;
+  int64_t tileRows;
+};
+
+class DIPMedian2DOpLowering : public OpRewritePattern<dip::Median2DOp> {
+public:
+  using OpRewritePattern<dip::Median2DOp>::OpRewritePattern;
+
+  explicit DIPMedian2DOpLowering(MLIRContext *context, int64_t strideParam,
+                                 int64_t tileRowsParam)
+      : OpRewritePattern(context) {
+    stride = strideParam;
+    tileRows = tileRowsParam;
+  }
+
+  LogicalResult matchAndRewrite(dip::Median2DOp op,
+                                PatternRewriter &rewriter) const override {
+    auto loc = op->getLoc();
+    auto *ctx = op->getContext();
+
+    // Register operand values.
+    Value input = op->getOperand(0);
+    Value output = op->getOperand(1);
+    Value kernelSize = op->getOperand(2);
+    Value constantValue = op->getOperand(3);
+    dip::BoundaryOption boundaryOptionAttr = op.getBoundaryOption();
+
+    if (failed(checkFilterOp(op, input, output, constantValue)))
+      return failure();
+
+    auto elemTy = input.getType().cast<MemRefType>().getElementType();
+    dip::rankFilter(rewriter, loc, ctx, input, output, kernelSize,
+                    /*rank=*/Value(), constantValue, elemTy,
+                    boundaryOptionAttr, stride, tileRows);
+    // Remove the origin filter operation.
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  int64_t stride;
+  int64_t tileRows;
+};
+
+class DIPRankFilter2DOpLowering
+    : public OpRewritePattern<dip::RankFilter2DOp> {
+public:
+  using OpRewritePattern<dip::RankFilter2DOp>::OpRewritePattern;
+
+  explicit DIPRankFilter2DOpLowering(MLIRContext *context,
+                                     int64_t strideParam,
+                                     int64_t tileRowsParam)
+      : OpRewritePattern(context) {
+    stride = strideParam;
+    tileRows = tileRowsParam;
+  }
+
+  LogicalResult matchAndRewrite(dip::RankFilter2DOp op,
+                                PatternRewriter &rewriter) const override {
+    auto loc = op->getLoc();
+    auto *ctx = op->getContext();
+
+    // Register operand values.
+    Value input = op->getOperand(0);
+    Value output = op->getOperand(1);
+    Value kernelSize = op->getOperand(2);
+    Value rank = op->getOperand(3);
+    Value constantValue = op->getOperand(4);
+    dip::BoundaryOption boundaryOptionAttr = op.getBoundaryOption();
+
+    if (failed(checkFilterOp(op, input, output, constantValue)))
+      return failure();
+
+    auto elemTy = input.getType().cast<MemRefType>().getElementType();
+    dip::rankFilter(rewriter, loc, ctx, input, output, kernelSize, rank,
+                    constantValue, elemTy, boundaryOptionAttr, stride,
+                    tileRows);
+    // Remove the origin filter operation.
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  int64_t stride;
+  int64_t tileRows;
+};
+
+class DIPPyrDownOpLowering : public OpRewritePattern<dip::PyrDownOp> {
+public:
+  using OpRewritePattern<dip::PyrDownOp>::OpRewritePattern;
+
+  explicit DIPPyrDownOpLowering(MLIRContext *context, int64_t strideParam,
+                                int64_t tileRowsParam)
+      : OpRewritePattern(context) {
+    stride = strideParam;
+    tileRows = tileRowsParam;
+  }
+
+  LogicalResult matchAndRewrite(dip::PyrDownOp op,
+                                PatternRewriter &rewriter) const override {
+    auto loc = op->getLoc();
+    auto *ctx = op->getContext();
+
+    // Register operand values.
+    Value input = op->getOperand(0);
+    Value output = op->getOperand(1);
+    Value constantValue = op->getOperand(2);
+    dip::BoundaryOption boundaryOptionAttr = op.getBoundaryOption();
+
+    if (failed(checkFilterOp(op, input, output, constantValue)))
+      return failure();
+
+    auto elemTy = input.getType().cast<MemRefType>().getElementType();
+    dip::pyrDown(rewriter, loc, ctx, input, output, constantValue, elemTy,
+                 boundaryOptionAttr, stride, tileRows);
+    // Remove the origin pyr_down operation.
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  int64_t stride;
+  int64_t tileRows;
+};
+
+class DIPPyrUpOpLowering : public OpRewritePattern<dip::PyrUpOp> {
+public:
+  using OpRewritePattern<dip::PyrUpOp>::OpRewritePattern;
+
+  explicit DIPPyrUpOpLowering(MLIRContext *context, int64_t strideParam,
+                              int64_t tileRowsParam)
+      : OpRewritePattern(context) {
+    stride = strideParam;
+    tileRows = tileRowsParam;
+  }
+
+  LogicalResult matchAndRewrite(dip::PyrUpOp op,
+                                PatternRewriter &rewriter) const override {
+    auto loc = op->getLoc();
+    auto *ctx = op->getContext();
+
+    // Register operand values.
+    Value input = op->getOperand(0);
+    Value output = op->getOperand(1);
+    Value constantValue = op->getOperand(2);
+    dip::BoundaryOption boundaryOptionAttr = op.getBoundaryOption();
+
+    if (failed(checkFilterOp(op, input, output, constantValue)))
+      return failure();
+
+    auto elemTy = input.getType().cast<MemRefType>().getElementType();
+    dip::pyrUp(rewriter, loc, ctx, input, output, constantValue, elemTy,
+               boundaryOptionAttr, stride, tileRows);
+    // Remove the origin pyr_up operation.
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  int64_t stride;
+  int64_t tileRows;
+};
+
+// Checks that `image` is an unsigned 8-bit image of rank 2, or also 3 when
+// `allowInterleaved` is set.
+static LogicalResult checkU8Image(Operation *op, Value image,
+                                  bool allowInterleaved = false) {
+  auto imageTy = image.getType().cast<MemRefType>();
+  if (!imageTy.getElementType().isInteger(8)) {
+    return op->emitOpError() << "supports only 8-bit images. "
+                             << imageTy.getElementType() << " is passed";
+  }
+  if (imageTy.getRank() != 2 && (!allowInterleaved || imageTy.getRank() != 3))
+    return op->emitOpError() << (allowInterleaved
+                                     ? "input must be a HxW or HxWxC image"
+                                     : "input must be a HxW image");
+  return success();
+}
+
+// Checks that `table` is a rank 1 memref of 256 (or a dynamic number of)
+// `elemTy` values.
+static LogicalResult checkLevelTable(Operation *op, Value table, Type elemTy,
+                                     StringRef name) {
+  auto tableTy = table.getType().cast<MemRefType>();
+  if (tableTy.getRank() != 1 || tableTy.getElementType() != elemTy ||
+      (!tableTy.isDynamicDim(0) && tableTy.getDimSize(0) != 256)) {
+    return op->emitOpError()
+           << name << " must be a rank 1 memref of 256 " << elemTy;
+  }
+  return success();
+}
+
+class DIPHistogramOpLowering : public OpRewritePattern<dip::HistogramOp> {
+public:
+  using OpRewritePattern<dip::HistogramOp>::OpRewritePattern;
+
+  explicit DIPHistogramOpLowering(MLIRContext *context, int64_t strideParam,
+                                  int64_t tileRowsParam)
+      : OpRewritePattern(context) {
+    stride = strideParam;
+    tileRows = tileRowsParam;
+  }
+
+  LogicalResult matchAndRewrite(dip::HistogramOp op,
+                                PatternRewriter &rewriter) const override {
+    auto loc = op->getLoc();
+    auto *ctx = op->getContext();
+
+    // Register operand values.
+    Value input = op->getOperand(0);
+    Value hist = op->getOperand(1);
+
+    if (failed(checkU8Image(op, input)) ||
+        failed(checkLevelTable(op, hist, rewriter.getI32Type(), "hist")))
+      return failure();
+
+    dip::histogram(rewriter, loc, ctx, input, hist, stride, tileRows);
+    // Remove the origin histogram operation.
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  int64_t stride;
+  int64_t tileRows;
+};
+
+class DIPEqualizeHistOpLowering
+    : public OpRewritePattern<dip::EqualizeHistOp> {
+public:
+  using OpRewritePattern<dip::EqualizeHistOp>::OpRewritePattern;
+
+  explicit DIPEqualizeHistOpLowering(MLIRContext *context,
+                                     int64_t strideParam,
+                                     int64_t tileRowsParam)
+      : OpRewritePattern(context) {
+    stride = strideParam;
+    tileRows = tileRowsParam;
+  }
+
+  LogicalResult matchAndRewrite(dip::EqualizeHistOp op,
+                                PatternRewriter &rewriter) const override {
+    auto loc = op->getLoc();
+    auto *ctx = op->getContext();
+
+    // Register operand values.
+    Value input = op->getOperand(0);
+    Value output = op->getOperand(1);
+
+    if (failed(checkU8Image(op, input)) || failed(checkU8Image(op, output)))
+      return failure();
+
+    dip::equalizeHist(rewriter, loc, ctx, input, output, stride, tileRows);
+    // Remove the origin equalization operation.
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  int64_t stride;
+  int64_t tileRows;
+};
+
+class DIPApplyLutOpLowering : public OpRewritePattern<dip::ApplyLutOp> {
+public:
+  using OpRewritePattern<dip::ApplyLutOp>::OpRewritePattern;
+
+  explicit DIPApplyLutOpLowering(MLIRContext *context, int64_t strideParam,
+                                 int64_t tileRowsParam)
+      : OpRewritePattern(context) {
+    stride = strideParam;
+    tileRows = tileRowsParam;
+  }
+
+  LogicalResult matchAndRewrite(dip::ApplyLutOp op,
+                                PatternRewriter &rewriter) const override {
+    auto loc = op->getLoc();
+    auto *ctx = op->getContext();
+
+    // Register operand values.
+    Value input = op->getOperand(0);
+    Value lut = op->getOperand(1);
+    Value output = op->getOperand(2);
+
+    if (failed(checkU8Image(op, input, /*allowInterleaved=*/true)))
+      return failure();
+    auto outputTy = output.getType().cast<MemRefType>();
+    Type outElemTy = outputTy.getElementType();
+    if (outputTy.getRank() != input.getType().cast<MemRefType>().getRank()) {
+      return op->emitOpError() << "input and output must have the same rank";
+    }
+    if (failed(checkLevelTable(op, lut, outElemTy, "lut")))
+      return failure();
+
+    // Interleaved images share the table across channels.
+    dip::collapseChannels(rewriter, loc, input);
+    dip::collapseChannels(rewriter, loc, output);
+    dip::applyLut(rewriter, loc, ctx, input, lut, output, outElemTy, stride,
+                  tileRows);
+    // Remove the origin LUT operation.
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  int64_t stride;
+  int64_t tileRows;
 };
 
 class DIPCorrFFT2DOpLowering : public OpRewritePattern<dip::CorrFFT2DOp> {
@@ -101,8 +635,7 @@ public:
 
   explicit DIPCorrFFT2DOpLowering(MLIRContext *context, int64_t strideParam)
       : OpRewritePattern(context) {
-    // ToDO: Develop support for stride > 1 for improving performance.
-    stride = 1;
+    stride = strideParam;
   }
 
   LogicalResult matchAndRewrite(dip::CorrFFT2DOp op,
@@ -121,7 +654,6 @@ public:
     Value kernelImag = op->getOperand(3);
     Value intermediateReal = op->getOperand(4);
     Value intermediateImag = op->getOperand(5);
-    Value strideVal = rewriter.create<arith::ConstantIndexOp>(loc, stride);
 
     // Create DimOp for padded input image.
     Value inputRow = rewriter.create<memref::DimOp>(loc, inputReal, c0);
@@ -135,17 +667,114 @@ public:
     VectorType vectorTy32 = VectorType::get({stride}, f32);
 
     dft2D(rewriter, loc, inputReal, inputImag, inputRow, inputCol,
-          intermediateReal, intermediateImag, c0, c1, strideVal, vectorTy32);
+          intermediateReal, intermediateImag, c0, c1, vectorTy32);
 
     dft2D(rewriter, loc, kernelReal, kernelImag, kernelRow, kernelCol,
-          intermediateReal, intermediateImag, c0, c1, strideVal, vectorTy32);
+          intermediateReal, intermediateImag, c0, c1, vectorTy32);
 
     vector2DMemRefMultiply(rewriter, loc, inputReal, inputImag, kernelReal,
                            kernelImag, inputReal, inputImag, inputRow, inputCol,
                            c0, vectorTy32);
 
     idft2D(rewriter, loc, inputReal, inputImag, inputRow, inputCol,
-           intermediateReal, intermediateImag, c0, c1, strideVal, vectorTy32);
+           intermediateReal, intermediateImag, c0, c1, vectorTy32);
+
+    // Remove the origin convolution operation involving FFT.
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  int64_t stride;
+};
+
+class DIPFFT2DOpLowering : public OpRewritePattern<dip::FFT2DOp> {
+public:
+  using OpRewritePattern<dip::FFT2DOp>::OpRewritePattern;
+
+  explicit DIPFFT2DOpLowering(MLIRContext *context, int64_t strideParam)
+      : OpRewritePattern(context) {
+    stride = strideParam;
+  }
+
+  LogicalResult matchAndRewrite(dip::FFT2DOp op,
+                                PatternRewriter &rewriter) const override {
+    auto loc = op->getLoc();
+    auto ctx = op->getContext();
+
+    // Create constant indices.
+    Value c0 = rewriter.create<arith::ConstantIndexOp>(loc, 0);
+    Value c1 = rewriter.create<arith::ConstantIndexOp>(loc, 1);
+
+    // Register operand values.
+    Value real = op->getOperand(0);
+    Value imag = op->getOperand(1);
+    Value intermediateReal = op->getOperand(2);
+    Value intermediateImag = op->getOperand(3);
+
+    Value rows = rewriter.create<memref::DimOp>(loc, real, c0);
+    Value cols = rewriter.create<memref::DimOp>(loc, real, c1);
+
+    FloatType f32 = FloatType::getF32(ctx);
+    VectorType vectorTy32 = VectorType::get({stride}, f32);
+
+    dft2D(rewriter, loc, real, imag, rows, cols, intermediateReal,
+          intermediateImag, c0, c1, vectorTy32);
+
+    // Remove the origin FFT operation.
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  int64_t stride;
+};
+
+class DIPCorrFFT2DSpectrumOpLowering
+    : public OpRewritePattern<dip::CorrFFT2DSpectrumOp> {
+public:
+  using OpRewritePattern<dip::CorrFFT2DSpectrumOp>::OpRewritePattern;
+
+  explicit DIPCorrFFT2DSpectrumOpLowering(MLIRContext *context,
+                                          int64_t strideParam)
+      : OpRewritePattern(context) {
+    stride = strideParam;
+  }
+
+  LogicalResult matchAndRewrite(dip::CorrFFT2DSpectrumOp op,
+                                PatternRewriter &rewriter) const override {
+    auto loc = op->getLoc();
+    auto ctx = op->getContext();
+
+    // Create constant indices.
+    Value c0 = rewriter.create<arith::ConstantIndexOp>(loc, 0);
+    Value c1 = rewriter.create<arith::ConstantIndexOp>(loc, 1);
+
+    // Register operand values.
+    Value inputReal = op->getOperand(0);
+    Value inputImag = op->getOperand(1);
+    Value kernelSpectrumReal = op->getOperand(2);
+    Value kernelSpectrumImag = op->getOperand(3);
+    Value intermediateReal = op->getOperand(4);
+    Value intermediateImag = op->getOperand(5);
+
+    // Create DimOp for padded input image.
+    Value inputRow = rewriter.create<memref::DimOp>(loc, inputReal, c0);
+    Value inputCol = rewriter.create<memref::DimOp>(loc, inputReal, c1);
+
+    FloatType f32 = FloatType::getF32(ctx);
+    VectorType vectorTy32 = VectorType::get({stride}, f32);
+
+    // The kernel spectrum is precomputed, only the input is transformed.
+    dft2D(rewriter, loc, inputReal, inputImag, inputRow, inputCol,
+          intermediateReal, intermediateImag, c0, c1, vectorTy32);
+
+    vector2DMemRefMultiply(rewriter, loc, inputReal, inputImag,
+                           kernelSpectrumReal, kernelSpectrumImag, inputReal,
+                           inputImag, inputRow, inputCol, c0, vectorTy32);
+
+    idft2D(rewriter, loc, inputReal, inputImag, inputRow, inputCol,
+           intermediateReal, intermediateImag, c0, c1, vectorTy32);
 
     // Remove the origin convolution operation involving FFT.
     rewriter.eraseOp(op);
@@ -160,9 +789,11 @@ class DIPRotate2DOpLowering : public OpRewritePattern<dip::Rotate2DOp> {
 public:
   using OpRewritePattern<dip::Rotate2DOp>::OpRewritePattern;
 
-  explicit DIPRotate2DOpLowering(MLIRContext *context, int64_t strideParam)
+  explicit DIPRotate2DOpLowering(MLIRContext *context, int64_t strideParam,
+                                 int64_t tileRowsParam)
       : OpRewritePattern(context) {
     stride = strideParam;
+    tileRows = tileRowsParam;
   }
 
   LogicalResult matchAndRewrite(dip::Rotate2DOp op,
@@ -226,7 +857,7 @@ public:
         rewriter.create<arith::AddFOp>(loc, affineMatrix[5], deltaYFDiv2);
 
     dip::affineTransformController(rewriter, loc, ctx, input, output,
-                                   affineMatrix, stride);
+                                   affineMatrix, stride, tileRows);
 
     // Remove the origin rotation operation.
     rewriter.eraseOp(op);
@@ -234,15 +865,18 @@ public:
   }
 
   int64_t stride;
+  int64_t tileRows;
 };
 
 class DIPResize2DOpLowering : public OpRewritePattern<dip::Resize2DOp> {
 public:
   using OpRewritePattern<dip::Resize2DOp>::OpRewritePattern;
 
-  explicit DIPResize2DOpLowering(MLIRContext *context, int64_t strideParam)
+  explicit DIPResize2DOpLowering(MLIRContext *context, int64_t strideParam,
+                                 int64_t tileRowsParam)
       : OpRewritePattern(context) {
     stride = strideParam;
+    tileRows = tileRowsParam;
   }
 
   LogicalResult matchAndRewrite(dip::Resize2DOp op,
@@ -256,7 +890,6 @@ public:
     Value verticalScalingFactor = op->getOperand(2);
     Value output = op->getOperand(3);
     auto interpolationAttr = op.getInterpolationType();
-    Value strideVal = rewriter.create<arith::ConstantIndexOp>(loc, stride);
 
     auto inElemTy = input.getType().cast<MemRefType>().getElementType();
     dip::DIP_ERROR error =
@@ -270,103 +903,293 @@ public:
                                << inElemTy << "is passed";
     }
 
-    Value c0 = rewriter.create<arith::ConstantIndexOp>(loc, 0);
-    Value c1 = rewriter.create<arith::ConstantIndexOp>(loc, 1);
-    Value c0F32 = indexToF32(rewriter, loc, c0);
+    // Every interpolation type and element type uses the separable resizing
+    // with precomputed coefficient tables. Interleaved images are resized as
+    // HxWC images.
+    Value channels = dip::collapseChannels(rewriter, loc, input);
+    dip::collapseChannels(rewriter, loc, output);
+    dip::separableResizing(rewriter, loc, ctx, input, output,
+                           horizontalScalingFactor, verticalScalingFactor,
+                           inElemTy, interpolationAttr, stride, tileRows,
+                           channels);
 
-    Value inputRow = rewriter.create<memref::DimOp>(loc, input, c0);
-    Value inputCol = rewriter.create<memref::DimOp>(loc, input, c1);
+    // Remove the original resize operation.
+    rewriter.eraseOp(op);
+    return success();
+  }
 
-    Value outputRow = rewriter.create<memref::DimOp>(loc, output, c0);
-    Value outputCol = rewriter.create<memref::DimOp>(loc, output, c1);
+private:
+  int64_t stride;
+  int64_t tileRows;
+};
 
-    // Determine lower bound for second call of resize function (this is done
-    // for efficient tail processing).
-    Value outputColStrideRatio =
-        rewriter.create<arith::DivUIOp>(loc, outputCol, strideVal);
-    Value outputColMultiple =
-        rewriter.create<arith::MulIOp>(loc, strideVal, outputColStrideRatio);
+// Checks the element type of the operands of the warping operations and
+// lowers them with `lowerFn`. Interleaved HxWxC images are warped with the
+// channels of each pixel in consecutive columns.
+template <typename WarpOp>
+static LogicalResult
+lowerWarpOp(WarpOp op, PatternRewriter &rewriter, Value input, Value output,
+            Value constantValue, Value transform, Type transformElemTy,
+            StringRef transformName,
+            function_ref<void(Location, MLIRContext *, Type)> lowerFn) {
+  auto inElemTy = input.getType().cast<MemRefType>().getElementType();
+  dip::DIP_ERROR error =
+      dip::checkDIPCommonTypes<WarpOp>(op, {input, output, constantValue});
+
+  if (error == dip::DIP_ERROR::INCONSISTENT_TYPES) {
+    return op->emitOpError()
+           << "input, output and constant must have the same element type";
+  } else if (error == dip::DIP_ERROR::UNSUPPORTED_TYPE) {
+    return op->emitOpError() << "supports only f32, f64 and integer types. "
+                             << inElemTy << "is passed";
+  }
+  if (transform.getType().cast<MemRefType>().getElementType() !=
+      transformElemTy) {
+    return op->emitOpError()
+           << transformName << " must have " << transformElemTy
+           << " element type";
+  }
+
+  lowerFn(op->getLoc(), op->getContext(), inElemTy);
+  // Remove the origin warping operation.
+  rewriter.eraseOp(op);
+  return success();
+}
 
-    SmallVector<Value, 8> lowerBounds1{c0, c0};
-    SmallVector<Value, 8> upperBounds1{outputRow, outputColMultiple};
+class DIPWarpAffine2DOpLowering
+    : public OpRewritePattern<dip::WarpAffine2DOp> {
+public:
+  using OpRewritePattern<dip::WarpAffine2DOp>::OpRewritePattern;
 
-    SmallVector<int64_t, 8> steps{1, stride};
-    Value strideTailVal =
-        rewriter.create<arith::SubIOp>(loc, outputCol, outputColMultiple);
+  explicit DIPWarpAffine2DOpLowering(MLIRContext *context,
+                                     int64_t strideParam,
+                                     int64_t tileRowsParam)
+      : OpRewritePattern(context) {
+    stride = strideParam;
+    tileRows = tileRowsParam;
+  }
 
-    SmallVector<Value, 8> lowerBounds2{c0, outputColMultiple};
-    SmallVector<Value, 8> upperBounds2{outputRow, outputCol};
+  LogicalResult matchAndRewrite(dip::WarpAffine2DOp op,
+                                PatternRewriter &rewriter) const override {
+    // Register operand values.
+    Value input = op->getOperand(0);
+    Value matrix = op->getOperand(1);
+    Value output = op->getOperand(2);
+    Value constantValue = op->getOperand(3);
+    dip::BoundaryOption boundaryOptionAttr = op.getBoundaryOption();
 
-    FloatType f32 = FloatType::getF32(ctx);
-    VectorType vectorTy32 = VectorType::get({stride}, f32);
+    return lowerWarpOp(
+        op, rewriter, input, output, constantValue, matrix,
+        rewriter.getF32Type(), "matrix",
+        [&](Location loc, MLIRContext *ctx, Type elemTy) {
+          Value channels = dip::collapseChannels(rewriter, loc, input);
+          dip::collapseChannels(rewriter, loc, output);
+          dip::warpImage(rewriter, loc, ctx, input, matrix, output,
+                         constantValue, elemTy, boundaryOptionAttr,
+                         /*perspective=*/false, stride, tileRows, channels);
+        });
+  }
 
-    Value horizontalScalingFactorVec = rewriter.create<vector::SplatOp>(
-        loc, vectorTy32, horizontalScalingFactor);
-    Value verticalScalingFactorVec = rewriter.create<vector::SplatOp>(
-        loc, vectorTy32, verticalScalingFactor);
-
-    // Obtain extreme allocatable value(s) in input and output for bounding
-    // purpose.
-    Value inputRowLastElem = rewriter.create<arith::SubIOp>(loc, inputRow, c1);
-    Value inputRowLastElemF32 = indexToF32(rewriter, loc, inputRowLastElem);
-
-    Value inputColLastElem = rewriter.create<arith::SubIOp>(loc, inputCol, c1);
-    Value inputColLastElemF32 = indexToF32(rewriter, loc, inputColLastElem);
-
-    Value outputRowLastElem =
-        rewriter.create<arith::SubIOp>(loc, outputRow, c1);
-    Value outputRowLastElemF32 = indexToF32(rewriter, loc, outputRowLastElem);
-
-    Value outputColLastElem =
-        rewriter.create<arith::SubIOp>(loc, outputCol, c1);
-    Value outputColLastElemF32 = indexToF32(rewriter, loc, outputColLastElem);
-
-    if (interpolationAttr ==
-        dip::InterpolationType::NearestNeighbourInterpolation) {
-      dip::NearestNeighbourInterpolationResizing(
-          rewriter, loc, ctx, lowerBounds1, upperBounds1, steps, strideVal,
-          input, output, horizontalScalingFactorVec, verticalScalingFactorVec,
-          outputRowLastElemF32, outputColLastElemF32, inputRowLastElemF32,
-          inputColLastElemF32, vectorTy32, stride, c0, c0F32);
-
-      dip::NearestNeighbourInterpolationResizing(
-          rewriter, loc, ctx, lowerBounds2, upperBounds2, steps, strideTailVal,
-          input, output, horizontalScalingFactorVec, verticalScalingFactorVec,
-          outputRowLastElemF32, outputColLastElemF32, inputRowLastElemF32,
-          inputColLastElemF32, vectorTy32, stride, c0, c0F32);
-    } else if (interpolationAttr ==
-               dip::InterpolationType::BilinearInterpolation) {
-      Value c1F32 = indexToF32(rewriter, loc, c1);
-
-      dip::BilinearInterpolationResizing(
-          rewriter, loc, ctx, lowerBounds1, upperBounds1, steps, strideVal,
-          input, output, horizontalScalingFactorVec, verticalScalingFactorVec,
-          outputRowLastElemF32, outputColLastElemF32, inputRowLastElemF32,
-          inputColLastElemF32, vectorTy32, stride, c0, c0F32, c1F32);
-
-      dip::BilinearInterpolationResizing(
-          rewriter, loc, ctx, lowerBounds2, upperBounds2, steps, strideTailVal,
-          input, output, horizontalScalingFactorVec, verticalScalingFactorVec,
-          outputRowLastElemF32, outputColLastElemF32, inputRowLastElemF32,
-          inputColLastElemF32, vectorTy32, stride, c0, c0F32, c1F32);
+private:
+  int64_t stride;
+  int64_t tileRows;
+};
+
+class DIPWarpPerspective2DOpLowering
+    : public OpRewritePattern<dip::WarpPerspective2DOp> {
+public:
+  using OpRewritePattern<dip::WarpPerspective2DOp>::OpRewritePattern;
+
+  explicit DIPWarpPerspective2DOpLowering(MLIRContext *context,
+                                          int64_t strideParam,
+                                          int64_t tileRowsParam)
+      : OpRewritePattern(context) {
+    stride = strideParam;
+    tileRows = tileRowsParam;
+  }
+
+  LogicalResult matchAndRewrite(dip::WarpPerspective2DOp op,
+                                PatternRewriter &rewriter) const override {
+    // Register operand values.
+    Value input = op->getOperand(0);
+    Value matrix = op->getOperand(1);
+    Value output = op->getOperand(2);
+    Value constantValue = op->getOperand(3);
+    dip::BoundaryOption boundaryOptionAttr = op.getBoundaryOption();
+
+    return lowerWarpOp(
+        op, rewriter, input, output, constantValue, matrix,
+        rewriter.getF32Type(), "matrix",
+        [&](Location loc, MLIRContext *ctx, Type elemTy) {
+          Value channels = dip::collapseChannels(rewriter, loc, input);
+          dip::collapseChannels(rewriter, loc, output);
+          dip::warpImage(rewriter, loc, ctx, input, matrix, output,
+                         constantValue, elemTy, boundaryOptionAttr,
+                         /*perspective=*/true, stride, tileRows, channels);
+        });
+  }
+
+private:
+  int64_t stride;
+  int64_t tileRows;
+};
+
+class DIPWarpMap2DOpLowering : public OpRewritePattern<dip::WarpMap2DOp> {
+public:
+  using OpRewritePattern<dip::WarpMap2DOp>::OpRewritePattern;
+
+  explicit DIPWarpMap2DOpLowering(MLIRContext *context, int64_t strideParam,
+                                  int64_t tileRowsParam)
+      : OpRewritePattern(context) {
+    stride = strideParam;
+    tileRows = tileRowsParam;
+  }
+
+  LogicalResult matchAndRewrite(dip::WarpMap2DOp op,
+                                PatternRewriter &rewriter) const override {
+    auto loc = op->getLoc();
+    auto ctx = op->getContext();
+
+    // Register operand values.
+    Value matrix = op->getOperand(0);
+    Value map = op->getOperand(1);
+
+    if (!matrix.getType().cast<MemRefType>().getElementType().isF32()) {
+      return op->emitOpError() << "matrix must have f32 element type";
+    }
+    auto mapTy = map.getType().cast<MemRefType>();
+    if (mapTy.getRank() != 3 || !mapTy.getElementType().isInteger(32)) {
+      return op->emitOpError() << "map must be a rank 3 memref of i32";
     }
 
-    // Remove the original resize operation.
+    dip::buildWarpMap(rewriter, loc, ctx, matrix, map, stride, tileRows);
+
+    // Remove the origin map operation.
+    rewriter.eraseOp(op);
+    return success();
+  }
+
+private:
+  int64_t stride;
+  int64_t tileRows;
+};
+
+class DIPRemap2DOpLowering : public OpRewritePattern<dip::Remap2DOp> {
+public:
+  using OpRewritePattern<dip::Remap2DOp>::OpRewritePattern;
+
+  explicit DIPRemap2DOpLowering(MLIRContext *context, int64_t strideParam,
+                                int64_t tileRowsParam)
+      : OpRewritePattern(context) {
+    stride = strideParam;
+    tileRows = tileRowsParam;
+  }
+
+  LogicalResult matchAndRewrite(dip::Remap2DOp op,
+                                PatternRewriter &rewriter) const override {
+    // Register operand values.
+    Value input = op->getOperand(0);
+    Value map = op->getOperand(1);
+    Value output = op->getOperand(2);
+    Value constantValue = op->getOperand(3);
+    dip::BoundaryOption boundaryOptionAttr = op.getBoundaryOption();
+
+    return lowerWarpOp(
+        op, rewriter, input, output, constantValue, map,
+        rewriter.getI32Type(), "map",
+        [&](Location loc, MLIRContext *ctx, Type elemTy) {
+          Value channels = dip::collapseChannels(rewriter, loc, input);
+          dip::collapseChannels(rewriter, loc, output);
+          dip::remapImage(rewriter, loc, ctx, input, map, output,
+                          constantValue, elemTy, boundaryOptionAttr, stride,
+                          tileRows, channels);
+        });
+  }
+
+private:
+  int64_t stride;
+  int64_t tileRows;
+};
+
+class DIPImageToTensorOpLowering
+    : public OpRewritePattern<dip::ImageToTensorOp> {
+public:
+  using OpRewritePattern<dip::ImageToTensorOp>::OpRewritePattern;
+
+  explicit DIPImageToTensorOpLowering(MLIRContext *context,
+                                      int64_t strideParam,
+                                      int64_t tileRowsParam)
+      : OpRewritePattern(context) {
+    stride = strideParam;
+    tileRows = tileRowsParam;
+  }
+
+  LogicalResult matchAndRewrite(dip::ImageToTensorOp op,
+                                PatternRewriter &rewriter) const override {
+    auto loc = op->getLoc();
+    auto ctx = op->getContext();
+
+    // Register operand values.
+    Value input = op->getOperand(0);
+    Value output = op->getOperand(1);
+    Value batch = op->getOperand(2);
+    Value scale = op->getOperand(3);
+    Value mean = op->getOperand(4);
+    Value stdDev = op->getOperand(5);
+    auto interpolationAttr = op.getInterpolationType();
+
+    auto inputTy = input.getType().cast<MemRefType>();
+    Type inElemTy = inputTy.getElementType();
+    if (inputTy.getRank() != 2 && inputTy.getRank() != 3) {
+      return op->emitOpError() << "input must be a HxW or HxWxC image";
+    }
+    if (!inElemTy.isF32() && !inElemTy.isInteger(8) &&
+        !inElemTy.isInteger(16)) {
+      return op->emitOpError() << "supports only 8-bit, 16-bit and f32 "
+                                  "images. "
+                               << inElemTy << " is passed";
+    }
+    auto outputTy = output.getType().cast<MemRefType>();
+    if (outputTy.getRank() != 4 || !outputTy.getElementType().isF32()) {
+      return op->emitOpError() << "output must be a rank 4 memref of f32";
+    }
+    for (Value param : {mean, stdDev}) {
+      auto paramTy = param.getType().cast<MemRefType>();
+      if (paramTy.getRank() != 1 || !paramTy.getElementType().isF32()) {
+        return op->emitOpError() << "mean and std must be rank 1 memrefs of "
+                                    "f32";
+      }
+    }
+    if (interpolationAttr !=
+            dip::InterpolationType::NearestNeighbourInterpolation &&
+        interpolationAttr != dip::InterpolationType::BilinearInterpolation) {
+      return op->emitOpError() << "supports only nearest neighbour and "
+                                  "bilinear interpolation";
+    }
+
+    dip::imageToTensor(rewriter, loc, ctx, input, output, batch, scale, mean,
+                       stdDev, inElemTy, interpolationAttr, op.getLayout(),
+                       op.getSwapRb(), stride, tileRows);
+
+    // Remove the origin conversion operation.
     rewriter.eraseOp(op);
     return success();
   }
 
 private:
   int64_t stride;
+  int64_t tileRows;
 };
 
 class DIPErosion2DOpLowering : public OpRewritePattern<dip::Erosion2DOp> {
 public:
   using OpRewritePattern<dip::Erosion2DOp>::OpRewritePattern;
 
-  explicit DIPErosion2DOpLowering(MLIRContext *context, int64_t strideParam)
+  explicit DIPErosion2DOpLowering(MLIRContext *context, int64_t strideParam,
+                                  int64_t tileRowsParam)
       : OpRewritePattern(context) {
     stride = strideParam;
+    tileRows = tileRowsParam;
   }
 
   LogicalResult matchAndRewrite(dip::Erosion2DOp op,
@@ -416,10 +1239,10 @@ public:
                 builder.create<scf::YieldOp>(loc);
               });
           builder.create<memref::CopyOp>(loc, copymemref, output);
-          traverseImagewBoundaryExtrapolation(
+          traverseImageMorphology(
               rewriter, loc, ctx, input, kernel, output, centerX, centerY,
               constantValue, strideVal, inElemTy, boundaryOptionAttr, stride,
-              dip::DIP_OP::EROSION_2D);
+              dip::DIP_OP::EROSION_2D, tileRows);
           builder.create<affine::AffineYieldOp>(loc);
         });
 
@@ -430,6 +1253,7 @@ public:
 
 private:
   int64_t stride;
+  int64_t tileRows;
 };
 
 class DIPDilation2DOpLowering : public OpRewritePattern<dip::Dilation2DOp> {
@@ -437,9 +1261,11 @@ class DIPDilation2DOpLowering : public OpRewritePattern<dip::Dilation2DOp> {
 public:
   using OpRewritePattern<dip::Dilation2DOp>::OpRewritePattern;
 
-  explicit DIPDilation2DOpLowering(MLIRContext *context, int64_t strideParam)
+  explicit DIPDilation2DOpLowering(MLIRContext *context, int64_t strideParam,
+                                   int64_t tileRowsParam)
       : OpRewritePattern(context) {
     stride = strideParam;
+    tileRows = tileRowsParam;
   }
 
   LogicalResult matchAndRewrite(dip::Dilation2DOp op,
@@ -488,10 +1314,10 @@ public:
                 builder.create<scf::YieldOp>(loc);
               });
           builder.create<memref::CopyOp>(loc, copymemref, output);
-          traverseImagewBoundaryExtrapolation(
+          traverseImageMorphology(
               rewriter, loc, ctx, input, kernel, output, centerX, centerY,
               constantValue, strideVal, inElemTy, boundaryOptionAttr, stride,
-              dip::DIP_OP::DILATION_2D);
+              dip::DIP_OP::DILATION_2D, tileRows);
           builder.create<affine::AffineYieldOp>(loc);
         });
 
@@ -502,15 +1328,45 @@ public:
 
 private:
   int64_t stride;
+  int64_t tileRows;
 };
 
+// Emits `scf.if iterations == 1`. The then-branch computes the compound
+// morphological operation `op` tile by tile with `fusedMorphology`; the
+// insertion point is left in the else-branch for the iterative lowering
+// through full size intermediate images.
+static void createFusedMorphologyBranch(
+    PatternRewriter &rewriter, Location loc, MLIRContext *ctx, Value input,
+    Value kernel, Value output, Value copymemref, Value copymemref1,
+    Value centerX, Value centerY, Value iterations, Value constantValue,
+    Type elemTy, dip::BoundaryOption boundaryOptionAttr, int64_t stride,
+    dip::DIP_OP op, int64_t tileRows) {
+  Value c0 = rewriter.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = rewriter.create<arith::ConstantIndexOp>(loc, 1);
+  Value isSingleIteration = rewriter.create<arith::CmpIOp>(
+      loc, arith::CmpIPredicate::eq, iterations, c1);
+  auto ifOp = rewriter.create<scf::IfOp>(loc, isSingleIteration,
+                                         /*withElseRegion=*/true);
+  rewriter.setInsertionPointToStart(&ifOp.getThenRegion().front());
+  Value firstInit =
+      rewriter.create<memref::LoadOp>(loc, copymemref, ValueRange{c0, c0});
+  Value secondInit =
+      rewriter.create<memref::LoadOp>(loc, copymemref1, ValueRange{c0, c0});
+  dip::fusedMorphology(rewriter, loc, ctx, input, kernel, output, centerX,
+                       centerY, constantValue, firstInit, secondInit, elemTy,
+                       boundaryOptionAttr, stride, op, tileRows);
+  rewriter.setInsertionPointToStart(&ifOp.getElseRegion().front());
+}
+
 class DIPOpening2DOpLowering : public OpRewritePattern<dip::Opening2DOp> {
 public:
   using OpRewritePattern<dip::Opening2DOp>::OpRewritePattern;
 
-  explicit DIPOpening2DOpLowering(MLIRContext *context, int64_t strideParam)
+  explicit DIPOpening2DOpLowering(MLIRContext *context, int64_t strideParam,
+                                  int64_t tileRowsParam)
       : OpRewritePattern(context) {
     stride = strideParam;
+    tileRows = tileRowsParam;
   }
 
   LogicalResult matchAndRewrite(dip::Opening2DOp op,
@@ -547,6 +1403,11 @@ public:
     }
     Value c0 = rewriter.create<arith::ConstantIndexOp>(loc, 0);
     Value c1 = rewriter.create<arith::ConstantIndexOp>(loc, 1);
+    createFusedMorphologyBranch(rewriter, loc, ctx, input, kernel, output,
+                                copymemref, copymemref1, centerX, centerY,
+                                iterations, constantValue, inElemTy,
+                                boundaryOptionAttr, stride,
+                                dip::DIP_OP::OPENING_2D, tileRows);
 
     rewriter.create<affine::AffineForOp>(
         loc, ValueRange{c0}, rewriter.getDimIdentityMap(),
@@ -562,10 +1423,10 @@ public:
                 builder.create<scf::YieldOp>(loc);
               });
           builder.create<memref::CopyOp>(loc, copymemref, output1);
-          traverseImagewBoundaryExtrapolation(
+          traverseImageMorphology(
               rewriter, loc, ctx, input, kernel, output1, centerX, centerY,
               constantValue, strideVal, inElemTy, boundaryOptionAttr, stride,
-              dip::DIP_OP::EROSION_2D);
+              dip::DIP_OP::EROSION_2D, tileRows);
           builder.create<affine::AffineYieldOp>(loc);
         });
 
@@ -583,10 +1444,10 @@ public:
                 builder.create<scf::YieldOp>(loc);
               });
           builder.create<memref::CopyOp>(loc, copymemref1, output);
-          traverseImagewBoundaryExtrapolation(
+          traverseImageMorphology(
               rewriter, loc, ctx, output1, kernel, output, centerX, centerY,
               constantValue, strideVal, inElemTy, boundaryOptionAttr, stride,
-              dip::DIP_OP::DILATION_2D);
+              dip::DIP_OP::DILATION_2D, tileRows);
           builder.create<affine::AffineYieldOp>(loc);
         });
 
@@ -597,15 +1458,18 @@ public:
 
 private:
   int64_t stride;
+  int64_t tileRows;
 };
 
 class DIPClosing2DOpLowering : public OpRewritePattern<dip::Closing2DOp> {
 public:
   using OpRewritePattern<dip::Closing2DOp>::OpRewritePattern;
 
-  explicit DIPClosing2DOpLowering(MLIRContext *context, int64_t strideParam)
+  explicit DIPClosing2DOpLowering(MLIRContext *context, int64_t strideParam,
+                                  int64_t tileRowsParam)
       : OpRewritePattern(context) {
     stride = strideParam;
+    tileRows = tileRowsParam;
   }
 
   LogicalResult matchAndRewrite(dip::Closing2DOp op,
@@ -642,6 +1506,11 @@ public:
     }
     Value c0 = rewriter.create<arith::ConstantIndexOp>(loc, 0);
     Value c1 = rewriter.create<arith::ConstantIndexOp>(loc, 1);
+    createFusedMorphologyBranch(rewriter, loc, ctx, input, kernel, output,
+                                copymemref, copymemref1, centerX, centerY,
+                                iterations, constantValue, inElemTy,
+                                boundaryOptionAttr, stride,
+                                dip::DIP_OP::CLOSING_2D, tileRows);
 
     rewriter.create<affine::AffineForOp>(
         loc, ValueRange{c0}, rewriter.getDimIdentityMap(),
@@ -657,10 +1526,10 @@ public:
                 builder.create<scf::YieldOp>(loc);
               });
           builder.create<memref::CopyOp>(loc, copymemref, output1);
-          traverseImagewBoundaryExtrapolation(
+          traverseImageMorphology(
               rewriter, loc, ctx, input, kernel, output1, centerX, centerY,
               constantValue, strideVal, inElemTy, boundaryOptionAttr, stride,
-              dip::DIP_OP::DILATION_2D);
+              dip::DIP_OP::DILATION_2D, tileRows);
           builder.create<affine::AffineYieldOp>(loc);
         });
 
@@ -678,10 +1547,10 @@ public:
                 builder.create<scf::YieldOp>(loc);
               });
           builder.create<memref::CopyOp>(loc, copymemref1, output);
-          traverseImagewBoundaryExtrapolation(
+          traverseImageMorphology(
               rewriter, loc, ctx, output1, kernel, output, centerX, centerY,
               constantValue, strideVal, inElemTy, boundaryOptionAttr, stride,
-              dip::DIP_OP::EROSION_2D);
+              dip::DIP_OP::EROSION_2D, tileRows);
           builder.create<affine::AffineYieldOp>(loc);
         });
 
@@ -692,15 +1561,18 @@ public:
 
 private:
   int64_t stride;
+  int64_t tileRows;
 };
 
 class DIPTopHat2DOpLowering : public OpRewritePattern<dip::TopHat2DOp> {
 public:
   using OpRewritePattern<dip::TopHat2DOp>::OpRewritePattern;
 
-  explicit DIPTopHat2DOpLowering(MLIRContext *context, int64_t strideParam)
+  explicit DIPTopHat2DOpLowering(MLIRContext *context, int64_t strideParam,
+                                 int64_t tileRowsParam)
       : OpRewritePattern(context) {
     stride = strideParam;
+    tileRows = tileRowsParam;
   }
 
   LogicalResult matchAndRewrite(dip::TopHat2DOp op,
@@ -743,6 +1615,11 @@ public:
       return op->emitOpError() << "supports only f32, f64 and integer types. "
                                << inElemTy << "is passed";
     }
+    createFusedMorphologyBranch(rewriter, loc, ctx, input, kernel, output,
+                                copymemref, copymemref1, centerX, centerY,
+                                iterations, constantValue, inElemTy,
+                                boundaryOptionAttr, stride,
+                                dip::DIP_OP::TOPHAT_2D, tileRows);
     rewriter.create<memref::CopyOp>(loc, input, input1);
     rewriter.create<affine::AffineForOp>(
         loc, ValueRange{c0}, rewriter.getDimIdentityMap(),
@@ -758,10 +1635,10 @@ public:
                 builder.create<scf::YieldOp>(loc);
               });
           builder.create<memref::CopyOp>(loc, copymemref, output1);
-          traverseImagewBoundaryExtrapolation(
+          traverseImageMorphology(
               rewriter, loc, ctx, input1, kernel, output1, centerX, centerY,
               constantValue, strideVal, inElemTy, boundaryOptionAttr, stride,
-              dip::DIP_OP::EROSION_2D);
+              dip::DIP_OP::EROSION_2D, tileRows);
           builder.create<affine::AffineYieldOp>(loc);
         });
 
@@ -779,10 +1656,10 @@ public:
                 builder.create<scf::YieldOp>(loc);
               });
           builder.create<memref::CopyOp>(loc, copymemref1, output2);
-          traverseImagewBoundaryExtrapolation(
+          traverseImageMorphology(
               rewriter, loc, ctx, output1, kernel, output2, centerX, centerY,
               constantValue, strideVal, inElemTy, boundaryOptionAttr, stride,
-              dip::DIP_OP::DILATION_2D);
+              dip::DIP_OP::DILATION_2D, tileRows);
           builder.create<affine::AffineYieldOp>(loc);
         });
 
@@ -800,8 +1677,8 @@ public:
         rewriter.create<vector::BroadcastOp>(loc, vectorTy32, zeroPaddingElem);
 
     if (inElemTy.isF32() || inElemTy.isF64()) {
-      affine::buildAffineLoopNest(
-          rewriter, loc, lowerbounds4, upperbounds4, steps4,
+      buildRowTiledLoopNest(
+          rewriter, loc, lowerbounds4, upperbounds4, steps4, tileRows,
           [&](OpBuilder &builder, Location loc, ValueRange ivs4) {
             Value pseudoCol =
                 builder.create<arith::AddIOp>(loc, ivs4[1], strideVal);
@@ -844,8 +1721,8 @@ public:
 
       );
     } else if (inElemTy.isInteger(bitWidth)) {
-      affine::buildAffineLoopNest(
-          rewriter, loc, lowerbounds4, upperbounds4, steps4,
+      buildRowTiledLoopNest(
+          rewriter, loc, lowerbounds4, upperbounds4, steps4, tileRows,
           [&](OpBuilder &builder, Location loc, ValueRange ivs4) {
             Value pseudoCol =
                 builder.create<arith::AddIOp>(loc, ivs4[1], strideVal);
@@ -896,15 +1773,18 @@ public:
 
 private:
   int64_t stride;
+  int64_t tileRows;
 };
 
 class DIPBottomHat2DOpLowering : public OpRewritePattern<dip::BottomHat2DOp> {
 public:
   using OpRewritePattern<dip::BottomHat2DOp>::OpRewritePattern;
 
-  explicit DIPBottomHat2DOpLowering(MLIRContext *context, int64_t strideParam)
+  explicit DIPBottomHat2DOpLowering(MLIRContext *context, int64_t strideParam,
+                                    int64_t tileRowsParam)
       : OpRewritePattern(context) {
     stride = strideParam;
+    tileRows = tileRowsParam;
   }
 
   LogicalResult matchAndRewrite(dip::BottomHat2DOp op,
@@ -947,6 +1827,11 @@ public:
       return op->emitOpError() << "supports only f32, f64 and integer types. "
                                << inElemTy << "is passed";
     }
+    createFusedMorphologyBranch(rewriter, loc, ctx, input, kernel, output,
+                                copymemref, copymemref1, centerX, centerY,
+                                iterations, constantValue, inElemTy,
+                                boundaryOptionAttr, stride,
+                                dip::DIP_OP::BOTTOMHAT_2D, tileRows);
     rewriter.create<memref::CopyOp>(loc, input, input1);
     rewriter.create<affine::AffineForOp>(
         loc, ValueRange{c0}, rewriter.getDimIdentityMap(),
@@ -962,10 +1847,10 @@ public:
                 builder.create<scf::YieldOp>(loc);
               });
           builder.create<memref::CopyOp>(loc, copymemref, output1);
-          traverseImagewBoundaryExtrapolation(
+          traverseImageMorphology(
               rewriter, loc, ctx, input1, kernel, output1, centerX, centerY,
               constantValue, strideVal, inElemTy, boundaryOptionAttr, stride,
-              dip::DIP_OP::DILATION_2D);
+              dip::DIP_OP::DILATION_2D, tileRows);
           builder.create<affine::AffineYieldOp>(loc);
         });
 
@@ -983,10 +1868,10 @@ public:
                 builder.create<scf::YieldOp>(loc);
               });
           builder.create<memref::CopyOp>(loc, copymemref1, output2);
-          traverseImagewBoundaryExtrapolation(
+          traverseImageMorphology(
               rewriter, loc, ctx, output1, kernel, output2, centerX, centerY,
               constantValue, strideVal, inElemTy, boundaryOptionAttr, stride,
-              dip::DIP_OP::EROSION_2D);
+              dip::DIP_OP::EROSION_2D, tileRows);
           builder.create<affine::AffineYieldOp>(loc);
         });
 
@@ -1005,8 +1890,8 @@ public:
         rewriter.create<vector::BroadcastOp>(loc, vectorTy32, zeroPaddingElem);
 
     if (inElemTy.isF32() || inElemTy.isF64()) {
-      affine::buildAffineLoopNest(
-          rewriter, loc, lowerbounds4, upperbounds4, steps4,
+      buildRowTiledLoopNest(
+          rewriter, loc, lowerbounds4, upperbounds4, steps4, tileRows,
           [&](OpBuilder &builder, Location loc, ValueRange ivs4) {
             Value pseudoCol =
                 builder.create<arith::AddIOp>(loc, ivs4[1], strideVal);
@@ -1049,8 +1934,8 @@ public:
 
       );
     } else if (inElemTy.isInteger(bitWidth)) {
-      affine::buildAffineLoopNest(
-          rewriter, loc, lowerbounds4, upperbounds4, steps4,
+      buildRowTiledLoopNest(
+          rewriter, loc, lowerbounds4, upperbounds4, steps4, tileRows,
           [&](OpBuilder &builder, Location loc, ValueRange ivs4) {
             Value pseudoCol =
                 builder.create<arith::AddIOp>(loc, ivs4[1], strideVal);
@@ -1098,15 +1983,18 @@ public:
 
 private:
   int64_t stride;
+  int64_t tileRows;
 };
 
 class DIPMorphGrad2DOpLowering : public OpRewritePattern<dip::MorphGrad2DOp> {
 public:
   using OpRewritePattern<dip::MorphGrad2DOp>::OpRewritePattern;
 
-  explicit DIPMorphGrad2DOpLowering(MLIRContext *context, int64_t strideParam)
+  explicit DIPMorphGrad2DOpLowering(MLIRContext *context, int64_t strideParam,
+                                    int64_t tileRowsParam)
       : OpRewritePattern(context) {
     stride = strideParam;
+    tileRows = tileRowsParam;
   }
 
   LogicalResult matchAndRewrite(dip::MorphGrad2DOp op,
@@ -1147,6 +2035,11 @@ public:
     }
     Value c0 = rewriter.create<arith::ConstantIndexOp>(loc, 0);
     Value c1 = rewriter.create<arith::ConstantIndexOp>(loc, 1);
+    createFusedMorphologyBranch(rewriter, loc, ctx, input, kernel, output,
+                                copymemref, copymemref1, centerX, centerY,
+                                iterations, constantValue, inElemTy,
+                                boundaryOptionAttr, stride,
+                                dip::DIP_OP::MORPHGRAD_2D, tileRows);
     rewriter.create<memref::CopyOp>(loc, input, input1);
 
     rewriter.create<affine::AffineForOp>(
@@ -1163,10 +2056,10 @@ public:
                 builder.create<scf::YieldOp>(loc);
               });
           builder.create<memref::CopyOp>(loc, copymemref, output1);
-          traverseImagewBoundaryExtrapolation(
+          traverseImageMorphology(
               rewriter, loc, ctx, input, kernel, output1, centerX, centerY,
               constantValue, strideVal, inElemTy, boundaryOptionAttr, stride,
-              dip::DIP_OP::DILATION_2D);
+              dip::DIP_OP::DILATION_2D, tileRows);
           builder.create<affine::AffineYieldOp>(loc);
         });
 
@@ -1184,10 +2077,10 @@ public:
                 builder.create<scf::YieldOp>(loc);
               });
           builder.create<memref::CopyOp>(loc, copymemref1, output2);
-          traverseImagewBoundaryExtrapolation(
+          traverseImageMorphology(
               rewriter, loc, ctx, input1, kernel, output2, centerX, centerY,
               constantValue, strideVal, inElemTy, boundaryOptionAttr, stride,
-              dip::DIP_OP::EROSION_2D);
+              dip::DIP_OP::EROSION_2D, tileRows);
           builder.create<affine::AffineYieldOp>(loc);
         });
 
@@ -1206,8 +2099,8 @@ public:
         rewriter.create<vector::BroadcastOp>(loc, vectorTy32, zeroPaddingElem);
 
     if (inElemTy.isF32() || inElemTy.isF64()) {
-      affine::buildAffineLoopNest(
-          rewriter, loc, lowerbounds4, upperbounds4, steps4,
+      buildRowTiledLoopNest(
+          rewriter, loc, lowerbounds4, upperbounds4, steps4, tileRows,
           [&](OpBuilder &builder, Location loc, ValueRange ivs4) {
             Value pseudoCol =
                 builder.create<arith::AddIOp>(loc, ivs4[1], strideVal);
@@ -1250,8 +2143,8 @@ public:
 
       );
     } else if (inElemTy.isInteger(bitWidth)) {
-      affine::buildAffineLoopNest(
-          rewriter, loc, lowerbounds4, upperbounds4, steps4,
+      buildRowTiledLoopNest(
+          rewriter, loc, lowerbounds4, upperbounds4, steps4, tileRows,
           [&](OpBuilder &builder, Location loc, ValueRange ivs4) {
             Value pseudoCol =
                 builder.create<arith::AddIOp>(loc, ivs4[1], strideVal);
@@ -1298,23 +2191,52 @@ public:
 
 private:
   int64_t stride;
+  int64_t tileRows;
 };
 
 } // end anonymous namespace
 
 void populateLowerDIPConversionPatterns(RewritePatternSet &patterns,
-                                        int64_t stride) {
-  patterns.add<DIPCorr2DOpLowering>(patterns.getContext(), stride);
+                                        int64_t stride, int64_t tileRows) {
+  patterns.add<DIPCorr2DOpLowering>(patterns.getContext(), stride, tileRows);
+  patterns.add<DIPCorr2DSeparableOpLowering>(patterns.getContext(), stride);
+  patterns.add<DIPIntegralImageOpLowering>(patterns.getContext(), stride);
+  patterns.add<DIPBoxFilterOpLowering>(patterns.getContext(), stride, tileRows);
+  patterns.add<DIPGaussianBlurOpLowering>(patterns.getContext(), stride,
+                                          tileRows);
+  patterns.add<DIPMedian2DOpLowering>(patterns.getContext(), stride, tileRows);
+  patterns.add<DIPRankFilter2DOpLowering>(patterns.getContext(), stride,
+                                          tileRows);
+  patterns.add<DIPPyrDownOpLowering>(patterns.getContext(), stride, tileRows);
+  patterns.add<DIPPyrUpOpLowering>(patterns.getContext(), stride, tileRows);
+  patterns.add<DIPHistogramOpLowering>(patterns.getContext(), stride, tileRows);
+  patterns.add<DIPEqualizeHistOpLowering>(patterns.getContext(), stride,
+                                          tileRows);
+  patterns.add<DIPApplyLutOpLowering>(patterns.getContext(), stride, tileRows);
   patterns.add<DIPCorrFFT2DOpLowering>(patterns.getContext(), stride);
-  patterns.add<DIPRotate2DOpLowering>(patterns.getContext(), stride);
-  patterns.add<DIPResize2DOpLowering>(patterns.getContext(), stride);
-  patterns.add<DIPErosion2DOpLowering>(patterns.getContext(), stride);
-  patterns.add<DIPDilation2DOpLowering>(patterns.getContext(), stride);
-  patterns.add<DIPOpening2DOpLowering>(patterns.getContext(), stride);
-  patterns.add<DIPClosing2DOpLowering>(patterns.getContext(), stride);
-  patterns.add<DIPTopHat2DOpLowering>(patterns.getContext(), stride);
-  patterns.add<DIPBottomHat2DOpLowering>(patterns.getContext(), stride);
-  patterns.add<DIPMorphGrad2DOpLowering>(patterns.getContext(), stride);
+  patterns.add<DIPFFT2DOpLowering>(patterns.getContext(), stride);
+  patterns.add<DIPCorrFFT2DSpectrumOpLowering>(patterns.getContext(), stride);
+  patterns.add<DIPRotate2DOpLowering>(patterns.getContext(), stride, tileRows);
+  patterns.add<DIPResize2DOpLowering>(patterns.getContext(), stride, tileRows);
+  patterns.add<DIPWarpAffine2DOpLowering>(patterns.getContext(), stride,
+                                         tileRows);
+  patterns.add<DIPWarpPerspective2DOpLowering>(patterns.getContext(), stride,
+                                              tileRows);
+  patterns.add<DIPWarpMap2DOpLowering>(patterns.getContext(), stride,
+                                       tileRows);
+  patterns.add<DIPRemap2DOpLowering>(patterns.getContext(), stride, tileRows);
+  patterns.add<DIPImageToTensorOpLowering>(patterns.getContext(), stride,
+                                          tileRows);
+  patterns.add<DIPErosion2DOpLowering>(patterns.getContext(), stride, tileRows);
+  patterns.add<DIPDilation2DOpLowering>(patterns.getContext(), stride,
+                                        tileRows);
+  patterns.add<DIPOpening2DOpLowering>(patterns.getContext(), stride, tileRows);
+  patterns.add<DIPClosing2DOpLowering>(patterns.getContext(), stride, tileRows);
+  patterns.add<DIPTopHat2DOpLowering>(patterns.getContext(), stride, tileRows);
+  patterns.add<DIPBottomHat2DOpLowering>(patterns.getContext(), stride,
+                                         tileRows);
+  patterns.add<DIPMorphGrad2DOpLowering>(patterns.getContext(), stride,
+                                         tileRows);
 }
 
 //===----------------------------------------------------------------------===//
@@ -1344,6 +2266,12 @@ public:
   Option<int64_t> stride{*this, "DIP-strip-mining",
                          llvm::cl::desc("Strip mining size."),
                          llvm::cl::init(32)};
+
+  Option<int64_t> tileRows{
+      *this, "DIP-parallel-tile-rows",
+      llvm::cl::desc("Height of the row tiles processed in parallel; 0 keeps "
+                     "the sequential row loops."),
+      llvm::cl::init(0)};
 };
 } // end anonymous namespace.
 
@@ -1359,7 +2287,7 @@ void LowerDIPPass::runOnOperation() {
   target.addLegalOp<ModuleOp, func::FuncOp, func::ReturnOp>();
 
   RewritePatternSet patterns(context);
-  populateLowerDIPConversionPatterns(patterns, stride);
+  populateLowerDIPConversionPatterns(patterns, stride, tileRows);
 
   if (failed(applyPartialConversion(module, target, std::move(patterns))))
     signalPassFailure();
@@ -115,7 +115,7 @@ void affineTransformCore(OpBuilder &builder, Location loc, Value input,
                          Value output, Value yStart, Value yEnd, Value xStart,
                          Value xEnd, Value m1, Value m4, Value xAddr1,
                          Value xAddr2, int64_t stride, const int &RSV_BITS,
-                         int interp_type) {
+                         int interp_type, int64_t tileRows) {
   Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
   Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
   Value c_rsv = builder.create<arith::ConstantOp>(
@@ -136,42 +136,54 @@ void affineTransformCore(OpBuilder &builder, Location loc, Value input,
   MemRefType resFracPartType =
       MemRefType::get({2, BLOCK_SZ / 2, BLOCK_SZ * 2},
                       IntegerType::get(builder.getContext(), 8));
-  Value resIntPart = builder.create<memref::AllocOp>(loc, resIntPartType);
-  Value resFracPart = builder.create<memref::AllocOp>(loc, resFracPartType);
 
   Value rowStride = builder.create<arith::ConstantIndexOp>(loc, BLOCK_SZ / 2);
   Value colStride = builder.create<arith::ConstantIndexOp>(loc, BLOCK_SZ * 2);
 #undef BLOCK_SZ
 
-  builder.create<scf::ForOp>(
-      loc, yStart, yEnd, rowStride, std::nullopt,
-      [&](OpBuilder &yBuilder, Location yLoc, Value yiv, ValueRange) {
-        Value realYEnd = yBuilder.create<arith::MinUIOp>(
-            yLoc, yEnd, yBuilder.create<arith::AddIOp>(yLoc, yiv, rowStride));
-        Value rows = yBuilder.create<arith::SubIOp>(yLoc, realYEnd, yiv);
-        yBuilder.create<scf::ForOp>(
-            yLoc, xStart, xEnd, colStride, std::nullopt,
-            [&](OpBuilder &xBuilder, Location xLoc, Value xiv, ValueRange) {
-              Value realXEnd = xBuilder.create<arith::MinUIOp>(
-                  xLoc, xEnd,
-                  xBuilder.create<arith::AddIOp>(xLoc, xiv, colStride));
-              Value cols = xBuilder.create<arith::SubIOp>(xLoc, realXEnd, xiv);
-              affineTransformCoreTiled(xBuilder, xLoc, resIntPart, resFracPart,
-                                       yiv, realYEnd, xiv, realXEnd, m1, m4,
-                                       xAddr1, xAddr2, rsvValVec, strideVal, c0,
-                                       c1, c_rsv, stride);
-
-              // remap
-              remapNearest(xBuilder, xLoc, input, output, resIntPart, yiv, xiv,
-                           rows, cols);
-
-              xBuilder.create<scf::YieldOp>(xLoc);
+  // Each row tile owns its remap buffers, so that parallel tiles do not share
+  // them.
+  buildRowTileLoop(
+      builder, loc, yStart, yEnd, tileRows,
+      [&](OpBuilder &builder, Location loc, Value tileStart, Value tileEnd) {
+        Value resIntPart =
+            builder.create<memref::AllocOp>(loc, resIntPartType);
+        Value resFracPart =
+            builder.create<memref::AllocOp>(loc, resFracPartType);
+
+        builder.create<scf::ForOp>(
+            loc, tileStart, tileEnd, rowStride, std::nullopt,
+            [&](OpBuilder &yBuilder, Location yLoc, Value yiv, ValueRange) {
+              Value realYEnd = yBuilder.create<arith::MinUIOp>(
+                  yLoc, tileEnd,
+                  yBuilder.create<arith::AddIOp>(yLoc, yiv, rowStride));
+              Value rows = yBuilder.create<arith::SubIOp>(yLoc, realYEnd, yiv);
+              yBuilder.create<scf::ForOp>(
+                  yLoc, xStart, xEnd, colStride, std::nullopt,
+                  [&](OpBuilder &xBuilder, Location xLoc, Value xiv,
+                      ValueRange) {
+                    Value realXEnd = xBuilder.create<arith::MinUIOp>(
+                        xLoc, xEnd,
+                        xBuilder.create<arith::AddIOp>(xLoc, xiv, colStride));
+                    Value cols =
+                        xBuilder.create<arith::SubIOp>(xLoc, realXEnd, xiv);
+                    affineTransformCoreTiled(
+                        xBuilder, xLoc, resIntPart, resFracPart, yiv,
+                        realYEnd, xiv, realXEnd, m1, m4, xAddr1, xAddr2,
+                        rsvValVec, strideVal, c0, c1, c_rsv, stride);
+
+                    // remap
+                    remapNearest(xBuilder, xLoc, input, output, resIntPart,
+                                 yiv, xiv, rows, cols);
+
+                    xBuilder.create<scf::YieldOp>(xLoc);
+                  });
+              yBuilder.create<scf::YieldOp>(yLoc);
             });
-        yBuilder.create<scf::YieldOp>(yLoc);
-      });
 
-  builder.create<memref::DeallocOp>(loc, resIntPart);
-  builder.create<memref::DeallocOp>(loc, resFracPart);
+        builder.create<memref::DeallocOp>(loc, resIntPart);
+        builder.create<memref::DeallocOp>(loc, resFracPart);
+      });
 }
 
 void remapNearest(OpBuilder &builder, Location loc, Value input, Value output,
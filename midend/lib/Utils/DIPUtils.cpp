@@ -30,6 +30,8 @@
 #include <mlir/Dialect/SCF/IR/SCF.h>
 #include <mlir/Dialect/Vector/IR/VectorOps.h>
 #include <mlir/IR/MLIRContext.h>
+#include <mlir/IR/SymbolTable.h>
+#include <mlir/IR/TypeUtilities.h>
 #include <mlir/IR/Value.h>
 #include <numeric>
 #include <vector>
@@ -48,12 +50,41 @@ template DIP_ERROR
 checkDIPCommonTypes<dip::Corr2DOp>(dip::Corr2DOp,
                                    const std::vector<Value> &args);
 template DIP_ERROR
+checkDIPCommonTypes<dip::Corr2DSeparableOp>(dip::Corr2DSeparableOp,
+                                            const std::vector<Value> &args);
+template DIP_ERROR
+checkDIPCommonTypes<dip::BoxFilterOp>(dip::BoxFilterOp,
+                                      const std::vector<Value> &args);
+template DIP_ERROR
+checkDIPCommonTypes<dip::GaussianBlurOp>(dip::GaussianBlurOp,
+                                         const std::vector<Value> &args);
+template DIP_ERROR
+checkDIPCommonTypes<dip::Median2DOp>(dip::Median2DOp,
+                                     const std::vector<Value> &args);
+template DIP_ERROR
+checkDIPCommonTypes<dip::RankFilter2DOp>(dip::RankFilter2DOp,
+                                         const std::vector<Value> &args);
+template DIP_ERROR
+checkDIPCommonTypes<dip::PyrDownOp>(dip::PyrDownOp,
+                                    const std::vector<Value> &args);
+template DIP_ERROR
+checkDIPCommonTypes<dip::PyrUpOp>(dip::PyrUpOp,
+                                  const std::vector<Value> &args);
+template DIP_ERROR
 checkDIPCommonTypes<dip::Rotate2DOp>(dip::Rotate2DOp,
                                      const std::vector<Value> &args);
 template DIP_ERROR
 checkDIPCommonTypes<dip::Resize2DOp>(dip::Resize2DOp,
                                      const std::vector<Value> &args);
 template DIP_ERROR
+checkDIPCommonTypes<dip::WarpAffine2DOp>(dip::WarpAffine2DOp,
+                                         const std::vector<Value> &args);
+template DIP_ERROR checkDIPCommonTypes<dip::WarpPerspective2DOp>(
+    dip::WarpPerspective2DOp, const std::vector<Value> &args);
+template DIP_ERROR
+checkDIPCommonTypes<dip::Remap2DOp>(dip::Remap2DOp,
+                                    const std::vector<Value> &args);
+template DIP_ERROR
 checkDIPCommonTypes<dip::Erosion2DOp>(dip::Erosion2DOp,
                                       const std::vector<Value> &args);
 template DIP_ERROR
@@ -103,6 +134,21 @@ DIP_ERROR checkDIPCommonTypes(DIPOP op, const std::vector<Value> &args) {
       return DIP_ERROR::INCONSISTENT_TYPES;
     }
 
+    if (notSameElementTypeForMemrefs(inElemTy)) {
+      return DIP_ERROR::UNSUPPORTED_TYPE;
+    }
+  } else if (op->getName().stripDialect() == "corr_2d_separable") {
+    auto inElemTy = getElementType(0);
+    auto kXElemTy = getElementType(1);
+    auto kYElemTy = getElementType(2);
+    auto outElemTy = getElementType(3);
+    auto constElemTy = getType(4);
+
+    if (inElemTy != kXElemTy || kXElemTy != kYElemTy ||
+        kYElemTy != outElemTy || outElemTy != constElemTy) {
+      return DIP_ERROR::INCONSISTENT_TYPES;
+    }
+
     if (notSameElementTypeForMemrefs(inElemTy)) {
       return DIP_ERROR::UNSUPPORTED_TYPE;
     }
@@ -117,6 +163,26 @@ DIP_ERROR checkDIPCommonTypes(DIPOP op, const std::vector<Value> &args) {
 
     // NB: we can infer element type for all related memrefs to be the same as
     // input since we verified that the operand types are the same.
+    if (notSameElementTypeForMemrefs(inElemTy)) {
+      return DIP_ERROR::UNSUPPORTED_TYPE;
+    }
+  } else if (op->getName().stripDialect() == "warp_affine_2d" ||
+             op->getName().stripDialect() == "warp_perspective_2d" ||
+             op->getName().stripDialect() == "remap_2d" ||
+             op->getName().stripDialect() == "box_filter" ||
+             op->getName().stripDialect() == "gaussian_blur" ||
+             op->getName().stripDialect() == "median_2d" ||
+             op->getName().stripDialect() == "rank_filter_2d" ||
+             op->getName().stripDialect() == "pyr_down" ||
+             op->getName().stripDialect() == "pyr_up") {
+    auto inElemTy = getElementType(0);
+    auto outElemTy = getElementType(1);
+    auto constElemTy = getType(2);
+
+    if (inElemTy != outElemTy || outElemTy != constElemTy) {
+      return DIP_ERROR::INCONSISTENT_TYPES;
+    }
+
     if (notSameElementTypeForMemrefs(inElemTy)) {
       return DIP_ERROR::UNSUPPORTED_TYPE;
     }
@@ -478,7 +544,7 @@ inline void inverseAffineMatrix(OpBuilder &builder, Location loc,
 void affineTransformController(OpBuilder &builder, Location loc,
                                MLIRContext *ctx, Value input, Value output,
                                SmallVector<Value, 6> affineMatrix,
-                               int64_t stride) {
+                               int64_t stride, int64_t tileRows) {
   VectorType vectorTyF32 = VectorType::get({stride}, FloatType::getF32(ctx));
   VectorType vectorTyI32 = VectorType::get({stride}, IntegerType::get(ctx, 32));
 
@@ -565,7 +631,7 @@ void affineTransformController(OpBuilder &builder, Location loc,
 
   affineTransformCore(builder, loc, input, output, c0Index, outputRow, c0Index,
                       outputCol, affineMatrix[1], affineMatrix[4], xMm0, xMm3,
-                      stride, RSV_BITS, 0);
+                      stride, RSV_BITS, 0, tileRows);
 
   builder.create<memref::DeallocOp>(loc, xMm0);
   builder.create<memref::DeallocOp>(loc, xMm3);
@@ -648,164 +714,1095 @@ void standardRotateController(
       });
 }
 
-// Fills pixels in bilinear interpolation fashion.
-void fillPixelsBilinearInterpolate(
-    OpBuilder &builder, Location loc, Value resXVec, Value resYVec,
-    Value xVec_L, Value yVec_L, Value xVec_H, Value yVec_H, Value input,
-    Value output, Value c0, Value strideVal, Value xVecWeight, Value yVecWeight,
-    Value outputRowLastElemF32, Value outputColLastElemF32,
-    Value inputRowLastElemF32, Value inputColLastElemF32, Value c0F32,
-    Value c1F32) {
-  builder.create<affine::AffineForOp>(
-      loc, ValueRange{c0}, builder.getDimIdentityMap(), ValueRange{strideVal},
-      builder.getDimIdentityMap(), /*step*/ 1, std::nullopt,
-      [&](OpBuilder &builder, Location loc, ValueRange ivs,
-          ValueRange iterArg) {
-        std::vector<Value> resIndices =
-            extractIndices(builder, loc, resXVec, resYVec, ivs[0],
-                           outputColLastElemF32, outputRowLastElemF32, c0F32);
+Value collapseChannels(OpBuilder &builder, Location loc, Value &image) {
+  auto imageTy = image.getType().cast<MemRefType>();
+  if (imageTy.getRank() != 3)
+    return nullptr;
+  Value c2 = builder.create<arith::ConstantIndexOp>(loc, 2);
+  Value channels = builder.create<memref::DimOp>(loc, image, c2);
+  image = builder.create<memref::CollapseShapeOp>(
+      loc, image, ArrayRef<ReassociationIndices>{{0}, {1, 2}});
+  return channels;
+}
 
-        std::vector<Value> inputIndices_L =
-            extractIndices(builder, loc, xVec_L, yVec_L, ivs[0],
-                           inputColLastElemF32, inputRowLastElemF32, c0F32);
-        std::vector<Value> inputIndices_H =
-            extractIndices(builder, loc, xVec_H, yVec_H, ivs[0],
-                           inputColLastElemF32, inputRowLastElemF32, c0F32);
+// Number of fractional bits of the fixed-point resizing coefficients of
+// integer images.
+static constexpr int64_t kResizeCoefBits = 11;
+
+// Rounds a f32 value towards negative infinity and casts it to index type.
+static Value floorToIndex(OpBuilder &builder, Location loc, Value val) {
+  Value floorVal = builder.create<math::FloorOp>(loc, val);
+  Value interm1 = builder.create<arith::FPToSIOp>(loc, builder.getI32Type(),
+                                                  floorVal);
+  return builder.create<arith::IndexCastOp>(loc, builder.getIndexType(),
+                                            interm1);
+}
 
-        std::vector<Value> indexWeights;
-        Value xPos_temp =
-            builder.create<vector::ExtractElementOp>(loc, xVecWeight, ivs[0]);
-        Value yPos_temp =
-            builder.create<vector::ExtractElementOp>(loc, yVecWeight, ivs[0]);
+// Number of source pixels contributing to one output pixel of
+// `separableResizing` along an axis with scaling factor `scale`.
+static Value resizeTaps(OpBuilder &builder, Location loc, Value scale,
+                        dip::InterpolationType type) {
+  switch (type) {
+  case dip::InterpolationType::NearestNeighbourInterpolation:
+    return builder.create<arith::ConstantIndexOp>(loc, 1);
+  case dip::InterpolationType::BilinearInterpolation:
+    return builder.create<arith::ConstantIndexOp>(loc, 2);
+  case dip::InterpolationType::BicubicInterpolation:
+    return builder.create<arith::ConstantIndexOp>(loc, 4);
+  case dip::InterpolationType::AreaInterpolation:
+    break;
+  }
+  Value ceilScale = builder.create<math::CeilOp>(loc, scale);
+  return builder.create<arith::AddIOp>(
+      loc, F32ToIndex(builder, loc, ceilScale),
+      builder.create<arith::ConstantIndexOp>(loc, 1));
+}
 
-        indexWeights.push_back(
-            valBound(builder, loc, xPos_temp, inputColLastElemF32, c0F32));
-        indexWeights.push_back(
-            valBound(builder, loc, yPos_temp, inputRowLastElemF32, c0F32));
+// Fills the coefficient tables of one axis of `separableResizing`. Entry
+// (k, i) of `indices` is the source position of tap k of output position i,
+// clamped to the image, and entry (k, i) of `weights` is its weight. Weights
+// of integer images are fixed-point values with `kResizeCoefBits` fractional
+// bits.
+static void buildResizeTable(OpBuilder &builder, Location loc, Value outSize,
+                             Value inSize, Value scale, Value taps,
+                             Value indices, Value weights,
+                             dip::InterpolationType type, Type accTy,
+                             Value channels = nullptr) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value inLast = builder.create<arith::SubIOp>(loc, inSize, c1);
+  FloatType f32 = builder.getF32Type();
+  auto f32Const = [&](float val) -> Value {
+    return builder.create<arith::ConstantFloatOp>(loc, APFloat(val), f32);
+  };
+  Value zeroF32 = f32Const(0.f), oneF32 = f32Const(1.f);
+  // Coefficient of the bicubic convolution kernel.
+  Value a = f32Const(-0.75f);
+
+  builder.create<scf::ForOp>(
+      loc, c0, outSize, c1, ValueRange{},
+      [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange) {
+        Value pos = indexToF32(builder, loc, iv[0]);
+        Value lo = builder.create<arith::MulFOp>(loc, pos, scale);
+        Value hi = builder.create<arith::AddFOp>(loc, lo, scale);
+        Value base;
+        if (type == dip::InterpolationType::NearestNeighbourInterpolation)
+          base = roundOff(builder, loc, lo);
+        else
+          base = builder.create<math::FloorOp>(loc, lo);
+        Value frac = builder.create<arith::SubFOp>(loc, lo, base);
+        Value baseIdx = floorToIndex(builder, loc, base);
+        if (type == dip::InterpolationType::BicubicInterpolation)
+          baseIdx = builder.create<arith::SubIOp>(loc, baseIdx, c1);
+
+        builder.create<scf::ForOp>(
+            loc, c0, taps, c1, ValueRange{},
+            [&](OpBuilder &builder, Location loc, ValueRange iv1, ValueRange) {
+              Value tap = indexToF32(builder, loc, iv1[0]);
+              Value src = builder.create<arith::AddIOp>(loc, baseIdx, iv1[0]);
+              Value weight;
+              switch (type) {
+              case dip::InterpolationType::NearestNeighbourInterpolation:
+                weight = oneF32;
+                break;
+              case dip::InterpolationType::BilinearInterpolation: {
+                Value isFirst = builder.create<arith::CmpIOp>(
+                    loc, arith::CmpIPredicate::eq, iv1[0], c0);
+                weight = builder.create<arith::SelectOp>(
+                    loc, isFirst,
+                    builder.create<arith::SubFOp>(loc, oneF32, frac), frac);
+                break;
+              }
+              case dip::InterpolationType::BicubicInterpolation: {
+                // Keys' kernel at the distance d between the sample and the
+                // tap: (a + 2)d^3 - (a + 3)d^2 + 1 for d <= 1 and
+                // a(d^3 - 5d^2 + 8d - 4) for 1 < d < 2.
+                Value d = builder.create<math::AbsFOp>(
+                    loc, builder.create<arith::SubFOp>(
+                             loc, builder.create<arith::AddFOp>(loc, frac,
+                                                                oneF32),
+                             tap));
+                Value d2 = builder.create<arith::MulFOp>(loc, d, d);
+                Value d3 = builder.create<arith::MulFOp>(loc, d2, d);
+                Value near = builder.create<arith::AddFOp>(
+                    loc,
+                    builder.create<arith::SubFOp>(
+                        loc,
+                        builder.create<arith::MulFOp>(
+                            loc, builder.create<arith::AddFOp>(
+                                     loc, a, f32Const(2.f)),
+                            d3),
+                        builder.create<arith::MulFOp>(
+                            loc, builder.create<arith::AddFOp>(
+                                     loc, a, f32Const(3.f)),
+                            d2)),
+                    oneF32);
+                Value far = builder.create<arith::SubFOp>(
+                    loc,
+                    builder.create<arith::AddFOp>(
+                        loc,
+                        builder.create<arith::SubFOp>(
+                            loc, d3,
+                            builder.create<arith::MulFOp>(loc, f32Const(5.f),
+                                                          d2)),
+                        builder.create<arith::MulFOp>(loc, f32Const(8.f), d)),
+                    f32Const(4.f));
+                Value isNear = builder.create<arith::CmpFOp>(
+                    loc, arith::CmpFPredicate::OLE, d, oneF32);
+                weight = builder.create<arith::SelectOp>(
+                    loc, isNear, near,
+                    builder.create<arith::MulFOp>(loc, a, far));
+                break;
+              }
+              case dip::InterpolationType::AreaInterpolation: {
+                // Overlap of source pixel `src` with the footprint [lo, hi)
+                // of the output pixel, relative to the footprint size.
+                Value srcF32 = builder.create<arith::AddFOp>(loc, base, tap);
+                Value srcEnd =
+                    builder.create<arith::AddFOp>(loc, srcF32, oneF32);
+                Value overlap = builder.create<arith::SubFOp>(
+                    loc, builder.create<arith::MinimumFOp>(loc, srcEnd, hi),
+                    builder.create<arith::MaximumFOp>(loc, srcF32, lo));
+                overlap = builder.create<arith::MaximumFOp>(loc, overlap,
+                                                            zeroF32);
+                weight = builder.create<arith::DivFOp>(loc, overlap, scale);
+                break;
+              }
+              }
+
+              Value clampedSrc = builder.create<arith::MinSIOp>(
+                  loc, builder.create<arith::MaxSIOp>(loc, src, c0), inLast);
+              if (accTy.isa<IntegerType>()) {
+                Value scaled = builder.create<arith::MulFOp>(
+                    loc, weight, f32Const(float(1 << kResizeCoefBits)));
+                weight = builder.create<arith::FPToSIOp>(
+                    loc, builder.getI32Type(), roundOff(builder, loc, scaled));
+                if (accTy.getIntOrFloatBitWidth() > 32)
+                  weight = builder.create<arith::ExtSIOp>(loc, accTy, weight);
+              } else if (!accTy.isF32()) {
+                weight = builder.create<arith::ExtFOp>(loc, accTy, weight);
+              }
+              // Stores the tap of column `col` reading source column `src`.
+              auto storeTap = [&](OpBuilder &builder, Location loc, Value col,
+                                  Value src) {
+                Value srcI32 = builder.create<arith::IndexCastOp>(
+                    loc, builder.getI32Type(), src);
+                builder.create<memref::StoreOp>(loc, srcI32, indices,
+                                                ValueRange{iv1[0], col});
+                builder.create<memref::StoreOp>(loc, weight, weights,
+                                                ValueRange{iv1[0], col});
+              };
+              if (!channels) {
+                storeTap(builder, loc, iv[0], clampedSrc);
+                builder.create<scf::YieldOp>(loc);
+                return;
+              }
+              // Interleaved images repeat the tap for every channel of the
+              // pixel.
+              Value colBase =
+                  builder.create<arith::MulIOp>(loc, iv[0], channels);
+              Value srcBase =
+                  builder.create<arith::MulIOp>(loc, clampedSrc, channels);
+              builder.create<scf::ForOp>(
+                  loc, c0, channels, c1, ValueRange{},
+                  [&](OpBuilder &builder, Location loc, ValueRange iv2,
+                      ValueRange) {
+                    storeTap(
+                        builder, loc,
+                        builder.create<arith::AddIOp>(loc, colBase, iv2[0]),
+                        builder.create<arith::AddIOp>(loc, srcBase, iv2[0]));
+                    builder.create<scf::YieldOp>(loc);
+                  });
+              builder.create<scf::YieldOp>(loc);
+            });
+        builder.create<scf::YieldOp>(loc);
+      });
+}
 
-        std::vector<Value> indexWeights_UnitComplements = {
-            builder.create<arith::SubFOp>(loc, c1F32, indexWeights[0]),
-            builder.create<arith::SubFOp>(loc, c1F32, indexWeights[1])};
+void separableResizing(OpBuilder &builder, Location loc, MLIRContext *ctx,
+                       Value input, Value output,
+                       Value horizontalScalingFactor,
+                       Value verticalScalingFactor, Type elemTy,
+                       dip::InterpolationType type, int64_t stride,
+                       int64_t tileRows, Value channels) {
+  // Create constant indices.
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value strideVal = builder.create<arith::ConstantIndexOp>(loc, stride);
 
-        Value pixelVal_a = builder.create<memref::LoadOp>(
-            loc, builder.getF32Type(), input,
-            ValueRange{inputIndices_L[1], inputIndices_L[0]});
-        Value pixelVal_b = builder.create<memref::LoadOp>(
-            loc, builder.getF32Type(), input,
-            ValueRange{inputIndices_H[1], inputIndices_L[0]});
-        Value pixelVal_c = builder.create<memref::LoadOp>(
-            loc, builder.getF32Type(), input,
-            ValueRange{inputIndices_L[1], inputIndices_H[0]});
-        Value pixelVal_d = builder.create<memref::LoadOp>(
-            loc, builder.getF32Type(), input,
-            ValueRange{inputIndices_H[1], inputIndices_H[0]});
-
-        Value weightVal1 =
-            builder.create<arith::MulFOp>(loc, indexWeights_UnitComplements[0],
-                                          indexWeights_UnitComplements[1]);
-        Value weightVal2 = builder.create<arith::MulFOp>(
-            loc, indexWeights[0], indexWeights_UnitComplements[1]);
-        Value weightVal3 = builder.create<arith::MulFOp>(
-            loc, indexWeights[1], indexWeights_UnitComplements[0]);
-        Value weightVal4 = builder.create<arith::MulFOp>(loc, indexWeights[0],
-                                                         indexWeights[1]);
-
-        Value interm1 =
-            builder.create<arith::MulFOp>(loc, pixelVal_a, weightVal1);
-        Value interm2 =
-            builder.create<arith::MulFOp>(loc, pixelVal_b, weightVal2);
-        Value interm3 =
-            builder.create<arith::MulFOp>(loc, pixelVal_c, weightVal3);
-        Value interm4 =
-            builder.create<arith::MulFOp>(loc, pixelVal_d, weightVal4);
-
-        Value pixel_interm1 =
-            builder.create<arith::AddFOp>(loc, interm1, interm2);
-        Value pixel_interm2 =
-            builder.create<arith::AddFOp>(loc, interm3, interm4);
-        Value pixel_interm3 =
-            builder.create<arith::AddFOp>(loc, pixel_interm1, pixel_interm2);
-
-        Value pixelVal = roundOff(builder, loc, pixel_interm3);
+  // Create DimOp.
+  Value inputRow = builder.create<memref::DimOp>(loc, input, c0);
+  Value inputCol = builder.create<memref::DimOp>(loc, input, c1);
+  Value outputRow = builder.create<memref::DimOp>(loc, output, c0);
+  Value outputCol = builder.create<memref::DimOp>(loc, output, c1);
+
+  // Integer images accumulate fixed-point values in the narrowest type that
+  // holds both passes: i32 for 8-bit pixels, i64 for 16-bit and 32-bit pixels
+  // and i128 for 64-bit pixels. 8-bit and 16-bit pixels are unsigned, wider
+  // pixels are signed.
+  bool isFloat = elemTy.isF32() || elemTy.isF64();
+  unsigned bitWidth = elemTy.getIntOrFloatBitWidth();
+  bool isUnsigned = !isFloat && bitWidth <= 16;
+  Type accTy = elemTy;
+  if (!isFloat)
+    accTy = IntegerType::get(ctx, bitWidth <= 8    ? 32
+                                  : bitWidth <= 32 ? 64
+                                                   : 128);
+  unsigned accWidth = accTy.getIntOrFloatBitWidth();
+  IntegerType i32 = builder.getI32Type();
+
+  VectorType vectorTy = VectorType::get({stride}, elemTy);
+  VectorType accVecTy = VectorType::get({stride}, accTy);
+  VectorType indexVecTy = VectorType::get({stride}, i32);
+  VectorType vectorMaskTy = VectorType::get({stride}, IntegerType::get(ctx, 1));
+  Value zeroElem = insertZeroConstantOp(ctx, builder, loc, elemTy);
+  Value zeroVec = builder.create<vector::BroadcastOp>(loc, vectorTy, zeroElem);
+  Value accZero = insertZeroConstantOp(ctx, builder, loc, accTy);
+  Value accZeroVec =
+      builder.create<vector::BroadcastOp>(loc, accVecTy, accZero);
+  Value indexZeroVec = builder.create<vector::BroadcastOp>(
+      loc, indexVecTy, builder.create<arith::ConstantIntOp>(loc, 0, i32));
+
+  // Coefficient tables, computed once for the pair of image sizes.
+  Value xTaps = resizeTaps(builder, loc, horizontalScalingFactor, type);
+  Value yTaps = resizeTaps(builder, loc, verticalScalingFactor, type);
+  MemRefType indexTableTy =
+      MemRefType::get({ShapedType::kDynamic, ShapedType::kDynamic}, i32);
+  MemRefType weightTableTy =
+      MemRefType::get({ShapedType::kDynamic, ShapedType::kDynamic}, accTy);
+  Value xIndices = builder.create<memref::AllocOp>(
+      loc, indexTableTy, ValueRange{xTaps, outputCol});
+  Value xWeights = builder.create<memref::AllocOp>(
+      loc, weightTableTy, ValueRange{xTaps, outputCol});
+  Value yIndices = builder.create<memref::AllocOp>(
+      loc, indexTableTy, ValueRange{yTaps, outputRow});
+  Value yWeights = builder.create<memref::AllocOp>(
+      loc, weightTableTy, ValueRange{yTaps, outputRow});
+  // Columns of interleaved images hold the channels of each pixel, and the
+  // horizontal tables have one column per channel.
+  Value inputWidth = inputCol, outputWidth = outputCol;
+  if (channels) {
+    inputWidth = builder.create<arith::DivUIOp>(loc, inputCol, channels);
+    outputWidth = builder.create<arith::DivUIOp>(loc, outputCol, channels);
+  }
+  buildResizeTable(builder, loc, outputWidth, inputWidth,
+                   horizontalScalingFactor, xTaps, xIndices, xWeights, type,
+                   accTy, channels);
+  buildResizeTable(builder, loc, outputRow, inputRow, verticalScalingFactor,
+                   yTaps, yIndices, yWeights, type, accTy);
+
+  // Converts the accumulated fixed-point values back to pixels, rounding to
+  // the nearest integer and saturating to the range of the image.
+  auto finalize = [&](OpBuilder &builder, Location loc, Value acc) -> Value {
+    if (isFloat)
+      return acc;
+    auto accConst = [&](const APInt &val) -> Value {
+      return builder.create<vector::BroadcastOp>(
+          loc, accVecTy,
+          builder.create<arith::ConstantOp>(
+              loc, builder.getIntegerAttr(accTy, val)));
+    };
+    unsigned shift = 2 * kResizeCoefBits;
+    APInt minVal = isUnsigned
+                       ? APInt::getMinValue(bitWidth).zext(accWidth)
+                       : APInt::getSignedMinValue(bitWidth).sext(accWidth);
+    APInt maxVal = isUnsigned
+                       ? APInt::getMaxValue(bitWidth).zext(accWidth)
+                       : APInt::getSignedMaxValue(bitWidth).sext(accWidth);
+    Value half = accConst(APInt::getOneBitSet(accWidth, shift - 1));
+    Value res = builder.create<arith::ShRSIOp>(
+        loc, builder.create<arith::AddIOp>(loc, acc, half),
+        accConst(APInt(accWidth, shift)));
+    res = builder.create<arith::MaxSIOp>(loc, res, accConst(minVal));
+    res = builder.create<arith::MinSIOp>(loc, res, accConst(maxVal));
+    return builder.create<arith::TruncIOp>(loc, vectorTy, res);
+  };
 
-        builder.create<memref::StoreOp>(
-            loc, pixelVal, output, ValueRange{resIndices[1], resIndices[0]});
+  MemRefType rowTy = MemRefType::get({ShapedType::kDynamic}, accTy);
+  buildRowTileLoop(
+      builder, loc, c0, outputRow, tileRows,
+      [&](OpBuilder &builder, Location loc, Value rowBegin, Value rowEnd) {
+        Value rowBuffer = builder.create<memref::AllocOp>(loc, rowTy, inputCol);
+        builder.create<scf::ForOp>(
+            loc, rowBegin, rowEnd, c1, ValueRange{},
+            [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange) {
+              // Vertical pass over contiguous input columns.
+              builder.create<scf::ForOp>(
+                  loc, c0, inputCol, strideVal, ValueRange{},
+                  [&](OpBuilder &builder, Location loc, ValueRange iv1,
+                      ValueRange) {
+                    Value mask = tailMaskCreator(builder, loc, inputCol, iv1[0],
+                                                 vectorMaskTy);
+                    auto tapLoop = builder.create<scf::ForOp>(
+                        loc, c0, yTaps, c1, ValueRange{accZeroVec},
+                        [&](OpBuilder &builder, Location loc, ValueRange iv2,
+                            ValueRange acc) {
+                          Value srcRow = builder.create<arith::IndexCastOp>(
+                              loc, builder.getIndexType(),
+                              builder.create<memref::LoadOp>(
+                                  loc, yIndices, ValueRange{iv2[0], iv[0]}));
+                          Value weight = builder.create<memref::LoadOp>(
+                              loc, yWeights, ValueRange{iv2[0], iv[0]});
+                          Value weightVec = builder.create<vector::BroadcastOp>(
+                              loc, accVecTy, weight);
+                          Value inputVec = builder.create<vector::MaskedLoadOp>(
+                              loc, vectorTy, input, ValueRange{srcRow, iv1[0]},
+                              mask, zeroVec);
+                          if (isUnsigned)
+                            inputVec = builder.create<arith::ExtUIOp>(
+                                loc, accVecTy, inputVec);
+                          else if (!isFloat)
+                            inputVec = builder.create<arith::ExtSIOp>(
+                                loc, accVecTy, inputVec);
+                          Value res = insertFMAOp(builder, loc, accVecTy,
+                                                  inputVec, weightVec, acc[0]);
+                          builder.create<scf::YieldOp>(loc, res);
+                        });
+                    builder.create<vector::MaskedStoreOp>(
+                        loc, rowBuffer, iv1[0], mask, tapLoop.getResult(0));
+                    builder.create<scf::YieldOp>(loc);
+                  });
 
-        builder.create<affine::AffineYieldOp>(loc);
+              // Horizontal pass, gathering the taps from the row buffer.
+              builder.create<scf::ForOp>(
+                  loc, c0, outputCol, strideVal, ValueRange{},
+                  [&](OpBuilder &builder, Location loc, ValueRange iv1,
+                      ValueRange) {
+                    Value mask = tailMaskCreator(builder, loc, outputCol,
+                                                 iv1[0], vectorMaskTy);
+                    auto tapLoop = builder.create<scf::ForOp>(
+                        loc, c0, xTaps, c1, ValueRange{accZeroVec},
+                        [&](OpBuilder &builder, Location loc, ValueRange iv2,
+                            ValueRange acc) {
+                          Value srcCols = builder.create<vector::MaskedLoadOp>(
+                              loc, indexVecTy, xIndices,
+                              ValueRange{iv2[0], iv1[0]}, mask, indexZeroVec);
+                          Value weightVec =
+                              builder.create<vector::MaskedLoadOp>(
+                                  loc, accVecTy, xWeights,
+                                  ValueRange{iv2[0], iv1[0]}, mask, accZeroVec);
+                          Value rowVec = builder.create<vector::GatherOp>(
+                              loc, accVecTy, rowBuffer, ValueRange{c0},
+                              srcCols, mask, accZeroVec);
+                          Value res = insertFMAOp(builder, loc, accVecTy,
+                                                  rowVec, weightVec, acc[0]);
+                          builder.create<scf::YieldOp>(loc, res);
+                        });
+                    Value res = finalize(builder, loc, tapLoop.getResult(0));
+                    builder.create<vector::MaskedStoreOp>(
+                        loc, output, ValueRange{iv[0], iv1[0]}, mask, res);
+                    builder.create<scf::YieldOp>(loc);
+                  });
+              builder.create<scf::YieldOp>(loc);
+            });
+        builder.create<memref::DeallocOp>(loc, rowBuffer);
       });
+
+  for (Value table : {xIndices, xWeights, yIndices, yWeights})
+    builder.create<memref::DeallocOp>(loc, table);
 }
 
-// Helper function for resizing an image using nearest neighbour interpolation
-// mechanism.
-void NearestNeighbourInterpolationResizing(
-    OpBuilder &builder, Location loc, MLIRContext *ctx,
-    SmallVector<Value, 8> lowerBounds, SmallVector<Value, 8> upperBounds,
-    SmallVector<int64_t, 8> steps, Value strideVal, Value input, Value output,
-    Value horizontalScalingFactorVec, Value verticalScalingFactorVec,
-    Value outputRowLastElemF32, Value outputColLastElemF32,
-    Value inputRowLastElemF32, Value inputColLastElemF32, VectorType vectorTy32,
-    int64_t stride, Value c0, Value c0F32) {
-  affine::buildAffineLoopNest(
-      builder, loc, lowerBounds, upperBounds, steps,
-      [&](OpBuilder &builder, Location loc, ValueRange ivs) {
-        Value ivs0F32 = indexToF32(builder, loc, ivs[0]);
-        Value yVec = builder.create<vector::SplatOp>(loc, vectorTy32, ivs0F32);
-        Value xVec = iotaVec(builder, loc, ctx, ivs[1], strideVal, vectorTy32,
-                             c0, stride);
+// Number of fractional bits of the fixed-point source positions of the
+// warping operations.
+static constexpr int64_t kWarpCoordBits = 5;
+
+// Loads the coefficients of a warping matrix in row-major order. The last row
+// is only loaded for perspective transformations and is (0, 0, 1) when the
+// matrix has two rows.
+static SmallVector<Value, 9> loadWarpMatrix(OpBuilder &builder, Location loc,
+                                            Value matrix, bool perspective) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value c2 = builder.create<arith::ConstantIndexOp>(loc, 2);
+  Value c3 = builder.create<arith::ConstantIndexOp>(loc, 3);
+
+  SmallVector<Value, 9> coefs;
+  for (Value row : {c0, c1})
+    for (Value col : {c0, c1, c2})
+      coefs.push_back(
+          builder.create<memref::LoadOp>(loc, matrix, ValueRange{row, col}));
+  if (!perspective)
+    return coefs;
+
+  Value matrixRow = builder.create<memref::DimOp>(loc, matrix, c0);
+  Value hasLastRow = builder.create<arith::CmpIOp>(
+      loc, arith::CmpIPredicate::eq, matrixRow, c3);
+  auto lastRow = builder.create<scf::IfOp>(
+      loc, hasLastRow,
+      [&](OpBuilder &builder, Location loc) {
+        SmallVector<Value, 3> row;
+        for (Value col : {c0, c1, c2})
+          row.push_back(
+              builder.create<memref::LoadOp>(loc, matrix, ValueRange{c2, col}));
+        builder.create<scf::YieldOp>(loc, row);
+      },
+      [&](OpBuilder &builder, Location loc) {
+        FloatType f32 = builder.getF32Type();
+        Value zero =
+            builder.create<arith::ConstantFloatOp>(loc, APFloat(0.f), f32);
+        Value one =
+            builder.create<arith::ConstantFloatOp>(loc, APFloat(1.f), f32);
+        builder.create<scf::YieldOp>(loc, ValueRange{zero, zero, one});
+      });
+  coefs.append(lastRow.getResults().begin(), lastRow.getResults().end());
+  return coefs;
+}
+
+// Computes the fixed-point source positions of the output pixels at the f32
+// columns `xVec` of row `y`. Positions are clamped to +/-2^25 pixels so that
+// they fit in i32.
+static void warpPositions(OpBuilder &builder, Location loc,
+                          ArrayRef<Value> coefs, Value xVec, Value y,
+                          bool perspective, int64_t stride, Value &srcX,
+                          Value &srcY) {
+  VectorType vectorTy32 = VectorType::get({stride}, builder.getF32Type());
+  VectorType indexVecTy = VectorType::get({stride}, builder.getI32Type());
+  auto splat = [&](Value val) -> Value {
+    return builder.create<vector::SplatOp>(loc, vectorTy32, val);
+  };
+  auto f32Splat = [&](float val) -> Value {
+    return splat(builder.create<arith::ConstantFloatOp>(
+        loc, APFloat(val), builder.getF32Type()));
+  };
 
-        Value resXVecInterm = builder.create<arith::MulFOp>(
-            loc, xVec, horizontalScalingFactorVec);
-        Value resYVecInterm =
-            builder.create<arith::MulFOp>(loc, yVec, verticalScalingFactorVec);
+  Value yF32 = indexToF32(builder, loc, y);
+  // Row `i` of the matrix applied to the pixels; the contribution of `y` is
+  // shared by the whole vector.
+  auto project = [&](int64_t i) -> Value {
+    Value rowTerm = builder.create<arith::AddFOp>(
+        loc, builder.create<arith::MulFOp>(loc, coefs[3 * i + 1], yF32),
+        coefs[3 * i + 2]);
+    return insertFMAOp(builder, loc, vectorTy32, xVec, splat(coefs[3 * i]),
+                       splat(rowTerm));
+  };
 
-        Value resXVec = roundOff(builder, loc, resXVecInterm);
-        Value resYVec = roundOff(builder, loc, resYVecInterm);
+  Value posX = project(0);
+  Value posY = project(1);
+  if (perspective) {
+    // Points mapped to infinity are sampled at the origin.
+    Value w = project(2);
+    Value zeroVec = f32Splat(0.f);
+    Value isInfinite = builder.create<arith::CmpFOp>(
+        loc, arith::CmpFPredicate::OEQ, w, zeroVec);
+    Value invW = builder.create<arith::SelectOp>(
+        loc, isInfinite, zeroVec,
+        builder.create<arith::DivFOp>(loc, f32Splat(1.f), w));
+    posX = builder.create<arith::MulFOp>(loc, posX, invW);
+    posY = builder.create<arith::MulFOp>(loc, posY, invW);
+  }
 
-        fillPixels(builder, loc, xVec, yVec, resXVec, resYVec, input, output,
-                   c0, strideVal, outputRowLastElemF32, outputColLastElemF32,
-                   inputRowLastElemF32, inputColLastElemF32, c0F32);
+  float scale = float(int64_t(1) << kWarpCoordBits);
+  float bound = float(int64_t(1) << 30);
+  auto toFixed = [&](Value pos) -> Value {
+    Value scaled = builder.create<arith::MulFOp>(loc, pos, f32Splat(scale));
+    scaled = builder.create<arith::MaximumFOp>(loc, scaled, f32Splat(-bound));
+    scaled = builder.create<arith::MinimumFOp>(loc, scaled, f32Splat(bound));
+    return builder.create<arith::FPToSIOp>(loc, indexVecTy,
+                                           roundOff(builder, loc, scaled));
+  };
+  srcX = toFixed(posX);
+  srcY = toFixed(posY);
+}
+
+// Splits the columns [x, x + stride) of an image collapsed by
+// `collapseChannels` into the i32 vectors of their pixel columns and channels.
+static void splitChannels(OpBuilder &builder, Location loc, Value x,
+                          Value channels, int64_t stride, Value &pixelVec,
+                          Value &channelVec) {
+  IntegerType i32 = builder.getI32Type();
+  VectorType indexVecTy = VectorType::get({stride}, i32);
+  std::vector<int32_t> iota(stride);
+  std::iota(iota.begin(), iota.end(), 0);
+  Value iotaVec = builder.create<arith::ConstantOp>(
+      loc, DenseIntElementsAttr::get(indexVecTy, ArrayRef<int32_t>(iota)));
+  auto splat = [&](Value val) -> Value {
+    return builder.create<vector::BroadcastOp>(
+        loc, indexVecTy, builder.create<arith::IndexCastOp>(loc, i32, val));
+  };
+  Value columns = builder.create<arith::AddIOp>(loc, iotaVec, splat(x));
+  Value channelsVec = splat(channels);
+  pixelVec = builder.create<arith::DivUIOp>(loc, columns, channelsVec);
+  channelVec = builder.create<arith::RemUIOp>(loc, columns, channelsVec);
+}
+
+// Samples the input image bilinearly at the fixed-point source positions
+// `srcX` and `srcY`. Taps outside the image are clamped to its border for
+// replicate padding and read as `constantValue` for constant padding. Integer
+// images are treated as unsigned and interpolated with fixed-point weights.
+// Images collapsed by `collapseChannels` pass their channel count and the
+// channel of every lane in `channels` and `channelVec`.
+static Value sampleBilinear(OpBuilder &builder, Location loc, MLIRContext *ctx,
+                            Value input, Value srcX, Value srcY, Value mask,
+                            Value constantValue, Type elemTy,
+                            dip::BoundaryOption boundaryOptionAttr,
+                            int64_t stride, Value channels = nullptr,
+                            Value channelVec = nullptr) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  IntegerType i32 = builder.getI32Type();
+  VectorType indexVecTy = VectorType::get({stride}, i32);
+  VectorType vectorTy = VectorType::get({stride}, elemTy);
+  auto i32Splat = [&](int64_t val) -> Value {
+    return builder.create<vector::BroadcastOp>(
+        loc, indexVecTy, builder.create<arith::ConstantIntOp>(loc, val, i32));
+  };
+  auto dimSplat = [&](Value dim) -> Value {
+    return builder.create<vector::BroadcastOp>(
+        loc, indexVecTy,
+        builder.create<arith::IndexCastOp>(
+            loc, i32, builder.create<memref::DimOp>(loc, input, dim)));
+  };
+
+  Value zeroVec = i32Splat(0);
+  Value oneVec = i32Splat(1);
+  Value inputColVec = dimSplat(c1);
+  Value inputWidthVec = inputColVec, channelsVec;
+  if (channels) {
+    channelsVec = builder.create<vector::BroadcastOp>(
+        loc, indexVecTy,
+        builder.create<arith::IndexCastOp>(loc, i32, channels));
+    inputWidthVec =
+        builder.create<arith::DivUIOp>(loc, inputColVec, channelsVec);
+  }
+  Value lastRowVec = builder.create<arith::SubIOp>(loc, dimSplat(c0), oneVec);
+  Value lastColVec = builder.create<arith::SubIOp>(loc, inputWidthVec, oneVec);
+  Value bitsVec = i32Splat(kWarpCoordBits);
+  Value fracMaskVec = i32Splat((int64_t(1) << kWarpCoordBits) - 1);
+
+  Value x0 = builder.create<arith::ShRSIOp>(loc, srcX, bitsVec);
+  Value y0 = builder.create<arith::ShRSIOp>(loc, srcY, bitsVec);
+  Value x1 = builder.create<arith::AddIOp>(loc, x0, oneVec);
+  Value y1 = builder.create<arith::AddIOp>(loc, y0, oneVec);
+  Value fracX = builder.create<arith::AndIOp>(loc, srcX, fracMaskVec);
+  Value fracY = builder.create<arith::AndIOp>(loc, srcY, fracMaskVec);
+
+  // Gathers the pixels at columns `x` and rows `y` from the linearized image.
+  Value constantVec =
+      builder.create<vector::BroadcastOp>(loc, vectorTy, constantValue);
+  auto gatherTap = [&](Value x, Value y) -> Value {
+    Value clampedX = builder.create<arith::MinSIOp>(
+        loc, builder.create<arith::MaxSIOp>(loc, x, zeroVec), lastColVec);
+    Value clampedY = builder.create<arith::MinSIOp>(
+        loc, builder.create<arith::MaxSIOp>(loc, y, zeroVec), lastRowVec);
+    Value tapMask = mask;
+    if (boundaryOptionAttr == dip::BoundaryOption::ConstantPadding) {
+      Value inside = builder.create<arith::AndIOp>(
+          loc,
+          builder.create<arith::CmpIOp>(loc, arith::CmpIPredicate::eq, x,
+                                        clampedX),
+          builder.create<arith::CmpIOp>(loc, arith::CmpIPredicate::eq, y,
+                                        clampedY));
+      tapMask = builder.create<arith::AndIOp>(loc, mask, inside);
+    }
+    Value column = clampedX;
+    if (channels)
+      column = builder.create<arith::AddIOp>(
+          loc, builder.create<arith::MulIOp>(loc, clampedX, channelsVec),
+          channelVec);
+    Value offsets = builder.create<arith::AddIOp>(
+        loc, builder.create<arith::MulIOp>(loc, clampedY, inputColVec),
+        column);
+    return builder.create<vector::GatherOp>(loc, vectorTy, input,
+                                            ValueRange{c0, c0}, offsets,
+                                            tapMask, constantVec);
+  };
+  Value topLeft = gatherTap(x0, y0);
+  Value topRight = gatherTap(x1, y0);
+  Value bottomLeft = gatherTap(x0, y1);
+  Value bottomRight = gatherTap(x1, y1);
+
+  // Float images use weights in [0, 1]. Integer images accumulate weights
+  // summing to 2^(2 * kWarpCoordBits) in i32 up to 16-bit pixels and in i64
+  // otherwise.
+  bool isFloat = elemTy.isF32() || elemTy.isF64();
+  unsigned bitWidth = elemTy.getIntOrFloatBitWidth();
+  Type accTy = elemTy;
+  if (!isFloat)
+    accTy = IntegerType::get(ctx, bitWidth <= 16 ? 32 : 64);
+  unsigned accWidth = accTy.getIntOrFloatBitWidth();
+  VectorType accVecTy = VectorType::get({stride}, accTy);
+
+  Value wx1, wy1, wx0, wy0;
+  if (isFloat) {
+    auto accSplat = [&](double val) -> Value {
+      return builder.create<vector::BroadcastOp>(
+          loc, accVecTy,
+          builder.create<arith::ConstantOp>(
+              loc, builder.getFloatAttr(accTy, val)));
+    };
+    Value scale = accSplat(1.0 / double(int64_t(1) << kWarpCoordBits));
+    Value one = accSplat(1.0);
+    wx1 = builder.create<arith::MulFOp>(
+        loc, builder.create<arith::SIToFPOp>(loc, accVecTy, fracX), scale);
+    wy1 = builder.create<arith::MulFOp>(
+        loc, builder.create<arith::SIToFPOp>(loc, accVecTy, fracY), scale);
+    wx0 = builder.create<arith::SubFOp>(loc, one, wx1);
+    wy0 = builder.create<arith::SubFOp>(loc, one, wy1);
+  } else {
+    Value one = i32Splat(int64_t(1) << kWarpCoordBits);
+    wx1 = fracX;
+    wy1 = fracY;
+    wx0 = builder.create<arith::SubIOp>(loc, one, wx1);
+    wy0 = builder.create<arith::SubIOp>(loc, one, wy1);
+    if (accWidth > 32)
+      for (Value *weight : {&wx0, &wx1, &wy0, &wy1})
+        *weight = builder.create<arith::ExtUIOp>(loc, accVecTy, *weight);
+    if (bitWidth < accWidth)
+      for (Value *tap : {&topLeft, &topRight, &bottomLeft, &bottomRight})
+        *tap = builder.create<arith::ExtUIOp>(loc, accVecTy, *tap);
+  }
+
+  auto mul = [&](Value lhs, Value rhs) -> Value {
+    if (isFloat)
+      return builder.create<arith::MulFOp>(loc, lhs, rhs);
+    return builder.create<arith::MulIOp>(loc, lhs, rhs);
+  };
+  Value top = insertFMAOp(builder, loc, accVecTy, topRight, wx1,
+                          mul(topLeft, wx0));
+  Value bottom = insertFMAOp(builder, loc, accVecTy, bottomRight, wx1,
+                             mul(bottomLeft, wx0));
+  Value res = insertFMAOp(builder, loc, accVecTy, bottom, wy1, mul(top, wy0));
+  if (isFloat)
+    return res;
+
+  // Round to the nearest integer. The result is a convex combination of the
+  // taps and needs no saturation.
+  auto accConst = [&](int64_t val) -> Value {
+    return builder.create<vector::BroadcastOp>(
+        loc, accVecTy, builder.create<arith::ConstantIntOp>(loc, val, accTy));
+  };
+  int64_t shift = 2 * kWarpCoordBits;
+  res = builder.create<arith::ShRUIOp>(
+      loc,
+      builder.create<arith::AddIOp>(loc, res,
+                                    accConst(int64_t(1) << (shift - 1))),
+      accConst(shift));
+  if (bitWidth < accWidth)
+    res = builder.create<arith::TruncIOp>(loc, vectorTy, res);
+  return res;
+}
+
+// Iterates over the output columns of a warping operation in vectors of
+// `stride` columns, calling `bodyBuilderFn` with the row, the first column and
+// the tail mask of each vector. Rows are processed in parallel tiles of
+// `tileRows` rows when it is positive.
+static void traverseWarpOutput(
+    OpBuilder &builder, Location loc, MLIRContext *ctx, Value outputRow,
+    Value outputCol, int64_t stride, int64_t tileRows,
+    function_ref<void(OpBuilder &, Location, Value, Value, Value)>
+        bodyBuilderFn) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value strideVal = builder.create<arith::ConstantIndexOp>(loc, stride);
+  VectorType vectorMaskTy = VectorType::get({stride}, IntegerType::get(ctx, 1));
+
+  buildRowTileLoop(
+      builder, loc, c0, outputRow, tileRows,
+      [&](OpBuilder &builder, Location loc, Value rowBegin, Value rowEnd) {
+        builder.create<scf::ForOp>(
+            loc, rowBegin, rowEnd, c1, ValueRange{},
+            [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange) {
+              builder.create<scf::ForOp>(
+                  loc, c0, outputCol, strideVal, ValueRange{},
+                  [&](OpBuilder &builder, Location loc, ValueRange iv1,
+                      ValueRange) {
+                    Value mask = tailMaskCreator(builder, loc, outputCol,
+                                                 iv1[0], vectorMaskTy);
+                    bodyBuilderFn(builder, loc, iv[0], iv1[0], mask);
+                    builder.create<scf::YieldOp>(loc);
+                  });
+              builder.create<scf::YieldOp>(loc);
+            });
       });
 }
 
-// Helper function for resizing an image using bilinear interpolation mechanism.
-void BilinearInterpolationResizing(
-    OpBuilder &builder, Location loc, MLIRContext *ctx,
-    SmallVector<Value, 8> lowerBounds, SmallVector<Value, 8> upperBounds,
-    SmallVector<int64_t, 8> steps, Value strideVal, Value input, Value output,
-    Value horizontalScalingFactorVec, Value verticalScalingFactorVec,
-    Value outputRowLastElemF32, Value outputColLastElemF32,
-    Value inputRowLastElemF32, Value inputColLastElemF32, VectorType vectorTy32,
-    int64_t stride, Value c0, Value c0F32, Value c1F32) {
-  affine::buildAffineLoopNest(
-      builder, loc, lowerBounds, upperBounds, steps,
-      [&](OpBuilder &builder, Location loc, ValueRange ivs) {
-        Value ivs0F32 = indexToF32(builder, loc, ivs[0]);
-        Value yVec = builder.create<vector::SplatOp>(loc, vectorTy32, ivs0F32);
-        Value xVec = iotaVec(builder, loc, ctx, ivs[1], strideVal, vectorTy32,
-                             c0, stride);
+void warpImage(OpBuilder &builder, Location loc, MLIRContext *ctx, Value input,
+               Value matrix, Value output, Value constantValue, Type elemTy,
+               dip::BoundaryOption boundaryOptionAttr, bool perspective,
+               int64_t stride, int64_t tileRows, Value channels) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value outputRow = builder.create<memref::DimOp>(loc, output, c0);
+  Value outputCol = builder.create<memref::DimOp>(loc, output, c1);
+  SmallVector<Value, 9> coefs =
+      loadWarpMatrix(builder, loc, matrix, perspective);
+
+  traverseWarpOutput(
+      builder, loc, ctx, outputRow, outputCol, stride, tileRows,
+      [&](OpBuilder &builder, Location loc, Value y, Value x, Value mask) {
+        Value xVec, pixelVec, channelVec;
+        VectorType vectorTy32 = VectorType::get({stride}, builder.getF32Type());
+        if (channels) {
+          splitChannels(builder, loc, x, channels, stride, pixelVec,
+                        channelVec);
+          xVec = builder.create<arith::SIToFPOp>(loc, vectorTy32, pixelVec);
+        } else {
+          xVec = builder.create<arith::AddFOp>(
+              loc, iotaVec0F32(builder, loc, stride),
+              builder.create<vector::SplatOp>(loc, vectorTy32,
+                                              indexToF32(builder, loc, x)));
+        }
+        Value srcX, srcY;
+        warpPositions(builder, loc, coefs, xVec, y, perspective, stride, srcX,
+                      srcY);
+        Value res = sampleBilinear(builder, loc, ctx, input, srcX, srcY, mask,
+                                   constantValue, elemTy, boundaryOptionAttr,
+                                   stride, channels, channelVec);
+        builder.create<vector::MaskedStoreOp>(loc, output, ValueRange{y, x},
+                                              mask, res);
+      });
+}
+
+void buildWarpMap(OpBuilder &builder, Location loc, MLIRContext *ctx,
+                  Value matrix, Value map, int64_t stride, int64_t tileRows) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value c2 = builder.create<arith::ConstantIndexOp>(loc, 2);
+  Value outputRow = builder.create<memref::DimOp>(loc, map, c1);
+  Value outputCol = builder.create<memref::DimOp>(loc, map, c2);
+  // The last row of affine matrices is (0, 0, 1), so the perspective division
+  // leaves their positions unchanged.
+  SmallVector<Value, 9> coefs =
+      loadWarpMatrix(builder, loc, matrix, /*perspective=*/true);
+
+  traverseWarpOutput(
+      builder, loc, ctx, outputRow, outputCol, stride, tileRows,
+      [&](OpBuilder &builder, Location loc, Value y, Value x, Value mask) {
+        VectorType vectorTy32 = VectorType::get({stride}, builder.getF32Type());
+        Value xVec = builder.create<arith::AddFOp>(
+            loc, iotaVec0F32(builder, loc, stride),
+            builder.create<vector::SplatOp>(loc, vectorTy32,
+                                            indexToF32(builder, loc, x)));
+        Value srcX, srcY;
+        warpPositions(builder, loc, coefs, xVec, y, /*perspective=*/true,
+                      stride, srcX, srcY);
+        builder.create<vector::MaskedStoreOp>(loc, map, ValueRange{c0, y, x},
+                                              mask, srcX);
+        builder.create<vector::MaskedStoreOp>(loc, map, ValueRange{c1, y, x},
+                                              mask, srcY);
+      });
+}
+
+void remapImage(OpBuilder &builder, Location loc, MLIRContext *ctx, Value input,
+                Value map, Value output, Value constantValue, Type elemTy,
+                dip::BoundaryOption boundaryOptionAttr, int64_t stride,
+                int64_t tileRows, Value channels) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value outputRow = builder.create<memref::DimOp>(loc, output, c0);
+  Value outputCol = builder.create<memref::DimOp>(loc, output, c1);
+  IntegerType i32 = builder.getI32Type();
+  VectorType indexVecTy = VectorType::get({stride}, i32);
+  Value indexZeroVec = builder.create<vector::BroadcastOp>(
+      loc, indexVecTy, builder.create<arith::ConstantIntOp>(loc, 0, i32));
+
+  traverseWarpOutput(
+      builder, loc, ctx, outputRow, outputCol, stride, tileRows,
+      [&](OpBuilder &builder, Location loc, Value y, Value x, Value mask) {
+        Value srcX, srcY, pixelVec, channelVec;
+        if (channels) {
+          // The map has one entry per pixel, shared by its channels.
+          splitChannels(builder, loc, x, channels, stride, pixelVec,
+                        channelVec);
+          srcX = builder.create<vector::GatherOp>(
+              loc, indexVecTy, map, ValueRange{c0, y, c0}, pixelVec, mask,
+              indexZeroVec);
+          srcY = builder.create<vector::GatherOp>(
+              loc, indexVecTy, map, ValueRange{c1, y, c0}, pixelVec, mask,
+              indexZeroVec);
+        } else {
+          srcX = builder.create<vector::MaskedLoadOp>(
+              loc, indexVecTy, map, ValueRange{c0, y, x}, mask, indexZeroVec);
+          srcY = builder.create<vector::MaskedLoadOp>(
+              loc, indexVecTy, map, ValueRange{c1, y, x}, mask, indexZeroVec);
+        }
+        Value res = sampleBilinear(builder, loc, ctx, input, srcX, srcY, mask,
+                                   constantValue, elemTy, boundaryOptionAttr,
+                                   stride, channels, channelVec);
+        builder.create<vector::MaskedStoreOp>(loc, output, ValueRange{y, x},
+                                              mask, res);
+      });
+}
 
-        Value xVecInterm = builder.create<arith::MulFOp>(
-            loc, xVec, horizontalScalingFactorVec);
-        Value yVecInterm =
-            builder.create<arith::MulFOp>(loc, yVec, verticalScalingFactorVec);
+void imageToTensor(OpBuilder &builder, Location loc, MLIRContext *ctx,
+                   Value input, Value output, Value batch, Value scale,
+                   Value mean, Value stdDev, Type elemTy,
+                   dip::InterpolationType type, dip::TensorLayout layout,
+                   bool swapRB, int64_t stride, int64_t tileRows) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value c2 = builder.create<arith::ConstantIndexOp>(loc, 2);
+  Value c3 = builder.create<arith::ConstantIndexOp>(loc, 3);
+  Value strideVal = builder.create<arith::ConstantIndexOp>(loc, stride);
 
-        Value xVecInterm_L = builder.create<math::FloorOp>(loc, xVecInterm);
-        Value xVecInterm_H = builder.create<math::CeilOp>(loc, xVecInterm);
+  Value channels = collapseChannels(builder, loc, input);
+  if (!channels)
+    channels = c1;
+  Value inputRow = builder.create<memref::DimOp>(loc, input, c0);
+  Value inputCol = builder.create<memref::DimOp>(loc, input, c1);
+  Value inputWidth = builder.create<arith::DivUIOp>(loc, inputCol, channels);
+  bool nhwc = layout == dip::TensorLayout::NHWC;
+  Value outputChannels =
+      builder.create<memref::DimOp>(loc, output, nhwc ? c3 : c1);
+  Value outputRow = builder.create<memref::DimOp>(loc, output, nhwc ? c1 : c2);
+  Value outputCol = builder.create<memref::DimOp>(loc, output, nhwc ? c2 : c3);
+  // NHWC outputs are written through a NxHxWC view, with the channels of each
+  // pixel in consecutive columns.
+  if (nhwc)
+    output = builder.create<memref::CollapseShapeOp>(
+        loc, output, ArrayRef<ReassociationIndices>{{0}, {1}, {2, 3}});
+
+  bool bilinear = type == dip::InterpolationType::BilinearInterpolation;
+  bool isFloat = elemTy.isF32() || elemTy.isF64();
+  FloatType f32 = builder.getF32Type();
+  IntegerType i32 = builder.getI32Type();
+  VectorType vectorTy = VectorType::get({stride}, elemTy);
+  VectorType vectorTy32 = VectorType::get({stride}, f32);
+  VectorType indexVecTy = VectorType::get({stride}, i32);
+  VectorType vectorMaskTy = VectorType::get({stride}, IntegerType::get(ctx, 1));
+  Value zeroVec = builder.create<vector::BroadcastOp>(
+      loc, vectorTy, insertZeroConstantOp(ctx, builder, loc, elemTy));
+  Value zeroVec32 = builder.create<vector::BroadcastOp>(
+      loc, vectorTy32, insertZeroConstantOp(ctx, builder, loc, f32));
+  Value indexZeroVec = builder.create<vector::BroadcastOp>(
+      loc, indexVecTy, builder.create<arith::ConstantIntOp>(loc, 0, i32));
+  auto splatI32 = [&](OpBuilder &builder, Location loc, Value val) -> Value {
+    return builder.create<vector::BroadcastOp>(
+        loc, indexVecTy, builder.create<arith::IndexCastOp>(loc, i32, val));
+  };
+  std::vector<int32_t> iota(stride);
+  std::iota(iota.begin(), iota.end(), 0);
+  Value iotaVec = builder.create<arith::ConstantOp>(
+      loc, DenseIntElementsAttr::get(indexVecTy, ArrayRef<int32_t>(iota)));
+
+  // Source position of output coordinate `pos` along an axis with `scale`
+  // input pixels per output pixel and `size` input pixels: the first tap, the
+  // second tap and the weight of the second tap, as f32 values. Positions
+  // follow cv::resize: nearest neighbour takes the pixel at floor(pos * scale)
+  // and bilinear interpolation aligns the pixel centers, sampling at
+  // (pos + 0.5) * scale - 0.5.
+  auto sourcePosition = [&](OpBuilder &builder, Location loc, Value pos,
+                            Value scale, Value size, Value &first,
+                            Value &second, Value &weight) {
+    Type ty = pos.getType();
+    auto splat = [&](Value val) -> Value {
+      if (auto vecTy = ty.dyn_cast<VectorType>())
+        return builder.create<vector::SplatOp>(loc, vecTy, val);
+      return val;
+    };
+    Value zero = splat(insertZeroConstantOp(ctx, builder, loc, f32));
+    Value half = splat(builder.create<arith::ConstantFloatOp>(
+        loc, APFloat(0.5f), f32));
+    Value one = splat(builder.create<arith::ConstantFloatOp>(
+        loc, APFloat(1.f), f32));
+    Value last = splat(builder.create<arith::SubFOp>(
+        loc, indexToF32(builder, loc, size), one));
+    if (!bilinear) {
+      Value nearest = builder.create<math::FloorOp>(
+          loc, builder.create<arith::MulFOp>(loc, pos, scale));
+      first = builder.create<arith::MinimumFOp>(loc, nearest, last);
+      second = first;
+      weight = zero;
+      return;
+    }
+    Value lo = builder.create<arith::SubFOp>(
+        loc,
+        builder.create<arith::MulFOp>(
+            loc, builder.create<arith::AddFOp>(loc, pos, half), scale),
+        half);
+    Value base = builder.create<math::FloorOp>(loc, lo);
+    weight = builder.create<arith::SubFOp>(loc, lo, base);
+    first = builder.create<arith::MinimumFOp>(
+        loc, builder.create<arith::MaximumFOp>(loc, base, zero), last);
+    second = builder.create<arith::MinimumFOp>(
+        loc, builder.create<arith::AddFOp>(loc, base, one), last);
+  };
 
-        Value yVecInterm_L = builder.create<math::FloorOp>(loc, yVecInterm);
-        Value yVecInterm_H = builder.create<math::CeilOp>(loc, yVecInterm);
+  Value horizontalScale = builder.create<arith::DivFOp>(
+      loc, indexToF32(builder, loc, inputWidth),
+      indexToF32(builder, loc, outputCol));
+  Value verticalScale = builder.create<arith::DivFOp>(
+      loc, indexToF32(builder, loc, inputRow),
+      indexToF32(builder, loc, outputRow));
+
+  // Horizontal tables, computed once: the first column of the two taps of
+  // every output column and the weight of the second tap.
+  MemRefType indexTableTy = MemRefType::get({ShapedType::kDynamic}, i32);
+  MemRefType weightTableTy = MemRefType::get({ShapedType::kDynamic}, f32);
+  Value xFirst = builder.create<memref::AllocOp>(loc, indexTableTy, outputCol);
+  Value xSecond = builder.create<memref::AllocOp>(loc, indexTableTy, outputCol);
+  Value xWeight =
+      builder.create<memref::AllocOp>(loc, weightTableTy, outputCol);
+  Value horizontalScaleVec =
+      builder.create<vector::SplatOp>(loc, vectorTy32, horizontalScale);
+  Value channelsVec = splatI32(builder, loc, channels);
+  Value outputChannelsVec = splatI32(builder, loc, outputChannels);
+  builder.create<scf::ForOp>(
+      loc, c0, outputCol, strideVal, ValueRange{},
+      [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange) {
+        Value mask =
+            tailMaskCreator(builder, loc, outputCol, iv[0], vectorMaskTy);
+        Value xVec = builder.create<arith::AddFOp>(
+            loc, iotaVec0F32(builder, loc, stride),
+            builder.create<vector::SplatOp>(loc, vectorTy32,
+                                            indexToF32(builder, loc, iv[0])));
+        Value first, second, weight;
+        sourcePosition(builder, loc, xVec, horizontalScaleVec, inputWidth,
+                       first, second, weight);
+        auto toColumn = [&](Value pos) -> Value {
+          return builder.create<arith::MulIOp>(
+              loc, builder.create<arith::FPToSIOp>(loc, indexVecTy, pos),
+              channelsVec);
+        };
+        builder.create<vector::MaskedStoreOp>(loc, xFirst, iv[0], mask,
+                                              toColumn(first));
+        builder.create<vector::MaskedStoreOp>(loc, xSecond, iv[0], mask,
+                                              toColumn(second));
+        builder.create<vector::MaskedStoreOp>(loc, xWeight, iv[0], mask,
+                                              weight);
+        builder.create<scf::YieldOp>(loc);
+      });
 
-        Value xVecWeight =
-            builder.create<arith::SubFOp>(loc, xVecInterm, xVecInterm_L);
-        Value yVecWeight =
-            builder.create<arith::SubFOp>(loc, yVecInterm, yVecInterm_L);
+  // Loads the input pixels of row `row` at columns `columns` as f32 values.
+  auto gatherPixels = [&](OpBuilder &builder, Location loc, Value row,
+                          Value columns, Value mask) -> Value {
+    Value pixels = builder.create<vector::GatherOp>(
+        loc, vectorTy, input, ValueRange{row, c0}, columns, mask, zeroVec);
+    if (!isFloat)
+      return builder.create<arith::UIToFPOp>(loc, vectorTy32, pixels);
+    if (!elemTy.isF32())
+      return builder.create<arith::TruncFOp>(loc, vectorTy32, pixels);
+    return pixels;
+  };
+  // Interpolates between two vectors with the weight `weight` of `second`.
+  auto lerp = [&](OpBuilder &builder, Location loc, Value first, Value second,
+                  Value weight) -> Value {
+    Value diff = builder.create<arith::SubFOp>(loc, second, first);
+    return builder.create<vector::FMAOp>(loc, diff, weight, first);
+  };
 
-        fillPixelsBilinearInterpolate(
-            builder, loc, xVec, yVec, xVecInterm_L, yVecInterm_L, xVecInterm_H,
-            yVecInterm_H, input, output, c0, strideVal, xVecWeight, yVecWeight,
-            outputRowLastElemF32, outputColLastElemF32, inputRowLastElemF32,
-            inputColLastElemF32, c0F32, c1F32);
+  Value lastChannel = builder.create<arith::SubIOp>(loc, channels, c1);
+  buildRowTileLoop(
+      builder, loc, c0, outputRow, tileRows,
+      [&](OpBuilder &builder, Location loc, Value rowBegin, Value rowEnd) {
+        builder.create<scf::ForOp>(
+            loc, rowBegin, rowEnd, c1, ValueRange{},
+            [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange) {
+              Value first, second, weight;
+              sourcePosition(builder, loc, indexToF32(builder, loc, iv[0]),
+                             verticalScale, inputRow, first, second, weight);
+              Value firstRow = floorToIndex(builder, loc, first);
+              Value secondRow = floorToIndex(builder, loc, second);
+              Value weightVec =
+                  builder.create<vector::SplatOp>(loc, vectorTy32, weight);
+
+              builder.create<scf::ForOp>(
+                  loc, c0, outputChannels, c1, ValueRange{},
+                  [&](OpBuilder &builder, Location loc, ValueRange iv1,
+                      ValueRange) {
+                    // Single channel images feed every output channel and
+                    // extra input channels (e.g. alpha) are dropped.
+                    Value srcChannel =
+                        builder.create<arith::MinUIOp>(loc, iv1[0],
+                                                       lastChannel);
+                    if (swapRB) {
+                      Value isColor = builder.create<arith::AndIOp>(
+                          loc,
+                          builder.create<arith::CmpIOp>(
+                              loc, arith::CmpIPredicate::uge, channels, c3),
+                          builder.create<arith::CmpIOp>(
+                              loc, arith::CmpIPredicate::ult, iv1[0], c3));
+                      srcChannel = builder.create<arith::SelectOp>(
+                          loc, isColor,
+                          builder.create<arith::SubIOp>(loc, c2, iv1[0]),
+                          srcChannel);
+                    }
+                    Value srcChannelVec = splatI32(builder, loc, srcChannel);
+                    // out = (pixel * scale - mean) / std, as one FMA.
+                    Value stdVal =
+                        builder.create<memref::LoadOp>(loc, stdDev, iv1[0]);
+                    Value alpha = builder.create<arith::DivFOp>(loc, scale,
+                                                                stdVal);
+                    Value beta = builder.create<arith::NegFOp>(
+                        loc, builder.create<arith::DivFOp>(
+                                 loc,
+                                 builder.create<memref::LoadOp>(loc, mean,
+                                                                iv1[0]),
+                                 stdVal));
+                    Value alphaVec =
+                        builder.create<vector::SplatOp>(loc, vectorTy32, alpha);
+                    Value betaVec =
+                        builder.create<vector::SplatOp>(loc, vectorTy32, beta);
+                    Value outputChannelVec = splatI32(builder, loc, iv1[0]);
+
+                    builder.create<scf::ForOp>(
+                        loc, c0, outputCol, strideVal, ValueRange{},
+                        [&](OpBuilder &builder, Location loc, ValueRange iv2,
+                            ValueRange) {
+                          Value mask = tailMaskCreator(builder, loc, outputCol,
+                                                       iv2[0], vectorMaskTy);
+                          auto loadColumns = [&](Value table) -> Value {
+                            Value columns =
+                                builder.create<vector::MaskedLoadOp>(
+                                    loc, indexVecTy, table, iv2[0], mask,
+                                    indexZeroVec);
+                            return builder.create<arith::AddIOp>(
+                                loc, columns, srcChannelVec);
+                          };
+                          Value firstCols = loadColumns(xFirst);
+                          Value res = gatherPixels(builder, loc, firstRow,
+                                                   firstCols, mask);
+                          if (bilinear) {
+                            Value secondCols = loadColumns(xSecond);
+                            Value colWeight =
+                                builder.create<vector::MaskedLoadOp>(
+                                    loc, vectorTy32, xWeight, iv2[0], mask,
+                                    zeroVec32);
+                            Value top = lerp(
+                                builder, loc, res,
+                                gatherPixels(builder, loc, firstRow,
+                                             secondCols, mask),
+                                colWeight);
+                            Value bottom = lerp(
+                                builder, loc,
+                                gatherPixels(builder, loc, secondRow,
+                                             firstCols, mask),
+                                gatherPixels(builder, loc, secondRow,
+                                             secondCols, mask),
+                                colWeight);
+                            res = lerp(builder, loc, top, bottom, weightVec);
+                          }
+                          res = builder.create<vector::FMAOp>(loc, res,
+                                                              alphaVec,
+                                                              betaVec);
+                          if (!nhwc) {
+                            builder.create<vector::MaskedStoreOp>(
+                                loc, output,
+                                ValueRange{batch, iv1[0], iv[0], iv2[0]}, mask,
+                                res);
+                          } else {
+                            // Pixel x of channel c is in column x * C + c.
+                            Value xVec = builder.create<arith::AddIOp>(
+                                loc, splatI32(builder, loc, iv2[0]), iotaVec);
+                            Value outputCols = builder.create<arith::AddIOp>(
+                                loc,
+                                builder.create<arith::MulIOp>(
+                                    loc, xVec, outputChannelsVec),
+                                outputChannelVec);
+                            builder.create<vector::ScatterOp>(
+                                loc, output, ValueRange{batch, iv[0], c0},
+                                outputCols, mask, res);
+                          }
+                          builder.create<scf::YieldOp>(loc);
+                        });
+                    builder.create<scf::YieldOp>(loc);
+                  });
+              builder.create<scf::YieldOp>(loc);
+            });
       });
+
+  for (Value table : {xFirst, xSecond, xWeight})
+    builder.create<memref::DeallocOp>(loc, table);
 }
 
 // Function to test whether a value is equivalent to zero or not.
@@ -937,7 +1934,8 @@ void traverseImagewBoundaryExtrapolation(
     OpBuilder &rewriter, Location loc, MLIRContext *ctx, Value input,
     Value kernel, Value output, Value centerX, Value centerY,
     Value constantValue, Value strideVal, Type elemTy,
-    buddy::dip::BoundaryOption boundaryOptionAttr, int64_t stride, DIP_OP op) {
+    buddy::dip::BoundaryOption boundaryOptionAttr, int64_t stride, DIP_OP op,
+    int64_t tileRows) {
   // Create constant indices.
   Value c0 = rewriter.create<arith::ConstantIndexOp>(loc, 0);
   Value c1 = rewriter.create<arith::ConstantIndexOp>(loc, 1);
@@ -973,8 +1971,10 @@ void traverseImagewBoundaryExtrapolation(
   Value pseudoCol = rewriter.create<affine::AffineApplyOp>(
       loc, calcHelper, ValueRange{inputCol, kernelCol, c1});
 
-  affine::buildAffineLoopNest(
-      rewriter, loc, lowerBounds, uperBounds, steps,
+  // Every output row only reads input rows, so row tiles are independent; the
+  // halo rows above and below a tile are extrapolated per row as usual.
+  buildRowTiledLoopNest(
+      rewriter, loc, lowerBounds, uperBounds, steps, tileRows,
       [&](OpBuilder &builder, Location loc, ValueRange ivs) {
         // Indices of current pixel with respect to pseudo image containing
         // extrapolated boundaries.
@@ -1623,6 +2623,3016 @@ void traverseImagewBoundaryExtrapolation(
       });
 }
 
+void separableCorrelation(OpBuilder &rewriter, Location loc, MLIRContext *ctx,
+                          Value input, Value kernelX, Value kernelY,
+                          Value output, Value centerX, Value centerY,
+                          Value constantValue, Type elemTy,
+                          buddy::dip::BoundaryOption boundaryOptionAttr,
+                          int64_t stride, Value channels) {
+  // Create constant indices.
+  Value c0 = rewriter.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = rewriter.create<arith::ConstantIndexOp>(loc, 1);
+  Value strideVal = rewriter.create<arith::ConstantIndexOp>(loc, stride);
+
+  // Create DimOp.
+  Value inputRow = rewriter.create<memref::DimOp>(loc, input, c0);
+  Value inputCol = rewriter.create<memref::DimOp>(loc, input, c1);
+  Value kernelXSize = rewriter.create<memref::DimOp>(loc, kernelX, c0);
+  Value kernelYSize = rewriter.create<memref::DimOp>(loc, kernelY, c0);
+  Value lastRow = rewriter.create<arith::SubIOp>(loc, inputRow, c1);
+
+  // Integer images of up to 16 bits accumulate in i32 (8-bit pixels) or i64.
+  bool isFloat = elemTy.isF32() || elemTy.isF64();
+  unsigned bitWidth = elemTy.getIntOrFloatBitWidth();
+  Type accTy = elemTy;
+  if (!isFloat && bitWidth <= 16)
+    accTy = IntegerType::get(ctx, bitWidth <= 8 ? 32 : 64);
+  bool widened = accTy != elemTy;
+
+  VectorType vectorTy = VectorType::get({stride}, elemTy);
+  VectorType accVecTy = VectorType::get({stride}, accTy);
+  VectorType vectorMaskTy = VectorType::get({stride}, IntegerType::get(ctx, 1));
+  Value zeroPaddingElem = insertZeroConstantOp(ctx, rewriter, loc, elemTy);
+  Value zeroPadding =
+      rewriter.create<vector::BroadcastOp>(loc, vectorTy, zeroPaddingElem);
+  Value accZeroVec = rewriter.create<vector::BroadcastOp>(
+      loc, accVecTy, insertZeroConstantOp(ctx, rewriter, loc, accTy));
+
+  // Loads a kernel value as a vector of the accumulator type. Kernels of
+  // widened images are signed.
+  auto loadKernelVec = [&](OpBuilder &builder, Location loc, Value kernel,
+                           Value idx) -> Value {
+    Value kernelValue = builder.create<memref::LoadOp>(loc, kernel, idx);
+    if (widened)
+      kernelValue = builder.create<arith::ExtSIOp>(loc, accTy, kernelValue);
+    return builder.create<vector::BroadcastOp>(loc, accVecTy, kernelValue);
+  };
+
+  // Columns of interleaved images hold the channels of each pixel, so the
+  // kernel taps of a column are `channels` columns apart.
+  Value step = channels ? channels : c1;
+  Value padLeft = rewriter.create<arith::MulIOp>(loc, centerX, step);
+  Value lastPixel = rewriter.create<arith::SubIOp>(loc, inputCol, step);
+
+  // The row buffer holds one input row with its extrapolated columns, so that
+  // element j + v * step is the input pixel under kernelX[v] for output column
+  // j. The ring buffer holds the last kernelY rows correlated with kernelX.
+  Value paddedCol = rewriter.create<arith::AddIOp>(
+      loc, inputCol,
+      rewriter.create<arith::MulIOp>(
+          loc, rewriter.create<arith::SubIOp>(loc, kernelXSize, c1), step));
+  Value rowBuffer = rewriter.create<memref::AllocOp>(
+      loc, MemRefType::get({ShapedType::kDynamic}, elemTy), paddedCol);
+  MemRefType ringBufferTy =
+      MemRefType::get({ShapedType::kDynamic, ShapedType::kDynamic}, accTy);
+  Value ringBuffer = rewriter.create<memref::AllocOp>(
+      loc, ringBufferTy, ValueRange{kernelYSize, inputCol});
+  Value rightBegin = rewriter.create<arith::AddIOp>(loc, padLeft, inputCol);
+  bool constantPadding =
+      boundaryOptionAttr == dip::BoundaryOption::ConstantPadding;
+
+  // Fills the row buffer elements in [begin, end) with the values returned by
+  // `valueFn` for their index.
+  auto fillRowBuffer =
+      [&](OpBuilder &builder, Location loc, Value begin, Value end,
+          function_ref<Value(OpBuilder &, Location, Value)> valueFn) {
+        builder.create<scf::ForOp>(
+            loc, begin, end, c1, ValueRange{},
+            [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange) {
+              builder.create<memref::StoreOp>(
+                  loc, valueFn(builder, loc, iv[0]), rowBuffer, iv[0]);
+              builder.create<scf::YieldOp>(loc);
+            });
+      };
+  auto constantFn = [&](OpBuilder &, Location, Value) {
+    return constantValue;
+  };
+
+  // Copies input row `row` into the row buffer and extrapolates its columns.
+  auto copyRow = [&](OpBuilder &builder, Location loc, Value row) {
+    builder.create<scf::ForOp>(
+        loc, c0, inputCol, strideVal, ValueRange{},
+        [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange) {
+          Value mask = tailMaskCreator(builder, loc, inputCol, iv[0],
+                                       vectorMaskTy);
+          Value inputVec = builder.create<vector::MaskedLoadOp>(
+              loc, vectorTy, input, ValueRange{row, iv[0]}, mask, zeroPadding);
+          Value bufferIdx = builder.create<arith::AddIOp>(loc, iv[0], padLeft);
+          builder.create<vector::MaskedStoreOp>(loc, rowBuffer, bufferIdx,
+                                                mask, inputVec);
+          builder.create<scf::YieldOp>(loc);
+        });
+
+    if (constantPadding) {
+      fillRowBuffer(builder, loc, c0, padLeft, constantFn);
+      fillRowBuffer(builder, loc, rightBegin, paddedCol, constantFn);
+      return;
+    }
+    // Replicate the channels of the first and the last pixel.
+    fillRowBuffer(builder, loc, c0, padLeft,
+                  [&](OpBuilder &builder, Location loc, Value idx) -> Value {
+                    Value col = builder.create<arith::RemUIOp>(loc, idx, step);
+                    return builder.create<memref::LoadOp>(
+                        loc, input, ValueRange{row, col});
+                  });
+    fillRowBuffer(
+        builder, loc, rightBegin, paddedCol,
+        [&](OpBuilder &builder, Location loc, Value idx) -> Value {
+          Value col = builder.create<arith::AddIOp>(
+              loc, lastPixel,
+              builder.create<arith::RemUIOp>(
+                  loc, builder.create<arith::SubIOp>(loc, idx, rightBegin),
+                  step));
+          return builder.create<memref::LoadOp>(loc, input,
+                                                ValueRange{row, col});
+        });
+  };
+
+  // Correlates the extrapolated input row `row` with kernelX and stores the
+  // result in row `slot` of the ring buffer.
+  auto filterRow = [&](OpBuilder &builder, Location loc, Value row,
+                       Value slot) {
+    if (constantPadding) {
+      Value rowInBounds = inBound(builder, loc, row, c0, inputRow);
+      builder.create<scf::IfOp>(
+          loc, rowInBounds,
+          [&](OpBuilder &builder, Location loc) {
+            copyRow(builder, loc, row);
+            builder.create<scf::YieldOp>(loc);
+          },
+          [&](OpBuilder &builder, Location loc) {
+            fillRowBuffer(builder, loc, c0, paddedCol, constantFn);
+            builder.create<scf::YieldOp>(loc);
+          });
+    } else {
+      Value clampedRow = builder.create<arith::MinSIOp>(
+          loc, builder.create<arith::MaxSIOp>(loc, row, c0), lastRow);
+      copyRow(builder, loc, clampedRow);
+    }
+
+    builder.create<scf::ForOp>(
+        loc, c0, inputCol, strideVal, ValueRange{},
+        [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange) {
+          Value mask = tailMaskCreator(builder, loc, inputCol, iv[0],
+                                       vectorMaskTy);
+          auto accLoop = builder.create<scf::ForOp>(
+              loc, c0, kernelXSize, c1, ValueRange{accZeroVec},
+              [&](OpBuilder &builder, Location loc, ValueRange iv1,
+                  ValueRange acc) {
+                Value kernelVec = loadKernelVec(builder, loc, kernelX, iv1[0]);
+                Value bufferIdx = builder.create<arith::AddIOp>(
+                    loc, iv[0],
+                    builder.create<arith::MulIOp>(loc, iv1[0], step));
+                Value inputVec = builder.create<vector::MaskedLoadOp>(
+                    loc, vectorTy, rowBuffer, bufferIdx, mask, zeroPadding);
+                if (widened)
+                  inputVec =
+                      builder.create<arith::ExtUIOp>(loc, accVecTy, inputVec);
+                Value res = insertFMAOp(builder, loc, accVecTy, inputVec,
+                                        kernelVec, acc[0]);
+                builder.create<scf::YieldOp>(loc, res);
+              });
+          builder.create<vector::MaskedStoreOp>(loc, ringBuffer,
+                                                ValueRange{slot, iv[0]}, mask,
+                                                accLoop.getResult(0));
+          builder.create<scf::YieldOp>(loc);
+        });
+  };
+
+  // Saturates the accumulated values to the unsigned range of the image.
+  auto saturate = [&](OpBuilder &builder, Location loc, Value acc) -> Value {
+    if (!widened)
+      return acc;
+    auto accConst = [&](int64_t val) -> Value {
+      return builder.create<vector::BroadcastOp>(
+          loc, accVecTy, builder.create<arith::ConstantIntOp>(loc, val, accTy));
+    };
+    Value res = builder.create<arith::MaxSIOp>(loc, acc, accZeroVec);
+    res = builder.create<arith::MinSIOp>(
+        loc, res, accConst((int64_t(1) << bitWidth) - 1));
+    return builder.create<arith::TruncIOp>(loc, vectorTy, res);
+  };
+
+  // Input row r lives in ring buffer slot (r + centerY) % kernelYSize. Fill
+  // the rows needed by the first output row, except the last one.
+  Value prologueEnd = rewriter.create<arith::SubIOp>(loc, kernelYSize, c1);
+  rewriter.create<scf::ForOp>(
+      loc, c0, prologueEnd, c1, ValueRange{},
+      [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange) {
+        Value row = builder.create<arith::SubIOp>(loc, iv[0], centerY);
+        filterRow(builder, loc, row, iv[0]);
+        builder.create<scf::YieldOp>(loc);
+      });
+
+  rewriter.create<scf::ForOp>(
+      loc, c0, inputRow, c1, ValueRange{},
+      [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange) {
+        // Correlate the one new row needed by output row i.
+        Value slotBase = builder.create<arith::AddIOp>(loc, iv[0], prologueEnd);
+        Value newRow = builder.create<arith::SubIOp>(loc, slotBase, centerY);
+        Value newSlot =
+            builder.create<arith::RemUIOp>(loc, slotBase, kernelYSize);
+        filterRow(builder, loc, newRow, newSlot);
+
+        // Combine the ring buffer rows with kernelY.
+        builder.create<scf::ForOp>(
+            loc, c0, inputCol, strideVal, ValueRange{},
+            [&](OpBuilder &builder, Location loc, ValueRange iv1, ValueRange) {
+              Value mask = tailMaskCreator(builder, loc, inputCol, iv1[0],
+                                           vectorMaskTy);
+              auto accLoop = builder.create<scf::ForOp>(
+                  loc, c0, kernelYSize, c1, ValueRange{accZeroVec},
+                  [&](OpBuilder &builder, Location loc, ValueRange iv2,
+                      ValueRange acc) {
+                    Value kernelVec =
+                        loadKernelVec(builder, loc, kernelY, iv2[0]);
+                    Value slot = builder.create<arith::RemUIOp>(
+                        loc, builder.create<arith::AddIOp>(loc, iv[0], iv2[0]),
+                        kernelYSize);
+                    Value rowVec = builder.create<vector::MaskedLoadOp>(
+                        loc, accVecTy, ringBuffer, ValueRange{slot, iv1[0]},
+                        mask, accZeroVec);
+                    Value res = insertFMAOp(builder, loc, accVecTy, rowVec,
+                                            kernelVec, acc[0]);
+                    builder.create<scf::YieldOp>(loc, res);
+                  });
+              builder.create<vector::MaskedStoreOp>(
+                  loc, output, ValueRange{iv[0], iv1[0]}, mask,
+                  saturate(builder, loc, accLoop.getResult(0)));
+              builder.create<scf::YieldOp>(loc);
+            });
+
+        builder.create<scf::YieldOp>(loc);
+      });
+
+  rewriter.create<memref::DeallocOp>(loc, rowBuffer);
+  rewriter.create<memref::DeallocOp>(loc, ringBuffer);
+}
+
+// Converts a vector of pixels to the vector type `toTy`. Integer pixels are
+// unsigned.
+static Value widenPixels(OpBuilder &builder, Location loc, Value vec,
+                         VectorType toTy) {
+  Type fromElemTy = vec.getType().cast<VectorType>().getElementType();
+  Type toElemTy = toTy.getElementType();
+  if (fromElemTy == toElemTy)
+    return vec;
+  if (fromElemTy.isa<FloatType>())
+    return builder.create<arith::ExtFOp>(loc, toTy, vec);
+  if (toElemTy.isa<FloatType>())
+    return builder.create<arith::UIToFPOp>(loc, toTy, vec);
+  return builder.create<arith::ExtUIOp>(loc, toTy, vec);
+}
+
+static Value addValues(OpBuilder &builder, Location loc, Value lhs,
+                       Value rhs) {
+  if (getElementTypeOrSelf(lhs.getType()).isa<FloatType>())
+    return builder.create<arith::AddFOp>(loc, lhs, rhs);
+  return builder.create<arith::AddIOp>(loc, lhs, rhs);
+}
+
+static Value subValues(OpBuilder &builder, Location loc, Value lhs,
+                       Value rhs) {
+  if (getElementTypeOrSelf(lhs.getType()).isa<FloatType>())
+    return builder.create<arith::SubFOp>(loc, lhs, rhs);
+  return builder.create<arith::SubIOp>(loc, lhs, rhs);
+}
+
+static Value mulValues(OpBuilder &builder, Location loc, Value lhs,
+                       Value rhs) {
+  if (getElementTypeOrSelf(lhs.getType()).isa<FloatType>())
+    return builder.create<arith::MulFOp>(loc, lhs, rhs);
+  return builder.create<arith::MulIOp>(loc, lhs, rhs);
+}
+
+// Inclusive prefix sum of the lanes of `vec`, computed with log2(stride)
+// shifted additions. `zeroVec` fills the lanes shifted in.
+static Value prefixSumVec(OpBuilder &builder, Location loc, Value vec,
+                          Value zeroVec, int64_t stride) {
+  for (int64_t shift = 1; shift < stride; shift *= 2) {
+    SmallVector<int64_t, 16> lanes;
+    for (int64_t lane = 0; lane < stride; ++lane)
+      lanes.push_back(lane < shift ? lane : stride + lane - shift);
+    Value shifted =
+        builder.create<vector::ShuffleOp>(loc, zeroVec, vec, lanes);
+    vec = addValues(builder, loc, vec, shifted);
+  }
+  return vec;
+}
+
+// Stores the running sum of `buffer[0, size)` into `prefix[1, size]`, with
+// prefix[0] = 0. The vectors of the buffer are scanned in registers and the
+// last lane of each carries to the next one.
+static void prefixSumRow(OpBuilder &builder, Location loc, Value buffer,
+                         Value prefix, Value size, VectorType vecTy,
+                         int64_t stride) {
+  MLIRContext *ctx = builder.getContext();
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value strideVal = builder.create<arith::ConstantIndexOp>(loc, stride);
+  Value lastLane = builder.create<arith::ConstantIndexOp>(loc, stride - 1);
+  VectorType vectorMaskTy = VectorType::get({stride}, builder.getI1Type());
+  Value zeroElem =
+      insertZeroConstantOp(ctx, builder, loc, vecTy.getElementType());
+  Value zeroVec = builder.create<vector::BroadcastOp>(loc, vecTy, zeroElem);
+
+  builder.create<memref::StoreOp>(loc, zeroElem, prefix, c0);
+  builder.create<scf::ForOp>(
+      loc, c0, size, strideVal, ValueRange{zeroElem},
+      [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange carry) {
+        Value mask = tailMaskCreator(builder, loc, size, iv[0], vectorMaskTy);
+        Value vec = builder.create<vector::MaskedLoadOp>(
+            loc, vecTy, buffer, iv[0], mask, zeroVec);
+        Value sum = addValues(
+            builder, loc, prefixSumVec(builder, loc, vec, zeroVec, stride),
+            builder.create<vector::BroadcastOp>(loc, vecTy, carry[0]));
+        Value prefixIdx = builder.create<arith::AddIOp>(loc, iv[0], c1);
+        builder.create<vector::MaskedStoreOp>(loc, prefix, prefixIdx, mask,
+                                              sum);
+        // Masked lanes are zero, so the last lane holds the running sum.
+        builder.create<scf::YieldOp>(
+            loc, ValueRange{builder.create<vector::ExtractElementOp>(
+                     loc, sum, lastLane)});
+      });
+}
+
+void integralImage(OpBuilder &builder, Location loc, MLIRContext *ctx,
+                   Value input, Value output, Type inElemTy, Type outElemTy,
+                   int64_t stride) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value strideVal = builder.create<arith::ConstantIndexOp>(loc, stride);
+  Value lastLane = builder.create<arith::ConstantIndexOp>(loc, stride - 1);
+
+  Value inputRow = builder.create<memref::DimOp>(loc, input, c0);
+  Value inputCol = builder.create<memref::DimOp>(loc, input, c1);
+  Value outputCol = builder.create<arith::AddIOp>(loc, inputCol, c1);
+
+  VectorType vectorTy = VectorType::get({stride}, inElemTy);
+  VectorType outVecTy = VectorType::get({stride}, outElemTy);
+  VectorType vectorMaskTy = VectorType::get({stride}, builder.getI1Type());
+  Value inZero = builder.create<vector::BroadcastOp>(
+      loc, vectorTy, insertZeroConstantOp(ctx, builder, loc, inElemTy));
+  Value outZeroElem = insertZeroConstantOp(ctx, builder, loc, outElemTy);
+  Value outZero =
+      builder.create<vector::BroadcastOp>(loc, outVecTy, outZeroElem);
+
+  // The first row and the first column are zero.
+  builder.create<scf::ForOp>(
+      loc, c0, outputCol, strideVal, ValueRange{},
+      [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange) {
+        Value mask =
+            tailMaskCreator(builder, loc, outputCol, iv[0], vectorMaskTy);
+        builder.create<vector::MaskedStoreOp>(loc, output,
+                                              ValueRange{c0, iv[0]}, mask,
+                                              outZero);
+        builder.create<scf::YieldOp>(loc);
+      });
+
+  // Each output row is the running sum of its input row plus the output row
+  // above it.
+  builder.create<scf::ForOp>(
+      loc, c0, inputRow, c1, ValueRange{},
+      [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange) {
+        Value row = builder.create<arith::AddIOp>(loc, iv[0], c1);
+        builder.create<memref::StoreOp>(loc, outZeroElem, output,
+                                        ValueRange{row, c0});
+        builder.create<scf::ForOp>(
+            loc, c0, inputCol, strideVal, ValueRange{outZeroElem},
+            [&](OpBuilder &builder, Location loc, ValueRange iv1,
+                ValueRange carry) {
+              Value mask =
+                  tailMaskCreator(builder, loc, inputCol, iv1[0], vectorMaskTy);
+              Value pixels = builder.create<vector::MaskedLoadOp>(
+                  loc, vectorTy, input, ValueRange{iv[0], iv1[0]}, mask,
+                  inZero);
+              pixels = widenPixels(builder, loc, pixels, outVecTy);
+              Value rowSum = addValues(
+                  builder, loc,
+                  prefixSumVec(builder, loc, pixels, outZero, stride),
+                  builder.create<vector::BroadcastOp>(loc, outVecTy,
+                                                      carry[0]));
+              Value col = builder.create<arith::AddIOp>(loc, iv1[0], c1);
+              Value above = builder.create<vector::MaskedLoadOp>(
+                  loc, outVecTy, output, ValueRange{iv[0], col}, mask,
+                  outZero);
+              builder.create<vector::MaskedStoreOp>(
+                  loc, output, ValueRange{row, col}, mask,
+                  addValues(builder, loc, rowSum, above));
+              builder.create<scf::YieldOp>(
+                  loc, ValueRange{builder.create<vector::ExtractElementOp>(
+                           loc, rowSum, lastLane)});
+            });
+        builder.create<scf::YieldOp>(loc);
+      });
+}
+
+void boxFilter(OpBuilder &builder, Location loc, MLIRContext *ctx, Value input,
+               Value output, Value kernelWidth, Value kernelHeight,
+               Value centerX, Value centerY, Value constantValue,
+               Type inElemTy, Type outElemTy,
+               buddy::dip::BoundaryOption boundaryOptionAttr, int64_t stride,
+               int64_t tileRows) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value strideVal = builder.create<arith::ConstantIndexOp>(loc, stride);
+
+  Value inputRow = builder.create<memref::DimOp>(loc, input, c0);
+  Value inputCol = builder.create<memref::DimOp>(loc, input, c1);
+  Value lastRow = builder.create<arith::SubIOp>(loc, inputRow, c1);
+
+  // Integer images of up to 16 bits are summed exactly in i32.
+  bool isFloat = inElemTy.isa<FloatType>();
+  bool outIsFloat = outElemTy.isa<FloatType>();
+  Type accTy = isFloat ? inElemTy : builder.getI32Type();
+  VectorType vectorTy = VectorType::get({stride}, inElemTy);
+  VectorType accVecTy = VectorType::get({stride}, accTy);
+  VectorType outVecTy = VectorType::get({stride}, outElemTy);
+  VectorType vectorMaskTy = VectorType::get({stride}, builder.getI1Type());
+  Value inZero = builder.create<vector::BroadcastOp>(
+      loc, vectorTy, insertZeroConstantOp(ctx, builder, loc, inElemTy));
+  Value accZero = builder.create<vector::BroadcastOp>(
+      loc, accVecTy, insertZeroConstantOp(ctx, builder, loc, accTy));
+  bool constantPadding =
+      boundaryOptionAttr == dip::BoundaryOption::ConstantPadding;
+  Value constantAcc = constantValue;
+  if (!isFloat)
+    constantAcc = builder.create<arith::ExtUIOp>(loc, accTy, constantValue);
+  Value constantAccVec =
+      builder.create<vector::BroadcastOp>(loc, accVecTy, constantAcc);
+
+  // Converts an index to a scalar of the accumulator type.
+  auto indexToAcc = [&](OpBuilder &builder, Location loc, Value idx,
+                        Type ty) -> Value {
+    Value val =
+        builder.create<arith::IndexCastOp>(loc, builder.getI32Type(), idx);
+    if (ty.isa<FloatType>())
+      val = builder.create<arith::UIToFPOp>(loc, ty, val);
+    return val;
+  };
+
+  // Window sums are divided by the area of the window. Integer results are
+  // rounded to nearest.
+  Value area = builder.create<arith::MulIOp>(loc, kernelWidth, kernelHeight);
+  Value scaleVec, halfAreaVec;
+  if (isFloat || outIsFloat) {
+    Type floatTy = isFloat ? accTy : outElemTy;
+    Value one = builder.create<arith::ConstantFloatOp>(
+        loc, APFloat(1.0f), builder.getF32Type());
+    if (!floatTy.isF32())
+      one = builder.create<arith::ExtFOp>(loc, floatTy, one);
+    Value scale = builder.create<arith::DivFOp>(
+        loc, one, indexToAcc(builder, loc, area, floatTy));
+    scaleVec = builder.create<vector::BroadcastOp>(
+        loc, VectorType::get({stride}, floatTy), scale);
+  } else {
+    Value areaAcc = indexToAcc(builder, loc, area, accTy);
+    scaleVec = builder.create<vector::BroadcastOp>(loc, accVecTy, areaAcc);
+    halfAreaVec = builder.create<vector::BroadcastOp>(
+        loc, accVecTy,
+        builder.create<arith::ShRUIOp>(
+            loc, areaAcc,
+            builder.create<arith::ConstantIntOp>(loc, 1, accTy)));
+  }
+  auto normalize = [&](OpBuilder &builder, Location loc, Value sum) -> Value {
+    if (!isFloat && !outIsFloat) {
+      Value res = builder.create<arith::DivUIOp>(
+          loc, builder.create<arith::AddIOp>(loc, sum, halfAreaVec),
+          scaleVec);
+      if (outElemTy == accTy)
+        return res;
+      return builder.create<arith::TruncIOp>(loc, outVecTy, res);
+    }
+    if (!isFloat)
+      sum = builder.create<arith::UIToFPOp>(loc, outVecTy, sum);
+    Value res = builder.create<arith::MulFOp>(loc, sum, scaleVec);
+    if (outIsFloat)
+      return res;
+    res = builder.create<math::RoundOp>(loc, res);
+    return builder.create<arith::FPToUIOp>(loc, outVecTy, res);
+  };
+
+  // Loads columns of the extrapolated input row `row` as accumulator values.
+  auto loadRow = [&](OpBuilder &builder, Location loc, Value row, Value col,
+                     Value mask) -> Value {
+    Value clampedRow = builder.create<arith::MinSIOp>(
+        loc, builder.create<arith::MaxSIOp>(loc, row, c0), lastRow);
+    Value pixels = builder.create<vector::MaskedLoadOp>(
+        loc, vectorTy, input, ValueRange{clampedRow, col}, mask, inZero);
+    pixels = widenPixels(builder, loc, pixels, accVecTy);
+    if (!constantPadding)
+      return pixels;
+    Value rowInBounds = inBound(builder, loc, row, c0, inputRow);
+    return builder.create<arith::SelectOp>(loc, rowInBounds, pixels,
+                                           constantAccVec);
+  };
+
+  // The column sums hold, for every extrapolated column, the sum of the
+  // kernelHeight rows of the window of the current output row. Output column
+  // j is the sum of the column sums [j, j + kernelWidth), which is the
+  // difference of two of their prefix sums.
+  Value paddedCol = builder.create<arith::AddIOp>(
+      loc, inputCol, builder.create<arith::SubIOp>(loc, kernelWidth, c1));
+  Value prefixSize = builder.create<arith::AddIOp>(loc, paddedCol, c1);
+  Value rightBegin = builder.create<arith::AddIOp>(loc, centerX, inputCol);
+  Value lastCol = builder.create<arith::SubIOp>(loc, rightBegin, c1);
+  MemRefType bufferTy = MemRefType::get({ShapedType::kDynamic}, accTy);
+  Value edgeSum;
+  if (constantPadding) {
+    Value heightAcc = indexToAcc(builder, loc, kernelHeight, accTy);
+    edgeSum = isFloat
+                  ? builder.create<arith::MulFOp>(loc, constantAcc, heightAcc)
+                        .getResult()
+                  : builder.create<arith::MulIOp>(loc, constantAcc, heightAcc)
+                        .getResult();
+  }
+
+  buildRowTileLoop(
+      builder, loc, c0, inputRow, tileRows,
+      [&](OpBuilder &builder, Location loc, Value rowBegin, Value rowEnd) {
+        Value colSum =
+            builder.create<memref::AllocOp>(loc, bufferTy, paddedCol);
+        Value prefix =
+            builder.create<memref::AllocOp>(loc, bufferTy, prefixSize);
+
+        // Sum the rows of the window of the first row of the tile.
+        Value firstRow = builder.create<arith::SubIOp>(loc, rowBegin, centerY);
+        builder.create<scf::ForOp>(
+            loc, c0, inputCol, strideVal, ValueRange{},
+            [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange) {
+              Value mask =
+                  tailMaskCreator(builder, loc, inputCol, iv[0], vectorMaskTy);
+              auto sumLoop = builder.create<scf::ForOp>(
+                  loc, c0, kernelHeight, c1, ValueRange{accZero},
+                  [&](OpBuilder &builder, Location loc, ValueRange iv1,
+                      ValueRange acc) {
+                    Value row =
+                        builder.create<arith::AddIOp>(loc, firstRow, iv1[0]);
+                    builder.create<scf::YieldOp>(
+                        loc, addValues(builder, loc, acc[0],
+                                       loadRow(builder, loc, row, iv[0],
+                                               mask)));
+                  });
+              Value sumIdx = builder.create<arith::AddIOp>(loc, iv[0], centerX);
+              builder.create<vector::MaskedStoreOp>(loc, colSum, sumIdx, mask,
+                                                    sumLoop.getResult(0));
+              builder.create<scf::YieldOp>(loc);
+            });
+
+        builder.create<scf::ForOp>(
+            loc, rowBegin, rowEnd, c1, ValueRange{},
+            [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange) {
+              // Extrapolate the column sums. The sums of replicated columns
+              // are the sums of the first and the last column.
+              Value leftSum = edgeSum, rightSum = edgeSum;
+              if (!constantPadding) {
+                leftSum = builder.create<memref::LoadOp>(loc, colSum, centerX);
+                rightSum = builder.create<memref::LoadOp>(loc, colSum, lastCol);
+              }
+              auto fillColSum = [&](Value begin, Value end, Value sum) {
+                builder.create<scf::ForOp>(
+                    loc, begin, end, c1, ValueRange{},
+                    [&](OpBuilder &builder, Location loc, ValueRange iv1,
+                        ValueRange) {
+                      builder.create<memref::StoreOp>(loc, sum, colSum, iv1[0]);
+                      builder.create<scf::YieldOp>(loc);
+                    });
+              };
+              fillColSum(c0, centerX, leftSum);
+              fillColSum(rightBegin, paddedCol, rightSum);
+              prefixSumRow(builder, loc, colSum, prefix, paddedCol, accVecTy,
+                           stride);
+
+              builder.create<scf::ForOp>(
+                  loc, c0, inputCol, strideVal, ValueRange{},
+                  [&](OpBuilder &builder, Location loc, ValueRange iv1,
+                      ValueRange) {
+                    Value mask = tailMaskCreator(builder, loc, inputCol,
+                                                 iv1[0], vectorMaskTy);
+                    Value endIdx =
+                        builder.create<arith::AddIOp>(loc, iv1[0], kernelWidth);
+                    Value windowEnd = builder.create<vector::MaskedLoadOp>(
+                        loc, accVecTy, prefix, endIdx, mask, accZero);
+                    Value windowBegin = builder.create<vector::MaskedLoadOp>(
+                        loc, accVecTy, prefix, iv1[0], mask, accZero);
+                    Value sum = subValues(builder, loc, windowEnd, windowBegin);
+                    builder.create<vector::MaskedStoreOp>(
+                        loc, output, ValueRange{iv[0], iv1[0]}, mask,
+                        normalize(builder, loc, sum));
+                    builder.create<scf::YieldOp>(loc);
+                  });
+
+              // Slide the window down by one row.
+              Value oldRow = builder.create<arith::SubIOp>(loc, iv[0], centerY);
+              Value newRow =
+                  builder.create<arith::AddIOp>(loc, oldRow, kernelHeight);
+              builder.create<scf::ForOp>(
+                  loc, c0, inputCol, strideVal, ValueRange{},
+                  [&](OpBuilder &builder, Location loc, ValueRange iv1,
+                      ValueRange) {
+                    Value mask = tailMaskCreator(builder, loc, inputCol,
+                                                 iv1[0], vectorMaskTy);
+                    Value sumIdx =
+                        builder.create<arith::AddIOp>(loc, iv1[0], centerX);
+                    Value sum = builder.create<vector::MaskedLoadOp>(
+                        loc, accVecTy, colSum, sumIdx, mask, accZero);
+                    Value added = loadRow(builder, loc, newRow, iv1[0], mask);
+                    Value removed =
+                        loadRow(builder, loc, oldRow, iv1[0], mask);
+                    sum = subValues(builder, loc,
+                                    addValues(builder, loc, sum, added),
+                                    removed);
+                    builder.create<vector::MaskedStoreOp>(loc, colSum, sumIdx,
+                                                          mask, sum);
+                    builder.create<scf::YieldOp>(loc);
+                  });
+              builder.create<scf::YieldOp>(loc);
+            });
+
+        builder.create<memref::DeallocOp>(loc, colSum);
+        builder.create<memref::DeallocOp>(loc, prefix);
+      });
+}
+
+// Number of box filters approximating a Gaussian blur.
+static constexpr int64_t kGaussianBoxPasses = 3;
+
+void gaussianBlur(OpBuilder &builder, Location loc, MLIRContext *ctx,
+                  Value input, Value output, Value sigmaX, Value sigmaY,
+                  Value constantValue, Type elemTy,
+                  buddy::dip::BoundaryOption boundaryOptionAttr,
+                  int64_t stride, int64_t tileRows) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value c2 = builder.create<arith::ConstantIndexOp>(loc, 2);
+  Value passes =
+      builder.create<arith::ConstantIndexOp>(loc, kGaussianBoxPasses);
+  FloatType f32 = builder.getF32Type();
+  auto f32Const = [&](float val) -> Value {
+    return builder.create<arith::ConstantFloatOp>(loc, APFloat(val), f32);
+  };
+
+  // The widths of the boxes whose variances add up to sigma^2: the largest odd
+  // width wl below the ideal one for m passes and wl + 2 for the others, with
+  // m chosen to match the variance best.
+  auto boxWidths = [&](Value sigma) -> SmallVector<Value, 3> {
+    Value n = f32Const(kGaussianBoxPasses);
+    Value variance = builder.create<arith::MulFOp>(loc, sigma, sigma);
+    Value twelveVar =
+        builder.create<arith::MulFOp>(loc, f32Const(12.0f), variance);
+    Value idealWidth = builder.create<math::SqrtOp>(
+        loc, builder.create<arith::AddFOp>(
+                 loc, builder.create<arith::DivFOp>(loc, twelveVar, n),
+                 f32Const(1.0f)));
+    Value small = floorToIndex(builder, loc, idealWidth);
+    Value even = builder.create<arith::XOrIOp>(
+        loc, builder.create<arith::AndIOp>(loc, small, c1), c1);
+    small = builder.create<arith::SubIOp>(loc, small, even);
+    Value large = builder.create<arith::AddIOp>(loc, small, c2);
+
+    // m = round((12 sigma^2 - n wl^2 - 4 n wl - 3 n) / (-4 wl - 4)).
+    Value smallF32 = indexToF32(builder, loc, small);
+    Value numerator = builder.create<arith::SubFOp>(
+        loc, twelveVar,
+        builder.create<arith::MulFOp>(
+            loc, n,
+            builder.create<arith::AddFOp>(
+                loc,
+                builder.create<arith::MulFOp>(
+                    loc, smallF32,
+                    builder.create<arith::AddFOp>(loc, smallF32,
+                                                  f32Const(4.0f))),
+                f32Const(3.0f))));
+    Value denominator = builder.create<arith::SubFOp>(
+        loc, f32Const(-4.0f),
+        builder.create<arith::MulFOp>(loc, f32Const(4.0f), smallF32));
+    Value numSmall = floorToIndex(
+        builder, loc,
+        builder.create<arith::AddFOp>(
+            loc, builder.create<arith::DivFOp>(loc, numerator, denominator),
+            f32Const(0.5f)));
+    numSmall = builder.create<arith::MinSIOp>(
+        loc, builder.create<arith::MaxSIOp>(loc, numSmall, c0), passes);
+
+    SmallVector<Value, 3> widths;
+    for (int64_t pass = 0; pass < kGaussianBoxPasses; ++pass) {
+      Value passIdx = builder.create<arith::ConstantIndexOp>(loc, pass);
+      Value isSmall = builder.create<arith::CmpIOp>(
+          loc, arith::CmpIPredicate::slt, passIdx, numSmall);
+      widths.push_back(
+          builder.create<arith::SelectOp>(loc, isSmall, small, large));
+    }
+    return widths;
+  };
+  SmallVector<Value, 3> widthsX = boxWidths(sigmaX);
+  SmallVector<Value, 3> widthsY = boxWidths(sigmaY);
+
+  // Intermediate results of integer images are kept in f32, so that only the
+  // final result is rounded.
+  Type tmpTy = elemTy.isa<FloatType>() ? elemTy : f32;
+  Value tmpConstant = constantValue;
+  if (tmpTy != elemTy)
+    tmpConstant = builder.create<arith::UIToFPOp>(loc, f32, constantValue);
+  Value inputRow = builder.create<memref::DimOp>(loc, input, c0);
+  Value inputCol = builder.create<memref::DimOp>(loc, input, c1);
+  MemRefType tmpMemRefTy =
+      MemRefType::get({ShapedType::kDynamic, ShapedType::kDynamic}, tmpTy);
+  Value buffers[2] = {
+      builder.create<memref::AllocOp>(loc, tmpMemRefTy,
+                                      ValueRange{inputRow, inputCol}),
+      builder.create<memref::AllocOp>(loc, tmpMemRefTy,
+                                      ValueRange{inputRow, inputCol})};
+
+  // Each pass extrapolates the result of the previous one as per the boundary
+  // option.
+  for (int64_t pass = 0; pass < kGaussianBoxPasses; ++pass) {
+    bool first = pass == 0;
+    bool last = pass == kGaussianBoxPasses - 1;
+    Value src = first ? input : buffers[(pass + 1) % 2];
+    Value dst = last ? output : buffers[pass % 2];
+    Value centerX = builder.create<arith::DivUIOp>(
+        loc, builder.create<arith::SubIOp>(loc, widthsX[pass], c1), c2);
+    Value centerY = builder.create<arith::DivUIOp>(
+        loc, builder.create<arith::SubIOp>(loc, widthsY[pass], c1), c2);
+    boxFilter(builder, loc, ctx, src, dst, widthsX[pass], widthsY[pass],
+              centerX, centerY, first ? constantValue : tmpConstant,
+              first ? elemTy : tmpTy, last ? elemTy : tmpTy,
+              boundaryOptionAttr, stride, tileRows);
+  }
+
+  for (Value buffer : buffers)
+    builder.create<memref::DeallocOp>(loc, buffer);
+}
+
+// Copies the rows [rowBegin - anchor, rowEnd - anchor + kernelSize - 1) of
+// `input`, extrapolated as per the boundary option, into a new buffer with
+// `anchor` extrapolated columns on the left and kernelSize - 1 - anchor on the
+// right, so that the windows of the rows [rowBegin, rowEnd) need no bounds
+// checks.
+static Value padImageRows(OpBuilder &builder, Location loc, MLIRContext *ctx,
+                          Value input, Value rowBegin, Value rowEnd,
+                          Value kernelSize, Value anchor, Value constantValue,
+                          Type elemTy,
+                          buddy::dip::BoundaryOption boundaryOptionAttr,
+                          int64_t stride) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value strideVal = builder.create<arith::ConstantIndexOp>(loc, stride);
+
+  Value inputRow = builder.create<memref::DimOp>(loc, input, c0);
+  Value inputCol = builder.create<memref::DimOp>(loc, input, c1);
+  Value lastRow = builder.create<arith::SubIOp>(loc, inputRow, c1);
+  Value lastCol = builder.create<arith::SubIOp>(loc, inputCol, c1);
+  Value border = builder.create<arith::SubIOp>(loc, kernelSize, c1);
+  Value paddedRows = builder.create<arith::AddIOp>(
+      loc, builder.create<arith::SubIOp>(loc, rowEnd, rowBegin), border);
+  Value paddedCols = builder.create<arith::AddIOp>(loc, inputCol, border);
+  Value rightBegin = builder.create<arith::AddIOp>(loc, anchor, inputCol);
+  Value firstRow = builder.create<arith::SubIOp>(loc, rowBegin, anchor);
+
+  VectorType vectorTy = VectorType::get({stride}, elemTy);
+  VectorType vectorMaskTy = VectorType::get({stride}, builder.getI1Type());
+  Value zeroVec = builder.create<vector::BroadcastOp>(
+      loc, vectorTy, insertZeroConstantOp(ctx, builder, loc, elemTy));
+  Value constantVec =
+      builder.create<vector::BroadcastOp>(loc, vectorTy, constantValue);
+  bool constantPadding =
+      boundaryOptionAttr == dip::BoundaryOption::ConstantPadding;
+
+  MemRefType paddedTy =
+      MemRefType::get({ShapedType::kDynamic, ShapedType::kDynamic}, elemTy);
+  Value padded = builder.create<memref::AllocOp>(
+      loc, paddedTy, ValueRange{paddedRows, paddedCols});
+
+  builder.create<scf::ForOp>(
+      loc, c0, paddedRows, c1, ValueRange{},
+      [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange) {
+        Value row = builder.create<arith::AddIOp>(loc, firstRow, iv[0]);
+        Value srcRow = builder.create<arith::MinSIOp>(
+            loc, builder.create<arith::MaxSIOp>(loc, row, c0), lastRow);
+        Value rowInBounds;
+        if (constantPadding)
+          rowInBounds = inBound(builder, loc, row, c0, inputRow);
+
+        builder.create<scf::ForOp>(
+            loc, c0, inputCol, strideVal, ValueRange{},
+            [&](OpBuilder &builder, Location loc, ValueRange iv1,
+                ValueRange) {
+              Value mask =
+                  tailMaskCreator(builder, loc, inputCol, iv1[0], vectorMaskTy);
+              Value pixels = builder.create<vector::MaskedLoadOp>(
+                  loc, vectorTy, input, ValueRange{srcRow, iv1[0]}, mask,
+                  zeroVec);
+              if (constantPadding)
+                pixels = builder.create<arith::SelectOp>(loc, rowInBounds,
+                                                         pixels, constantVec);
+              Value col = builder.create<arith::AddIOp>(loc, iv1[0], anchor);
+              builder.create<vector::MaskedStoreOp>(
+                  loc, padded, ValueRange{iv[0], col}, mask, pixels);
+              builder.create<scf::YieldOp>(loc);
+            });
+
+        // Fill the columns left and right of the image.
+        Value left = constantValue, right = constantValue;
+        if (!constantPadding) {
+          left = builder.create<memref::LoadOp>(loc, input,
+                                                ValueRange{srcRow, c0});
+          right = builder.create<memref::LoadOp>(loc, input,
+                                                 ValueRange{srcRow, lastCol});
+        }
+        auto fillCols = [&](Value begin, Value end, Value val) {
+          builder.create<scf::ForOp>(
+              loc, begin, end, c1, ValueRange{},
+              [&](OpBuilder &builder, Location loc, ValueRange iv1,
+                  ValueRange) {
+                builder.create<memref::StoreOp>(loc, val, padded,
+                                                ValueRange{iv[0], iv1[0]});
+                builder.create<scf::YieldOp>(loc);
+              });
+        };
+        fillCols(c0, anchor, left);
+        fillCols(rightBegin, paddedCols, right);
+        builder.create<scf::YieldOp>(loc);
+      });
+  return padded;
+}
+
+// Comparators (lo, hi) of Batcher's odd-even merge sort of `size` elements.
+// The network is generated for the next power of two and the comparators with
+// a missing element, which would compare as +inf, are dropped.
+static SmallVector<std::pair<int64_t, int64_t>, 0>
+oddEvenMergeSortNetwork(int64_t size) {
+  int64_t paddedSize = llvm::PowerOf2Ceil(size);
+  SmallVector<std::pair<int64_t, int64_t>, 0> network;
+  for (int64_t p = 1; p < paddedSize; p *= 2)
+    for (int64_t k = p; k >= 1; k /= 2)
+      for (int64_t j = k % p; j + k < paddedSize; j += 2 * k)
+        for (int64_t i = 0; i < std::min(k, paddedSize - j - k); ++i)
+          if ((i + j) / (2 * p) == (i + j + k) / (2 * p) && i + j + k < size)
+            network.emplace_back(i + j, i + j + k);
+  return network;
+}
+
+// Sorts `values` lane-wise with a sorting network. With a non-negative
+// `target`, only the comparator outputs that values[target] depends on are
+// computed, e.g. 40 min/max operations instead of 56 for the median of 9.
+static void sortValues(OpBuilder &builder, Location loc,
+                       SmallVectorImpl<Value> &values, Type elemTy,
+                       int64_t target) {
+  auto network = oddEvenMergeSortNetwork(values.size());
+  // Walk the network backwards to find which comparator outputs are live.
+  SmallVector<std::pair<bool, bool>, 0> needed(network.size(), {true, true});
+  if (target >= 0) {
+    SmallVector<bool, 32> live(values.size(), false);
+    live[target] = true;
+    for (size_t i = network.size(); i-- > 0;) {
+      auto [lo, hi] = network[i];
+      needed[i] = {live[lo], live[hi]};
+      if (live[lo] || live[hi])
+        live[lo] = live[hi] = true;
+    }
+  }
+
+  bool isFloat = elemTy.isa<FloatType>();
+  for (size_t i = 0; i < network.size(); ++i) {
+    auto [lo, hi] = network[i];
+    Value a = values[lo], b = values[hi];
+    if (isFloat) {
+      if (needed[i].first)
+        values[lo] = builder.create<arith::MinimumFOp>(loc, a, b);
+      if (needed[i].second)
+        values[hi] = builder.create<arith::MaximumFOp>(loc, a, b);
+    } else {
+      if (needed[i].first)
+        values[lo] = builder.create<arith::MinUIOp>(loc, a, b);
+      if (needed[i].second)
+        values[hi] = builder.create<arith::MaxUIOp>(loc, a, b);
+    }
+  }
+}
+
+// Layout of the histograms of the 8-bit rank filter: 256 fine bins followed by
+// 16 coarse bins, each counting the values of 16 consecutive fine bins.
+static constexpr int64_t kFineBins = 256;
+static constexpr int64_t kCoarseBins = 16;
+static constexpr int64_t kHistogramSize = kFineBins + kCoarseBins;
+
+void rankFilter(OpBuilder &builder, Location loc, MLIRContext *ctx,
+                Value input, Value output, Value kernelSize, Value rank,
+                Value constantValue, Type elemTy,
+                buddy::dip::BoundaryOption boundaryOptionAttr, int64_t stride,
+                int64_t tileRows) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value c2 = builder.create<arith::ConstantIndexOp>(loc, 2);
+  Value strideVal = builder.create<arith::ConstantIndexOp>(loc, stride);
+
+  Value inputRow = builder.create<memref::DimOp>(loc, input, c0);
+  Value inputCol = builder.create<memref::DimOp>(loc, input, c1);
+  Value anchor = builder.create<arith::DivUIOp>(loc, kernelSize, c2);
+  Value area = builder.create<arith::MulIOp>(loc, kernelSize, kernelSize);
+  Value lastRank = builder.create<arith::SubIOp>(loc, area, c1);
+  bool isMedian = !rank;
+  rank = isMedian ? builder.create<arith::DivUIOp>(loc, area, c2).getResult()
+                  : builder.create<arith::MinUIOp>(loc, rank, lastRank)
+                        .getResult();
+
+  bool isFloat = elemTy.isa<FloatType>();
+  IntegerType i32 = builder.getI32Type();
+  VectorType vectorTy = VectorType::get({stride}, elemTy);
+  VectorType countVecTy = VectorType::get({stride}, i32);
+  VectorType vectorMaskTy = VectorType::get({stride}, builder.getI1Type());
+  Value zeroVec = builder.create<vector::BroadcastOp>(
+      loc, vectorTy, insertZeroConstantOp(ctx, builder, loc, elemTy));
+  Value countZero = builder.create<vector::BroadcastOp>(
+      loc, countVecTy, builder.create<arith::ConstantIntOp>(loc, 0, 32));
+  Value rankI32 = builder.create<arith::IndexCastOp>(loc, i32, rank);
+
+  buildRowTileLoop(
+      builder, loc, c0, inputRow, tileRows,
+      [&](OpBuilder &builder, Location loc, Value rowBegin, Value rowEnd) {
+        Value padded = padImageRows(builder, loc, ctx, input, rowBegin,
+                                    rowEnd, kernelSize, anchor, constantValue,
+                                    elemTy, boundaryOptionAttr, stride);
+        Value tileRowCount =
+            builder.create<arith::SubIOp>(loc, rowEnd, rowBegin);
+
+        // Visits the output vectors of the tile with their row in the padded
+        // buffer, their column and their tail mask.
+        auto forEachOutputVec =
+            [&](OpBuilder &builder, Location loc,
+                function_ref<Value(OpBuilder &, Location, Value, Value,
+                                   Value)>
+                    bodyFn) {
+              builder.create<scf::ForOp>(
+                  loc, c0, tileRowCount, c1, ValueRange{},
+                  [&](OpBuilder &builder, Location loc, ValueRange iv,
+                      ValueRange) {
+                    Value outRow =
+                        builder.create<arith::AddIOp>(loc, rowBegin, iv[0]);
+                    builder.create<scf::ForOp>(
+                        loc, c0, inputCol, strideVal, ValueRange{},
+                        [&](OpBuilder &builder, Location loc, ValueRange iv1,
+                            ValueRange) {
+                          Value mask = tailMaskCreator(builder, loc, inputCol,
+                                                       iv1[0], vectorMaskTy);
+                          Value res =
+                              bodyFn(builder, loc, iv[0], iv1[0], mask);
+                          builder.create<vector::MaskedStoreOp>(
+                              loc, output, ValueRange{outRow, iv1[0]}, mask,
+                              res);
+                          builder.create<scf::YieldOp>(loc);
+                        });
+                    builder.create<scf::YieldOp>(loc);
+                  });
+            };
+
+        // Small windows are sorted with a network in registers. The median is
+        // known statically, other ranks are selected at runtime.
+        auto networkFilter = [&](OpBuilder &builder, Location loc,
+                                 int64_t size) {
+          int64_t windowArea = size * size;
+          SmallVector<Value, 25> isRank;
+          if (!isMedian)
+            for (int64_t i = 0; i < windowArea; ++i)
+              isRank.push_back(builder.create<arith::CmpIOp>(
+                  loc, arith::CmpIPredicate::eq, rank,
+                  builder.create<arith::ConstantIndexOp>(loc, i)));
+          forEachOutputVec(
+              builder, loc,
+              [&](OpBuilder &builder, Location loc, Value row, Value col,
+                  Value mask) -> Value {
+                SmallVector<Value, 25> values;
+                for (int64_t dy = 0; dy < size; ++dy) {
+                  Value windowRow = builder.create<arith::AddIOp>(
+                      loc, row,
+                      builder.create<arith::ConstantIndexOp>(loc, dy));
+                  for (int64_t dx = 0; dx < size; ++dx) {
+                    Value windowCol = builder.create<arith::AddIOp>(
+                        loc, col,
+                        builder.create<arith::ConstantIndexOp>(loc, dx));
+                    values.push_back(builder.create<vector::MaskedLoadOp>(
+                        loc, vectorTy, padded,
+                        ValueRange{windowRow, windowCol}, mask, zeroVec));
+                  }
+                }
+                sortValues(builder, loc, values, elemTy,
+                           isMedian ? windowArea / 2 : -1);
+                if (isMedian)
+                  return values[windowArea / 2];
+                Value res = values[0];
+                for (int64_t i = 1; i < windowArea; ++i)
+                  res = builder.create<arith::SelectOp>(loc, isRank[i],
+                                                        values[i], res);
+                return res;
+              });
+        };
+
+        // Other windows select the element of rank `rank` like
+        // std::nth_element, with the FIND algorithm of Hoare: the window is
+        // copied to a scratch buffer, which is partitioned around the element
+        // at the rank position until the part holding that position is a
+        // single element. This takes O(area) comparisons on average.
+        auto selectionFilter = [&](OpBuilder &builder, Location loc) {
+          Type indexTy = builder.getIndexType();
+          Value window = builder.create<memref::AllocOp>(
+              loc, MemRefType::get({ShapedType::kDynamic}, elemTy), area);
+          auto isLess = [&](OpBuilder &builder, Location loc, Value a,
+                            Value b) -> Value {
+            if (isFloat)
+              return builder.create<arith::CmpFOp>(
+                  loc, arith::CmpFPredicate::OLT, a, b);
+            return builder.create<arith::CmpIOp>(loc, arith::CmpIPredicate::ult,
+                                                 a, b);
+          };
+          // Moves `idx` by `step` while `keepGoing` holds for the element at
+          // `idx`.
+          auto scan = [&](OpBuilder &builder, Location loc, Value idx,
+                          Value step,
+                          function_ref<Value(OpBuilder &, Location, Value)>
+                              keepGoing) -> Value {
+            auto whileOp = builder.create<scf::WhileOp>(
+                loc, TypeRange{indexTy}, ValueRange{idx},
+                [&](OpBuilder &builder, Location loc, ValueRange args) {
+                  Value elem = builder.create<memref::LoadOp>(loc, window,
+                                                              args[0]);
+                  builder.create<scf::ConditionOp>(
+                      loc, keepGoing(builder, loc, elem), args);
+                },
+                [&](OpBuilder &builder, Location loc, ValueRange args) {
+                  Value next =
+                      builder.create<arith::AddIOp>(loc, args[0], step);
+                  builder.create<scf::YieldOp>(loc, next);
+                });
+            return whileOp.getResult(0);
+          };
+          Value minusOneIdx = builder.create<arith::ConstantIndexOp>(loc, -1);
+
+          builder.create<scf::ForOp>(
+              loc, c0, tileRowCount, c1, ValueRange{},
+              [&](OpBuilder &builder, Location loc, ValueRange iv,
+                  ValueRange) {
+                Value outRow =
+                    builder.create<arith::AddIOp>(loc, rowBegin, iv[0]);
+                builder.create<scf::ForOp>(
+                    loc, c0, inputCol, c1, ValueRange{},
+                    [&](OpBuilder &builder, Location loc, ValueRange iv1,
+                        ValueRange) {
+                      // Copy the window row by row.
+                      builder.create<scf::ForOp>(
+                          loc, c0, kernelSize, c1, ValueRange{},
+                          [&](OpBuilder &builder, Location loc, ValueRange dy,
+                              ValueRange) {
+                            Value windowRow = builder.create<arith::AddIOp>(
+                                loc, iv[0], dy[0]);
+                            Value rowBase =
+                                builder.create<arith::MulIOp>(loc, dy[0],
+                                                              kernelSize);
+                            builder.create<scf::ForOp>(
+                                loc, c0, kernelSize, strideVal, ValueRange{},
+                                [&](OpBuilder &builder, Location loc,
+                                    ValueRange dx, ValueRange) {
+                                  Value mask = tailMaskCreator(
+                                      builder, loc, kernelSize, dx[0],
+                                      vectorMaskTy);
+                                  Value vec =
+                                      builder.create<vector::MaskedLoadOp>(
+                                          loc, vectorTy, padded,
+                                          ValueRange{windowRow,
+                                                     builder.create<
+                                                         arith::AddIOp>(
+                                                         loc, iv1[0], dx[0])},
+                                          mask, zeroVec);
+                                  builder.create<vector::MaskedStoreOp>(
+                                      loc, window,
+                                      ValueRange{builder.create<arith::AddIOp>(
+                                          loc, rowBase, dx[0])},
+                                      mask, vec);
+                                  builder.create<scf::YieldOp>(loc);
+                                });
+                            builder.create<scf::YieldOp>(loc);
+                          });
+
+                      // Narrow [lo, hi] down to the rank position. Indices are
+                      // compared as signed, since hi may step below zero.
+                      builder.create<scf::WhileOp>(
+                          loc, TypeRange{indexTy, indexTy},
+                          ValueRange{c0, lastRank},
+                          [&](OpBuilder &builder, Location loc,
+                              ValueRange args) {
+                            builder.create<scf::ConditionOp>(
+                                loc,
+                                builder.create<arith::CmpIOp>(
+                                    loc, arith::CmpIPredicate::slt, args[0],
+                                    args[1]),
+                                args);
+                          },
+                          [&](OpBuilder &builder, Location loc,
+                              ValueRange args) {
+                            Value pivot =
+                                builder.create<memref::LoadOp>(loc, window,
+                                                               rank);
+                            // Swap the out-of-place pairs until the scans
+                            // cross.
+                            auto partition = builder.create<scf::WhileOp>(
+                                loc, TypeRange{indexTy, indexTy}, args,
+                                [&](OpBuilder &builder, Location loc,
+                                    ValueRange ij) {
+                                  Value i = scan(
+                                      builder, loc, ij[0], c1,
+                                      [&](OpBuilder &builder, Location loc,
+                                          Value elem) {
+                                        return isLess(builder, loc, elem,
+                                                      pivot);
+                                      });
+                                  Value j = scan(
+                                      builder, loc, ij[1], minusOneIdx,
+                                      [&](OpBuilder &builder, Location loc,
+                                          Value elem) {
+                                        return isLess(builder, loc, pivot,
+                                                      elem);
+                                      });
+                                  Value notCrossed =
+                                      builder.create<arith::CmpIOp>(
+                                          loc, arith::CmpIPredicate::sle, i, j);
+                                  auto swapOp = builder.create<scf::IfOp>(
+                                      loc, notCrossed,
+                                      [&](OpBuilder &builder, Location loc) {
+                                        Value a =
+                                            builder.create<memref::LoadOp>(
+                                                loc, window, i);
+                                        Value b =
+                                            builder.create<memref::LoadOp>(
+                                                loc, window, j);
+                                        builder.create<memref::StoreOp>(
+                                            loc, b, window, i);
+                                        builder.create<memref::StoreOp>(
+                                            loc, a, window, j);
+                                        builder.create<scf::YieldOp>(
+                                            loc,
+                                            ValueRange{
+                                                builder.create<arith::AddIOp>(
+                                                    loc, i, c1),
+                                                builder.create<arith::SubIOp>(
+                                                    loc, j, c1)});
+                                      },
+                                      [&](OpBuilder &builder, Location loc) {
+                                        builder.create<scf::YieldOp>(
+                                            loc, ValueRange{i, j});
+                                      });
+                                  Value nextI = swapOp.getResult(0);
+                                  Value nextJ = swapOp.getResult(1);
+                                  builder.create<scf::ConditionOp>(
+                                      loc,
+                                      builder.create<arith::CmpIOp>(
+                                          loc, arith::CmpIPredicate::sle,
+                                          nextI, nextJ),
+                                      ValueRange{nextI, nextJ});
+                                },
+                                [&](OpBuilder &builder, Location loc,
+                                    ValueRange ij) {
+                                  builder.create<scf::YieldOp>(loc, ij);
+                                });
+                            Value i = partition.getResult(0);
+                            Value j = partition.getResult(1);
+                            // Keep the part holding the rank position.
+                            Value lo = builder.create<arith::SelectOp>(
+                                loc,
+                                builder.create<arith::CmpIOp>(
+                                    loc, arith::CmpIPredicate::slt, j, rank),
+                                i, args[0]);
+                            Value hi = builder.create<arith::SelectOp>(
+                                loc,
+                                builder.create<arith::CmpIOp>(
+                                    loc, arith::CmpIPredicate::slt, rank, i),
+                                j, args[1]);
+                            builder.create<scf::YieldOp>(loc,
+                                                         ValueRange{lo, hi});
+                          });
+                      builder.create<memref::StoreOp>(
+                          loc,
+                          builder.create<memref::LoadOp>(loc, window, rank),
+                          output, ValueRange{outRow, iv1[0]});
+                      builder.create<scf::YieldOp>(loc);
+                    });
+                builder.create<scf::YieldOp>(loc);
+              });
+          builder.create<memref::DeallocOp>(loc, window);
+        };
+
+        // 8-bit windows use the constant-time algorithm of Perreault and
+        // Hebert: every padded column keeps the histogram of its kernelSize
+        // rows, which slides down by one row per output row, and the window
+        // histogram slides right by adding the entering column histogram and
+        // subtracting the leaving one. The rank is found in the coarse bins
+        // and then in the 16 fine bins of the coarse bin.
+        auto histogramFilter = [&](OpBuilder &builder, Location loc) {
+          Value border = builder.create<arith::SubIOp>(loc, kernelSize, c1);
+          Value paddedCols =
+              builder.create<arith::AddIOp>(loc, inputCol, border);
+          Value histSize =
+              builder.create<arith::ConstantIndexOp>(loc, kHistogramSize);
+          Value fineBins =
+              builder.create<arith::ConstantIndexOp>(loc, kFineBins);
+          Value c4 = builder.create<arith::ConstantIndexOp>(loc, 4);
+          Value c16 = builder.create<arith::ConstantIndexOp>(loc, kCoarseBins);
+          Value one = builder.create<arith::ConstantIntOp>(loc, 1, 32);
+          Value minusOne = builder.create<arith::ConstantIntOp>(loc, -1, 32);
+          VectorType binVecTy = VectorType::get({kCoarseBins}, i32);
+          Value binZero = builder.create<vector::BroadcastOp>(
+              loc, binVecTy, builder.create<arith::ConstantIntOp>(loc, 0, 32));
+
+          Value colHist = builder.create<memref::AllocOp>(
+              loc, MemRefType::get({ShapedType::kDynamic, kHistogramSize}, i32),
+              paddedCols);
+          Value windowHist = builder.create<memref::AllocOp>(
+              loc, MemRefType::get({kHistogramSize}, i32));
+
+          // Applies `fn` to every vector of histogram bins.
+          auto forEachBinVec = [&](OpBuilder &builder, Location loc,
+                                   function_ref<void(OpBuilder &, Location,
+                                                     Value, Value)>
+                                       fn) {
+            builder.create<scf::ForOp>(
+                loc, c0, histSize, strideVal, ValueRange{},
+                [&](OpBuilder &builder, Location loc, ValueRange iv,
+                    ValueRange) {
+                  Value mask = tailMaskCreator(builder, loc, histSize, iv[0],
+                                               vectorMaskTy);
+                  fn(builder, loc, iv[0], mask);
+                  builder.create<scf::YieldOp>(loc);
+                });
+          };
+
+          // Adds the padded row `row` to the column histograms, or removes it
+          // with a `delta` of -1.
+          auto updateColumns = [&](OpBuilder &builder, Location loc, Value row,
+                                   Value delta) {
+            builder.create<scf::ForOp>(
+                loc, c0, paddedCols, c1, ValueRange{},
+                [&](OpBuilder &builder, Location loc, ValueRange iv,
+                    ValueRange) {
+                  Value pixel = builder.create<memref::LoadOp>(
+                      loc, padded, ValueRange{row, iv[0]});
+                  Value fine = builder.create<arith::IndexCastOp>(
+                      loc, builder.getIndexType(),
+                      builder.create<arith::ExtUIOp>(loc, i32, pixel));
+                  Value coarse = builder.create<arith::AddIOp>(
+                      loc, fineBins,
+                      builder.create<arith::ShRUIOp>(loc, fine, c4));
+                  for (Value bin : {fine, coarse}) {
+                    Value count = builder.create<memref::LoadOp>(
+                        loc, colHist, ValueRange{iv[0], bin});
+                    builder.create<memref::StoreOp>(
+                        loc, builder.create<arith::AddIOp>(loc, count, delta),
+                        colHist, ValueRange{iv[0], bin});
+                  }
+                  builder.create<scf::YieldOp>(loc);
+                });
+          };
+
+          // Adds the histogram of padded column `col` to the window histogram,
+          // or subtracts it.
+          auto updateWindow = [&](OpBuilder &builder, Location loc, Value col,
+                                  bool add) {
+            forEachBinVec(
+                builder, loc,
+                [&](OpBuilder &builder, Location loc, Value bin, Value mask) {
+                  Value counts = builder.create<vector::MaskedLoadOp>(
+                      loc, countVecTy, windowHist, bin, mask, countZero);
+                  Value colCounts = builder.create<vector::MaskedLoadOp>(
+                      loc, countVecTy, colHist, ValueRange{col, bin}, mask,
+                      countZero);
+                  counts = add ? builder.create<arith::AddIOp>(loc, counts,
+                                                               colCounts)
+                                     .getResult()
+                               : builder.create<arith::SubIOp>(loc, counts,
+                                                               colCounts)
+                                     .getResult();
+                  builder.create<vector::MaskedStoreOp>(loc, windowHist, bin,
+                                                        mask, counts);
+                });
+          };
+
+          // Returns the bin of `counts` holding the element of rank `target`
+          // and the number of elements in the bins before it.
+          auto findBin = [&](OpBuilder &builder, Location loc, Value counts,
+                             Value target) -> std::pair<Value, Value> {
+            Value prefix =
+                prefixSumVec(builder, loc, counts, binZero, kCoarseBins);
+            Value isBefore = builder.create<arith::CmpIOp>(
+                loc, arith::CmpIPredicate::ule, prefix,
+                builder.create<vector::BroadcastOp>(loc, binVecTy, target));
+            Value bin = builder.create<vector::ReductionOp>(
+                loc, vector::CombiningKind::ADD,
+                builder.create<arith::ExtUIOp>(loc, binVecTy, isBefore));
+            Value skipped = builder.create<vector::ReductionOp>(
+                loc, vector::CombiningKind::ADD,
+                builder.create<arith::SelectOp>(loc, isBefore, counts,
+                                                binZero));
+            return {bin, skipped};
+          };
+
+          builder.create<scf::ForOp>(
+              loc, c0, paddedCols, c1, ValueRange{},
+              [&](OpBuilder &builder, Location loc, ValueRange iv,
+                  ValueRange) {
+                forEachBinVec(builder, loc,
+                              [&](OpBuilder &builder, Location loc, Value bin,
+                                  Value mask) {
+                                builder.create<vector::MaskedStoreOp>(
+                                    loc, colHist, ValueRange{iv[0], bin}, mask,
+                                    countZero);
+                              });
+                builder.create<scf::YieldOp>(loc);
+              });
+          builder.create<scf::ForOp>(
+              loc, c0, border, c1, ValueRange{},
+              [&](OpBuilder &builder, Location loc, ValueRange iv,
+                  ValueRange) {
+                updateColumns(builder, loc, iv[0], one);
+                builder.create<scf::YieldOp>(loc);
+              });
+
+          builder.create<scf::ForOp>(
+              loc, c0, tileRowCount, c1, ValueRange{},
+              [&](OpBuilder &builder, Location loc, ValueRange iv,
+                  ValueRange) {
+                Value outRow =
+                    builder.create<arith::AddIOp>(loc, rowBegin, iv[0]);
+                updateColumns(builder, loc,
+                              builder.create<arith::AddIOp>(loc, iv[0], border),
+                              one);
+
+                forEachBinVec(builder, loc,
+                              [&](OpBuilder &builder, Location loc, Value bin,
+                                  Value mask) {
+                                builder.create<vector::MaskedStoreOp>(
+                                    loc, windowHist, bin, mask, countZero);
+                              });
+                builder.create<scf::ForOp>(
+                    loc, c0, border, c1, ValueRange{},
+                    [&](OpBuilder &builder, Location loc, ValueRange iv1,
+                        ValueRange) {
+                      updateWindow(builder, loc, iv1[0], /*add=*/true);
+                      builder.create<scf::YieldOp>(loc);
+                    });
+
+                builder.create<scf::ForOp>(
+                    loc, c0, inputCol, c1, ValueRange{},
+                    [&](OpBuilder &builder, Location loc, ValueRange iv1,
+                        ValueRange) {
+                      updateWindow(
+                          builder, loc,
+                          builder.create<arith::AddIOp>(loc, iv1[0], border),
+                          /*add=*/true);
+                      Value coarseCounts = builder.create<vector::LoadOp>(
+                          loc, binVecTy, windowHist, fineBins);
+                      auto [coarseBin, skipped] =
+                          findBin(builder, loc, coarseCounts, rankI32);
+                      Value fineBegin = builder.create<arith::MulIOp>(
+                          loc,
+                          builder.create<arith::IndexCastOp>(
+                              loc, builder.getIndexType(), coarseBin),
+                          c16);
+                      Value fineCounts = builder.create<vector::LoadOp>(
+                          loc, binVecTy, windowHist, fineBegin);
+                      Value fineBin =
+                          findBin(builder, loc, fineCounts,
+                                  builder.create<arith::SubIOp>(loc, rankI32,
+                                                                skipped))
+                              .first;
+                      Value res = builder.create<arith::AddIOp>(
+                          loc,
+                          builder.create<arith::MulIOp>(
+                              loc, coarseBin,
+                              builder.create<arith::ConstantIntOp>(
+                                  loc, kCoarseBins, 32)),
+                          fineBin);
+                      builder.create<memref::StoreOp>(
+                          loc,
+                          builder.create<arith::TruncIOp>(loc, elemTy, res),
+                          output, ValueRange{outRow, iv1[0]});
+                      updateWindow(builder, loc, iv1[0], /*add=*/false);
+                      builder.create<scf::YieldOp>(loc);
+                    });
+
+                updateColumns(builder, loc, iv[0], minusOne);
+                builder.create<scf::YieldOp>(loc);
+              });
+
+          builder.create<memref::DeallocOp>(loc, colHist);
+          builder.create<memref::DeallocOp>(loc, windowHist);
+        };
+
+        auto isSize = [&](OpBuilder &builder, Location loc,
+                          int64_t size) -> Value {
+          return builder.create<arith::CmpIOp>(
+              loc, arith::CmpIPredicate::eq, kernelSize,
+              builder.create<arith::ConstantIndexOp>(loc, size));
+        };
+        builder.create<scf::IfOp>(
+            loc, isSize(builder, loc, 3),
+            [&](OpBuilder &builder, Location loc) {
+              networkFilter(builder, loc, 3);
+              builder.create<scf::YieldOp>(loc);
+            },
+            [&](OpBuilder &builder, Location loc) {
+              builder.create<scf::IfOp>(
+                  loc, isSize(builder, loc, 5),
+                  [&](OpBuilder &builder, Location loc) {
+                    networkFilter(builder, loc, 5);
+                    builder.create<scf::YieldOp>(loc);
+                  },
+                  [&](OpBuilder &builder, Location loc) {
+                    if (elemTy.isInteger(8))
+                      histogramFilter(builder, loc);
+                    else
+                      selectionFilter(builder, loc);
+                    builder.create<scf::YieldOp>(loc);
+                  });
+              builder.create<scf::YieldOp>(loc);
+            });
+
+        builder.create<memref::DeallocOp>(loc, padded);
+      });
+}
+
+// Weights of the 5-tap binomial kernel of the Gaussian pyramids.
+static constexpr int64_t kPyramidKernel[5] = {1, 4, 6, 4, 1};
+
+// Stores the weighted sum of the input rows firstRow + t, extrapolated as per
+// the boundary option, with the scalar weights `weights[t]` into
+// buffer[pad, pad + inputCol), and fills the `pad` columns on both sides with
+// the sums of the extrapolated columns. Integer pixels are unsigned and summed
+// in i32.
+static void pyramidRowSum(OpBuilder &builder, Location loc, MLIRContext *ctx,
+                          Value input, Value buffer, Value firstRow,
+                          ArrayRef<Value> weights, Value pad,
+                          Value constantValue, Type elemTy, Type accTy,
+                          buddy::dip::BoundaryOption boundaryOptionAttr,
+                          int64_t stride) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value strideVal = builder.create<arith::ConstantIndexOp>(loc, stride);
+
+  Value inputRow = builder.create<memref::DimOp>(loc, input, c0);
+  Value inputCol = builder.create<memref::DimOp>(loc, input, c1);
+  Value lastRow = builder.create<arith::SubIOp>(loc, inputRow, c1);
+  Value rightBegin = builder.create<arith::AddIOp>(loc, pad, inputCol);
+  Value bufferEnd = builder.create<arith::AddIOp>(loc, rightBegin, pad);
+
+  VectorType vectorTy = VectorType::get({stride}, elemTy);
+  VectorType accVecTy = VectorType::get({stride}, accTy);
+  VectorType vectorMaskTy = VectorType::get({stride}, builder.getI1Type());
+  Value zeroVec = builder.create<vector::BroadcastOp>(
+      loc, vectorTy, insertZeroConstantOp(ctx, builder, loc, elemTy));
+  Value accZeroElem = insertZeroConstantOp(ctx, builder, loc, accTy);
+  Value accZero =
+      builder.create<vector::BroadcastOp>(loc, accVecTy, accZeroElem);
+  bool constantPadding =
+      boundaryOptionAttr == dip::BoundaryOption::ConstantPadding;
+  Value constantAcc = constantValue;
+  if (accTy != elemTy)
+    constantAcc = builder.create<arith::ExtUIOp>(loc, accTy, constantValue);
+  Value constantVec =
+      builder.create<vector::BroadcastOp>(loc, accVecTy, constantAcc);
+
+  SmallVector<Value, 5> srcRows, rowsInBounds, weightVecs;
+  for (size_t t = 0; t < weights.size(); ++t) {
+    Value row = builder.create<arith::AddIOp>(
+        loc, firstRow, builder.create<arith::ConstantIndexOp>(loc, t));
+    srcRows.push_back(builder.create<arith::MinSIOp>(
+        loc, builder.create<arith::MaxSIOp>(loc, row, c0), lastRow));
+    if (constantPadding)
+      rowsInBounds.push_back(inBound(builder, loc, row, c0, inputRow));
+    weightVecs.push_back(
+        builder.create<vector::BroadcastOp>(loc, accVecTy, weights[t]));
+  }
+
+  builder.create<scf::ForOp>(
+      loc, c0, inputCol, strideVal, ValueRange{},
+      [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange) {
+        Value mask = tailMaskCreator(builder, loc, inputCol, iv[0],
+                                     vectorMaskTy);
+        Value sum = accZero;
+        for (size_t t = 0; t < weights.size(); ++t) {
+          Value pixels = builder.create<vector::MaskedLoadOp>(
+              loc, vectorTy, input, ValueRange{srcRows[t], iv[0]}, mask,
+              zeroVec);
+          pixels = widenPixels(builder, loc, pixels, accVecTy);
+          if (constantPadding)
+            pixels = builder.create<arith::SelectOp>(loc, rowsInBounds[t],
+                                                     pixels, constantVec);
+          sum = addValues(builder, loc, sum,
+                          mulValues(builder, loc, pixels, weightVecs[t]));
+        }
+        Value col = builder.create<arith::AddIOp>(loc, iv[0], pad);
+        builder.create<vector::MaskedStoreOp>(loc, buffer, col, mask, sum);
+        builder.create<scf::YieldOp>(loc);
+      });
+
+  // The extrapolated columns are the constant times the sum of the weights, or
+  // copies of the sums of the edge columns.
+  Value left, right;
+  if (constantPadding) {
+    Value weightSum = accZeroElem;
+    for (Value weight : weights)
+      weightSum = addValues(builder, loc, weightSum, weight);
+    left = right = mulValues(builder, loc, constantAcc, weightSum);
+  } else {
+    Value lastCol = builder.create<arith::SubIOp>(loc, rightBegin, c1);
+    left = builder.create<memref::LoadOp>(loc, buffer, pad);
+    right = builder.create<memref::LoadOp>(loc, buffer, lastCol);
+  }
+  auto fillCols = [&](Value begin, Value end, Value val) {
+    builder.create<scf::ForOp>(
+        loc, begin, end, c1, ValueRange{},
+        [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange) {
+          builder.create<memref::StoreOp>(loc, val, buffer, iv[0]);
+          builder.create<scf::YieldOp>(loc);
+        });
+  };
+  fillCols(c0, pad, left);
+  fillCols(rightBegin, bufferEnd, right);
+}
+
+// Divides the weighted sums `sum` by 2^`shift` and converts them back to the
+// element type; integer sums are rounded to nearest.
+static Value pyramidNormalize(OpBuilder &builder, Location loc, Value sum,
+                             Type elemTy, int64_t shift) {
+  VectorType sumTy = sum.getType().cast<VectorType>();
+  if (elemTy.isa<FloatType>()) {
+    Value scale = builder.create<arith::ConstantOp>(
+        loc, builder.getFloatAttr(elemTy, 1.0 / (int64_t(1) << shift)));
+    return builder.create<arith::MulFOp>(
+        loc, sum, builder.create<vector::BroadcastOp>(loc, sumTy, scale));
+  }
+  auto i32Vec = [&](int64_t val) -> Value {
+    return builder.create<vector::BroadcastOp>(
+        loc, sumTy, builder.create<arith::ConstantIntOp>(loc, val, 32));
+  };
+  Value rounded = builder.create<arith::ShRUIOp>(
+      loc, builder.create<arith::AddIOp>(loc, sum, i32Vec(1 << (shift - 1))),
+      i32Vec(shift));
+  return builder.create<arith::TruncIOp>(
+      loc, VectorType::get(sumTy.getShape(), elemTy), rounded);
+}
+
+void pyrDown(OpBuilder &builder, Location loc, MLIRContext *ctx, Value input,
+             Value output, Value constantValue, Type elemTy,
+             buddy::dip::BoundaryOption boundaryOptionAttr, int64_t stride,
+             int64_t tileRows) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value c2 = builder.create<arith::ConstantIndexOp>(loc, 2);
+  Value c4 = builder.create<arith::ConstantIndexOp>(loc, 4);
+  Value strideVal = builder.create<arith::ConstantIndexOp>(loc, stride);
+
+  Value inputCol = builder.create<memref::DimOp>(loc, input, c1);
+  Value outputRow = builder.create<memref::DimOp>(loc, output, c0);
+  Value outputCol = builder.create<memref::DimOp>(loc, output, c1);
+  Value bufferCol = builder.create<arith::AddIOp>(loc, inputCol, c4);
+
+  Type accTy = elemTy.isa<FloatType>() ? elemTy : builder.getI32Type();
+  VectorType accVecTy = VectorType::get({stride}, accTy);
+  VectorType wideVecTy = VectorType::get({2 * stride}, accTy);
+  VectorType vectorMaskTy = VectorType::get({stride}, builder.getI1Type());
+  VectorType wideMaskTy = VectorType::get({2 * stride}, builder.getI1Type());
+  Value accZeroElem = insertZeroConstantOp(ctx, builder, loc, accTy);
+  Value accZero =
+      builder.create<vector::BroadcastOp>(loc, accVecTy, accZeroElem);
+  Value wideZero =
+      builder.create<vector::BroadcastOp>(loc, wideVecTy, accZeroElem);
+
+  SmallVector<Value, 5> weights, weightVecs;
+  for (int64_t weight : kPyramidKernel) {
+    Value val;
+    if (elemTy.isa<FloatType>())
+      val = builder.create<arith::ConstantOp>(
+          loc, builder.getFloatAttr(accTy, weight));
+    else
+      val = builder.create<arith::ConstantIntOp>(loc, weight, 32);
+    weights.push_back(val);
+    weightVecs.push_back(
+        builder.create<vector::BroadcastOp>(loc, accVecTy, val));
+  }
+  SmallVector<int64_t, 16> evenLanes;
+  for (int64_t lane = 0; lane < stride; ++lane)
+    evenLanes.push_back(2 * lane);
+
+  // Only the kept rows are blurred vertically, into a row buffer with two
+  // extrapolated columns on both sides, and only the kept columns of the
+  // buffer are blurred horizontally: the taps of `stride` output pixels are
+  // the even lanes of 2 * stride consecutive buffer elements.
+  MemRefType bufferTy = MemRefType::get({ShapedType::kDynamic}, accTy);
+  buildRowTileLoop(
+      builder, loc, c0, outputRow, tileRows,
+      [&](OpBuilder &builder, Location loc, Value rowBegin, Value rowEnd) {
+        Value buffer = builder.create<memref::AllocOp>(loc, bufferTy,
+                                                       ValueRange{bufferCol});
+        builder.create<scf::ForOp>(
+            loc, rowBegin, rowEnd, c1, ValueRange{},
+            [&](OpBuilder &builder, Location loc, ValueRange iv,
+                ValueRange) {
+              Value firstRow = builder.create<arith::SubIOp>(
+                  loc, builder.create<arith::MulIOp>(loc, iv[0], c2), c2);
+              pyramidRowSum(builder, loc, ctx, input, buffer, firstRow,
+                            weights, c2, constantValue, elemTy, accTy,
+                            boundaryOptionAttr, stride);
+
+              builder.create<scf::ForOp>(
+                  loc, c0, outputCol, strideVal, ValueRange{},
+                  [&](OpBuilder &builder, Location loc, ValueRange iv1,
+                      ValueRange) {
+                    Value col = builder.create<arith::MulIOp>(loc, iv1[0], c2);
+                    Value sum = accZero;
+                    for (int64_t tap = 0; tap < 5; ++tap) {
+                      Value tapCol = builder.create<arith::AddIOp>(
+                          loc, col,
+                          builder.create<arith::ConstantIndexOp>(loc, tap));
+                      Value wideMask = tailMaskCreator(builder, loc, bufferCol,
+                                                       tapCol, wideMaskTy);
+                      Value wide = builder.create<vector::MaskedLoadOp>(
+                          loc, wideVecTy, buffer, tapCol, wideMask, wideZero);
+                      Value taps = builder.create<vector::ShuffleOp>(
+                          loc, wide, wide, evenLanes);
+                      sum = addValues(
+                          builder, loc, sum,
+                          mulValues(builder, loc, taps, weightVecs[tap]));
+                    }
+                    Value mask = tailMaskCreator(builder, loc, outputCol,
+                                                 iv1[0], vectorMaskTy);
+                    builder.create<vector::MaskedStoreOp>(
+                        loc, output, ValueRange{iv[0], iv1[0]}, mask,
+                        pyramidNormalize(builder, loc, sum, elemTy, 8));
+                    builder.create<scf::YieldOp>(loc);
+                  });
+              builder.create<scf::YieldOp>(loc);
+            });
+        builder.create<memref::DeallocOp>(loc, buffer);
+      });
+}
+
+void pyrUp(OpBuilder &builder, Location loc, MLIRContext *ctx, Value input,
+           Value output, Value constantValue, Type elemTy,
+           buddy::dip::BoundaryOption boundaryOptionAttr, int64_t stride,
+           int64_t tileRows) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value c2 = builder.create<arith::ConstantIndexOp>(loc, 2);
+  Value wideStride = builder.create<arith::ConstantIndexOp>(loc, 2 * stride);
+
+  Value inputCol = builder.create<memref::DimOp>(loc, input, c1);
+  Value outputRow = builder.create<memref::DimOp>(loc, output, c0);
+  Value outputCol = builder.create<memref::DimOp>(loc, output, c1);
+  Value bufferCol = builder.create<arith::AddIOp>(loc, inputCol, c2);
+
+  Type accTy = elemTy.isa<FloatType>() ? elemTy : builder.getI32Type();
+  VectorType accVecTy = VectorType::get({stride}, accTy);
+  VectorType vectorMaskTy = VectorType::get({stride}, builder.getI1Type());
+  VectorType wideMaskTy = VectorType::get({2 * stride}, builder.getI1Type());
+  Value accZero = builder.create<vector::BroadcastOp>(
+      loc, accVecTy, insertZeroConstantOp(ctx, builder, loc, accTy));
+
+  auto accConst = [&](int64_t val) -> Value {
+    if (elemTy.isa<FloatType>())
+      return builder.create<arith::ConstantOp>(
+          loc, builder.getFloatAttr(accTy, val));
+    return builder.create<arith::ConstantIntOp>(loc, val, 32);
+  };
+  Value zero = accConst(0), one = accConst(1), four = accConst(4),
+        six = accConst(6);
+  Value fourVec = builder.create<vector::BroadcastOp>(loc, accVecTy, four);
+  Value sixVec = builder.create<vector::BroadcastOp>(loc, accVecTy, six);
+  SmallVector<int64_t, 32> interleaved;
+  for (int64_t lane = 0; lane < stride; ++lane) {
+    interleaved.push_back(lane);
+    interleaved.push_back(stride + lane);
+  }
+
+  // Output row 2i weights the input rows i - 1, i, i + 1 by 1, 6, 1 and output
+  // row 2i + 1 the rows i, i + 1 by 4, 4, so every output row is one vertical
+  // pass into a row buffer with one extrapolated column on both sides. The
+  // even and odd output columns of `stride` buffer elements are computed in
+  // separate vectors and interleaved.
+  MemRefType bufferTy = MemRefType::get({ShapedType::kDynamic}, accTy);
+  buildRowTileLoop(
+      builder, loc, c0, outputRow, tileRows,
+      [&](OpBuilder &builder, Location loc, Value rowBegin, Value rowEnd) {
+        Value buffer = builder.create<memref::AllocOp>(loc, bufferTy,
+                                                       ValueRange{bufferCol});
+        builder.create<scf::ForOp>(
+            loc, rowBegin, rowEnd, c1, ValueRange{},
+            [&](OpBuilder &builder, Location loc, ValueRange iv,
+                ValueRange) {
+              Value isOdd = builder.create<arith::CmpIOp>(
+                  loc, arith::CmpIPredicate::eq,
+                  builder.create<arith::AndIOp>(loc, iv[0], c1), c1);
+              Value firstRow = builder.create<arith::SubIOp>(
+                  loc, builder.create<arith::DivUIOp>(loc, iv[0], c2), c1);
+              SmallVector<Value, 3> weights = {
+                  builder.create<arith::SelectOp>(loc, isOdd, zero, one),
+                  builder.create<arith::SelectOp>(loc, isOdd, four, six),
+                  builder.create<arith::SelectOp>(loc, isOdd, four, one)};
+              pyramidRowSum(builder, loc, ctx, input, buffer, firstRow,
+                            weights, c1, constantValue, elemTy, accTy,
+                            boundaryOptionAttr, stride);
+
+              builder.create<scf::ForOp>(
+                  loc, c0, outputCol, wideStride, ValueRange{},
+                  [&](OpBuilder &builder, Location loc, ValueRange iv1,
+                      ValueRange) {
+                    Value col = builder.create<arith::DivUIOp>(loc, iv1[0], c2);
+                    SmallVector<Value, 3> taps;
+                    for (int64_t tap = 0; tap < 3; ++tap) {
+                      Value tapCol = builder.create<arith::AddIOp>(
+                          loc, col,
+                          builder.create<arith::ConstantIndexOp>(loc, tap));
+                      Value mask = tailMaskCreator(builder, loc, bufferCol,
+                                                   tapCol, vectorMaskTy);
+                      taps.push_back(builder.create<vector::MaskedLoadOp>(
+                          loc, accVecTy, buffer, tapCol, mask, accZero));
+                    }
+                    Value even = addValues(
+                        builder, loc,
+                        addValues(builder, loc, taps[0], taps[2]),
+                        mulValues(builder, loc, taps[1], sixVec));
+                    Value odd = mulValues(
+                        builder, loc,
+                        addValues(builder, loc, taps[1], taps[2]), fourVec);
+                    Value sum = builder.create<vector::ShuffleOp>(
+                        loc, even, odd, interleaved);
+                    Value mask = tailMaskCreator(builder, loc, outputCol,
+                                                 iv1[0], wideMaskTy);
+                    builder.create<vector::MaskedStoreOp>(
+                        loc, output, ValueRange{iv[0], iv1[0]}, mask,
+                        pyramidNormalize(builder, loc, sum, elemTy, 6));
+                    builder.create<scf::YieldOp>(loc);
+                  });
+              builder.create<scf::YieldOp>(loc);
+            });
+        builder.create<memref::DeallocOp>(loc, buffer);
+      });
+}
+
+// Number of levels of 8-bit images, i.e. of histogram bins and LUT entries.
+static constexpr int64_t kU8Levels = 256;
+
+// Counts the pixels of the rows [rowBegin, rowEnd) of an 8-bit image into the
+// bins `hist[histPrefix..., level]`.
+static void countPixels(OpBuilder &builder, Location loc, Value input,
+                        Value rowBegin, Value rowEnd, Value hist,
+                        ValueRange histPrefix) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value one = builder.create<arith::ConstantIntOp>(loc, 1, 32);
+  Value inputCol = builder.create<memref::DimOp>(loc, input, c1);
+  builder.create<scf::ForOp>(
+      loc, rowBegin, rowEnd, c1, ValueRange{},
+      [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange) {
+        builder.create<scf::ForOp>(
+            loc, c0, inputCol, c1, ValueRange{},
+            [&](OpBuilder &builder, Location loc, ValueRange iv1,
+                ValueRange) {
+              Value pixel = builder.create<memref::LoadOp>(
+                  loc, input, ValueRange{iv[0], iv1[0]});
+              Value level = builder.create<arith::IndexCastOp>(
+                  loc, builder.getIndexType(),
+                  builder.create<arith::ExtUIOp>(loc, builder.getI32Type(),
+                                                 pixel));
+              SmallVector<Value, 2> bin(histPrefix.begin(), histPrefix.end());
+              bin.push_back(level);
+              Value count = builder.create<memref::LoadOp>(loc, hist, bin);
+              builder.create<memref::StoreOp>(
+                  loc, builder.create<arith::AddIOp>(loc, count, one), hist,
+                  bin);
+              builder.create<scf::YieldOp>(loc);
+            });
+        builder.create<scf::YieldOp>(loc);
+      });
+}
+
+// Applies `fn` to every vector of the 256 bins of a histogram or LUT.
+static void forEachLevelVec(
+    OpBuilder &builder, Location loc, int64_t stride,
+    function_ref<void(OpBuilder &, Location, Value, Value)> fn) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value levels = builder.create<arith::ConstantIndexOp>(loc, kU8Levels);
+  Value strideVal = builder.create<arith::ConstantIndexOp>(loc, stride);
+  VectorType vectorMaskTy = VectorType::get({stride}, builder.getI1Type());
+  builder.create<scf::ForOp>(
+      loc, c0, levels, strideVal, ValueRange{},
+      [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange) {
+        Value mask =
+            tailMaskCreator(builder, loc, levels, iv[0], vectorMaskTy);
+        fn(builder, loc, iv[0], mask);
+        builder.create<scf::YieldOp>(loc);
+      });
+}
+
+void histogram(OpBuilder &builder, Location loc, MLIRContext *ctx,
+               Value input, Value hist, int64_t stride, int64_t tileRows) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value inputRow = builder.create<memref::DimOp>(loc, input, c0);
+  VectorType countVecTy = VectorType::get({stride}, builder.getI32Type());
+  Value countZero = builder.create<vector::BroadcastOp>(
+      loc, countVecTy, builder.create<arith::ConstantIntOp>(loc, 0, 32));
+  auto clearHist = [&](OpBuilder &builder, Location loc, Value buffer,
+                       ValueRange prefix) {
+    forEachLevelVec(builder, loc, stride,
+                    [&](OpBuilder &builder, Location loc, Value level,
+                        Value mask) {
+                      SmallVector<Value, 2> bin(prefix.begin(), prefix.end());
+                      bin.push_back(level);
+                      builder.create<vector::MaskedStoreOp>(loc, buffer, bin,
+                                                            mask, countZero);
+                    });
+  };
+
+  if (tileRows <= 0) {
+    clearHist(builder, loc, hist, {});
+    countPixels(builder, loc, input, c0, inputRow, hist, {});
+    return;
+  }
+
+  // Every row tile counts into its own sub-histogram, so that the threads
+  // never share a bin.
+  Value tileSize = builder.create<arith::ConstantIndexOp>(loc, tileRows);
+  Value tileCount = builder.create<arith::CeilDivUIOp>(loc, inputRow, tileSize);
+  Value subHists = builder.create<memref::AllocOp>(
+      loc,
+      MemRefType::get({ShapedType::kDynamic, kU8Levels},
+                      builder.getI32Type()),
+      tileCount);
+  buildRowTileLoop(
+      builder, loc, c0, inputRow, tileRows,
+      [&](OpBuilder &builder, Location loc, Value rowBegin, Value rowEnd) {
+        Value tile = builder.create<arith::DivUIOp>(loc, rowBegin, tileSize);
+        clearHist(builder, loc, subHists, tile);
+        countPixels(builder, loc, input, rowBegin, rowEnd, subHists, tile);
+      });
+
+  // Merge the sub-histograms.
+  forEachLevelVec(
+      builder, loc, stride,
+      [&](OpBuilder &builder, Location loc, Value level, Value mask) {
+        auto mergeLoop = builder.create<scf::ForOp>(
+            loc, c0, tileCount, c1, ValueRange{countZero},
+            [&](OpBuilder &builder, Location loc, ValueRange iv,
+                ValueRange acc) {
+              Value counts = builder.create<vector::MaskedLoadOp>(
+                  loc, countVecTy, subHists, ValueRange{iv[0], level}, mask,
+                  countZero);
+              builder.create<scf::YieldOp>(
+                  loc, ValueRange{
+                           builder.create<arith::AddIOp>(loc, acc[0], counts)});
+            });
+        builder.create<vector::MaskedStoreOp>(loc, hist, level, mask,
+                                              mergeLoop.getResult(0));
+      });
+  builder.create<memref::DeallocOp>(loc, subHists);
+}
+
+void applyLut(OpBuilder &builder, Location loc, MLIRContext *ctx, Value input,
+              Value lut, Value output, Type outElemTy, int64_t stride,
+              int64_t tileRows) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value strideVal = builder.create<arith::ConstantIndexOp>(loc, stride);
+  Value inputRow = builder.create<memref::DimOp>(loc, input, c0);
+  Value inputCol = builder.create<memref::DimOp>(loc, input, c1);
+
+  VectorType vectorTy = VectorType::get({stride}, builder.getI8Type());
+  VectorType indexVecTy = VectorType::get({stride}, builder.getI32Type());
+  VectorType outVecTy = VectorType::get({stride}, outElemTy);
+  VectorType vectorMaskTy = VectorType::get({stride}, builder.getI1Type());
+  Value zeroVec = builder.create<vector::BroadcastOp>(
+      loc, vectorTy, builder.create<arith::ConstantIntOp>(loc, 0, 8));
+  Value outZero = builder.create<vector::BroadcastOp>(
+      loc, outVecTy, insertZeroConstantOp(ctx, builder, loc, outElemTy));
+
+  buildRowTileLoop(
+      builder, loc, c0, inputRow, tileRows,
+      [&](OpBuilder &builder, Location loc, Value rowBegin, Value rowEnd) {
+        builder.create<scf::ForOp>(
+            loc, rowBegin, rowEnd, c1, ValueRange{},
+            [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange) {
+              builder.create<scf::ForOp>(
+                  loc, c0, inputCol, strideVal, ValueRange{},
+                  [&](OpBuilder &builder, Location loc, ValueRange iv1,
+                      ValueRange) {
+                    Value mask = tailMaskCreator(builder, loc, inputCol,
+                                                 iv1[0], vectorMaskTy);
+                    Value pixels = builder.create<vector::MaskedLoadOp>(
+                        loc, vectorTy, input, ValueRange{iv[0], iv1[0]}, mask,
+                        zeroVec);
+                    Value levels =
+                        builder.create<arith::ExtUIOp>(loc, indexVecTy, pixels);
+                    Value res = builder.create<vector::GatherOp>(
+                        loc, outVecTy, lut, ValueRange{c0}, levels, mask,
+                        outZero);
+                    builder.create<vector::MaskedStoreOp>(
+                        loc, output, ValueRange{iv[0], iv1[0]}, mask, res);
+                    builder.create<scf::YieldOp>(loc);
+                  });
+              builder.create<scf::YieldOp>(loc);
+            });
+      });
+}
+
+void equalizeHist(OpBuilder &builder, Location loc, MLIRContext *ctx,
+                  Value input, Value output, int64_t stride,
+                  int64_t tileRows) {
+  Value c0 = builder.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = builder.create<arith::ConstantIndexOp>(loc, 1);
+  Value levels = builder.create<arith::ConstantIndexOp>(loc, kU8Levels);
+  IntegerType i32 = builder.getI32Type();
+  FloatType f32 = builder.getF32Type();
+  VectorType countVecTy = VectorType::get({stride}, i32);
+  VectorType floatVecTy = VectorType::get({stride}, f32);
+  VectorType lutVecTy = VectorType::get({stride}, builder.getI8Type());
+  Value countZero = builder.create<vector::BroadcastOp>(
+      loc, countVecTy, builder.create<arith::ConstantIntOp>(loc, 0, 32));
+
+  Value hist = builder.create<memref::AllocOp>(
+      loc, MemRefType::get({kU8Levels}, i32));
+  Value cdf = builder.create<memref::AllocOp>(
+      loc, MemRefType::get({kU8Levels + 1}, i32));
+  Value lut = builder.create<memref::AllocOp>(
+      loc, MemRefType::get({kU8Levels}, builder.getI8Type()));
+  histogram(builder, loc, ctx, input, hist, stride, tileRows);
+  prefixSumRow(builder, loc, hist, cdf, levels, countVecTy, stride);
+
+  // The smallest non-zero value of the cdf counts the darkest level present,
+  // which is mapped to 0.
+  Value maxCount = builder.create<vector::BroadcastOp>(
+      loc, countVecTy, builder.create<arith::ConstantIntOp>(loc, -1, 32));
+  auto minLoop = builder.create<scf::ForOp>(
+      loc, c0, levels, builder.create<arith::ConstantIndexOp>(loc, stride),
+      ValueRange{maxCount},
+      [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange acc) {
+        Value mask =
+            tailMaskCreator(builder, loc, levels, iv[0],
+                            VectorType::get({stride}, builder.getI1Type()));
+        Value cdfIdx = builder.create<arith::AddIOp>(loc, iv[0], c1);
+        Value counts = builder.create<vector::MaskedLoadOp>(
+            loc, countVecTy, cdf, cdfIdx, mask, countZero);
+        Value present = builder.create<arith::CmpIOp>(
+            loc, arith::CmpIPredicate::ne, counts, countZero);
+        counts =
+            builder.create<arith::SelectOp>(loc, present, counts, maxCount);
+        builder.create<scf::YieldOp>(
+            loc, ValueRange{builder.create<arith::MinUIOp>(loc, acc[0],
+                                                           counts)});
+      });
+  Value cdfMin = builder.create<vector::ReductionOp>(
+      loc, vector::CombiningKind::MINUI, minLoop.getResult(0));
+  Value total = builder.create<memref::LoadOp>(loc, cdf, levels);
+  Value range = builder.create<arith::SubIOp>(loc, total, cdfMin);
+
+  // Images with a single level (or no pixel) keep their levels.
+  Value singleLevel = builder.create<arith::CmpIOp>(
+      loc, arith::CmpIPredicate::eq, range,
+      builder.create<arith::ConstantIntOp>(loc, 0, 32));
+  Value scale = builder.create<arith::DivFOp>(
+      loc,
+      builder.create<arith::ConstantFloatOp>(loc, APFloat(255.0f), f32),
+      builder.create<arith::UIToFPOp>(loc, f32, range));
+  Value scaleVec = builder.create<vector::BroadcastOp>(loc, floatVecTy, scale);
+  Value cdfMinVec =
+      builder.create<vector::BroadcastOp>(loc, countVecTy, cdfMin);
+  std::vector<int32_t> iota(stride);
+  std::iota(iota.begin(), iota.end(), 0);
+  Value iotaVec = builder.create<arith::ConstantOp>(
+      loc, DenseIntElementsAttr::get(countVecTy, ArrayRef<int32_t>(iota)));
+
+  forEachLevelVec(
+      builder, loc, stride,
+      [&](OpBuilder &builder, Location loc, Value level, Value mask) {
+        Value cdfIdx = builder.create<arith::AddIOp>(loc, level, c1);
+        Value counts = builder.create<vector::MaskedLoadOp>(
+            loc, countVecTy, cdf, cdfIdx, mask, countZero);
+        Value above = builder.create<arith::MaxSIOp>(
+            loc, builder.create<arith::SubIOp>(loc, counts, cdfMinVec),
+            countZero);
+        Value mapped = builder.create<arith::MulFOp>(
+            loc, builder.create<arith::SIToFPOp>(loc, floatVecTy, above),
+            scaleVec);
+        mapped = builder.create<math::RoundOp>(loc, mapped);
+        Value identity = builder.create<arith::AddIOp>(
+            loc,
+            builder.create<vector::BroadcastOp>(
+                loc, countVecTy,
+                builder.create<arith::IndexCastOp>(loc, i32, level)),
+            iotaVec);
+        Value res = builder.create<arith::SelectOp>(
+            loc, singleLevel, identity,
+            builder.create<arith::FPToUIOp>(loc, countVecTy, mapped));
+        builder.create<vector::MaskedStoreOp>(
+            loc, lut, level, mask,
+            builder.create<arith::TruncIOp>(loc, lutVecTy, res));
+      });
+  applyLut(builder, loc, ctx, input, lut, output, builder.getI8Type(), stride,
+           tileRows);
+
+  builder.create<memref::DeallocOp>(loc, hist);
+  builder.create<memref::DeallocOp>(loc, cdf);
+  builder.create<memref::DeallocOp>(loc, lut);
+}
+
+// Combines two values (scalars or vectors) with min for erosion and max for
+// dilation.
+static Value morphCombine(OpBuilder &builder, Location loc, Type elemTy,
+                          Value lhs, Value rhs, DIP_OP op) {
+  bool isErosion = op == DIP_OP::EROSION_2D;
+  if (elemTy.isF32() || elemTy.isF64()) {
+    if (isErosion)
+      return builder.create<arith::MinimumFOp>(loc, lhs, rhs);
+    return builder.create<arith::MaximumFOp>(loc, lhs, rhs);
+  }
+  if (isErosion)
+    return builder.create<arith::MinSIOp>(loc, lhs, rhs);
+  return builder.create<arith::MaxSIOp>(loc, lhs, rhs);
+}
+
+// Checks at runtime whether every element of `kernel` is non-zero, i.e.
+// whether the structuring element is a flat rectangle (or a line).
+static Value isRectangularKernel(OpBuilder &builder, Location loc,
+                                 MLIRContext *ctx, Value kernel, Type elemTy,
+                                 Value c0, Value c1) {
+  Value kernelRow = builder.create<memref::DimOp>(loc, kernel, c0);
+  Value kernelCol = builder.create<memref::DimOp>(loc, kernel, c1);
+  Value zeroElem = insertZeroConstantOp(ctx, builder, loc, elemTy);
+  Value trueVal = builder.create<arith::ConstantIntOp>(loc, 1, 1);
+
+  auto rowLoop = builder.create<scf::ForOp>(
+      loc, c0, kernelRow, c1, ValueRange{trueVal},
+      [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange acc) {
+        auto colLoop = builder.create<scf::ForOp>(
+            loc, c0, kernelCol, c1, ValueRange{acc[0]},
+            [&](OpBuilder &builder, Location loc, ValueRange iv1,
+                ValueRange acc1) {
+              Value kernelValue = builder.create<memref::LoadOp>(
+                  loc, kernel, ValueRange{iv[0], iv1[0]});
+              Value nonZero =
+                  zeroCond(builder, loc, elemTy, kernelValue, zeroElem);
+              Value res = builder.create<arith::AndIOp>(loc, acc1[0], nonZero);
+              builder.create<scf::YieldOp>(loc, res);
+            });
+        builder.create<scf::YieldOp>(loc, colLoop.getResult(0));
+      });
+  return rowLoop.getResult(0);
+}
+
+// Emits the running min/max of one van Herk/Gil-Werman scan. The scanned
+// sequence is split into segments of `segment` elements; the forward scan
+// restarts at every segment start, the backward scan at every segment end.
+// Segments are independent, so they are distributed by an `scf.parallel` loop
+// when `parallel` is set. `emitStep` receives the sequence position, the
+// restart condition and the position of the previous scan element.
+static void vanHerkScan(
+    OpBuilder &builder, Location loc, Value length, Value segment,
+    bool backward, bool parallel, Value c0, Value c1,
+    function_ref<void(OpBuilder &, Location, Value, Value, Value)> emitStep) {
+  auto segmentBody = [&](OpBuilder &builder, Location loc, Value begin) {
+    Value end = builder.create<arith::MinSIOp>(
+        loc, builder.create<arith::AddIOp>(loc, begin, segment), length);
+    Value last = builder.create<arith::SubIOp>(loc, end, c1);
+    Value count = builder.create<arith::SubIOp>(loc, end, begin);
+    builder.create<scf::ForOp>(
+        loc, c0, count, c1, ValueRange{},
+        [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange) {
+          Value pos, prev;
+          Value restart = builder.create<arith::CmpIOp>(
+              loc, arith::CmpIPredicate::eq, iv[0], c0);
+          if (backward) {
+            pos = builder.create<arith::SubIOp>(loc, last, iv[0]);
+            prev = builder.create<arith::MinSIOp>(
+                loc, builder.create<arith::AddIOp>(loc, pos, c1), last);
+          } else {
+            pos = builder.create<arith::AddIOp>(loc, begin, iv[0]);
+            prev = builder.create<arith::MaxSIOp>(
+                loc, builder.create<arith::SubIOp>(loc, pos, c1), begin);
+          }
+          emitStep(builder, loc, pos, restart, prev);
+          builder.create<scf::YieldOp>(loc);
+        });
+  };
+  if (parallel) {
+    builder.create<scf::ParallelOp>(
+        loc, ValueRange{c0}, ValueRange{length}, ValueRange{segment},
+        [&](OpBuilder &builder, Location loc, ValueRange ivs) {
+          segmentBody(builder, loc, ivs[0]);
+        });
+    return;
+  }
+  builder.create<scf::ForOp>(
+      loc, c0, length, segment, ValueRange{},
+      [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange) {
+        segmentBody(builder, loc, iv[0]);
+        builder.create<scf::YieldOp>(loc);
+      });
+}
+
+// Number of rows filtered together by the horizontal van Herk/Gil-Werman
+// scans; it is also capped by the vector width.
+static constexpr int64_t kVanHerkLanes = 8;
+
+// Transposes the square block given by its row vectors.
+static SmallVector<Value> transposeBlock(OpBuilder &builder, Location loc,
+                                         ArrayRef<Value> rows) {
+  auto rowTy = rows.front().getType().cast<VectorType>();
+  int64_t lanes = rows.size();
+  VectorType blockTy = VectorType::get({lanes, lanes}, rowTy.getElementType());
+  Value block = builder.create<arith::ConstantOp>(
+      loc, blockTy, builder.getZeroAttr(blockTy));
+  for (int64_t i = 0; i < lanes; ++i)
+    block = builder.create<vector::InsertOp>(loc, rows[i], block,
+                                             ArrayRef<int64_t>{i});
+  Value transposed = builder.create<vector::TransposeOp>(
+      loc, block, ArrayRef<int64_t>{1, 0});
+  SmallVector<Value> columns;
+  for (int64_t i = 0; i < lanes; ++i)
+    columns.push_back(builder.create<vector::ExtractOp>(loc, transposed,
+                                                        ArrayRef<int64_t>{i}));
+  return columns;
+}
+
+// Fills the columns of row `row` of the column padded `buffer` outside of the
+// image, i.e. [0, centerX) with `leftVal` and [centerX + width, end) with
+// `rightVal`.
+static void padColumns(OpBuilder &builder, Location loc, Value buffer,
+                       Value row, Value centerX, Value width, Value leftVal,
+                       Value rightVal, Value c0, Value c1) {
+  Value paddedWidth = builder.create<memref::DimOp>(loc, buffer, c1);
+  Value rightBegin = builder.create<arith::AddIOp>(loc, centerX, width);
+  builder.create<scf::ForOp>(
+      loc, c0, centerX, c1, ValueRange{},
+      [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange) {
+        builder.create<memref::StoreOp>(loc, leftVal, buffer,
+                                        ValueRange{row, iv[0]});
+        builder.create<scf::YieldOp>(loc);
+      });
+  builder.create<scf::ForOp>(
+      loc, rightBegin, paddedWidth, c1, ValueRange{},
+      [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange) {
+        builder.create<memref::StoreOp>(loc, rightVal, buffer,
+                                        ValueRange{row, iv[0]});
+        builder.create<scf::YieldOp>(loc);
+      });
+}
+
+// Vertical van Herk/Gil-Werman pass over the columns [0, width). Row `pos`,
+// pos in [0, length), of the scanned sequence is read as vectors by `loadRow`
+// from the position and the mask of the columns. Output row t, t in
+// [0, count), combines the scanned rows [t + offset, t + offset + window) and
+// is passed to `emitRow` as vectors of `stride` columns. With a positive
+// `tileRows`, the scan segments and the output row tiles are processed in
+// parallel.
+static void verticalVanHerk(
+    OpBuilder &builder, Location loc, MLIRContext *ctx, Value length,
+    Value window, Value width, Value count, Value offset, Type elemTy,
+    int64_t stride, DIP_OP op, int64_t tileRows, Value c0, Value c1,
+    function_ref<Value(OpBuilder &, Location, Value, Value, Value)> loadRow,
+    function_ref<void(OpBuilder &, Location, Value, Value, Value, Value)>
+        emitRow) {
+  Value strideVal = builder.create<arith::ConstantIndexOp>(loc, stride);
+  VectorType vectorTy = VectorType::get({stride}, elemTy);
+  VectorType vectorMaskTy = VectorType::get({stride}, IntegerType::get(ctx, 1));
+  Value padding = builder.create<arith::ConstantOp>(
+      loc, vectorTy, builder.getZeroAttr(vectorTy));
+  MemRefType scanTy =
+      MemRefType::get({ShapedType::kDynamic, ShapedType::kDynamic}, elemTy);
+  Value forward = builder.create<memref::AllocOp>(loc, scanTy,
+                                                  ValueRange{length, width});
+  Value backward = builder.create<memref::AllocOp>(loc, scanTy,
+                                                   ValueRange{length, width});
+
+  auto scanStep = [&](Value scan) {
+    return [&, scan](OpBuilder &builder, Location loc, Value pos,
+                     Value restart, Value prev) {
+      builder.create<scf::ForOp>(
+          loc, c0, width, strideVal, ValueRange{},
+          [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange) {
+            Value mask =
+                tailMaskCreator(builder, loc, width, iv[0], vectorMaskTy);
+            Value vec = loadRow(builder, loc, pos, iv[0], mask);
+            Value prevVec = builder.create<vector::MaskedLoadOp>(
+                loc, vectorTy, scan, ValueRange{prev, iv[0]}, mask, padding);
+            Value combined =
+                morphCombine(builder, loc, elemTy, prevVec, vec, op);
+            Value res =
+                builder.create<arith::SelectOp>(loc, restart, vec, combined);
+            builder.create<vector::MaskedStoreOp>(
+                loc, scan, ValueRange{pos, iv[0]}, mask, res);
+            builder.create<scf::YieldOp>(loc);
+          });
+    };
+  };
+  vanHerkScan(builder, loc, length, window, /*backward=*/false, tileRows > 0,
+              c0, c1, scanStep(forward));
+  vanHerkScan(builder, loc, length, window, /*backward=*/true, tileRows > 0,
+              c0, c1, scanStep(backward));
+
+  Value windowLast = builder.create<arith::SubIOp>(loc, window, c1);
+  buildRowTileLoop(
+      builder, loc, c0, count, tileRows,
+      [&](OpBuilder &builder, Location loc, Value rowBegin, Value rowEnd) {
+        builder.create<scf::ForOp>(
+            loc, rowBegin, rowEnd, c1, ValueRange{},
+            [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange) {
+              Value backwardRow =
+                  builder.create<arith::AddIOp>(loc, iv[0], offset);
+              Value forwardRow =
+                  builder.create<arith::AddIOp>(loc, backwardRow, windowLast);
+              builder.create<scf::ForOp>(
+                  loc, c0, width, strideVal, ValueRange{},
+                  [&](OpBuilder &builder, Location loc, ValueRange iv1,
+                      ValueRange) {
+                    Value mask = tailMaskCreator(builder, loc, width, iv1[0],
+                                                 vectorMaskTy);
+                    Value backwardVec = builder.create<vector::MaskedLoadOp>(
+                        loc, vectorTy, backward,
+                        ValueRange{backwardRow, iv1[0]}, mask, padding);
+                    Value forwardVec = builder.create<vector::MaskedLoadOp>(
+                        loc, vectorTy, forward,
+                        ValueRange{forwardRow, iv1[0]}, mask, padding);
+                    Value res = morphCombine(builder, loc, elemTy, backwardVec,
+                                             forwardVec, op);
+                    emitRow(builder, loc, iv[0], iv1[0], mask, res);
+                    builder.create<scf::YieldOp>(loc);
+                  });
+              builder.create<scf::YieldOp>(loc);
+            });
+      });
+
+  builder.create<memref::DeallocOp>(loc, forward);
+  builder.create<memref::DeallocOp>(loc, backward);
+}
+
+// Horizontal van Herk/Gil-Werman pass over the rows [rowBegin, rowEnd) of
+// `src`, whose element (r, p) is column p - centerX of row r after boundary
+// extrapolation, so that it has width + window - 1 columns. The rows are
+// filtered in groups of `lanes` rows: the group is transposed block by block
+// into a column buffer, the scans run on vectors holding one element of every
+// row of the group and the combined result is transposed back. `emitRow`
+// receives the row, the first column, the mask of the valid columns and the
+// vector of `lanes` filtered columns; it may overwrite the rows of `src` that
+// it is called for.
+static void horizontalVanHerk(
+    OpBuilder &builder, Location loc, MLIRContext *ctx, Value src,
+    Value rowBegin, Value rowEnd, Value width, Value window, Type elemTy,
+    int64_t lanes, DIP_OP op, Value c0, Value c1,
+    function_ref<void(OpBuilder &, Location, Value, Value, Value, Value)>
+        emitRow) {
+  Value lanesVal = builder.create<arith::ConstantIndexOp>(loc, lanes);
+  Value paddedWidth = builder.create<arith::SubIOp>(
+      loc, builder.create<arith::AddIOp>(loc, width, window), c1);
+  Value lastRow = builder.create<arith::SubIOp>(loc, rowEnd, c1);
+  Value lastCol = builder.create<arith::SubIOp>(loc, width, c1);
+  Value windowLast = builder.create<arith::SubIOp>(loc, window, c1);
+
+  VectorType vectorTy = VectorType::get({lanes}, elemTy);
+  VectorType vectorMaskTy = VectorType::get({lanes}, IntegerType::get(ctx, 1));
+  Value padding = builder.create<arith::ConstantOp>(
+      loc, vectorTy, builder.getZeroAttr(vectorTy));
+  // Element (p, j) of the column buffer is element p of row j of the group.
+  // The last block may be stored past the padded width.
+  MemRefType columnTy = MemRefType::get({ShapedType::kDynamic, lanes}, elemTy);
+  Value columnRow = builder.create<arith::AddIOp>(loc, paddedWidth, lanesVal);
+  Value columns =
+      builder.create<memref::AllocOp>(loc, columnTy, ValueRange{columnRow});
+  Value forward =
+      builder.create<memref::AllocOp>(loc, columnTy, ValueRange{paddedWidth});
+  Value backward =
+      builder.create<memref::AllocOp>(loc, columnTy, ValueRange{paddedWidth});
+
+  auto scanStep = [&](Value scan) {
+    return [&, scan](OpBuilder &builder, Location loc, Value pos,
+                     Value restart, Value prev) {
+      Value vec = builder.create<vector::LoadOp>(loc, vectorTy, columns,
+                                                 ValueRange{pos, c0});
+      Value prevVec = builder.create<vector::LoadOp>(loc, vectorTy, scan,
+                                                     ValueRange{prev, c0});
+      Value combined = morphCombine(builder, loc, elemTy, prevVec, vec, op);
+      Value res = builder.create<arith::SelectOp>(loc, restart, vec, combined);
+      builder.create<vector::StoreOp>(loc, res, scan, ValueRange{pos, c0});
+    };
+  };
+
+  builder.create<scf::ForOp>(
+      loc, rowBegin, rowEnd, lanesVal, ValueRange{},
+      [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange) {
+        // The rows of the last group past `rowEnd` repeat the last row.
+        SmallVector<Value> rows;
+        for (int64_t j = 0; j < lanes; ++j)
+          rows.push_back(builder.create<arith::MinSIOp>(
+              loc,
+              builder.create<arith::AddIOp>(
+                  loc, iv[0],
+                  builder.create<arith::ConstantIndexOp>(loc, j)),
+              lastRow));
+
+        builder.create<scf::ForOp>(
+            loc, c0, paddedWidth, lanesVal, ValueRange{},
+            [&](OpBuilder &builder, Location loc, ValueRange iv1,
+                ValueRange) {
+              Value mask = tailMaskCreator(builder, loc, paddedWidth, iv1[0],
+                                           vectorMaskTy);
+              SmallVector<Value> block;
+              for (Value row : rows)
+                block.push_back(builder.create<vector::MaskedLoadOp>(
+                    loc, vectorTy, src, ValueRange{row, iv1[0]}, mask,
+                    padding));
+              SmallVector<Value> transposed =
+                  transposeBlock(builder, loc, block);
+              for (int64_t k = 0; k < lanes; ++k)
+                builder.create<vector::StoreOp>(
+                    loc, transposed[k], columns,
+                    ValueRange{builder.create<arith::AddIOp>(
+                                   loc, iv1[0],
+                                   builder.create<arith::ConstantIndexOp>(
+                                       loc, k)),
+                               c0});
+              builder.create<scf::YieldOp>(loc);
+            });
+
+        vanHerkScan(builder, loc, paddedWidth, window, /*backward=*/false,
+                    /*parallel=*/false, c0, c1, scanStep(forward));
+        vanHerkScan(builder, loc, paddedWidth, window, /*backward=*/true,
+                    /*parallel=*/false, c0, c1, scanStep(backward));
+
+        // Output column c combines the backward scan at c and the forward
+        // scan at c + window - 1. Columns past the image repeat the last one.
+        builder.create<scf::ForOp>(
+            loc, c0, width, lanesVal, ValueRange{},
+            [&](OpBuilder &builder, Location loc, ValueRange iv1,
+                ValueRange) {
+              Value mask =
+                  tailMaskCreator(builder, loc, width, iv1[0], vectorMaskTy);
+              SmallVector<Value> block;
+              for (int64_t k = 0; k < lanes; ++k) {
+                Value col = builder.create<arith::MinSIOp>(
+                    loc,
+                    builder.create<arith::AddIOp>(
+                        loc, iv1[0],
+                        builder.create<arith::ConstantIndexOp>(loc, k)),
+                    lastCol);
+                Value forwardCol =
+                    builder.create<arith::AddIOp>(loc, col, windowLast);
+                Value backwardVec = builder.create<vector::LoadOp>(
+                    loc, vectorTy, backward, ValueRange{col, c0});
+                Value forwardVec = builder.create<vector::LoadOp>(
+                    loc, vectorTy, forward, ValueRange{forwardCol, c0});
+                block.push_back(morphCombine(builder, loc, elemTy, backwardVec,
+                                             forwardVec, op));
+              }
+              SmallVector<Value> transposed =
+                  transposeBlock(builder, loc, block);
+              for (int64_t j = 0; j < lanes; ++j) {
+                Value row = builder.create<arith::AddIOp>(
+                    loc, iv[0], builder.create<arith::ConstantIndexOp>(loc, j));
+                if (j == 0) {
+                  emitRow(builder, loc, row, iv1[0], mask, transposed[j]);
+                  continue;
+                }
+                Value isRow = builder.create<arith::CmpIOp>(
+                    loc, arith::CmpIPredicate::slt, row, rowEnd);
+                builder.create<scf::IfOp>(
+                    loc, isRow, [&](OpBuilder &builder, Location loc) {
+                      emitRow(builder, loc, row, iv1[0], mask, transposed[j]);
+                      builder.create<scf::YieldOp>(loc);
+                    });
+              }
+              builder.create<scf::YieldOp>(loc);
+            });
+        builder.create<scf::YieldOp>(loc);
+      });
+
+  for (Value buffer : {columns, forward, backward})
+    builder.create<memref::DeallocOp>(loc, buffer);
+}
+
+// Returns whether `kernel` is rectangular, i.e. has no zero element, when it is
+// a constant global, so that the decision can be taken at compile time.
+static std::optional<bool> constantRectangularKernel(Value kernel) {
+  auto getGlobalOp = kernel.getDefiningOp<memref::GetGlobalOp>();
+  if (!getGlobalOp)
+    return std::nullopt;
+  auto globalOp = SymbolTable::lookupNearestSymbolFrom<memref::GlobalOp>(
+      getGlobalOp, getGlobalOp.getNameAttr());
+  if (!globalOp || !globalOp.getConstant() || !globalOp.getInitialValue())
+    return std::nullopt;
+  auto dense = globalOp.getInitialValue()->dyn_cast<DenseElementsAttr>();
+  if (!dense)
+    return std::nullopt;
+  if (dense.getElementType().isa<FloatType>())
+    return llvm::none_of(dense.getValues<APFloat>(),
+                         [](const APFloat &value) { return value.isZero(); });
+  return llvm::none_of(dense.getValues<APInt>(),
+                       [](const APInt &value) { return value.isZero(); });
+}
+
+void vanHerkMorphology(OpBuilder &rewriter, Location loc, MLIRContext *ctx,
+                       Value input, Value kernel, Value output, Value centerX,
+                       Value centerY, Value constantValue, Type elemTy,
+                       buddy::dip::BoundaryOption boundaryOptionAttr,
+                       int64_t stride, DIP_OP op, int64_t tileRows) {
+  // Create constant indices.
+  Value c0 = rewriter.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = rewriter.create<arith::ConstantIndexOp>(loc, 1);
+
+  // Create DimOp.
+  Value inputRow = rewriter.create<memref::DimOp>(loc, input, c0);
+  Value inputCol = rewriter.create<memref::DimOp>(loc, input, c1);
+  Value kernelRow = rewriter.create<memref::DimOp>(loc, kernel, c0);
+  Value kernelCol = rewriter.create<memref::DimOp>(loc, kernel, c1);
+  Value lastRow = rewriter.create<arith::SubIOp>(loc, inputRow, c1);
+  Value lastCol = rewriter.create<arith::SubIOp>(loc, inputCol, c1);
+
+  VectorType vectorTy = VectorType::get({stride}, elemTy);
+  VectorType vectorMaskTy = VectorType::get({stride}, IntegerType::get(ctx, 1));
+  Value constantVec =
+      rewriter.create<vector::BroadcastOp>(loc, vectorTy, constantValue);
+  bool constantPadding =
+      boundaryOptionAttr == dip::BoundaryOption::ConstantPadding;
+  int64_t lanes = std::min(stride, kVanHerkLanes);
+
+  // Vertical pass. Padded row q is input row q - centerY after boundary
+  // extrapolation; output row i covers padded rows [i, i + kernelRow). The
+  // result is stored with its columns shifted by centerX, so that the row tiles
+  // of the horizontal pass can extrapolate them in place: element p of a row
+  // of `vertical` is column p - centerX.
+  Value paddedRow = rewriter.create<arith::SubIOp>(
+      loc, rewriter.create<arith::AddIOp>(loc, inputRow, kernelRow), c1);
+  Value paddedCol = rewriter.create<arith::SubIOp>(
+      loc, rewriter.create<arith::AddIOp>(loc, inputCol, kernelCol), c1);
+  MemRefType imageTy =
+      MemRefType::get({ShapedType::kDynamic, ShapedType::kDynamic}, elemTy);
+  Value vertical = rewriter.create<memref::AllocOp>(
+      loc, imageTy, ValueRange{inputRow, paddedCol});
+  verticalVanHerk(
+      rewriter, loc, ctx, paddedRow, kernelRow, inputCol, inputRow, c0, elemTy,
+      stride, op, tileRows, c0, c1,
+      [&](OpBuilder &builder, Location loc, Value pos, Value col,
+          Value) -> Value {
+        Value row = builder.create<arith::SubIOp>(loc, pos, centerY);
+        Value clampedRow = builder.create<arith::MinSIOp>(
+            loc, builder.create<arith::MaxSIOp>(loc, row, c0), lastRow);
+        Value tailLength = builder.create<arith::SubIOp>(loc, inputCol, col);
+        // Rows outside of the image read the padding constant.
+        if (constantPadding)
+          tailLength = builder.create<arith::SelectOp>(
+              loc, inBound(builder, loc, row, c0, inputRow), tailLength, c0);
+        Value mask = builder.create<vector::CreateMaskOp>(
+            loc, vectorMaskTy, ValueRange{tailLength});
+        return builder.create<vector::MaskedLoadOp>(
+            loc, vectorTy, input, ValueRange{clampedRow, col}, mask,
+            constantVec);
+      },
+      [&](OpBuilder &builder, Location loc, Value row, Value col, Value mask,
+          Value vec) {
+        Value bufferCol = builder.create<arith::AddIOp>(loc, col, centerX);
+        builder.create<vector::MaskedStoreOp>(
+            loc, vertical, ValueRange{row, bufferCol}, mask, vec);
+      });
+
+  // Horizontal pass. Every row tile extrapolates the columns of its rows and
+  // filters them in groups, combining the result with the output.
+  buildRowTileLoop(
+      rewriter, loc, c0, inputRow, tileRows,
+      [&](OpBuilder &builder, Location loc, Value rowBegin, Value rowEnd) {
+        builder.create<scf::ForOp>(
+            loc, rowBegin, rowEnd, c1, ValueRange{},
+            [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange) {
+              Value leftVal = constantValue, rightVal = constantValue;
+              if (!constantPadding) {
+                leftVal = builder.create<memref::LoadOp>(
+                    loc, vertical, ValueRange{iv[0], centerX});
+                rightVal = builder.create<memref::LoadOp>(
+                    loc, vertical,
+                    ValueRange{iv[0], builder.create<arith::AddIOp>(
+                                          loc, centerX, lastCol)});
+              }
+              padColumns(builder, loc, vertical, iv[0], centerX, inputCol,
+                         leftVal, rightVal, c0, c1);
+              builder.create<scf::YieldOp>(loc);
+            });
+        horizontalVanHerk(
+            builder, loc, ctx, vertical, rowBegin, rowEnd, inputCol,
+            kernelCol, elemTy, lanes, op, c0, c1,
+            [&](OpBuilder &builder, Location loc, Value row, Value col,
+                Value mask, Value vec) {
+              Value outputVec = builder.create<vector::MaskedLoadOp>(
+                  loc, vec.getType(), output, ValueRange{row, col}, mask,
+                  vec);
+              Value res =
+                  morphCombine(builder, loc, elemTy, outputVec, vec, op);
+              builder.create<vector::MaskedStoreOp>(
+                  loc, output, ValueRange{row, col}, mask, res);
+            });
+      });
+
+  rewriter.create<memref::DeallocOp>(loc, vertical);
+}
+
+void traverseImageMorphology(OpBuilder &rewriter, Location loc,
+                             MLIRContext *ctx, Value input, Value kernel,
+                             Value output, Value centerX, Value centerY,
+                             Value constantValue, Value strideVal, Type elemTy,
+                             buddy::dip::BoundaryOption boundaryOptionAttr,
+                             int64_t stride, DIP_OP op, int64_t tileRows) {
+  auto buildVanHerk = [&](OpBuilder &builder, Location loc) {
+    vanHerkMorphology(builder, loc, ctx, input, kernel, output, centerX,
+                      centerY, constantValue, elemTy, boundaryOptionAttr,
+                      stride, op, tileRows);
+  };
+  auto buildGeneric = [&](OpBuilder &builder, Location loc) {
+    traverseImagewBoundaryExtrapolation(
+        builder, loc, ctx, input, kernel, output, centerX, centerY,
+        constantValue, strideVal, elemTy, boundaryOptionAttr, stride, op,
+        tileRows);
+  };
+  // A constant kernel selects the implementation at compile time.
+  if (std::optional<bool> isRectangular = constantRectangularKernel(kernel)) {
+    if (*isRectangular)
+      buildVanHerk(rewriter, loc);
+    else
+      buildGeneric(rewriter, loc);
+    return;
+  }
+
+  Value c0 = rewriter.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = rewriter.create<arith::ConstantIndexOp>(loc, 1);
+  Value isRectangular =
+      isRectangularKernel(rewriter, loc, ctx, kernel, elemTy, c0, c1);
+  rewriter.create<scf::IfOp>(
+      loc, isRectangular,
+      [&](OpBuilder &builder, Location loc) {
+        buildVanHerk(builder, loc);
+        builder.create<scf::YieldOp>(loc);
+      },
+      [&](OpBuilder &builder, Location loc) {
+        buildGeneric(builder, loc);
+        builder.create<scf::YieldOp>(loc);
+      });
+}
+
+// Number of rows of the tiles of `fusedMorphology` when the tiles are not
+// processed in parallel.
+static constexpr int64_t kFusedMorphologyTileRows = 32;
+
+void fusedMorphology(OpBuilder &rewriter, Location loc, MLIRContext *ctx,
+                     Value input, Value kernel, Value output, Value centerX,
+                     Value centerY, Value constantValue, Value firstInit,
+                     Value secondInit, Type elemTy,
+                     buddy::dip::BoundaryOption boundaryOptionAttr,
+                     int64_t stride, DIP_OP op, int64_t tileRows) {
+  // Create constant indices.
+  Value c0 = rewriter.create<arith::ConstantIndexOp>(loc, 0);
+  Value c1 = rewriter.create<arith::ConstantIndexOp>(loc, 1);
+  Value strideVal = rewriter.create<arith::ConstantIndexOp>(loc, stride);
+  int64_t tileHeight = tileRows > 0 ? tileRows : kFusedMorphologyTileRows;
+  Value tileHeightVal =
+      rewriter.create<arith::ConstantIndexOp>(loc, tileHeight);
+
+  // Create DimOp.
+  Value inputRow = rewriter.create<memref::DimOp>(loc, input, c0);
+  Value inputCol = rewriter.create<memref::DimOp>(loc, input, c1);
+  Value kernelRow = rewriter.create<memref::DimOp>(loc, kernel, c0);
+  Value kernelCol = rewriter.create<memref::DimOp>(loc, kernel, c1);
+  Value lastRow = rewriter.create<arith::SubIOp>(loc, inputRow, c1);
+  Value lastCol = rewriter.create<arith::SubIOp>(loc, inputCol, c1);
+  Value kernelRowLast = rewriter.create<arith::SubIOp>(loc, kernelRow, c1);
+  Value kernelColLast = rewriter.create<arith::SubIOp>(loc, kernelCol, c1);
+
+  VectorType vectorTy = VectorType::get({stride}, elemTy);
+  VectorType vectorMaskTy = VectorType::get({stride}, IntegerType::get(ctx, 1));
+  Value constantVec =
+      rewriter.create<vector::BroadcastOp>(loc, vectorTy, constantValue);
+  Value zeroElem = insertZeroConstantOp(ctx, rewriter, loc, elemTy);
+  bool constantPadding =
+      boundaryOptionAttr == dip::BoundaryOption::ConstantPadding;
+  bool isFloat = elemTy.isF32() || elemTy.isF64();
+  int64_t lanes = std::min(stride, kVanHerkLanes);
+
+  // Opening and top hat erode first, closing and bottom hat dilate first. The
+  // morphological gradient combines a dilation and an erosion of the input.
+  bool twoStages = op != DIP_OP::MORPHGRAD_2D;
+  DIP_OP firstOp = DIP_OP::DILATION_2D, secondOp = DIP_OP::EROSION_2D;
+  if (op == DIP_OP::OPENING_2D || op == DIP_OP::TOPHAT_2D)
+    std::swap(firstOp, secondOp);
+
+  // Tile buffers. Row k of the input tile is input row
+  // tileBegin - 2 * centerY + k, row m of the first stage tile is row
+  // tileBegin - centerY + m of the first stage, both after boundary
+  // extrapolation. Element p of a tile row is column p - centerX.
+  MemRefType tileTy =
+      MemRefType::get({ShapedType::kDynamic, ShapedType::kDynamic}, elemTy);
+  Value paddedCol =
+      rewriter.create<arith::AddIOp>(loc, inputCol, kernelColLast);
+  Value rowHalo =
+      rewriter.create<arith::AddIOp>(loc, kernelRowLast, kernelRowLast);
+  Value inTileRow = rewriter.create<arith::AddIOp>(loc, tileHeightVal, rowHalo);
+  Value midTileRow =
+      rewriter.create<arith::AddIOp>(loc, tileHeightVal, kernelRowLast);
+
+  // Extrapolates the columns of row `row` of `buffer` from its image columns.
+  auto extrapolateColumns = [&](OpBuilder &builder, Location loc, Value buffer,
+                                Value row) {
+    Value leftVal = constantValue, rightVal = constantValue;
+    if (!constantPadding) {
+      leftVal =
+          builder.create<memref::LoadOp>(loc, buffer, ValueRange{row, centerX});
+      Value lastBufferCol =
+          builder.create<arith::AddIOp>(loc, centerX, lastCol);
+      rightVal = builder.create<memref::LoadOp>(
+          loc, buffer, ValueRange{row, lastBufferCol});
+    }
+    padColumns(builder, loc, buffer, row, centerX, inputCol, leftVal, rightVal,
+               c0, c1);
+  };
+
+  // Combines the window of `buffer` whose top left element is at (row, col)
+  // for the vector of output columns starting at `col`.
+  auto combineWindow = [&](OpBuilder &builder, Location loc, Value buffer,
+                           Value row, Value col, Value mask, Value init,
+                           DIP_OP stageOp) -> Value {
+    Value initVec = builder.create<vector::BroadcastOp>(loc, vectorTy, init);
+    auto rowLoop = builder.create<scf::ForOp>(
+        loc, c0, kernelRow, c1, ValueRange{initVec},
+        [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange acc) {
+          Value bufferRow = builder.create<arith::AddIOp>(loc, row, iv[0]);
+          auto colLoop = builder.create<scf::ForOp>(
+              loc, c0, kernelCol, c1, ValueRange{acc[0]},
+              [&](OpBuilder &builder, Location loc, ValueRange iv1,
+                  ValueRange acc1) {
+                Value kernelValue = builder.create<memref::LoadOp>(
+                    loc, kernel, ValueRange{iv[0], iv1[0]});
+                Value nonZero =
+                    zeroCond(builder, loc, elemTy, kernelValue, zeroElem);
+                Value bufferCol =
+                    builder.create<arith::AddIOp>(loc, col, iv1[0]);
+                Value vec = builder.create<vector::MaskedLoadOp>(
+                    loc, vectorTy, buffer, ValueRange{bufferRow, bufferCol},
+                    mask, constantVec);
+                Value combined =
+                    morphCombine(builder, loc, elemTy, acc1[0], vec, stageOp);
+                Value res = builder.create<arith::SelectOp>(loc, nonZero,
+                                                            combined, acc1[0]);
+                builder.create<scf::YieldOp>(loc, res);
+              });
+          builder.create<scf::YieldOp>(loc, colLoop.getResult(0));
+        });
+    return rowLoop.getResult(0);
+  };
+
+  auto subtract = [&](OpBuilder &builder, Location loc, Value lhs,
+                      Value rhs) -> Value {
+    if (isFloat)
+      return builder.create<arith::SubFOp>(loc, lhs, rhs);
+    return builder.create<arith::SubIOp>(loc, lhs, rhs);
+  };
+
+  // Stores the result of the compound operation for the vector of columns
+  // starting at `col` of image row `row`; top hat and bottom hat subtract the
+  // input.
+  auto storeResult = [&](OpBuilder &builder, Location loc, Value row,
+                         Value col, Value mask, Value res) {
+    if (op == DIP_OP::TOPHAT_2D || op == DIP_OP::BOTTOMHAT_2D) {
+      Value inputVec = builder.create<vector::MaskedLoadOp>(
+          loc, res.getType(), input, ValueRange{row, col}, mask, res);
+      res = op == DIP_OP::TOPHAT_2D ? subtract(builder, loc, inputVec, res)
+                                    : subtract(builder, loc, res, inputVec);
+    }
+    builder.create<vector::MaskedStoreOp>(loc, output, ValueRange{row, col},
+                                          mask, res);
+  };
+
+  // Extrapolated input rows of the tile and of its halo.
+  auto fillInputTile = [&](OpBuilder &builder, Location loc, Value inTile,
+                           Value inBase, Value inCount) {
+    builder.create<scf::ForOp>(
+        loc, c0, inCount, c1, ValueRange{},
+        [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange) {
+          Value row = builder.create<arith::AddIOp>(loc, inBase, iv[0]);
+          Value clampedRow = builder.create<arith::MinSIOp>(
+              loc, builder.create<arith::MaxSIOp>(loc, row, c0), lastRow);
+          Value inRange = inBound(builder, loc, row, c0, inputRow);
+          builder.create<scf::ForOp>(
+              loc, c0, inputCol, strideVal, ValueRange{},
+              [&](OpBuilder &builder, Location loc, ValueRange iv1,
+                  ValueRange) {
+                Value tailLength =
+                    builder.create<arith::SubIOp>(loc, inputCol, iv1[0]);
+                // Rows outside of the image read the padding constant.
+                if (constantPadding)
+                  tailLength = builder.create<arith::SelectOp>(
+                      loc, inRange, tailLength, c0);
+                Value mask = builder.create<vector::CreateMaskOp>(
+                    loc, vectorMaskTy, ValueRange{tailLength});
+                Value inputVec = builder.create<vector::MaskedLoadOp>(
+                    loc, vectorTy, input, ValueRange{clampedRow, iv1[0]}, mask,
+                    constantVec);
+                Value storeMask = tailMaskCreator(builder, loc, inputCol,
+                                                  iv1[0], vectorMaskTy);
+                Value bufferCol =
+                    builder.create<arith::AddIOp>(loc, iv1[0], centerX);
+                builder.create<vector::MaskedStoreOp>(
+                    loc, inTile, ValueRange{iv[0], bufferCol}, storeMask,
+                    inputVec);
+                builder.create<scf::YieldOp>(loc);
+              });
+          extrapolateColumns(builder, loc, inTile, iv[0]);
+          builder.create<scf::YieldOp>(loc);
+        });
+  };
+
+  // Tile body for arbitrary kernels, combining the whole window of every
+  // element.
+  auto tileBody = [&](OpBuilder &builder, Location loc, Value tileBegin,
+                      Value tileEnd) {
+    Value tileCount = builder.create<arith::SubIOp>(loc, tileEnd, tileBegin);
+    Value inTile = builder.create<memref::AllocOp>(
+        loc, tileTy, ValueRange{inTileRow, paddedCol});
+    Value midTile;
+    if (twoStages)
+      midTile = builder.create<memref::AllocOp>(
+          loc, tileTy, ValueRange{midTileRow, paddedCol});
+
+    Value inBase = builder.create<arith::SubIOp>(
+        loc, tileBegin, builder.create<arith::AddIOp>(loc, centerY, centerY));
+    Value inCount = builder.create<arith::AddIOp>(loc, tileCount, rowHalo);
+    fillInputTile(builder, loc, inTile, inBase, inCount);
+
+    // First stage on the rows of the tile and of the halo of the second
+    // stage. Rows outside of the image are extrapolated like the input.
+    Value midBase = builder.create<arith::SubIOp>(loc, tileBegin, centerY);
+    Value midCount =
+        builder.create<arith::AddIOp>(loc, tileCount, kernelRowLast);
+    if (twoStages)
+      builder.create<scf::ForOp>(
+          loc, c0, midCount, c1, ValueRange{},
+          [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange) {
+            Value row = builder.create<arith::AddIOp>(loc, midBase, iv[0]);
+            Value clampedRow = builder.create<arith::MinSIOp>(
+                loc, builder.create<arith::MaxSIOp>(loc, row, c0), lastRow);
+            Value inRange = inBound(builder, loc, row, c0, inputRow);
+            Value windowRow = builder.create<arith::SubIOp>(
+                loc, builder.create<arith::SubIOp>(loc, clampedRow, centerY),
+                inBase);
+            builder.create<scf::ForOp>(
+                loc, c0, inputCol, strideVal, ValueRange{},
+                [&](OpBuilder &builder, Location loc, ValueRange iv1,
+                    ValueRange) {
+                  Value mask = tailMaskCreator(builder, loc, inputCol, iv1[0],
+                                               vectorMaskTy);
+                  Value res = combineWindow(builder, loc, inTile, windowRow,
+                                            iv1[0], mask, firstInit, firstOp);
+                  if (constantPadding)
+                    res = builder.create<arith::SelectOp>(loc, inRange, res,
+                                                          constantVec);
+                  Value bufferCol =
+                      builder.create<arith::AddIOp>(loc, iv1[0], centerX);
+                  builder.create<vector::MaskedStoreOp>(
+                      loc, midTile, ValueRange{iv[0], bufferCol}, mask, res);
+                  builder.create<scf::YieldOp>(loc);
+                });
+            extrapolateColumns(builder, loc, midTile, iv[0]);
+            builder.create<scf::YieldOp>(loc);
+          });
+
+    // Second stage and final combination, written to the output.
+    builder.create<scf::ForOp>(
+        loc, tileBegin, tileEnd, c1, ValueRange{},
+        [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange) {
+          Value tileRow = builder.create<arith::SubIOp>(loc, iv[0], tileBegin);
+          builder.create<scf::ForOp>(
+              loc, c0, inputCol, strideVal, ValueRange{},
+              [&](OpBuilder &builder, Location loc, ValueRange iv1,
+                  ValueRange) {
+                Value mask = tailMaskCreator(builder, loc, inputCol, iv1[0],
+                                             vectorMaskTy);
+                Value res;
+                if (twoStages) {
+                  res = combineWindow(builder, loc, midTile, tileRow, iv1[0],
+                                      mask, secondInit, secondOp);
+                } else {
+                  Value windowRow =
+                      builder.create<arith::AddIOp>(loc, tileRow, centerY);
+                  Value dilated =
+                      combineWindow(builder, loc, inTile, windowRow, iv1[0],
+                                    mask, firstInit, firstOp);
+                  Value eroded =
+                      combineWindow(builder, loc, inTile, windowRow, iv1[0],
+                                    mask, secondInit, secondOp);
+                  res = subtract(builder, loc, dilated, eroded);
+                }
+                storeResult(builder, loc, iv[0], iv1[0], mask, res);
+                builder.create<scf::YieldOp>(loc);
+              });
+          builder.create<scf::YieldOp>(loc);
+        });
+
+    builder.create<memref::DeallocOp>(loc, inTile);
+    if (twoStages)
+      builder.create<memref::DeallocOp>(loc, midTile);
+  };
+
+  // Tile body for rectangular kernels: every stage is a vertical and a
+  // horizontal van Herk/Gil-Werman pass over the tile buffers.
+  auto loadTile = [&](Value buffer) {
+    return [&, buffer](OpBuilder &builder, Location loc, Value pos, Value col,
+                       Value mask) -> Value {
+      return builder.create<vector::MaskedLoadOp>(
+          loc, vectorTy, buffer, ValueRange{pos, col}, mask, constantVec);
+    };
+  };
+  auto storeTile = [&](Value buffer) {
+    return [&, buffer](OpBuilder &builder, Location loc, Value row, Value col,
+                       Value mask, Value vec) {
+      builder.create<vector::MaskedStoreOp>(loc, buffer, ValueRange{row, col},
+                                            mask, vec);
+    };
+  };
+  auto withInit = [&](OpBuilder &builder, Location loc, Value vec, Value init,
+                      DIP_OP stageOp) -> Value {
+    Value initVec =
+        builder.create<vector::BroadcastOp>(loc, vec.getType(), init);
+    return morphCombine(builder, loc, elemTy, initVec, vec, stageOp);
+  };
+  auto vanHerkTileBody = [&](OpBuilder &builder, Location loc, Value tileBegin,
+                             Value tileEnd) {
+    Value tileCount = builder.create<arith::SubIOp>(loc, tileEnd, tileBegin);
+    Value inTile = builder.create<memref::AllocOp>(
+        loc, tileTy, ValueRange{inTileRow, paddedCol});
+    Value midTile = builder.create<memref::AllocOp>(
+        loc, tileTy, ValueRange{midTileRow, paddedCol});
+
+    Value inBase = builder.create<arith::SubIOp>(
+        loc, tileBegin, builder.create<arith::AddIOp>(loc, centerY, centerY));
+    Value inCount = builder.create<arith::AddIOp>(loc, tileCount, rowHalo);
+    fillInputTile(builder, loc, inTile, inBase, inCount);
+
+    if (twoStages) {
+      // First stage. The vertical pass covers the padded columns of the input
+      // tile, the horizontal pass then overwrites the image columns in place.
+      Value midBase = builder.create<arith::SubIOp>(loc, tileBegin, centerY);
+      Value midCount =
+          builder.create<arith::AddIOp>(loc, tileCount, kernelRowLast);
+      verticalVanHerk(builder, loc, ctx, inCount, kernelRow, paddedCol,
+                      midCount, c0, elemTy, stride, firstOp, /*tileRows=*/0,
+                      c0, c1, loadTile(inTile), storeTile(midTile));
+      horizontalVanHerk(
+          builder, loc, ctx, midTile, c0, midCount, inputCol, kernelCol,
+          elemTy, lanes, firstOp, c0, c1,
+          [&](OpBuilder &builder, Location loc, Value row, Value col,
+              Value mask, Value vec) {
+            Value bufferCol = builder.create<arith::AddIOp>(loc, col, centerX);
+            builder.create<vector::MaskedStoreOp>(
+                loc, midTile, ValueRange{row, bufferCol}, mask,
+                withInit(builder, loc, vec, firstInit, firstOp));
+          });
+
+      // Rows outside of the image are extrapolated like the input.
+      builder.create<scf::ForOp>(
+          loc, c0, midCount, c1, ValueRange{},
+          [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange) {
+            Value row = builder.create<arith::AddIOp>(loc, midBase, iv[0]);
+            Value clampedRow = builder.create<arith::MinSIOp>(
+                loc, builder.create<arith::MaxSIOp>(loc, row, c0), lastRow);
+            Value isOutside = builder.create<arith::CmpIOp>(
+                loc, arith::CmpIPredicate::ne, row, clampedRow);
+            Value sourceRow =
+                builder.create<arith::SubIOp>(loc, clampedRow, midBase);
+            builder.create<scf::IfOp>(
+                loc, isOutside, [&](OpBuilder &builder, Location loc) {
+                  builder.create<scf::ForOp>(
+                      loc, c0, inputCol, strideVal, ValueRange{},
+                      [&](OpBuilder &builder, Location loc, ValueRange iv1,
+                          ValueRange) {
+                        Value mask = tailMaskCreator(builder, loc, inputCol,
+                                                     iv1[0], vectorMaskTy);
+                        Value bufferCol =
+                            builder.create<arith::AddIOp>(loc, iv1[0], centerX);
+                        Value vec = constantVec;
+                        if (!constantPadding)
+                          vec = builder.create<vector::MaskedLoadOp>(
+                              loc, vectorTy, midTile,
+                              ValueRange{sourceRow, bufferCol}, mask,
+                              constantVec);
+                        builder.create<vector::MaskedStoreOp>(
+                            loc, midTile, ValueRange{iv[0], bufferCol}, mask,
+                            vec);
+                        builder.create<scf::YieldOp>(loc);
+                      });
+                  builder.create<scf::YieldOp>(loc);
+                });
+            extrapolateColumns(builder, loc, midTile, iv[0]);
+            builder.create<scf::YieldOp>(loc);
+          });
+
+      // Second stage. The vertical pass is written in place to the first rows
+      // of the first stage tile.
+      verticalVanHerk(builder, loc, ctx, midCount, kernelRow, paddedCol,
+                      tileCount, c0, elemTy, stride, secondOp, /*tileRows=*/0,
+                      c0, c1, loadTile(midTile), storeTile(midTile));
+      horizontalVanHerk(
+          builder, loc, ctx, midTile, c0, tileCount, inputCol, kernelCol,
+          elemTy, lanes, secondOp, c0, c1,
+          [&](OpBuilder &builder, Location loc, Value row, Value col,
+              Value mask, Value vec) {
+            storeResult(builder, loc,
+                        builder.create<arith::AddIOp>(loc, tileBegin, row),
+                        col, mask,
+                        withInit(builder, loc, vec, secondInit, secondOp));
+          });
+    } else {
+      // The dilation is written to the output, then the erosion is subtracted
+      // from it.
+      verticalVanHerk(builder, loc, ctx, inCount, kernelRow, paddedCol,
+                      tileCount, centerY, elemTy, stride, firstOp,
+                      /*tileRows=*/0, c0, c1, loadTile(inTile),
+                      storeTile(midTile));
+      horizontalVanHerk(
+          builder, loc, ctx, midTile, c0, tileCount, inputCol, kernelCol,
+          elemTy, lanes, firstOp, c0, c1,
+          [&](OpBuilder &builder, Location loc, Value row, Value col,
+              Value mask, Value vec) {
+            Value outputRow =
+                builder.create<arith::AddIOp>(loc, tileBegin, row);
+            builder.create<vector::MaskedStoreOp>(
+                loc, output, ValueRange{outputRow, col}, mask,
+                withInit(builder, loc, vec, firstInit, firstOp));
+          });
+      verticalVanHerk(builder, loc, ctx, inCount, kernelRow, paddedCol,
+                      tileCount, centerY, elemTy, stride, secondOp,
+                      /*tileRows=*/0, c0, c1, loadTile(inTile),
+                      storeTile(midTile));
+      horizontalVanHerk(
+          builder, loc, ctx, midTile, c0, tileCount, inputCol, kernelCol,
+          elemTy, lanes, secondOp, c0, c1,
+          [&](OpBuilder &builder, Location loc, Value row, Value col,
+              Value mask, Value vec) {
+            Value outputRow =
+                builder.create<arith::AddIOp>(loc, tileBegin, row);
+            Value dilated = builder.create<vector::MaskedLoadOp>(
+                loc, vec.getType(), output, ValueRange{outputRow, col}, mask,
+                vec);
+            Value eroded = withInit(builder, loc, vec, secondInit, secondOp);
+            builder.create<vector::MaskedStoreOp>(
+                loc, output, ValueRange{outputRow, col}, mask,
+                subtract(builder, loc, dilated, eroded));
+          });
+    }
+
+    builder.create<memref::DeallocOp>(loc, inTile);
+    builder.create<memref::DeallocOp>(loc, midTile);
+  };
+
+  auto buildTiles =
+      [&](OpBuilder &builder, Location loc,
+          function_ref<void(OpBuilder &, Location, Value, Value)> body) {
+        if (tileRows > 0) {
+          buildRowTileLoop(builder, loc, c0, inputRow, tileRows, body);
+          return;
+        }
+        builder.create<scf::ForOp>(
+            loc, c0, inputRow, tileHeightVal, ValueRange{},
+            [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange) {
+              Value tileEnd = builder.create<arith::MinSIOp>(
+                  loc,
+                  builder.create<arith::AddIOp>(loc, iv[0], tileHeightVal),
+                  inputRow);
+              body(builder, loc, iv[0], tileEnd);
+              builder.create<scf::YieldOp>(loc);
+            });
+      };
+
+  // A constant kernel selects the tile body at compile time.
+  if (std::optional<bool> isRectangular = constantRectangularKernel(kernel)) {
+    if (*isRectangular)
+      buildTiles(rewriter, loc, vanHerkTileBody);
+    else
+      buildTiles(rewriter, loc, tileBody);
+    return;
+  }
+  Value isRectangular =
+      isRectangularKernel(rewriter, loc, ctx, kernel, elemTy, c0, c1);
+  rewriter.create<scf::IfOp>(
+      loc, isRectangular,
+      [&](OpBuilder &builder, Location loc) {
+        buildTiles(builder, loc, vanHerkTileBody);
+        builder.create<scf::YieldOp>(loc);
+      },
+      [&](OpBuilder &builder, Location loc) {
+        buildTiles(builder, loc, tileBody);
+        builder.create<scf::YieldOp>(loc);
+      });
+}
+
 } // namespace dip
 } // namespace buddy
 
@@ -32,8 +32,10 @@
 #include <mlir/IR/MLIRContext.h>
 #include <mlir/IR/Value.h>
 
+#include <cmath>
 #include <initializer_list>
 #include <numeric>
+#include <tuple>
 
 using namespace mlir;
 
@@ -171,6 +173,69 @@ Value castAndExpand(OpBuilder &builder, Location loc, Value val,
   return builder.create<vector::SplatOp>(loc, vecType, interm1);
 }
 
+// Builds an affine loop nest whose outermost loop is optionally split into
+// row tiles that are distributed by an `affine.parallel` loop.
+void buildRowTiledLoopNest(
+    OpBuilder &builder, Location loc, ValueRange lbs, ValueRange ubs,
+    ArrayRef<int64_t> steps, int64_t tileRows,
+    function_ref<void(OpBuilder &, Location, ValueRange)> bodyBuilderFn) {
+  if (tileRows <= 0) {
+    affine::buildAffineLoopNest(builder, loc, lbs, ubs, steps, bodyBuilderFn);
+    return;
+  }
+  MLIRContext *ctx = builder.getContext();
+  AffineMap identityMap = builder.getDimIdentityMap();
+  int64_t tileStep = tileRows * steps[0];
+  auto tileLoop = builder.create<affine::AffineParallelOp>(
+      loc, TypeRange{}, ArrayRef<arith::AtomicRMWKind>{},
+      ArrayRef<AffineMap>{identityMap}, ValueRange{lbs[0]},
+      ArrayRef<AffineMap>{identityMap}, ValueRange{ubs[0]},
+      ArrayRef<int64_t>{tileStep});
+
+  OpBuilder::InsertionGuard guard(builder);
+  builder.setInsertionPointToStart(tileLoop.getBody());
+  Value tileBegin = tileLoop.getIVs()[0];
+  // The last tile stops at the upper bound: min(d0 + tileStep, s0).
+  AffineMap tileEndMap = AffineMap::get(
+      1, 1, {getAffineDimExpr(0, ctx) + tileStep, getAffineSymbolExpr(0, ctx)},
+      ctx);
+  builder.create<affine::AffineForOp>(
+      loc, ValueRange{tileBegin}, identityMap, ValueRange{tileBegin, ubs[0]},
+      tileEndMap, steps[0], std::nullopt,
+      [&](OpBuilder &builder, Location loc, Value row, ValueRange) {
+        affine::buildAffineLoopNest(
+            builder, loc, lbs.drop_front(), ubs.drop_front(),
+            steps.drop_front(),
+            [&](OpBuilder &builder, Location loc, ValueRange ivs) {
+              SmallVector<Value, 4> allIvs{row};
+              allIvs.append(ivs.begin(), ivs.end());
+              bodyBuilderFn(builder, loc, allIvs);
+            });
+        builder.create<affine::AffineYieldOp>(loc);
+      });
+}
+
+// Splits a row range into tiles that are distributed by an `scf.parallel`
+// loop, or builds the body once for the whole range.
+void buildRowTileLoop(
+    OpBuilder &builder, Location loc, Value lowerBound, Value upperBound,
+    int64_t tileRows,
+    function_ref<void(OpBuilder &, Location, Value, Value)> bodyBuilderFn) {
+  if (tileRows <= 0) {
+    bodyBuilderFn(builder, loc, lowerBound, upperBound);
+    return;
+  }
+  Value tileSize = builder.create<arith::ConstantIndexOp>(loc, tileRows);
+  builder.create<scf::ParallelOp>(
+      loc, ValueRange{lowerBound}, ValueRange{upperBound}, ValueRange{tileSize},
+      [&](OpBuilder &builder, Location loc, ValueRange ivs) {
+        Value tileEnd = builder.create<arith::MinSIOp>(
+            loc, builder.create<arith::AddIOp>(loc, ivs[0], tileSize),
+            upperBound);
+        bodyBuilderFn(builder, loc, ivs[0], tileEnd);
+      });
+}
+
 // print values(for debug use)
 void printValues(OpBuilder &builder, Location loc,
                  std::initializer_list<Value> values) {
@@ -251,286 +316,544 @@ void vector2DMemRefMultiply(OpBuilder &builder, Location loc, Value memRef1Real,
                             Value memRef2Imag, Value memRef3Real,
                             Value memRef3Imag, Value memRefNumRows,
                             Value memRefNumCols, Value c0, VectorType vecType) {
+  int64_t stride = vecType.getNumElements();
+  VectorType maskType = VectorType::get({stride}, builder.getI1Type());
+  Value zeroVec = builder.create<arith::ConstantOp>(
+      loc, vecType, builder.getZeroAttr(vecType));
+
   SmallVector<Value, 8> lowerBounds(2, c0);
   SmallVector<Value, 8> upperBounds{memRefNumRows, memRefNumCols};
-  SmallVector<int64_t, 8> steps(2, 1);
+  SmallVector<int64_t, 8> steps{1, stride};
 
   affine::buildAffineLoopNest(
       builder, loc, lowerBounds, upperBounds, steps,
       [&](OpBuilder &builder, Location loc, ValueRange ivs) {
-        Value pixelVal1Real = builder.create<vector::LoadOp>(
-            loc, vecType, memRef1Real, ValueRange{ivs[0], ivs[1]});
-        Value pixelVal1Imag = builder.create<vector::LoadOp>(
-            loc, vecType, memRef1Imag, ValueRange{ivs[0], ivs[1]});
-
-        Value pixelVal2Real = builder.create<vector::LoadOp>(
-            loc, vecType, memRef2Real, ValueRange{ivs[0], ivs[1]});
-        Value pixelVal2Imag = builder.create<vector::LoadOp>(
-            loc, vecType, memRef2Imag, ValueRange{ivs[0], ivs[1]});
+        // Mask the tail of the row.
+        Value remainder =
+            builder.create<arith::SubIOp>(loc, memRefNumCols, ivs[1]);
+        Value mask = builder.create<vector::CreateMaskOp>(
+            loc, maskType, ValueRange{remainder});
+
+        Value pixelVal1Real = builder.create<vector::MaskedLoadOp>(
+            loc, vecType, memRef1Real, ValueRange{ivs[0], ivs[1]}, mask,
+            zeroVec);
+        Value pixelVal1Imag = builder.create<vector::MaskedLoadOp>(
+            loc, vecType, memRef1Imag, ValueRange{ivs[0], ivs[1]}, mask,
+            zeroVec);
+
+        Value pixelVal2Real = builder.create<vector::MaskedLoadOp>(
+            loc, vecType, memRef2Real, ValueRange{ivs[0], ivs[1]}, mask,
+            zeroVec);
+        Value pixelVal2Imag = builder.create<vector::MaskedLoadOp>(
+            loc, vecType, memRef2Imag, ValueRange{ivs[0], ivs[1]}, mask,
+            zeroVec);
 
         std::vector<Value> resVecs =
             complexVecMulI(builder, loc, pixelVal1Real, pixelVal1Imag,
                            pixelVal2Real, pixelVal2Imag);
 
-        builder.create<vector::StoreOp>(loc, resVecs[0], memRef3Real,
-                                        ValueRange{ivs[0], ivs[1]});
-        builder.create<vector::StoreOp>(loc, resVecs[1], memRef3Imag,
-                                        ValueRange{ivs[0], ivs[1]});
+        builder.create<vector::MaskedStoreOp>(
+            loc, memRef3Real, ValueRange{ivs[0], ivs[1]}, mask, resVecs[0]);
+        builder.create<vector::MaskedStoreOp>(
+            loc, memRef3Imag, ValueRange{ivs[0], ivs[1]}, mask, resVecs[1]);
       });
 }
 
-// Function for implementing Cooley Tukey Butterfly algortihm for calculating
-// inverse of discrete Fourier transform of invidiual 1D components of 2D input
-// MemRef. Separate MemRefs for real and imaginary parts are expected.
-void idft1DCooleyTukeyButterfly(OpBuilder &builder, Location loc,
-                                Value memRefReal2D, Value memRefImag2D,
-                                Value memRefLength, Value strideVal,
-                                VectorType vecType, Value rowIndex, Value c0,
-                                Value c1, int64_t step) {
-  // Cooley Tukey Butterfly algorithm implementation.
-  Value subProbs = builder.create<arith::ShRSIOp>(loc, memRefLength, c1);
-  Value subProbSize, half = c1, i, jBegin, jEnd, j, angle;
-  Value wStepReal, wStepImag, wReal, wImag, tmp1Real, tmp1Imag, tmp2Real,
-      tmp2Imag;
-  Value wRealVec, wImagVec, wStepRealVec, wStepImagVec;
-  Value tmp2RealTemp, tmp2ImagTemp;
-
-  Value upperBound =
-      F32ToIndex(builder, loc,
-                 builder.create<math::Log2Op>(
-                     loc, indexToF32(builder, loc, memRefLength)));
-  Value pos2MPI = builder.create<arith::ConstantFloatOp>(
-      loc, (llvm::APFloat)(float)(2.0 * M_PI), builder.getF32Type());
+// Radices of the mixed-radix FFT, in the order the factorization tries them.
+static constexpr int64_t fftRadices[] = {4, 2, 3, 5};
+
+// Upper bound on the number of mixed-radix stages of a 32-bit length.
+static constexpr int64_t fftMaxStages = 32;
+
+// Function for factorizing `memRefLength` into the radices of the mixed-radix
+// FFT. The radices are stored in the 1D index MemRef `radices`; the number of
+// stages and the remaining factor are returned. The remaining factor is 1 iff
+// the length is of the form 2^a * 3^b * 5^c.
+std::pair<Value, Value> fftFactorize(OpBuilder &builder, Location loc,
+                                     Value memRefLength, Value radices,
+                                     Value c0, Value c1) {
+  Value remaining = memRefLength, numStages = c0;
+  for (int64_t radix : fftRadices) {
+    Value radixVal = builder.create<arith::ConstantIndexOp>(loc, radix);
+    auto whileOp = builder.create<scf::WhileOp>(
+        loc, TypeRange{builder.getIndexType(), builder.getIndexType()},
+        ValueRange{remaining, numStages},
+        [&](OpBuilder &builder, Location loc, ValueRange args) {
+          Value rem = builder.create<arith::RemUIOp>(loc, args[0], radixVal);
+          Value divisible = builder.create<arith::CmpIOp>(
+              loc, arith::CmpIPredicate::eq, rem, c0);
+          Value notDone = builder.create<arith::CmpIOp>(
+              loc, arith::CmpIPredicate::ugt, args[0], c1);
+          Value cond = builder.create<arith::AndIOp>(loc, divisible, notDone);
+          builder.create<scf::ConditionOp>(loc, cond, args);
+        },
+        [&](OpBuilder &builder, Location loc, ValueRange args) {
+          builder.create<memref::StoreOp>(loc, radixVal, radices,
+                                          ValueRange{args[1]});
+          Value quotient =
+              builder.create<arith::DivUIOp>(loc, args[0], radixVal);
+          Value nextStage = builder.create<arith::AddIOp>(loc, args[1], c1);
+          builder.create<scf::YieldOp>(loc, ValueRange{quotient, nextStage});
+        });
+    remaining = whileOp.getResult(0);
+    numStages = whileOp.getResult(1);
+  }
+  return {numStages, remaining};
+}
 
-  builder.create<scf::ForOp>(
-      loc, c0, upperBound, c1, ValueRange{subProbs, half},
-      [&](OpBuilder &builder, Location loc, ValueRange iv,
-          ValueRange outerIterVR) {
-        subProbSize = builder.create<arith::ShLIOp>(loc, outerIterVR[1], c1);
-        angle = builder.create<arith::DivFOp>(
-            loc, pos2MPI, indexToF32(builder, loc, subProbSize));
+// Function for calculating the `radix`-point DFT of the vectors in `real` and
+// `imag` in place. Radix 2 and 4 butterflies need no multiplication, other
+// radices use the O(radix^2) definition.
+static void fftButterfly(OpBuilder &builder, Location loc, int64_t radix,
+                         bool inverse, SmallVectorImpl<Value> &real,
+                         SmallVectorImpl<Value> &imag) {
+  if (radix == 2) {
+    std::vector<Value> sum =
+        complexVecAddI(builder, loc, real[0], imag[0], real[1], imag[1]);
+    std::vector<Value> diff =
+        complexVecSubI(builder, loc, real[0], imag[0], real[1], imag[1]);
+    real[0] = sum[0], imag[0] = sum[1];
+    real[1] = diff[0], imag[1] = diff[1];
+    return;
+  }
 
-        wStepReal = builder.create<math::CosOp>(loc, angle);
-        wStepRealVec =
-            builder.create<vector::BroadcastOp>(loc, vecType, wStepReal);
+  if (radix == 4) {
+    std::vector<Value> t0 =
+        complexVecAddI(builder, loc, real[0], imag[0], real[2], imag[2]);
+    std::vector<Value> t1 =
+        complexVecSubI(builder, loc, real[0], imag[0], real[2], imag[2]);
+    std::vector<Value> t2 =
+        complexVecAddI(builder, loc, real[1], imag[1], real[3], imag[3]);
+    std::vector<Value> t3 =
+        complexVecSubI(builder, loc, real[1], imag[1], real[3], imag[3]);
+    std::vector<Value> y0 =
+        complexVecAddI(builder, loc, t0[0], t0[1], t2[0], t2[1]);
+    std::vector<Value> y2 =
+        complexVecSubI(builder, loc, t0[0], t0[1], t2[0], t2[1]);
+    // Multiplying t3 by -i (forward) or i (inverse) swaps its components.
+    Value rotReal = t3[1], rotImag = t3[0];
+    if (inverse)
+      rotReal = builder.create<arith::NegFOp>(loc, t3[1]);
+    else
+      rotImag = builder.create<arith::NegFOp>(loc, t3[0]);
+    std::vector<Value> y1 =
+        complexVecAddI(builder, loc, t1[0], t1[1], rotReal, rotImag);
+    std::vector<Value> y3 =
+        complexVecSubI(builder, loc, t1[0], t1[1], rotReal, rotImag);
+    real[0] = y0[0], imag[0] = y0[1];
+    real[1] = y1[0], imag[1] = y1[1];
+    real[2] = y2[0], imag[2] = y2[1];
+    real[3] = y3[0], imag[3] = y3[1];
+    return;
+  }
 
-        wStepImag = builder.create<math::SinOp>(loc, angle);
-        wStepImagVec =
-            builder.create<vector::BroadcastOp>(loc, vecType, wStepImag);
+  VectorType vecType = real[0].getType().cast<VectorType>();
+  double sign = inverse ? 1.0 : -1.0;
+  SmallVector<Value, 5> resReal, resImag;
+  for (int64_t k = 0; k < radix; ++k) {
+    Value accReal = real[0], accImag = imag[0];
+    for (int64_t n = 1; n < radix; ++n) {
+      double angle = sign * 2.0 * M_PI * ((k * n) % radix) / radix;
+      Value cosVal = builder.create<arith::ConstantFloatOp>(
+          loc, (llvm::APFloat)(float)std::cos(angle), builder.getF32Type());
+      Value sinVal = builder.create<arith::ConstantFloatOp>(
+          loc, (llvm::APFloat)(float)std::sin(angle), builder.getF32Type());
+      Value wReal = builder.create<vector::SplatOp>(loc, vecType, cosVal);
+      Value wImag = builder.create<vector::SplatOp>(loc, vecType, sinVal);
+      std::vector<Value> prod =
+          complexVecMulI(builder, loc, real[n], imag[n], wReal, wImag);
+      std::vector<Value> acc =
+          complexVecAddI(builder, loc, accReal, accImag, prod[0], prod[1]);
+      accReal = acc[0], accImag = acc[1];
+    }
+    resReal.push_back(accReal);
+    resImag.push_back(accImag);
+  }
+  real.assign(resReal.begin(), resReal.end());
+  imag.assign(resImag.begin(), resImag.end());
+}
+
+// Function for emitting one stage of the mixed-radix FFT on a row of 2D
+// MemRefs. The row is split into blocks of `blockSize` elements; element
+// j + k * (blockSize / radix) of a block is the k-th input of its j-th
+// butterfly, so consecutive butterflies are processed as one vector. Forward
+// stages apply the twiddle factors after the butterfly (decimation in
+// frequency), inverse stages undo a forward stage in the opposite order.
+static void fftRadixStage(OpBuilder &builder, Location loc,
+                          Value memRefReal2D, Value memRefImag2D,
+                          Value rowIndex, Value memRefLength, Value blockSize,
+                          int64_t radix, bool inverse, VectorType vecType,
+                          Value c0, Value c1) {
+  int64_t stride = vecType.getNumElements();
+  Value strideVal = builder.create<arith::ConstantIndexOp>(loc, stride);
+  Value radixVal = builder.create<arith::ConstantIndexOp>(loc, radix);
+  Value span = builder.create<arith::DivUIOp>(loc, blockSize, radixVal);
+  Value numBlocks =
+      builder.create<arith::DivUIOp>(loc, memRefLength, blockSize);
+
+  VectorType maskType = VectorType::get({stride}, builder.getI1Type());
+  Value zeroVec = builder.create<arith::ConstantOp>(
+      loc, vecType, builder.getZeroAttr(vecType));
+  Value iota = iotaVec0F32(builder, loc, stride);
+  Value twoPI = builder.create<arith::ConstantFloatOp>(
+      loc, (llvm::APFloat)(float)((inverse ? 2.0 : -2.0) * M_PI),
+      builder.getF32Type());
+  Value angleStep = builder.create<arith::DivFOp>(
+      loc, twoPI, indexToF32(builder, loc, blockSize));
+  Value angleStepVec = builder.create<vector::SplatOp>(loc, vecType, angleStep);
+
+  builder.create<scf::ForOp>(
+      loc, c0, numBlocks, c1, ValueRange{},
+      [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange) {
+        Value blockBase = builder.create<arith::MulIOp>(loc, iv[0], blockSize);
 
         builder.create<scf::ForOp>(
-            loc, c0, outerIterVR[0], c1, ValueRange{},
+            loc, c0, span, strideVal, ValueRange{},
             [&](OpBuilder &builder, Location loc, ValueRange iv1, ValueRange) {
-              jBegin = builder.create<arith::MulIOp>(loc, iv1[0], subProbSize);
-              jEnd = builder.create<arith::AddIOp>(loc, jBegin, outerIterVR[1]);
-              wReal = builder.create<arith::ConstantFloatOp>(
-                  loc, (llvm::APFloat)1.0f, builder.getF32Type());
-              wImag = builder.create<arith::ConstantFloatOp>(
-                  loc, (llvm::APFloat)0.0f, builder.getF32Type());
-
-              wRealVec =
-                  builder.create<vector::BroadcastOp>(loc, vecType, wReal);
-              wImagVec =
-                  builder.create<vector::BroadcastOp>(loc, vecType, wImag);
-
-              // Vectorize stuff inside this loop (take care of tail processing
-              // as well)
-              builder.create<scf::ForOp>(
-                  loc, jBegin, jEnd, strideVal, ValueRange{wRealVec, wImagVec},
-                  [&](OpBuilder &builder, Location loc, ValueRange iv2,
-                      ValueRange wVR) {
-                    tmp1Real = builder.create<vector::LoadOp>(
-                        loc, vecType, memRefReal2D,
-                        ValueRange{rowIndex, iv2[0]});
-                    tmp1Imag = builder.create<vector::LoadOp>(
-                        loc, vecType, memRefImag2D,
-                        ValueRange{rowIndex, iv2[0]});
-
-                    Value secondIndex = builder.create<arith::AddIOp>(
-                        loc, iv2[0], outerIterVR[1]);
-                    tmp2RealTemp = builder.create<vector::LoadOp>(
-                        loc, vecType, memRefReal2D,
-                        ValueRange{rowIndex, secondIndex});
-                    tmp2ImagTemp = builder.create<vector::LoadOp>(
-                        loc, vecType, memRefImag2D,
-                        ValueRange{rowIndex, secondIndex});
-
-                    std::vector<Value> tmp2Vec =
-                        complexVecMulI(builder, loc, tmp2RealTemp, tmp2ImagTemp,
-                                       wVR[0], wVR[1]);
-
-                    std::vector<Value> int1Vec =
-                        complexVecAddI(builder, loc, tmp1Real, tmp1Imag,
-                                       tmp2Vec[0], tmp2Vec[1]);
-                    builder.create<vector::StoreOp>(
-                        loc, int1Vec[0], memRefReal2D,
-                        ValueRange{rowIndex, iv2[0]});
-                    builder.create<vector::StoreOp>(
-                        loc, int1Vec[1], memRefImag2D,
-                        ValueRange{rowIndex, iv2[0]});
-
-                    std::vector<Value> int2Vec =
-                        complexVecSubI(builder, loc, tmp1Real, tmp1Imag,
-                                       tmp2Vec[0], tmp2Vec[1]);
-                    builder.create<vector::StoreOp>(
-                        loc, int2Vec[0], memRefReal2D,
-                        ValueRange{rowIndex, secondIndex});
-                    builder.create<vector::StoreOp>(
-                        loc, int2Vec[1], memRefImag2D,
-                        ValueRange{rowIndex, secondIndex});
-
-                    std::vector<Value> wUpdate =
-                        complexVecMulI(builder, loc, wVR[0], wVR[1],
-                                       wStepRealVec, wStepImagVec);
-
-                    builder.create<scf::YieldOp>(
-                        loc, ValueRange{wUpdate[0], wUpdate[1]});
-                  });
+              Value remainder =
+                  builder.create<arith::SubIOp>(loc, span, iv1[0]);
+              Value mask = builder.create<vector::CreateMaskOp>(
+                  loc, maskType, ValueRange{remainder});
+              Value base =
+                  builder.create<arith::AddIOp>(loc, blockBase, iv1[0]);
+
+              SmallVector<Value, 5> indices, real, imag;
+              for (int64_t k = 0; k < radix; ++k) {
+                Value offset = builder.create<arith::MulIOp>(
+                    loc, builder.create<arith::ConstantIndexOp>(loc, k), span);
+                indices.push_back(
+                    builder.create<arith::AddIOp>(loc, base, offset));
+                real.push_back(builder.create<vector::MaskedLoadOp>(
+                    loc, vecType, memRefReal2D,
+                    ValueRange{rowIndex, indices[k]}, mask, zeroVec));
+                imag.push_back(builder.create<vector::MaskedLoadOp>(
+                    loc, vecType, memRefImag2D,
+                    ValueRange{rowIndex, indices[k]}, mask, zeroVec));
+              }
+
+              // Twiddle factor of butterfly j is w^k with w = exp(-+2*pi*i *
+              // j / blockSize); its powers are built by repeated products.
+              Value jVec = builder.create<arith::AddFOp>(
+                  loc, castAndExpand(builder, loc, iv1[0], vecType), iota);
+              Value angle =
+                  builder.create<arith::MulFOp>(loc, jVec, angleStepVec);
+              Value wReal = builder.create<math::CosOp>(loc, angle);
+              Value wImag = builder.create<math::SinOp>(loc, angle);
+              auto applyTwiddles = [&]() {
+                Value wkReal = wReal, wkImag = wImag;
+                for (int64_t k = 1; k < radix; ++k) {
+                  std::vector<Value> prod = complexVecMulI(
+                      builder, loc, real[k], imag[k], wkReal, wkImag);
+                  real[k] = prod[0], imag[k] = prod[1];
+                  if (k + 1 < radix) {
+                    std::vector<Value> next = complexVecMulI(
+                        builder, loc, wkReal, wkImag, wReal, wImag);
+                    wkReal = next[0], wkImag = next[1];
+                  }
+                }
+              };
+
+              if (inverse) {
+                applyTwiddles();
+                fftButterfly(builder, loc, radix, inverse, real, imag);
+              } else {
+                fftButterfly(builder, loc, radix, inverse, real, imag);
+                applyTwiddles();
+              }
+
+              for (int64_t k = 0; k < radix; ++k) {
+                builder.create<vector::MaskedStoreOp>(
+                    loc, memRefReal2D, ValueRange{rowIndex, indices[k]}, mask,
+                    real[k]);
+                builder.create<vector::MaskedStoreOp>(
+                    loc, memRefImag2D, ValueRange{rowIndex, indices[k]}, mask,
+                    imag[k]);
+              }
 
               builder.create<scf::YieldOp>(loc);
             });
-        Value updatedSubProbs =
-            builder.create<arith::ShRSIOp>(loc, outerIterVR[0], c1);
 
-        builder.create<scf::YieldOp>(loc,
-                                     ValueRange{updatedSubProbs, subProbSize});
+        builder.create<scf::YieldOp>(loc);
+      });
+}
+
+// Function for implementing the mixed-radix (2, 3, 4, 5) FFT of a row of 2D
+// MemRefs, using the radices computed by `fftFactorize`. The forward
+// transform leaves the spectrum in digit-reversed order, which is the order
+// consumed by the inverse transform; the inverse transform also scales the
+// result by 1 / length. Separate MemRefs for real and imaginary parts are
+// expected.
+void fft1DMixedRadix(OpBuilder &builder, Location loc, Value memRefReal2D,
+                     Value memRefImag2D, Value memRefLength, Value radices,
+                     Value numStages, VectorType vecType, Value rowIndex,
+                     Value c0, Value c1, bool inverse) {
+  // Emits the stage whose radix is only known at runtime.
+  auto emitStage = [&](OpBuilder &builder, Location loc, Value radix,
+                       Value blockSize) {
+    for (int64_t candidate : fftRadices) {
+      Value isCandidate = builder.create<arith::CmpIOp>(
+          loc, arith::CmpIPredicate::eq, radix,
+          builder.create<arith::ConstantIndexOp>(loc, candidate));
+      builder.create<scf::IfOp>(
+          loc, isCandidate, [&](OpBuilder &builder, Location loc) {
+            fftRadixStage(builder, loc, memRefReal2D, memRefImag2D, rowIndex,
+                          memRefLength, blockSize, candidate, inverse, vecType,
+                          c0, c1);
+            builder.create<scf::YieldOp>(loc);
+          });
+    }
+  };
+
+  if (!inverse) {
+    // Stage s works on blocks of length / (r_0 * ... * r_{s-1}) elements.
+    builder.create<scf::ForOp>(
+        loc, c0, numStages, c1, ValueRange{memRefLength},
+        [&](OpBuilder &builder, Location loc, ValueRange iv,
+            ValueRange blockSize) {
+          Value radix = builder.create<memref::LoadOp>(loc, radices, iv[0]);
+          emitStage(builder, loc, radix, blockSize[0]);
+          Value nextBlockSize =
+              builder.create<arith::DivUIOp>(loc, blockSize[0], radix);
+          builder.create<scf::YieldOp>(loc, nextBlockSize);
+        });
+    return;
+  }
+
+  // Undo the forward stages from the last one to the first one.
+  Value lastStage = builder.create<arith::SubIOp>(loc, numStages, c1);
+  builder.create<scf::ForOp>(
+      loc, c0, numStages, c1, ValueRange{c1},
+      [&](OpBuilder &builder, Location loc, ValueRange iv,
+          ValueRange blockSize) {
+        Value stage = builder.create<arith::SubIOp>(loc, lastStage, iv[0]);
+        Value radix = builder.create<memref::LoadOp>(loc, radices, stage);
+        Value curBlockSize =
+            builder.create<arith::MulIOp>(loc, blockSize[0], radix);
+        emitStage(builder, loc, radix, curBlockSize);
+        builder.create<scf::YieldOp>(loc, curBlockSize);
       });
 
-  Value memRefLengthVec = builder.create<vector::BroadcastOp>(
-      loc, vecType, indexToF32(builder, loc, memRefLength));
+  int64_t stride = vecType.getNumElements();
+  Value strideVal = builder.create<arith::ConstantIndexOp>(loc, stride);
+  VectorType maskType = VectorType::get({stride}, builder.getI1Type());
+  Value zeroVec = builder.create<arith::ConstantOp>(
+      loc, vecType, builder.getZeroAttr(vecType));
+  Value memRefLengthVec = castAndExpand(builder, loc, memRefLength, vecType);
 
   builder.create<scf::ForOp>(
       loc, c0, memRefLength, strideVal, ValueRange{},
       [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange) {
-        Value tempVecReal = builder.create<vector::LoadOp>(
-            loc, vecType, memRefReal2D, ValueRange{rowIndex, iv[0]});
-        Value tempResVecReal =
-            builder.create<arith::DivFOp>(loc, tempVecReal, memRefLengthVec);
-        builder.create<vector::StoreOp>(loc, tempResVecReal, memRefReal2D,
-                                        ValueRange{rowIndex, iv[0]});
-
-        Value tempVecImag = builder.create<vector::LoadOp>(
-            loc, vecType, memRefImag2D, ValueRange{rowIndex, iv[0]});
-        Value tempResVecImag =
-            builder.create<arith::DivFOp>(loc, tempVecImag, memRefLengthVec);
-        builder.create<vector::StoreOp>(loc, tempResVecImag, memRefImag2D,
-                                        ValueRange{rowIndex, iv[0]});
-
+        Value remainder =
+            builder.create<arith::SubIOp>(loc, memRefLength, iv[0]);
+        Value mask = builder.create<vector::CreateMaskOp>(
+            loc, maskType, ValueRange{remainder});
+        for (Value memRef : {memRefReal2D, memRefImag2D}) {
+          Value vec = builder.create<vector::MaskedLoadOp>(
+              loc, vecType, memRef, ValueRange{rowIndex, iv[0]}, mask, zeroVec);
+          Value res = builder.create<arith::DivFOp>(loc, vec, memRefLengthVec);
+          builder.create<vector::MaskedStoreOp>(
+              loc, memRef, ValueRange{rowIndex, iv[0]}, mask, res);
+        }
         builder.create<scf::YieldOp>(loc);
       });
 }
 
-// Function for implementing Gentleman Sande Butterfly algortihm for calculating
-// discrete Fourier transform of invidiual 1D components of 2D input MemRef.
-// Separate MemRefs for real and imaginary parts are expected.
-void dft1DGentlemanSandeButterfly(OpBuilder &builder, Location loc,
-                                  Value memRefReal2D, Value memRefImag2D,
-                                  Value memRefLength, Value strideVal,
-                                  VectorType vecType, Value rowIndex, Value c0,
-                                  Value c1, int64_t step) {
-  // Gentleman Sande Butterfly algorithm implementation.
-  Value subProbs = c1, subProbSize = memRefLength, i, jBegin, jEnd, j, half,
-        angle;
-  Value wStepReal, wStepImag, wReal, wImag, tmp1Real, tmp1Imag, tmp2Real,
-      tmp2Imag;
-  Value wRealVec, wImagVec, wStepRealVec, wStepImagVec;
-
-  Value upperBound =
-      F32ToIndex(builder, loc,
-                 builder.create<math::Log2Op>(
-                     loc, indexToF32(builder, loc, memRefLength)));
-  Value neg2MPI = builder.create<arith::ConstantFloatOp>(
-      loc, (llvm::APFloat)(float)(-2.0 * M_PI), builder.getF32Type());
+// Function for implementing Bluestein's algorithm for the DFT of every row of
+// 2D MemRefs whose length has prime factors other than 2, 3 and 5. The DFT is
+// rewritten as a circular convolution with the chirp exp(-+i * pi * n^2 / N),
+// evaluated with power-of-two mixed-radix transforms of length >= 2N - 1.
+// Unlike the mixed-radix path, the spectrum is in natural order. Separate
+// MemRefs for real and imaginary parts are expected.
+void fft1DBluestein(OpBuilder &builder, Location loc, Value memRefReal2D,
+                    Value memRefImag2D, Value memRefNumRows,
+                    Value memRefLength, VectorType vecType, Value c0, Value c1,
+                    bool inverse) {
+  Type f32 = builder.getF32Type();
+  Value zero = builder.create<arith::ConstantFloatOp>(
+      loc, (llvm::APFloat)0.0f, builder.getF32Type());
+
+  // Convolution length: the smallest power of two >= 2N - 1.
+  Value twoLength = builder.create<arith::ShLIOp>(loc, memRefLength, c1);
+  Value minConvLength = builder.create<arith::SubIOp>(loc, twoLength, c1);
+  auto whileOp = builder.create<scf::WhileOp>(
+      loc, TypeRange{builder.getIndexType()}, ValueRange{c1},
+      [&](OpBuilder &builder, Location loc, ValueRange args) {
+        Value cond = builder.create<arith::CmpIOp>(
+            loc, arith::CmpIPredicate::ult, args[0], minConvLength);
+        builder.create<scf::ConditionOp>(loc, cond, args);
+      },
+      [&](OpBuilder &builder, Location loc, ValueRange args) {
+        Value doubled = builder.create<arith::ShLIOp>(loc, args[0], c1);
+        builder.create<scf::YieldOp>(loc, doubled);
+      });
+  Value convLength = whileOp.getResult(0);
+
+  Value radices = builder.create<memref::AllocaOp>(
+      loc, MemRefType::get({fftMaxStages}, builder.getIndexType()));
+  Value numStages =
+      fftFactorize(builder, loc, convLength, radices, c0, c1).first;
+
+  MemRefType chirpType = MemRefType::get({ShapedType::kDynamic}, f32);
+  MemRefType convType = MemRefType::get({1, ShapedType::kDynamic}, f32);
+  Value chirpReal =
+      builder.create<memref::AllocOp>(loc, chirpType, memRefLength);
+  Value chirpImag =
+      builder.create<memref::AllocOp>(loc, chirpType, memRefLength);
+  Value filterReal = builder.create<memref::AllocOp>(loc, convType, convLength);
+  Value filterImag = builder.create<memref::AllocOp>(loc, convType, convLength);
+  Value workReal = builder.create<memref::AllocOp>(loc, convType, convLength);
+  Value workImag = builder.create<memref::AllocOp>(loc, convType, convLength);
+
+  auto fillZero = [&](OpBuilder &builder, Location loc, Value real,
+                      Value imag) {
+    builder.create<scf::ForOp>(
+        loc, c0, convLength, c1, ValueRange{},
+        [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange) {
+          builder.create<memref::StoreOp>(loc, zero, real,
+                                          ValueRange{c0, iv[0]});
+          builder.create<memref::StoreOp>(loc, zero, imag,
+                                          ValueRange{c0, iv[0]});
+          builder.create<scf::YieldOp>(loc);
+        });
+  };
+
+  // Chirp; n^2 is reduced modulo 2N to keep the angle accurate.
+  Value piVal = builder.create<arith::ConstantFloatOp>(
+      loc, (llvm::APFloat)(float)(inverse ? M_PI : -M_PI), f32);
+  Value angleStep = builder.create<arith::DivFOp>(
+      loc, piVal, indexToF32(builder, loc, memRefLength));
+  builder.create<scf::ForOp>(
+      loc, c0, memRefLength, c1, ValueRange{},
+      [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange) {
+        Value square = builder.create<arith::MulIOp>(loc, iv[0], iv[0]);
+        Value phase = builder.create<arith::RemUIOp>(loc, square, twoLength);
+        Value angle = builder.create<arith::MulFOp>(
+            loc, indexToF32(builder, loc, phase), angleStep);
+        builder.create<memref::StoreOp>(
+            loc, builder.create<math::CosOp>(loc, angle), chirpReal, iv[0]);
+        builder.create<memref::StoreOp>(
+            loc, builder.create<math::SinOp>(loc, angle), chirpImag, iv[0]);
+        builder.create<scf::YieldOp>(loc);
+      });
 
+  // Filter: the conjugate chirp at offsets n and -n, transformed once.
+  fillZero(builder, loc, filterReal, filterImag);
   builder.create<scf::ForOp>(
-      loc, c0, upperBound, c1, ValueRange{subProbs, subProbSize},
-      [&](OpBuilder &builder, Location loc, ValueRange iv,
-          ValueRange outerIterVR) {
-        half = builder.create<arith::ShRSIOp>(loc, outerIterVR[1], c1);
-        angle = builder.create<arith::DivFOp>(
-            loc, neg2MPI, indexToF32(builder, loc, outerIterVR[1]));
+      loc, c0, memRefLength, c1, ValueRange{},
+      [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange) {
+        Value wReal = builder.create<memref::LoadOp>(loc, chirpReal, iv[0]);
+        Value wImag = builder.create<arith::NegFOp>(
+            loc, builder.create<memref::LoadOp>(loc, chirpImag, iv[0]));
+        Value mirror = builder.create<arith::RemUIOp>(
+            loc, builder.create<arith::SubIOp>(loc, convLength, iv[0]),
+            convLength);
+        for (Value index : {iv[0], mirror}) {
+          builder.create<memref::StoreOp>(loc, wReal, filterReal,
+                                          ValueRange{c0, index});
+          builder.create<memref::StoreOp>(loc, wImag, filterImag,
+                                          ValueRange{c0, index});
+        }
+        builder.create<scf::YieldOp>(loc);
+      });
+  fft1DMixedRadix(builder, loc, filterReal, filterImag, convLength, radices,
+                  numStages, vecType, c0, c0, c1, /*inverse=*/false);
 
-        wStepReal = builder.create<math::CosOp>(loc, angle);
-        wStepRealVec =
-            builder.create<vector::BroadcastOp>(loc, vecType, wStepReal);
+  Value lengthF32 = indexToF32(builder, loc, memRefLength);
+  builder.create<scf::ForOp>(
+      loc, c0, memRefNumRows, c1, ValueRange{},
+      [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange) {
+        Value row = iv[0];
+        fillZero(builder, loc, workReal, workImag);
+        builder.create<scf::ForOp>(
+            loc, c0, memRefLength, c1, ValueRange{},
+            [&](OpBuilder &builder, Location loc, ValueRange iv1, ValueRange) {
+              std::vector<Value> prod = complexVecMulI(
+                  builder, loc,
+                  builder.create<memref::LoadOp>(loc, memRefReal2D,
+                                                 ValueRange{row, iv1[0]}),
+                  builder.create<memref::LoadOp>(loc, memRefImag2D,
+                                                 ValueRange{row, iv1[0]}),
+                  builder.create<memref::LoadOp>(loc, chirpReal, iv1[0]),
+                  builder.create<memref::LoadOp>(loc, chirpImag, iv1[0]));
+              builder.create<memref::StoreOp>(loc, prod[0], workReal,
+                                              ValueRange{c0, iv1[0]});
+              builder.create<memref::StoreOp>(loc, prod[1], workImag,
+                                              ValueRange{c0, iv1[0]});
+              builder.create<scf::YieldOp>(loc);
+            });
 
-        wStepImag = builder.create<math::SinOp>(loc, angle);
-        wStepImagVec =
-            builder.create<vector::BroadcastOp>(loc, vecType, wStepImag);
+        fft1DMixedRadix(builder, loc, workReal, workImag, convLength, radices,
+                        numStages, vecType, c0, c0, c1, /*inverse=*/false);
+        vector2DMemRefMultiply(builder, loc, workReal, workImag, filterReal,
+                               filterImag, workReal, workImag, c1, convLength,
+                               c0, vecType);
+        fft1DMixedRadix(builder, loc, workReal, workImag, convLength, radices,
+                        numStages, vecType, c0, c0, c1, /*inverse=*/true);
 
         builder.create<scf::ForOp>(
-            loc, c0, outerIterVR[0], c1, ValueRange{},
+            loc, c0, memRefLength, c1, ValueRange{},
             [&](OpBuilder &builder, Location loc, ValueRange iv1, ValueRange) {
-              jBegin =
-                  builder.create<arith::MulIOp>(loc, iv1[0], outerIterVR[1]);
-              jEnd = builder.create<arith::AddIOp>(loc, jBegin, half);
-              wReal = builder.create<arith::ConstantFloatOp>(
-                  loc, (llvm::APFloat)1.0f, builder.getF32Type());
-              wImag = builder.create<arith::ConstantFloatOp>(
-                  loc, (llvm::APFloat)0.0f, builder.getF32Type());
-
-              wRealVec =
-                  builder.create<vector::BroadcastOp>(loc, vecType, wReal);
-              wImagVec =
-                  builder.create<vector::BroadcastOp>(loc, vecType, wImag);
-
-              // Vectorize stuff inside this loop (take care of tail processing
-              // as well)
-              builder.create<scf::ForOp>(
-                  loc, jBegin, jEnd, strideVal, ValueRange{wRealVec, wImagVec},
-                  [&](OpBuilder &builder, Location loc, ValueRange iv2,
-                      ValueRange wVR) {
-                    tmp1Real = builder.create<vector::LoadOp>(
-                        loc, vecType, memRefReal2D,
-                        ValueRange{rowIndex, iv2[0]});
-                    tmp1Imag = builder.create<vector::LoadOp>(
-                        loc, vecType, memRefImag2D,
-                        ValueRange{rowIndex, iv2[0]});
-
-                    Value secondIndex =
-                        builder.create<arith::AddIOp>(loc, iv2[0], half);
-                    tmp2Real = builder.create<vector::LoadOp>(
-                        loc, vecType, memRefReal2D,
-                        ValueRange{rowIndex, secondIndex});
-                    tmp2Imag = builder.create<vector::LoadOp>(
-                        loc, vecType, memRefImag2D,
-                        ValueRange{rowIndex, secondIndex});
-
-                    std::vector<Value> int1Vec = complexVecAddI(
-                        builder, loc, tmp1Real, tmp1Imag, tmp2Real, tmp2Imag);
-                    builder.create<vector::StoreOp>(
-                        loc, int1Vec[0], memRefReal2D,
-                        ValueRange{rowIndex, iv2[0]});
-                    builder.create<vector::StoreOp>(
-                        loc, int1Vec[1], memRefImag2D,
-                        ValueRange{rowIndex, iv2[0]});
-
-                    std::vector<Value> int2Vec = complexVecSubI(
-                        builder, loc, tmp1Real, tmp1Imag, tmp2Real, tmp2Imag);
-                    std::vector<Value> int3Vec = complexVecMulI(
-                        builder, loc, int2Vec[0], int2Vec[1], wVR[0], wVR[1]);
-
-                    builder.create<vector::StoreOp>(
-                        loc, int3Vec[0], memRefReal2D,
-                        ValueRange{rowIndex, secondIndex});
-                    builder.create<vector::StoreOp>(
-                        loc, int3Vec[1], memRefImag2D,
-                        ValueRange{rowIndex, secondIndex});
-
-                    std::vector<Value> wUpdate =
-                        complexVecMulI(builder, loc, wVR[0], wVR[1],
-                                       wStepRealVec, wStepImagVec);
-
-                    builder.create<scf::YieldOp>(
-                        loc, ValueRange{wUpdate[0], wUpdate[1]});
-                  });
-
+              std::vector<Value> prod = complexVecMulI(
+                  builder, loc,
+                  builder.create<memref::LoadOp>(loc, workReal,
+                                                 ValueRange{c0, iv1[0]}),
+                  builder.create<memref::LoadOp>(loc, workImag,
+                                                 ValueRange{c0, iv1[0]}),
+                  builder.create<memref::LoadOp>(loc, chirpReal, iv1[0]),
+                  builder.create<memref::LoadOp>(loc, chirpImag, iv1[0]));
+              if (inverse) {
+                prod[0] =
+                    builder.create<arith::DivFOp>(loc, prod[0], lengthF32);
+                prod[1] =
+                    builder.create<arith::DivFOp>(loc, prod[1], lengthF32);
+              }
+              builder.create<memref::StoreOp>(loc, prod[0], memRefReal2D,
+                                              ValueRange{row, iv1[0]});
+              builder.create<memref::StoreOp>(loc, prod[1], memRefImag2D,
+                                              ValueRange{row, iv1[0]});
               builder.create<scf::YieldOp>(loc);
             });
-        Value updatedSubProbs =
-            builder.create<arith::ShLIOp>(loc, outerIterVR[0], c1);
 
-        builder.create<scf::YieldOp>(loc, ValueRange{updatedSubProbs, half});
+        builder.create<scf::YieldOp>(loc);
+      });
+
+  for (Value buffer : {chirpReal, chirpImag, filterReal, filterImag, workReal,
+                       workImag})
+    builder.create<memref::DeallocOp>(loc, buffer);
+}
+
+// Function for calculating the DFT (or its inverse) of every row of 2D
+// MemRefs. Rows whose length is 2^a * 3^b * 5^c use the mixed-radix FFT, other
+// lengths fall back to Bluestein's algorithm. Separate MemRefs for real and
+// imaginary parts are expected.
+void fft1DRows(OpBuilder &builder, Location loc, Value memRefReal2D,
+               Value memRefImag2D, Value memRefNumRows, Value memRefLength,
+               VectorType vecType, Value c0, Value c1, bool inverse) {
+  Value radices = builder.create<memref::AllocaOp>(
+      loc, MemRefType::get({fftMaxStages}, builder.getIndexType()));
+  Value numStages, remaining;
+  std::tie(numStages, remaining) =
+      fftFactorize(builder, loc, memRefLength, radices, c0, c1);
+  Value isSmooth = builder.create<arith::CmpIOp>(
+      loc, arith::CmpIPredicate::ule, remaining, c1);
+
+  builder.create<scf::IfOp>(
+      loc, isSmooth,
+      [&](OpBuilder &builder, Location loc) {
+        builder.create<scf::ForOp>(
+            loc, c0, memRefNumRows, c1, ValueRange{},
+            [&](OpBuilder &builder, Location loc, ValueRange iv, ValueRange) {
+              fft1DMixedRadix(builder, loc, memRefReal2D, memRefImag2D,
+                              memRefLength, radices, numStages, vecType, iv[0],
+                              c0, c1, inverse);
+              builder.create<scf::YieldOp>(loc);
+            });
+        builder.create<scf::YieldOp>(loc);
+      },
+      [&](OpBuilder &builder, Location loc) {
+        fft1DBluestein(builder, loc, memRefReal2D, memRefImag2D, memRefNumRows,
+                       memRefLength, vecType, c0, c1, inverse);
+        builder.create<scf::YieldOp>(loc);
       });
 }
 
@@ -539,18 +862,9 @@ void dft1DGentlemanSandeButterfly(OpBuilder &builder, Location loc,
 void idft2D(OpBuilder &builder, Location loc, Value container2DReal,
             Value container2DImag, Value container2DRows, Value container2DCols,
             Value intermediateReal, Value intermediateImag, Value c0, Value c1,
-            Value strideVal, VectorType vecType) {
-  builder.create<affine::AffineForOp>(
-      loc, ValueRange{c0}, builder.getDimIdentityMap(),
-      ValueRange{container2DRows}, builder.getDimIdentityMap(), 1, std::nullopt,
-      [&](OpBuilder &nestedBuilder, Location nestedLoc, Value iv,
-          ValueRange itrArg) {
-        idft1DCooleyTukeyButterfly(builder, loc, container2DReal,
-                                   container2DImag, container2DCols, strideVal,
-                                   vecType, iv, c0, c1, 1);
-
-        nestedBuilder.create<affine::AffineYieldOp>(nestedLoc);
-      });
+            VectorType vecType) {
+  fft1DRows(builder, loc, container2DReal, container2DImag, container2DRows,
+            container2DCols, vecType, c0, c1, /*inverse=*/true);
 
   scalar2DMemRefTranspose(builder, loc, container2DReal, intermediateReal,
                           container2DRows, container2DCols, container2DCols,
@@ -559,17 +873,8 @@ void idft2D(OpBuilder &builder, Location loc, Value container2DReal,
                           container2DRows, container2DCols, container2DCols,
                           container2DRows, c0);
 
-  builder.create<affine::AffineForOp>(
-      loc, ValueRange{c0}, builder.getDimIdentityMap(),
-      ValueRange{container2DCols}, builder.getDimIdentityMap(), 1, std::nullopt,
-      [&](OpBuilder &nestedBuilder, Location nestedLoc, Value iv,
-          ValueRange itrArg) {
-        idft1DCooleyTukeyButterfly(builder, loc, intermediateReal,
-                                   intermediateImag, container2DRows, strideVal,
-                                   vecType, iv, c0, c1, 1);
-
-        nestedBuilder.create<affine::AffineYieldOp>(nestedLoc);
-      });
+  fft1DRows(builder, loc, intermediateReal, intermediateImag, container2DCols,
+            container2DRows, vecType, c0, c1, /*inverse=*/true);
 
   Value transposeCond = builder.create<arith::CmpIOp>(
       loc, arith::CmpIPredicate::ne, container2DRows, container2DCols);
@@ -598,18 +903,9 @@ void idft2D(OpBuilder &builder, Location loc, Value container2DReal,
 void dft2D(OpBuilder &builder, Location loc, Value container2DReal,
            Value container2DImag, Value container2DRows, Value container2DCols,
            Value intermediateReal, Value intermediateImag, Value c0, Value c1,
-           Value strideVal, VectorType vecType) {
-  builder.create<affine::AffineForOp>(
-      loc, ValueRange{c0}, builder.getDimIdentityMap(),
-      ValueRange{container2DRows}, builder.getDimIdentityMap(), 1, std::nullopt,
-      [&](OpBuilder &nestedBuilder, Location nestedLoc, Value iv,
-          ValueRange itrArg) {
-        dft1DGentlemanSandeButterfly(builder, loc, container2DReal,
-                                     container2DImag, container2DCols,
-                                     strideVal, vecType, iv, c0, c1, 1);
-
-        nestedBuilder.create<affine::AffineYieldOp>(nestedLoc);
-      });
+           VectorType vecType) {
+  fft1DRows(builder, loc, container2DReal, container2DImag, container2DRows,
+            container2DCols, vecType, c0, c1, /*inverse=*/false);
 
   scalar2DMemRefTranspose(builder, loc, container2DReal, intermediateReal,
                           container2DRows, container2DCols, container2DCols,
@@ -618,17 +914,8 @@ void dft2D(OpBuilder &builder, Location loc, Value container2DReal,
                           container2DRows, container2DCols, container2DCols,
                           container2DRows, c0);
 
-  builder.create<affine::AffineForOp>(
-      loc, ValueRange{c0}, builder.getDimIdentityMap(),
-      ValueRange{container2DCols}, builder.getDimIdentityMap(), 1, std::nullopt,
-      [&](OpBuilder &nestedBuilder, Location nestedLoc, Value iv,
-          ValueRange itrArg) {
-        dft1DGentlemanSandeButterfly(builder, loc, intermediateReal,
-                                     intermediateImag, container2DRows,
-                                     strideVal, vecType, iv, c0, c1, 1);
-
-        nestedBuilder.create<affine::AffineYieldOp>(nestedLoc);
-      });
+  fft1DRows(builder, loc, intermediateReal, intermediateImag, container2DCols,
+            container2DRows, vecType, c0, c1, /*inverse=*/false);
 
   Value transposeCond = builder.create<arith::CmpIOp>(
       loc, arith::CmpIPredicate::ne, container2DRows, container2DCols);
@@ -0,0 +1,358 @@
+// RUN: buddy-opt %s \
+// RUN:     -conv-optimize="vec-size=4 channel-block=2 width-block=3" \
+// RUN:     -convert-linalg-to-loops -convert-vector-to-scf -expand-strided-metadata \
+// RUN:     -lower-affine -convert-scf-to-cf -convert-vector-to-llvm \
+// RUN:     -finalize-memref-to-llvm -convert-arith-to-llvm \
+// RUN:     -convert-func-to-llvm -reconcile-unrealized-casts \
+// RUN: | mlir-cpu-runner -e main -entry-point-result=void \
+// RUN:     -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext \
+// RUN:     -shared-libs=%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+// RUN: buddy-opt %s \
+// RUN:     -convert-linalg-to-loops -convert-vector-to-scf -expand-strided-metadata \
+// RUN:     -lower-affine -convert-scf-to-cf -convert-vector-to-llvm \
+// RUN:     -finalize-memref-to-llvm -convert-arith-to-llvm \
+// RUN:     -convert-func-to-llvm -reconcile-unrealized-casts \
+// RUN: | mlir-cpu-runner -e main -entry-point-result=void \
+// RUN:     -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext \
+// RUN:     -shared-libs=%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+
+// The direct NHWC kernel and linalg.conv_2d_nhwc_hwcf must print the same
+// results. The outputs start at 1, so both must accumulate into the output
+// operand. With blocks of 2 vectors of 4 channels, the 10 output channels
+// leave a partial last block with one vector fully out of bounds, and the 3
+// output channels of the second convolution fit in a single partial vector.
+// The 5 and 4 output columns leave tails after the width block of 3.
+
+module {
+  memref.global "private" @input_strided : memref<2x7x11x3xf32> = dense<[[[[-3.,  1., -2.],
+                                                                           [-1.,  3., -3.],
+                                                                           [ 1., -1.,  0.],
+                                                                           [ 3., -2.,  2.],
+                                                                           [ 2., -3.,  3.],
+                                                                           [-2., -1., -1.],
+                                                                           [ 3.,  3., -1.],
+                                                                           [-1.,  1., -2.],
+                                                                           [-1.,  3., -3.],
+                                                                           [ 3., -3., -1.],
+                                                                           [-1., -1.,  0.]],
+                                                                          [[ 2.,  1., -2.],
+                                                                           [ 0.,  2.,  3.],
+                                                                           [ 0.,  2.,  1.],
+                                                                           [ 3.,  3.,  3.],
+                                                                           [-3.,  2., -1.],
+                                                                           [-3.,  2., -1.],
+                                                                           [ 1., -2., -3.],
+                                                                           [ 2.,  3., -2.],
+                                                                           [ 3., -2., -3.],
+                                                                           [ 3.,  0., -2.],
+                                                                           [-1.,  1.,  3.]],
+                                                                          [[-2., -3.,  3.],
+                                                                           [ 2.,  2., -2.],
+                                                                           [ 1., -3., -3.],
+                                                                           [ 0., -3., -1.],
+                                                                           [-3.,  0.,  2.],
+                                                                           [-3.,  3.,  3.],
+                                                                           [ 2., -1.,  3.],
+                                                                           [ 1.,  0., -1.],
+                                                                           [ 3.,  2., -3.],
+                                                                           [ 2.,  3.,  3.],
+                                                                           [-1.,  1., -3.]],
+                                                                          [[-2.,  0., -3.],
+                                                                           [ 1., -3., -2.],
+                                                                           [ 1., -3.,  3.],
+                                                                           [ 1., -3.,  0.],
+                                                                           [ 0., -2.,  3.],
+                                                                           [ 1.,  2., -1.],
+                                                                           [-3.,  1.,  0.],
+                                                                           [ 0.,  3., -2.],
+                                                                           [-1.,  2.,  1.],
+                                                                           [ 3., -1., -2.],
+                                                                           [ 0.,  0., -3.]],
+                                                                          [[-3.,  1., -2.],
+                                                                           [ 2.,  0., -1.],
+                                                                           [-1., -3., -3.],
+                                                                           [ 1.,  3.,  2.],
+                                                                           [ 0.,  0.,  2.],
+                                                                           [ 1., -2.,  2.],
+                                                                           [-2., -2., -3.],
+                                                                           [ 1.,  1.,  0.],
+                                                                           [ 2.,  0.,  3.],
+                                                                           [ 0.,  2.,  1.],
+                                                                           [ 0., -2.,  3.]],
+                                                                          [[ 3.,  1.,  0.],
+                                                                           [-2.,  2., -2.],
+                                                                           [ 2.,  2., -3.],
+                                                                           [-3.,  3., -1.],
+                                                                           [-3.,  0.,  1.],
+                                                                           [ 2., -2., -3.],
+                                                                           [ 1.,  1.,  3.],
+                                                                           [ 0., -2., -3.],
+                                                                           [ 3., -2.,  2.],
+                                                                           [-2., -1.,  2.],
+                                                                           [ 2., -3., -2.]],
+                                                                          [[-3.,  0.,  0.],
+                                                                           [ 0.,  2., -2.],
+                                                                           [ 2.,  3.,  0.],
+                                                                           [ 2., -2.,  3.],
+                                                                           [-2.,  0.,  1.],
+                                                                           [ 2.,  3.,  0.],
+                                                                           [ 1.,  2.,  2.],
+                                                                           [ 0.,  3., -1.],
+                                                                           [-3., -2.,  1.],
+                                                                           [-2., -1.,  1.],
+                                                                           [ 2., -3.,  3.]]],
+                                                                         [[[ 0.,  0., -2.],
+                                                                           [ 3.,  0.,  2.],
+                                                                           [ 1.,  2.,  2.],
+                                                                           [-1., -3.,  3.],
+                                                                           [ 1., -1.,  1.],
+                                                                           [ 2., -1., -3.],
+                                                                           [ 2.,  2.,  1.],
+                                                                           [ 3.,  3., -3.],
+                                                                           [-3.,  1.,  3.],
+                                                                           [ 3., -1.,  0.],
+                                                                           [ 1.,  1., -3.]],
+                                                                          [[ 2.,  1.,  1.],
+                                                                           [-3.,  3., -2.],
+                                                                           [-1., -1., -3.],
+                                                                           [ 0., -1., -3.],
+                                                                           [ 0., -1., -1.],
+                                                                           [ 1.,  0.,  3.],
+                                                                           [ 1.,  2.,  0.],
+                                                                           [ 3., -2.,  3.],
+                                                                           [ 2.,  3.,  2.],
+                                                                           [-2.,  1.,  0.],
+                                                                           [ 0.,  2.,  2.]],
+                                                                          [[ 0., -3.,  2.],
+                                                                           [-2., -2., -3.],
+                                                                           [ 0., -2., -3.],
+                                                                           [-3.,  0., -1.],
+                                                                           [ 1., -2.,  3.],
+                                                                           [-2., -3.,  1.],
+                                                                           [-3., -1.,  1.],
+                                                                           [ 1.,  2.,  1.],
+                                                                           [ 2.,  2.,  3.],
+                                                                           [ 2., -2., -3.],
+                                                                           [-1.,  3., -3.]],
+                                                                          [[ 2., -1.,  1.],
+                                                                           [-3.,  2.,  3.],
+                                                                           [ 1.,  0., -3.],
+                                                                           [ 0.,  1.,  0.],
+                                                                           [-3.,  2.,  0.],
+                                                                           [ 0., -3.,  1.],
+                                                                           [ 2.,  3., -3.],
+                                                                           [ 1., -2.,  1.],
+                                                                           [-3.,  0.,  2.],
+                                                                           [-1.,  3.,  2.],
+                                                                           [-3.,  2.,  3.]],
+                                                                          [[ 3., -3., -3.],
+                                                                           [-2.,  0.,  2.],
+                                                                           [-3.,  1., -2.],
+                                                                           [ 0., -1., -1.],
+                                                                           [ 1.,  2.,  1.],
+                                                                           [ 1.,  1.,  0.],
+                                                                           [-2.,  1., -3.],
+                                                                           [-3., -3., -1.],
+                                                                           [-1.,  1.,  1.],
+                                                                           [-3.,  0., -1.],
+                                                                           [ 3.,  3., -2.]],
+                                                                          [[-3.,  3.,  2.],
+                                                                           [-1., -3., -3.],
+                                                                           [ 1.,  0., -2.],
+                                                                           [-2.,  0.,  1.],
+                                                                           [ 0.,  2., -3.],
+                                                                           [ 0.,  2.,  1.],
+                                                                           [-3., -1.,  3.],
+                                                                           [ 3., -3.,  3.],
+                                                                           [ 2.,  1.,  3.],
+                                                                           [-2.,  3.,  3.],
+                                                                           [ 2., -3., -3.]],
+                                                                          [[ 1., -2.,  0.],
+                                                                           [ 3., -2., -3.],
+                                                                           [ 3., -2.,  1.],
+                                                                           [ 2.,  1., -1.],
+                                                                           [ 3.,  2.,  1.],
+                                                                           [ 0.,  2., -1.],
+                                                                           [ 3., -3., -3.],
+                                                                           [-2., -1., -1.],
+                                                                           [ 0.,  2.,  3.],
+                                                                           [-3., -3.,  3.],
+                                                                           [ 3.,  0.,  2.]]]]>
+  memref.global "private" @filter_strided : memref<3x3x3x10xf32> = dense<[[[[ 0.,  0., -2.,  0., -2.,  1., -1.,  2.,  1.,  2.],
+                                                                            [ 2.,  0.,  0.,  2., -1.,  1.,  0.,  2.,  0.,  1.],
+                                                                            [-2., -2.,  2., -1.,  2.,  1.,  2., -2.,  2., -2.]],
+                                                                           [[-1., -1.,  0.,  0.,  0.,  1.,  1., -2.,  0., -1.],
+                                                                            [ 1.,  2.,  0., -1.,  0.,  2., -2.,  1., -1.,  1.],
+                                                                            [-2., -2.,  2., -2., -1., -2., -2.,  2.,  1.,  1.]],
+                                                                           [[-1.,  2.,  1., -1., -2.,  1.,  0.,  1.,  0., -2.],
+                                                                            [ 1.,  1.,  0.,  0.,  2.,  1.,  0.,  2., -1.,  0.],
+                                                                            [ 2.,  0., -2.,  1.,  1.,  1., -1., -2.,  1., -1.]]],
+                                                                          [[[-2., -2., -1.,  1., -2., -1., -2.,  2.,  0.,  2.],
+                                                                            [ 2.,  0.,  2.,  2.,  0.,  2.,  0.,  1., -1., -1.],
+                                                                            [ 0.,  0., -2.,  2.,  0.,  2.,  2., -2., -1., -2.]],
+                                                                           [[ 1.,  1., -2.,  0.,  0.,  2.,  1.,  2.,  2.,  1.],
+                                                                            [-1.,  2.,  1., -2., -2., -2.,  2., -1.,  2., -1.],
+                                                                            [ 1.,  1.,  2.,  0.,  1.,  1., -2.,  1., -2., -1.]],
+                                                                           [[ 0.,  2.,  1.,  1.,  0., -1., -1.,  1.,  0., -1.],
+                                                                            [-1.,  2., -1., -1.,  0.,  0.,  0.,  1., -1.,  1.],
+                                                                            [ 0.,  0.,  1., -1.,  2.,  0.,  0., -2., -1., -2.]]],
+                                                                          [[[-2., -2., -2.,  1., -2.,  2., -2.,  2.,  0.,  0.],
+                                                                            [ 0.,  2., -2., -1.,  1.,  1., -2.,  2., -1.,  0.],
+                                                                            [-2.,  1.,  0., -1.,  0., -2.,  1.,  2.,  1.,  0.]],
+                                                                           [[-2.,  0., -2.,  2.,  0., -2.,  2.,  2.,  0.,  2.],
+                                                                            [ 1.,  2.,  2.,  2.,  2.,  0.,  1.,  1., -1.,  0.],
+                                                                            [ 0.,  2.,  0., -2.,  2., -1.,  2.,  0.,  0.,  0.]],
+                                                                           [[ 1., -1., -1.,  1.,  0.,  2.,  1., -2.,  0.,  2.],
+                                                                            [-1., -2., -2., -2., -1.,  1.,  1., -2., -1., -2.],
+                                                                            [-2., -1.,  0.,  0., -2.,  2.,  0., -2.,  0., -1.]]]]>
+  memref.global "private" @input_dilated : memref<1x6x9x2xf32> = dense<[[[[ 3.,  1.],
+                                                                          [-3.,  1.],
+                                                                          [-2., -3.],
+                                                                          [ 0.,  2.],
+                                                                          [-2., -1.],
+                                                                          [-2.,  1.],
+                                                                          [-1.,  0.],
+                                                                          [ 2.,  0.],
+                                                                          [ 0., -1.]],
+                                                                         [[ 2.,  3.],
+                                                                          [-1.,  2.],
+                                                                          [ 3., -1.],
+                                                                          [ 3., -1.],
+                                                                          [ 1., -1.],
+                                                                          [-2.,  2.],
+                                                                          [-1.,  1.],
+                                                                          [ 0.,  3.],
+                                                                          [ 2.,  3.]],
+                                                                         [[-3.,  0.],
+                                                                          [ 2.,  3.],
+                                                                          [ 3.,  2.],
+                                                                          [-2.,  1.],
+                                                                          [-2., -1.],
+                                                                          [ 3.,  1.],
+                                                                          [ 1.,  2.],
+                                                                          [ 0.,  1.],
+                                                                          [-3.,  3.]],
+                                                                         [[ 1., -1.],
+                                                                          [ 1., -2.],
+                                                                          [-1.,  0.],
+                                                                          [ 3., -2.],
+                                                                          [ 2., -2.],
+                                                                          [ 0.,  2.],
+                                                                          [ 3.,  2.],
+                                                                          [ 2.,  0.],
+                                                                          [-3.,  1.]],
+                                                                         [[ 3.,  0.],
+                                                                          [ 2.,  0.],
+                                                                          [ 2., -2.],
+                                                                          [ 3.,  2.],
+                                                                          [-2., -2.],
+                                                                          [ 2., -1.],
+                                                                          [ 1.,  1.],
+                                                                          [ 0.,  3.],
+                                                                          [-3.,  1.]],
+                                                                         [[ 1., -3.],
+                                                                          [ 2., -3.],
+                                                                          [ 0.,  2.],
+                                                                          [ 3., -3.],
+                                                                          [ 3., -1.],
+                                                                          [ 0.,  1.],
+                                                                          [ 1., -1.],
+                                                                          [-3., -1.],
+                                                                          [-2., -1.]]]]>
+  memref.global "private" @filter_dilated : memref<2x3x2x3xf32> = dense<[[[[ 1., -1., -2.],
+                                                                           [ 0., -1.,  1.]],
+                                                                          [[ 1.,  0.,  2.],
+                                                                           [ 2.,  0.,  2.]],
+                                                                          [[ 1.,  1.,  2.],
+                                                                           [-1., -2.,  2.]]],
+                                                                         [[[ 0.,  2.,  2.],
+                                                                           [-2.,  2., -1.]],
+                                                                          [[ 0.,  1., -1.],
+                                                                           [ 1.,  2.,  1.]],
+                                                                          [[ 2.,  0., -1.],
+                                                                           [ 0., -1.,  0.]]]]>
+
+  func.func private @printMemrefF32(memref<*xf32>)
+
+  func.func @main() {
+    %one = arith.constant 1. : f32
+    %inputStrided = memref.get_global @input_strided : memref<2x7x11x3xf32>
+    %filterStrided = memref.get_global @filter_strided : memref<3x3x3x10xf32>
+    %inputDilated = memref.get_global @input_dilated : memref<1x6x9x2xf32>
+    %filterDilated = memref.get_global @filter_dilated : memref<2x3x2x3xf32>
+
+    // Stride 2.
+    %outputStrided = memref.alloc() : memref<2x3x5x10xf32>
+    linalg.fill ins(%one : f32) outs(%outputStrided : memref<2x3x5x10xf32>)
+    linalg.conv_2d_nhwc_hwcf {dilations = dense<1> : tensor<2xi64>, strides = dense<2> : tensor<2xi64>}
+      ins(%inputStrided, %filterStrided : memref<2x7x11x3xf32>, memref<3x3x3x10xf32>)
+      outs(%outputStrided : memref<2x3x5x10xf32>)
+    %collapsedStrided = memref.collapse_shape %outputStrided [[0, 1, 2], [3]] : memref<2x3x5x10xf32> into memref<30x10xf32>
+    %printedStrided = memref.cast %collapsedStrided : memref<30x10xf32> to memref<*xf32>
+    call @printMemrefF32(%printedStrided) : (memref<*xf32>) -> ()
+    // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[30, 10\] strides = \[10, 1\] data =}}
+    // CHECK{LITERAL}: [[18, 35, 24, 17, 8, -19, 2, 21, -8, 16],
+    // CHECK{LITERAL}: [-10, -17, -1, -6, -31, 14, 1, -17, 17, -16],
+    // CHECK{LITERAL}: [4, 27, 39, -15, 14, 1, 26, -14, 9, -19],
+    // CHECK{LITERAL}: [1, 8, -19, 5, -22, -10, 7, 43, 19, 36],
+    // CHECK{LITERAL}: [2, 1, -25, 9, 6, -11, 3, 22, -1, 21],
+    // CHECK{LITERAL}: [6, 7, 27, -2, 33, -10, 10, -13, 4, -4],
+    // CHECK{LITERAL}: [10, -13, -17, 23, 20, -1, 13, -32, -8, 1],
+    // CHECK{LITERAL}: [-9, 14, -3, -21, 8, -17, 8, 7, 18, -2],
+    // CHECK{LITERAL}: [-7, 10, 18, -10, -2, 16, 38, -26, 7, -11],
+    // CHECK{LITERAL}: [-2, 11, -7, 12, -21, 16, -5, 48, 5, 31],
+    // CHECK{LITERAL}: [-6, 0, 6, 10, -19, -16, 14, -11, -8, 9],
+    // CHECK{LITERAL}: [-18, 5, -6, -26, -10, -17, -21, 11, -4, 7],
+    // CHECK{LITERAL}: [-14, -9, 6, 0, 17, -4, 35, -17, 5, -4],
+    // CHECK{LITERAL}: [2, 19, -4, 22, 7, 2, -12, 8, -8, -18],
+    // CHECK{LITERAL}: [-1, -11, 14, 7, -4, 4, -9, -22, 15, 2],
+    // CHECK{LITERAL}: [0, -12, 8, 6, -24, -16, -6, 2, 14, 6],
+    // CHECK{LITERAL}: [1, -27, 19, 1, -14, 3, -6, -13, 25, 6],
+    // CHECK{LITERAL}: [-9, 14, 3, -14, 0, 5, -1, 4, 6, -18],
+    // CHECK{LITERAL}: [24, 15, -10, 18, 23, 36, 9, -9, -12, 3],
+    // CHECK{LITERAL}: [-30, -16, 4, -1, -2, -2, 11, 7, -10, -22],
+    // CHECK{LITERAL}: [-15, -7, 16, -4, -9, -13, 3, -10, -3, -16],
+    // CHECK{LITERAL}: [12, 6, -14, -13, -10, -3, -10, -13, -2, 11],
+    // CHECK{LITERAL}: [1, 1, -2, 6, 25, -7, 0, 19, 1, 0],
+    // CHECK{LITERAL}: [17, -13, 15, -17, 11, 27, -26, -15, -8, -16],
+    // CHECK{LITERAL}: [11, 3, 5, -15, 19, 24, 33, -30, -8, -22],
+    // CHECK{LITERAL}: [3, -18, -16, 29, -13, 4, -3, 12, -2, 32],
+    // CHECK{LITERAL}: [-6, -7, -7, 17, -13, 2, 0, 9, -10, 11],
+    // CHECK{LITERAL}: [10, 1, 17, 6, 12, 6, -6, 27, 0, 22],
+    // CHECK{LITERAL}: [22, -9, -12, 19, 4, 33, -6, -20, -18, -22],
+    // CHECK{LITERAL}: [-3, 16, 12, -9, -12, 11, 2, 7, -2, -16]]
+
+    // Row dilation 2 and column stride 2.
+    %outputDilated = memref.alloc() : memref<1x4x4x3xf32>
+    linalg.fill ins(%one : f32) outs(%outputDilated : memref<1x4x4x3xf32>)
+    linalg.conv_2d_nhwc_hwcf {dilations = dense<[2, 1]> : tensor<2xi64>, strides = dense<[1, 2]> : tensor<2xi64>}
+      ins(%inputDilated, %filterDilated : memref<1x6x9x2xf32>, memref<2x3x2x3xf32>)
+      outs(%outputDilated : memref<1x4x4x3xf32>)
+    %collapsedDilated = memref.collapse_shape %outputDilated [[0, 1, 2], [3]] : memref<1x4x4x3xf32> into memref<16x3xf32>
+    %printedDilated = memref.cast %collapsedDilated : memref<16x3xf32> to memref<*xf32>
+    call @printMemrefF32(%printedDilated) : (memref<*xf32>) -> ()
+    // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[16, 3\] strides = \[3, 1\] data =}}
+    // CHECK{LITERAL}: [[13, 1, -26],
+    // CHECK{LITERAL}: [-5, 17, 9],
+    // CHECK{LITERAL}: [3, 0, -6],
+    // CHECK{LITERAL}: [-6, 9, 9],
+    // CHECK{LITERAL}: [8, -2, 7],
+    // CHECK{LITERAL}: [9, 1, -11],
+    // CHECK{LITERAL}: [14, 0, 3],
+    // CHECK{LITERAL}: [-5, 8, 25],
+    // CHECK{LITERAL}: [11, 13, 29],
+    // CHECK{LITERAL}: [5, 5, -4],
+    // CHECK{LITERAL}: [8, -8, 12],
+    // CHECK{LITERAL}: [-7, -2, 10],
+    // CHECK{LITERAL}: [1, -10, -6],
+    // CHECK{LITERAL}: [2, 10, -6],
+    // CHECK{LITERAL}: [13, 7, 16],
+    // CHECK{LITERAL}: [-1, -13, 4]]
+
+    memref.dealloc %outputStrided : memref<2x3x5x10xf32>
+    memref.dealloc %outputDilated : memref<1x4x4x3xf32>
+    return
+  }
+}
@@ -0,0 +1,240 @@
+// RUN: buddy-opt %s \
+// RUN:     -conv-vectorization="strip-mining=4 register-block=4" \
+// RUN:     -convert-linalg-to-loops -convert-vector-to-scf -expand-strided-metadata \
+// RUN:     -lower-affine -convert-scf-to-cf -convert-vector-to-llvm \
+// RUN:     -finalize-memref-to-llvm -convert-arith-to-llvm \
+// RUN:     -convert-func-to-llvm -reconcile-unrealized-casts \
+// RUN: | mlir-cpu-runner -e main -entry-point-result=void \
+// RUN:     -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext \
+// RUN:     -shared-libs=%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+// RUN: buddy-opt %s \
+// RUN:     -convert-linalg-to-loops -convert-vector-to-scf -expand-strided-metadata \
+// RUN:     -lower-affine -convert-scf-to-cf -convert-vector-to-llvm \
+// RUN:     -finalize-memref-to-llvm -convert-arith-to-llvm \
+// RUN:     -convert-func-to-llvm -reconcile-unrealized-casts \
+// RUN: | mlir-cpu-runner -e main -entry-point-result=void \
+// RUN:     -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext \
+// RUN:     -shared-libs=%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+
+// The vectorized and the direct convolutions must print the same results.
+// The outputs start at 1, so both must accumulate into the output operand.
+// NCHW: the 6 output channels round the register block of 4 down to 3, and
+// the 3 output columns of the stride 2 convolution are a partial vector.
+// NHWC: the 4 output columns fill one register block, and the 5 output
+// channels end in a partial vector after the strip of 4.
+
+module {
+  memref.global "private" @input_nchw : memref<2x3x5x7xf32> = dense<[[[[ 0.,  3.,  0., -3.,  1.,  1., -3.],
+                                                                       [ 0., -1.,  1.,  1., -3., -2., -3.],
+                                                                       [ 2., -2.,  3.,  3.,  1., -1., -1.],
+                                                                       [ 1.,  2.,  3., -3.,  1., -3., -2.],
+                                                                       [-2., -1.,  1., -3.,  0., -2., -3.]],
+                                                                      [[-1.,  0., -3.,  1.,  2.,  3.,  3.],
+                                                                       [ 2.,  0., -1.,  1., -3.,  1.,  1.],
+                                                                       [ 1., -2.,  3.,  1.,  1., -1., -3.],
+                                                                       [ 2.,  1.,  1.,  1.,  3.,  2.,  1.],
+                                                                       [ 1., -2., -1., -1., -3., -1.,  0.]],
+                                                                      [[ 2.,  1.,  3.,  2.,  2.,  1., -2.],
+                                                                       [ 1.,  0.,  1.,  0., -2., -1., -1.],
+                                                                       [ 1., -1., -1., -3., -1.,  3., -2.],
+                                                                       [-3.,  2.,  3., -2.,  2.,  2., -2.],
+                                                                       [ 2., -1.,  0., -2.,  0.,  1., -3.]]],
+                                                                     [[[-3.,  1., -1.,  1.,  2., -3.,  0.],
+                                                                       [ 0.,  1.,  2., -1.,  3.,  1.,  2.],
+                                                                       [ 3.,  1.,  1.,  2.,  3., -1.,  2.],
+                                                                       [-1.,  0.,  0., -1.,  0.,  1., -3.],
+                                                                       [ 1., -1., -1.,  0.,  1.,  1., -1.]],
+                                                                      [[ 3.,  3., -1., -2.,  0., -1., -1.],
+                                                                       [ 2., -3.,  0., -1., -2.,  0., -2.],
+                                                                       [-3.,  2.,  1.,  1.,  2., -1.,  3.],
+                                                                       [-1.,  1.,  0.,  1.,  3., -2.,  1.],
+                                                                       [ 0., -3.,  2.,  1.,  1.,  3.,  1.]],
+                                                                      [[-1.,  2.,  3., -1.,  3.,  1., -2.],
+                                                                       [-3., -1.,  3., -2.,  0.,  0.,  2.],
+                                                                       [ 1.,  0.,  2.,  2., -3., -3.,  3.],
+                                                                       [ 1., -3., -2.,  3.,  2.,  0., -2.],
+                                                                       [-3., -1., -3., -3., -3., -1., -3.]]]]>
+  memref.global "private" @kernel_fchw : memref<6x3x3x3xf32> = dense<[[[[-2.,  2., -2.],
+                                                                        [ 0.,  2., -1.],
+                                                                        [ 1., -2., -2.]],
+                                                                       [[ 0.,  1., -1.],
+                                                                        [-1., -2., -2.],
+                                                                        [-1., -1.,  1.]],
+                                                                       [[ 1., -2.,  1.],
+                                                                        [ 2., -2.,  2.],
+                                                                        [ 2.,  2.,  0.]]],
+                                                                      [[[-2.,  0.,  2.],
+                                                                        [-2.,  1.,  1.],
+                                                                        [-2.,  0., -2.]],
+                                                                       [[ 2., -1.,  0.],
+                                                                        [ 0., -2.,  1.],
+                                                                        [ 1.,  1., -1.]],
+                                                                       [[ 1.,  0., -1.],
+                                                                        [-1.,  2., -2.],
+                                                                        [ 2.,  0., -1.]]],
+                                                                      [[[ 1.,  2.,  1.],
+                                                                        [ 2., -1., -1.],
+                                                                        [ 1.,  2.,  1.]],
+                                                                       [[ 1., -2.,  0.],
+                                                                        [-2., -1.,  0.],
+                                                                        [-2.,  2.,  2.]],
+                                                                       [[-1.,  2.,  1.],
+                                                                        [ 0., -1.,  1.],
+                                                                        [-1.,  1.,  2.]]],
+                                                                      [[[-2.,  2., -1.],
+                                                                        [-1., -2.,  0.],
+                                                                        [ 2., -1.,  0.]],
+                                                                       [[ 2., -1.,  0.],
+                                                                        [ 1.,  1.,  0.],
+                                                                        [ 2.,  0.,  1.]],
+                                                                       [[ 2.,  2.,  1.],
+                                                                        [-1., -1., -1.],
+                                                                        [ 0.,  0.,  1.]]],
+                                                                      [[[ 2.,  0.,  0.],
+                                                                        [ 0.,  1.,  1.],
+                                                                        [-1.,  0., -2.]],
+                                                                       [[ 1.,  1.,  2.],
+                                                                        [ 1.,  2.,  1.],
+                                                                        [-2., -1.,  1.]],
+                                                                       [[-1., -1.,  2.],
+                                                                        [ 0., -1., -2.],
+                                                                        [-2.,  2.,  1.]]],
+                                                                      [[[ 2., -2.,  2.],
+                                                                        [ 2., -2., -1.],
+                                                                        [-1.,  1.,  0.]],
+                                                                       [[-2.,  0.,  1.],
+                                                                        [ 2.,  2.,  1.],
+                                                                        [ 0.,  2.,  2.]],
+                                                                       [[-2.,  1., -1.],
+                                                                        [ 2., -2.,  2.],
+                                                                        [ 2., -1.,  2.]]]]>
+  memref.global "private" @input_nhwc : memref<1x4x8x3xf32> = dense<[[[[-3.,  1., -1.],
+                                                                       [-2., -2.,  2.],
+                                                                       [-3.,  1.,  3.],
+                                                                       [ 2.,  3.,  0.],
+                                                                       [ 1.,  1.,  3.],
+                                                                       [ 3., -3.,  3.],
+                                                                       [ 3.,  3., -2.],
+                                                                       [-3., -1.,  2.]],
+                                                                      [[ 2., -2., -3.],
+                                                                       [-2., -1.,  0.],
+                                                                       [-1.,  2.,  2.],
+                                                                       [ 3.,  2., -1.],
+                                                                       [ 0.,  3.,  3.],
+                                                                       [ 0.,  0., -3.],
+                                                                       [-2.,  2.,  0.],
+                                                                       [ 0.,  0., -2.]],
+                                                                      [[-3., -3., -1.],
+                                                                       [ 0.,  2.,  1.],
+                                                                       [ 1.,  3.,  3.],
+                                                                       [ 3.,  1.,  1.],
+                                                                       [-2.,  1.,  0.],
+                                                                       [-2.,  0.,  2.],
+                                                                       [-3., -2.,  0.],
+                                                                       [ 0.,  0.,  3.]],
+                                                                      [[ 1.,  1.,  1.],
+                                                                       [-2.,  2.,  1.],
+                                                                       [ 2., -1., -3.],
+                                                                       [ 2.,  1., -1.],
+                                                                       [-2.,  1.,  1.],
+                                                                       [-1.,  2., -3.],
+                                                                       [ 0., -3., -1.],
+                                                                       [-2.,  3.,  3.]]]]>
+  memref.global "private" @kernel_hwcf : memref<3x3x3x5xf32> = dense<[[[[-1.,  0., -1.,  1., -2.],
+                                                                        [ 0., -1.,  1.,  1.,  2.],
+                                                                        [-1.,  2.,  1.,  1.,  1.]],
+                                                                       [[ 0.,  2.,  0.,  0., -1.],
+                                                                        [ 2.,  2.,  1.,  2., -1.],
+                                                                        [ 1.,  1., -1.,  0., -2.]],
+                                                                       [[ 1.,  0.,  2., -1.,  2.],
+                                                                        [ 1.,  2., -2.,  2., -1.],
+                                                                        [-2.,  1.,  2.,  0., -1.]]],
+                                                                      [[[ 1., -2., -1.,  1.,  0.],
+                                                                        [ 0.,  2.,  1.,  2., -2.],
+                                                                        [ 1., -1., -1.,  1.,  1.]],
+                                                                       [[-2.,  0., -2., -2.,  2.],
+                                                                        [ 2.,  0., -1., -2.,  0.],
+                                                                        [ 2.,  2., -2.,  1.,  1.]],
+                                                                       [[ 2.,  2.,  2., -1.,  0.],
+                                                                        [-2.,  0., -2.,  1.,  0.],
+                                                                        [ 2., -1., -1.,  0.,  0.]]],
+                                                                      [[[ 0., -2.,  1., -2.,  2.],
+                                                                        [-2., -2., -1., -1., -1.],
+                                                                        [-2.,  2., -2., -1.,  0.]],
+                                                                       [[-2.,  0., -2.,  0.,  2.],
+                                                                        [-2., -1., -2.,  2.,  1.],
+                                                                        [-1.,  2., -1., -2.,  2.]],
+                                                                       [[-1., -1.,  1.,  2.,  1.],
+                                                                        [ 1.,  2., -2., -1.,  1.],
+                                                                        [ 2.,  0.,  1., -1.,  0.]]]]>
+
+  func.func private @printMemrefF32(memref<*xf32>)
+
+  func.func @main() {
+    %one = arith.constant 1. : f32
+    %inputNchw = memref.get_global @input_nchw : memref<2x3x5x7xf32>
+    %kernelFchw = memref.get_global @kernel_fchw : memref<6x3x3x3xf32>
+    %inputNhwc = memref.get_global @input_nhwc : memref<1x4x8x3xf32>
+    %kernelHwcf = memref.get_global @kernel_hwcf : memref<3x3x3x5xf32>
+
+    // NCHW with stride 2.
+    %outputNchw = memref.alloc() : memref<2x6x2x3xf32>
+    linalg.fill ins(%one : f32) outs(%outputNchw : memref<2x6x2x3xf32>)
+    linalg.conv_2d_nchw_fchw {dilations = dense<1> : tensor<2xi64>, strides = dense<2> : tensor<2xi64>}
+      ins(%inputNchw, %kernelFchw : memref<2x3x5x7xf32>, memref<6x3x3x3xf32>)
+      outs(%outputNchw : memref<2x6x2x3xf32>)
+    %collapsedNchw = memref.collapse_shape %outputNchw [[0, 1, 2], [3]] : memref<2x6x2x3xf32> into memref<24x3xf32>
+    %printedNchw = memref.cast %collapsedNchw : memref<24x3xf32> to memref<*xf32>
+    call @printMemrefF32(%printedNchw) : (memref<*xf32>) -> ()
+    // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[24, 3\] strides = \[3, 1\] data =}}
+    // CHECK{LITERAL}: [[18, -15, 5],
+    // CHECK{LITERAL}: [-25, 3, -9],
+    // CHECK{LITERAL}: [-17, -15, 3],
+    // CHECK{LITERAL}: [18, -17, 2],
+    // CHECK{LITERAL}: [3, 1, -13],
+    // CHECK{LITERAL}: [-18, 2, -6],
+    // CHECK{LITERAL}: [26, 6, 18],
+    // CHECK{LITERAL}: [-13, -2, 4],
+    // CHECK{LITERAL}: [-14, -14, 8],
+    // CHECK{LITERAL}: [3, 12, 8],
+    // CHECK{LITERAL}: [-5, 12, -32],
+    // CHECK{LITERAL}: [12, 20, 11],
+    // CHECK{LITERAL}: [22, 17, -9],
+    // CHECK{LITERAL}: [4, -42, -15],
+    // CHECK{LITERAL}: [-2, -3, -27],
+    // CHECK{LITERAL}: [-23, 14, 3],
+    // CHECK{LITERAL}: [25, 16, 14],
+    // CHECK{LITERAL}: [-7, 0, 8],
+    // CHECK{LITERAL}: [18, 9, 6],
+    // CHECK{LITERAL}: [-1, 6, -13],
+    // CHECK{LITERAL}: [-2, -11, -15],
+    // CHECK{LITERAL}: [26, -12, 26],
+    // CHECK{LITERAL}: [-9, 5, 10],
+    // CHECK{LITERAL}: [-3, 3, 13]]
+
+    // NHWC with a column dilation of 2.
+    %outputNhwc = memref.alloc() : memref<1x2x4x5xf32>
+    linalg.fill ins(%one : f32) outs(%outputNhwc : memref<1x2x4x5xf32>)
+    linalg.conv_2d_nhwc_hwcf {dilations = dense<[1, 2]> : tensor<2xi64>, strides = dense<1> : tensor<2xi64>}
+      ins(%inputNhwc, %kernelHwcf : memref<1x4x8x3xf32>, memref<3x3x3x5xf32>)
+      outs(%outputNhwc : memref<1x2x4x5xf32>)
+    %collapsedNhwc = memref.collapse_shape %outputNhwc [[0, 1, 2], [3]] : memref<1x2x4x5xf32> into memref<8x5xf32>
+    %printedNhwc = memref.cast %collapsedNhwc : memref<8x5xf32> to memref<*xf32>
+    call @printMemrefF32(%printedNhwc) : (memref<*xf32>) -> ()
+    // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[8, 5\] strides = \[5, 1\] data =}}
+    // CHECK{LITERAL}: [[15, 15, -19, 4, 10],
+    // CHECK{LITERAL}: [-20, 18, 9, -28, 16],
+    // CHECK{LITERAL}: [12, 19, -19, 3, 1],
+    // CHECK{LITERAL}: [-16, -6, 9, -11, -13],
+    // CHECK{LITERAL}: [7, 10, -26, -10, -14],
+    // CHECK{LITERAL}: [-3, 11, -34, 6, 5],
+    // CHECK{LITERAL}: [21, -2, 13, 33, -12],
+    // CHECK{LITERAL}: [30, -20, -9, 13, 1]]
+
+    memref.dealloc %outputNchw : memref<2x6x2x3xf32>
+    memref.dealloc %outputNhwc : memref<1x2x4x5xf32>
+    return
+  }
+}
@@ -0,0 +1,316 @@
+// RUN: buddy-opt %s \
+// RUN:     -convert-linalg-to-loops -convert-vector-to-scf -expand-strided-metadata -lower-affine -convert-scf-to-cf \
+// RUN:     -convert-vector-to-llvm -convert-math-to-llvm -finalize-memref-to-llvm -convert-arith-to-llvm \
+// RUN:     -convert-func-to-llvm -reconcile-unrealized-casts \
+// RUN: | mlir-cpu-runner -e main -entry-point-result=void \
+// RUN:     -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext \
+// RUN:     -shared-libs=%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+// RUN: buddy-opt %s -conv-winograd="tile-size=2" \
+// RUN:     -convert-linalg-to-loops -convert-vector-to-scf -expand-strided-metadata -lower-affine -convert-scf-to-cf \
+// RUN:     -convert-vector-to-llvm -convert-math-to-llvm -finalize-memref-to-llvm -convert-arith-to-llvm \
+// RUN:     -convert-func-to-llvm -reconcile-unrealized-casts \
+// RUN: | mlir-cpu-runner -e main -entry-point-result=void \
+// RUN:     -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext \
+// RUN:     -shared-libs=%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+// RUN: buddy-opt %s -conv-winograd="tile-size=4" \
+// RUN:     -convert-linalg-to-loops -convert-vector-to-scf -expand-strided-metadata -lower-affine -convert-scf-to-cf \
+// RUN:     -convert-vector-to-llvm -convert-math-to-llvm -finalize-memref-to-llvm -convert-arith-to-llvm \
+// RUN:     -convert-func-to-llvm -reconcile-unrealized-casts \
+// RUN: | mlir-cpu-runner -e main -entry-point-result=void \
+// RUN:     -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext \
+// RUN:     -shared-libs=%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+// RUN: buddy-opt %s -conv-winograd="tile-size=4" | FileCheck %s --check-prefix=FOLD
+
+// The direct convolution and F(2x2, 3x3) and F(4x4, 3x3) must print the same
+// results. The 5x6 outputs have a partial last tile in both directions for
+// m = 4 and in the row direction for m = 2. The constant filters are folded
+// into transformed constant globals; @conv_nchw transforms its filter argument
+// at runtime.
+
+// FOLD-DAG: memref.global "private" constant @filter_fchw_winograd_f4 : memref<36x3x2xf32>
+// FOLD-DAG: memref.global "private" constant @filter_hwcf_winograd_f4 : memref<36x3x2xf32>
+// FOLD-LABEL: func.func @conv_nchw
+// FOLD-NOT: linalg.conv_2d
+// FOLD: linalg.batch_matmul
+
+module {
+  memref.global "private" @input_nchw : memref<1x2x7x8xf32> = dense<[[[[ 1., -2.,  2., -4., -3.,  4., -3.,  1.],
+                                                                       [-4.,  4., -1., -4., -3.,  2.,  2., -3.],
+                                                                       [-1., -3.,  4.,  2., -4., -3., -1., -4.],
+                                                                       [ 2., -4., -1., -4.,  4., -2.,  0.,  2.],
+                                                                       [-2.,  4., -3.,  0.,  4., -2., -3., -1.],
+                                                                       [ 1., -3.,  4., -3., -4., -1.,  3.,  4.],
+                                                                       [ 2.,  1.,  3.,  3.,  1.,  0., -1., -2.]],
+                                                                      [[-1., -3.,  0.,  4.,  3.,  1.,  3.,  0.],
+                                                                       [-3., -3.,  4.,  2., -2.,  1., -2.,  3.],
+                                                                       [ 2., -4., -3.,  4.,  1.,  1.,  1.,  3.],
+                                                                       [ 3., -3., -3.,  0.,  3., -3., -4.,  0.],
+                                                                       [ 3.,  0.,  2.,  1., -4.,  3.,  1., -2.],
+                                                                       [-3.,  3., -4., -1.,  0., -2., -1.,  2.],
+                                                                       [ 2.,  3., -3., -2.,  3.,  2.,  4.,  0.]]]]>
+  memref.global "private" constant @filter_fchw : memref<3x2x3x3xf32> = dense<[[[[-1.,  1.,  2.],
+                                                                                 [ 0.,  1.,  0.],
+                                                                                 [ 1., -1., -1.]],
+                                                                                [[-2., -1., -1.],
+                                                                                 [-1., -1., -2.],
+                                                                                 [ 1.,  2., -1.]]],
+                                                                               [[[ 0.,  0., -2.],
+                                                                                 [-1.,  1.,  2.],
+                                                                                 [ 0.,  2.,  2.]],
+                                                                                [[ 0., -1.,  2.],
+                                                                                 [ 2., -2.,  1.],
+                                                                                 [ 2.,  1.,  1.]]],
+                                                                               [[[ 1.,  1., -2.],
+                                                                                 [ 1.,  1., -2.],
+                                                                                 [-1., -2., -1.]],
+                                                                                [[ 1., -1., -2.],
+                                                                                 [ 0.,  2., -2.],
+                                                                                 [-2., -2.,  2.]]]]>
+  memref.global "private" @input_nhwc : memref<2x7x8x2xf32> = dense<[[[[-2.,  1.],
+                                                                       [ 4., -4.],
+                                                                       [-3., -4.],
+                                                                       [ 1.,  0.],
+                                                                       [-4.,  3.],
+                                                                       [-3.,  0.],
+                                                                       [-1., -1.],
+                                                                       [ 2.,  1.]],
+                                                                      [[-2.,  3.],
+                                                                       [ 0.,  1.],
+                                                                       [ 1.,  1.],
+                                                                       [ 1., -3.],
+                                                                       [ 3., -1.],
+                                                                       [-3., -3.],
+                                                                       [-3., -1.],
+                                                                       [ 3.,  3.]],
+                                                                      [[ 3., -1.],
+                                                                       [ 3.,  1.],
+                                                                       [ 3., -1.],
+                                                                       [ 0.,  3.],
+                                                                       [-3., -4.],
+                                                                       [-2.,  3.],
+                                                                       [-3.,  1.],
+                                                                       [ 1., -3.]],
+                                                                      [[ 0., -3.],
+                                                                       [ 3.,  2.],
+                                                                       [-2., -1.],
+                                                                       [ 4.,  3.],
+                                                                       [-4., -2.],
+                                                                       [-1.,  2.],
+                                                                       [ 4.,  1.],
+                                                                       [ 1., -3.]],
+                                                                      [[-2.,  2.],
+                                                                       [ 4.,  3.],
+                                                                       [-4.,  2.],
+                                                                       [ 4., -3.],
+                                                                       [ 0., -2.],
+                                                                       [-3., -2.],
+                                                                       [ 0., -2.],
+                                                                       [ 4., -4.]],
+                                                                      [[ 1., -2.],
+                                                                       [-2.,  3.],
+                                                                       [ 1., -2.],
+                                                                       [-1.,  3.],
+                                                                       [ 4.,  1.],
+                                                                       [ 4., -2.],
+                                                                       [ 4.,  4.],
+                                                                       [ 1.,  4.]],
+                                                                      [[-1., -2.],
+                                                                       [-1., -4.],
+                                                                       [-1., -4.],
+                                                                       [ 2., -3.],
+                                                                       [-1.,  4.],
+                                                                       [-1., -2.],
+                                                                       [ 4.,  2.],
+                                                                       [ 3., -1.]]],
+                                                                     [[[-1., -1.],
+                                                                       [-4.,  0.],
+                                                                       [ 0.,  3.],
+                                                                       [-1.,  4.],
+                                                                       [ 0.,  4.],
+                                                                       [ 4.,  3.],
+                                                                       [-1.,  4.],
+                                                                       [ 1., -1.]],
+                                                                      [[ 0.,  4.],
+                                                                       [ 4.,  0.],
+                                                                       [ 2.,  4.],
+                                                                       [-2., -1.],
+                                                                       [-4.,  3.],
+                                                                       [ 1., -2.],
+                                                                       [ 3.,  2.],
+                                                                       [ 4., -3.]],
+                                                                      [[ 2.,  2.],
+                                                                       [ 4.,  3.],
+                                                                       [-2.,  1.],
+                                                                       [ 4., -3.],
+                                                                       [-2., -1.],
+                                                                       [ 4.,  2.],
+                                                                       [ 4., -3.],
+                                                                       [-4., -1.]],
+                                                                      [[ 3.,  0.],
+                                                                       [-2., -3.],
+                                                                       [-4., -2.],
+                                                                       [-2.,  1.],
+                                                                       [-2., -2.],
+                                                                       [-2.,  0.],
+                                                                       [ 3., -2.],
+                                                                       [-3.,  3.]],
+                                                                      [[ 4., -1.],
+                                                                       [-4., -3.],
+                                                                       [ 1.,  2.],
+                                                                       [ 4.,  3.],
+                                                                       [ 4., -2.],
+                                                                       [ 4., -1.],
+                                                                       [ 3., -2.],
+                                                                       [-3.,  2.]],
+                                                                      [[ 4.,  4.],
+                                                                       [-4.,  2.],
+                                                                       [-1.,  1.],
+                                                                       [-1.,  2.],
+                                                                       [ 0., -1.],
+                                                                       [-4.,  1.],
+                                                                       [-3.,  1.],
+                                                                       [ 4., -3.]],
+                                                                      [[ 3.,  1.],
+                                                                       [ 4., -4.],
+                                                                       [-4.,  1.],
+                                                                       [-3.,  4.],
+                                                                       [ 3.,  3.],
+                                                                       [ 1.,  3.],
+                                                                       [ 4., -4.],
+                                                                       [ 4.,  2.]]]]>
+  memref.global "private" constant @filter_hwcf : memref<3x3x2x3xf32> = dense<[[[[-1.,  0.,  1.],
+                                                                                 [-2.,  0.,  1.]],
+                                                                                [[ 1.,  0.,  1.],
+                                                                                 [-1., -1., -1.]],
+                                                                                [[ 2., -2., -2.],
+                                                                                 [-1.,  2., -2.]]],
+                                                                               [[[ 0., -1.,  1.],
+                                                                                 [-1.,  2.,  0.]],
+                                                                                [[ 1.,  1.,  1.],
+                                                                                 [-1., -2.,  2.]],
+                                                                                [[ 0.,  2., -2.],
+                                                                                 [-2.,  1., -2.]]],
+                                                                               [[[ 1.,  0., -1.],
+                                                                                 [ 1.,  2., -2.]],
+                                                                                [[-1.,  2., -2.],
+                                                                                 [ 2.,  1., -2.]],
+                                                                                [[-1.,  2., -1.],
+                                                                                 [-1.,  1.,  2.]]]]>
+
+  func.func private @printMemrefF32(memref<*xf32>)
+
+  // Rounds every element of %m to the nearest integer and prints %m.
+  func.func @round_and_print(%m : memref<?x?xf32>) {
+    %c0 = arith.constant 0 : index
+    %c1 = arith.constant 1 : index
+    %zero = arith.constant 0. : f32
+    %rows = memref.dim %m, %c0 : memref<?x?xf32>
+    %cols = memref.dim %m, %c1 : memref<?x?xf32>
+    scf.for %i = %c0 to %rows step %c1 {
+      scf.for %j = %c0 to %cols step %c1 {
+        %x = memref.load %m[%i, %j] : memref<?x?xf32>
+        %rounded = math.roundeven %x : f32
+        // Adding zero turns -0 into 0.
+        %res = arith.addf %rounded, %zero : f32
+        memref.store %res, %m[%i, %j] : memref<?x?xf32>
+      }
+    }
+    %printed = memref.cast %m : memref<?x?xf32> to memref<*xf32>
+    call @printMemrefF32(%printed) : (memref<*xf32>) -> ()
+    return
+  }
+
+  func.func @conv_nchw(%input : memref<1x2x7x8xf32>, %filter : memref<3x2x3x3xf32>, %output : memref<1x3x5x6xf32>) {
+    linalg.conv_2d_nchw_fchw {dilations = dense<1> : tensor<2xi64>, strides = dense<1> : tensor<2xi64>}
+      ins(%input, %filter : memref<1x2x7x8xf32>, memref<3x2x3x3xf32>)
+      outs(%output : memref<1x3x5x6xf32>)
+    return
+  }
+
+  func.func @main() {
+    %zero = arith.constant 0. : f32
+    %inputNchw = memref.get_global @input_nchw : memref<1x2x7x8xf32>
+    %filterFchw = memref.get_global @filter_fchw : memref<3x2x3x3xf32>
+    %inputNhwc = memref.get_global @input_nhwc : memref<2x7x8x2xf32>
+    %filterHwcf = memref.get_global @filter_hwcf : memref<3x3x2x3xf32>
+
+    // NCHW with the folded constant filter.
+    %outputNchw = memref.alloc() : memref<1x3x5x6xf32>
+    linalg.fill ins(%zero : f32) outs(%outputNchw : memref<1x3x5x6xf32>)
+    linalg.conv_2d_nchw_fchw {dilations = dense<1> : tensor<2xi64>, strides = dense<1> : tensor<2xi64>}
+      ins(%inputNchw, %filterFchw : memref<1x2x7x8xf32>, memref<3x2x3x3xf32>)
+      outs(%outputNchw : memref<1x3x5x6xf32>)
+    %collapsedNchw = memref.collapse_shape %outputNchw [[0, 1, 2], [3]] : memref<1x3x5x6xf32> into memref<15x6xf32>
+    %printedNchw = memref.cast %collapsedNchw : memref<15x6xf32> to memref<?x?xf32>
+    call @round_and_print(%printedNchw) : (memref<?x?xf32>) -> ()
+    // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[15, 6\] strides = \[6, 1\] data =}}
+    // CHECK{LITERAL}: [[3, -31, -15, 6, 0, -11],
+    // CHECK{LITERAL}: [23, -18, -25, -6, 14, -33],
+    // CHECK{LITERAL}: [9, 33, -15, -27, 11, 4],
+    // CHECK{LITERAL}: [-4, -11, 18, 8, -17, -1],
+    // CHECK{LITERAL}: [6, -9, 1, 4, 0, 7],
+    // CHECK{LITERAL}: [8, -4, -4, 1, 8, -6],
+    // CHECK{LITERAL}: [18, 2, -26, -1, -14, 5],
+    // CHECK{LITERAL}: [1, -1, 17, 7, -9, 18],
+    // CHECK{LITERAL}: [2, 4, -16, -6, -29, 10],
+    // CHECK{LITERAL}: [10, 27, -35, 10, 27, 11],
+    // CHECK{LITERAL}: [-14, 27, -1, -32, 13, 8],
+    // CHECK{LITERAL}: [-19, 5, 44, -19, -17, 21],
+    // CHECK{LITERAL}: [-5, -15, -29, 27, 4, -19],
+    // CHECK{LITERAL}: [9, 4, -7, 11, 33, -1],
+    // CHECK{LITERAL}: [-12, -16, 11, 3, -16, -17]]
+
+    // NCHW with the filter transformed at runtime.
+    %outputNchwDynamic = memref.alloc() : memref<1x3x5x6xf32>
+    linalg.fill ins(%zero : f32) outs(%outputNchwDynamic : memref<1x3x5x6xf32>)
+    call @conv_nchw(%inputNchw, %filterFchw, %outputNchwDynamic) : (memref<1x2x7x8xf32>, memref<3x2x3x3xf32>, memref<1x3x5x6xf32>) -> ()
+    %collapsedNchwDynamic = memref.collapse_shape %outputNchwDynamic [[0, 1, 2], [3]] : memref<1x3x5x6xf32> into memref<15x6xf32>
+    %printedNchwDynamic = memref.cast %collapsedNchwDynamic : memref<15x6xf32> to memref<?x?xf32>
+    call @round_and_print(%printedNchwDynamic) : (memref<?x?xf32>) -> ()
+    // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[15, 6\] strides = \[6, 1\] data =}}
+    // CHECK{LITERAL}: [[3, -31, -15, 6, 0, -11],
+    // CHECK{LITERAL}: [23, -18, -25, -6, 14, -33],
+    // CHECK{LITERAL}: [9, 33, -15, -27, 11, 4],
+    // CHECK{LITERAL}: [-4, -11, 18, 8, -17, -1],
+    // CHECK{LITERAL}: [6, -9, 1, 4, 0, 7],
+    // CHECK{LITERAL}: [8, -4, -4, 1, 8, -6],
+    // CHECK{LITERAL}: [18, 2, -26, -1, -14, 5],
+    // CHECK{LITERAL}: [1, -1, 17, 7, -9, 18],
+    // CHECK{LITERAL}: [2, 4, -16, -6, -29, 10],
+    // CHECK{LITERAL}: [10, 27, -35, 10, 27, 11],
+    // CHECK{LITERAL}: [-14, 27, -1, -32, 13, 8],
+    // CHECK{LITERAL}: [-19, 5, 44, -19, -17, 21],
+    // CHECK{LITERAL}: [-5, -15, -29, 27, 4, -19],
+    // CHECK{LITERAL}: [9, 4, -7, 11, 33, -1],
+    // CHECK{LITERAL}: [-12, -16, 11, 3, -16, -17]]
+
+    // NHWC with a batch of two images, printed as rows of (column, channel).
+    %outputNhwc = memref.alloc() : memref<2x5x6x3xf32>
+    linalg.fill ins(%zero : f32) outs(%outputNhwc : memref<2x5x6x3xf32>)
+    linalg.conv_2d_nhwc_hwcf {dilations = dense<1> : tensor<2xi64>, strides = dense<1> : tensor<2xi64>}
+      ins(%inputNhwc, %filterHwcf : memref<2x7x8x2xf32>, memref<3x3x2x3xf32>)
+      outs(%outputNhwc : memref<2x5x6x3xf32>)
+    %collapsedNhwc = memref.collapse_shape %outputNhwc [[0, 1], [2, 3]] : memref<2x5x6x3xf32> into memref<10x18xf32>
+    %printedNhwc = memref.cast %collapsedNhwc : memref<10x18xf32> to memref<?x?xf32>
+    call @round_and_print(%printedNhwc) : (memref<?x?xf32>) -> ()
+    // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[10, 18\] strides = \[18, 1\] data =}}
+    // CHECK{LITERAL}: [[-1, 21, 3, 8, 12, 3, 21, 18, -24, -4, -13, 30, 0, -23, 16, 9, 4, -36],
+    // CHECK{LITERAL}: [2, -3, -4, -2, 8, 4, 19, -27, 15, 4, 7, 8, -15, -6, 19, 10, 15, -39],
+    // CHECK{LITERAL}: [18, -12, 5, 1, 24, -29, -10, -10, 27, -19, 0, 1, -5, -5, -9, -5, -5, 9],
+    // CHECK{LITERAL}: [7, -7, 12, -12, 5, -3, 9, 23, 5, -9, 15, -10, 6, 7, -28, 18, 12, -8],
+    // CHECK{LITERAL}: [-15, -20, 20, -22, -15, 1, -11, -9, 25, 15, 11, 9, -4, 30, -12, 10, -9, -9],
+    // CHECK{LITERAL}: [-5, 38, -36, 5, 0, -11, -34, 7, -12, -13, -17, -5, -21, 43, -36, -2, -9, 0],
+    // CHECK{LITERAL}: [-2, -16, 17, -13, -18, 34, -12, 11, 17, -2, -17, -10, 11, 1, -1, 13, -14, 19],
+    // CHECK{LITERAL}: [-7, -15, 29, -14, -13, 0, 10, 16, -11, 2, 18, -36, 16, -9, -22, -12, 13, 23],
+    // CHECK{LITERAL}: [4, 8, -1, -3, 17, -13, 12, 7, 1, 3, 19, 6, 30, -22, 9, 1, 13, 4],
+    // CHECK{LITERAL}: [-20, -1, 1, 11, -16, -6, 6, -9, 7, 2, 14, -2, 18, -7, -22, -18, 38, -4]]
+
+    memref.dealloc %outputNchw : memref<1x3x5x6xf32>
+    memref.dealloc %outputNchwDynamic : memref<1x3x5x6xf32>
+    memref.dealloc %outputNhwc : memref<2x5x6x3xf32>
+    return
+  }
+}
@@ -0,0 +1,142 @@
+// RUN: buddy-opt %s \
+// RUN:     -depthwise-conv-vectorization="vector-size=4 width-block=2" \
+// RUN:     -convert-linalg-to-loops -convert-vector-to-scf -expand-strided-metadata \
+// RUN:     -lower-affine -convert-scf-to-cf -convert-vector-to-llvm \
+// RUN:     -finalize-memref-to-llvm -convert-arith-to-llvm \
+// RUN:     -convert-func-to-llvm -reconcile-unrealized-casts \
+// RUN: | mlir-cpu-runner -e main -entry-point-result=void \
+// RUN:     -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext \
+// RUN:     -shared-libs=%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+// RUN: buddy-opt %s \
+// RUN:     -convert-linalg-to-loops -convert-vector-to-scf -expand-strided-metadata \
+// RUN:     -lower-affine -convert-scf-to-cf -convert-vector-to-llvm \
+// RUN:     -finalize-memref-to-llvm -convert-arith-to-llvm \
+// RUN:     -convert-func-to-llvm -reconcile-unrealized-casts \
+// RUN: | mlir-cpu-runner -e main -entry-point-result=void \
+// RUN:     -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext \
+// RUN:     -shared-libs=%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+
+// The vectorized and the direct convolutions must print the same results.
+// With 3 channels and a multiplier of 3, the 9 output channels end in a
+// partial vector of 4 and every vector starts at a different multiplier
+// offset. The 3 output columns leave a tail after the width block of 2.
+
+module {
+  memref.global "private" @input : memref<1x5x7x3xf32> = dense<[[[[ 0.,  3.,  1.],
+                                                                  [ 3.,  3.,  0.],
+                                                                  [ 0.,  1.,  3.],
+                                                                  [ 1., -2., -2.],
+                                                                  [ 3.,  1.,  0.],
+                                                                  [ 2.,  1.,  3.],
+                                                                  [-2., -3.,  0.]],
+                                                                 [[-1., -2., -3.],
+                                                                  [ 1.,  3.,  2.],
+                                                                  [ 2., -3.,  1.],
+                                                                  [ 0.,  0.,  2.],
+                                                                  [ 2.,  1.,  2.],
+                                                                  [-2.,  1., -3.],
+                                                                  [ 3.,  1., -3.]],
+                                                                 [[-3., -3., -2.],
+                                                                  [-2.,  1., -3.],
+                                                                  [ 3.,  0., -1.],
+                                                                  [ 0.,  1.,  3.],
+                                                                  [-2.,  1., -2.],
+                                                                  [ 2., -1.,  0.],
+                                                                  [-3.,  2., -3.]],
+                                                                 [[ 0.,  2., -1.],
+                                                                  [ 0.,  1.,  3.],
+                                                                  [-3.,  2., -1.],
+                                                                  [-1.,  3., -2.],
+                                                                  [ 1., -1., -3.],
+                                                                  [-3.,  1.,  3.],
+                                                                  [-3.,  0., -3.]],
+                                                                 [[ 3., -1.,  0.],
+                                                                  [-3., -3.,  3.],
+                                                                  [ 2., -3., -2.],
+                                                                  [-2., -3.,  0.],
+                                                                  [ 0.,  2.,  0.],
+                                                                  [ 0., -3.,  1.],
+                                                                  [ 2., -2.,  3.]]]]>
+  memref.global "private" @kernel_hwcm : memref<3x3x3x3xf32> = dense<[[[[ 0.,  0., -2.],
+                                                                        [ 0.,  0., -2.],
+                                                                        [ 1., -2., -1.]],
+                                                                       [[-1., -2., -2.],
+                                                                        [-2.,  1.,  1.],
+                                                                        [-1.,  2., -1.]],
+                                                                       [[ 1.,  2., -1.],
+                                                                        [-1.,  1.,  1.],
+                                                                        [-2.,  1.,  1.]]],
+                                                                      [[[-1., -2.,  0.],
+                                                                        [ 2.,  0., -2.],
+                                                                        [-1., -1.,  1.]],
+                                                                       [[ 2.,  2., -2.],
+                                                                        [-2., -1., -1.],
+                                                                        [ 1.,  0., -2.]],
+                                                                       [[ 2.,  0.,  0.],
+                                                                        [ 1., -2., -2.],
+                                                                        [-2., -1.,  2.]]],
+                                                                      [[[-1., -2.,  2.],
+                                                                        [ 0.,  0.,  2.],
+                                                                        [ 1., -1.,  2.]],
+                                                                       [[ 1.,  2., -1.],
+                                                                        [ 1., -1., -1.],
+                                                                        [ 0., -1.,  2.]],
+                                                                       [[-1., -1., -1.],
+                                                                        [ 2., -1.,  1.],
+                                                                        [ 1.,  2., -2.]]]]>
+  memref.global "private" @kernel_hwc : memref<3x3x3xf32> = dense<[[[ 1., -2., -2.],
+                                                                    [-2., -2.,  2.],
+                                                                    [ 0., -1.,  1.]],
+                                                                   [[ 0.,  1.,  2.],
+                                                                    [ 1.,  0.,  2.],
+                                                                    [-1., -2., -1.]],
+                                                                   [[-1.,  1.,  2.],
+                                                                    [ 2.,  2., -2.],
+                                                                    [ 0., -1., -1.]]]>
+
+  func.func private @printMemrefF32(memref<*xf32>)
+
+  func.func @main() {
+    %zero = arith.constant 0. : f32
+    %input = memref.get_global @input : memref<1x5x7x3xf32>
+    %kernelHwcm = memref.get_global @kernel_hwcm : memref<3x3x3x3xf32>
+    %kernelHwc = memref.get_global @kernel_hwc : memref<3x3x3xf32>
+
+    // Channel multiplier 3 with stride 2.
+    %outputHwcm = memref.alloc() : memref<1x2x3x3x3xf32>
+    linalg.fill ins(%zero : f32) outs(%outputHwcm : memref<1x2x3x3x3xf32>)
+    linalg.depthwise_conv_2d_nhwc_hwcm {dilations = dense<1> : tensor<2xi64>, strides = dense<2> : tensor<2xi64>}
+      ins(%input, %kernelHwcm : memref<1x5x7x3xf32>, memref<3x3x3x3xf32>)
+      outs(%outputHwcm : memref<1x2x3x3x3xf32>)
+    %collapsedHwcm = memref.collapse_shape %outputHwcm [[0, 1, 2], [3, 4]] : memref<1x2x3x3x3xf32> into memref<6x9xf32>
+    %printedHwcm = memref.cast %collapsedHwcm : memref<6x9xf32> to memref<*xf32>
+    call @printMemrefF32(%printedHwcm) : (memref<*xf32>) -> ()
+    // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[6, 9\] strides = \[9, 1\] data =}}
+    // CHECK{LITERAL}: [[2, -3, -15, -19, 6, -2, -5, 6, -11],
+    // CHECK{LITERAL}: [3, -4, 3, 1, -5, 1, -1, -19, 8],
+    // CHECK{LITERAL}: [3, -5, -7, 5, -6, -4, -7, 3, 1],
+    // CHECK{LITERAL}: [-9, -4, 14, -7, 2, -4, 7, -8, 5],
+    // CHECK{LITERAL}: [-3, -8, 4, -5, 2, -4, 3, 12, -11],
+    // CHECK{LITERAL}: [-20, -20, 7, -11, 5, 5, 19, 12, -20]]
+
+    // No multiplier with dilation 2.
+    %outputHwc = memref.alloc() : memref<1x1x3x3xf32>
+    linalg.fill ins(%zero : f32) outs(%outputHwc : memref<1x1x3x3xf32>)
+    linalg.depthwise_conv_2d_nhwc_hwc {dilations = dense<2> : tensor<2xi64>, strides = dense<1> : tensor<2xi64>}
+      ins(%input, %kernelHwc : memref<1x5x7x3xf32>, memref<3x3x3xf32>)
+      outs(%outputHwc : memref<1x1x3x3xf32>)
+    %collapsedHwc = memref.collapse_shape %outputHwc [[0, 1, 2], [3]] : memref<1x1x3x3xf32> into memref<3x3xf32>
+    %printedHwc = memref.cast %collapsedHwc : memref<3x3xf32> to memref<*xf32>
+    call @printMemrefF32(%printedHwc) : (memref<*xf32>) -> ()
+    // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[3, 3\] strides = \[3, 1\] data =}}
+    // CHECK{LITERAL}: [[6, -23, 4],
+    // CHECK{LITERAL}: [-2, -6, 4],
+    // CHECK{LITERAL}: [-7, -2, -16]]
+
+    memref.dealloc %outputHwcm : memref<1x2x3x3x3xf32>
+    memref.dealloc %outputHwc : memref<1x1x3x3xf32>
+    return
+  }
+}
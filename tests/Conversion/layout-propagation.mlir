@@ -0,0 +1,53 @@
+// RUN: buddy-opt %s -layout-propagation | FileCheck %s
+
+// CHECK-LABEL: func.func @cancel_inverse_transposes
+// CHECK-NOT: linalg.transpose
+// CHECK: return %arg0
+func.func @cancel_inverse_transposes(%arg0: tensor<2x3x4xf32>) -> tensor<2x3x4xf32> {
+  %0 = tensor.empty() : tensor<4x2x3xf32>
+  %1 = linalg.transpose ins(%arg0 : tensor<2x3x4xf32>) outs(%0 : tensor<4x2x3xf32>) permutation = [2, 0, 1]
+  %2 = tensor.empty() : tensor<2x3x4xf32>
+  %3 = linalg.transpose ins(%1 : tensor<4x2x3xf32>) outs(%2 : tensor<2x3x4xf32>) permutation = [1, 2, 0]
+  return %3 : tensor<2x3x4xf32>
+}
+
+// CHECK-LABEL: func.func @matmul_transpose_b
+// CHECK-NOT: linalg.transpose
+// CHECK: linalg.matmul_transpose_b ins(%arg0, %arg1 : tensor<16x32xf32>, tensor<8x32xf32>)
+func.func @matmul_transpose_b(%arg0: tensor<16x32xf32>, %arg1: tensor<8x32xf32>, %arg2: tensor<16x8xf32>) -> tensor<16x8xf32> {
+  %0 = tensor.empty() : tensor<32x8xf32>
+  %1 = linalg.transpose ins(%arg1 : tensor<8x32xf32>) outs(%0 : tensor<32x8xf32>) permutation = [1, 0]
+  %2 = linalg.matmul ins(%arg0, %1 : tensor<16x32xf32>, tensor<32x8xf32>) outs(%arg2 : tensor<16x8xf32>) -> tensor<16x8xf32>
+  return %2 : tensor<16x8xf32>
+}
+
+// CHECK-LABEL: func.func @batch_matmul_transpose_b_through_expand
+// CHECK-NOT: linalg.transpose
+// CHECK: linalg.batch_matmul_transpose_b ins(%{{.*}}, %arg1 : tensor<4x16x32xf32>, tensor<4x16x32xf32>)
+func.func @batch_matmul_transpose_b_through_expand(%arg0: tensor<1x4x16x32xf32>, %arg1: tensor<4x16x32xf32>, %arg2: tensor<4x16x16xf32>) -> tensor<4x16x16xf32> {
+  %0 = tensor.empty() : tensor<4x32x16xf32>
+  %1 = linalg.transpose ins(%arg1 : tensor<4x16x32xf32>) outs(%0 : tensor<4x32x16xf32>) permutation = [0, 2, 1]
+  %2 = tensor.expand_shape %1 [[0, 1], [2], [3]] : tensor<4x32x16xf32> into tensor<1x4x32x16xf32>
+  %3 = tensor.collapse_shape %2 [[0, 1], [2], [3]] : tensor<1x4x32x16xf32> into tensor<4x32x16xf32>
+  %4 = tensor.collapse_shape %arg0 [[0, 1], [2], [3]] : tensor<1x4x16x32xf32> into tensor<4x16x32xf32>
+  %5 = linalg.batch_matmul ins(%4, %3 : tensor<4x16x32xf32>, tensor<4x32x16xf32>) outs(%arg2 : tensor<4x16x16xf32>) -> tensor<4x16x16xf32>
+  return %5 : tensor<4x16x16xf32>
+}
+
+// CHECK: #[[MAP:.*]] = affine_map<(d0, d1) -> (d1, d0)>
+// CHECK-LABEL: func.func @fold_into_elementwise
+// CHECK-NOT: linalg.transpose
+// CHECK: linalg.generic {indexing_maps = [#[[MAP]], #{{.*}}]
+#id = affine_map<(d0, d1) -> (d0, d1)>
+func.func @fold_into_elementwise(%arg0: tensor<8x4xf32>) -> tensor<4x8xf32> {
+  %0 = tensor.empty() : tensor<4x8xf32>
+  %1 = linalg.transpose ins(%arg0 : tensor<8x4xf32>) outs(%0 : tensor<4x8xf32>) permutation = [1, 0]
+  %2 = tensor.empty() : tensor<4x8xf32>
+  %3 = linalg.generic {indexing_maps = [#id, #id], iterator_types = ["parallel", "parallel"]}
+      ins(%1 : tensor<4x8xf32>) outs(%2 : tensor<4x8xf32>) {
+  ^bb0(%in: f32, %out: f32):
+    %4 = arith.negf %in : f32
+    linalg.yield %4 : f32
+  } -> tensor<4x8xf32>
+  return %3 : tensor<4x8xf32>
+}
@@ -0,0 +1,166 @@
+// RUN: buddy-opt %s \
+// RUN:     -pooling-vectorization="strip-mining=4" \
+// RUN:     -convert-linalg-to-loops -convert-vector-to-scf -expand-strided-metadata \
+// RUN:     -lower-affine -convert-scf-to-cf -convert-vector-to-llvm \
+// RUN:     -finalize-memref-to-llvm -convert-arith-to-llvm \
+// RUN:     -convert-func-to-llvm -reconcile-unrealized-casts \
+// RUN: | mlir-cpu-runner -e main -entry-point-result=void \
+// RUN:     -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext \
+// RUN:     -shared-libs=%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+// RUN: buddy-opt %s \
+// RUN:     -convert-linalg-to-loops -convert-vector-to-scf -expand-strided-metadata \
+// RUN:     -lower-affine -convert-scf-to-cf -convert-vector-to-llvm \
+// RUN:     -finalize-memref-to-llvm -convert-arith-to-llvm \
+// RUN:     -convert-func-to-llvm -reconcile-unrealized-casts \
+// RUN: | mlir-cpu-runner -e main -entry-point-result=void \
+// RUN:     -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext \
+// RUN:     -shared-libs=%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+
+// The vectorized and the direct poolings must print the same results.
+// The outputs are filled with a value that some windows do not reach, so
+// both must reduce into the output operand. With a vector of 4 lanes, the 6
+// NHWC channels and the 6 and 7 NCHW output columns all end in a partial
+// vector. The strided NCHW max pooling gathers its input columns.
+
+module {
+  memref.global "private" @input_nhwc : memref<1x5x6x6xf32> = dense<[[[[-11.,  -8.,   0.,  -5.,  -6., -11.],
+                                                                       [ -2.,  -2.,  -8.,   1.,  -9.,   2.],
+                                                                       [-12.,  -7.,   1., -11., -10.,  -6.],
+                                                                       [  0.,  -2., -10.,  -8.,  -8.,  -2.],
+                                                                       [  0.,   3.,  -2.,  -6.,  -8.,  -4.],
+                                                                       [ -5.,   1.,   0.,  -2.,  -8.,   0.]],
+                                                                      [[ -9.,  -4.,   0.,   3.,  -2., -10.],
+                                                                       [ -3.,  -2.,  -3., -11.,  -7.,   4.],
+                                                                       [-10.,  -5., -11., -10., -11.,   3.],
+                                                                       [ -6.,   3.,  -2.,  -9.,  -5.,  -7.],
+                                                                       [ -8.,  -9.,   0.,  -6.,  -9.,  -4.],
+                                                                       [ -1.,  -7., -12.,  -7.,  -1.,  -8.]],
+                                                                      [[-12., -11.,  -4., -10.,   4.,   4.],
+                                                                       [ -8., -10.,   4.,   2.,  -9.,   3.],
+                                                                       [-11.,  -2.,   2.,  -1.,  -1.,  -7.],
+                                                                       [  2., -10.,  -9.,   4.,  -5.,  -8.],
+                                                                       [  3.,   4.,  -8.,   1.,  -2.,   3.],
+                                                                       [  3.,  -6.,  -1.,  -5.,  -4.,  -5.]],
+                                                                      [[ -3., -10.,  -2.,  -5., -11., -10.],
+                                                                       [-10.,  -2.,  -4.,  -8.,  -5.,  -5.],
+                                                                       [ -9.,  -3., -12.,  -7.,  -3.,   1.],
+                                                                       [ -7.,   4.,  -3.,   4.,  -3.,  -5.],
+                                                                       [ -1.,  -5.,  -8.,  -7.,  -1.,  -3.],
+                                                                       [-10.,  -6.,   3.,  -2.,  -3.,  -5.]],
+                                                                      [[ -5.,   4.,  -4.,  -6.,  -8.,   2.],
+                                                                       [ -6.,  -6.,  -8.,  -3.,  -5.,  -1.],
+                                                                       [ -6.,   4., -12.,  -7.,  -2.,  -2.],
+                                                                       [ -2.,  -6.,  -8.,  -9.,   0.,  -6.],
+                                                                       [ -5., -10.,   3.,  -3.,  -1.,  -4.],
+                                                                       [-10.,   2.,   0.,  -3.,  -9.,  -6.]]]]>
+  memref.global "private" @input_nchw_i32 : memref<1x2x5x15xi32> = dense<[[[[-11, -10,  -5,  -6,  -7,  -9,  -5,  -5,  -3,  -9,   2,  -6,  -2,   1, -12],
+                                                                            [ -7,   2,   2,   2,  -8, -12,   0,  -8,   0,  -9,  -1,  -9,   1,  -2,  -4],
+                                                                            [ -8,  -3, -11,  -8,  -4,  -3, -10,   2,  -6,  -3,  -5,   1,  -5, -12, -12],
+                                                                            [ -7,  -7,  -7,  -5,   1,  -5, -12,  -6, -12,  -7,  -5,  -2,   1,   0,  -9],
+                                                                            [ -3,   1,  -4,  -7,  -5,  -6,  -7,  -7,  -2,  -7,  -5,  -9,  -5,   2,  -3]],
+                                                                           [[-10, -10, -12,  -1,   1, -11,   1,  -3, -12,   2,  -6,   0,  -3,   0, -12],
+                                                                            [ -3,  -4, -10,  -8, -10,  -8,   1,  -3,   2,   1,  -4,   1, -12,   0,  -8],
+                                                                            [ -6,   1,   2,  -3,   2, -12,   2,  -7,  -4,   0,  -7,  -6,  -3, -10,  -4],
+                                                                            [  1, -11,   0,  -4,  -5, -10,   2,  -6, -10, -11,   0,  -1,  -1,  -1,   1],
+                                                                            [  1,   1,  -8,   0, -11,   1, -11,   2,  -1,  -8,  -6,  -2, -12,   1,  -5]]]]>
+  memref.global "private" @input_nchw : memref<2x2x5x9xf32> = dense<[[[[  7.,  -7.,   3.,  -5.,  -8.,   3.,  -4.,  -8.,   3.],
+                                                                       [  0.,   8.,  -6.,   7.,   1.,   8.,  -8.,   5.,   7.],
+                                                                       [ -4.,   7.,   8.,  -7.,  -1.,   1.,   5.,  -9.,  -2.],
+                                                                       [  9.,   5.,   1.,  -9.,   3.,  -8.,  -7.,   7.,  -4.],
+                                                                       [  0.,  -5.,   8.,  -4.,  -8.,  -1.,  -9.,   1.,  -6.]],
+                                                                      [[ -3.,   3.,  -9.,   2.,   8.,  -5.,   3.,  -1.,   3.],
+                                                                       [  4.,   9.,   1.,  -8.,  -2.,  -7.,   6.,   9.,   6.],
+                                                                       [ -3.,  -4.,   6.,  -8.,   3.,  -5.,  -4.,   4.,  -5.],
+                                                                       [ -1.,   5.,   0.,   0.,  -4.,  -6.,  -6.,  -2.,  -4.],
+                                                                       [ -8.,   4.,   9.,   7.,  -7.,   7.,   3.,  -1.,  -2.]]],
+                                                                     [[[ -1.,  -7.,   0.,  -5.,   1.,   5.,  -8.,  -7.,   5.],
+                                                                       [ -5.,  -8.,   4.,  -2.,  -4.,   9.,  -9.,  -8.,   6.],
+                                                                       [  2.,  -9.,   4.,  -2.,   4.,  -4.,   2.,  -2.,   5.],
+                                                                       [  4.,  -8.,  -8.,   7.,  -6.,   7.,  -7.,   0.,  -9.],
+                                                                       [  4.,   0.,  -3.,   4.,  -6.,   9.,   9.,   1.,  -2.]],
+                                                                      [[  4.,   4.,  -7.,   9.,   0.,  -7.,  -7.,  -4.,   7.],
+                                                                       [ -1.,  -7.,   0.,  -1.,  -9.,   6.,  -4.,  -9.,   1.],
+                                                                       [ -8.,   2.,   0.,   0.,   8.,   5.,   8.,   7.,  -5.],
+                                                                       [  7.,   5.,   9.,   9.,   8.,   1.,  -3.,   7.,  -7.],
+                                                                       [  0.,  -4.,   4.,  -8.,  -8.,  -7.,   6.,  -7.,   1.]]]]>
+
+  func.func private @printMemrefF32(memref<*xf32>)
+  func.func private @printMemrefI32(memref<*xi32>)
+
+  func.func @main() {
+    %zero = arith.constant 0. : f32
+    %one = arith.constant 1. : f32
+    %low = arith.constant -3 : i32
+    %inputNhwc = memref.get_global @input_nhwc : memref<1x5x6x6xf32>
+    %inputNchwI32 = memref.get_global @input_nchw_i32 : memref<1x2x5x15xi32>
+    %inputNchw = memref.get_global @input_nchw : memref<2x2x5x9xf32>
+
+    // NHWC max pooling with stride 2.
+    %windowNhwc = memref.alloc() : memref<2x2xf32>
+    %outputNhwc = memref.alloc() : memref<1x2x3x6xf32>
+    linalg.fill ins(%zero : f32) outs(%outputNhwc : memref<1x2x3x6xf32>)
+    linalg.pooling_nhwc_max {dilations = dense<1> : tensor<2xi64>, strides = dense<2> : tensor<2xi64>}
+      ins(%inputNhwc, %windowNhwc : memref<1x5x6x6xf32>, memref<2x2xf32>)
+      outs(%outputNhwc : memref<1x2x3x6xf32>)
+    %collapsedNhwc = memref.collapse_shape %outputNhwc [[0, 1, 2], [3]] : memref<1x2x3x6xf32> into memref<6x6xf32>
+    %printedNhwc = memref.cast %collapsedNhwc : memref<6x6xf32> to memref<*xf32>
+    call @printMemrefF32(%printedNhwc) : (memref<*xf32>) -> ()
+    // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[6, 6\] strides = \[6, 1\] data =}}
+    // CHECK{LITERAL}: [[0, 0, 0, 3, 0, 4],
+    // CHECK{LITERAL}: [0, 3, 1, 0, 0, 3],
+    // CHECK{LITERAL}: [0, 3, 0, 0, 0, 0],
+    // CHECK{LITERAL}: [0, 0, 4, 2, 4, 4],
+    // CHECK{LITERAL}: [2, 4, 2, 4, 0, 1],
+    // CHECK{LITERAL}: [3, 4, 3, 1, 0, 3]]
+
+    // NCHW max pooling of integers with stride 2 and a column dilation of 2.
+    %windowNchwI32 = memref.alloc() : memref<2x3xi32>
+    %outputNchwI32 = memref.alloc() : memref<1x2x2x6xi32>
+    linalg.fill ins(%low : i32) outs(%outputNchwI32 : memref<1x2x2x6xi32>)
+    linalg.pooling_nchw_max {dilations = dense<[1, 2]> : tensor<2xi64>, strides = dense<2> : tensor<2xi64>}
+      ins(%inputNchwI32, %windowNchwI32 : memref<1x2x5x15xi32>, memref<2x3xi32>)
+      outs(%outputNchwI32 : memref<1x2x2x6xi32>)
+    %collapsedNchwI32 = memref.collapse_shape %outputNchwI32 [[0, 1, 2], [3]] : memref<1x2x2x6xi32> into memref<4x6xi32>
+    %printedNchwI32 = memref.cast %collapsedNchwI32 : memref<4x6xi32> to memref<*xi32>
+    call @printMemrefI32(%printedNchwI32) : (memref<*xi32>) -> ()
+    // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[4, 6\] strides = \[6, 1\] data =}}
+    // CHECK{LITERAL}: [[2, 2, 0, 2, 2, 2],
+    // CHECK{LITERAL}: [1, 1, 1, -3, 1, 1],
+    // CHECK{LITERAL}: [1, 1, 2, 2, 2, -3],
+    // CHECK{LITERAL}: [2, 2, 2, 2, 0, 1]]
+
+    // NCHW sum pooling with stride 1.
+    %windowNchw = memref.alloc() : memref<3x3xf32>
+    %outputNchw = memref.alloc() : memref<2x2x3x7xf32>
+    linalg.fill ins(%one : f32) outs(%outputNchw : memref<2x2x3x7xf32>)
+    linalg.pooling_nchw_sum {dilations = dense<1> : tensor<2xi64>, strides = dense<1> : tensor<2xi64>}
+      ins(%inputNchw, %windowNchw : memref<2x2x5x9xf32>, memref<3x3xf32>)
+      outs(%outputNchw : memref<2x2x3x7xf32>)
+    %collapsedNchw = memref.collapse_shape %outputNchw [[0, 1, 2], [3]] : memref<2x2x3x7xf32> into memref<12x7xf32>
+    %printedNchw = memref.cast %collapsedNchw : memref<12x7xf32> to memref<*xf32>
+    call @printMemrefF32(%printedNchw) : (memref<*xf32>) -> ()
+    // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[12, 7\] strides = \[7, 1\] data =}}
+    // CHECK{LITERAL}: [[17, 9, -7, 0, -2, -6, -10],
+    // CHECK{LITERAL}: [29, 15, -2, -4, -5, -5, -5],
+    // CHECK{LITERAL}: [30, 5, -8, -33, -24, -19, -23],
+    // CHECK{LITERAL}: [5, -7, -6, -21, -2, 1, 22],
+    // CHECK{LITERAL}: [18, 2, -11, -36, -24, -10, 5],
+    // CHECK{LITERAL}: [9, 20, 7, -12, -18, -9, -16],
+    // CHECK{LITERAL}: [-19, -24, 1, 3, -3, -21, -15],
+    // CHECK{LITERAL}: [-23, -21, -2, 10, -7, -11, -21],
+    // CHECK{LITERAL}: [-13, -14, -5, 14, 9, 16, -2],
+    // CHECK{LITERAL}: [-12, 1, 1, 12, 1, -4, -5],
+    // CHECK{LITERAL}: [8, 18, 25, 28, 21, 19, -4],
+    // CHECK{LITERAL}: [16, 18, 23, 9, 19, 18, 8]]
+
+    memref.dealloc %windowNhwc : memref<2x2xf32>
+    memref.dealloc %outputNhwc : memref<1x2x3x6xf32>
+    memref.dealloc %windowNchwI32 : memref<2x3xi32>
+    memref.dealloc %outputNchwI32 : memref<1x2x2x6xi32>
+    memref.dealloc %windowNchw : memref<3x3xf32>
+    memref.dealloc %outputNchw : memref<2x2x3x7xf32>
+    return
+  }
+}
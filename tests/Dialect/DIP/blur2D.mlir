@@ -0,0 +1,141 @@
+//
+// x86
+//
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=4" -arith-expand --convert-vector-to-scf --lower-affine --convert-scf-to-cf --convert-vector-to-llvm \
+// RUN: --convert-math-to-llvm --finalize-memref-to-llvm --convert-arith-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=4 DIP-parallel-tile-rows=2" -arith-expand --convert-vector-to-scf --lower-affine --convert-scf-to-cf --convert-vector-to-llvm \
+// RUN: --convert-math-to-llvm --finalize-memref-to-llvm --convert-arith-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+
+// Box filters use running sums and Gaussian blurs three box filters: widths
+// 1, 1, 3 for sigma 1 and 3, 3, 5 for sigma 2. 8-bit images are unsigned and
+// their results are rounded to nearest.
+
+memref.global "private" @global_input_u8 : memref<3x5xi8> = dense<[[10, 20, 60, 40, 0],
+                                                                   [0, 30, 30, 10, 250],
+                                                                   [5, 5, 50, 20, 100]]>
+
+memref.global "private" @global_input_f32 : memref<4x5xf32> = dense<[[0. , 1. , 2. , 3. , 4. ],
+                                                                     [5. , 6. , 7. , 8. , 9. ],
+                                                                     [10., 11., 12., 13., 14.],
+                                                                     [15., 16., 17., 18., 19.]]>
+
+memref.global "private" @global_input_small : memref<2x3xf32> = dense<[[0.5, 1., 2.],
+                                                                       [4., 8., 16.25]]>
+
+memref.global "private" @global_integral_u8 : memref<4x6xi32> = dense<0>
+
+memref.global "private" @global_integral_f32 : memref<3x4xf32> = dense<0.>
+
+memref.global "private" @global_box_f32 : memref<4x5xf32> = dense<0.>
+
+memref.global "private" @global_box_u8 : memref<3x5xi8> = dense<0>
+
+memref.global "private" @global_gaussian_u8 : memref<3x5xi8> = dense<0>
+
+memref.global "private" @global_gaussian_f32 : memref<4x5xf32> = dense<0.>
+
+func.func private @printMemrefF32(memref<*xf32>) attributes { llvm.emit_c_interface }
+
+func.func private @printMemrefI32(memref<*xi32>) attributes { llvm.emit_c_interface }
+
+// Prints an 8-bit image as unsigned values.
+func.func @printU8(%image : memref<?x?xi8>) {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %rows = memref.dim %image, %c0 : memref<?x?xi8>
+  %cols = memref.dim %image, %c1 : memref<?x?xi8>
+  %wide = memref.alloc(%rows, %cols) : memref<?x?xi32>
+  scf.for %i = %c0 to %rows step %c1 {
+    scf.for %j = %c0 to %cols step %c1 {
+      %val = memref.load %image[%i, %j] : memref<?x?xi8>
+      %ext = arith.extui %val : i8 to i32
+      memref.store %ext, %wide[%i, %j] : memref<?x?xi32>
+    }
+  }
+  %printed = memref.cast %wide : memref<?x?xi32> to memref<*xi32>
+  call @printMemrefI32(%printed) : (memref<*xi32>) -> ()
+  memref.dealloc %wide : memref<?x?xi32>
+  return
+}
+
+func.func @main() -> i32 {
+  %inputU8 = memref.get_global @global_input_u8 : memref<3x5xi8>
+  %inputF32 = memref.get_global @global_input_f32 : memref<4x5xf32>
+  %inputSmall = memref.get_global @global_input_small : memref<2x3xf32>
+  %integralU8 = memref.get_global @global_integral_u8 : memref<4x6xi32>
+  %integralF32 = memref.get_global @global_integral_f32 : memref<3x4xf32>
+  %boxF32 = memref.get_global @global_box_f32 : memref<4x5xf32>
+  %boxU8 = memref.get_global @global_box_u8 : memref<3x5xi8>
+  %gaussianU8 = memref.get_global @global_gaussian_u8 : memref<3x5xi8>
+  %gaussianF32 = memref.get_global @global_gaussian_f32 : memref<4x5xf32>
+
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c2 = arith.constant 2 : index
+  %c3 = arith.constant 3 : index
+  %zero = arith.constant 0 : i8
+  %padding = arith.constant -9. : f32
+  %one = arith.constant 1. : f32
+  %two = arith.constant 2. : f32
+
+  dip.integral_image %inputU8, %integralU8 : memref<3x5xi8>, memref<4x6xi32>
+  dip.integral_image %inputSmall, %integralF32 : memref<2x3xf32>, memref<3x4xf32>
+  dip.box_filter <CONSTANT_PADDING> %inputF32, %boxF32, %c3, %c3, %c1, %c1, %padding : memref<4x5xf32>, memref<4x5xf32>, index, index, index, index, f32
+  dip.box_filter <REPLICATE_PADDING> %inputU8, %boxU8, %c3, %c2, %c1, %c0, %zero : memref<3x5xi8>, memref<3x5xi8>, index, index, index, index, i8
+  dip.gaussian_blur <REPLICATE_PADDING> %inputU8, %gaussianU8, %one, %two, %zero : memref<3x5xi8>, memref<3x5xi8>, f32, f32, i8
+  dip.gaussian_blur <CONSTANT_PADDING> %inputF32, %gaussianF32, %two, %one, %one : memref<4x5xf32>, memref<4x5xf32>, f32, f32, f32
+
+  %printed_integral_u8 = memref.cast %integralU8 : memref<4x6xi32> to memref<*xi32>
+  call @printMemrefI32(%printed_integral_u8) : (memref<*xi32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[4, 6\] strides = \[6, 1\] data =}}
+  // CHECK{LITERAL}: [[0, 0, 0, 0, 0, 0],
+  // CHECK{LITERAL}: [0, 10, 30, 90, 130, 130],
+  // CHECK{LITERAL}: [0, 10, 60, 150, 200, 450],
+  // CHECK{LITERAL}: [0, 15, 70, 210, 280, 630]]
+
+  %printed_integral_f32 = memref.cast %integralF32 : memref<3x4xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_integral_f32) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[3, 4\] strides = \[4, 1\] data =}}
+  // CHECK{LITERAL}: [[0, 0, 0, 0],
+  // CHECK{LITERAL}: [0, 0.5, 1.5, 3.5],
+  // CHECK{LITERAL}: [0, 4.5, 13.5, 31.75]]
+
+  %printed_box_f32 = memref.cast %boxF32 : memref<4x5xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_box_f32) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[4, 5\] strides = \[5, 1\] data =}}
+  // CHECK{LITERAL}: [[-3.66667, -0.666667, 0, 0.666667, -2.33333],
+  // CHECK{LITERAL}: [0.666667, 6, 7, 8, 2.66667],
+  // CHECK{LITERAL}: [4, 11, 12, 13, 6],
+  // CHECK{LITERAL}: [0.777778, 6, 6.66667, 7.33333, 2.11111]]
+
+  %box_u8 = memref.cast %boxU8 : memref<3x5xi8> to memref<?x?xi8>
+  call @printU8(%box_u8) : (memref<?x?xi8>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[3, 5\] strides = \[5, 1\] data =}}
+  // CHECK{LITERAL}: [[12, 25, 32, 65, 92],
+  // CHECK{LITERAL}: [8, 20, 24, 77, 122],
+  // CHECK{LITERAL}: [5, 20, 25, 57, 73]]
+
+  %gaussian_u8 = memref.cast %gaussianU8 : memref<3x5xi8> to memref<?x?xi8>
+  call @printU8(%gaussian_u8) : (memref<?x?xi8>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[3, 5\] strides = \[5, 1\] data =}}
+  // CHECK{LITERAL}: [[10, 24, 31, 60, 80],
+  // CHECK{LITERAL}: [9, 23, 29, 62, 86],
+  // CHECK{LITERAL}: [9, 22, 28, 64, 91]]
+
+  %printed_gaussian_f32 = memref.cast %gaussianF32 : memref<4x5xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_gaussian_f32) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[4, 5\] strides = \[5, 1\] data =}}
+  // CHECK{LITERAL}: [[1.96296, 2.46667, 2.81481, 2.64444, 2.31852],
+  // CHECK{LITERAL}: [3.66667, 4.86667, 5.66667, 5.13333, 4.2],
+  // CHECK{LITERAL}: [6.11111, 8.2, 9.55556, 8.46667, 6.64444],
+  // CHECK{LITERAL}: [5.22222, 6.91111, 8, 7.08889, 5.57778]]
+
+  %ret = arith.constant 0 : i32
+  return %ret : i32
+}
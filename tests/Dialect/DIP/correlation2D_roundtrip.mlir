@@ -59,3 +59,9 @@ func.func @buddy_corr2d_REPLICATE_PADDING_i64(%input : memref<?x?xi64>, %identit
   dip.corr_2d <REPLICATE_PADDING> %input, %identity, %output, %kernelAnchorX, %kernelAnchorY, %c : memref<?x?xi64>, memref<?x?xi64>, memref<?x?xi64>, index, index, i64
   return
 }
+
+func.func @buddy_corr2d_separable_CONSTANT_PADDING_f32(%input : memref<?x?xf32>, %kernelX : memref<?xf32>, %kernelY : memref<?xf32>, %output : memref<?x?xf32>, %kernelAnchorX : index, %kernelAnchorY : index, %c : f32) -> () {
+  // CHECK: dip.corr_2d_separable <CONSTANT_PADDING>{{.*}} : memref<?x?xf32>, memref<?xf32>, memref<?xf32>, memref<?x?xf32>, index, index, f32
+  dip.corr_2d_separable <CONSTANT_PADDING> %input, %kernelX, %kernelY, %output, %kernelAnchorX, %kernelAnchorY, %c : memref<?x?xf32>, memref<?xf32>, memref<?xf32>, memref<?x?xf32>, index, index, f32
+  return
+}
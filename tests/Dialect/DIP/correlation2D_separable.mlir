@@ -0,0 +1,50 @@
+//
+// x86
+//
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=64" -arith-expand --convert-vector-to-scf --lower-affine --convert-scf-to-cf --convert-vector-to-llvm \
+// RUN: --finalize-memref-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+
+memref.global "private" @global_input : memref<3x3xf32> = dense<[[0. , 1. , 2. ],
+                                                                 [10., 11., 12.],
+                                                                 [20., 21., 22.]]>
+
+memref.global "private" @global_kernel_x : memref<3xf32> = dense<[1., 2., 1.]>
+
+memref.global "private" @global_kernel_y : memref<3xf32> = dense<[1., 0., -1.]>
+
+memref.global "private" @global_output : memref<3x3xf32> = dense<[[0., 0., 0.],
+                                                                  [0., 0., 0.],
+                                                                  [0., 0., 0.]]>
+func.func private @printMemrefF32(memref<*xf32>) attributes { llvm.emit_c_interface }
+
+func.func @main() -> i32 {
+  %input = memref.get_global @global_input : memref<3x3xf32>
+  %kernelX = memref.get_global @global_kernel_x : memref<3xf32>
+  %kernelY = memref.get_global @global_kernel_y : memref<3xf32>
+  %output = memref.get_global @global_output : memref<3x3xf32>
+
+  %kernelAnchorX = arith.constant 1 : index
+  %kernelAnchorY = arith.constant 1 : index
+  %c = arith.constant 0. : f32
+  %printed_output = memref.cast %output : memref<3x3xf32> to memref<*xf32>
+
+  dip.corr_2d_separable <CONSTANT_PADDING> %input, %kernelX, %kernelY, %output, %kernelAnchorX, %kernelAnchorY, %c : memref<3x3xf32>, memref<3xf32>, memref<3xf32>, memref<3x3xf32>, index, index, f32
+  call @printMemrefF32(%printed_output) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[3, 3\] strides = \[3, 1\] data =}}
+  // CHECK{LITERAL}: [[-31, -44, -35],
+  // CHECK{LITERAL}: [-60, -80, -60],
+  // CHECK{LITERAL}: [31, 44, 35]]
+
+  dip.corr_2d_separable <REPLICATE_PADDING> %input, %kernelX, %kernelY, %output, %kernelAnchorX, %kernelAnchorY, %c : memref<3x3xf32>, memref<3xf32>, memref<3xf32>, memref<3x3xf32>, index, index, f32
+  call @printMemrefF32(%printed_output) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[3, 3\] strides = \[3, 1\] data =}}
+  // CHECK{LITERAL}: [[-40, -40, -40],
+  // CHECK{LITERAL}: [-80, -80, -80],
+  // CHECK{LITERAL}: [-40, -40, -40]]
+
+  %ret = arith.constant 0 : i32
+  return %ret : i32
+}
@@ -0,0 +1,111 @@
+//
+// x86
+//
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=4" -arith-expand --convert-vector-to-scf --lower-affine --convert-scf-to-cf --convert-vector-to-llvm \
+// RUN: --convert-math-to-llvm --finalize-memref-to-llvm --convert-arith-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+
+// Rows of length 12 take the mixed-radix path, rows of length 7 fall back to
+// Bluestein's algorithm. The FFT correlations are compared with the circular
+// convolutions given by a reference DFT, and the 2x7 spectrum, which is in
+// natural order, with the reference DFT scaled by 10. Results are rounded to
+// integers before printing.
+
+memref.global "private" @global_input_12 : memref<2x12xf32> = dense<[[0., 5., 3., 1., 6., 4., 2., 0., 5., 3., 1., 6.],
+                                                                     [3., 1., 6., 4., 2., 0., 5., 3., 1., 6., 4., 2.]]>
+
+memref.global "private" @global_kernel_12 : memref<2x12xf32> = dense<[[1., 2., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0. ],
+                                                                      [0., 0., 0., 0., 0., 3., 0., 0., 0., 0., 0., -1.]]>
+
+memref.global "private" @global_input_7 : memref<2x7xf32> = dense<[[0., 3., 1., 4., 2., 0., 3.],
+                                                                   [2., 0., 3., 1., 4., 2., 0.]]>
+
+memref.global "private" @global_kernel_7 : memref<2x7xf32> = dense<[[2., 0., 0., -1., 0., 0., 0.],
+                                                                    [0., 0., 0., 0. , 0., 0., 1.]]>
+
+memref.global "private" @global_signal_7 : memref<2x7xf32> = dense<[[1., 2., 0., -1., 3. , 0., 2.],
+                                                                    [0., 1., 1., 0. , -2., 1., 0.]]>
+
+memref.global "private" @global_imag_12 : memref<2x12xf32> = dense<0.>
+memref.global "private" @global_kernel_imag_12 : memref<2x12xf32> = dense<0.>
+memref.global "private" @global_intermediate_real_12 : memref<12x2xf32> = dense<0.>
+memref.global "private" @global_intermediate_imag_12 : memref<12x2xf32> = dense<0.>
+memref.global "private" @global_imag_7 : memref<2x7xf32> = dense<0.>
+memref.global "private" @global_kernel_imag_7 : memref<2x7xf32> = dense<0.>
+memref.global "private" @global_signal_imag_7 : memref<2x7xf32> = dense<0.>
+memref.global "private" @global_intermediate_real_7 : memref<7x2xf32> = dense<0.>
+memref.global "private" @global_intermediate_imag_7 : memref<7x2xf32> = dense<0.>
+
+func.func private @printMemrefF32(memref<*xf32>) attributes { llvm.emit_c_interface }
+
+// Replaces every element x of %m by roundeven(x * %scale) and prints %m.
+func.func @round_and_print(%m : memref<?x?xf32>, %scale : f32) {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %zero = arith.constant 0. : f32
+  %rows = memref.dim %m, %c0 : memref<?x?xf32>
+  %cols = memref.dim %m, %c1 : memref<?x?xf32>
+  scf.for %i = %c0 to %rows step %c1 {
+    scf.for %j = %c0 to %cols step %c1 {
+      %x = memref.load %m[%i, %j] : memref<?x?xf32>
+      %scaled = arith.mulf %x, %scale : f32
+      %rounded = math.roundeven %scaled : f32
+      // Adding zero turns -0 into 0.
+      %res = arith.addf %rounded, %zero : f32
+      memref.store %res, %m[%i, %j] : memref<?x?xf32>
+    }
+  }
+  %printed = memref.cast %m : memref<?x?xf32> to memref<*xf32>
+  call @printMemrefF32(%printed) : (memref<*xf32>) -> ()
+  return
+}
+
+func.func @main() -> i32 {
+  %one = arith.constant 1. : f32
+  %ten = arith.constant 10. : f32
+
+  %input12 = memref.get_global @global_input_12 : memref<2x12xf32>
+  %imag12 = memref.get_global @global_imag_12 : memref<2x12xf32>
+  %kernel12 = memref.get_global @global_kernel_12 : memref<2x12xf32>
+  %kernelImag12 = memref.get_global @global_kernel_imag_12 : memref<2x12xf32>
+  %intReal12 = memref.get_global @global_intermediate_real_12 : memref<12x2xf32>
+  %intImag12 = memref.get_global @global_intermediate_imag_12 : memref<12x2xf32>
+  dip.corrfft_2d %input12, %imag12, %kernel12, %kernelImag12, %intReal12, %intImag12 : memref<2x12xf32>, memref<2x12xf32>, memref<2x12xf32>, memref<2x12xf32>, memref<12x2xf32>, memref<12x2xf32>
+  %result12 = memref.cast %input12 : memref<2x12xf32> to memref<?x?xf32>
+  call @round_and_print(%result12, %one) : (memref<?x?xf32>, f32) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[2, 12\] strides = \[12, 1\] data =}}
+  // CHECK{LITERAL}: [[20, 2, 27, 17, 14, 20, 10, 21, 11, 15, 5, 20],
+  // CHECK{LITERAL}: [2, 19, 16, 13, 24, 2, 20, 17, 7, 25, 22, 16]]
+
+  %input7 = memref.get_global @global_input_7 : memref<2x7xf32>
+  %imag7 = memref.get_global @global_imag_7 : memref<2x7xf32>
+  %kernel7 = memref.get_global @global_kernel_7 : memref<2x7xf32>
+  %kernelImag7 = memref.get_global @global_kernel_imag_7 : memref<2x7xf32>
+  %intReal7 = memref.get_global @global_intermediate_real_7 : memref<7x2xf32>
+  %intImag7 = memref.get_global @global_intermediate_imag_7 : memref<7x2xf32>
+  dip.corrfft_2d %input7, %imag7, %kernel7, %kernelImag7, %intReal7, %intImag7 : memref<2x7xf32>, memref<2x7xf32>, memref<2x7xf32>, memref<2x7xf32>, memref<7x2xf32>, memref<7x2xf32>
+  %result7 = memref.cast %input7 : memref<2x7xf32> to memref<?x?xf32>
+  call @round_and_print(%result7, %one) : (memref<?x?xf32>, f32) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[2, 7\] strides = \[7, 1\] data =}}
+  // CHECK{LITERAL}: [[-2, 9, 0, 12, 3, -1, 4],
+  // CHECK{LITERAL}: [3, -1, 10, 2, 8, 4, -1]]
+
+  %signal7 = memref.get_global @global_signal_7 : memref<2x7xf32>
+  %signalImag7 = memref.get_global @global_signal_imag_7 : memref<2x7xf32>
+  dip.fft_2d %signal7, %signalImag7, %intReal7, %intImag7 : memref<2x7xf32>, memref<2x7xf32>, memref<7x2xf32>, memref<7x2xf32>
+  %spectrumReal7 = memref.cast %signal7 : memref<2x7xf32> to memref<?x?xf32>
+  %spectrumImag7 = memref.cast %signalImag7 : memref<2x7xf32> to memref<?x?xf32>
+  call @round_and_print(%spectrumReal7, %ten) : (memref<?x?xf32>, f32) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[2, 7\] strides = \[7, 1\] data =}}
+  // CHECK{LITERAL}: [[80, 37, -19, -23, -23, -19, 37],
+  // CHECK{LITERAL}: [60, -3, 46, -38, -38, 46, -3]]
+  call @round_and_print(%spectrumImag7, %ten) : (memref<?x?xf32>, f32) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[2, 7\] strides = \[7, 1\] data =}}
+  // CHECK{LITERAL}: [[0, 1, -25, 15, -15, 25, -1],
+  // CHECK{LITERAL}: [0, 34, -37, 63, -63, 37, -34]]
+
+  %ret = arith.constant 0 : i32
+  return %ret : i32
+}
@@ -0,0 +1,13 @@
+// RUN: buddy-opt -verify-diagnostics %s | buddy-opt | FileCheck %s
+
+func.func @buddy_fft2d(%real : memref<?x?xf32>, %imag : memref<?x?xf32>, %intReal : memref<?x?xf32>, %intImag : memref<?x?xf32>) -> () {
+  // CHECK: dip.fft_2d {{.*}} : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>
+  dip.fft_2d %real, %imag, %intReal, %intImag : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>
+  return
+}
+
+func.func @buddy_corrfft2d_spectrum(%inReal : memref<?x?xf32>, %inImag : memref<?x?xf32>, %kReal : memref<?x?xf32>, %kImag : memref<?x?xf32>, %intReal : memref<?x?xf32>, %intImag : memref<?x?xf32>) -> () {
+  // CHECK: dip.corrfft_2d_spectrum {{.*}} : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>
+  dip.corrfft_2d_spectrum %inReal, %inImag, %kReal, %kImag, %intReal, %intImag : memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>, memref<?x?xf32>
+  return
+}
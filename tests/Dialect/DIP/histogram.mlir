@@ -0,0 +1,148 @@
+//
+// x86
+//
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=4" -arith-expand --convert-vector-to-scf --expand-strided-metadata --lower-affine --convert-scf-to-cf --convert-vector-to-llvm \
+// RUN: --convert-math-to-llvm --finalize-memref-to-llvm --convert-arith-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=4 DIP-parallel-tile-rows=2" -arith-expand --convert-vector-to-scf --expand-strided-metadata --lower-affine --convert-scf-to-cf --convert-vector-to-llvm \
+// RUN: --convert-math-to-llvm --finalize-memref-to-llvm --convert-arith-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+
+// Histograms have 256 bins and are printed as 16x16 matrices. Equalization
+// maps the darkest level to 0 and the brightest to 255, and leaves images with
+// a single level unchanged.
+
+memref.global "private" @global_input : memref<3x6xi8> = dense<[[10, 200, 30, 255, 0, 77],
+                                                                [90, 200, 130, 40, 30, 180],
+                                                                [5, 250, 30, 100, 35, 77]]>
+
+memref.global "private" @global_input_flat : memref<2x2xi8> = dense<7>
+
+memref.global "private" @global_input_hwc : memref<2x2x3xi8> = dense<[[[10, 20, 30], [40, 50, 60]],
+                                                                      [[0, 128, 255], [200, 100, 1]]]>
+
+memref.global "private" @global_hist : memref<256xi32> = dense<0>
+
+memref.global "private" @global_output : memref<3x6xi8> = dense<0>
+
+memref.global "private" @global_output_flat : memref<2x2xi8> = dense<0>
+
+memref.global "private" @global_output_hwc : memref<2x2x3xi8> = dense<0>
+
+memref.global "private" @global_output_f32 : memref<3x6xf32> = dense<0.>
+
+func.func private @printMemrefF32(memref<*xf32>) attributes { llvm.emit_c_interface }
+func.func private @printMemrefI32(memref<*xi32>) attributes { llvm.emit_c_interface }
+
+// Prints an 8-bit image as unsigned values.
+func.func @printU8(%image : memref<?x?xi8>) {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %rows = memref.dim %image, %c0 : memref<?x?xi8>
+  %cols = memref.dim %image, %c1 : memref<?x?xi8>
+  %wide = memref.alloc(%rows, %cols) : memref<?x?xi32>
+  scf.for %i = %c0 to %rows step %c1 {
+    scf.for %j = %c0 to %cols step %c1 {
+      %val = memref.load %image[%i, %j] : memref<?x?xi8>
+      %ext = arith.extui %val : i8 to i32
+      memref.store %ext, %wide[%i, %j] : memref<?x?xi32>
+    }
+  }
+  %printed = memref.cast %wide : memref<?x?xi32> to memref<*xi32>
+  call @printMemrefI32(%printed) : (memref<*xi32>) -> ()
+  memref.dealloc %wide : memref<?x?xi32>
+  return
+}
+
+func.func @main() -> i32 {
+  %input = memref.get_global @global_input : memref<3x6xi8>
+  %inputFlat = memref.get_global @global_input_flat : memref<2x2xi8>
+  %inputHWC = memref.get_global @global_input_hwc : memref<2x2x3xi8>
+  %hist = memref.get_global @global_hist : memref<256xi32>
+  %output = memref.get_global @global_output : memref<3x6xi8>
+  %outputFlat = memref.get_global @global_output_flat : memref<2x2xi8>
+  %outputHWC = memref.get_global @global_output_hwc : memref<2x2x3xi8>
+  %outputF32 = memref.get_global @global_output_f32 : memref<3x6xf32>
+
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c256 = arith.constant 256 : index
+  %c255 = arith.constant 255 : i32
+  %half = arith.constant 0.5 : f32
+
+  // Build an inverting table and a table scaling levels by 0.5.
+  %invert = memref.alloc() : memref<256xi8>
+  %scale = memref.alloc() : memref<256xf32>
+  scf.for %i = %c0 to %c256 step %c1 {
+    %level = arith.index_cast %i : index to i32
+    %inverted = arith.subi %c255, %level : i32
+    %invertedU8 = arith.trunci %inverted : i32 to i8
+    memref.store %invertedU8, %invert[%i] : memref<256xi8>
+    %levelF32 = arith.sitofp %level : i32 to f32
+    %scaled = arith.mulf %levelF32, %half : f32
+    memref.store %scaled, %scale[%i] : memref<256xf32>
+  }
+
+  dip.histogram %input, %hist : memref<3x6xi8>, memref<256xi32>
+  %bins = memref.expand_shape %hist [[0, 1]] : memref<256xi32> into memref<16x16xi32>
+  %printed_hist = memref.cast %bins : memref<16x16xi32> to memref<*xi32>
+  call @printMemrefI32(%printed_hist) : (memref<*xi32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[16, 16\] strides = \[16, 1\] data =}}
+  // CHECK{LITERAL}: [[1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0],
+  // CHECK{LITERAL}: [0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 0],
+  // CHECK{LITERAL}: [0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0],
+  // CHECK{LITERAL}: [0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0],
+  // CHECK{LITERAL}: [0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0],
+  // CHECK{LITERAL}: [0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0],
+  // CHECK{LITERAL}: [0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0],
+  // CHECK{LITERAL}: [0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0],
+  // CHECK{LITERAL}: [0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0],
+  // CHECK{LITERAL}: [0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0],
+  // CHECK{LITERAL}: [0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0],
+  // CHECK{LITERAL}: [0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0],
+  // CHECK{LITERAL}: [0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0],
+  // CHECK{LITERAL}: [0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0],
+  // CHECK{LITERAL}: [0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0],
+  // CHECK{LITERAL}: [0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1]]
+
+  dip.equalize_hist %input, %output : memref<3x6xi8>, memref<3x6xi8>
+  %printed_output = memref.cast %output : memref<3x6xi8> to memref<?x?xi8>
+  call @printU8(%printed_output) : (memref<?x?xi8>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[3, 6\] strides = \[6, 1\] data =}}
+  // CHECK{LITERAL}: [[30, 225, 75, 255, 0, 135],
+  // CHECK{LITERAL}: [150, 225, 180, 105, 75, 195],
+  // CHECK{LITERAL}: [15, 240, 75, 165, 90, 135]]
+
+  dip.equalize_hist %inputFlat, %outputFlat : memref<2x2xi8>, memref<2x2xi8>
+  %printed_flat = memref.cast %outputFlat : memref<2x2xi8> to memref<?x?xi8>
+  call @printU8(%printed_flat) : (memref<?x?xi8>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[2, 2\] strides = \[2, 1\] data =}}
+  // CHECK{LITERAL}: [[7, 7],
+  // CHECK{LITERAL}: [7, 7]]
+
+  // Interleaved images share the table across channels.
+  dip.apply_lut %inputHWC, %invert, %outputHWC : memref<2x2x3xi8>, memref<256xi8>, memref<2x2x3xi8>
+  %hwc = memref.collapse_shape %outputHWC [[0], [1, 2]] : memref<2x2x3xi8> into memref<2x6xi8>
+  %printed_hwc = memref.cast %hwc : memref<2x6xi8> to memref<?x?xi8>
+  call @printU8(%printed_hwc) : (memref<?x?xi8>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[2, 6\] strides = \[6, 1\] data =}}
+  // CHECK{LITERAL}: [[245, 235, 225, 215, 205, 195],
+  // CHECK{LITERAL}: [255, 127, 0, 55, 155, 254]]
+
+  dip.apply_lut %input, %scale, %outputF32 : memref<3x6xi8>, memref<256xf32>, memref<3x6xf32>
+  %printed_f32 = memref.cast %outputF32 : memref<3x6xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_f32) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[3, 6\] strides = \[6, 1\] data =}}
+  // CHECK{LITERAL}: [[5, 100, 15, 127.5, 0, 38.5],
+  // CHECK{LITERAL}: [45, 100, 65, 20, 15, 90],
+  // CHECK{LITERAL}: [2.5, 125, 15, 50, 17.5, 38.5]]
+
+  memref.dealloc %invert : memref<256xi8>
+  memref.dealloc %scale : memref<256xf32>
+  %ret = arith.constant 0 : i32
+  return %ret : i32
+}
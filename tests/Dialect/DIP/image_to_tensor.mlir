@@ -0,0 +1,92 @@
+//
+// x86
+//
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=4" -arith-expand --convert-vector-to-scf --expand-strided-metadata --lower-affine --convert-scf-to-cf --convert-vector-to-llvm \
+// RUN: --convert-math-to-llvm --finalize-memref-to-llvm --convert-arith-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=4 DIP-parallel-tile-rows=2" -arith-expand --convert-vector-to-scf --expand-strided-metadata --lower-affine --convert-scf-to-cf --convert-vector-to-llvm \
+// RUN: --convert-math-to-llvm --finalize-memref-to-llvm --convert-arith-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+
+// Every output value is (pixel * scale - mean[c]) / std[c] of the resampled
+// pixel, sampled like cv::resize: bilinear interpolation aligns the pixel
+// centers and nearest neighbour reads the pixel at floor(x * scale). The BGR
+// image is written as RGB; the gray image feeds every channel of batch entry 1
+// and leaves entry 0 untouched.
+
+memref.global "private" @global_input_bgr : memref<2x2x3xi8> = dense<[[[10, 20, 30], [50, 60, 70]],
+                                                                      [[90, 100, 110], [130, 140, 150]]]>
+
+memref.global "private" @global_input_gray : memref<2x3xi8> = dense<[[0, 255, 40],
+                                                                     [128, 64, 200]]>
+
+memref.global "private" @global_mean_nchw : memref<3xf32> = dense<[0., 10., 100.]>
+
+memref.global "private" @global_std_nchw : memref<3xf32> = dense<[1., 2., 4.]>
+
+memref.global "private" @global_mean_nhwc : memref<3xf32> = dense<[0., 100., 128.]>
+
+memref.global "private" @global_std_nhwc : memref<3xf32> = dense<[1., 1., 2.]>
+
+memref.global "private" @global_output_nchw : memref<1x3x4x4xf32> = dense<0.>
+
+memref.global "private" @global_output_nhwc : memref<2x2x2x3xf32> = dense<0.>
+
+func.func private @printMemrefF32(memref<*xf32>) attributes { llvm.emit_c_interface }
+
+func.func @main() -> i32 {
+  %inputBGR = memref.get_global @global_input_bgr : memref<2x2x3xi8>
+  %inputGray = memref.get_global @global_input_gray : memref<2x3xi8>
+  %meanNCHW = memref.get_global @global_mean_nchw : memref<3xf32>
+  %stdNCHW = memref.get_global @global_std_nchw : memref<3xf32>
+  %meanNHWC = memref.get_global @global_mean_nhwc : memref<3xf32>
+  %stdNHWC = memref.get_global @global_std_nhwc : memref<3xf32>
+  %outputNCHW = memref.get_global @global_output_nchw : memref<1x3x4x4xf32>
+  %outputNHWC = memref.get_global @global_output_nhwc : memref<2x2x2x3xf32>
+
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %one = arith.constant 1. : f32
+
+  dip.image_to_tensor <NCHW> BILINEAR_INTERPOLATION %inputBGR, %outputNCHW, %c0, %one, %meanNCHW, %stdNCHW {swap_rb} : memref<2x2x3xi8>, memref<1x3x4x4xf32>, index, f32, memref<3xf32>, memref<3xf32>
+  dip.image_to_tensor <NHWC> NEAREST_NEIGHBOUR_INTERPOLATION %inputGray, %outputNHWC, %c1, %one, %meanNHWC, %stdNHWC : memref<2x3xi8>, memref<2x2x2x3xf32>, index, f32, memref<3xf32>, memref<3xf32>
+
+  // The tensors are printed with one row per image row of each channel (NCHW)
+  // or one row per pixel (NHWC).
+  %nchw = memref.collapse_shape %outputNCHW [[0, 1, 2], [3]] : memref<1x3x4x4xf32> into memref<12x4xf32>
+  %printed_nchw = memref.cast %nchw : memref<12x4xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_nchw) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[12, 4\] strides = \[4, 1\] data =}}
+  // CHECK{LITERAL}: [[30, 40, 60, 70],
+  // CHECK{LITERAL}: [50, 60, 80, 90],
+  // CHECK{LITERAL}: [90, 100, 120, 130],
+  // CHECK{LITERAL}: [110, 120, 140, 150],
+  // CHECK{LITERAL}: [5, 10, 20, 25],
+  // CHECK{LITERAL}: [15, 20, 30, 35],
+  // CHECK{LITERAL}: [35, 40, 50, 55],
+  // CHECK{LITERAL}: [45, 50, 60, 65],
+  // CHECK{LITERAL}: [-22.5, -20, -15, -12.5],
+  // CHECK{LITERAL}: [-17.5, -15, -10, -7.5],
+  // CHECK{LITERAL}: [-7.5, -5, 0, 2.5],
+  // CHECK{LITERAL}: [-2.5, 0, 5, 7.5]]
+
+  %nhwc = memref.collapse_shape %outputNHWC [[0, 1, 2], [3]] : memref<2x2x2x3xf32> into memref<8x3xf32>
+  %printed_nhwc = memref.cast %nhwc : memref<8x3xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_nhwc) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[8, 3\] strides = \[3, 1\] data =}}
+  // CHECK{LITERAL}: [[0, 0, 0],
+  // CHECK{LITERAL}: [0, 0, 0],
+  // CHECK{LITERAL}: [0, 0, 0],
+  // CHECK{LITERAL}: [0, 0, 0],
+  // CHECK{LITERAL}: [0, -100, -64],
+  // CHECK{LITERAL}: [255, 155, 63.5],
+  // CHECK{LITERAL}: [128, 28, 0],
+  // CHECK{LITERAL}: [64, -36, -32]]
+
+  %ret = arith.constant 0 : i32
+  return %ret : i32
+}
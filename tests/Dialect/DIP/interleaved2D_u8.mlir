@@ -0,0 +1,127 @@
+//
+// x86
+//
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=4" -arith-expand --convert-vector-to-scf --expand-strided-metadata --lower-affine --convert-scf-to-cf --convert-vector-to-llvm \
+// RUN: --convert-math-to-llvm --finalize-memref-to-llvm --convert-arith-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=4 DIP-parallel-tile-rows=2" -arith-expand --convert-vector-to-scf --expand-strided-metadata --lower-affine --convert-scf-to-cf --convert-vector-to-llvm \
+// RUN: --convert-math-to-llvm --finalize-memref-to-llvm --convert-arith-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+
+// 8-bit images are unsigned and interleaved images (HxWxC) are processed
+// channel by channel. Separable correlation uses signed kernels and saturates
+// its results to [0, 255].
+
+memref.global "private" @global_input_hwc : memref<2x2x2xi8> = dense<[[[0, 255], [200, 0]],
+                                                                      [[100, 10], [250, 90]]]>
+
+memref.global "private" @global_input_gray : memref<3x4xi8> = dense<[[10, 20, 60, 40],
+                                                                     [0, 30, 30, 10],
+                                                                     [5, 5, 50, 20]]>
+
+memref.global "private" @global_input_blur : memref<2x3x2xi8> = dense<[[[10, 1], [250, 100], [30, 3]],
+                                                                       [[0, 60], [40, 5], [80, 7]]]>
+
+memref.global "private" @global_sobel_x : memref<3xi8> = dense<[-1, 0, 1]>
+
+memref.global "private" @global_sobel_y : memref<3xi8> = dense<[1, 2, 1]>
+
+memref.global "private" @global_identity : memref<1xi8> = dense<[1]>
+
+memref.global "private" @global_scale : memref<2x3xf32> = dense<[[0.5, 0., 0.],
+                                                                 [0., 0.5, 0.]]>
+
+memref.global "private" @global_output_resize : memref<4x4x2xi8> = dense<0>
+
+memref.global "private" @global_output_sobel : memref<3x4xi8> = dense<0>
+
+memref.global "private" @global_output_blur : memref<2x3x2xi8> = dense<0>
+
+memref.global "private" @global_output_warp : memref<3x3x2xi8> = dense<0>
+
+func.func private @printMemrefI32(memref<*xi32>) attributes { llvm.emit_c_interface }
+
+// Prints an 8-bit image as unsigned values.
+func.func @printU8(%image : memref<?x?xi8>) {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %rows = memref.dim %image, %c0 : memref<?x?xi8>
+  %cols = memref.dim %image, %c1 : memref<?x?xi8>
+  %wide = memref.alloc(%rows, %cols) : memref<?x?xi32>
+  scf.for %i = %c0 to %rows step %c1 {
+    scf.for %j = %c0 to %cols step %c1 {
+      %val = memref.load %image[%i, %j] : memref<?x?xi8>
+      %ext = arith.extui %val : i8 to i32
+      memref.store %ext, %wide[%i, %j] : memref<?x?xi32>
+    }
+  }
+  %printed = memref.cast %wide : memref<?x?xi32> to memref<*xi32>
+  call @printMemrefI32(%printed) : (memref<*xi32>) -> ()
+  memref.dealloc %wide : memref<?x?xi32>
+  return
+}
+
+func.func @main() -> i32 {
+  %inputHWC = memref.get_global @global_input_hwc : memref<2x2x2xi8>
+  %inputGray = memref.get_global @global_input_gray : memref<3x4xi8>
+  %inputBlur = memref.get_global @global_input_blur : memref<2x3x2xi8>
+  %sobelX = memref.get_global @global_sobel_x : memref<3xi8>
+  %sobelY = memref.get_global @global_sobel_y : memref<3xi8>
+  %identity = memref.get_global @global_identity : memref<1xi8>
+  %scale = memref.get_global @global_scale : memref<2x3xf32>
+  %outputResize = memref.get_global @global_output_resize : memref<4x4x2xi8>
+  %outputSobel = memref.get_global @global_output_sobel : memref<3x4xi8>
+  %outputBlur = memref.get_global @global_output_blur : memref<2x3x2xi8>
+  %outputWarp = memref.get_global @global_output_warp : memref<3x3x2xi8>
+
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %half = arith.constant 0.5 : f32
+  %zero = arith.constant 0 : i8
+  %padding = arith.constant 20 : i8
+
+  dip.resize_2d BILINEAR_INTERPOLATION %inputHWC, %half, %half, %outputResize : memref<2x2x2xi8>, f32, f32, memref<4x4x2xi8>
+  dip.corr_2d_separable <REPLICATE_PADDING> %inputGray, %sobelX, %sobelY, %outputSobel, %c1, %c1, %zero : memref<3x4xi8>, memref<3xi8>, memref<3xi8>, memref<3x4xi8>, index, index, i8
+  dip.corr_2d_separable <CONSTANT_PADDING> %inputBlur, %sobelY, %identity, %outputBlur, %c1, %c0, %padding : memref<2x3x2xi8>, memref<3xi8>, memref<1xi8>, memref<2x3x2xi8>, index, index, i8
+  dip.warp_affine_2d <REPLICATE_PADDING> %inputHWC, %scale, %outputWarp, %zero : memref<2x2x2xi8>, memref<2x3xf32>, memref<3x3x2xi8>, i8
+
+  // Interleaved outputs are printed with the channels of each pixel in
+  // consecutive columns.
+  %resize = memref.collapse_shape %outputResize [[0], [1, 2]] : memref<4x4x2xi8> into memref<4x8xi8>
+  %printed_resize = memref.cast %resize : memref<4x8xi8> to memref<?x?xi8>
+  call @printU8(%printed_resize) : (memref<?x?xi8>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[4, 8\] strides = \[8, 1\] data =}}
+  // CHECK{LITERAL}: [[0, 255, 100, 128, 200, 0, 200, 0],
+  // CHECK{LITERAL}: [50, 133, 138, 89, 225, 45, 225, 45],
+  // CHECK{LITERAL}: [100, 10, 175, 50, 250, 90, 250, 90],
+  // CHECK{LITERAL}: [100, 10, 175, 50, 250, 90, 250, 90]]
+
+  %printed_sobel = memref.cast %outputSobel : memref<3x4xi8> to memref<?x?xi8>
+  call @printU8(%printed_sobel) : (memref<?x?xi8>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[3, 4\] strides = \[4, 1\] data =}}
+  // CHECK{LITERAL}: [[60, 180, 40, 0],
+  // CHECK{LITERAL}: [70, 155, 0, 0],
+  // CHECK{LITERAL}: [30, 165, 25, 0]]
+
+  %blur = memref.collapse_shape %outputBlur [[0], [1, 2]] : memref<2x3x2xi8> into memref<2x6xi8>
+  %printed_blur = memref.cast %blur : memref<2x6xi8> to memref<?x?xi8>
+  call @printU8(%printed_blur) : (memref<?x?xi8>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[2, 6\] strides = \[6, 1\] data =}}
+  // CHECK{LITERAL}: [[255, 122, 255, 204, 255, 126],
+  // CHECK{LITERAL}: [60, 145, 160, 77, 220, 39]]
+
+  %warp = memref.collapse_shape %outputWarp [[0], [1, 2]] : memref<3x3x2xi8> into memref<3x6xi8>
+  %printed_warp = memref.cast %warp : memref<3x6xi8> to memref<?x?xi8>
+  call @printU8(%printed_warp) : (memref<?x?xi8>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[3, 6\] strides = \[6, 1\] data =}}
+  // CHECK{LITERAL}: [[0, 255, 100, 128, 200, 0],
+  // CHECK{LITERAL}: [50, 133, 138, 89, 225, 45],
+  // CHECK{LITERAL}: [100, 10, 175, 50, 250, 90]]
+
+  %ret = arith.constant 0 : i32
+  return %ret : i32
+}
@@ -0,0 +1,138 @@
+//
+// x86
+//
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=4" -arith-expand --convert-vector-to-scf --lower-affine --convert-scf-to-cf --convert-vector-to-llvm \
+// RUN: --convert-math-to-llvm --finalize-memref-to-llvm --convert-arith-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=4 DIP-parallel-tile-rows=2" -arith-expand --convert-vector-to-scf --lower-affine --convert-scf-to-cf --convert-vector-to-llvm \
+// RUN: --convert-math-to-llvm --finalize-memref-to-llvm --convert-arith-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+
+// 3x3 and 5x5 windows use sorting networks, other 8-bit windows use column
+// histograms and the remaining windows select the rank with quickselect. Even
+// windows are anchored at kernelSize / 2.
+
+memref.global "private" @global_input_f32 : memref<4x5xf32> = dense<[[3., -1., 4., 1.5, 9.],
+                                                                     [2., 6., 5., 3., 5.],
+                                                                     [8., 9., 7., 9., 3.],
+                                                                     [2., 3., 8., 4., 6.]]>
+
+memref.global "private" @global_input_u8 : memref<5x6xi8> = dense<[[10, 200, 30, 255, 0, 77],
+                                                                   [90, 20, 130, 40, 180, 60],
+                                                                   [5, 250, 15, 100, 35, 220],
+                                                                   [140, 70, 160, 80, 190, 25],
+                                                                   [45, 210, 55, 120, 65, 230]]>
+
+memref.global "private" @global_output_f32 : memref<4x5xf32> = dense<0.>
+
+memref.global "private" @global_output_u8 : memref<5x6xi8> = dense<0>
+
+func.func private @printMemrefF32(memref<*xf32>) attributes { llvm.emit_c_interface }
+func.func private @printMemrefI32(memref<*xi32>) attributes { llvm.emit_c_interface }
+
+// Prints an 8-bit image as unsigned values.
+func.func @printU8(%image : memref<?x?xi8>) {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %rows = memref.dim %image, %c0 : memref<?x?xi8>
+  %cols = memref.dim %image, %c1 : memref<?x?xi8>
+  %wide = memref.alloc(%rows, %cols) : memref<?x?xi32>
+  scf.for %i = %c0 to %rows step %c1 {
+    scf.for %j = %c0 to %cols step %c1 {
+      %val = memref.load %image[%i, %j] : memref<?x?xi8>
+      %ext = arith.extui %val : i8 to i32
+      memref.store %ext, %wide[%i, %j] : memref<?x?xi32>
+    }
+  }
+  %printed = memref.cast %wide : memref<?x?xi32> to memref<*xi32>
+  call @printMemrefI32(%printed) : (memref<*xi32>) -> ()
+  memref.dealloc %wide : memref<?x?xi32>
+  return
+}
+
+func.func @main() -> i32 {
+  %inputF32 = memref.get_global @global_input_f32 : memref<4x5xf32>
+  %inputU8 = memref.get_global @global_input_u8 : memref<5x6xi8>
+  %outputF32 = memref.get_global @global_output_f32 : memref<4x5xf32>
+  %outputU8 = memref.get_global @global_output_u8 : memref<5x6xi8>
+  %printedF32 = memref.cast %outputF32 : memref<4x5xf32> to memref<*xf32>
+  %printedU8 = memref.cast %outputU8 : memref<5x6xi8> to memref<?x?xi8>
+
+  %c3 = arith.constant 3 : index
+  %c4 = arith.constant 4 : index
+  %c5 = arith.constant 5 : index
+  %c7 = arith.constant 7 : index
+  %c8 = arith.constant 8 : index
+  %c20 = arith.constant 20 : index
+  %minusOne = arith.constant -1. : f32
+  %padding = arith.constant 2.5 : f32
+  %zero = arith.constant 0. : f32
+  %zeroU8 = arith.constant 0 : i8
+  %paddingU8 = arith.constant 200 : i8
+
+  dip.median_2d <CONSTANT_PADDING> %inputF32, %outputF32, %c3, %minusOne : memref<4x5xf32>, memref<4x5xf32>, index, f32
+  call @printMemrefF32(%printedF32) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[4, 5\] strides = \[5, 1\] data =}}
+  // CHECK{LITERAL}: [[-1, 2, 1.5, 3, -1],
+  // CHECK{LITERAL}: [2, 5, 5, 5, 3],
+  // CHECK{LITERAL}: [2, 6, 6, 5, 3],
+  // CHECK{LITERAL}: [-1, 3, 4, 4, -1]]
+
+  dip.rank_filter_2d <REPLICATE_PADDING> %inputF32, %outputF32, %c5, %c20, %zero : memref<4x5xf32>, memref<4x5xf32>, index, index, f32
+  call @printMemrefF32(%printedF32) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[4, 5\] strides = \[5, 1\] data =}}
+  // CHECK{LITERAL}: [[7, 7, 9, 9, 9],
+  // CHECK{LITERAL}: [8, 8, 8, 9, 9],
+  // CHECK{LITERAL}: [8, 8, 8, 8, 8],
+  // CHECK{LITERAL}: [8, 8, 8, 8, 7]]
+
+  dip.rank_filter_2d <CONSTANT_PADDING> %inputF32, %outputF32, %c4, %c8, %padding : memref<4x5xf32>, memref<4x5xf32>, index, index, f32
+  call @printMemrefF32(%printedF32) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[4, 5\] strides = \[5, 1\] data =}}
+  // CHECK{LITERAL}: [[2.5, 2.5, 2.5, 2.5, 2.5],
+  // CHECK{LITERAL}: [2.5, 2.5, 3, 4, 3],
+  // CHECK{LITERAL}: [2.5, 3, 4, 5, 4],
+  // CHECK{LITERAL}: [2.5, 2.5, 4, 5, 3]]
+
+  dip.median_2d <REPLICATE_PADDING> %inputF32, %outputF32, %c7, %zero : memref<4x5xf32>, memref<4x5xf32>, index, f32
+  call @printMemrefF32(%printedF32) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[4, 5\] strides = \[5, 1\] data =}}
+  // CHECK{LITERAL}: [[3, 3, 4, 5, 6],
+  // CHECK{LITERAL}: [3, 3, 4, 5, 6],
+  // CHECK{LITERAL}: [3, 3, 4, 5, 6],
+  // CHECK{LITERAL}: [3, 3, 4, 5, 6]]
+
+  dip.median_2d <REPLICATE_PADDING> %inputU8, %outputU8, %c7, %zeroU8 : memref<5x6xi8>, memref<5x6xi8>, index, i8
+  call @printU8(%printedU8) : (memref<?x?xi8>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[5, 6\] strides = \[6, 1\] data =}}
+  // CHECK{LITERAL}: [[30, 30, 70, 77, 77, 77],
+  // CHECK{LITERAL}: [45, 45, 70, 77, 77, 77],
+  // CHECK{LITERAL}: [45, 55, 70, 77, 77, 77],
+  // CHECK{LITERAL}: [55, 65, 70, 80, 120, 100],
+  // CHECK{LITERAL}: [55, 65, 70, 100, 120, 120]]
+
+  dip.rank_filter_2d <CONSTANT_PADDING> %inputU8, %outputU8, %c3, %c8, %paddingU8 : memref<5x6xi8>, memref<5x6xi8>, index, index, i8
+  call @printU8(%printedU8) : (memref<?x?xi8>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[5, 6\] strides = \[6, 1\] data =}}
+  // CHECK{LITERAL}: [[200, 200, 255, 255, 255, 200],
+  // CHECK{LITERAL}: [250, 250, 255, 255, 255, 220],
+  // CHECK{LITERAL}: [250, 250, 250, 190, 220, 220],
+  // CHECK{LITERAL}: [250, 250, 250, 190, 230, 230],
+  // CHECK{LITERAL}: [210, 210, 210, 200, 230, 230]]
+
+  dip.rank_filter_2d <REPLICATE_PADDING> %inputU8, %outputU8, %c4, %c5, %zeroU8 : memref<5x6xi8>, memref<5x6xi8>, index, index, i8
+  call @printU8(%printedU8) : (memref<?x?xi8>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[5, 6\] strides = \[6, 1\] data =}}
+  // CHECK{LITERAL}: [[10, 10, 30, 30, 30, 60],
+  // CHECK{LITERAL}: [10, 10, 30, 30, 35, 60],
+  // CHECK{LITERAL}: [10, 20, 40, 40, 40, 60],
+  // CHECK{LITERAL}: [45, 45, 55, 65, 60, 60],
+  // CHECK{LITERAL}: [45, 45, 55, 65, 65, 80]]
+
+  %ret = arith.constant 0 : i32
+  return %ret : i32
+}
@@ -0,0 +1,83 @@
+//
+// x86
+//
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=64" -arith-expand --convert-vector-to-scf --lower-affine --convert-scf-to-cf --convert-vector-to-llvm \
+// RUN: --finalize-memref-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=64 DIP-parallel-tile-rows=3" -arith-expand --convert-vector-to-scf --lower-affine --convert-scf-to-cf --convert-vector-to-llvm \
+// RUN: --finalize-memref-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+
+// A single iteration of a compound operation is computed tile by tile, so the
+// intermediate and initial value buffers only need one element.
+
+memref.global "private" @global_input : memref<4x4xf32> = dense<[[5., 1., 7., 2.],
+                                                                 [3., 9., 4., 8.],
+                                                                 [6., 2., 8., 1.],
+                                                                 [0., 7., 3., 5.]]>
+
+memref.global "private" @global_kernel : memref<3x3xf32> = dense<[[0., 1., 0.],
+                                                                  [1., 1., 1.],
+                                                                  [0., 1., 0.]]>
+
+memref.global "private" @global_output_opening : memref<4x4xf32> = dense<0.>
+
+memref.global "private" @global_output_tophat : memref<4x4xf32> = dense<0.>
+
+memref.global "private" @global_output_morphgrad : memref<4x4xf32> = dense<0.>
+
+memref.global "private" @global_scratch : memref<1x1xf32> = dense<0.>
+
+memref.global "private" @global_copymemref_erosion : memref<1x1xf32> = dense<256.>
+
+memref.global "private" @global_copymemref_dilation : memref<1x1xf32> = dense<-1.>
+
+func.func private @printMemrefF32(memref<*xf32>) attributes { llvm.emit_c_interface }
+
+func.func @main() -> i32 {
+  %input = memref.get_global @global_input : memref<4x4xf32>
+  %kernel = memref.get_global @global_kernel : memref<3x3xf32>
+  %outputOpening = memref.get_global @global_output_opening : memref<4x4xf32>
+  %outputTopHat = memref.get_global @global_output_tophat : memref<4x4xf32>
+  %outputMorphGrad = memref.get_global @global_output_morphgrad : memref<4x4xf32>
+  %scratch = memref.get_global @global_scratch : memref<1x1xf32>
+  %copyErosion = memref.get_global @global_copymemref_erosion : memref<1x1xf32>
+  %copyDilation = memref.get_global @global_copymemref_dilation : memref<1x1xf32>
+
+  %c1 = arith.constant 1 : index
+  %padding = arith.constant 4. : f32
+  %zero = arith.constant 0. : f32
+
+  dip.opening_2d <CONSTANT_PADDING> %input, %kernel, %outputOpening, %scratch, %copyErosion, %copyDilation, %c1, %c1, %c1, %padding : memref<4x4xf32>, memref<3x3xf32>, memref<4x4xf32>, memref<1x1xf32>, memref<1x1xf32>, memref<1x1xf32>, index, index, index, f32
+  dip.tophat_2d <REPLICATE_PADDING> %input, %kernel, %outputTopHat, %scratch, %scratch, %scratch, %copyErosion, %copyDilation, %c1, %c1, %c1, %zero : memref<4x4xf32>, memref<3x3xf32>, memref<4x4xf32>, memref<1x1xf32>, memref<1x1xf32>, memref<1x1xf32>, memref<1x1xf32>, memref<1x1xf32>, index, index, index, f32
+  dip.morphgrad_2d <REPLICATE_PADDING> %input, %kernel, %outputMorphGrad, %scratch, %scratch, %scratch, %copyDilation, %copyErosion, %c1, %c1, %c1, %zero : memref<4x4xf32>, memref<3x3xf32>, memref<4x4xf32>, memref<1x1xf32>, memref<1x1xf32>, memref<1x1xf32>, memref<1x1xf32>, memref<1x1xf32>, index, index, index, f32
+
+  %printed_opening = memref.cast %outputOpening : memref<4x4xf32> to memref<*xf32>
+  %printed_tophat = memref.cast %outputTopHat : memref<4x4xf32> to memref<*xf32>
+  %printed_morphgrad = memref.cast %outputMorphGrad : memref<4x4xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_opening) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[4, 4\] strides = \[4, 1\] data =}}
+  // CHECK{LITERAL}: [[4, 4, 4, 4],
+  // CHECK{LITERAL}: [4, 4, 4, 4],
+  // CHECK{LITERAL}: [4, 2, 4, 4],
+  // CHECK{LITERAL}: [4, 4, 4, 4]]
+  call @printMemrefF32(%printed_tophat) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[4, 4\] strides = \[4, 1\] data =}}
+  // CHECK{LITERAL}: [[2, 0, 3, 0],
+  // CHECK{LITERAL}: [0, 5, 0, 4],
+  // CHECK{LITERAL}: [3, 0, 4, 0],
+  // CHECK{LITERAL}: [0, 4, 0, 2]]
+  call @printMemrefF32(%printed_morphgrad) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[4, 4\] strides = \[4, 1\] data =}}
+  // CHECK{LITERAL}: [[4, 8, 6, 6],
+  // CHECK{LITERAL}: [6, 8, 5, 7],
+  // CHECK{LITERAL}: [6, 7, 7, 7],
+  // CHECK{LITERAL}: [7, 7, 5, 4]]
+
+  %ret = arith.constant 0 : i32
+  return %ret : i32
+}
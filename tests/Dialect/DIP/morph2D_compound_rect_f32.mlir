@@ -0,0 +1,186 @@
+//
+// x86
+//
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=64" -arith-expand --convert-vector-to-scf --lower-affine --convert-scf-to-cf --convert-vector-to-llvm \
+// RUN: --finalize-memref-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=4 DIP-parallel-tile-rows=3" -arith-expand --convert-vector-to-scf --lower-affine --convert-scf-to-cf --convert-vector-to-llvm \
+// RUN: --finalize-memref-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+
+// Single iterations of compound operations with a large flat kernel run the
+// van Herk/Gil-Werman scans inside the fused tiles. The constant kernel is
+// checked at compile time, the other one at runtime. Opening and closing are
+// compared with separate erosions and dilations through full size images.
+
+memref.global "private" @global_input : memref<9x13xf32> = dense<[[0. , 29., 58., 23., 52., 17., 46., 11., 40., 5. , 34., 63., 28.],
+                                                                  [17., 46., 11., 40., 5. , 34., 63., 28., 57., 22., 51., 16., 45.],
+                                                                  [34., 63., 28., 57., 22., 51., 16., 45., 10., 39., 4. , 33., 62.],
+                                                                  [51., 16., 45., 10., 39., 4. , 33., 62., 27., 56., 21., 50., 15.],
+                                                                  [4. , 33., 62., 27., 56., 21., 50., 15., 44., 9. , 38., 3. , 32.],
+                                                                  [21., 50., 15., 44., 9. , 38., 3. , 32., 61., 26., 55., 20., 49.],
+                                                                  [38., 3. , 32., 61., 26., 55., 20., 49., 14., 43., 8. , 37., 2.],
+                                                                  [55., 20., 49., 14., 43., 8. , 37., 2. , 31., 60., 25., 54., 19.],
+                                                                  [8. , 37., 2. , 31., 60., 25., 54., 19., 48., 13., 42., 7. , 36.]]>
+
+memref.global "private" constant @global_kernel : memref<5x7xf32> = dense<1.>
+
+memref.global "private" @global_kernel_runtime : memref<5x7xf32> = dense<1.>
+
+memref.global "private" @global_output_opening : memref<9x13xf32> = dense<0.>
+
+memref.global "private" @global_output_closing : memref<9x13xf32> = dense<0.>
+
+memref.global "private" @global_output_tophat : memref<9x13xf32> = dense<0.>
+
+memref.global "private" @global_output_bottomhat : memref<9x13xf32> = dense<0.>
+
+memref.global "private" @global_output_morphgrad : memref<9x13xf32> = dense<0.>
+
+memref.global "private" @global_output_eroded : memref<9x13xf32> = dense<0.>
+
+memref.global "private" @global_output_dilated : memref<9x13xf32> = dense<0.>
+
+memref.global "private" @global_output_opening_ref : memref<9x13xf32> = dense<0.>
+
+memref.global "private" @global_output_closing_ref : memref<9x13xf32> = dense<0.>
+
+memref.global "private" @global_scratch : memref<1x1xf32> = dense<0.>
+
+memref.global "private" @global_copymemref_erosion : memref<1x1xf32> = dense<256.>
+
+memref.global "private" @global_copymemref_dilation : memref<1x1xf32> = dense<-1.>
+
+memref.global "private" @global_copymemref_erosion_full : memref<9x13xf32> = dense<256.>
+
+memref.global "private" @global_copymemref_dilation_full : memref<9x13xf32> = dense<-1.>
+
+func.func private @printMemrefF32(memref<*xf32>) attributes { llvm.emit_c_interface }
+
+func.func @main() -> i32 {
+  %input = memref.get_global @global_input : memref<9x13xf32>
+  %kernel = memref.get_global @global_kernel : memref<5x7xf32>
+  %kernelRuntime = memref.get_global @global_kernel_runtime : memref<5x7xf32>
+  %outputOpening = memref.get_global @global_output_opening : memref<9x13xf32>
+  %outputClosing = memref.get_global @global_output_closing : memref<9x13xf32>
+  %outputTophat = memref.get_global @global_output_tophat : memref<9x13xf32>
+  %outputBottomhat = memref.get_global @global_output_bottomhat : memref<9x13xf32>
+  %outputMorphgrad = memref.get_global @global_output_morphgrad : memref<9x13xf32>
+  %outputEroded = memref.get_global @global_output_eroded : memref<9x13xf32>
+  %outputDilated = memref.get_global @global_output_dilated : memref<9x13xf32>
+  %outputOpeningRef = memref.get_global @global_output_opening_ref : memref<9x13xf32>
+  %outputClosingRef = memref.get_global @global_output_closing_ref : memref<9x13xf32>
+  %scratch = memref.get_global @global_scratch : memref<1x1xf32>
+  %copyErosion = memref.get_global @global_copymemref_erosion : memref<1x1xf32>
+  %copyDilation = memref.get_global @global_copymemref_dilation : memref<1x1xf32>
+  %copyErosionFull = memref.get_global @global_copymemref_erosion_full : memref<9x13xf32>
+  %copyDilationFull = memref.get_global @global_copymemref_dilation_full : memref<9x13xf32>
+
+  %c1 = arith.constant 1 : index
+  %c4 = arith.constant 4 : index
+  %padding = arith.constant 30. : f32
+  %zero = arith.constant 0. : f32
+
+  dip.opening_2d <REPLICATE_PADDING> %input, %kernel, %outputOpening, %scratch, %copyErosion, %copyDilation, %c4, %c1, %c1, %zero : memref<9x13xf32>, memref<5x7xf32>, memref<9x13xf32>, memref<1x1xf32>, memref<1x1xf32>, memref<1x1xf32>, index, index, index, f32
+  dip.closing_2d <REPLICATE_PADDING> %input, %kernelRuntime, %outputClosing, %scratch, %copyDilation, %copyErosion, %c4, %c1, %c1, %zero : memref<9x13xf32>, memref<5x7xf32>, memref<9x13xf32>, memref<1x1xf32>, memref<1x1xf32>, memref<1x1xf32>, index, index, index, f32
+  dip.tophat_2d <CONSTANT_PADDING> %input, %kernel, %outputTophat, %scratch, %scratch, %scratch, %copyErosion, %copyDilation, %c4, %c1, %c1, %padding : memref<9x13xf32>, memref<5x7xf32>, memref<9x13xf32>, memref<1x1xf32>, memref<1x1xf32>, memref<1x1xf32>, memref<1x1xf32>, memref<1x1xf32>, index, index, index, f32
+  dip.bottomhat_2d <REPLICATE_PADDING> %input, %kernel, %outputBottomhat, %scratch, %scratch, %scratch, %copyDilation, %copyErosion, %c4, %c1, %c1, %zero : memref<9x13xf32>, memref<5x7xf32>, memref<9x13xf32>, memref<1x1xf32>, memref<1x1xf32>, memref<1x1xf32>, memref<1x1xf32>, memref<1x1xf32>, index, index, index, f32
+  dip.morphgrad_2d <CONSTANT_PADDING> %input, %kernel, %outputMorphgrad, %scratch, %scratch, %scratch, %copyDilation, %copyErosion, %c4, %c1, %c1, %padding : memref<9x13xf32>, memref<5x7xf32>, memref<9x13xf32>, memref<1x1xf32>, memref<1x1xf32>, memref<1x1xf32>, memref<1x1xf32>, memref<1x1xf32>, index, index, index, f32
+
+  dip.erosion_2d <REPLICATE_PADDING> %input, %kernel, %outputEroded, %copyErosionFull, %c4, %c1, %c1, %zero : memref<9x13xf32>, memref<5x7xf32>, memref<9x13xf32>, memref<9x13xf32>, index, index, index, f32
+  dip.dilation_2d <REPLICATE_PADDING> %outputEroded, %kernel, %outputOpeningRef, %copyDilationFull, %c4, %c1, %c1, %zero : memref<9x13xf32>, memref<5x7xf32>, memref<9x13xf32>, memref<9x13xf32>, index, index, index, f32
+  dip.dilation_2d <REPLICATE_PADDING> %input, %kernelRuntime, %outputDilated, %copyDilationFull, %c4, %c1, %c1, %zero : memref<9x13xf32>, memref<5x7xf32>, memref<9x13xf32>, memref<9x13xf32>, index, index, index, f32
+  dip.erosion_2d <REPLICATE_PADDING> %outputDilated, %kernelRuntime, %outputClosingRef, %copyErosionFull, %c4, %c1, %c1, %zero : memref<9x13xf32>, memref<5x7xf32>, memref<9x13xf32>, memref<9x13xf32>, index, index, index, f32
+
+  %printedOpening = memref.cast %outputOpening : memref<9x13xf32> to memref<*xf32>
+  %printedOpeningRef = memref.cast %outputOpeningRef : memref<9x13xf32> to memref<*xf32>
+  %printedClosing = memref.cast %outputClosing : memref<9x13xf32> to memref<*xf32>
+  %printedClosingRef = memref.cast %outputClosingRef : memref<9x13xf32> to memref<*xf32>
+  %printedTophat = memref.cast %outputTophat : memref<9x13xf32> to memref<*xf32>
+  %printedBottomhat = memref.cast %outputBottomhat : memref<9x13xf32> to memref<*xf32>
+  %printedMorphgrad = memref.cast %outputMorphgrad : memref<9x13xf32> to memref<*xf32>
+  call @printMemrefF32(%printedOpening) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[9, 13\] strides = \[13, 1\] data =}}
+  // CHECK{LITERAL}: [[4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4],
+  // CHECK{LITERAL}: [4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4],
+  // CHECK{LITERAL}: [4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4],
+  // CHECK{LITERAL}: [4, 4, 4, 4, 4, 4, 4, 4, 3, 3, 3, 3, 3],
+  // CHECK{LITERAL}: [3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3],
+  // CHECK{LITERAL}: [3, 3, 3, 3, 3, 3, 3, 3, 3, 2, 7, 7, 7],
+  // CHECK{LITERAL}: [2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 7, 7, 7],
+  // CHECK{LITERAL}: [2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 7, 7, 7],
+  // CHECK{LITERAL}: [2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 7, 7, 7]]
+  call @printMemrefF32(%printedOpeningRef) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[9, 13\] strides = \[13, 1\] data =}}
+  // CHECK{LITERAL}: [[4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4],
+  // CHECK{LITERAL}: [4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4],
+  // CHECK{LITERAL}: [4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4],
+  // CHECK{LITERAL}: [4, 4, 4, 4, 4, 4, 4, 4, 3, 3, 3, 3, 3],
+  // CHECK{LITERAL}: [3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3],
+  // CHECK{LITERAL}: [3, 3, 3, 3, 3, 3, 3, 3, 3, 2, 7, 7, 7],
+  // CHECK{LITERAL}: [2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 7, 7, 7],
+  // CHECK{LITERAL}: [2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 7, 7, 7],
+  // CHECK{LITERAL}: [2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 7, 7, 7]]
+  call @printMemrefF32(%printedClosing) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[9, 13\] strides = \[13, 1\] data =}}
+  // CHECK{LITERAL}: [[63, 63, 63, 63, 62, 62, 62, 62, 62, 62, 62, 62, 62],
+  // CHECK{LITERAL}: [62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 61, 61, 61],
+  // CHECK{LITERAL}: [62, 62, 62, 62, 62, 61, 61, 61, 61, 61, 61, 61, 61],
+  // CHECK{LITERAL}: [55, 55, 55, 55, 55, 61, 61, 61, 61, 61, 61, 61, 61],
+  // CHECK{LITERAL}: [55, 55, 55, 55, 55, 61, 60, 60, 60, 60, 60, 60, 60],
+  // CHECK{LITERAL}: [55, 55, 55, 55, 55, 55, 60, 60, 60, 60, 60, 60, 60],
+  // CHECK{LITERAL}: [55, 55, 55, 55, 55, 55, 60, 60, 60, 60, 60, 60, 60],
+  // CHECK{LITERAL}: [55, 55, 55, 55, 55, 55, 60, 60, 60, 60, 60, 60, 60],
+  // CHECK{LITERAL}: [55, 55, 55, 55, 55, 55, 60, 60, 60, 60, 60, 60, 60]]
+  call @printMemrefF32(%printedClosingRef) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[9, 13\] strides = \[13, 1\] data =}}
+  // CHECK{LITERAL}: [[63, 63, 63, 63, 62, 62, 62, 62, 62, 62, 62, 62, 62],
+  // CHECK{LITERAL}: [62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 61, 61, 61],
+  // CHECK{LITERAL}: [62, 62, 62, 62, 62, 61, 61, 61, 61, 61, 61, 61, 61],
+  // CHECK{LITERAL}: [55, 55, 55, 55, 55, 61, 61, 61, 61, 61, 61, 61, 61],
+  // CHECK{LITERAL}: [55, 55, 55, 55, 55, 61, 60, 60, 60, 60, 60, 60, 60],
+  // CHECK{LITERAL}: [55, 55, 55, 55, 55, 55, 60, 60, 60, 60, 60, 60, 60],
+  // CHECK{LITERAL}: [55, 55, 55, 55, 55, 55, 60, 60, 60, 60, 60, 60, 60],
+  // CHECK{LITERAL}: [55, 55, 55, 55, 55, 55, 60, 60, 60, 60, 60, 60, 60],
+  // CHECK{LITERAL}: [55, 55, 55, 55, 55, 55, 60, 60, 60, 60, 60, 60, 60]]
+  call @printMemrefF32(%printedTophat) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[9, 13\] strides = \[13, 1\] data =}}
+  // CHECK{LITERAL}: [[-30, -1, 28, -7, 22, -13, 16, -19, 10, -25, 4, 33, -2],
+  // CHECK{LITERAL}: [-13, 16, -19, 10, 1, 30, 59, 24, 53, 18, 47, -14, 15],
+  // CHECK{LITERAL}: [4, 33, -2, 27, 18, 47, 12, 41, 6, 35, 0, 3, 32],
+  // CHECK{LITERAL}: [21, -14, 15, -20, 35, 0, 29, 58, 24, 53, 18, 20, -15],
+  // CHECK{LITERAL}: [-26, 3, 32, -3, 53, 18, 47, 12, 41, 6, 35, -27, 2],
+  // CHECK{LITERAL}: [-9, 20, -15, 14, 6, 35, 0, 29, 58, 24, 48, -10, 19],
+  // CHECK{LITERAL}: [8, -27, 2, 31, -4, 25, -10, 19, -16, 13, -22, 7, -28],
+  // CHECK{LITERAL}: [25, -10, 19, -16, 13, -22, 7, -28, 1, 30, -5, 24, -11],
+  // CHECK{LITERAL}: [-22, 7, -28, 1, 30, -5, 24, -11, 18, -17, 12, -23, 6]]
+  call @printMemrefF32(%printedBottomhat) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[9, 13\] strides = \[13, 1\] data =}}
+  // CHECK{LITERAL}: [[63, 34, 5, 40, 10, 45, 16, 51, 22, 57, 28, -1, 34],
+  // CHECK{LITERAL}: [45, 16, 51, 22, 57, 28, -1, 34, 5, 40, 10, 45, 16],
+  // CHECK{LITERAL}: [28, -1, 34, 5, 40, 10, 45, 16, 51, 22, 57, 28, -1],
+  // CHECK{LITERAL}: [4, 39, 10, 45, 16, 57, 28, -1, 34, 5, 40, 11, 46],
+  // CHECK{LITERAL}: [51, 22, -7, 28, -1, 40, 10, 45, 16, 51, 22, 57, 28],
+  // CHECK{LITERAL}: [34, 5, 40, 11, 46, 17, 57, 28, -1, 34, 5, 40, 11],
+  // CHECK{LITERAL}: [17, 52, 23, -6, 29, 0, 40, 11, 46, 17, 52, 23, 58],
+  // CHECK{LITERAL}: [0, 35, 6, 41, 12, 47, 23, 58, 29, 0, 35, 6, 41],
+  // CHECK{LITERAL}: [47, 18, 53, 24, -5, 30, 6, 41, 12, 47, 18, 53, 24]]
+  call @printMemrefF32(%printedMorphgrad) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[9, 13\] strides = \[13, 1\] data =}}
+  // CHECK{LITERAL}: [[63, 63, 63, 63, 63, 59, 59, 59, 59, 59, 59, 59, 59],
+  // CHECK{LITERAL}: [63, 63, 63, 63, 63, 59, 59, 59, 59, 60, 60, 60, 60],
+  // CHECK{LITERAL}: [59, 59, 59, 59, 60, 60, 60, 60, 60, 60, 60, 59, 59],
+  // CHECK{LITERAL}: [60, 60, 60, 60, 60, 60, 59, 59, 59, 59, 60, 60, 60],
+  // CHECK{LITERAL}: [59, 59, 59, 59, 59, 60, 60, 60, 60, 60, 60, 60, 59],
+  // CHECK{LITERAL}: [60, 60, 60, 60, 60, 60, 60, 59, 59, 59, 59, 59, 59],
+  // CHECK{LITERAL}: [53, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59],
+  // CHECK{LITERAL}: [53, 59, 59, 59, 59, 59, 59, 59, 58, 58, 58, 58, 58],
+  // CHECK{LITERAL}: [53, 53, 58, 58, 58, 58, 58, 58, 58, 58, 58, 58, 53]]
+
+  %ret = arith.constant 0 : i32
+  return %ret : i32
+}
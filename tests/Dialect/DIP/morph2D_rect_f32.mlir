@@ -0,0 +1,123 @@
+//
+// x86
+//
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=64" -arith-expand --convert-vector-to-scf --lower-affine --convert-scf-to-cf --convert-vector-to-llvm \
+// RUN: --finalize-memref-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=4 DIP-parallel-tile-rows=3" -arith-expand --convert-vector-to-scf --lower-affine --convert-scf-to-cf --convert-vector-to-llvm \
+// RUN: --finalize-memref-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+
+// Flat rectangular kernels take the van Herk/Gil-Werman path. The 3x3 and 2x3
+// kernels are checked at runtime, the constant 3x5 kernel at compile time. The
+// 7x11 image has row groups and column blocks with tails.
+
+memref.global "private" @global_input : memref<4x4xf32> = dense<[[0. , 1. , 2. , 3. ],
+                                                                 [10., 11., 12., 13.],
+                                                                 [20., 21., 22., 23.],
+                                                                 [30., 31., 32., 33.]]>
+
+memref.global "private" @global_kernel_3x3 : memref<3x3xf32> = dense<1.>
+
+memref.global "private" @global_kernel_2x3 : memref<2x3xf32> = dense<1.>
+
+memref.global "private" constant @global_kernel_3x5 : memref<3x5xf32> = dense<1.>
+
+memref.global "private" @global_input_large : memref<7x11xf32> = dense<[[0. , 13., 26., 39., 2. , 15., 28., 41., 4. , 17., 30.],
+                                                                        [7. , 20., 33., 46., 9. , 22., 35., 48., 11., 24., 37.],
+                                                                        [14., 27., 40., 3. , 16., 29., 42., 5. , 18., 31., 44.],
+                                                                        [21., 34., 47., 10., 23., 36., 49., 12., 25., 38., 1. ],
+                                                                        [28., 41., 4. , 17., 30., 43., 6. , 19., 32., 45., 8. ],
+                                                                        [35., 48., 11., 24., 37., 0. , 13., 26., 39., 2. , 15.],
+                                                                        [42., 5. , 18., 31., 44., 7. , 20., 33., 46., 9. , 22.]]>
+
+memref.global "private" @global_output_erosion_large : memref<7x11xf32> = dense<0.>
+
+memref.global "private" @global_output_dilation_large : memref<7x11xf32> = dense<0.>
+
+memref.global "private" @global_copymemref_erosion_large : memref<7x11xf32> = dense<256.>
+
+memref.global "private" @global_copymemref_dilation_large : memref<7x11xf32> = dense<-1.>
+
+memref.global "private" @global_output_erosion : memref<4x4xf32> = dense<0.>
+
+memref.global "private" @global_output_dilation : memref<4x4xf32> = dense<0.>
+
+memref.global "private" @global_copymemref_erosion : memref<4x4xf32> = dense<256.>
+
+memref.global "private" @global_copymemref_dilation : memref<4x4xf32> = dense<-1.>
+
+func.func private @printMemrefF32(memref<*xf32>) attributes { llvm.emit_c_interface }
+
+func.func @main() -> i32 {
+  %input = memref.get_global @global_input : memref<4x4xf32>
+  %kernel3x3 = memref.get_global @global_kernel_3x3 : memref<3x3xf32>
+  %kernel2x3 = memref.get_global @global_kernel_2x3 : memref<2x3xf32>
+  %outputErosion = memref.get_global @global_output_erosion : memref<4x4xf32>
+  %outputDilation = memref.get_global @global_output_dilation : memref<4x4xf32>
+  %copyErosion = memref.get_global @global_copymemref_erosion : memref<4x4xf32>
+  %copyDilation = memref.get_global @global_copymemref_dilation : memref<4x4xf32>
+
+  %inputLarge = memref.get_global @global_input_large : memref<7x11xf32>
+  %kernel3x5 = memref.get_global @global_kernel_3x5 : memref<3x5xf32>
+  %outputErosionLarge = memref.get_global @global_output_erosion_large : memref<7x11xf32>
+  %outputDilationLarge = memref.get_global @global_output_dilation_large : memref<7x11xf32>
+  %copyErosionLarge = memref.get_global @global_copymemref_erosion_large : memref<7x11xf32>
+  %copyDilationLarge = memref.get_global @global_copymemref_dilation_large : memref<7x11xf32>
+
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c2 = arith.constant 2 : index
+  %c3 = arith.constant 3 : index
+  %padding = arith.constant 100. : f32
+  %zero = arith.constant 0. : f32
+
+  dip.erosion_2d <CONSTANT_PADDING> %input, %kernel3x3, %outputErosion, %copyErosion, %c1, %c1, %c1, %padding : memref<4x4xf32>, memref<3x3xf32>, memref<4x4xf32>, memref<4x4xf32>, index, index, index, f32
+  dip.dilation_2d <REPLICATE_PADDING> %input, %kernel2x3, %outputDilation, %copyDilation, %c1, %c0, %c1, %zero : memref<4x4xf32>, memref<2x3xf32>, memref<4x4xf32>, memref<4x4xf32>, index, index, index, f32
+
+  dip.erosion_2d <CONSTANT_PADDING> %inputLarge, %kernel3x5, %outputErosionLarge, %copyErosionLarge, %c3, %c1, %c1, %padding : memref<7x11xf32>, memref<3x5xf32>, memref<7x11xf32>, memref<7x11xf32>, index, index, index, f32
+  dip.dilation_2d <REPLICATE_PADDING> %inputLarge, %kernel3x5, %outputDilationLarge, %copyDilationLarge, %c0, %c2, %c1, %zero : memref<7x11xf32>, memref<3x5xf32>, memref<7x11xf32>, memref<7x11xf32>, index, index, index, f32
+
+  %printed_erosion = memref.cast %outputErosion : memref<4x4xf32> to memref<*xf32>
+  %printed_dilation = memref.cast %outputDilation : memref<4x4xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_erosion) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[4, 4\] strides = \[4, 1\] data =}}
+  // CHECK{LITERAL}: [[0, 0, 1, 2],
+  // CHECK{LITERAL}: [0, 0, 1, 2],
+  // CHECK{LITERAL}: [10, 10, 11, 12],
+  // CHECK{LITERAL}: [20, 20, 21, 22]]
+  call @printMemrefF32(%printed_dilation) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[4, 4\] strides = \[4, 1\] data =}}
+  // CHECK{LITERAL}: [[11, 12, 13, 13],
+  // CHECK{LITERAL}: [21, 22, 23, 23],
+  // CHECK{LITERAL}: [31, 32, 33, 33],
+  // CHECK{LITERAL}: [31, 32, 33, 33]]
+
+  %printed_erosion_large = memref.cast %outputErosionLarge : memref<7x11xf32> to memref<*xf32>
+  %printed_dilation_large = memref.cast %outputDilationLarge : memref<7x11xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_erosion_large) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[7, 11\] strides = \[11, 1\] data =}}
+  // CHECK{LITERAL}: [[0, 0, 0, 0, 2, 2, 2, 2, 4, 4, 4],
+  // CHECK{LITERAL}: [0, 0, 0, 0, 2, 2, 2, 2, 4, 4, 4],
+  // CHECK{LITERAL}: [7, 7, 3, 3, 3, 3, 3, 5, 5, 1, 1],
+  // CHECK{LITERAL}: [14, 4, 3, 3, 3, 3, 3, 5, 5, 1, 1],
+  // CHECK{LITERAL}: [21, 4, 4, 4, 0, 0, 0, 0, 0, 1, 1],
+  // CHECK{LITERAL}: [5, 4, 4, 4, 0, 0, 0, 0, 0, 2, 2],
+  // CHECK{LITERAL}: [5, 5, 5, 5, 0, 0, 0, 0, 0, 2, 2]]
+  call @printMemrefF32(%printed_dilation_large) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[7, 11\] strides = \[11, 1\] data =}}
+  // CHECK{LITERAL}: [[39, 39, 39, 41, 41, 41, 41, 41, 30, 30, 30],
+  // CHECK{LITERAL}: [46, 46, 46, 48, 48, 48, 48, 48, 37, 37, 37],
+  // CHECK{LITERAL}: [46, 46, 46, 48, 48, 48, 48, 48, 44, 44, 44],
+  // CHECK{LITERAL}: [47, 47, 49, 49, 49, 49, 49, 48, 44, 44, 44],
+  // CHECK{LITERAL}: [47, 47, 49, 49, 49, 49, 49, 45, 45, 45, 44],
+  // CHECK{LITERAL}: [48, 48, 49, 49, 49, 49, 49, 45, 45, 45, 15],
+  // CHECK{LITERAL}: [48, 48, 44, 44, 46, 46, 46, 46, 46, 45, 22]]
+
+  %ret = arith.constant 0 : i32
+  return %ret : i32
+}
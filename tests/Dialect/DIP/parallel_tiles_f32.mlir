@@ -0,0 +1,72 @@
+//
+// x86
+//
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=64 DIP-parallel-tile-rows=2" -arith-expand --convert-vector-to-scf --lower-affine --convert-scf-to-cf --convert-vector-to-llvm \
+// RUN: --finalize-memref-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=64 DIP-parallel-tile-rows=2" \
+// RUN: | FileCheck %s --check-prefix=TILED
+
+// Row tiles of 2 rows; the last tile is partial and every tile reads halo rows
+// from its neighbours.
+
+// TILED: affine.parallel {{.*}} step (2)
+// TILED: scf.parallel
+
+memref.global "private" @global_input : memref<5x3xf32> = dense<[[0. , 1. , 2. ],
+                                                                 [10., 11., 12.],
+                                                                 [20., 21., 22.],
+                                                                 [30., 31., 32.],
+                                                                 [40., 41., 42.]]>
+
+memref.global "private" @global_column : memref<3x3xf32> = dense<[[0., 1., 0.],
+                                                                  [0., 1., 0.],
+                                                                  [0., 1., 0.]]>
+
+memref.global "private" @global_line : memref<3x1xf32> = dense<1.>
+
+memref.global "private" @global_output_corr : memref<5x3xf32> = dense<0.>
+
+memref.global "private" @global_output_erosion : memref<5x3xf32> = dense<0.>
+
+memref.global "private" @global_copymemref : memref<5x3xf32> = dense<256.>
+
+func.func private @printMemrefF32(memref<*xf32>) attributes { llvm.emit_c_interface }
+
+func.func @main() -> i32 {
+  %input = memref.get_global @global_input : memref<5x3xf32>
+  %column = memref.get_global @global_column : memref<3x3xf32>
+  %line = memref.get_global @global_line : memref<3x1xf32>
+  %outputCorr = memref.get_global @global_output_corr : memref<5x3xf32>
+  %outputErosion = memref.get_global @global_output_erosion : memref<5x3xf32>
+  %copymemref = memref.get_global @global_copymemref : memref<5x3xf32>
+
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %zero = arith.constant 0. : f32
+
+  dip.corr_2d <CONSTANT_PADDING> %input, %column, %outputCorr, %c1, %c1, %zero : memref<5x3xf32>, memref<3x3xf32>, memref<5x3xf32>, index, index, f32
+  dip.erosion_2d <REPLICATE_PADDING> %input, %line, %outputErosion, %copymemref, %c0, %c1, %c1, %zero : memref<5x3xf32>, memref<3x1xf32>, memref<5x3xf32>, memref<5x3xf32>, index, index, index, f32
+
+  %printed_corr = memref.cast %outputCorr : memref<5x3xf32> to memref<*xf32>
+  %printed_erosion = memref.cast %outputErosion : memref<5x3xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_corr) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[5, 3\] strides = \[3, 1\] data =}}
+  // CHECK{LITERAL}: [[10, 12, 14],
+  // CHECK{LITERAL}: [30, 33, 36],
+  // CHECK{LITERAL}: [60, 63, 66],
+  // CHECK{LITERAL}: [90, 93, 96],
+  // CHECK{LITERAL}: [70, 72, 74]]
+  call @printMemrefF32(%printed_erosion) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[5, 3\] strides = \[3, 1\] data =}}
+  // CHECK{LITERAL}: [[0, 1, 2],
+  // CHECK{LITERAL}: [0, 1, 2],
+  // CHECK{LITERAL}: [10, 11, 12],
+  // CHECK{LITERAL}: [20, 21, 22],
+  // CHECK{LITERAL}: [30, 31, 32]]
+
+  %ret = arith.constant 0 : i32
+  return %ret : i32
+}
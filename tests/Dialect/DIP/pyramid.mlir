@@ -0,0 +1,131 @@
+//
+// x86
+//
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=4" -arith-expand --convert-vector-to-scf --lower-affine --convert-scf-to-cf --convert-vector-to-llvm \
+// RUN: --convert-math-to-llvm --finalize-memref-to-llvm --convert-arith-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=4 DIP-parallel-tile-rows=2" -arith-expand --convert-vector-to-scf --lower-affine --convert-scf-to-cf --convert-vector-to-llvm \
+// RUN: --convert-math-to-llvm --finalize-memref-to-llvm --convert-arith-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+
+// pyr_down blurs with the 5x5 binomial kernel and keeps the even rows and
+// columns, pyr_up upsamples and blurs with 4 times that kernel. 8-bit images
+// are unsigned and rounded to nearest.
+
+memref.global "private" @global_input_down : memref<5x6xf32> = dense<[[32., 64., 96., 128., 160., 192.],
+                                                                      [224., 256., 288., 320., 352., 384.],
+                                                                      [0., 96., 192., 288., 384., 480.],
+                                                                      [640., 320., 0., 320., 640., 960.],
+                                                                      [160., 160., 160., 160., 160., 160.]]>
+
+memref.global "private" @global_input_down_u8 : memref<4x4xi8> = dense<[[0, 255, 40, 90],
+                                                                        [128, 64, 200, 10],
+                                                                        [30, 30, 250, 100],
+                                                                        [5, 77, 16, 199]]>
+
+memref.global "private" @global_input_up : memref<2x3xf32> = dense<[[4., 8., 16.],
+                                                                    [32., 64., 124.]]>
+
+memref.global "private" @global_input_up_u8 : memref<2x2xi8> = dense<[[0, 255],
+                                                                      [100, 37]]>
+
+memref.global "private" @global_output_down : memref<3x3xf32> = dense<0.>
+
+memref.global "private" @global_output_down_u8 : memref<2x2xi8> = dense<0>
+
+memref.global "private" @global_output_up : memref<4x6xf32> = dense<0.>
+
+memref.global "private" @global_output_up_u8 : memref<4x4xi8> = dense<0>
+
+memref.global "private" @global_output_up_odd : memref<3x3xi8> = dense<0>
+
+func.func private @printMemrefF32(memref<*xf32>) attributes { llvm.emit_c_interface }
+func.func private @printMemrefI32(memref<*xi32>) attributes { llvm.emit_c_interface }
+
+// Prints an 8-bit image as unsigned values.
+func.func @printU8(%image : memref<?x?xi8>) {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %rows = memref.dim %image, %c0 : memref<?x?xi8>
+  %cols = memref.dim %image, %c1 : memref<?x?xi8>
+  %wide = memref.alloc(%rows, %cols) : memref<?x?xi32>
+  scf.for %i = %c0 to %rows step %c1 {
+    scf.for %j = %c0 to %cols step %c1 {
+      %val = memref.load %image[%i, %j] : memref<?x?xi8>
+      %ext = arith.extui %val : i8 to i32
+      memref.store %ext, %wide[%i, %j] : memref<?x?xi32>
+    }
+  }
+  %printed = memref.cast %wide : memref<?x?xi32> to memref<*xi32>
+  call @printMemrefI32(%printed) : (memref<*xi32>) -> ()
+  memref.dealloc %wide : memref<?x?xi32>
+  return
+}
+
+func.func @main() -> i32 {
+  %inputDown = memref.get_global @global_input_down : memref<5x6xf32>
+  %inputDownU8 = memref.get_global @global_input_down_u8 : memref<4x4xi8>
+  %inputUp = memref.get_global @global_input_up : memref<2x3xf32>
+  %inputUpU8 = memref.get_global @global_input_up_u8 : memref<2x2xi8>
+  %outputDown = memref.get_global @global_output_down : memref<3x3xf32>
+  %outputDownU8 = memref.get_global @global_output_down_u8 : memref<2x2xi8>
+  %outputUp = memref.get_global @global_output_up : memref<4x6xf32>
+  %outputUpU8 = memref.get_global @global_output_up_u8 : memref<4x4xi8>
+  %outputUpOdd = memref.get_global @global_output_up_odd : memref<3x3xi8>
+
+  %zero = arith.constant 0. : f32
+  %padding = arith.constant -8. : f32
+  %zeroU8 = arith.constant 0 : i8
+  %paddingU8 = arith.constant 100 : i8
+  %paddingOdd = arith.constant 50 : i8
+
+  dip.pyr_down <REPLICATE_PADDING> %inputDown, %outputDown, %zero : memref<5x6xf32>, memref<3x3xf32>, f32
+  dip.pyr_down <CONSTANT_PADDING> %inputDownU8, %outputDownU8, %paddingU8 : memref<4x4xi8>, memref<2x2xi8>, i8
+  dip.pyr_up <CONSTANT_PADDING> %inputUp, %outputUp, %padding : memref<2x3xf32>, memref<4x6xf32>, f32
+  dip.pyr_up <REPLICATE_PADDING> %inputUpU8, %outputUpU8, %zeroU8 : memref<2x2xi8>, memref<4x4xi8>, i8
+  dip.pyr_up <CONSTANT_PADDING> %inputUpU8, %outputUpOdd, %paddingOdd : memref<2x2xi8>, memref<3x3xi8>, i8
+
+  %printed_down = memref.cast %outputDown : memref<3x3xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_down) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[3, 3\] strides = \[3, 1\] data =}}
+  // CHECK{LITERAL}: [[91.5, 150, 219.75],
+  // CHECK{LITERAL}: [215.25, 220, 404.125],
+  // CHECK{LITERAL}: [242.25, 182, 288.625]]
+
+  %printed_down_u8 = memref.cast %outputDownU8 : memref<2x2xi8> to memref<?x?xi8>
+  call @printU8(%printed_down_u8) : (memref<?x?xi8>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[2, 2\] strides = \[2, 1\] data =}}
+  // CHECK{LITERAL}: [[99, 107],
+  // CHECK{LITERAL}: [77, 111]]
+
+  %printed_up = memref.cast %outputUp : memref<4x6xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_up) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[4, 6\] strides = \[6, 1\] data =}}
+  // CHECK{LITERAL}: [[5.125, 9.5, 13.8125, 19.75, 20.5, 9.25],
+  // CHECK{LITERAL}: [17, 27, 38, 53, 56, 31],
+  // CHECK{LITERAL}: [22.625, 35.75, 50.6875, 71, 75.5, 43],
+  // CHECK{LITERAL}: [11.5, 20, 29.75, 43, 46, 25]]
+
+  %printed_up_u8 = memref.cast %outputUpU8 : memref<4x4xi8> to memref<?x?xi8>
+  call @printU8(%printed_up_u8) : (memref<?x?xi8>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[4, 4\] strides = \[4, 1\] data =}}
+  // CHECK{LITERAL}: [[39, 120, 201, 228],
+  // CHECK{LITERAL}: [62, 98, 134, 146],
+  // CHECK{LITERAL}: [85, 76, 67, 64],
+  // CHECK{LITERAL}: [92, 69, 45, 37]]
+
+  // Odd output sizes drop the last row and column of the upsampled image.
+  %printed_up_odd = memref.cast %outputUpOdd : memref<3x3xi8> to memref<?x?xi8>
+  call @printU8(%printed_up_odd) : (memref<?x?xi8>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[3, 3\] strides = \[3, 1\] data =}}
+  // CHECK{LITERAL}: [[46, 110, 160],
+  // CHECK{LITERAL}: [62, 98, 122],
+  // CHECK{LITERAL}: [75, 74, 66]]
+
+  %ret = arith.constant 0 : i32
+  return %ret : i32
+}
@@ -0,0 +1,153 @@
+//
+// x86
+//
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=4" -arith-expand --convert-vector-to-scf --lower-affine --convert-scf-to-cf --convert-vector-to-llvm \
+// RUN: --convert-math-to-llvm --finalize-memref-to-llvm --convert-arith-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+
+// Every interpolation type and element type uses the separable resizing.
+// Integer images use fixed-point coefficients; 8-bit images are unsigned and
+// wider images are signed, and all of them saturate to their range.
+
+memref.global "private" @global_input_f32 : memref<4x4xf32> = dense<[[0. , 2. , 4. , 6. ],
+                                                                     [8. , 10., 12., 14.],
+                                                                     [16., 18., 20., 22.],
+                                                                     [24., 26., 28., 30.]]>
+
+memref.global "private" @global_input_i8 : memref<2x2xi8> = dense<[[0, 200],
+                                                                   [100, 250]]>
+
+memref.global "private" @global_input_row_i8 : memref<1x4xi8> = dense<[[0, 40, 200, 255]]>
+
+memref.global "private" @global_input_row_i32 : memref<1x4xi32> = dense<[[-2147483648, -2147483648, 2147483647, 2147483647]]>
+
+memref.global "private" @global_input_row_i64 : memref<1x4xi64> = dense<[[-9223372036854775808, 5, 9223372036854775807, -7]]>
+
+memref.global "private" @global_output_area_f32 : memref<2x2xf32> = dense<0.>
+
+memref.global "private" @global_output_nearest_f32 : memref<2x3xf32> = dense<0.>
+
+memref.global "private" @global_output_bilinear_f32 : memref<3x5xf32> = dense<0.>
+
+memref.global "private" @global_output_bilinear_i8 : memref<4x4xi8> = dense<0>
+
+memref.global "private" @global_output_bicubic_i8 : memref<1x8xi8> = dense<0>
+
+memref.global "private" @global_output_area_i8 : memref<1x2xi8> = dense<0>
+
+memref.global "private" @global_output_bicubic_i32 : memref<1x8xi32> = dense<0>
+
+memref.global "private" @global_output_bilinear_i64 : memref<1x8xi64> = dense<0>
+
+func.func private @printMemrefF32(memref<*xf32>) attributes { llvm.emit_c_interface }
+
+func.func private @printMemrefI32(memref<*xi32>) attributes { llvm.emit_c_interface }
+
+func.func private @printMemrefI64(memref<*xi64>) attributes { llvm.emit_c_interface }
+
+// Prints an 8-bit image as unsigned values.
+func.func @printU8(%image : memref<?x?xi8>) {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %rows = memref.dim %image, %c0 : memref<?x?xi8>
+  %cols = memref.dim %image, %c1 : memref<?x?xi8>
+  %wide = memref.alloc(%rows, %cols) : memref<?x?xi32>
+  scf.for %i = %c0 to %rows step %c1 {
+    scf.for %j = %c0 to %cols step %c1 {
+      %val = memref.load %image[%i, %j] : memref<?x?xi8>
+      %ext = arith.extui %val : i8 to i32
+      memref.store %ext, %wide[%i, %j] : memref<?x?xi32>
+    }
+  }
+  %printed = memref.cast %wide : memref<?x?xi32> to memref<*xi32>
+  call @printMemrefI32(%printed) : (memref<*xi32>) -> ()
+  memref.dealloc %wide : memref<?x?xi32>
+  return
+}
+
+func.func @main() -> i32 {
+  %inputF32 = memref.get_global @global_input_f32 : memref<4x4xf32>
+  %inputI8 = memref.get_global @global_input_i8 : memref<2x2xi8>
+  %inputRowI8 = memref.get_global @global_input_row_i8 : memref<1x4xi8>
+  %outputAreaF32 = memref.get_global @global_output_area_f32 : memref<2x2xf32>
+  %outputBilinearI8 = memref.get_global @global_output_bilinear_i8 : memref<4x4xi8>
+  %outputBicubicI8 = memref.get_global @global_output_bicubic_i8 : memref<1x8xi8>
+  %outputAreaI8 = memref.get_global @global_output_area_i8 : memref<1x2xi8>
+  %inputRowI32 = memref.get_global @global_input_row_i32 : memref<1x4xi32>
+  %inputRowI64 = memref.get_global @global_input_row_i64 : memref<1x4xi64>
+  %outputNearestF32 = memref.get_global @global_output_nearest_f32 : memref<2x3xf32>
+  %outputBilinearF32 = memref.get_global @global_output_bilinear_f32 : memref<3x5xf32>
+  %outputBicubicI32 = memref.get_global @global_output_bicubic_i32 : memref<1x8xi32>
+  %outputBilinearI64 = memref.get_global @global_output_bilinear_i64 : memref<1x8xi64>
+
+  %half = arith.constant 0.5 : f32
+  %one = arith.constant 1. : f32
+  %two = arith.constant 2. : f32
+  %threeQuarters = arith.constant 0.75 : f32
+  %threeHalves = arith.constant 1.5 : f32
+
+  dip.resize_2d AREA_INTERPOLATION %inputF32, %two, %two, %outputAreaF32 : memref<4x4xf32>, f32, f32, memref<2x2xf32>
+  dip.resize_2d BILINEAR_INTERPOLATION %inputI8, %half, %half, %outputBilinearI8 : memref<2x2xi8>, f32, f32, memref<4x4xi8>
+  dip.resize_2d BICUBIC_INTERPOLATION %inputRowI8, %half, %one, %outputBicubicI8 : memref<1x4xi8>, f32, f32, memref<1x8xi8>
+  dip.resize_2d AREA_INTERPOLATION %inputRowI8, %two, %one, %outputAreaI8 : memref<1x4xi8>, f32, f32, memref<1x2xi8>
+  dip.resize_2d NEAREST_NEIGHBOUR_INTERPOLATION %inputF32, %threeHalves, %two, %outputNearestF32 : memref<4x4xf32>, f32, f32, memref<2x3xf32>
+  dip.resize_2d BILINEAR_INTERPOLATION %inputF32, %threeQuarters, %threeQuarters, %outputBilinearF32 : memref<4x4xf32>, f32, f32, memref<3x5xf32>
+  dip.resize_2d BICUBIC_INTERPOLATION %inputRowI32, %half, %one, %outputBicubicI32 : memref<1x4xi32>, f32, f32, memref<1x8xi32>
+  dip.resize_2d BILINEAR_INTERPOLATION %inputRowI64, %half, %one, %outputBilinearI64 : memref<1x4xi64>, f32, f32, memref<1x8xi64>
+
+  %printed_area_f32 = memref.cast %outputAreaF32 : memref<2x2xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_area_f32) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[2, 2\] strides = \[2, 1\] data =}}
+  // CHECK{LITERAL}: [[5, 9],
+  // CHECK{LITERAL}: [21, 25]]
+
+  %bilinear = memref.cast %outputBilinearI8 : memref<4x4xi8> to memref<?x?xi8>
+  call @printU8(%bilinear) : (memref<?x?xi8>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[4, 4\] strides = \[4, 1\] data =}}
+  // CHECK{LITERAL}: [[0, 100, 200, 200],
+  // CHECK{LITERAL}: [50, 138, 225, 225],
+  // CHECK{LITERAL}: [100, 175, 250, 250],
+  // CHECK{LITERAL}: [100, 175, 250, 250]]
+
+  %bicubic = memref.cast %outputBicubicI8 : memref<1x8xi8> to memref<?x?xi8>
+  call @printU8(%bicubic) : (memref<?x?xi8>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[1, 8\] strides = \[8, 1\] data =}}
+  // CHECK{LITERAL}: [[0, 5, 40, 119, 200, 243, 255, 255]]
+
+  %area = memref.cast %outputAreaI8 : memref<1x2xi8> to memref<?x?xi8>
+  call @printU8(%area) : (memref<?x?xi8>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[1, 2\] strides = \[2, 1\] data =}}
+  // CHECK{LITERAL}: [[20, 228]]
+
+  %printed_nearest_f32 = memref.cast %outputNearestF32 : memref<2x3xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_nearest_f32) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[2, 3\] strides = \[3, 1\] data =}}
+  // CHECK{LITERAL}: [[0, 4, 6],
+  // CHECK{LITERAL}: [16, 20, 22]]
+
+  // Bilinear interpolation of a linear ramp reproduces the ramp, and columns
+  // past the last input column replicate it.
+  %printed_bilinear_f32 = memref.cast %outputBilinearF32 : memref<3x5xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_bilinear_f32) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[3, 5\] strides = \[5, 1\] data =}}
+  // CHECK{LITERAL}: [[0, 1.5, 3, 4.5, 6],
+  // CHECK{LITERAL}: [6, 7.5, 9, 10.5, 12],
+  // CHECK{LITERAL}: [12, 13.5, 15, 16.5, 18]]
+
+  // The bicubic overshoot saturates to the signed range of i32.
+  %printed_bicubic_i32 = memref.cast %outputBicubicI32 : memref<1x8xi32> to memref<*xi32>
+  call @printMemrefI32(%printed_bicubic_i32) : (memref<*xi32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[1, 8\] strides = \[8, 1\] data =}}
+  // CHECK{LITERAL}: [[-2147483648, -2147483648, -2147483648, 0, 2147483647, 2147483647, 2147483647, 2147483647]]
+
+  // i64 images accumulate in i128, so the extremes of the range do not wrap.
+  %printed_bilinear_i64 = memref.cast %outputBilinearI64 : memref<1x8xi64> to memref<*xi64>
+  call @printMemrefI64(%printed_bilinear_i64) : (memref<*xi64>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[1, 8\] strides = \[8, 1\] data =}}
+  // CHECK{LITERAL}: [[-9223372036854775808, -4611686018427387901, 5, 4611686018427387906, 9223372036854775807, 4611686018427387900, -7, -7]]
+
+  %ret = arith.constant 0 : i32
+  return %ret : i32
+}
@@ -0,0 +1,124 @@
+//
+// x86
+//
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=4" -arith-expand --convert-vector-to-scf --lower-affine --convert-scf-to-cf --convert-vector-to-llvm \
+// RUN: --convert-math-to-llvm --finalize-memref-to-llvm --convert-arith-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+// RUN: buddy-opt %s -lower-dip="DIP-strip-mining=4 DIP-parallel-tile-rows=2" -arith-expand --convert-vector-to-scf --lower-affine --convert-scf-to-cf --convert-vector-to-llvm \
+// RUN: --convert-math-to-llvm --finalize-memref-to-llvm --convert-arith-to-llvm --convert-func-to-llvm --reconcile-unrealized-casts  \
+// RUN: | mlir-cpu-runner -O0 -e main -entry-point-result=i32 \
+// RUN: -shared-libs=%mlir_runner_utils_dir/libmlir_runner_utils%shlibext,%mlir_runner_utils_dir/libmlir_c_runner_utils%shlibext \
+// RUN: | FileCheck %s
+
+// The matrices map output coordinates to input coordinates. Remapping with a
+// precomputed map gives the same result as the warping it was built for.
+
+memref.global "private" @global_input : memref<4x4xf32> = dense<[[0. , 2. , 4. , 6. ],
+                                                                 [8. , 10., 12., 14.],
+                                                                 [16., 18., 20., 22.],
+                                                                 [24., 26., 28., 30.]]>
+
+memref.global "private" @global_input_i8 : memref<2x2xi8> = dense<[[0, 200],
+                                                                   [100, 250]]>
+
+memref.global "private" @global_affine : memref<2x3xf32> = dense<[[1., 0., 0.5],
+                                                                  [0., 1., -1.]]>
+
+memref.global "private" @global_scale : memref<2x3xf32> = dense<[[0.5, 0., 0.],
+                                                                 [0., 0.5, 0.]]>
+
+memref.global "private" @global_perspective : memref<3x3xf32> = dense<[[1.  , 0., 0.],
+                                                                       [0.  , 1., 0.],
+                                                                       [0.25, 0., 1.]]>
+
+memref.global "private" @global_output_affine : memref<3x5xf32> = dense<0.>
+
+memref.global "private" @global_output_perspective : memref<4x4xf32> = dense<0.>
+
+memref.global "private" @global_output_remap : memref<4x4xf32> = dense<0.>
+
+memref.global "private" @global_output_i8 : memref<3x3xi8> = dense<0>
+
+memref.global "private" @global_map : memref<2x4x4xi32> = dense<0>
+
+func.func private @printMemrefF32(memref<*xf32>) attributes { llvm.emit_c_interface }
+
+func.func private @printMemrefI32(memref<*xi32>) attributes { llvm.emit_c_interface }
+
+// Prints an 8-bit image as unsigned values.
+func.func @printU8(%image : memref<?x?xi8>) {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %rows = memref.dim %image, %c0 : memref<?x?xi8>
+  %cols = memref.dim %image, %c1 : memref<?x?xi8>
+  %wide = memref.alloc(%rows, %cols) : memref<?x?xi32>
+  scf.for %i = %c0 to %rows step %c1 {
+    scf.for %j = %c0 to %cols step %c1 {
+      %val = memref.load %image[%i, %j] : memref<?x?xi8>
+      %ext = arith.extui %val : i8 to i32
+      memref.store %ext, %wide[%i, %j] : memref<?x?xi32>
+    }
+  }
+  %printed = memref.cast %wide : memref<?x?xi32> to memref<*xi32>
+  call @printMemrefI32(%printed) : (memref<*xi32>) -> ()
+  memref.dealloc %wide : memref<?x?xi32>
+  return
+}
+
+func.func @main() -> i32 {
+  %input = memref.get_global @global_input : memref<4x4xf32>
+  %inputI8 = memref.get_global @global_input_i8 : memref<2x2xi8>
+  %affine = memref.get_global @global_affine : memref<2x3xf32>
+  %scale = memref.get_global @global_scale : memref<2x3xf32>
+  %perspective = memref.get_global @global_perspective : memref<3x3xf32>
+  %outputAffine = memref.get_global @global_output_affine : memref<3x5xf32>
+  %outputPerspective = memref.get_global @global_output_perspective : memref<4x4xf32>
+  %outputRemap = memref.get_global @global_output_remap : memref<4x4xf32>
+  %outputI8 = memref.get_global @global_output_i8 : memref<3x3xi8>
+  %map = memref.get_global @global_map : memref<2x4x4xi32>
+
+  %padding = arith.constant -1. : f32
+  %zero = arith.constant 0. : f32
+  %zeroI8 = arith.constant 0 : i8
+
+  dip.warp_affine_2d <CONSTANT_PADDING> %input, %affine, %outputAffine, %padding : memref<4x4xf32>, memref<2x3xf32>, memref<3x5xf32>, f32
+  dip.warp_perspective_2d <REPLICATE_PADDING> %input, %perspective, %outputPerspective, %zero : memref<4x4xf32>, memref<3x3xf32>, memref<4x4xf32>, f32
+  dip.warp_map_2d %perspective, %map : memref<3x3xf32>, memref<2x4x4xi32>
+  dip.remap_2d <REPLICATE_PADDING> %input, %map, %outputRemap, %zero : memref<4x4xf32>, memref<2x4x4xi32>, memref<4x4xf32>, f32
+  dip.warp_affine_2d <REPLICATE_PADDING> %inputI8, %scale, %outputI8, %zeroI8 : memref<2x2xi8>, memref<2x3xf32>, memref<3x3xi8>, i8
+
+  %printed_affine = memref.cast %outputAffine : memref<3x5xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_affine) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[3, 5\] strides = \[5, 1\] data =}}
+  // CHECK{LITERAL}: [[-1, -1, -1, -1, -1],
+  // CHECK{LITERAL}: [1, 3, 5, 2.5, -1],
+  // CHECK{LITERAL}: [9, 11, 13, 6.5, -1]]
+
+  %printed_perspective = memref.cast %outputPerspective : memref<4x4xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_perspective) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[4, 4\] strides = \[4, 1\] data =}}
+  // CHECK{LITERAL}: [[0, 1.625, 2.6875, 3.4375],
+  // CHECK{LITERAL}: [8, 8.125, 7.9375, 7.9375],
+  // CHECK{LITERAL}: [16, 14.375, 13.4375, 12.6875],
+  // CHECK{LITERAL}: [24, 20.875, 18.6875, 17.1875]]
+
+  %printed_remap = memref.cast %outputRemap : memref<4x4xf32> to memref<*xf32>
+  call @printMemrefF32(%printed_remap) : (memref<*xf32>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[4, 4\] strides = \[4, 1\] data =}}
+  // CHECK{LITERAL}: [[0, 1.625, 2.6875, 3.4375],
+  // CHECK{LITERAL}: [8, 8.125, 7.9375, 7.9375],
+  // CHECK{LITERAL}: [16, 14.375, 13.4375, 12.6875],
+  // CHECK{LITERAL}: [24, 20.875, 18.6875, 17.1875]]
+
+  %printedI8 = memref.cast %outputI8 : memref<3x3xi8> to memref<?x?xi8>
+  call @printU8(%printedI8) : (memref<?x?xi8>) -> ()
+  // CHECK: {{Unranked Memref base@ = 0x[0-9A-Fa-f]{1,} rank = 2 offset = 0 sizes = \[3, 3\] strides = \[3, 1\] data =}}
+  // CHECK{LITERAL}: [[0, 100, 200],
+  // CHECK{LITERAL}: [50, 138, 225],
+  // CHECK{LITERAL}: [100, 175, 250]]
+
+  %ret = arith.constant 0 : i32
+  return %ret : i32
+}
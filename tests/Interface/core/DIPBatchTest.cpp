@@ -0,0 +1,211 @@
+//===- DIPBatchTest.cpp ---------------------------------------------------===//
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+// This is the batched DIP interfaces test file. Every batched result is
+// compared with the per-image call on the same image.
+//
+//===----------------------------------------------------------------------===//
+
+// RUN: buddy-dip-batch-test 2>&1 | FileCheck %s
+
+#include <buddy/Core/Container.h>
+#include <buddy/DIP/DIP.h>
+#include <buddy/DIP/ImageContainer.h>
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+
+constexpr intptr_t kImages = 5;
+constexpr intptr_t kRows = 9;
+constexpr intptr_t kCols = 11;
+constexpr unsigned kThreads = 4;
+
+// Image `index` of `stack` as a standalone image.
+Img<float, 2> image(MemRef<float, 3> &stack, intptr_t index) {
+  intptr_t rows = stack.getSizes()[1];
+  intptr_t cols = stack.getSizes()[2];
+  intptr_t sizes[2] = {rows, cols};
+  return Img<float, 2>(stack.getData() + index * rows * cols, sizes);
+}
+
+// Number of elements of image `index` of `stack` that differ from `expected`.
+int mismatches(MemRef<float, 3> &stack, intptr_t index,
+               MemRef<float, 2> &expected) {
+  intptr_t size = stack.getSizes()[1] * stack.getSizes()[2];
+  if (size != static_cast<intptr_t>(expected.getSize()))
+    return size;
+  const float *data = stack.getData() + index * size;
+  int count = 0;
+  for (intptr_t i = 0; i < size; ++i)
+    if (std::fabs(data[i] - expected.getData()[i]) >
+        1e-4f * (1 + std::fabs(expected.getData()[i])))
+      ++count;
+  return count;
+}
+
+int main() {
+  intptr_t stackSizes[3] = {kImages, kRows, kCols};
+  MemRef<float, 3> pixels(stackSizes);
+  for (size_t i = 0; i < pixels.getSize(); ++i)
+    pixels.getData()[i] = (i * 37 + 11) % 23;
+  Img<float, 3> input(pixels.getData(), stackSizes);
+  MemRef<float, 3> output(stackSizes);
+
+  intptr_t kernelSizes[2] = {3, 3};
+  float kernelData[9] = {0, 1, 0, 1, 1, 1, 0, 1, 0};
+  MemRef<float, 2> kernel(kernelData, kernelSizes);
+  intptr_t imageSizes[2] = {kRows, kCols};
+
+  //===--------------------------------------------------------------------===//
+  // Test Corr2DBatch.
+  //===--------------------------------------------------------------------===//
+  dip::Corr2DBatch(&input, &kernel, &output, 1, 1,
+                   dip::BOUNDARY_OPTION::CONSTANT_PADDING, 1.5f, kThreads);
+  int count = 0;
+  for (intptr_t i = 0; i < kImages; ++i) {
+    Img<float, 2> inputImage = image(input, i);
+    MemRef<float, 2> expected(imageSizes);
+    dip::Corr2D(&inputImage, &kernel, &expected, 1, 1,
+                dip::BOUNDARY_OPTION::CONSTANT_PADDING, 1.5f);
+    count += mismatches(output, i, expected);
+  }
+  // CHECK: Corr2DBatch mismatches: 0
+  fprintf(stderr, "Corr2DBatch mismatches: %d\n", count);
+
+  //===--------------------------------------------------------------------===//
+  // Test CorrFFT2DBatch.
+  //===--------------------------------------------------------------------===//
+  dip::CorrFFT2DBatch(&input, &kernel, &output, 1, 1,
+                      dip::BOUNDARY_OPTION::REPLICATE_PADDING, 0, kThreads);
+  count = 0;
+  for (intptr_t i = 0; i < kImages; ++i) {
+    Img<float, 2> inputImage = image(input, i);
+    MemRef<float, 2> expected(imageSizes);
+    dip::CorrFFT2D(&inputImage, &kernel, &expected, 1, 1,
+                   dip::BOUNDARY_OPTION::REPLICATE_PADDING);
+    count += mismatches(output, i, expected);
+  }
+  // CHECK: CorrFFT2DBatch mismatches: 0
+  fprintf(stderr, "CorrFFT2DBatch mismatches: %d\n", count);
+
+  //===--------------------------------------------------------------------===//
+  // Test Erosion2DBatch with two iterations, which must not change the input.
+  //===--------------------------------------------------------------------===//
+  dip::Erosion2DBatch(&input, &kernel, &output, 1, 1, 2,
+                      dip::BOUNDARY_OPTION::REPLICATE_PADDING, 0, kThreads);
+  count = 0;
+  for (intptr_t i = 0; i < kImages; ++i) {
+    MemRef<float, 2> expected(imageSizes);
+    dip::Erosion2D(image(input, i), &kernel, &expected, 1, 1, 2,
+                   dip::BOUNDARY_OPTION::REPLICATE_PADDING);
+    count += mismatches(output, i, expected);
+  }
+  // CHECK: Erosion2DBatch mismatches: 0
+  fprintf(stderr, "Erosion2DBatch mismatches: %d\n", count);
+  count = 0;
+  for (size_t i = 0; i < input.getSize(); ++i)
+    if (input.getData()[i] != (i * 37 + 11) % 23)
+      ++count;
+  // CHECK: Erosion2DBatch input changes: 0
+  fprintf(stderr, "Erosion2DBatch input changes: %d\n", count);
+
+  //===--------------------------------------------------------------------===//
+  // Test Opening2DBatch.
+  //===--------------------------------------------------------------------===//
+  dip::Opening2DBatch(&input, &kernel, &output, 1, 1, 1,
+                      dip::BOUNDARY_OPTION::CONSTANT_PADDING, 4.f, kThreads);
+  count = 0;
+  for (intptr_t i = 0; i < kImages; ++i) {
+    Img<float, 2> inputImage = image(input, i);
+    MemRef<float, 2> expected(imageSizes);
+    dip::Opening2D(&inputImage, &kernel, &expected, 1, 1, 1,
+                   dip::BOUNDARY_OPTION::CONSTANT_PADDING, 4.f);
+    count += mismatches(output, i, expected);
+  }
+  // CHECK: Opening2DBatch mismatches: 0
+  fprintf(stderr, "Opening2DBatch mismatches: %d\n", count);
+
+  //===--------------------------------------------------------------------===//
+  // Test MorphGrad2DBatch.
+  //===--------------------------------------------------------------------===//
+  dip::MorphGrad2DBatch(&input, &kernel, &output, 1, 1, 1,
+                        dip::BOUNDARY_OPTION::REPLICATE_PADDING, 0, kThreads);
+  count = 0;
+  for (intptr_t i = 0; i < kImages; ++i) {
+    Img<float, 2> inputImage = image(input, i);
+    MemRef<float, 2> expected(imageSizes);
+    dip::MorphGrad2D(&inputImage, &kernel, &expected, 1, 1, 1,
+                     dip::BOUNDARY_OPTION::REPLICATE_PADDING);
+    count += mismatches(output, i, expected);
+  }
+  // CHECK: MorphGrad2DBatch mismatches: 0
+  fprintf(stderr, "MorphGrad2DBatch mismatches: %d\n", count);
+
+  //===--------------------------------------------------------------------===//
+  // Test Rotate2DBatch.
+  //===--------------------------------------------------------------------===//
+  MemRef<float, 3> rotated =
+      dip::Rotate2DBatch(&input, 30, dip::ANGLE_TYPE::DEGREE, kThreads);
+  count = 0;
+  for (intptr_t i = 0; i < kImages; ++i) {
+    Img<float, 2> inputImage = image(input, i);
+    MemRef<float, 2> expected =
+        dip::Rotate2D(&inputImage, 30, dip::ANGLE_TYPE::DEGREE);
+    count += mismatches(rotated, i, expected);
+  }
+  // CHECK: Rotate2DBatch mismatches: 0
+  fprintf(stderr, "Rotate2DBatch mismatches: %d\n", count);
+
+  //===--------------------------------------------------------------------===//
+  // Test Resize2DBatch.
+  //===--------------------------------------------------------------------===//
+  intptr_t outputSize[2] = {7, 5};
+  MemRef<float, 3> resized = dip::Resize2DBatch(
+      &input, dip::INTERPOLATION_TYPE::BILINEAR_INTERPOLATION, outputSize,
+      kThreads);
+  count = 0;
+  for (intptr_t i = 0; i < kImages; ++i) {
+    Img<float, 2> inputImage = image(input, i);
+    MemRef<float, 2> expected = dip::Resize2D(
+        &inputImage, dip::INTERPOLATION_TYPE::BILINEAR_INTERPOLATION,
+        outputSize);
+    count += mismatches(resized, i, expected);
+  }
+  // CHECK: Resize2DBatch mismatches: 0
+  fprintf(stderr, "Resize2DBatch mismatches: %d\n", count);
+
+  //===--------------------------------------------------------------------===//
+  // Test that an exception of a worker reaches the caller, and that the
+  // thread pool still runs the next batch.
+  //===--------------------------------------------------------------------===//
+  try {
+    dip::detail::parallelFor(64, kThreads, [](intptr_t i, unsigned) {
+      if (i == 37)
+        throw std::runtime_error("image 37 failed");
+    });
+    fprintf(stderr, "no exception\n");
+  } catch (const std::runtime_error &e) {
+    // CHECK: caught: image 37 failed
+    fprintf(stderr, "caught: %s\n", e.what());
+  }
+  std::atomic<intptr_t> sum(0);
+  dip::detail::parallelFor(64, kThreads,
+                           [&](intptr_t i, unsigned) { sum += i; });
+  // CHECK: sum: 2016
+  fprintf(stderr, "sum: %ld\n", static_cast<long>(sum));
+
+  return 0;
+}
@@ -0,0 +1,116 @@
+//===- DIPCorrFFTTest.cpp -------------------------------------------------===//
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//===----------------------------------------------------------------------===//
+//
+// This is the FFT correlation test file. Shift kernels move the image by two
+// pixels, so the border rows and columns of the output are the replicated or
+// constant padding of the input. The center of `CorrFFT2D` indexes the flipped
+// kernel, so center (x, y) of a 3x3 kernel matches center (2 - x, 2 - y) of
+// `Corr2D`.
+//
+//===----------------------------------------------------------------------===//
+
+// RUN: buddy-dip-corrfft-test 2>&1 | FileCheck %s
+
+#include <buddy/Core/Container.h>
+#include <buddy/DIP/DIP.h>
+#include <buddy/DIP/ImageContainer.h>
+#include <cmath>
+#include <cstdio>
+
+constexpr intptr_t kRows = 5;
+constexpr intptr_t kCols = 6;
+
+// Print the rows `first` to the last row of `output`, rounded to integers.
+void printRows(const char *name, MemRef<float, 2> &output, intptr_t first) {
+  intptr_t cols = output.getSizes()[1];
+  for (intptr_t i = first; i < output.getSizes()[0]; ++i) {
+    fprintf(stderr, "%s row %ld:", name, static_cast<long>(i));
+    for (intptr_t j = 0; j < cols; ++j)
+      fprintf(stderr, " %ld", std::lround(output.getData()[i * cols + j]));
+    fprintf(stderr, "\n");
+  }
+}
+
+int main() {
+  intptr_t imageSizes[2] = {kRows, kCols};
+  MemRef<float, 2> pixels(imageSizes);
+  for (intptr_t i = 0; i < kRows; ++i)
+    for (intptr_t j = 0; j < kCols; ++j)
+      pixels.getData()[i * kCols + j] = 10 * i + j;
+  Img<float, 2> input(pixels.getData(), imageSizes);
+  MemRef<float, 2> output(imageSizes);
+
+  // A 3x3 kernel with a single one at (`row`, `col`).
+  intptr_t kernelSizes[2] = {3, 3};
+  auto shiftKernel = [&](intptr_t row, intptr_t col) {
+    MemRef<float, 2> kernel(kernelSizes, 0.f);
+    kernel.getData()[row * 3 + col] = 1;
+    return kernel;
+  };
+
+  //===--------------------------------------------------------------------===//
+  // Test replicate padding after the image: out(i, j) = in(i + 2, j + 2).
+  //===--------------------------------------------------------------------===//
+  MemRef<float, 2> down = shiftKernel(2, 2);
+  dip::CorrFFT2D(&input, &down, &output, 2, 2,
+                 dip::BOUNDARY_OPTION::REPLICATE_PADDING);
+  // CHECK: after row 2: 42 43 44 45 45 45
+  // CHECK: after row 3: 42 43 44 45 45 45
+  // CHECK: after row 4: 42 43 44 45 45 45
+  printRows("after", output, 2);
+
+  //===--------------------------------------------------------------------===//
+  // Test replicate padding before the image: out(i, j) = in(i - 2, j - 2).
+  //===--------------------------------------------------------------------===//
+  MemRef<float, 2> up = shiftKernel(0, 0);
+  dip::CorrFFT2D(&input, &up, &output, 0, 0,
+                 dip::BOUNDARY_OPTION::REPLICATE_PADDING);
+  // CHECK: before row 0: 0 0 0 1 2 3
+  // CHECK: before row 1: 0 0 0 1 2 3
+  // CHECK: before row 2: 0 0 0 1 2 3
+  // CHECK: before row 3: 10 10 10 11 12 13
+  // CHECK: before row 4: 20 20 20 21 22 23
+  printRows("before", output, 0);
+
+  //===--------------------------------------------------------------------===//
+  // Test constant padding after the image.
+  //===--------------------------------------------------------------------===//
+  dip::CorrFFT2D(&input, &down, &output, 2, 2,
+                 dip::BOUNDARY_OPTION::CONSTANT_PADDING, -1.f);
+  // CHECK: constant row 2: 42 43 44 45 -1 -1
+  // CHECK: constant row 3: -1 -1 -1 -1 -1 -1
+  // CHECK: constant row 4: -1 -1 -1 -1 -1 -1
+  printRows("constant", output, 2);
+
+  //===--------------------------------------------------------------------===//
+  // Test an off-center anchor against the direct correlation.
+  //===--------------------------------------------------------------------===//
+  float kernelData[9] = {1, -2, 0, 3, 1, -1, 0, 2, 1};
+  MemRef<float, 2> kernel(kernelData, kernelSizes);
+  MemRef<float, 2> expected(imageSizes);
+  dip::Corr2D(&input, &kernel, &expected, 0, 2,
+              dip::BOUNDARY_OPTION::REPLICATE_PADDING);
+  dip::CorrFFT2D(&input, &kernel, &output, 2, 0,
+                 dip::BOUNDARY_OPTION::REPLICATE_PADDING);
+  int count = 0;
+  for (size_t i = 0; i < output.getSize(); ++i)
+    if (std::fabs(output.getData()[i] - expected.getData()[i]) > 1e-3f)
+      ++count;
+  // CHECK: off-center mismatches: 0
+  fprintf(stderr, "off-center mismatches: %d\n", count);
+
+  return 0;
+}
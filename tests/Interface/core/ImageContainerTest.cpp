@@ -120,6 +120,16 @@ int main() {
   // CHECK: 60.0
   fprintf(stderr, "%f\n", testMoveConstructor2[3]);
 
+  //===--------------------------------------------------------------------===//
+  // Test move assignment operator.
+  //===--------------------------------------------------------------------===//
+  Img<float, 2> testMoveAssignment(grayimage_bmp);
+  testMoveAssignment = std::move(testMoveConstructor2);
+  // CHECK: 15.0
+  fprintf(stderr, "%f\n", testMoveAssignment[0]);
+  // CHECK: 60.0
+  fprintf(stderr, "%f\n", testMoveAssignment[3]);
+
   //===--------------------------------------------------------------------===//
   // Test overloading bracket operator.
   //===--------------------------------------------------------------------===//
@@ -204,7 +214,7 @@ int main() {
   // CHECK: 60.0
   fprintf(stderr, "%f\n", testMoveConstructor3[3]);
 
-  Img<float, 2> testMoveConstructor4 = std::move(testMoveConstructor1);
+  Img<float, 2> testMoveConstructor4 = std::move(testMoveConstructor3);
   // CHECK: 15.0
   fprintf(stderr, "%f\n", testMoveConstructor4[0]);
   // CHECK: 4, 4
@@ -304,7 +314,7 @@ int main() {
   // CHECK: 60.0
   fprintf(stderr, "%f\n", testMoveConstructor5[3]);
 
-  Img<float, 2> testMoveConstructor6 = std::move(testMoveConstructor1);
+  Img<float, 2> testMoveConstructor6 = std::move(testMoveConstructor5);
   // CHECK: 15.0
   fprintf(stderr, "%f\n", testMoveConstructor6[0]);
   // CHECK: 4, 4
@@ -332,6 +342,109 @@ int main() {
   const Img<float, 2> testBracketOperator6(grayimage_png);
   // CHECK: 240.0
   fprintf(stderr, "%f\n", testBracketOperator6[15]);
-  
+
+  //===--------------------------------------------------------------------===//
+  // Test non-owning views of caller-provided pixels.
+  //===--------------------------------------------------------------------===//
+  uint8_t viewPixels[6] = {1, 2, 3, 4, 5, 6};
+  intptr_t viewSizes[2] = {2, 3};
+  ImgView<uint8_t, 2> testView(viewPixels, viewSizes);
+  testView[4] = 50;
+  // CHECK: 1, 50, 3
+  fprintf(stderr, "%d, %d, %ld\n", testView.getData() == viewPixels,
+          viewPixels[4], testView.getStrides()[0]);
+
+  //===--------------------------------------------------------------------===//
+  // Test decoding jpeg images into 8-bit images and with a target size.
+  //===--------------------------------------------------------------------===//
+  Img<uchar, 2> grayimage_jpg_u8 = dip::imread<uchar, 2>(
+      "../../../../tests/Interface/core/TestGrayImage.jpg",
+      dip::IMGRD_GRAYSCALE);
+  // CHECK: 15, 240
+  fprintf(stderr, "%d, %d\n", grayimage_jpg_u8[0], grayimage_jpg_u8[15]);
+  Img<float, 2> reducedimage_jpg = dip::imread<float, 2>(
+      "../../../../tests/Interface/core/TestGrayImage.jpg",
+      dip::IMGRD_GRAYSCALE, dip::_Size(2, 2));
+  // CHECK: 2, 2
+  fprintf(stderr, "%ld, %ld\n", reducedimage_jpg.getSizes()[0],
+          reducedimage_jpg.getSizes()[1]);
+  Img<float, 2> unreducedimage_jpg = dip::imread<float, 2>(
+      "../../../../tests/Interface/core/TestGrayImage.jpg",
+      dip::IMGRD_GRAYSCALE, dip::_Size(3, 2));
+  // CHECK: 4, 4
+  fprintf(stderr, "%ld, %ld\n", unreducedimage_jpg.getSizes()[0],
+          unreducedimage_jpg.getSizes()[1]);
+
+  //===--------------------------------------------------------------------===//
+  // Test decoding png images into 8-bit images and caller-provided buffers.
+  //===--------------------------------------------------------------------===//
+  Img<uchar, 2> grayimage_png_u8 = dip::imread<uchar, 2>(
+      "../../../../tests/Interface/core/TestGrayImage.png",
+      dip::IMGRD_GRAYSCALE);
+  // CHECK: 15, 240
+  fprintf(stderr, "%d, %d\n", grayimage_png_u8[0], grayimage_png_u8[15]);
+  // Decode into the second image of a pool of two 4x4 images.
+  std::vector<uchar> pool(2 * 16, 0);
+  dip::PngDecoder<uchar, 2> pngDecoder;
+  pngDecoder.setSource("../../../../tests/Interface/core/TestGrayImage.png");
+  pngDecoder.readHeader();
+  pngDecoder.readData(pool.data() + 16, 4, 1);
+  // CHECK: 0, 15, 240
+  fprintf(stderr, "%d, %d, %d\n", pool[15], pool[16], pool[31]);
+
+  //===--------------------------------------------------------------------===//
+  // Test decoding images asynchronously, in order and into batches.
+  //===--------------------------------------------------------------------===//
+  dip::ImageDecodeQueue<uchar, 2> decodeQueue(dip::IMGRD_GRAYSCALE, 2);
+  decodeQueue.push("../../../../tests/Interface/core/TestGrayImage.png");
+  decodeQueue.push("../../../../tests/Interface/core/TestGrayImage.bmp");
+  std::vector<uchar> encoded_jpg;
+  dip::readFileBytes("../../../../tests/Interface/core/TestGrayImage.jpg",
+                     encoded_jpg);
+  decodeQueue.push(encoded_jpg);
+  // CHECK: 3
+  fprintf(stderr, "%zu\n", decodeQueue.size());
+  for (int i = 0; i < 3; i++) {
+    Img<uchar, 2> decoded = decodeQueue.pop();
+    // CHECK: 15, 240
+    // CHECK: 15, 240
+    // CHECK: 15, 240
+    fprintf(stderr, "%d, %d\n", decoded[0], decoded[15]);
+  }
+  intptr_t batchSizes[3] = {2, 4, 4};
+  MemRef<uchar, 3> batch(batchSizes);
+  std::vector<std::string> batchFiles = {
+      "../../../../tests/Interface/core/TestGrayImage.bmp",
+      "../../../../tests/Interface/core/TestGrayImage.png"};
+  decodeQueue.decodeBatch(batchFiles, batch);
+  // CHECK: 15, 240, 15, 240
+  fprintf(stderr, "%d, %d, %d, %d\n", batch[0], batch[15], batch[16],
+          batch[31]);
+
+  // A missing file fails its own pop, and the queue keeps decoding.
+  decodeQueue.push("../../../../tests/Interface/core/MissingImage.png");
+  decodeQueue.push("../../../../tests/Interface/core/TestGrayImage.png");
+  try {
+    decodeQueue.pop();
+    fprintf(stderr, "no exception\n");
+  } catch (const std::runtime_error &e) {
+    // CHECK: caught: Failed to read {{.*}}MissingImage.png.
+    fprintf(stderr, "caught: %s\n", e.what());
+  }
+  Img<uchar, 2> decodedAfterError = decodeQueue.pop();
+  // CHECK: 15, 240
+  fprintf(stderr, "%d, %d\n", decodedAfterError[0], decodedAfterError[15]);
+
+  // A batch entry of another size is an error.
+  intptr_t wrongBatchSizes[3] = {2, 4, 3};
+  MemRef<uchar, 3> wrongBatch(wrongBatchSizes);
+  try {
+    decodeQueue.decodeBatch(batchFiles, wrongBatch);
+    fprintf(stderr, "no exception\n");
+  } catch (const std::runtime_error &e) {
+    // CHECK: caught: The image size does not match the batch entry.
+    fprintf(stderr, "caught: %s\n", e.what());
+  }
+
   return 0;
 }
\ No newline at end of file
@@ -0,0 +1,44 @@
+# RUN: %PYTHON %s 2>&1 | FileCheck %s
+
+import torch
+import torch._dynamo as dynamo
+from torch._inductor.decomposition import decompositions as inductor_decomp
+
+from buddy.compiler.frontend import DynamoCompiler
+from buddy.compiler.ops import tosa
+
+
+class ConvBnRelu(torch.nn.Module):
+    def __init__(self, *args, **kwargs) -> None:
+        super().__init__(*args, **kwargs)
+        self.conv = torch.nn.Conv2d(3, 16, (3, 3), 1, 1, bias=False)
+        self.bn = torch.nn.BatchNorm2d(16)
+        self.relu = torch.nn.ReLU()
+
+    def forward(self, a):
+        return self.relu(self.bn(self.conv(a)))
+
+
+model = ConvBnRelu().eval()
+dynamo_compiler = DynamoCompiler(
+    primary_registry=tosa.ops_registry,
+    aot_autograd_decomposition=inductor_decomp,
+)
+
+in1 = torch.randn((1, 3, 32, 32))
+with torch.no_grad():
+    graphs = dynamo_compiler.importer(model, in1)
+assert len(graphs) == 1
+graph = graphs[0]
+graph.lower_to_top_level_ir()
+print(graph._imported_module)
+# CHECK: module {
+# CHECK-LABEL: func.func @forward
+# CHECK-NOT: tosa.rsqrt
+# CHECK: %{{.*}} = tosa.conv2d
+# CHECK-NEXT: %{{.*}} = tosa.clamp
+# CHECK-NOT: tosa.mul
+# CHECK-NOT: tosa.maximum
+# CHECK: return %{{.*}}
+# CHECK: }
+# CHECK: }
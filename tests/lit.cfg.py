@@ -66,6 +66,8 @@ tools = [
     "buddy-opt",
     "buddy-translate",
     "buddy-container-test",
+    "buddy-dip-batch-test",
+    "buddy-dip-corrfft-test",
     "buddy-audio-container-test",
     "buddy-text-container-test",
     "mlir-cpu-runner",
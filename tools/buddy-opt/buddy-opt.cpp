@@ -53,6 +53,7 @@ namespace buddy {
 void registerConvVectorizationPass();
 void registerPointwiseConvToGemmPass();
 void registerPoolingVectorizationPass();
+void registerDepthwiseConvVectorizationPass();
 void registerLowerBudPass();
 void registerLowerDIPPass();
 void registerLowerDAPPass();
@@ -63,7 +64,9 @@ void registerMatMulOptimizePass();
 void registerMatMulVectorizationPass();
 void registerMatMulParallelVectorizationPass();
 void registerTransposeOptimizationPass();
+void registerLayoutPropagationPass();
 void registerConvOptimizePass();
+void registerConvWinogradPass();
 void registerLowerVectorExpPass();
 void registerLowerGemminiPass();
 void registerLowerLinalgToGemminiPass();
@@ -81,6 +84,8 @@ int main(int argc, char **argv) {
   mlir::buddy::registerConvVectorizationPass();
   // Register Vectorization of Pooling.
   mlir::buddy::registerPoolingVectorizationPass();
+  // Register Vectorization of Depthwise Convolution.
+  mlir::buddy::registerDepthwiseConvVectorizationPass();
   mlir::buddy::registerLowerBudPass();
   mlir::buddy::registerLowerDIPPass();
   mlir::buddy::registerLowerDAPPass();
@@ -97,7 +102,9 @@ int main(int argc, char **argv) {
   mlir::buddy::registerMatMulParallelVectorizationPass();
   mlir::buddy::registerBatchMatMulOptimizePass();
   mlir::buddy::registerTransposeOptimizationPass();
+  mlir::buddy::registerLayoutPropagationPass();
   mlir::buddy::registerConvOptimizePass();
+  mlir::buddy::registerConvWinogradPass();
   mlir::buddy::registerDeviceSchedulePass();
   mlir::buddy::registerLowerSchePass();
   mlir::buddy::registerFuncBufferizeDynamicOffsetPass();